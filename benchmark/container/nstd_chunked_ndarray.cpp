@@ -0,0 +1,66 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_chunked_ndarray.h>
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// 8192 x 8192 floats (256 MiB) in 256 x 256 tiles
+using field = nstd::chunked_ndarray<float, 256, 256>;
+
+constexpr nstd::size_t extent = 8192;
+
+const std::string &field_path() {
+	static const std::string path = [] {
+		const auto res = (std::filesystem::temp_directory_path() / "nstd_bench_chunked_field.bin").string();
+		auto arr = field::create(res.c_str(), { extent, extent });
+		nstd::transform(arr, arr, [](float) { return 0.5f; });
+		return res;
+	}();
+	return path;
+}
+
+// a kernel with some arithmetic per element, so that IO and compute can overlap
+float tile_energy(const field::tile_type &tile) {
+	float sum = 0.0f;
+	for (nstd::size_t i = 0; i < field::tile_type::arr_size; i++) {
+		sum += std::sqrt(tile.data()[i] * tile.data()[i] + 1.0f);
+	}
+	return sum;
+}
+
+// bench_chunked_scan BEGINS
+TEST_CASE("bench_chunked_scan") {
+	const field arr(field_path().c_str());
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_chunked_scan")
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(3)
+	    .batch(extent * extent)
+	    .unit("element")
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("synchronous read_tile / chunked_scan", [&]() {
+		auto tile = std::make_unique<field::tile_type>();
+		float sum = 0.0f;
+		for (nstd::size_t t = 0; t < arr.tile_count(); t++) {
+			arr.read_tile(t, *tile);
+			sum += tile_energy(*tile);
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+	bench.run("nonstd::tile_stream / chunked_scan", [&]() {
+		float sum = 0.0f;
+		nstd::for_each_tile(arr, [&](const field::tile_type &tile, const auto &) { sum += tile_energy(tile); });
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+}
+// bench_chunked_scan ENDS
@@ -0,0 +1,149 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_compressed_ndarray.h>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// a smooth 2048 x 2048 float field (16 MiB raw) in 64 x 64 tiles, quantized like most stored simulation output
+constexpr nstd::size_t extent = 2048;
+
+using field = nstd::compressed_ndarray<float, 64, 64>;
+
+float sample(nstd::size_t i, nstd::size_t j) {
+	const float x = static_cast<float>(i) * 0.003f, y = static_cast<float>(j) * 0.002f;
+	return std::round((std::sin(x) * std::cos(y) + 0.25f * std::sin(3.0f * x + y)) * 4096.0f) / 4096.0f;
+}
+
+std::vector<float> make_raw() {
+	std::vector<float> res(extent * extent);
+	for (nstd::size_t i = 0; i < extent; i++) {
+		for (nstd::size_t j = 0; j < extent; j++) {
+			res[i * extent + j] = sample(i, j);
+		}
+	}
+	return res;
+}
+
+void fill(field &arr, const std::vector<float> &raw) {
+	auto tile = std::make_unique<field::tile_type>();
+	for (nstd::size_t t = 0; t < arr.tile_count(); t++) {
+		const auto info = arr.info(t);
+		for (nstd::size_t i = 0; i < 64; i++) {
+			for (nstd::size_t j = 0; j < 64; j++) {
+				(*tile)[i][j] = raw[(info._Origin[0] + i) * extent + info._Origin[1] + j];
+			}
+		}
+		arr.write_tile(t, *tile);
+	}
+}
+
+const char *shuffle_name(nstd::shuffle_mode mode) {
+	return mode == nstd::shuffle_mode::none ? "no shuffle" : mode == nstd::shuffle_mode::byte ? "byte shuffle" : "bit shuffle";
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(extent * extent * sizeof(float))
+	    .unit("byte")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+constexpr nstd::shuffle_mode modes[] = { nstd::shuffle_mode::none, nstd::shuffle_mode::byte, nstd::shuffle_mode::bit };
+
+// bench_compressed_footprint BEGINS
+TEST_CASE("bench_compressed_footprint") {
+	const auto raw = make_raw();
+	std::printf("| %-14s | %14s | %14s | %8s |\n", "storage", "raw bytes", "stored bytes", "ratio");
+	std::printf("| %-14s | %14zu | %14zu | %8.2f |\n", "std::vector", raw.size() * sizeof(float), raw.size() * sizeof(float), 1.0);
+	for (auto mode : modes) {
+		field arr({ extent, extent }, mode);
+		fill(arr, raw);
+		std::printf("| %-14s | %14zu | %14zu | %8.2f |\n", shuffle_name(mode), arr.raw_bytes(), arr.footprint() + arr.cache_footprint(),
+		            static_cast<double>(arr.raw_bytes()) / static_cast<double>(arr.footprint() + arr.cache_footprint()));
+	}
+}
+// bench_compressed_footprint ENDS
+
+// bench_compressed_compress BEGINS
+TEST_CASE("bench_compressed_compress") {
+	const auto raw = make_raw();
+	auto bench = make_bench("bench_compressed_compress");
+	for (auto mode : modes) {
+		field arr({ extent, extent }, mode);
+		bench.run(std::string("nonstd::compressed_ndarray / compress, ") + shuffle_name(mode), [&]() { fill(arr, raw); });
+	}
+}
+// bench_compressed_compress ENDS
+
+// bench_compressed_reduce BEGINS
+// effective throughput of a bandwidth-bound reduction, in uncompressed bytes
+TEST_CASE("bench_compressed_reduce") {
+	const auto raw = make_raw();
+	auto bench = make_bench("bench_compressed_reduce");
+
+	bench.run("std::vector / reduce", [&]() {
+		double sum = 0.0;
+		for (float x : raw) {
+			sum += x;
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+	for (auto mode : modes) {
+		field arr({ extent, extent }, mode);
+		fill(arr, raw);
+		bench.run(std::string("nonstd::compressed_ndarray / reduce, ") + shuffle_name(mode), [&]() {
+			const double sum = nstd::reduce(arr, 0.0, [](double acc, float x) { return acc + x; });
+			ankerl::nanobench::doNotOptimizeAway(sum);
+		});
+	}
+}
+// bench_compressed_reduce ENDS
+
+// bench_compressed_random BEGINS
+// random element reads, mostly hitting the tile cache thanks to locality
+TEST_CASE("bench_compressed_random") {
+	const auto raw = make_raw();
+	field arr({ extent, extent });
+	fill(arr, raw);
+
+	ankerl::nanobench::Rng rng(5);
+	std::vector<nstd::size_t> walk;
+	nstd::size_t i = extent / 2, j = extent / 2;
+	for (int n = 0; n < 100'000; n++) {
+		i = (i + extent + rng.bounded(9) - 4) % extent;
+		j = (j + extent + rng.bounded(9) - 4) % extent;
+		walk.push_back(i * extent + j);
+	}
+
+	auto bench = make_bench("bench_compressed_random");
+	bench.batch(walk.size()).unit("read");
+	bench.run("std::vector / random_walk", [&]() {
+		float sum = 0.0f;
+		for (auto idx : walk) {
+			sum += raw[idx];
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+	bench.run("nonstd::compressed_ndarray / random_walk", [&]() {
+		float sum = 0.0f;
+		for (auto idx : walk) {
+			sum += arr.get({ idx / extent, idx % extent });
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+}
+// bench_compressed_random ENDS
@@ -0,0 +1,230 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_mpmc_queue.h>
+#include <container/nstd_spsc_ring.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr nstd::size_t items = 1'000'000;
+constexpr nstd::size_t round_trips = 100'000;
+
+// the usual baseline: a deque behind a mutex, same try_push / try_pop interface
+template<typename Ty>
+class locked_queue {
+	std::mutex _Mutex;
+	std::deque<Ty> _Queue;
+	nstd::size_t _Capacity;
+
+public:
+	explicit locked_queue(nstd::size_t capacity)
+	    : _Capacity(capacity) {
+				std::this_thread::yield();
+			}
+
+	bool try_push(const Ty &val) {
+		std::lock_guard lock(_Mutex);
+		if (_Queue.size() == _Capacity) {
+			return false;
+		}
+		_Queue.push_back(val);
+		return true;
+	}
+
+	bool try_pop(Ty &out) {
+		std::lock_guard lock(_Mutex);
+		if (_Queue.empty()) {
+			return false;
+		}
+		out = _Queue.front();
+		_Queue.pop_front();
+		return true;
+	}
+};
+
+using spsc_1k = nstd::spsc_ring<nstd::size_t, 1024>;
+
+ankerl::nanobench::Bench make_bench(const std::string &title, nstd::size_t n) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(n)
+	    .unit("item")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// one producer thread streams `items` values to the calling thread
+template<typename Queue>
+void stream_single(Queue &queue) {
+	std::thread producer([&] {
+		for (nstd::size_t i = 0; i < items;) {
+			if (queue.try_push(i)) {
+				i++;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+	nstd::size_t sum = 0, val = 0;
+	for (nstd::size_t i = 0; i < items;) {
+		if (queue.try_pop(val)) {
+			sum += val;
+			i++;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+	ankerl::nanobench::doNotOptimizeAway(sum);
+}
+
+template<typename Queue>
+void stream_batched(Queue &queue) {
+	std::thread producer([&] {
+		nstd::size_t batch[64];
+		for (nstd::size_t i = 0; i < items;) {
+			nstd::size_t n = 0;
+			for (; n < 64 && i + n < items; n++) {
+				batch[n] = i + n;
+			}
+			const nstd::size_t pushed = queue.push_n(batch, n);
+			if (pushed == 0) {
+				std::this_thread::yield();
+			}
+			i += pushed;
+		}
+	});
+	nstd::size_t sum = 0, buf[64];
+	for (nstd::size_t i = 0; i < items;) {
+		const nstd::size_t n = queue.pop_n(buf, 64);
+		if (n == 0) {
+			std::this_thread::yield();
+		}
+		for (nstd::size_t j = 0; j < n; j++) {
+			sum += buf[j];
+		}
+		i += n;
+	}
+	producer.join();
+	ankerl::nanobench::doNotOptimizeAway(sum);
+}
+
+// bench_spsc_throughput BEGINS
+TEST_CASE("bench_spsc_throughput") {
+	auto bench = make_bench("bench_spsc_throughput", items);
+
+	locked_queue<nstd::size_t> locked(1024);
+	auto ring = std::make_unique<spsc_1k>();
+	nstd::mpmc_queue<nstd::size_t> mpmc(1024);
+
+	bench.run("std::deque + std::mutex / spsc_throughput", [&]() { stream_single(locked); });
+	bench.run("nonstd::spsc_ring / spsc_throughput", [&]() { stream_single(*ring); });
+	bench.run("nonstd::spsc_ring / spsc_throughput_batched", [&]() { stream_batched(*ring); });
+	bench.run("nonstd::mpmc_queue / spsc_throughput", [&]() { stream_single(mpmc); });
+	bench.run("nonstd::mpmc_queue / spsc_throughput_batched", [&]() { stream_batched(mpmc); });
+}
+// bench_spsc_throughput ENDS
+
+// bench_mpmc_throughput BEGINS
+// 4 producers and 4 consumers share `items` values
+template<typename Queue>
+void stream_many(Queue &queue) {
+	constexpr int threads = 4;
+	constexpr nstd::size_t per_thread = items / threads;
+	std::vector<std::thread> workers;
+	std::atomic<nstd::size_t> sum{ 0 };
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&] {
+			for (nstd::size_t i = 0; i < per_thread;) {
+				if (queue.try_push(i)) {
+					i++;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		});
+		workers.emplace_back([&] {
+			nstd::size_t local = 0, val = 0;
+			for (nstd::size_t i = 0; i < per_thread;) {
+				if (queue.try_pop(val)) {
+					local += val;
+					i++;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			sum.fetch_add(local, std::memory_order_relaxed);
+		});
+	}
+	for (auto &w : workers) {
+		w.join();
+	}
+	ankerl::nanobench::doNotOptimizeAway(sum);
+}
+
+TEST_CASE("bench_mpmc_throughput") {
+	auto bench = make_bench("bench_mpmc_throughput", items);
+
+	locked_queue<nstd::size_t> locked(1024);
+	nstd::mpmc_queue<nstd::size_t> mpmc(1024);
+
+	bench.run("std::deque + std::mutex / mpmc_throughput", [&]() { stream_many(locked); });
+	bench.run("nonstd::mpmc_queue / mpmc_throughput", [&]() { stream_many(mpmc); });
+}
+// bench_mpmc_throughput ENDS
+
+// bench_queue_latency BEGINS
+// ping-pong between two threads over a pair of queues, one item per round trip
+// NOTE: waiting sides yield, on machines with fewer cores than threads this measures scheduling as well
+template<typename Queue>
+void ping_pong(Queue &ping, Queue &pong) {
+	std::thread echo([&] {
+		nstd::size_t val = 0;
+		for (nstd::size_t i = 0; i < round_trips; i++) {
+			while (!ping.try_pop(val)) {
+				std::this_thread::yield();
+			}
+			while (!pong.try_push(val)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+	nstd::size_t val = 0;
+	for (nstd::size_t i = 0; i < round_trips; i++) {
+		while (!ping.try_push(i)) {
+			std::this_thread::yield();
+		}
+		while (!pong.try_pop(val)) {
+			std::this_thread::yield();
+		}
+	}
+	echo.join();
+	ankerl::nanobench::doNotOptimizeAway(val);
+}
+
+TEST_CASE("bench_queue_latency") {
+	auto bench = make_bench("bench_queue_latency", round_trips);
+	bench.unit("round trip");
+
+	locked_queue<nstd::size_t> locked_ping(1024), locked_pong(1024);
+	auto ring_ping = std::make_unique<spsc_1k>(), ring_pong = std::make_unique<spsc_1k>();
+	nstd::mpmc_queue<nstd::size_t> mpmc_ping(1024), mpmc_pong(1024);
+
+	bench.run("std::deque + std::mutex / latency", [&]() { ping_pong(locked_ping, locked_pong); });
+	bench.run("nonstd::spsc_ring / latency", [&]() { ping_pong(*ring_ping, *ring_pong); });
+	bench.run("nonstd::mpmc_queue / latency", [&]() { ping_pong(mpmc_ping, mpmc_pong); });
+}
+// bench_queue_latency ENDS
@@ -0,0 +1,156 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_flat_hash_map.h>
+#include <math/linalg/nstd_vector.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+constexpr nstd::size_t bench_sizes[] = { 1'000, 100'000, 10'000'000 };
+
+std::vector<unsigned long long> make_keys(nstd::size_t n, unsigned long long seed) {
+	ankerl::nanobench::Rng rng(seed);
+	std::vector<unsigned long long> keys(n);
+	for (auto &key : keys) {
+		key = rng();
+	}
+	return keys;
+}
+
+template<typename Map>
+void run_insert(ankerl::nanobench::Bench &bench, const char *name, const std::vector<unsigned long long> &keys) {
+	bench.run(name, [&]() {
+		Map map;
+		for (auto key : keys) {
+			map[key] = key;
+		}
+		ankerl::nanobench::doNotOptimizeAway(map.size());
+	});
+}
+
+// half of the lookups hit, half miss
+template<typename Map>
+void run_find(ankerl::nanobench::Bench &bench, const char *name, const std::vector<unsigned long long> &keys, const std::vector<unsigned long long> &misses) {
+	Map map;
+	for (auto key : keys) {
+		map[key] = key;
+	}
+	bench.run(name, [&]() {
+		nstd::size_t found = 0;
+		for (nstd::size_t i = 0; i < keys.size(); i++) {
+			found += map.find(keys[i]) != map.end();
+			found += map.find(misses[i]) != map.end();
+		}
+		ankerl::nanobench::doNotOptimizeAway(found);
+	});
+}
+
+template<typename Map>
+void run_erase(ankerl::nanobench::Bench &bench, const char *name, const std::vector<unsigned long long> &keys) {
+	Map filled;
+	for (auto key : keys) {
+		filled[key] = key;
+	}
+	bench.run(name, [&]() {
+		Map map = filled;  // NOTE: the copy is part of the measurement for both maps
+		for (auto key : keys) {
+			map.erase(key);
+		}
+		ankerl::nanobench::doNotOptimizeAway(map.size());
+	});
+}
+
+using std_map = std::unordered_map<unsigned long long, unsigned long long>;
+using nstd_map = nstd::flat_hash_map<unsigned long long, unsigned long long>;
+
+ankerl::nanobench::Bench make_bench(const std::string &title, nstd::size_t n) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title + " / " + std::to_string(n))
+	    .warmup(n >= 1'000'000 ? 0 : 3)
+	    .minEpochIterations(n >= 1'000'000 ? 1 : 10)
+	    .epochs(n >= 1'000'000 ? 3 : 11)
+	    .batch(n)
+	    .unit("op")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// bench_hash_insert BEGINS
+TEST_CASE("bench_hash_insert") {
+	for (nstd::size_t n : bench_sizes) {
+		const auto keys = make_keys(n, 1);
+		auto bench = make_bench("bench_hash_insert", n);
+		run_insert<std_map>(bench, "std::unordered_map / insert", keys);
+		run_insert<nstd_map>(bench, "nonstd::flat_hash_map / insert", keys);
+	}
+}
+// bench_hash_insert ENDS
+
+// bench_hash_find BEGINS
+TEST_CASE("bench_hash_find") {
+	for (nstd::size_t n : bench_sizes) {
+		const auto keys = make_keys(n, 1);
+		const auto misses = make_keys(n, 2);
+		auto bench = make_bench("bench_hash_find", 2 * n);
+		run_find<std_map>(bench, "std::unordered_map / find", keys, misses);
+		run_find<nstd_map>(bench, "nonstd::flat_hash_map / find", keys, misses);
+	}
+}
+// bench_hash_find ENDS
+
+// bench_hash_erase BEGINS
+TEST_CASE("bench_hash_erase") {
+	for (nstd::size_t n : bench_sizes) {
+		const auto keys = make_keys(n, 1);
+		auto bench = make_bench("bench_hash_erase", n);
+		run_erase<std_map>(bench, "std::unordered_map / erase", keys);
+		run_erase<nstd_map>(bench, "nonstd::flat_hash_map / erase", keys);
+	}
+}
+// bench_hash_erase ENDS
+
+// bench_grid_lookup BEGINS
+// sparse voxel grid keyed by cell coordinates, queried along a random walk
+TEST_CASE("bench_grid_lookup") {
+	std::unordered_map<nstd::linalg::vector3i, int, nstd::hash<nstd::linalg::vector3i>> std_grid;
+	nstd::flat_hash_map<nstd::linalg::vector3i, int> nstd_grid;
+	for (int x = 0; x < 64; x++) {
+		for (int y = 0; y < 64; y++) {
+			for (int z = 0; z < 64; z += 2) {
+				std_grid[nstd::linalg::vector3i(x, y, z)] = x + y + z;
+				nstd_grid[nstd::linalg::vector3i(x, y, z)] = x + y + z;
+			}
+		}
+	}
+
+	ankerl::nanobench::Rng rng(3);
+	std::vector<nstd::linalg::vector3i> queries;
+	for (int i = 0; i < 100'000; i++) {
+		queries.emplace_back(static_cast<int>(rng.bounded(64)), static_cast<int>(rng.bounded(64)), static_cast<int>(rng.bounded(64)));
+	}
+
+	auto bench = make_bench("bench_grid_lookup", queries.size());
+	bench.run("std::unordered_map / grid_lookup", [&]() {
+		int sum = 0;
+		for (const auto &q : queries) {
+			auto it = std_grid.find(q);
+			sum += it == std_grid.end() ? 0 : it->second;
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+	bench.run("nonstd::flat_hash_map / grid_lookup", [&]() {
+		int sum = 0;
+		for (const auto &q : queries) {
+			auto it = nstd_grid.find(q);
+			sum += it == nstd_grid.end() ? 0 : it->second;
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+}
+// bench_grid_lookup ENDS
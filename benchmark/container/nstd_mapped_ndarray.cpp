@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_mapped_ndarray.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// a 64 MiB float field, 4096 x 4096
+constexpr nstd::size_t rows = 4096;
+constexpr nstd::size_t cols = 4096;
+
+using field = nstd::mapped_ndarray<float, rows, cols>;
+
+const std::string &field_path() {
+	static const std::string path = [] {
+		const auto res = (std::filesystem::temp_directory_path() / "nstd_bench_mapped_field.bin").string();
+		auto arr = field::create(res.c_str());
+		for (nstd::size_t i = 0; i < rows; i++) {
+			for (nstd::size_t j = 0; j < cols; j++) {
+				arr[i][j] = static_cast<float>((i + j) & 0xff);
+			}
+		}
+		return res;
+	}();
+	return path;
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// bench_mapped_open BEGINS
+// time until element [rows / 2][cols / 2] can be read
+TEST_CASE("bench_mapped_open") {
+	const auto &path = field_path();
+	auto bench = make_bench("bench_mapped_open");
+
+	bench.run("read whole file / open", [&]() {
+		nstd::file f(path.c_str(), nstd::open_mode::read);
+		std::vector<float> buf(rows * cols);
+		f.read_at(buf.data(), buf.size() * sizeof(float), sizeof(nstd::mapped_header));  // data starts right after the header at the default alignment
+		ankerl::nanobench::doNotOptimizeAway(buf[rows / 2 * cols + cols / 2]);
+	});
+	bench.run("nonstd::mapped_ndarray / open", [&]() {
+		const field arr(path.c_str());
+		ankerl::nanobench::doNotOptimizeAway(arr[rows / 2][cols / 2]);
+	});
+}
+// bench_mapped_open ENDS
+
+// bench_mapped_scan BEGINS
+// full sequential reduction, with and without the read-ahead hint
+TEST_CASE("bench_mapped_scan") {
+	const auto &path = field_path();
+	auto bench = make_bench("bench_mapped_scan");
+	bench.batch(rows * cols).unit("element");
+
+	auto scan = [](const field &arr) {
+		float sum = 0.0f;
+		for (nstd::size_t i = 0; i < rows; i++) {
+			for (nstd::size_t j = 0; j < cols; j++) {
+				sum += arr[i][j];
+			}
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	};
+
+	bench.run("read whole file / scan", [&]() {
+		nstd::file f(path.c_str(), nstd::open_mode::read);
+		std::vector<float> buf(rows * cols);
+		f.read_at(buf.data(), buf.size() * sizeof(float), sizeof(nstd::mapped_header));  // data starts right after the header at the default alignment
+		float sum = 0.0f;
+		for (float x : buf) {
+			sum += x;
+		}
+		ankerl::nanobench::doNotOptimizeAway(sum);
+	});
+	bench.run("nonstd::mapped_ndarray / scan", [&]() {
+		const field arr(path.c_str());
+		scan(arr);
+	});
+	bench.run("nonstd::mapped_ndarray / scan_sequential_hint", [&]() {
+		const field arr(path.c_str());
+		arr.advise(nstd::access_hint::sequential);
+		scan(arr);
+	});
+}
+// bench_mapped_scan ENDS
@@ -29,6 +29,27 @@ void BM_nonstd_seqwr_1d() {
 	ankerl::nanobench::doNotOptimizeAway(arr);
 }
 
+void BM_strict_seqwr_1d() {
+	nstd::ndarray_strict<int, 16384> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	for (int i = 0; i < 16384; i++) {
+		ankerl::nanobench::doNotOptimizeAway(arr[i]);
+		arr[i] = 0xcafebabe;
+	}
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
+// bounds validated once for the whole array, not per access
+void BM_strict_for_each_seqwr_1d() {
+	nstd::ndarray_strict<int, 16384> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	nstd::for_each_index(arr, [](int &v, auto...) {
+		ankerl::nanobench::doNotOptimizeAway(v);
+		v = 0xcafebabe;
+	});
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
 TEST_CASE("bench_seqwr_1d") {
 	auto bench = ankerl::nanobench::Bench();
 	bench.title("bench_seqwr_1d")
@@ -39,6 +60,8 @@ TEST_CASE("bench_seqwr_1d") {
 
 	bench.run("plain / seqwr_1d", BM_plain_seqwr_1d);
 	bench.run("nonstd / seqwr_1d", BM_nonstd_seqwr_1d);
+	bench.run("nonstd / seqwr_1d strict", BM_strict_seqwr_1d);
+	bench.run("nonstd / seqwr_1d strict for_each_index", BM_strict_for_each_seqwr_1d);
 }
 // bench_seqwr_1d ENDS
 
@@ -67,6 +90,28 @@ void BM_nonstd_seqwr_2d() {
 	ankerl::nanobench::doNotOptimizeAway(arr);
 }
 
+void BM_strict_seqwr_2d() {
+	nstd::ndarray_strict<int, 128, 128> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	for (int i = 0; i < 128; i++) {
+		for (int j = 0; j < 128; j++) {
+			ankerl::nanobench::doNotOptimizeAway(arr[i][j]);
+			arr[i][j] = 0xcafebabe;
+		}
+	}
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
+void BM_strict_for_each_seqwr_2d() {
+	nstd::ndarray_strict<int, 128, 128> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	nstd::for_each_index(arr, [](int &v, auto...) {
+		ankerl::nanobench::doNotOptimizeAway(v);
+		v = 0xcafebabe;
+	});
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
 TEST_CASE("bench_seqwr_2d") {
 	auto bench = ankerl::nanobench::Bench();
 	bench.title("bench_seqwr_2d")
@@ -77,6 +122,8 @@ TEST_CASE("bench_seqwr_2d") {
 
 	bench.run("plain / seqwr_2d", BM_plain_seqwr_2d);
 	bench.run("nonstd / seqwr_2d", BM_nonstd_seqwr_2d);
+	bench.run("nonstd / seqwr_2d strict", BM_strict_seqwr_2d);
+	bench.run("nonstd / seqwr_2d strict for_each_index", BM_strict_for_each_seqwr_2d);
 }
 // bench_seqwr_2d ENDS
 
@@ -109,6 +156,30 @@ void BM_nonstd_seqwr_3d() {
 	ankerl::nanobench::doNotOptimizeAway(arr);
 }
 
+void BM_strict_seqwr_3d() {
+	nstd::ndarray_strict<int, 32, 32, 32> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	for (int i = 0; i < 32; i++) {
+		for (int j = 0; j < 32; j++) {
+			for (int k = 0; k < 32; k++) {
+				ankerl::nanobench::doNotOptimizeAway(arr[i][j][k]);
+				arr[i][j][k] = 0xcafebabe;
+			}
+		}
+	}
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
+void BM_strict_for_each_seqwr_3d() {
+	nstd::ndarray_strict<int, 32, 32, 32> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	nstd::for_each_index(arr, [](int &v, auto...) {
+		ankerl::nanobench::doNotOptimizeAway(v);
+		v = 0xcafebabe;
+	});
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
 TEST_CASE("bench_seqwr_3d") {
 	auto bench = ankerl::nanobench::Bench();
 	bench.title("bench_seqwr_3d")
@@ -119,6 +190,8 @@ TEST_CASE("bench_seqwr_3d") {
 
 	bench.run("plain / seqwr_3d", BM_plain_seqwr_3d);
 	bench.run("nonstd / seqwr_3d", BM_nonstd_seqwr_3d);
+	bench.run("nonstd / seqwr_3d strict", BM_strict_seqwr_3d);
+	bench.run("nonstd / seqwr_3d strict for_each_index", BM_strict_for_each_seqwr_3d);
 }
 // bench_seqwr_3d ENDS
 
@@ -155,6 +228,32 @@ void BM_nonstd_seqwr_4d() {
 	ankerl::nanobench::doNotOptimizeAway(arr);
 }
 
+void BM_strict_seqwr_4d() {
+	nstd::ndarray_strict<int, 16, 16, 16, 16> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	for (int i = 0; i < 16; i++) {
+		for (int j = 0; j < 16; j++) {
+			for (int k = 0; k < 16; k++) {
+				for (int m = 0; m < 16; m++) {
+					ankerl::nanobench::doNotOptimizeAway(arr[i][j][k][m]);
+					arr[i][j][k][m] = 0xcafebabe;
+				}
+			}
+		}
+	}
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
+void BM_strict_for_each_seqwr_4d() {
+	nstd::ndarray_strict<int, 16, 16, 16, 16> arr;
+	ankerl::nanobench::doNotOptimizeAway(arr);
+	nstd::for_each_index(arr, [](int &v, auto...) {
+		ankerl::nanobench::doNotOptimizeAway(v);
+		v = 0xcafebabe;
+	});
+	ankerl::nanobench::doNotOptimizeAway(arr);
+}
+
 TEST_CASE("bench_seqwr_4d") {
 	auto bench = ankerl::nanobench::Bench();
 	bench.title("bench_seqwr_4d")
@@ -165,6 +264,8 @@ TEST_CASE("bench_seqwr_4d") {
 
 	bench.run("plain / seqwr_4d", BM_plain_seqwr_4d);
 	bench.run("nonstd / seqwr_4d", BM_nonstd_seqwr_4d);
+	bench.run("nonstd / seqwr_4d strict", BM_strict_seqwr_4d);
+	bench.run("nonstd / seqwr_4d strict for_each_index", BM_strict_for_each_seqwr_4d);
 }
 // bench_seqwr_4d ENDS
 
@@ -0,0 +1,111 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <container/nstd_small_vector.h>
+#include <container/nstd_static_vector.h>
+
+#include <vector>
+
+ankerl::nanobench::Rng rng;
+
+// a short-lived "neighbor list": up to 16 entries, usually a handful
+template<typename Vec>
+void fill_and_sum(Vec &vec, int n) {
+	for (int i = 0; i < n; i++) {
+		vec.push_back(i);
+	}
+	int sum = 0;
+	for (int x : vec) {
+		sum += x;
+	}
+	ankerl::nanobench::doNotOptimizeAway(sum);
+}
+
+// bench_small_push BEGINS
+void BM_std_small_push() {
+	std::vector<int> vec;
+	fill_and_sum(vec, 1 + static_cast<int>(rng.bounded(8)));
+}
+
+void BM_static_vector_small_push() {
+	nstd::static_vector<int, 16> vec;
+	fill_and_sum(vec, 1 + static_cast<int>(rng.bounded(8)));
+}
+
+void BM_small_vector_small_push() {
+	nstd::small_vector<int, 8> vec;
+	fill_and_sum(vec, 1 + static_cast<int>(rng.bounded(8)));
+}
+
+TEST_CASE("bench_small_push") {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_small_push")
+	    .warmup(100)
+	    .minEpochIterations(10000)
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("std::vector / small_push", BM_std_small_push);
+	bench.run("nonstd::static_vector / small_push", BM_static_vector_small_push);
+	bench.run("nonstd::small_vector / small_push", BM_small_vector_small_push);
+}
+// bench_small_push ENDS
+
+// bench_spill_push BEGINS
+void BM_std_spill_push() {
+	std::vector<int> vec;
+	fill_and_sum(vec, 64);
+}
+
+void BM_small_vector_spill_push() {
+	nstd::small_vector<int, 8> vec;
+	fill_and_sum(vec, 64);
+}
+
+TEST_CASE("bench_spill_push") {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_spill_push")
+	    .warmup(100)
+	    .minEpochIterations(10000)
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("std::vector / spill_push", BM_std_spill_push);
+	bench.run("nonstd::small_vector / spill_push", BM_small_vector_spill_push);
+}
+// bench_spill_push ENDS
+
+// bench_move BEGINS
+struct contact {
+	float _Point[3];
+	float _Normal[3];
+	float _Depth;
+};
+
+void BM_std_move() {
+	std::vector<contact> src(4);
+	std::vector<contact> dst(static_cast<std::vector<contact> &&>(src));
+	ankerl::nanobench::doNotOptimizeAway(dst);
+}
+
+void BM_small_vector_move() {
+	nstd::small_vector<contact, 8> src(4);
+	nstd::small_vector<contact, 8> dst(static_cast<nstd::small_vector<contact, 8> &&>(src));
+	ankerl::nanobench::doNotOptimizeAway(dst);
+}
+
+TEST_CASE("bench_move") {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_move")
+	    .warmup(100)
+	    .minEpochIterations(10000)
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("std::vector / move", BM_std_move);
+	bench.run("nonstd::small_vector / move", BM_small_vector_move);
+}
+// bench_move ENDS
@@ -0,0 +1,99 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <io/nstd_serialize.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// a simulation checkpoint: 100K 4x4 transforms
+constexpr nstd::size_t mat_count = 100'000;
+
+using mat4 = nstd::linalg::matrix4f;
+
+const std::string &checkpoint_path() {
+	static const std::string path = (std::filesystem::temp_directory_path() / "nstd_bench_checkpoint.bin").string();
+	return path;
+}
+
+std::vector<mat4> make_state() {
+	std::vector<mat4> res;
+	res.reserve(mat_count);
+	for (nstd::size_t i = 0; i < mat_count; i++) {
+		res.emplace_back(static_cast<float>(i));
+	}
+	return res;
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(mat_count * sizeof(mat4))
+	    .unit("byte")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// bench_checkpoint_write BEGINS
+TEST_CASE("bench_checkpoint_write") {
+	const auto state = make_state();
+	auto bench = make_bench("bench_checkpoint_write");
+
+	bench.run("hand-written loop / checkpoint_write", [&]() {
+		nstd::file f(checkpoint_path().c_str(), nstd::open_mode::create);
+		nstd::size_t offset = 0;
+		for (const auto &mat : state) {
+			f.write_at(mat.data(), sizeof(mat4), offset);
+			offset += sizeof(mat4);
+		}
+	});
+	bench.run("staging buffer / checkpoint_write", [&]() {
+		nstd::file f(checkpoint_path().c_str(), nstd::open_mode::create);
+		std::vector<unsigned char> staging(state.size() * sizeof(mat4));
+		for (nstd::size_t i = 0; i < state.size(); i++) {
+			std::memcpy(staging.data() + i * sizeof(mat4), state[i].data(), sizeof(mat4));
+		}
+		f.write_at(staging.data(), staging.size(), 0);
+	});
+	bench.run("nonstd::binary_writer / checkpoint_write", [&]() {
+		nstd::file f(checkpoint_path().c_str(), nstd::open_mode::create);
+		nstd::binary_writer(f).write(state.data(), state.size());
+	});
+}
+// bench_checkpoint_write ENDS
+
+// bench_checkpoint_read BEGINS
+TEST_CASE("bench_checkpoint_read") {
+	{
+		const auto state = make_state();
+		nstd::file f(checkpoint_path().c_str(), nstd::open_mode::create);
+		nstd::binary_writer(f).write(state.data(), state.size());
+	}
+	std::vector<mat4> loaded(mat_count);
+	auto bench = make_bench("bench_checkpoint_read");
+
+	bench.run("hand-written loop / checkpoint_read", [&]() {
+		const nstd::file f(checkpoint_path().c_str(), nstd::open_mode::read);
+		nstd::size_t offset = sizeof(nstd::blob_header);
+		for (auto &mat : loaded) {
+			f.read_at(mat.data(), sizeof(mat4), offset);
+			offset += sizeof(mat4);
+		}
+	});
+	bench.run("nonstd::binary_reader / checkpoint_read", [&]() {
+		const nstd::file f(checkpoint_path().c_str(), nstd::open_mode::read);
+		nstd::binary_reader(f).read(loaded.data(), loaded.size());
+	});
+	ankerl::nanobench::doNotOptimizeAway(loaded);
+	std::filesystem::remove(checkpoint_path());
+}
+// bench_checkpoint_read ENDS
@@ -0,0 +1,127 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/linalg/nstd_dmatrix.h>
+#include <util/nstd_simd.h>
+
+#include <Eigen/Dense>
+
+#include <string>
+
+// the regression workload: a 10000 x 200 feature matrix
+constexpr nstd::size_t samples = 10000;
+constexpr nstd::size_t features = 200;
+
+nstd::linalg::dmatrixf to_nonstd(const Eigen::MatrixXf &mat) {
+	nstd::linalg::dmatrixf res(mat.rows(), mat.cols());
+	for (Eigen::Index i = 0; i < mat.rows(); i++) {
+		for (Eigen::Index j = 0; j < mat.cols(); j++) {
+			res[i][j] = mat(i, j);
+		}
+	}
+	return res;
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double flops) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title + " (" + nstd::simd_isa + ")")
+	    .warmup(3)
+	    .minEpochIterations(3)
+	    .batch(flops)
+	    .unit("flop")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// bench_dmatrix_gemm BEGINS
+void run_gemm(nstd::size_t n) {
+	const Eigen::MatrixXf ea = Eigen::MatrixXf::Random(n, n), eb = Eigen::MatrixXf::Random(n, n);
+	Eigen::MatrixXf ec(n, n);
+	const auto a = to_nonstd(ea), b = to_nonstd(eb);
+
+	auto bench = make_bench("bench_dmatrix_gemm / " + std::to_string(n), 2.0 * n * n * n);
+	bench.run("eigen / MatrixXf * MatrixXf", [&] {
+		ec.noalias() = ea * eb;
+		ankerl::nanobench::doNotOptimizeAway(ec(0, 0));
+	});
+	bench.run("nonstd / dmatrixf * dmatrixf", [&] {
+		ankerl::nanobench::doNotOptimizeAway((a * b)[0][0]);
+	});
+}
+
+TEST_CASE("bench_dmatrix_gemm") {
+	run_gemm(64);
+	run_gemm(256);
+	run_gemm(1024);
+}
+// bench_dmatrix_gemm ENDS
+
+// bench_dmatrix_gram BEGINS
+// X^T X of the feature matrix, the normal-equations hot spot
+TEST_CASE("bench_dmatrix_gram") {
+	const Eigen::MatrixXf ex = Eigen::MatrixXf::Random(samples, features);
+	Eigen::MatrixXf gram(features, features);
+	const auto x = to_nonstd(ex);
+	const auto xt = x.transpose();
+
+	auto bench = make_bench("bench_dmatrix_gram", 2.0 * samples * features * features);
+	bench.run("eigen / X^T X", [&] {
+		gram.noalias() = ex.transpose() * ex;
+		ankerl::nanobench::doNotOptimizeAway(gram(0, 0));
+	});
+	bench.run("nonstd / X^T X", [&] {
+		ankerl::nanobench::doNotOptimizeAway((xt * x)[0][0]);
+	});
+}
+// bench_dmatrix_gram ENDS
+
+// bench_dmatrix_gemv BEGINS
+TEST_CASE("bench_dmatrix_gemv") {
+	const Eigen::MatrixXf ex = Eigen::MatrixXf::Random(samples, features);
+	const Eigen::VectorXf ew = Eigen::VectorXf::Random(features);
+	Eigen::VectorXf ey(samples);
+	const auto x = to_nonstd(ex);
+	nstd::linalg::dvectorf w(features);
+	for (nstd::size_t i = 0; i < features; i++) {
+		w[i] = ew[i];
+	}
+
+	auto bench = make_bench("bench_dmatrix_gemv", 2.0 * samples * features);
+	bench.run("eigen / X * w", [&] {
+		ey.noalias() = ex * ew;
+		ankerl::nanobench::doNotOptimizeAway(ey[0]);
+	});
+	bench.run("nonstd / X * w", [&] {
+		ankerl::nanobench::doNotOptimizeAway((x * w)[0]);
+	});
+}
+// bench_dmatrix_gemv ENDS
+
+// bench_dmatrix_add BEGINS
+TEST_CASE("bench_dmatrix_add") {
+	const Eigen::MatrixXf ea = Eigen::MatrixXf::Random(samples, features), eb = Eigen::MatrixXf::Random(samples, features);
+	Eigen::MatrixXf ec = ea;
+	const auto a = to_nonstd(ea), b = to_nonstd(eb);
+	auto c = a;
+
+	auto bench = make_bench("bench_dmatrix_add", static_cast<double>(samples * features));
+	bench.run("eigen / a + b (allocating)", [&] {
+		ankerl::nanobench::doNotOptimizeAway((ea + eb).eval()(0, 0));
+	});
+	bench.run("nonstd / a + b (allocating)", [&] {
+		ankerl::nanobench::doNotOptimizeAway((a + b)[0][0]);
+	});
+	bench.run("eigen / c += b", [&] {
+		ec += eb;
+		ankerl::nanobench::doNotOptimizeAway(ec(0, 0));
+	});
+	bench.run("nonstd / c += b", [&] {
+		c += b;
+		ankerl::nanobench::doNotOptimizeAway(c[0][0]);
+	});
+}
+// bench_dmatrix_add ENDS
@@ -4,11 +4,20 @@
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
 
+#include <math/linalg/nstd_dmatrix.h>
 #include <math/linalg/nstd_vector.h>
+#include <math/nstd_dispatch.h>
+#include <util/nstd_thread_pool.h>
 
 #include <glm/glm.hpp>
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
 // bench_matrix_add BEGINS
 void BM_nonstd_matrix_add() {
 	nstd::linalg::matrix2f mat2f_a(1.0f, 2.0f, 3.0f, 4.0f), mat2f_b(1.0f, 2.0f, 3.0f, 4.0f);
@@ -106,3 +115,41 @@ TEST_CASE("bench_matrix_mul") {
 	bench.run("nonstd / matrix_mul", BM_nonstd_matrix_mul);
 }
 // bench_matrix_mul ENDS
+
+// bench_matrix_mul_parallel BEGINS
+TEST_CASE("bench_matrix_mul_parallel") {
+	// thread counts 1, 2, 4, ... up to every hardware thread
+	std::vector<nstd::size_t> counts;
+	const nstd::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+	for (nstd::size_t t = 1; t < cores; t *= 2) {
+		counts.push_back(t);
+	}
+	counts.push_back(cores);
+
+	for (nstd::size_t n : { 512, 2048 }) {
+		std::mt19937 engine(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		nstd::linalg::dmatrix<float> a(n, n), b(n, n), c(n, n);
+		for (nstd::size_t i = 0; i < n * n; i++) {
+			a.data()[i] = dist(engine);
+			b.data()[i] = dist(engine);
+		}
+
+		auto bench = ankerl::nanobench::Bench();
+		bench.title("bench_matrix_mul_parallel / " + std::to_string(n))
+		    .warmup(1)
+		    .minEpochIterations(2)
+		    .batch(2.0 * n * n * n)
+		    .unit("flop")
+		    .performanceCounters(true)
+		    .relative(true);
+		for (nstd::size_t threads : counts) {
+			nstd::thread_pool pool(threads);
+			bench.run("nonstd / gemm " + std::to_string(threads) + " threads", [&] {
+				nstd::dispatch::gemm(n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n, pool);
+				ankerl::nanobench::doNotOptimizeAway(c.data()[0]);
+			});
+		}
+	}
+}
+// bench_matrix_mul_parallel ENDS
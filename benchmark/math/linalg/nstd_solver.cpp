@@ -0,0 +1,147 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/linalg/nstd_solver.h>
+#include <util/nstd_thread_pool.h>
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+
+#include <string>
+#include <vector>
+
+// a pressure Poisson solve on a 256 x 256 grid (65536 unknowns), warm buffers, zero initial guess every time
+constexpr nstd::size_t grid = 256;
+constexpr nstd::size_t rows = grid * grid;
+constexpr float tolerance = 1e-5f;
+constexpr nstd::size_t max_iterations = 2000;
+
+using eigen_csr = Eigen::SparseMatrix<float, Eigen::RowMajor>;
+
+struct problem {
+	nstd::linalg::csr_matrixf _Matrix;
+	eigen_csr _Ref;
+	Eigen::VectorXf _Rhs;
+};
+
+// 5-point Laplacian, convection > 0 adds an upwinded term and makes the matrix nonsymmetric
+problem make_problem(float convection) {
+	nstd::linalg::coo_matrixf coo(rows, rows);
+	std::vector<Eigen::Triplet<float>> triplets;
+	auto push = [&](nstd::size_t r, nstd::size_t c, float v) {
+		coo.push_back(r, c, v);
+		triplets.emplace_back(static_cast<int>(r), static_cast<int>(c), v);
+	};
+	for (nstd::size_t i = 0; i < grid; i++) {
+		for (nstd::size_t j = 0; j < grid; j++) {
+			const nstd::size_t r = i * grid + j;
+			push(r, r, 4.0f + convection);
+			if (i > 0) {
+				push(r, r - grid, -1.0f - convection);
+			}
+			if (i + 1 < grid) {
+				push(r, r + grid, -1.0f);
+			}
+			if (j > 0) {
+				push(r, r - 1, -1.0f);
+			}
+			if (j + 1 < grid) {
+				push(r, r + 1, -1.0f);
+			}
+		}
+	}
+	problem res;
+	res._Matrix = coo.to_csr();
+	res._Ref.resize(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(rows));
+	res._Ref.setFromTriplets(triplets.begin(), triplets.end());
+	res._Rhs = Eigen::VectorXf::Random(static_cast<Eigen::Index>(rows));
+	return res;
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .unit("solve")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+template<typename Solver>
+void run_eigen(ankerl::nanobench::Bench &bench, const std::string &name, const problem &p, Solver &solver) {
+	solver.setTolerance(tolerance);
+	solver.setMaxIterations(static_cast<Eigen::Index>(max_iterations));
+	solver.compute(p._Ref);
+	Eigen::VectorXf x(static_cast<Eigen::Index>(rows));
+	bench.run(name, [&] {
+		x.setZero();
+		x = solver.solveWithGuess(p._Rhs, x);
+		ankerl::nanobench::doNotOptimizeAway(x[0]);
+	});
+}
+
+template<typename Solver, typename Op, typename Pre>
+void run_nonstd(ankerl::nanobench::Bench &bench, const std::string &name, const problem &p, Solver &solver, const Op &op, const Pre &pre) {
+	std::vector<float> x(rows);
+	bench.run(name, [&] {
+		std::fill(x.begin(), x.end(), 0.0f);
+		ankerl::nanobench::doNotOptimizeAway(solver.solve(op, p._Rhs.data(), x.data(), pre)._Iterations);
+	});
+}
+
+// bench_solver_cg BEGINS
+TEST_CASE("bench_solver_cg") {
+	const problem p = make_problem(0.0f);
+	auto &pool = nstd::thread_pool::global();
+	auto bench = make_bench("bench_solver_cg");
+
+	Eigen::ConjugateGradient<eigen_csr, Eigen::Lower | Eigen::Upper> eigen_jacobi;
+	run_eigen(bench, "eigen / cg + jacobi", p, eigen_jacobi);
+	Eigen::ConjugateGradient<eigen_csr, Eigen::Lower | Eigen::Upper, Eigen::IncompleteCholesky<float>> eigen_ic;
+	run_eigen(bench, "eigen / cg + incomplete cholesky", p, eigen_ic);
+
+	nstd::linalg::conjugate_gradient<float> cg({ max_iterations, tolerance });
+	const nstd::linalg::jacobi_preconditioner<float> jacobi(p._Matrix);
+	const nstd::linalg::ic0_preconditioner<float> ic0(p._Matrix);
+	const nstd::linalg::threaded_csr<float> threaded(p._Matrix, pool);
+	run_nonstd(bench, "nonstd / cg + jacobi", p, cg, p._Matrix, jacobi);
+	run_nonstd(bench, "nonstd / cg + ic0", p, cg, p._Matrix, ic0);
+	run_nonstd(bench, "nonstd / cg + jacobi (" + std::to_string(pool.size()) + " threads)", p, cg, threaded, jacobi);
+}
+// bench_solver_cg ENDS
+
+// bench_solver_bicgstab BEGINS
+TEST_CASE("bench_solver_bicgstab") {
+	const problem p = make_problem(1.0f);
+	auto bench = make_bench("bench_solver_bicgstab");
+
+	Eigen::BiCGSTAB<eigen_csr> eigen_jacobi;
+	run_eigen(bench, "eigen / bicgstab + jacobi", p, eigen_jacobi);
+
+	nstd::linalg::bicgstab<float> solver({ max_iterations, tolerance });
+	run_nonstd(bench, "nonstd / bicgstab + jacobi", p, solver, p._Matrix, nstd::linalg::jacobi_preconditioner<float>(p._Matrix));
+}
+// bench_solver_bicgstab ENDS
+
+// bench_solver_setup BEGINS
+TEST_CASE("bench_solver_setup") {
+	const problem p = make_problem(0.0f);
+	auto bench = make_bench("bench_solver_setup");
+	bench.unit("factorization");
+
+	bench.run("eigen / incomplete cholesky", [&] {
+		Eigen::IncompleteCholesky<float> ic(p._Ref);
+		ankerl::nanobench::doNotOptimizeAway(ic.info());
+	});
+	bench.run("nonstd / ic0", [&] {
+		nstd::linalg::ic0_preconditioner<float> ic(p._Matrix);
+		ankerl::nanobench::doNotOptimizeAway(ic.factor().nnz());
+	});
+}
+// bench_solver_setup ENDS
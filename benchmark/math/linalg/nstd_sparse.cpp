@@ -0,0 +1,155 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/linalg/nstd_sparse.h>
+#include <util/nstd_thread_pool.h>
+
+#include <Eigen/Sparse>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// a 5-point Laplacian on a 512 x 512 grid (262144 rows, ~1.3M nonzeros) and a scattered matrix of the same size
+constexpr nstd::size_t grid = 512;
+constexpr nstd::size_t rows = grid * grid;
+constexpr nstd::size_t scattered_per_row = 5;
+constexpr nstd::size_t block_cols = 8;
+
+using eigen_csr = Eigen::SparseMatrix<float, Eigen::RowMajor>;
+
+struct problem {
+	nstd::linalg::coo_matrixf _Coo{ rows, rows };
+	std::vector<Eigen::Triplet<float>> _Triplets;
+};
+
+// triplets are emitted column-major per stencil arm, so the builder really has to sort
+problem make_laplacian() {
+	problem res;
+	res._Coo.reserve(rows * 5);
+	const long long offsets[5][2] = { { 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+	for (const auto &o : offsets) {
+		for (nstd::size_t j = 0; j < grid; j++) {
+			for (nstd::size_t i = 0; i < grid; i++) {
+				const long long ni = static_cast<long long>(i) + o[0], nj = static_cast<long long>(j) + o[1];
+				if (ni < 0 || nj < 0 || ni >= static_cast<long long>(grid) || nj >= static_cast<long long>(grid)) {
+					continue;
+				}
+				const nstd::size_t r = i * grid + j, c = static_cast<nstd::size_t>(ni) * grid + static_cast<nstd::size_t>(nj);
+				const float v = o[0] == 0 && o[1] == 0 ? 4.0f : -1.0f;
+				res._Coo.push_back(r, c, v);
+				res._Triplets.emplace_back(static_cast<int>(r), static_cast<int>(c), v);
+			}
+		}
+	}
+	return res;
+}
+
+problem make_scattered() {
+	problem res;
+	std::mt19937_64 engine(7);
+	std::uniform_int_distribution<nstd::size_t> col(0, rows - 1);
+	res._Coo.reserve(rows * scattered_per_row);
+	for (nstd::size_t r = 0; r < rows; r++) {
+		for (nstd::size_t k = 0; k < scattered_per_row; k++) {
+			const nstd::size_t c = col(engine);
+			res._Coo.push_back(r, c, 1.0f);
+			res._Triplets.emplace_back(static_cast<int>(r), static_cast<int>(c), 1.0f);
+		}
+	}
+	return res;
+}
+
+eigen_csr to_eigen(const problem &p) {
+	eigen_csr res(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(rows));
+	res.setFromTriplets(p._Triplets.begin(), p._Triplets.end());
+	return res;
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title, nstd::size_t batch, const char *unit) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(3)
+	    .minEpochIterations(5)
+	    .batch(batch)
+	    .unit(unit)
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// bench_sparse_build BEGINS
+TEST_CASE("bench_sparse_build") {
+	const problem p = make_laplacian();
+	auto bench = make_bench("bench_sparse_build", p._Triplets.size(), "triplet");
+	bench.minEpochIterations(1).epochs(5);
+
+	bench.run("eigen / setFromTriplets", [&] {
+		ankerl::nanobench::doNotOptimizeAway(to_eigen(p).nonZeros());
+	});
+	bench.run("nonstd / coo -> csr", [&] {
+		ankerl::nanobench::doNotOptimizeAway(p._Coo.to_csr().nnz());
+	});
+	bench.run("nonstd / coo -> csc", [&] {
+		ankerl::nanobench::doNotOptimizeAway(p._Coo.to_csc().nnz());
+	});
+}
+// bench_sparse_build ENDS
+
+// bench_sparse_spmv BEGINS
+void run_spmv(const std::string &title, const problem &p) {
+	const eigen_csr ref = to_eigen(p);
+	const auto csr = p._Coo.to_csr();
+	Eigen::VectorXf x = Eigen::VectorXf::Random(static_cast<Eigen::Index>(rows));
+	Eigen::VectorXf y(static_cast<Eigen::Index>(rows));
+	auto &pool = nstd::thread_pool::global();
+
+	auto bench = make_bench(title, csr.nnz(), "nonzero");
+	bench.run("eigen / spmv", [&] {
+		y.noalias() = ref * x;
+		ankerl::nanobench::doNotOptimizeAway(y[0]);
+	});
+	bench.run("nonstd / spmv", [&] {
+		nstd::linalg::spmv(csr, x.data(), y.data());
+		ankerl::nanobench::doNotOptimizeAway(y[0]);
+	});
+	bench.run("nonstd / spmv (" + std::to_string(pool.size()) + " threads)", [&] {
+		nstd::linalg::spmv(csr, x.data(), y.data(), pool);
+		ankerl::nanobench::doNotOptimizeAway(y[0]);
+	});
+}
+
+TEST_CASE("bench_sparse_spmv") {
+	run_spmv("bench_sparse_spmv / laplacian", make_laplacian());
+	run_spmv("bench_sparse_spmv / scattered", make_scattered());
+}
+// bench_sparse_spmv ENDS
+
+// bench_sparse_spmm BEGINS
+TEST_CASE("bench_sparse_spmm") {
+	const problem p = make_laplacian();
+	const eigen_csr ref = to_eigen(p);
+	const auto csr = p._Coo.to_csr();
+	using dense = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+	const dense b = dense::Random(static_cast<Eigen::Index>(rows), block_cols);
+	dense c(static_cast<Eigen::Index>(rows), block_cols);
+	auto &pool = nstd::thread_pool::global();
+
+	auto bench = make_bench("bench_sparse_spmm", csr.nnz() * block_cols, "madd");
+	bench.run("eigen / spmm", [&] {
+		c.noalias() = ref * b;
+		ankerl::nanobench::doNotOptimizeAway(c(0, 0));
+	});
+	bench.run("nonstd / spmm", [&] {
+		nstd::linalg::spmm(csr, b.data(), block_cols, c.data());
+		ankerl::nanobench::doNotOptimizeAway(c(0, 0));
+	});
+	bench.run("nonstd / spmm (" + std::to_string(pool.size()) + " threads)", [&] {
+		nstd::linalg::spmm(csr, b.data(), block_cols, c.data(), pool);
+		ankerl::nanobench::doNotOptimizeAway(c(0, 0));
+	});
+}
+// bench_sparse_spmm ENDS
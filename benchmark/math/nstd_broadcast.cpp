@@ -0,0 +1,73 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_broadcast.h>
+
+#include <memory>
+#include <random>
+#include <string>
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double flops) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(3)
+	    .minEpochIterations(3)
+	    .batch(flops)
+	    .unit("flop")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+template<typename Arr>
+std::unique_ptr<Arr> random_array(float lo, float hi) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> dist(lo, hi);
+	auto res = std::make_unique<Arr>();
+	for (auto &v : *res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+// bench_broadcast_normalize BEGINS
+TEST_CASE("bench_broadcast_normalize") {
+	constexpr nstd::size_t R = 512, C = 1024;
+	const auto x = random_array<nstd::ndarray<float, R, C>>(-1.0f, 1.0f);
+	const auto mean = random_array<nstd::ndarray<float, R, 1>>(-0.1f, 0.1f);
+	const auto scale = random_array<nstd::ndarray<float, C>>(0.5f, 2.0f);
+	auto y = std::make_unique<nstd::ndarray<float, R, C>>();
+	auto centered = std::make_unique<nstd::ndarray<float, R, C>>();
+	auto expanded = std::make_unique<nstd::ndarray<float, R, C>>();
+
+	auto bench = make_bench("bench_broadcast_normalize (x - row_mean) / col_scale 512 x 1024", 2.0 * R * C);
+	bench.run("plain / two temporaries", [&] {
+		// what the normalization did before: materialize the centered array and the expanded scale
+		for (nstd::size_t i = 0; i < R; i++) {
+			for (nstd::size_t j = 0; j < C; j++) {
+				(*centered)[i][j] = (*x)[i][j] - (*mean)[i][0];
+				(*expanded)[i][j] = (*scale)[j];
+			}
+		}
+		for (nstd::size_t i = 0; i < R * C; i++) {
+			y->data()[i] = centered->data()[i] / expanded->data()[i];
+		}
+		ankerl::nanobench::doNotOptimizeAway(y->data()[0]);
+	});
+	bench.run("plain / fused loop", [&] {
+		for (nstd::size_t i = 0; i < R; i++) {
+			for (nstd::size_t j = 0; j < C; j++) {
+				(*y)[i][j] = ((*x)[i][j] - (*mean)[i][0]) / (*scale)[j];
+			}
+		}
+		ankerl::nanobench::doNotOptimizeAway(y->data()[0]);
+	});
+	bench.run("nonstd / assign(y, (x - mean) / scale)", [&] {
+		nstd::assign(*y, (*x - *mean) / *scale);
+		ankerl::nanobench::doNotOptimizeAway(y->data()[0]);
+	});
+}
+// bench_broadcast_normalize ENDS
@@ -0,0 +1,145 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_bvh.h>
+#include <util/nstd_thread_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double items, const std::string &unit) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(3)
+	    .batch(items)
+	    .unit(unit)
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// boxes of about the same size spread through a cube that grows with n, so that the density stays the same
+std::vector<nstd::aabb> random_boxes(nstd::size_t n) {
+	std::mt19937 engine(1);
+	const float side = 10.0f * std::cbrt(static_cast<float>(n));
+	std::uniform_real_distribution<float> pos(-side, side), size(0.1f, 2.0f);
+	std::vector<nstd::aabb> res(n);
+	for (auto &box : res) {
+		for (nstd::size_t a = 0; a < 3; a++) {
+			box._Min[a] = pos(engine);
+			box._Max[a] = box._Min[a] + size(engine);
+		}
+	}
+	return res;
+}
+
+std::vector<nstd::ray> random_rays(nstd::size_t count, float side) {
+	std::mt19937 engine(2);
+	std::uniform_real_distribution<float> pos(-side, side), dir(-1.0f, 1.0f);
+	std::vector<nstd::ray> res(count);
+	for (auto &r : res) {
+		r = { nstd::linalg::vector3f(pos(engine), pos(engine), pos(engine)), nstd::linalg::vector3f(dir(engine), dir(engine), dir(engine)) };
+	}
+	return res;
+}
+
+// bench_bvh_build BEGINS
+TEST_CASE("bench_bvh_build") {
+	nstd::thread_pool &pool = nstd::thread_pool::global();
+	nstd::thread_pool single(1);
+	for (nstd::size_t n : { nstd::size_t(100000), nstd::size_t(1000000), nstd::size_t(10000000) }) {
+		const auto boxes = random_boxes(n);
+		auto bench = make_bench("bench_bvh_build / " + std::to_string(n), static_cast<double>(n), "primitive");
+		bench.run("nonstd / bvh one thread", [&] { ankerl::nanobench::doNotOptimizeAway(nstd::bvh(boxes.data(), n, single).nodes().size()); });
+		bench.run("nonstd / bvh " + std::to_string(pool.size()) + " threads", [&] {
+			ankerl::nanobench::doNotOptimizeAway(nstd::bvh(boxes.data(), n, pool).nodes().size());
+		});
+		bench.run("nonstd / bvh4 " + std::to_string(pool.size()) + " threads", [&] {
+			ankerl::nanobench::doNotOptimizeAway(nstd::bvh4(boxes.data(), n, pool).nodes().size());
+		});
+		nstd::bvh tree(boxes.data(), n, pool);
+		bench.run("nonstd / bvh refit", [&] {
+			tree.refit(boxes.data());
+			ankerl::nanobench::doNotOptimizeAway(tree.bounds()._Min[0]);
+		});
+	}
+}
+// bench_bvh_build ENDS
+
+// bench_bvh_query BEGINS
+TEST_CASE("bench_bvh_query") {
+	constexpr nstd::size_t queries = 10000;
+	for (nstd::size_t n : { nstd::size_t(100000), nstd::size_t(1000000), nstd::size_t(10000000) }) {
+		const auto boxes = random_boxes(n);
+		const float side = 10.0f * std::cbrt(static_cast<float>(n));
+		const auto rays = random_rays(queries, side);
+		const nstd::bvh wide(boxes.data(), n);
+		const nstd::bvh4 narrow(boxes.data(), n);
+
+		auto ray = make_bench("bench_bvh_query raycast / " + std::to_string(n), queries, "ray");
+		if (n == 100000) {
+			ray.batch(queries / 100);  // a hundredth of the rays, every box for each
+			ray.run("plain / every box", [&] {
+				float sum = 0.0f;
+				for (nstd::size_t q = 0; q < queries / 100; q++) {
+					const nstd::ray &r = rays[q];
+					float best = std::numeric_limits<float>::infinity();
+					for (const nstd::aabb &box : boxes) {
+						float near = r._TMin, far = r._TMax;
+						for (nstd::size_t a = 0; a < 3; a++) {
+							const float inv = 1.0f / r._Dir[a];
+							const float t0 = (box._Min[a] - r._Origin[a]) * inv, t1 = (box._Max[a] - r._Origin[a]) * inv;
+							near = std::max(near, std::min(t0, t1));
+							far = std::min(far, std::max(t0, t1));
+						}
+						best = near <= far ? std::min(best, near) : best;
+					}
+					sum += best;
+				}
+				ankerl::nanobench::doNotOptimizeAway(sum);
+			});
+			ray.batch(queries);
+		}
+		ray.run("nonstd / bvh", [&] {
+			float sum = 0.0f;
+			for (const nstd::ray &r : rays) {
+				sum += wide.raycast(r)._Dist;
+			}
+			ankerl::nanobench::doNotOptimizeAway(sum);
+		});
+		ray.run("nonstd / bvh4", [&] {
+			float sum = 0.0f;
+			for (const nstd::ray &r : rays) {
+				sum += narrow.raycast(r)._Dist;
+			}
+			ankerl::nanobench::doNotOptimizeAway(sum);
+		});
+
+		auto near = make_bench("bench_bvh_query nearest / " + std::to_string(n), queries, "point");
+		near.run("nonstd / bvh", [&] {
+			float sum = 0.0f;
+			for (const nstd::ray &r : rays) {
+				sum += wide.nearest(r._Origin)._Dist;
+			}
+			ankerl::nanobench::doNotOptimizeAway(sum);
+		});
+		near.run("nonstd / bvh4", [&] {
+			float sum = 0.0f;
+			for (const nstd::ray &r : rays) {
+				sum += narrow.nearest(r._Origin)._Dist;
+			}
+			ankerl::nanobench::doNotOptimizeAway(sum);
+		});
+	}
+}
+// bench_bvh_query ENDS
@@ -0,0 +1,136 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_convolve.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// a 2048^2 float image (16 MiB), well past L2
+constexpr nstd::size_t n = 2048;
+constexpr nstd::size_t pixels = n * n;
+constexpr nstd::size_t extents[] = { n, n };
+
+struct images {
+	std::vector<float> _In, _Out;
+
+	images()
+	    : _In(pixels), _Out(pixels) {
+		std::mt19937 engine(1);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+		for (float &v : _In) {
+			v = dist(engine);
+		}
+	}
+
+	nstd::strided_view<const float, 2> in() const {
+		return { _In.data(), extents };
+	}
+
+	nstd::strided_view<float, 2> out() {
+		return { _Out.data(), extents };
+	}
+};
+
+ankerl::nanobench::Bench make_bench(const std::string &title) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(pixels)
+	    .unit("pixel")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// the hand-written version: clamped taps, boundary branches inside the innermost loop
+void handwritten(const float *in, float *out, const float *kernel, long long k) {
+	const long long m = static_cast<long long>(n), c = k / 2;
+	for (long long i = 0; i < m; i++) {
+		for (long long j = 0; j < m; j++) {
+			float acc = 0.0f;
+			for (long long a = 0; a < k; a++) {
+				for (long long b = 0; b < k; b++) {
+					long long x = i + a - c, y = j + b - c;
+					x = x < 0 ? 0 : (x >= m ? m - 1 : x);
+					y = y < 0 ? 0 : (y >= m ? m - 1 : y);
+					acc += kernel[a * k + b] * in[x * m + y];
+				}
+			}
+			out[i * m + j] = acc;
+		}
+	}
+}
+
+// bench_convolve_small BEGINS
+TEST_CASE("bench_convolve_small") {
+	images img;
+	const float sharpen[] = { 0.0f, -1.0f, 0.0f, -1.0f, 5.0f, -1.0f, 0.0f, -1.0f, 0.0f };  // not separable
+	const nstd::size_t k33[] = { 3, 3 };
+	auto bench = make_bench("bench_convolve_small");
+	bench.run("plain / branchy 3x3 loop", [&] {
+		handwritten(img._In.data(), img._Out.data(), sharpen, 3);
+		ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+	});
+	bench.run("nonstd / correlate 3x3 (direct)", [&] {
+		nstd::correlate(img.in(), img.out(), nstd::strided_view<const float, 2>(sharpen, k33));
+		ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+	});
+}
+// bench_convolve_small ENDS
+
+// bench_convolve_gaussian BEGINS
+TEST_CASE("bench_convolve_gaussian") {
+	images img;
+	auto bench = make_bench("bench_convolve_gaussian");
+	for (double sigma : { 1.0, 2.0, 4.0 }) {
+		const std::vector<float> g = nstd::gaussian_kernel(static_cast<float>(sigma));
+		const nstd::size_t k = g.size(), kk[] = { k, k };
+		std::vector<float> kernel(k * k);
+		for (nstd::size_t i = 0; i < k; i++) {
+			for (nstd::size_t j = 0; j < k; j++) {
+				kernel[i * k + j] = g[i] * g[j];
+			}
+		}
+		const std::string size = std::to_string(k) + "x" + std::to_string(k);
+		bench.run("plain / branchy " + size + " loop", [&] {
+			handwritten(img._In.data(), img._Out.data(), kernel.data(), static_cast<long long>(k));
+			ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+		});
+		bench.run("nonstd / correlate " + size + " (detected separable)", [&] {
+			nstd::correlate(img.in(), img.out(), nstd::strided_view<const float, 2>(kernel.data(), kk));
+			ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+		});
+		bench.run("nonstd / gaussian_filter sigma " + std::to_string(static_cast<int>(sigma)), [&] {
+			nstd::gaussian_filter(img.in(), img.out(), sigma);
+			ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+		});
+	}
+}
+// bench_convolve_gaussian ENDS
+
+// bench_box_filter BEGINS
+TEST_CASE("bench_box_filter") {
+	images img;
+	auto bench = make_bench("bench_box_filter");
+	for (nstd::size_t radius : { 1, 4, 16, 64 }) {
+		const std::string size = std::to_string(2 * radius + 1);
+		const std::vector<float> box(2 * radius + 1, 1.0f / static_cast<float>(2 * radius + 1));
+		const std::span<const float> kernels[] = { box, box };
+		bench.run("nonstd / separable_filter " + size + "x" + size, [&] {
+			nstd::separable_filter(img.in(), img.out(), kernels);
+			ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+		});
+		bench.run("nonstd / box_filter " + size + "x" + size + " (running sum)", [&] {
+			nstd::box_filter(img.in(), img.out(), radius);
+			ankerl::nanobench::doNotOptimizeAway(img._Out[pixels / 2]);
+		});
+	}
+}
+// bench_box_filter ENDS
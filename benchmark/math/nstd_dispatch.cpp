@@ -0,0 +1,135 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_dispatch.h>
+#include <util/nstd_cpu.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr nstd::isa isas[] = { nstd::isa::scalar, nstd::isa::sse2, nstd::isa::avx2, nstd::isa::avx512 };
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double flops) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(3)
+	    .minEpochIterations(3)
+	    .batch(flops)
+	    .unit("flop")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+std::vector<float> random_vector(nstd::size_t n) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+template<typename Ty>
+std::vector<Ty> random_ints(nstd::size_t n, int lo, int hi) {
+	std::mt19937 engine(2);
+	std::uniform_int_distribution<int> dist(lo, hi);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = static_cast<Ty>(dist(engine));
+	}
+	return res;
+}
+
+// runs fn once per table the cpu can execute, the first (scalar) one is the baseline
+template<typename Fn>
+void for_each_table(ankerl::nanobench::Bench &bench, Fn &&fn) {
+	const nstd::isa initial = nstd::kernels()._Isa;
+	for (nstd::isa target : isas) {
+		if (nstd::kernels_for(target) != nullptr) {
+			nstd::select_kernels(target);
+			bench.run(std::string("nonstd / ") + nstd::isa_name(target), fn);
+		}
+	}
+	nstd::select_kernels(initial);
+}
+
+// bench_dispatch_reduce BEGINS
+TEST_CASE("bench_dispatch_reduce") {
+	constexpr nstd::size_t n = 1 << 16;
+	const auto x = random_vector(n), y = random_vector(n);
+	auto sum = make_bench("bench_dispatch_sum / " + std::to_string(n), n);
+	for_each_table(sum, [&] { ankerl::nanobench::doNotOptimizeAway(nstd::dispatch::sum(n, x.data())); });
+	auto dot = make_bench("bench_dispatch_dot / " + std::to_string(n), 2.0 * n);
+	for_each_table(dot, [&] { ankerl::nanobench::doNotOptimizeAway(nstd::dispatch::dot(n, x.data(), y.data())); });
+}
+// bench_dispatch_reduce ENDS
+
+// bench_dispatch_gemm BEGINS
+TEST_CASE("bench_dispatch_gemm") {
+	for (nstd::size_t n : { 128, 512 }) {
+		const auto a = random_vector(n * n), b = random_vector(n * n);
+		std::vector<float> c(n * n);
+		auto bench = make_bench("bench_dispatch_gemm / " + std::to_string(n), 2.0 * n * n * n);
+		for_each_table(bench, [&] {
+			nstd::dispatch::gemm(n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+			ankerl::nanobench::doNotOptimizeAway(c[0]);
+		});
+	}
+}
+// bench_dispatch_gemm ENDS
+
+// bench_dispatch_widening BEGINS
+TEST_CASE("bench_dispatch_widening") {
+	const nstd::isa initial = nstd::kernels()._Isa;
+	for (nstd::size_t n : { 128, 512 }) {
+		const auto a = random_vector(n * n), b = random_vector(n * n);
+		const auto a8 = random_ints<std::int8_t>(n * n, -128, 127), b8 = random_ints<std::int8_t>(n * n, -128, 127);
+		const auto a16 = random_ints<std::int16_t>(n * n, -32767, 32767), b16 = random_ints<std::int16_t>(n * n, -32767, 32767);
+		std::vector<float> c(n * n);
+		std::vector<std::int32_t> ci(n * n);
+
+		// the float gemm of the best table is the baseline, "flop" counts integer multiply-adds the same way
+		auto bench = make_bench("bench_dispatch_widening gemm / " + std::to_string(n), 2.0 * n * n * n);
+		bench.run(std::string("float / ") + nstd::isa_name(initial), [&] {
+			nstd::dispatch::gemm(n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+			ankerl::nanobench::doNotOptimizeAway(c[0]);
+		});
+		for (nstd::isa target : isas) {
+			if (nstd::kernels_for(target) == nullptr) {
+				continue;
+			}
+			nstd::select_kernels(target);
+			const std::string name = std::string(nstd::isa_name(target)) + (nstd::kernels()._Widening._Vnni ? "-vnni" : "");
+			bench.run("int8 / " + name, [&] {
+				nstd::dispatch::widening_gemm(n, n, n, a8.data(), n, b8.data(), n, ci.data(), n);
+				ankerl::nanobench::doNotOptimizeAway(ci[0]);
+			});
+			bench.run("int16 / " + name, [&] {
+				nstd::dispatch::widening_gemm(n, n, n, a16.data(), n, b16.data(), n, ci.data(), n);
+				ankerl::nanobench::doNotOptimizeAway(ci[0]);
+			});
+			bench.run("int16 saturating / " + name, [&] {
+				nstd::dispatch::widening_gemm(n, n, n, a16.data(), n, b16.data(), n, ci.data(), n, true);
+				ankerl::nanobench::doNotOptimizeAway(ci[0]);
+			});
+		}
+		nstd::select_kernels(initial);
+	}
+
+	constexpr nstd::size_t n = 1 << 16;
+	const auto x = random_vector(n), y = random_vector(n);
+	const auto x8 = random_ints<std::int8_t>(n, -128, 127), y8 = random_ints<std::int8_t>(n, -128, 127);
+	auto dot = make_bench("bench_dispatch_widening dot / " + std::to_string(n), 2.0 * n);
+	dot.run(std::string("float / ") + nstd::isa_name(initial), [&] { ankerl::nanobench::doNotOptimizeAway(nstd::dispatch::dot(n, x.data(), y.data())); });
+	dot.run(std::string("int8 / ") + nstd::isa_name(initial), [&] { ankerl::nanobench::doNotOptimizeAway(nstd::dispatch::widening_dot(n, x8.data(), y8.data())); });
+	dot.run(std::string("int8 saturating / ") + nstd::isa_name(initial),
+	        [&] { ankerl::nanobench::doNotOptimizeAway(nstd::dispatch::widening_dot(n, x8.data(), y8.data(), true)); });
+}
+// bench_dispatch_widening ENDS
@@ -0,0 +1,93 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_einsum.h>
+
+#include <memory>
+#include <random>
+#include <string>
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double flops) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(3)
+	    .minEpochIterations(3)
+	    .batch(flops)
+	    .unit("flop")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+template<typename Arr>
+std::unique_ptr<Arr> random_array() {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	auto res = std::make_unique<Arr>();
+	for (auto &v : *res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+// bench_einsum_batched_matmul BEGINS
+TEST_CASE("bench_einsum_batched_matmul") {
+	constexpr nstd::size_t B = 16, N = 128;
+	const auto a = random_array<nstd::ndarray<float, B, N, N>>();
+	const auto b = random_array<nstd::ndarray<float, B, N, N>>();
+	auto c = std::make_unique<nstd::ndarray<float, B, N, N>>();
+
+	auto bench = make_bench("bench_einsum_batched_matmul 16 x 128^3", 2.0 * B * N * N * N);
+	bench.run("plain / loop nest", [&] {
+		c->fill(0.0f);
+		for (nstd::size_t n = 0; n < B; n++) {
+			for (nstd::size_t i = 0; i < N; i++) {
+				for (nstd::size_t j = 0; j < N; j++) {
+					for (nstd::size_t k = 0; k < N; k++) {
+						(*c)[n][i][k] += (*a)[n][i][j] * (*b)[n][j][k];
+					}
+				}
+			}
+		}
+		ankerl::nanobench::doNotOptimizeAway(c->data()[0]);
+	});
+	bench.run("nonstd / einsum bij,bjk->bik (gemm)", [&] {
+		nstd::einsum<"bij,bjk->bik">(*a, *b, *c);
+		ankerl::nanobench::doNotOptimizeAway(c->data()[0]);
+	});
+	bench.run("nonstd / einsum bij,bkj->bik (loops)", [&] {
+		nstd::einsum<"bij,bkj->bik">(*a, *b, *c);
+		ankerl::nanobench::doNotOptimizeAway(c->data()[0]);
+	});
+}
+// bench_einsum_batched_matmul ENDS
+
+// bench_einsum_contract_last BEGINS
+TEST_CASE("bench_einsum_contract_last") {
+	constexpr nstd::size_t I = 64, J = 64, K = 256;
+	const auto a = random_array<nstd::ndarray<float, I, J, K>>();
+	const auto x = random_array<nstd::ndarray<float, K>>();
+	auto y = std::make_unique<nstd::ndarray<float, I, J>>();
+
+	auto bench = make_bench("bench_einsum_contract_last ijk,k->ij", 2.0 * I * J * K);
+	bench.run("plain / loop nest", [&] {
+		for (nstd::size_t i = 0; i < I; i++) {
+			for (nstd::size_t j = 0; j < J; j++) {
+				float acc = 0.0f;
+				for (nstd::size_t k = 0; k < K; k++) {
+					acc += (*a)[i][j][k] * (*x)[k];
+				}
+				(*y)[i][j] = acc;
+			}
+		}
+		ankerl::nanobench::doNotOptimizeAway(y->data()[0]);
+	});
+	bench.run("nonstd / einsum (gemv)", [&] {
+		nstd::einsum<"ijk,k->ij">(*a, *x, *y);
+		ankerl::nanobench::doNotOptimizeAway(y->data()[0]);
+	});
+}
+// bench_einsum_contract_last ENDS
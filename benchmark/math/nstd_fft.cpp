@@ -0,0 +1,120 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_fft.h>
+#include <util/nstd_thread_pool.h>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+// throughput is reported in the usual nominal count of 5 n log2(n) flops per complex transform, whatever the algorithm
+double nominal_flops(nstd::size_t n) {
+	return 5.0 * static_cast<double>(n) * std::log2(static_cast<double>(n));
+}
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double flops) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(flops)
+	    .unit("flop")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+std::vector<std::complex<float>> random_signal(nstd::size_t n) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<std::complex<float>> res(n);
+	for (auto &v : res) {
+		v = { dist(engine), dist(engine) };
+	}
+	return res;
+}
+
+// the definition with a table of the n roots of unity
+void naive_dft(const std::complex<float> *x, std::complex<float> *y, const std::complex<float> *roots, nstd::size_t n) {
+	for (nstd::size_t k = 0; k < n; k++) {
+		std::complex<float> acc = 0.0f;
+		for (nstd::size_t j = 0, jk = 0; j < n; j++, jk = (jk + k) % n) {
+			acc += x[j] * roots[jk];
+		}
+		y[k] = acc;
+	}
+}
+
+// bench_fft_vs_dft BEGINS
+TEST_CASE("bench_fft_vs_dft") {
+	for (nstd::size_t n : { 256, 1024, 4096 }) {
+		const auto x = random_signal(n);
+		std::vector<std::complex<float>> y(n), roots(n);
+		for (nstd::size_t k = 0; k < n; k++) {
+			roots[k] = std::polar(1.0f, -2.0f * std::numbers::pi_v<float> * static_cast<float>(k) / static_cast<float>(n));
+		}
+		nstd::fft_plan<float> plan(n);
+		auto bench = make_bench("bench_fft_vs_dft n = " + std::to_string(n), nominal_flops(n));
+		bench.run("plain / naive DFT", [&] {
+			naive_dft(x.data(), y.data(), roots.data(), n);
+			ankerl::nanobench::doNotOptimizeAway(y[n / 2]);
+		});
+		bench.run("nonstd / fft_plan", [&] {
+			plan.forward(x.data(), y.data());
+			ankerl::nanobench::doNotOptimizeAway(y[n / 2]);
+		});
+	}
+}
+// bench_fft_vs_dft ENDS
+
+// bench_fft_sizes BEGINS
+TEST_CASE("bench_fft_sizes") {
+	auto bench = make_bench("bench_fft_sizes", 1.0);
+	// powers of two, then mixed radices and a prime factor
+	for (nstd::size_t n : { 1 << 10, 1 << 16, 1 << 20, 1000, 59049, 100000, 65537 * 2 }) {
+		const auto x = random_signal(n);
+		std::vector<std::complex<float>> y(n);
+		nstd::fft_plan<float> plan(n);
+		bench.batch(nominal_flops(n)).run("nonstd / complex n = " + std::to_string(n), [&] {
+			plan.forward(x.data(), y.data());
+			ankerl::nanobench::doNotOptimizeAway(y[n / 2]);
+		});
+	}
+	for (nstd::size_t n : { 1 << 10, 1 << 16, 1 << 20 }) {
+		std::vector<float> x(n, 1.0f);
+		std::vector<std::complex<float>> y(n / 2 + 1);
+		nstd::rfft_plan<float> plan(n);
+		bench.batch(nominal_flops(n) / 2).run("nonstd / real n = " + std::to_string(n), [&] {
+			plan.forward(x.data(), y.data());
+			ankerl::nanobench::doNotOptimizeAway(y[n / 4]);
+		});
+	}
+}
+// bench_fft_sizes ENDS
+
+// bench_fft_2d BEGINS
+TEST_CASE("bench_fft_2d") {
+	constexpr nstd::size_t n = 1024;
+	const nstd::size_t extents[] = { n, n };
+	auto data = random_signal(n * n);
+	const nstd::strided_view<std::complex<float>, 2> view(data.data(), extents);
+	const nstd::fftn_plan<float, 2> plan(extents);
+	auto bench = make_bench("bench_fft_2d", nominal_flops(n * n));
+	bench.run("nonstd / 1024^2 serial", [&] {
+		plan.forward(view);
+		ankerl::nanobench::doNotOptimizeAway(data[n]);
+	});
+	bench.run("nonstd / 1024^2 thread_pool::global()", [&] {
+		plan.forward(view, &nstd::thread_pool::global());
+		ankerl::nanobench::doNotOptimizeAway(data[n]);
+	});
+}
+// bench_fft_2d ENDS
@@ -0,0 +1,119 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_geometry.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+ankerl::nanobench::Bench make_bench(const std::string &title, double items) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(3)
+	    .minEpochIterations(3)
+	    .batch(items)
+	    .unit("primitive")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+std::vector<nstd::aabb> random_boxes(nstd::size_t n) {
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f), size(0.1f, 2.0f);
+	std::vector<nstd::aabb> res(n);
+	for (auto &box : res) {
+		for (nstd::size_t a = 0; a < 3; a++) {
+			box._Min[a] = pos(engine);
+			box._Max[a] = box._Min[a] + size(engine);
+		}
+	}
+	return res;
+}
+
+// a 90 degree OpenGL-style perspective looking down -z, about a quarter of the boxes survive
+nstd::frustum camera() {
+	constexpr float n = 1.0f, f = 150.0f;
+	nstd::linalg::matrix4f m(0.0f);
+	m.at(0, 0) = 1.0f;
+	m.at(1, 1) = 1.0f;
+	m.at(2, 2) = -(f + n) / (f - n);
+	m.at(2, 3) = -2.0f * f * n / (f - n);
+	m.at(3, 2) = -1.0f;
+	return nstd::frustum::from_matrix(m);
+}
+
+// bench_geometry_cull BEGINS
+TEST_CASE("bench_geometry_cull") {
+	constexpr nstd::size_t n = 1 << 20;
+	const auto boxes = random_boxes(n);
+	const nstd::aabb_packet packet(boxes.data(), n);
+	const nstd::frustum f = camera();
+	std::vector<std::uint64_t> mask(nstd::mask_words(n));
+
+	auto bench = make_bench("bench_geometry_cull aabb / 1M", n);
+	bench.run("plain / one box at a time", [&] {
+		std::fill(mask.begin(), mask.end(), 0);
+		for (nstd::size_t i = 0; i < n; i++) {
+			bool visible = true;
+			for (const nstd::plane &p : f._Planes) {
+				float s = p._Dist;
+				for (nstd::size_t a = 0; a < 3; a++) {
+					s += p._Normal[a] * (p._Normal[a] >= 0.0f ? boxes[i]._Max[a] : boxes[i]._Min[a]);
+				}
+				if (s < 0.0f) {
+					visible = false;
+					break;
+				}
+			}
+			mask[i / 64] |= static_cast<std::uint64_t>(visible) << (i % 64);
+		}
+		ankerl::nanobench::doNotOptimizeAway(mask[0]);
+	});
+	bench.run("nonstd / cull(frustum, aabb_packet)", [&] { ankerl::nanobench::doNotOptimizeAway(nstd::cull(f, packet, mask.data())); });
+}
+// bench_geometry_cull ENDS
+
+// bench_geometry_ray BEGINS
+TEST_CASE("bench_geometry_ray") {
+	constexpr nstd::size_t n = 1 << 20;
+	const auto boxes = random_boxes(n);
+	const nstd::aabb_packet packet(boxes.data(), n);
+	const nstd::ray r{ nstd::linalg::vector3f(-120.0f, 3.0f, 1.0f), nstd::linalg::vector3f(1.0f, 0.01f, 0.02f) };
+	std::vector<std::uint64_t> mask(nstd::mask_words(n));
+
+	auto bench = make_bench("bench_geometry_ray aabb / 1M", n);
+	bench.run("plain / one box at a time", [&] {
+		std::fill(mask.begin(), mask.end(), 0);
+		for (nstd::size_t i = 0; i < n; i++) {
+			float near = r._TMin, far = r._TMax;
+			for (nstd::size_t a = 0; a < 3; a++) {
+				const float inv = 1.0f / r._Dir[a];
+				const float t0 = (boxes[i]._Min[a] - r._Origin[a]) * inv, t1 = (boxes[i]._Max[a] - r._Origin[a]) * inv;
+				near = std::max(near, std::min(t0, t1));
+				far = std::min(far, std::max(t0, t1));
+			}
+			mask[i / 64] |= static_cast<std::uint64_t>(near <= far) << (i % 64);
+		}
+		ankerl::nanobench::doNotOptimizeAway(mask[0]);
+	});
+	bench.run("nonstd / intersect(ray, aabb_packet)", [&] { ankerl::nanobench::doNotOptimizeAway(nstd::intersect(r, packet, mask.data())); });
+
+	std::mt19937 engine(2);
+	std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+	std::vector<nstd::linalg::vector3f> vertices(3 * n);
+	for (auto &v : vertices) {
+		v = nstd::linalg::vector3f(pos(engine), pos(engine), pos(engine));
+	}
+	const nstd::triangle_packet tris(vertices.data(), n);
+	std::vector<float> t(n);
+	auto tri = make_bench("bench_geometry_ray triangle / 1M", n);
+	tri.run("nonstd / intersect(ray, triangle_packet)", [&] { ankerl::nanobench::doNotOptimizeAway(nstd::intersect(r, tris, mask.data(), t.data())); });
+}
+// bench_geometry_ray ENDS
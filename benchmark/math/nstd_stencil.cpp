@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <math/nstd_stencil.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// 256^3 float grids (64 MiB each), far larger than any cache
+constexpr nstd::size_t n = 256;
+constexpr nstd::size_t cells = n * n * n;
+constexpr nstd::size_t extents[] = { n, n, n };
+
+struct grids {
+	std::vector<float> _In, _Out;
+
+	grids()
+	    : _In(cells), _Out(cells) {
+		std::mt19937 engine(1);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+		for (float &v : _In) {
+			v = dist(engine);
+		}
+	}
+};
+
+ankerl::nanobench::Bench make_bench(const std::string &title, nstd::size_t batch) {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title(title)
+	    .warmup(1)
+	    .minEpochIterations(1)
+	    .epochs(5)
+	    .batch(batch)
+	    .unit("cell")
+	    .performanceCounters(true)
+	    .relative(true);
+	return bench;
+}
+
+// the hand-written version: clamped neighbours, boundary branches inside the innermost loop
+template<auto S>
+void handwritten(const float *in, float *out) {
+	const long long m = static_cast<long long>(n);
+	for (long long i = 0; i < m; i++) {
+		for (long long j = 0; j < m; j++) {
+			for (long long k = 0; k < m; k++) {
+				float acc = 0.0f;
+				for (const auto &tap : S._Taps) {
+					long long x = i + tap._Offset[0], y = j + tap._Offset[1], z = k + tap._Offset[2];
+					x = x < 0 ? 0 : (x >= m ? m - 1 : x);
+					y = y < 0 ? 0 : (y >= m ? m - 1 : y);
+					z = z < 0 ? 0 : (z >= m ? m - 1 : z);
+					acc += tap._Weight * in[(x * m + y) * m + z];
+				}
+				out[(i * m + j) * m + k] = acc;
+			}
+		}
+	}
+}
+
+template<auto S>
+void run_apply(const std::string &title) {
+	grids g;
+	auto bench = make_bench(title, cells);
+	bench.run("plain / branchy loop", [&] {
+		handwritten<S>(g._In.data(), g._Out.data());
+		ankerl::nanobench::doNotOptimizeAway(g._Out[cells / 2]);
+	});
+	bench.run("nonstd / apply_stencil (clamp)", [&] {
+		nstd::apply_stencil<S>(g._In.data(), g._Out.data(), extents);
+		ankerl::nanobench::doNotOptimizeAway(g._Out[cells / 2]);
+	});
+	bench.run("nonstd / apply_stencil (wrap)", [&] {
+		nstd::apply_stencil<S>(g._In.data(), g._Out.data(), extents, nstd::wrap_boundary{});
+		ankerl::nanobench::doNotOptimizeAway(g._Out[cells / 2]);
+	});
+}
+
+// bench_stencil_7pt BEGINS
+TEST_CASE("bench_stencil_7pt") {
+	run_apply<nstd::stencils::laplacian7<float>>("bench_stencil_7pt");
+}
+// bench_stencil_7pt ENDS
+
+// bench_stencil_27pt BEGINS
+TEST_CASE("bench_stencil_27pt") {
+	run_apply<nstd::stencils::box27<float>>("bench_stencil_27pt");
+}
+// bench_stencil_27pt ENDS
+
+// bench_stencil_temporal BEGINS
+TEST_CASE("bench_stencil_temporal") {
+	constexpr nstd::size_t steps = 8;
+	grids g;
+	auto bench = make_bench("bench_stencil_temporal", cells * steps);
+	for (nstd::size_t time_block : { 1, 2, 4, 8 }) {
+		bench.run("nonstd / 7pt x " + std::to_string(steps) + ", time_block " + std::to_string(time_block), [&] {
+			float *res = nstd::iterate_stencil<nstd::stencils::laplacian7<float>>(g._In.data(), g._Out.data(), extents, steps,
+			                                                                       nstd::clamp_boundary{}, time_block);
+			ankerl::nanobench::doNotOptimizeAway(res[cells / 2]);
+		});
+	}
+}
+// bench_stencil_temporal ENDS
@@ -0,0 +1,88 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <memory/nstd_arena.h>
+#include <memory/nstd_pool.h>
+
+// bench_frame_scratch BEGINS
+// one "frame": 256 short-lived scratch buffers of varying size, all released at the end
+constexpr int frame_allocs = 256;
+
+void BM_new_frame_scratch() {
+	float *bufs[frame_allocs];
+	for (int i = 0; i < frame_allocs; i++) {
+		bufs[i] = new float[16 + (i & 63)];
+		ankerl::nanobench::doNotOptimizeAway(bufs[i]);
+	}
+	for (int i = 0; i < frame_allocs; i++) {
+		delete[] bufs[i];
+	}
+}
+
+nstd::arena frame_arena;
+
+void BM_arena_frame_scratch() {
+	for (int i = 0; i < frame_allocs; i++) {
+		float *buf = frame_arena.allocate<float>(16 + (i & 63));
+		ankerl::nanobench::doNotOptimizeAway(buf);
+	}
+	frame_arena.reset();
+}
+
+TEST_CASE("bench_frame_scratch") {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_frame_scratch")
+	    .warmup(100)
+	    .minEpochIterations(1000)
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("new / frame_scratch", BM_new_frame_scratch);
+	bench.run("arena / frame_scratch", BM_arena_frame_scratch);
+}
+// bench_frame_scratch ENDS
+
+// bench_fixed_size BEGINS
+struct node {
+	node *_Next;
+	float _Payload[6];
+};
+
+void BM_new_fixed_size() {
+	node *nodes[frame_allocs];
+	for (int i = 0; i < frame_allocs; i++) {
+		nodes[i] = new node;
+		ankerl::nanobench::doNotOptimizeAway(nodes[i]);
+	}
+	for (int i = 0; i < frame_allocs; i++) {
+		delete nodes[i];
+	}
+}
+
+void BM_pool_fixed_size() {
+	auto &p = nstd::pool<node>::local();
+	node *nodes[frame_allocs];
+	for (int i = 0; i < frame_allocs; i++) {
+		nodes[i] = p.allocate();
+		ankerl::nanobench::doNotOptimizeAway(nodes[i]);
+	}
+	for (int i = 0; i < frame_allocs; i++) {
+		p.deallocate(nodes[i]);
+	}
+}
+
+TEST_CASE("bench_fixed_size") {
+	auto bench = ankerl::nanobench::Bench();
+	bench.title("bench_fixed_size")
+	    .warmup(100)
+	    .minEpochIterations(1000)
+	    .performanceCounters(true)
+	    .relative(true);
+
+	bench.run("new / fixed_size", BM_new_fixed_size);
+	bench.run("pool / fixed_size", BM_pool_fixed_size);
+}
+// bench_fixed_size ENDS
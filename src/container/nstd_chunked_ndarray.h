@@ -0,0 +1,350 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <container/nstd_tile_grid.h>
+#include <io/nstd_dtype.h>
+#include <io/nstd_file.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+/*
+ * arrays larger than memory, stored on disk as a row-major grid of fixed-size tiles
+ * file layout:
+ *     [ chunked_header | padding up to _DataOffset | tile 0 | tile 1 | ... ]
+ * 1. every tile is a row-major ndarray<Ty, TileDim...>, so kernels written for in-memory arrays run on tiles unchanged
+ * 2. edge tiles are padded up to the full tile shape, the padding is zero on creation and
+ *    is skipped by reduce() but not by tile kernels (tile_info tells the valid extent)
+ * 3. tile_stream reads the next tile on a background thread while the current one is processed
+ */
+
+namespace nstd {
+
+struct chunked_header {
+	static constexpr char magic[8] = { 'N', 'S', 'T', 'D', 'C', 'H', 'N', 'K' };
+	static constexpr unsigned int current_version = 1;
+	static constexpr size_t max_rank = 8;
+	static constexpr size_t data_alignment = 4096;
+
+	char _Magic[8];
+	unsigned int _Version;
+	dtype _Dtype;
+	unsigned char _Rank;
+	unsigned short _Reserved;
+	unsigned long long _DataOffset;
+	unsigned long long _TileBytes;
+	unsigned long long _Shape[max_rank];
+	unsigned long long _Tile[max_rank];
+};
+
+static_assert(sizeof(chunked_header) == 160);
+
+
+template<typename Ty, size_t... TileDim>
+    requires(sizeof...(TileDim) > 0 && sizeof...(TileDim) <= chunked_header::max_rank && dtype_of_v<Ty> != dtype::unknown)
+class chunked_ndarray {
+public:
+	using value_type = Ty;
+	using tile_type = ndarray<Ty, TileDim...>;
+	using grid_type = tile_grid<TileDim...>;
+	using info_type = tile_info<sizeof...(TileDim)>;
+
+	static constexpr size_t rank = sizeof...(TileDim);
+	static constexpr size_t tile_shape[] = { TileDim... };
+	static constexpr size_t tile_bytes = tile_type::arr_size * sizeof(Ty);
+
+private:
+	file _File;
+	grid_type _Grid;
+	size_t _DataOffset = 0;
+
+	size_t tile_offset(size_t t) const noexcept {
+		return _DataOffset + t * tile_bytes;
+	}
+
+public:
+	chunked_ndarray() noexcept = default;
+
+	explicit chunked_ndarray(const char *path, open_mode mode = open_mode::read)
+	    : _File(path, mode) {
+		if (mode == open_mode::create) {
+			throw std::runtime_error("chunked_ndarray use create() to make a new array!");
+		}
+		chunked_header header;
+		if (_File.size() < sizeof(chunked_header)) {
+			throw std::runtime_error("chunked_ndarray file too small for a header!");
+		}
+		_File.read_at(&header, sizeof(chunked_header), 0);
+		if (std::memcmp(header._Magic, chunked_header::magic, sizeof(chunked_header::magic)) != 0) {
+			throw std::runtime_error("chunked_ndarray bad magic!");
+		}
+		if (header._Version != chunked_header::current_version) {
+			throw std::runtime_error("chunked_ndarray unsupported version!");
+		}
+		if (header._Dtype != dtype_of_v<Ty>) {
+			throw std::runtime_error("chunked_ndarray dtype mismatch!");
+		}
+		if (header._Rank != rank || header._TileBytes != tile_bytes) {
+			throw std::runtime_error("chunked_ndarray tile shape mismatch!");
+		}
+		size_t shape[rank];
+		for (size_t i = 0; i < rank; i++) {
+			if (header._Tile[i] != tile_shape[i]) {
+				throw std::runtime_error("chunked_ndarray tile shape mismatch!");
+			}
+			shape[i] = static_cast<size_t>(header._Shape[i]);
+		}
+		_Grid = grid_type(shape);
+		// the header is untrusted: divide instead of multiplying so that nothing can wrap
+		const size_t file_size = _File.size();
+		if (header._DataOffset < sizeof(chunked_header) || header._DataOffset % chunked_header::data_alignment != 0 ||
+		    header._DataOffset > file_size) {
+			throw std::runtime_error("chunked_ndarray bad data offset!");
+		}
+		_DataOffset = static_cast<size_t>(header._DataOffset);
+		if (_Grid.tile_count() > (file_size - _DataOffset) / tile_bytes) {
+			throw std::runtime_error("chunked_ndarray file truncated!");
+		}
+	}
+
+	chunked_ndarray(chunked_ndarray &&) noexcept = default;
+	chunked_ndarray &operator=(chunked_ndarray &&) noexcept = default;
+
+	// creates (or truncates) path as a zero-filled array of the given global shape
+	static chunked_ndarray create(const char *path, const size_t (&shape)[rank]) {
+		chunked_ndarray res;
+		res._Grid = grid_type(shape);
+		res._File = file(path, open_mode::create);
+		res._DataOffset = (sizeof(chunked_header) + chunked_header::data_alignment - 1) / chunked_header::data_alignment * chunked_header::data_alignment;
+
+		chunked_header header{};
+		std::memcpy(header._Magic, chunked_header::magic, sizeof(chunked_header::magic));
+		header._Version = chunked_header::current_version;
+		header._Dtype = dtype_of_v<Ty>;
+		header._Rank = static_cast<unsigned char>(rank);
+		header._DataOffset = res._DataOffset;
+		header._TileBytes = tile_bytes;
+		for (size_t i = 0; i < rank; i++) {
+			header._Shape[i] = shape[i];
+			header._Tile[i] = tile_shape[i];
+		}
+		res._File.write_at(&header, sizeof(chunked_header), 0);
+		res._File.resize(res.tile_offset(res._Grid.tile_count()));
+		return res;
+	}
+
+	const grid_type &grid() const noexcept {
+		return _Grid;
+	}
+
+	size_t extent(size_t dim) const noexcept {
+		return _Grid.extent(dim);
+	}
+
+	size_t grid_extent(size_t dim) const noexcept {
+		return _Grid.grid_extent(dim);
+	}
+
+	size_t tile_count() const noexcept {
+		return _Grid.tile_count();
+	}
+
+	// number of valid (non-padding) elements
+	size_t size() const noexcept {
+		return _Grid.size();
+	}
+
+	info_type info(size_t t) const noexcept {
+		return _Grid.info(t);
+	}
+
+	// safe to call from several threads at once
+	void read_tile(size_t t, tile_type &dst) const {
+		if (t >= _Grid.tile_count()) {
+			throw std::runtime_error("chunked_ndarray out of bounds!");
+		}
+		_File.read_at(dst.data(), tile_bytes, tile_offset(t));
+	}
+
+	void write_tile(size_t t, const tile_type &src) {
+		if (t >= _Grid.tile_count()) {
+			throw std::runtime_error("chunked_ndarray out of bounds!");
+		}
+		_File.write_at(src.data(), tile_bytes, tile_offset(t));
+	}
+
+	void sync() {
+		_File.sync();
+	}
+};
+
+/*
+ * double-buffered prefetching reader over the tiles of a chunked_ndarray, in tile order
+ * 1. while the caller holds tile t (between next() calls), the worker reads tile t + 1 into the other buffer
+ * 2. an IO error on the worker is rethrown by next()
+ */
+template<typename Ty, size_t... TileDim>
+class tile_stream {
+	using array_type = chunked_ndarray<Ty, TileDim...>;
+	using tile_type = typename array_type::tile_type;
+
+	const array_type *_Array;
+	size_t _Begin;
+	size_t _End;
+
+	std::unique_ptr<tile_type> _Buffers[2];
+	bool _Filled[2] = { false, false };
+	size_t _Current;  // tile held by the caller
+	bool _Started = false;
+	bool _Stop = false;
+	std::exception_ptr _Error;
+	std::mutex _Mutex;
+	std::condition_variable _Cond;
+	std::thread _Worker;
+
+	void work() {
+		for (size_t t = _Begin; t < _End; t++) {
+			const size_t slot = (t - _Begin) & 1;
+			{
+				std::unique_lock lock(_Mutex);
+				_Cond.wait(lock, [&] { return _Stop || !_Filled[slot]; });
+				if (_Stop) {
+					return;
+				}
+			}
+			try {
+				_Array->read_tile(t, *_Buffers[slot]);  // the slot is owned by the worker until it is marked filled
+			} catch (...) {
+				std::lock_guard lock(_Mutex);
+				_Error = std::current_exception();
+				_Cond.notify_all();
+				return;
+			}
+			std::lock_guard lock(_Mutex);
+			_Filled[slot] = true;
+			_Cond.notify_all();
+		}
+	}
+
+public:
+	explicit tile_stream(const array_type &arr)
+	    : tile_stream(arr, 0, arr.tile_count()) {}
+
+	// tiles [begin, end)
+	tile_stream(const array_type &arr, size_t begin, size_t end)
+	    : _Array(&arr)
+	    , _Begin(begin)
+	    , _End(end < arr.tile_count() ? end : arr.tile_count())
+	    , _Current(_End) {
+		_Buffers[0] = std::make_unique<tile_type>();
+		_Buffers[1] = std::make_unique<tile_type>();
+		if (_Begin < _End) {
+			_Worker = std::thread([this] { work(); });
+		}
+	}
+
+	tile_stream(const tile_stream &) = delete;
+	tile_stream &operator=(const tile_stream &) = delete;
+
+	~tile_stream() {
+		{
+			std::lock_guard lock(_Mutex);
+			_Stop = true;
+		}
+		_Cond.notify_all();
+		if (_Worker.joinable()) {
+			_Worker.join();
+		}
+	}
+
+	// releases the current tile and waits for the next one, nullptr past the last tile
+	const tile_type *next() {
+		std::unique_lock lock(_Mutex);
+		size_t t = _Begin;
+		if (_Started) {
+			if (_Current == _End) {
+				return nullptr;
+			}
+			_Filled[(_Current - _Begin) & 1] = false;
+			_Cond.notify_all();
+			t = _Current + 1;
+		}
+		_Started = true;
+		if (t >= _End) {
+			_Current = _End;
+			return nullptr;
+		}
+		const size_t slot = (t - _Begin) & 1;
+		_Cond.wait(lock, [&] { return _Filled[slot] || _Error != nullptr; });
+		if (!_Filled[slot]) {
+			std::rethrow_exception(_Error);
+		}
+		_Current = t;
+		return _Buffers[slot].get();
+	}
+
+	// index of the tile returned by the last next()
+	size_t index() const noexcept {
+		return _Current;
+	}
+};
+
+// calls fn(const tile_type &, const tile_info &) on every tile, reads are prefetched
+template<typename Ty, size_t... TileDim, typename Fn>
+void for_each_tile(const chunked_ndarray<Ty, TileDim...> &src, Fn &&fn) {
+	tile_stream<Ty, TileDim...> stream(src);
+	while (const auto *tile = stream.next()) {
+		fn(*tile, src.info(stream.index()));
+	}
+}
+
+/*
+ * ! assumptions !
+ * 1. fn is either a tile kernel, fn(const tile_type &in, tile_type &out), or an element-wise fn(Ty) -> Ty
+ * 2. src and dst have the same shape, they may be the same array (each tile is written after it is read)
+ */
+template<typename Ty, size_t... TileDim, typename Fn>
+void transform(const chunked_ndarray<Ty, TileDim...> &src, chunked_ndarray<Ty, TileDim...> &dst, Fn &&fn) {
+	using tile_type = typename chunked_ndarray<Ty, TileDim...>::tile_type;
+	for (size_t i = 0; i < chunked_ndarray<Ty, TileDim...>::rank; i++) {
+		if (src.extent(i) != dst.extent(i)) {
+			throw std::runtime_error("chunked_ndarray shape mismatch!");
+		}
+	}
+
+	auto out = std::make_unique<tile_type>();
+	tile_stream<Ty, TileDim...> stream(src);
+	while (const tile_type *tile = stream.next()) {
+		if constexpr (std::is_invocable_v<Fn &, const tile_type &, tile_type &>) {
+			fn(*tile, *out);
+		} else {
+			const Ty *in = tile->data();
+			Ty *res = out->data();
+			for (size_t i = 0; i < tile_type::arr_size; i++) {
+				res[i] = fn(in[i]);
+			}
+		}
+		dst.write_tile(stream.index(), *out);
+	}
+}
+
+// folds op(acc, x) over every valid element, tile by tile in row-major tile order
+template<typename Ty, size_t... TileDim, typename Acc, typename Op>
+Acc reduce(const chunked_ndarray<Ty, TileDim...> &src, Acc init, Op &&op) {
+	tile_stream<Ty, TileDim...> stream(src);
+	while (const auto *tile = stream.next()) {
+		const auto info = src.info(stream.index());
+		tile_grid<TileDim...>::for_each_valid(tile->data(), info._Extent, [&](const Ty &x) { init = op(init, x); });
+	}
+	return init;
+}
+
+}  // namespace nstd
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <container/nstd_tile_grid.h>
+#include <util/nstd_compress.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_type_traits.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+ * in-memory arrays whose tiles are kept compressed, for smooth fields that are too big to hold raw
+ * 1. every tile is an ndarray<Ty, TileDim...> compressed on its own: shuffle, then LZ,
+ *    tiles that do not shrink are stored raw
+ * 2. element and tile reads go through a small LRU cache of decompressed tiles, writes mark the
+ *    cached tile dirty and it is recompressed on eviction or flush()
+ * 3. not thread-safe, even const access updates the cache
+ */
+
+namespace nstd {
+
+enum class shuffle_mode : unsigned char {
+	none,
+	byte,
+	bit,
+};
+
+template<typename Ty, size_t... TileDim>
+    requires(is_trivially_copyable_v<Ty>)
+class compressed_ndarray {
+public:
+	using value_type = Ty;
+	using tile_type = ndarray<Ty, TileDim...>;
+	using grid_type = tile_grid<TileDim...>;
+	using info_type = tile_info<sizeof...(TileDim)>;
+
+	static constexpr size_t rank = sizeof...(TileDim);
+	static constexpr size_t tile_bytes = tile_type::arr_size * sizeof(Ty);
+
+private:
+	enum codec : unsigned char {
+		codec_raw,
+		codec_lz,
+	};
+
+	struct cache_slot {
+		static constexpr size_t empty = static_cast<size_t>(-1);
+
+		size_t _Tile = empty;
+		bool _Dirty = false;
+		unsigned long long _LastUse = 0;
+		std::unique_ptr<tile_type> _Data = std::make_unique<tile_type>();
+	};
+
+	grid_type _Grid;
+	shuffle_mode _Shuffle = shuffle_mode::bit;
+
+	// [codec][payload] per tile, mutable since evicting a dirty tile from a const access recompresses it
+	mutable std::vector<std::vector<unsigned char>> _Tiles;
+	mutable std::vector<cache_slot> _Cache;
+	mutable unsigned long long _Clock = 0;
+	mutable std::unique_ptr<unsigned char[]> _Shuffled;
+	mutable std::unique_ptr<unsigned char[]> _Packed;
+
+	void encode(size_t t, const tile_type &tile) const {
+		const unsigned char *raw = reinterpret_cast<const unsigned char *>(tile.data());
+		const unsigned char *src = raw;
+		if (_Shuffle == shuffle_mode::byte) {
+			byte_shuffle(raw, _Shuffled.get(), tile_type::arr_size, sizeof(Ty));
+			src = _Shuffled.get();
+		} else if (_Shuffle == shuffle_mode::bit) {
+			bit_shuffle(raw, _Shuffled.get(), tile_type::arr_size, sizeof(Ty));
+			src = _Shuffled.get();
+		}
+
+		const size_t packed = lz_compress(src, tile_bytes, _Packed.get(), lz_compress_bound(tile_bytes));
+		std::vector<unsigned char> &blob = _Tiles[t];
+		if (packed < tile_bytes) {
+			blob.resize(1 + packed);
+			blob[0] = codec_lz;
+			std::memcpy(blob.data() + 1, _Packed.get(), packed);
+		} else {
+			blob.resize(1 + tile_bytes);
+			blob[0] = codec_raw;
+			std::memcpy(blob.data() + 1, raw, tile_bytes);
+		}
+		blob.shrink_to_fit();
+	}
+
+	void decode(size_t t, tile_type &tile) const {
+		const std::vector<unsigned char> &blob = _Tiles[t];
+		unsigned char *raw = reinterpret_cast<unsigned char *>(tile.data());
+		if (blob[0] == codec_raw) {
+			if (blob.size() - 1 != tile_bytes) {
+				throw std::runtime_error("compressed_ndarray corrupt tile!");
+			}
+			std::memcpy(raw, blob.data() + 1, tile_bytes);
+			return;
+		}
+		// a short result would leave the rest of the tile stale
+		unsigned char *dst = _Shuffle == shuffle_mode::none ? raw : _Shuffled.get();
+		if (lz_decompress(blob.data() + 1, blob.size() - 1, dst, tile_bytes) != tile_bytes) {
+			throw std::runtime_error("compressed_ndarray corrupt tile!");
+		}
+		if (_Shuffle == shuffle_mode::none) {
+			return;
+		}
+		if (_Shuffle == shuffle_mode::byte) {
+			byte_unshuffle(_Shuffled.get(), raw, tile_type::arr_size, sizeof(Ty));
+		} else {
+			bit_unshuffle(_Shuffled.get(), raw, tile_type::arr_size, sizeof(Ty));
+		}
+	}
+
+	cache_slot *find_cached(size_t t) const noexcept {
+		for (auto &slot : _Cache) {
+			if (slot._Tile == t) {
+				slot._LastUse = ++_Clock;
+				return &slot;
+			}
+		}
+		return nullptr;
+	}
+
+	// the cached tile t, loading it over the least recently used slot
+	cache_slot &fetch(size_t t) const {
+		if (cache_slot *slot = find_cached(t)) {
+			return *slot;
+		}
+		cache_slot *victim = &_Cache[0];
+		for (auto &slot : _Cache) {
+			if (slot._LastUse < victim->_LastUse) {
+				victim = &slot;
+			}
+		}
+		if (victim->_Tile != cache_slot::empty && victim->_Dirty) {
+			encode(victim->_Tile, *victim->_Data);
+		}
+		victim->_Tile = cache_slot::empty;  // stays empty if decode throws
+		decode(t, *victim->_Data);
+		victim->_Tile = t;
+		victim->_Dirty = false;
+		victim->_LastUse = ++_Clock;
+		return *victim;
+	}
+
+	size_t locate_checked(const size_t (&idx)[rank], size_t &offset) const {
+		if (!_Grid.contains(idx)) {
+			throw std::runtime_error("compressed_ndarray out of bounds!");
+		}
+		return _Grid.locate(idx, offset);
+	}
+
+public:
+	// a zero-filled array of the given global shape, caching up to cache_tiles decompressed tiles
+	explicit compressed_ndarray(const size_t (&shape)[rank], shuffle_mode shuffle = shuffle_mode::bit, size_t cache_tiles = 4)
+	    : _Grid(shape)
+	    , _Shuffle(shuffle)
+	    , _Cache(cache_tiles == 0 ? 1 : cache_tiles)
+	    , _Shuffled(new unsigned char[tile_bytes])
+	    , _Packed(new unsigned char[lz_compress_bound(tile_bytes)]) {
+		_Tiles.resize(_Grid.tile_count());
+		auto zero = std::make_unique<tile_type>();
+		encode(0, *zero);
+		for (size_t t = 1; t < _Tiles.size(); t++) {
+			_Tiles[t] = _Tiles[0];
+		}
+	}
+
+	compressed_ndarray(compressed_ndarray &&) noexcept = default;
+	compressed_ndarray &operator=(compressed_ndarray &&) noexcept = default;
+
+	const grid_type &grid() const noexcept {
+		return _Grid;
+	}
+
+	size_t extent(size_t dim) const noexcept {
+		return _Grid.extent(dim);
+	}
+
+	size_t tile_count() const noexcept {
+		return _Grid.tile_count();
+	}
+
+	size_t size() const noexcept {
+		return _Grid.size();
+	}
+
+	info_type info(size_t t) const noexcept {
+		return _Grid.info(t);
+	}
+
+	Ty get(const size_t (&idx)[rank]) const {
+		size_t offset;
+		const size_t t = locate_checked(idx, offset);
+		return fetch(t)._Data->data()[offset];
+	}
+
+	void set(const size_t (&idx)[rank], const Ty &val) {
+		size_t offset;
+		const size_t t = locate_checked(idx, offset);
+		cache_slot &slot = fetch(t);
+		slot._Data->data()[offset] = val;
+		slot._Dirty = true;
+	}
+
+	// decompresses straight into dst unless the tile is cached
+	void read_tile(size_t t, tile_type &dst) const {
+		if (t >= _Grid.tile_count()) {
+			throw std::runtime_error("compressed_ndarray out of bounds!");
+		}
+		if (const cache_slot *slot = find_cached(t)) {
+			dst = *slot->_Data;
+		} else {
+			decode(t, dst);
+		}
+	}
+
+	void write_tile(size_t t, const tile_type &src) {
+		if (t >= _Grid.tile_count()) {
+			throw std::runtime_error("compressed_ndarray out of bounds!");
+		}
+		if (cache_slot *slot = find_cached(t)) {
+			*slot->_Data = src;
+			slot->_Dirty = true;
+		} else {
+			encode(t, src);
+		}
+	}
+
+	// recompresses every dirty cached tile
+	void flush() const {
+		for (auto &slot : _Cache) {
+			if (slot._Tile != cache_slot::empty && slot._Dirty) {
+				encode(slot._Tile, *slot._Data);
+				slot._Dirty = false;
+			}
+		}
+	}
+
+	// bytes held by the compressed tiles (capacity included), excluding the cache and scratch buffers
+	size_t footprint() const noexcept {
+		size_t res = 0;
+		for (const auto &blob : _Tiles) {
+			res += blob.capacity();
+		}
+		return res;
+	}
+
+	size_t cache_footprint() const noexcept {
+		return _Cache.size() * tile_bytes + tile_bytes + lz_compress_bound(tile_bytes);
+	}
+
+	// bytes the tiles would take uncompressed
+	size_t raw_bytes() const noexcept {
+		return _Grid.tile_count() * tile_bytes;
+	}
+};
+
+// calls fn(const tile_type &, const tile_info &) on every tile, decompressing one at a time
+template<typename Ty, size_t... TileDim, typename Fn>
+void for_each_tile(const compressed_ndarray<Ty, TileDim...> &src, Fn &&fn) {
+	auto tile = std::make_unique<typename compressed_ndarray<Ty, TileDim...>::tile_type>();
+	for (size_t t = 0; t < src.tile_count(); t++) {
+		src.read_tile(t, *tile);
+		fn(*tile, src.info(t));
+	}
+}
+
+// in place, fn is a tile kernel fn(const tile_type &in, tile_type &out) or an element-wise fn(Ty) -> Ty
+template<typename Ty, size_t... TileDim, typename Fn>
+void transform(compressed_ndarray<Ty, TileDim...> &arr, Fn &&fn) {
+	using tile_type = typename compressed_ndarray<Ty, TileDim...>::tile_type;
+	auto in = std::make_unique<tile_type>();
+	auto out = std::make_unique<tile_type>();
+	for (size_t t = 0; t < arr.tile_count(); t++) {
+		arr.read_tile(t, *in);
+		if constexpr (std::is_invocable_v<Fn &, const tile_type &, tile_type &>) {
+			fn(*in, *out);
+		} else {
+			for (size_t i = 0; i < tile_type::arr_size; i++) {
+				out->data()[i] = fn(in->data()[i]);
+			}
+		}
+		arr.write_tile(t, *out);
+	}
+}
+
+// folds op(acc, x) over every valid element
+template<typename Ty, size_t... TileDim, typename Acc, typename Op>
+Acc reduce(const compressed_ndarray<Ty, TileDim...> &src, Acc init, Op &&op) {
+	for_each_tile(src, [&](const auto &tile, const auto &info) {
+		tile_grid<TileDim...>::for_each_valid(tile.data(), info._Extent, [&](const Ty &x) { init = op(init, x); });
+	});
+	return init;
+}
+
+}  // namespace nstd
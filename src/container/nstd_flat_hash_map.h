@@ -0,0 +1,618 @@
+#pragma once
+
+#include <util/nstd_hash.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define NSTD_FLAT_HASH_MAP_SSE2 1
+#else
+#	define NSTD_FLAT_HASH_MAP_SSE2 0
+#endif
+
+/*
+ * open-addressing hash map (swiss table layout)
+ * 1. one control byte per slot: empty / deleted / sentinel, or the low 7 bits of the hash when full
+ * 2. probing compares a whole group of control bytes at once (16 with SSE2, 8 with the portable SWAR fallback),
+ *    keys are only compared for control bytes that match
+ * 3. slots and control bytes share a single allocation, inserting never allocates per element
+ * 4. capacity is always 2^k - 1; the sentinel sits at ctrl[capacity], followed by a copy of the first
+ *    group_width - 1 control bytes so that a group load starting near the end never wraps
+ * 5. any insertion that grows the table invalidates iterators and references
+ */
+
+namespace nstd {
+
+namespace internal {
+
+using ctrl_t = signed char;
+
+inline constexpr ctrl_t ctrl_empty = -128;
+inline constexpr ctrl_t ctrl_deleted = -2;
+inline constexpr ctrl_t ctrl_sentinel = -1;
+
+// one set bit per matching slot of a group, Shift = log2(bits per slot)
+template<typename UInt, int Shift>
+class group_mask {
+	UInt _Bits;
+
+public:
+	explicit group_mask(UInt bits) noexcept
+	    : _Bits(bits) {}
+
+	explicit operator bool() const noexcept {
+		return _Bits != 0;
+	}
+
+	size_t lowest() const noexcept {
+		return static_cast<size_t>(std::countr_zero(_Bits)) >> Shift;
+	}
+
+	void clear_lowest() noexcept {
+		_Bits &= static_cast<UInt>(_Bits - 1);
+	}
+
+	// number of unmatched slots before the first / after the last match
+	size_t trailing_zeros() const noexcept {
+		return static_cast<size_t>(std::countr_zero(_Bits)) >> Shift;
+	}
+
+	size_t leading_zeros() const noexcept {
+		return static_cast<size_t>(std::countl_zero(_Bits)) >> Shift;
+	}
+};
+
+#if NSTD_FLAT_HASH_MAP_SSE2
+struct group_sse2 {
+	static constexpr size_t width = 16;
+	using mask = group_mask<std::uint16_t, 0>;
+
+	__m128i _Ctrl;
+
+	explicit group_sse2(const ctrl_t *pos) noexcept
+	    : _Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+	mask match(ctrl_t h2) const noexcept {
+		return mask(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _Ctrl))));
+	}
+
+	mask match_empty() const noexcept {
+		return match(ctrl_empty);
+	}
+
+	mask match_empty_or_deleted() const noexcept {  // i.e. ctrl < ctrl_sentinel
+		return mask(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), _Ctrl))));
+	}
+};
+#endif
+
+// SWAR over a little-endian 64-bit word, match() may report false positives, which the key comparison filters out
+struct group_portable {
+	static constexpr size_t width = 8;
+	using mask = group_mask<std::uint64_t, 3>;
+
+	static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+	static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+	std::uint64_t _Ctrl;
+
+	explicit group_portable(const ctrl_t *pos) noexcept {
+		std::memcpy(&_Ctrl, pos, sizeof(_Ctrl));
+	}
+
+	mask match(ctrl_t h2) const noexcept {
+		const std::uint64_t x = _Ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+		return mask((x - lsbs) & ~x & msbs);
+	}
+
+	mask match_empty() const noexcept {
+		return mask(_Ctrl & ~(_Ctrl << 6) & msbs);
+	}
+
+	mask match_empty_or_deleted() const noexcept {
+		return mask(_Ctrl & ~(_Ctrl << 7) & msbs);
+	}
+};
+
+#if NSTD_FLAT_HASH_MAP_SSE2
+using group = group_sse2;
+#else
+using group = group_portable;
+#endif
+
+}  // namespace internal
+
+template<typename Key, typename Ty, typename Hash = hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map {
+public:
+	using key_type = Key;
+	using mapped_type = Ty;
+	using value_type = std::pair<const Key, Ty>;
+	using size_type = size_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+private:
+	using ctrl_t = internal::ctrl_t;
+	using group = internal::group;
+
+	static constexpr size_t group_width = group::width;
+	static constexpr size_t min_capacity = 15;
+	static constexpr size_t npos = ~static_cast<size_t>(0);
+	static constexpr size_t slot_align = alignof(value_type) > 16 ? alignof(value_type) : 16;
+
+	ctrl_t *_Ctrl = nullptr;
+	value_type *_Slots = nullptr;
+	size_t _Capacity = 0;  // 0 or 2^k - 1
+	size_t _Size = 0;
+	size_t _GrowthLeft = 0;  // insertions into empty slots left before a rehash
+	[[no_unique_address]] Hash _Hash;
+	[[no_unique_address]] KeyEqual _Eq;
+
+	template<bool Const>
+	class basic_iterator {
+		friend class flat_hash_map;
+
+		using slot_type = typename flat_hash_map::value_type;
+		using slot_ptr = conditional_t<Const, const slot_type *, slot_type *>;
+
+		const ctrl_t *_Ctrl = nullptr;
+		slot_ptr _Slot = nullptr;
+
+		basic_iterator(const ctrl_t *ctrl, slot_ptr slot) noexcept
+		    : _Ctrl(ctrl)
+		    , _Slot(slot) {}
+
+		void skip_empty() noexcept {
+			while (*_Ctrl < internal::ctrl_sentinel) {
+				++_Ctrl;
+				++_Slot;
+			}
+		}
+
+	public:
+		using value_type = slot_type;
+		using difference_type = ptrdiff_t;
+		using reference = conditional_t<Const, const slot_type &, slot_type &>;
+		using pointer = slot_ptr;
+		using iterator_category = std::forward_iterator_tag;
+
+		basic_iterator() noexcept = default;
+
+		template<bool C = Const>
+		    requires(C)
+		basic_iterator(const basic_iterator<false> &rhs) noexcept
+		    : _Ctrl(rhs._Ctrl)
+		    , _Slot(rhs._Slot) {}
+
+		reference operator*() const noexcept {
+			return *_Slot;
+		}
+
+		pointer operator->() const noexcept {
+			return _Slot;
+		}
+
+		basic_iterator &operator++() noexcept {
+			++_Ctrl;
+			++_Slot;
+			skip_empty();
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept {
+			basic_iterator res = *this;
+			++*this;
+			return res;
+		}
+
+		friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept {
+			return lhs._Slot == rhs._Slot;
+		}
+	};
+
+	static size_t max_load(size_t capacity) noexcept {
+		return capacity - capacity / 8;
+	}
+
+	static size_t ctrl_bytes(size_t capacity) noexcept {
+		return capacity + group_width;  // + sentinel + cloned bytes
+	}
+
+	static size_t slot_offset(size_t capacity) noexcept {
+		return (ctrl_bytes(capacity) + alignof(value_type) - 1) & ~(alignof(value_type) - 1);
+	}
+
+	// the low 7 bits tag the control byte, the rest pick the probe start
+	static ctrl_t h2(size_t h) noexcept {
+		return static_cast<ctrl_t>(h & 0x7f);
+	}
+
+	size_t probe_start(size_t h) const noexcept {
+		return (h >> 7) & _Capacity;
+	}
+
+	void set_ctrl(size_t i, ctrl_t c) noexcept {
+		_Ctrl[i] = c;
+		_Ctrl[((i - (group_width - 1)) & _Capacity) + ((group_width - 1) & _Capacity)] = c;
+	}
+
+	template<typename K>
+	size_t find_index(const K &key, size_t h) const {
+		if (_Capacity == 0) {
+			return npos;
+		}
+		size_t pos = probe_start(h);
+		for (size_t step = group_width;; step += group_width) {
+			group g(_Ctrl + pos);
+			for (auto m = g.match(h2(h)); m; m.clear_lowest()) {
+				const size_t idx = (pos + m.lowest()) & _Capacity;
+				if (_Eq(_Slots[idx].first, key)) {
+					return idx;
+				}
+			}
+			if (g.match_empty()) {
+				return npos;
+			}
+			pos = (pos + step) & _Capacity;
+		}
+	}
+
+	size_t find_first_non_full(size_t h) const noexcept {
+		size_t pos = probe_start(h);
+		for (size_t step = group_width;; step += group_width) {
+			auto m = group(_Ctrl + pos).match_empty_or_deleted();
+			if (m) {
+				return (pos + m.lowest()) & _Capacity;
+			}
+			pos = (pos + step) & _Capacity;
+		}
+	}
+
+	void allocate(size_t capacity) {
+		void *raw = ::operator new(slot_offset(capacity) + capacity * sizeof(value_type), std::align_val_t{ slot_align });
+		_Ctrl = static_cast<ctrl_t *>(raw);
+		_Slots = reinterpret_cast<value_type *>(static_cast<char *>(raw) + slot_offset(capacity));
+		_Capacity = capacity;
+		std::memset(_Ctrl, static_cast<unsigned char>(internal::ctrl_empty), ctrl_bytes(capacity));
+		_Ctrl[capacity] = internal::ctrl_sentinel;
+		_GrowthLeft = max_load(capacity) - _Size;
+	}
+
+	static void deallocate(ctrl_t *ctrl) noexcept {
+		::operator delete(static_cast<void *>(ctrl), std::align_val_t{ slot_align });
+	}
+
+	void destroy_slots() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (size_t i = 0; i < _Capacity; i++) {
+				if (_Ctrl[i] >= 0) {
+					std::destroy_at(_Slots + i);
+				}
+			}
+		}
+	}
+
+	void resize(size_t new_capacity) {
+		ctrl_t *old_ctrl = _Ctrl;
+		value_type *old_slots = _Slots;
+		const size_t old_capacity = _Capacity;
+
+		allocate(new_capacity);
+		for (size_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] >= 0) {
+				value_type &slot = old_slots[i];
+				const size_t h = _Hash(slot.first);
+				const size_t idx = find_first_non_full(h);
+				set_ctrl(idx, h2(h));
+				std::construct_at(_Slots + idx, std::move(const_cast<Key &>(slot.first)), std::move(slot.second));
+				std::destroy_at(&slot);
+			}
+		}
+		if (old_ctrl) {
+			deallocate(old_ctrl);
+		}
+	}
+
+	// grows when at least half the load is live, otherwise only rebuilds to purge tombstones
+	void rehash_for_insert() {
+		if (_Capacity == 0) {
+			resize(min_capacity);
+		} else if (_Size + 1 > max_load(_Capacity) / 2) {
+			resize(_Capacity * 2 + 1);
+		} else {
+			resize(_Capacity);
+		}
+	}
+
+	static size_t capacity_for(size_t n) noexcept {
+		size_t capacity = min_capacity;
+		while (max_load(capacity) < n) {
+			capacity = capacity * 2 + 1;
+		}
+		return capacity;
+	}
+
+	// returns {index, inserted}; when inserted, the caller constructs the slot at index and then calls
+	// finish_insert, so a throwing constructor leaves the slot empty and the counts untouched
+	template<typename K>
+	std::pair<size_t, bool> find_or_prepare_insert(const K &key, size_t h) {
+		const size_t found = find_index(key, h);
+		if (found != npos) {
+			return { found, false };
+		}
+		if (_Capacity == 0) {
+			rehash_for_insert();
+		}
+		size_t idx = find_first_non_full(h);
+		if (_GrowthLeft == 0 && _Ctrl[idx] == internal::ctrl_empty) {
+			rehash_for_insert();
+			idx = find_first_non_full(h);
+		}
+		return { idx, true };
+	}
+
+	void finish_insert(size_t idx, size_t h) noexcept {
+		_Size++;
+		_GrowthLeft -= _Ctrl[idx] == internal::ctrl_empty;
+		set_ctrl(idx, h2(h));
+	}
+
+	// the slot is marked empty when no probe sequence can have passed over it while it was full,
+	// i.e. there is an empty slot within one group in both directions
+	void erase_index(size_t idx) noexcept {
+		std::destroy_at(_Slots + idx);
+		_Size--;
+		const size_t before = (idx - group_width) & _Capacity;
+		const auto empty_after = group(_Ctrl + idx).match_empty();
+		const auto empty_before = group(_Ctrl + before).match_empty();
+		const bool was_never_full = empty_before && empty_after &&
+		                            empty_after.trailing_zeros() + empty_before.leading_zeros() < group_width;
+		set_ctrl(idx, was_never_full ? internal::ctrl_empty : internal::ctrl_deleted);
+		_GrowthLeft += was_never_full;
+	}
+
+public:
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	flat_hash_map() noexcept = default;
+
+	explicit flat_hash_map(size_t n, const Hash &hash = Hash(), const KeyEqual &eq = KeyEqual())
+	    : _Hash(hash)
+	    , _Eq(eq) {
+		reserve(n);
+	}
+
+	flat_hash_map(std::initializer_list<value_type> init) {
+		reserve(init.size());
+		for (const value_type &val : init) {
+			insert(val);
+		}
+	}
+
+	flat_hash_map(const flat_hash_map &rhs)
+	    : _Hash(rhs._Hash)
+	    , _Eq(rhs._Eq) {
+		reserve(rhs._Size);
+		try {
+			for (const value_type &val : rhs) {
+				const size_t h = _Hash(val.first);
+				const size_t idx = find_first_non_full(h);
+				std::construct_at(_Slots + idx, val);
+				finish_insert(idx, h);
+			}
+		} catch (...) {
+			// no destructor runs for a constructor that throws
+			destroy_slots();
+			deallocate(_Ctrl);
+			throw;
+		}
+	}
+
+	flat_hash_map(flat_hash_map &&rhs) noexcept
+	    : _Ctrl(rhs._Ctrl)
+	    , _Slots(rhs._Slots)
+	    , _Capacity(rhs._Capacity)
+	    , _Size(rhs._Size)
+	    , _GrowthLeft(rhs._GrowthLeft)
+	    , _Hash(std::move(rhs._Hash))
+	    , _Eq(std::move(rhs._Eq)) {
+		rhs._Ctrl = nullptr;
+		rhs._Slots = nullptr;
+		rhs._Capacity = rhs._Size = rhs._GrowthLeft = 0;
+	}
+
+	flat_hash_map &operator=(const flat_hash_map &rhs) {
+		if (this != &rhs) {
+			flat_hash_map tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	flat_hash_map &operator=(flat_hash_map &&rhs) noexcept {
+		if (this != &rhs) {
+			flat_hash_map tmp(std::move(rhs));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~flat_hash_map() {
+		if (_Ctrl) {
+			destroy_slots();
+			deallocate(_Ctrl);
+		}
+	}
+
+	void swap(flat_hash_map &rhs) noexcept {
+		std::swap(_Ctrl, rhs._Ctrl);
+		std::swap(_Slots, rhs._Slots);
+		std::swap(_Capacity, rhs._Capacity);
+		std::swap(_Size, rhs._Size);
+		std::swap(_GrowthLeft, rhs._GrowthLeft);
+		std::swap(_Hash, rhs._Hash);
+		std::swap(_Eq, rhs._Eq);
+	}
+
+	iterator begin() noexcept {
+		if (_Capacity == 0) {
+			return end();
+		}
+		iterator it(_Ctrl, _Slots);
+		it.skip_empty();
+		return it;
+	}
+
+	const_iterator begin() const noexcept {
+		return const_cast<flat_hash_map *>(this)->begin();
+	}
+
+	iterator end() noexcept {
+		return iterator(_Ctrl + _Capacity, _Slots + _Capacity);
+	}
+
+	const_iterator end() const noexcept {
+		return const_cast<flat_hash_map *>(this)->end();
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	bool empty() const noexcept {
+		return _Size == 0;
+	}
+
+	size_t capacity() const noexcept {
+		return _Capacity;
+	}
+
+	float load_factor() const noexcept {
+		return _Capacity == 0 ? 0.0f : static_cast<float>(_Size) / static_cast<float>(_Capacity);
+	}
+
+	void reserve(size_t n) {
+		if (n > _Size + _GrowthLeft) {
+			resize(capacity_for(n));
+		}
+	}
+
+	void clear() noexcept {
+		if (_Ctrl) {
+			destroy_slots();
+			_Size = 0;
+			std::memset(_Ctrl, static_cast<unsigned char>(internal::ctrl_empty), ctrl_bytes(_Capacity));
+			_Ctrl[_Capacity] = internal::ctrl_sentinel;
+			_GrowthLeft = max_load(_Capacity);
+		}
+	}
+
+	iterator find(const Key &key) {
+		const size_t idx = find_index(key, _Hash(key));
+		return idx == npos ? end() : iterator(_Ctrl + idx, _Slots + idx);
+	}
+
+	const_iterator find(const Key &key) const {
+		return const_cast<flat_hash_map *>(this)->find(key);
+	}
+
+	bool contains(const Key &key) const {
+		return find_index(key, _Hash(key)) != npos;
+	}
+
+	size_t count(const Key &key) const {
+		return contains(key) ? 1 : 0;
+	}
+
+	Ty &at(const Key &key) {
+		const size_t idx = find_index(key, _Hash(key));
+		if (idx == npos) {
+			throw std::runtime_error("flat_hash_map key not found!");
+		}
+		return _Slots[idx].second;
+	}
+
+	const Ty &at(const Key &key) const {
+		return const_cast<flat_hash_map *>(this)->at(key);
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+		const size_t h = _Hash(key);
+		auto [idx, inserted] = find_or_prepare_insert(key, h);
+		if (inserted) {
+			std::construct_at(_Slots + idx, std::piecewise_construct, std::forward_as_tuple(key),
+			                  std::forward_as_tuple(nstd::forward<Args>(args)...));
+			finish_insert(idx, h);
+		}
+		return { iterator(_Ctrl + idx, _Slots + idx), inserted };
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+		const size_t h = _Hash(key);
+		auto [idx, inserted] = find_or_prepare_insert(key, h);
+		if (inserted) {
+			std::construct_at(_Slots + idx, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+			                  std::forward_as_tuple(nstd::forward<Args>(args)...));
+			finish_insert(idx, h);
+		}
+		return { iterator(_Ctrl + idx, _Slots + idx), inserted };
+	}
+
+	std::pair<iterator, bool> insert(const value_type &val) {
+		return try_emplace(val.first, val.second);
+	}
+
+	std::pair<iterator, bool> insert(value_type &&val) {
+		return try_emplace(val.first, std::move(val.second));
+	}
+
+	template<typename M>
+	std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+		auto res = try_emplace(key, nstd::forward<M>(obj));
+		if (!res.second) {
+			res.first->second = nstd::forward<M>(obj);
+		}
+		return res;
+	}
+
+	Ty &operator[](const Key &key) {
+		return try_emplace(key).first->second;
+	}
+
+	Ty &operator[](Key &&key) {
+		return try_emplace(std::move(key)).first->second;
+	}
+
+	size_t erase(const Key &key) {
+		const size_t idx = find_index(key, _Hash(key));
+		if (idx == npos) {
+			return 0;
+		}
+		erase_index(idx);
+		return 1;
+	}
+
+	// does not return the next iterator (that would cost a scan), use the erase-then-increment idiom:
+	// `map.erase(it++)`, which stays valid since erasing never moves other elements
+	void erase(const_iterator pos) noexcept {
+		erase_index(static_cast<size_t>(pos._Slot - _Slots));
+	}
+};
+
+}  // namespace nstd
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <io/nstd_dtype.h>
+#include <io/nstd_file.h>
+#include <util/nstd_bounds.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * ndarrays living in a memory-mapped file, nothing is read until it is touched
+ * file layout:
+ *     [ mapped_header (128 bytes) | padding up to _DataOffset | elements ]
+ * 1. header fields are stored in native byte order, files are not portable across endianness
+ * 2. _DataOffset is a multiple of _Alignment, the mapping itself is page-aligned
+ * 3. in map_mode::read_only the elements must not be written, the pages are mapped read-only and a write faults
+ */
+
+namespace nstd {
+
+struct mapped_header {
+	static constexpr char magic[8] = { 'N', 'S', 'T', 'D', 'A', 'R', 'R', '\0' };
+	static constexpr unsigned int current_version = 1;
+	static constexpr size_t max_rank = 12;
+
+	char _Magic[8];
+	unsigned int _Version;
+	dtype _Dtype;
+	layout _Layout;
+	unsigned short _Rank;
+	unsigned long long _Alignment;
+	unsigned long long _DataOffset;
+	unsigned long long _Shape[max_rank];
+
+	constexpr size_t count() const noexcept {
+		size_t res = 1;
+		for (size_t i = 0; i < _Rank; i++) {
+			res *= static_cast<size_t>(_Shape[i]);
+		}
+		return res;
+	}
+};
+
+static_assert(sizeof(mapped_header) == 128);
+
+namespace internal {
+
+// bytes of the elements, throws when that does not fit size_t: the header of an opened file is untrusted
+inline size_t mapped_bytes(const mapped_header &header, size_t elem_size) {
+	constexpr size_t max = std::numeric_limits<size_t>::max();
+	const size_t rank = header._Rank < mapped_header::max_rank ? header._Rank : mapped_header::max_rank;
+	for (size_t i = 0; i < rank; i++) {
+		if (header._Shape[i] == 0) {
+			return 0;
+		}
+	}
+	size_t res = elem_size;
+	for (size_t i = 0; i < rank; i++) {
+		if (header._Shape[i] > max / res) {
+			throw std::runtime_error("mapped_ndarray size overflow!");
+		}
+		res *= static_cast<size_t>(header._Shape[i]);
+	}
+	return res;
+}
+
+// the file, its mapping and the validated header, shared by the static and dynamic shape arrays
+class mapped_storage {
+	file _File;
+	mapped_region _Region;
+	mapped_header _Header{};
+
+public:
+	mapped_storage() noexcept = default;
+
+	mapped_storage(const char *path, map_mode mode, dtype type, size_t rank)
+	    : _File(path, mode == map_mode::read_write ? open_mode::read_write : open_mode::read) {
+		const size_t file_size = _File.size();
+		if (file_size < sizeof(mapped_header)) {
+			throw std::runtime_error("mapped_ndarray file too small for a header!");
+		}
+		_File.read_at(&_Header, sizeof(mapped_header), 0);
+		if (std::memcmp(_Header._Magic, mapped_header::magic, sizeof(mapped_header::magic)) != 0) {
+			throw std::runtime_error("mapped_ndarray bad magic!");
+		}
+		if (_Header._Version != mapped_header::current_version) {
+			throw std::runtime_error("mapped_ndarray unsupported version!");
+		}
+		if (_Header._Dtype != type) {
+			throw std::runtime_error("mapped_ndarray dtype mismatch!");
+		}
+		if (_Header._Rank != rank) {
+			throw std::runtime_error("mapped_ndarray rank mismatch!");
+		}
+		if (_Header._Alignment == 0 || (_Header._Alignment & (_Header._Alignment - 1)) != 0) {
+			throw std::runtime_error("mapped_ndarray alignment must be a power of two!");
+		}
+		if (_Header._DataOffset < sizeof(mapped_header) || _Header._DataOffset % _Header._Alignment != 0) {
+			throw std::runtime_error("mapped_ndarray bad data offset!");
+		}
+		// subtract instead of adding, neither side can wrap
+		if (_Header._DataOffset > file_size || mapped_bytes(_Header, dtype_size(type)) > file_size - _Header._DataOffset) {
+			throw std::runtime_error("mapped_ndarray file truncated!");
+		}
+		_Region = mapped_region(_File, mode);
+	}
+
+	// writes a header for a zero-filled array of the given shape and maps it read-write
+	static mapped_storage create(const char *path, dtype type, size_t rank, const size_t *shape, layout order, size_t alignment) {
+		if (rank == 0 || rank > mapped_header::max_rank) {
+			throw std::runtime_error("mapped_ndarray rank out of bounds!");
+		}
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+			throw std::runtime_error("mapped_ndarray alignment must be a power of two!");
+		}
+
+		mapped_storage res;
+		mapped_header &header = res._Header;
+		std::memcpy(header._Magic, mapped_header::magic, sizeof(mapped_header::magic));
+		header._Version = mapped_header::current_version;
+		header._Dtype = type;
+		header._Layout = order;
+		header._Rank = static_cast<unsigned short>(rank);
+		header._Alignment = alignment;
+		header._DataOffset = (sizeof(mapped_header) + alignment - 1) / alignment * alignment;
+		for (size_t i = 0; i < rank; i++) {
+			header._Shape[i] = shape[i];
+		}
+
+		const size_t bytes = mapped_bytes(header, dtype_size(type));
+		if (bytes > std::numeric_limits<size_t>::max() - header._DataOffset) {
+			throw std::runtime_error("mapped_ndarray size overflow!");
+		}
+
+		res._File = file(path, open_mode::create);
+		res._File.write_at(&header, sizeof(mapped_header), 0);
+		res._File.resize(static_cast<size_t>(header._DataOffset) + bytes);  // zero-filled, sparse where supported
+		res._Region = mapped_region(res._File, map_mode::read_write);
+		return res;
+	}
+
+	const mapped_header &header() const noexcept {
+		return _Header;
+	}
+
+	const mapped_region &region() const noexcept {
+		return _Region;
+	}
+
+	void *data() const noexcept {
+		return _Region.data() + _Header._DataOffset;
+	}
+
+	void advise(access_hint hint) const noexcept {
+		_Region.advise(hint, static_cast<size_t>(_Header._DataOffset), _Header.count() * dtype_size(_Header._Dtype));
+	}
+};
+
+}  // namespace internal
+
+template<typename Ty, bool exception, size_t... DimSize>
+    requires(sizeof...(DimSize) > 0 && sizeof...(DimSize) <= mapped_header::max_rank && dtype_of_v<Ty> != dtype::unknown)
+class basic_mapped_ndarray {
+	internal::mapped_storage _Storage;
+	Ty *_Data = nullptr;
+
+	explicit basic_mapped_ndarray(internal::mapped_storage &&storage) noexcept
+	    : _Storage(static_cast<internal::mapped_storage &&>(storage))
+	    , _Data(static_cast<Ty *>(_Storage.data())) {}
+
+	static internal::mapped_storage open_checked(const char *path, map_mode mode) {
+		internal::mapped_storage storage(path, mode, dtype_of_v<Ty>, rank);
+		const mapped_header &header = storage.header();
+		for (size_t i = 0; i < rank; i++) {
+			if (header._Shape[i] != shape[i]) {
+				throw std::runtime_error("mapped_ndarray shape mismatch!");
+			}
+		}
+		if (header._Layout != layout::row_major && rank > 1) {
+			throw std::runtime_error("mapped_ndarray layout mismatch, use dynamic_mapped_ndarray for column-major files!");
+		}
+		if (header._DataOffset % alignof(Ty) != 0) {
+			throw std::runtime_error("mapped_ndarray misaligned data!");
+		}
+		return storage;
+	}
+
+public:
+	static constexpr size_t arr_size = (DimSize * ...);
+	static constexpr size_t rank = sizeof...(DimSize);
+	static constexpr size_t shape[] = { DimSize... };
+
+	basic_mapped_ndarray() noexcept = default;
+
+	explicit basic_mapped_ndarray(const char *path, map_mode mode = map_mode::read_only)
+	    : basic_mapped_ndarray(open_checked(path, mode)) {}
+
+	basic_mapped_ndarray(basic_mapped_ndarray &&rhs) noexcept
+	    : _Storage(static_cast<internal::mapped_storage &&>(rhs._Storage))
+	    , _Data(rhs._Data) {
+		rhs._Data = nullptr;
+	}
+
+	basic_mapped_ndarray &operator=(basic_mapped_ndarray &&rhs) noexcept {
+		_Storage = static_cast<internal::mapped_storage &&>(rhs._Storage);
+		_Data = rhs._Data;
+		rhs._Data = nullptr;
+		return *this;
+	}
+
+	// creates (or truncates) path as a zero-filled array, mapped read-write
+	static basic_mapped_ndarray create(const char *path, size_t alignment = cache_line_size) {
+		if (alignment < alignof(Ty)) {
+			alignment = alignof(Ty);
+		}
+		return basic_mapped_ndarray(internal::mapped_storage::create(path, dtype_of_v<Ty>, rank, shape, layout::row_major, alignment));
+	}
+
+	decltype(auto) operator[](size_t i) const noexcept(!exception) {
+		internal::ndarray_visitor<const Ty, exception, rank - 1, DimSize...> visitor{ _Data, 0 };
+		return visitor[i];
+	}
+
+	decltype(auto) operator[](size_t i) noexcept(!exception) {
+		internal::ndarray_visitor<Ty, exception, rank - 1, DimSize...> visitor{ _Data, 0 };
+		return visitor[i];
+	}
+
+	Ty *data() noexcept {
+		return _Data;
+	}
+
+	const Ty *data() const noexcept {
+		return _Data;
+	}
+
+	bool is_open() const noexcept {
+		return _Data != nullptr;
+	}
+
+	map_mode mode() const noexcept {
+		return _Storage.region().mode();
+	}
+
+	void advise(access_hint hint) const noexcept {
+		_Storage.advise(hint);
+	}
+
+	// writes dirty pages back, only meaningful in map_mode::read_write
+	void flush() {
+		_Storage.region().flush();
+	}
+};
+
+template<typename Ty, size_t... DimSize>
+using mapped_ndarray = basic_mapped_ndarray<Ty, false, DimSize...>;
+
+template<typename Ty, size_t... DimSize>
+using mapped_ndarray_strict = basic_mapped_ndarray<Ty, true, DimSize...>;
+
+// shape read from the file, only the rank is fixed; row- and column-major files are both accepted
+template<typename Ty, bool exception, size_t Rank>
+    requires(Rank > 0 && Rank <= mapped_header::max_rank && dtype_of_v<Ty> != dtype::unknown)
+class basic_dynamic_mapped_ndarray {
+	internal::mapped_storage _Storage;
+	Ty *_Data = nullptr;
+	size_t _Shape[Rank]{};
+	size_t _Strides[Rank]{};  // in elements
+	size_t _Size = 0;
+
+	explicit basic_dynamic_mapped_ndarray(internal::mapped_storage &&storage)
+	    : _Storage(static_cast<internal::mapped_storage &&>(storage))
+	    , _Data(static_cast<Ty *>(_Storage.data())) {
+		const mapped_header &header = _Storage.header();
+		if (header._DataOffset % alignof(Ty) != 0) {
+			throw std::runtime_error("mapped_ndarray misaligned data!");
+		}
+		for (size_t i = 0; i < Rank; i++) {
+			_Shape[i] = static_cast<size_t>(header._Shape[i]);
+		}
+		size_t stride = 1;
+		if (header._Layout == layout::row_major) {
+			for (size_t i = Rank; i-- > 0;) {
+				_Strides[i] = stride;
+				stride *= _Shape[i];
+			}
+		} else {
+			for (size_t i = 0; i < Rank; i++) {
+				_Strides[i] = stride;
+				stride *= _Shape[i];
+			}
+		}
+		_Size = stride;
+	}
+
+	void take_shape(basic_dynamic_mapped_ndarray &rhs) noexcept {
+		_Data = rhs._Data;
+		_Size = rhs._Size;
+		for (size_t i = 0; i < Rank; i++) {
+			_Shape[i] = rhs._Shape[i];
+			_Strides[i] = rhs._Strides[i];
+		}
+		rhs._Data = nullptr;
+		rhs._Size = 0;
+	}
+
+public:
+	static constexpr size_t rank = Rank;
+
+	basic_dynamic_mapped_ndarray() noexcept = default;
+
+	explicit basic_dynamic_mapped_ndarray(const char *path, map_mode mode = map_mode::read_only)
+	    : basic_dynamic_mapped_ndarray(internal::mapped_storage(path, mode, dtype_of_v<Ty>, Rank)) {}
+
+	basic_dynamic_mapped_ndarray(basic_dynamic_mapped_ndarray &&rhs) noexcept
+	    : _Storage(static_cast<internal::mapped_storage &&>(rhs._Storage)) {
+		take_shape(rhs);
+	}
+
+	basic_dynamic_mapped_ndarray &operator=(basic_dynamic_mapped_ndarray &&rhs) noexcept {
+		_Storage = static_cast<internal::mapped_storage &&>(rhs._Storage);
+		take_shape(rhs);
+		return *this;
+	}
+
+	static basic_dynamic_mapped_ndarray create(const char *path, const size_t (&shape)[Rank], layout order = layout::row_major, size_t alignment = cache_line_size) {
+		if (alignment < alignof(Ty)) {
+			alignment = alignof(Ty);
+		}
+		return basic_dynamic_mapped_ndarray(internal::mapped_storage::create(path, dtype_of_v<Ty>, Rank, shape, order, alignment));
+	}
+
+	decltype(auto) operator[](size_t i) const noexcept(!exception) {
+		internal::strided_visitor<const Ty, exception, Rank - 1> visitor{ _Data, _Shape, _Strides };
+		return visitor[i];
+	}
+
+	decltype(auto) operator[](size_t i) noexcept(!exception) {
+		internal::strided_visitor<Ty, exception, Rank - 1> visitor{ _Data, _Shape, _Strides };
+		return visitor[i];
+	}
+
+	Ty *data() noexcept {
+		return _Data;
+	}
+
+	const Ty *data() const noexcept {
+		return _Data;
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	size_t extent(size_t dim) const noexcept {
+		NSTD_BOUNDS_ASSERT(dim < Rank);
+		return _Shape[dim];
+	}
+
+	size_t stride(size_t dim) const noexcept {
+		NSTD_BOUNDS_ASSERT(dim < Rank);
+		return _Strides[dim];
+	}
+
+	layout order() const noexcept {
+		return _Storage.header()._Layout;
+	}
+
+	bool is_open() const noexcept {
+		return _Data != nullptr;
+	}
+
+	map_mode mode() const noexcept {
+		return _Storage.region().mode();
+	}
+
+	void advise(access_hint hint) const noexcept {
+		_Storage.advise(hint);
+	}
+
+	void flush() {
+		_Storage.region().flush();
+	}
+};
+
+template<typename Ty, size_t Rank>
+using dynamic_mapped_ndarray = basic_dynamic_mapped_ndarray<Ty, false, Rank>;
+
+template<typename Ty, size_t Rank>
+using dynamic_mapped_ndarray_strict = basic_dynamic_mapped_ndarray<Ty, true, Rank>;
+
+}  // namespace nstd
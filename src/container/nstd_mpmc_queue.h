@@ -0,0 +1,191 @@
+#pragma once
+
+#include <memory/nstd_uninitialized.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+/*
+ * bounded lock-free multi-producer / multi-consumer queue (Vyukov's sequenced cells)
+ * 1. capacity is rounded up to a power of two, cells are allocated once in the constructor
+ * 2. a cell's sequence number tells whose turn it is:
+ *    seq == pos       -> free for the producer claiming pos
+ *    seq == pos + 1   -> filled, ready for the consumer claiming pos
+ * 3. batches claim a run of consecutive ready cells with a single CAS
+ * 4. constructing an element must not throw, a claimed cell that is never published stalls its consumer
+ */
+
+namespace nstd {
+
+template<typename Ty>
+class mpmc_queue {
+	struct cell {
+		std::atomic<size_t> _Seq;
+		alignas(Ty) unsigned char _Storage[sizeof(Ty)];
+
+		Ty *ptr() noexcept {
+			return reinterpret_cast<Ty *>(_Storage);
+		}
+	};
+
+	static constexpr size_t cell_align = alignof(cell) > cache_line_size ? alignof(cell) : cache_line_size;
+
+	alignas(cache_line_size) std::atomic<size_t> _EnqueuePos{ 0 };
+	alignas(cache_line_size) std::atomic<size_t> _DequeuePos{ 0 };
+	alignas(cache_line_size) cell *_Cells = nullptr;
+	size_t _Mask = 0;
+
+	static size_t round_up_pow2(size_t n) noexcept {
+		size_t res = 2;
+		while (res < n) {
+			res <<= 1;
+		}
+		return res;
+	}
+
+	/*
+	 * ! assumptions !
+	 * 1. Offset is 0 for producers and 1 for consumers
+	 * 2. returns how many cells starting at pos (at most n) are ready for the caller,
+	 *    sets lagging when the very first cell still belongs to the previous lap
+	 */
+	template<size_t Offset>
+	size_t ready_run(size_t pos, size_t n, bool &lagging) const noexcept {
+		size_t run = 0;
+		lagging = false;
+		for (; run < n; run++) {
+			const size_t p = pos + run;
+			const size_t seq = _Cells[p & _Mask]._Seq.load(std::memory_order_acquire);
+			if (seq != p + Offset) {
+				lagging = run == 0 && static_cast<ptrdiff_t>(seq - (p + Offset)) < 0;
+				break;
+			}
+		}
+		return run;
+	}
+
+	// claims up to n cells on the given side, returns the first claimed position through pos
+	template<size_t Offset>
+	size_t claim(std::atomic<size_t> &side, size_t n, size_t &pos) noexcept {
+		pos = side.load(std::memory_order_relaxed);
+		for (;;) {
+			bool lagging;
+			const size_t run = ready_run<Offset>(pos, n, lagging);
+			if (run == 0) {
+				if (lagging) {
+					return 0;  // full (producer) / empty (consumer)
+				}
+				pos = side.load(std::memory_order_relaxed);  // another thread got there first
+				continue;
+			}
+			if (side.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+				return run;
+			}
+		}
+	}
+
+public:
+	using value_type = Ty;
+
+	explicit mpmc_queue(size_t capacity) {
+		if (capacity == 0) {
+			throw std::runtime_error("mpmc_queue capacity must be non-zero!");
+		}
+		const size_t cap = round_up_pow2(capacity);
+		_Cells = static_cast<cell *>(::operator new(cap * sizeof(cell), std::align_val_t{ cell_align }));
+		for (size_t i = 0; i < cap; i++) {
+			std::construct_at(&_Cells[i]._Seq, i);
+		}
+		_Mask = cap - 1;
+	}
+
+	mpmc_queue(const mpmc_queue &) = delete;
+	mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+	~mpmc_queue() {
+		const size_t tail = _EnqueuePos.load(std::memory_order_relaxed);
+		for (size_t i = _DequeuePos.load(std::memory_order_relaxed); i != tail; i++) {
+			internal::destroy_n(_Cells[i & _Mask].ptr(), 1);
+		}
+		::operator delete(static_cast<void *>(_Cells), std::align_val_t{ cell_align });
+	}
+
+	size_t capacity() const noexcept {
+		return _Mask + 1;
+	}
+
+	template<typename... Args>
+	bool try_emplace(Args &&...args) {
+		size_t pos;
+		if (claim<0>(_EnqueuePos, 1, pos) == 0) {
+			return false;
+		}
+		cell &c = _Cells[pos & _Mask];
+		std::construct_at(c.ptr(), nstd::forward<Args>(args)...);
+		c._Seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push(const Ty &val) {
+		return try_emplace(val);
+	}
+
+	bool try_push(Ty &&val) {
+		return try_emplace(static_cast<Ty &&>(val));
+	}
+
+	bool try_pop(Ty &out) {
+		size_t pos;
+		if (claim<1>(_DequeuePos, 1, pos) == 0) {
+			return false;
+		}
+		cell &c = _Cells[pos & _Mask];
+		out = static_cast<Ty &&>(*c.ptr());
+		internal::destroy_n(c.ptr(), 1);
+		c._Seq.store(pos + _Mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	// copies up to n elements into consecutive cells claimed at once, returns how many were pushed
+	size_t push_n(const Ty *src, size_t n) {
+		size_t pos;
+		const size_t count = n == 0 ? 0 : claim<0>(_EnqueuePos, n, pos);
+		for (size_t i = 0; i < count; i++) {
+			cell &c = _Cells[(pos + i) & _Mask];
+			std::construct_at(c.ptr(), src[i]);
+			c._Seq.store(pos + i + 1, std::memory_order_release);
+		}
+		return count;
+	}
+
+	// moves up to n elements into dst (which holds live objects), returns how many were popped
+	size_t pop_n(Ty *dst, size_t n) {
+		size_t pos;
+		const size_t count = n == 0 ? 0 : claim<1>(_DequeuePos, n, pos);
+		for (size_t i = 0; i < count; i++) {
+			cell &c = _Cells[(pos + i) & _Mask];
+			dst[i] = static_cast<Ty &&>(*c.ptr());
+			internal::destroy_n(c.ptr(), 1);
+			c._Seq.store(pos + i + _Mask + 1, std::memory_order_release);
+		}
+		return count;
+	}
+
+	// only a snapshot while other threads are active
+	size_t size_approx() const noexcept {
+		const size_t head = _DequeuePos.load(std::memory_order_acquire);
+		const size_t tail = _EnqueuePos.load(std::memory_order_acquire);
+		return static_cast<ptrdiff_t>(tail - head) > 0 ? tail - head : 0;
+	}
+
+	bool empty_approx() const noexcept {
+		return size_approx() == 0;
+	}
+};
+
+}  // namespace nstd
@@ -1,75 +1,168 @@
 #pragma once
 
+#include <util/nstd_bounds.h>
+#include <util/nstd_profile.h>
 #include <util/nstd_type_traits.h>
 
-// TODO: REMOVE this dep in future versions
-#include <cassert>
-#include <stdexcept>
+// TODO: REMOVE these deps in future versions
+#include <iterator>
+#include <ranges>
+#include <utility>
 
 namespace nstd {
 
-template<typename Ty, bool exception, size_t... DimSize>
-    requires(sizeof...(DimSize) > 0)
-class basic_ndarray {
-	template<typename _Ty, size_t N, size_t CurrDim, size_t... RemainDim>
-	struct basic_ndarray_visitor {
-		_Ty *_Data;
-		size_t _Offset;
-
-		constexpr basic_ndarray_visitor(_Ty *data, size_t offset) noexcept(!exception)
-		    : _Data(data)
-		    , _Offset(offset) {}
-
-		constexpr basic_ndarray_visitor<_Ty, N - 1, RemainDim...> operator[](size_t i) noexcept(!exception) {
-			if constexpr (exception) {
-				if (i >= CurrDim) {
-					throw std::runtime_error("basic_ndarray out of bounds!");
-				}
+namespace internal {
+
+// row-major indexing over a flat buffer of compile-time shape, one operator[] per dimension
+template<typename Ty, bool exception, size_t N, size_t CurrDim, size_t... RemainDim>
+struct ndarray_visitor {
+	Ty *_Data;
+	size_t _Offset;
+
+	constexpr ndarray_visitor(Ty *data, size_t offset) noexcept(!exception)
+	    : _Data(data)
+	    , _Offset(offset) {}
+
+	constexpr ndarray_visitor<Ty, exception, N - 1, RemainDim...> operator[](size_t i) noexcept(!exception) {
+		if constexpr (exception) {
+			if (i >= CurrDim) [[unlikely]] {
+				bounds_failure("basic_ndarray out of bounds!");
 			}
-			return { _Data, _Offset + i * (RemainDim * ...) };
 		}
-	};
+		return { _Data, _Offset + i * (RemainDim * ...) };
+	}
+};
 
-	template<typename _Ty, size_t CurrDim>
-	struct basic_ndarray_visitor<_Ty, 0, CurrDim> {
-		_Ty *_Data;
-		size_t _Offset;
+template<typename Ty, bool exception, size_t CurrDim>
+struct ndarray_visitor<Ty, exception, 0, CurrDim> {
+	Ty *_Data;
+	size_t _Offset;
 
-		constexpr basic_ndarray_visitor(_Ty *data, size_t offset) noexcept(!exception)
-		    : _Data(data)
-		    , _Offset(offset) {}
+	constexpr ndarray_visitor(Ty *data, size_t offset) noexcept(!exception)
+	    : _Data(data)
+	    , _Offset(offset) {}
 
-		constexpr _Ty &operator[](size_t i) noexcept(!exception) {
-			if constexpr (exception) {
-				if (i >= CurrDim) {
-					throw std::runtime_error("basic_ndarray out of bounds!");
-				}
+	constexpr Ty &operator[](size_t i) noexcept(!exception) {
+		if constexpr (exception) {
+			if (i >= CurrDim) [[unlikely]] {
+				bounds_failure("basic_ndarray out of bounds!");
 			}
-			return _Data[_Offset + i];
 		}
-	};
+		return _Data[_Offset + i];
+	}
+};
 
-private:
+// the same indexing over runtime extents and element strides, N is the number of remaining dimensions minus one
+template<typename Ty, bool exception, size_t N>
+struct strided_visitor {
+	Ty *_Data;
+	const size_t *_Extents;
+	const size_t *_Strides;
+
+	constexpr strided_visitor(Ty *data, const size_t *extents, const size_t *strides) noexcept
+	    : _Data(data)
+	    , _Extents(extents)
+	    , _Strides(strides) {}
+
+	constexpr decltype(auto) operator[](size_t i) const noexcept(!exception) {
+		if constexpr (exception) {
+			if (i >= _Extents[0]) [[unlikely]] {
+				bounds_failure("basic_ndarray out of bounds!");
+			}
+		}
+		if constexpr (N == 0) {
+			return static_cast<Ty &>(_Data[i * _Strides[0]]);
+		} else {
+			return strided_visitor<Ty, exception, N - 1>{ _Data + i * _Strides[0], _Extents + 1, _Strides + 1 };
+		}
+	}
+};
+
+}  // namespace internal
+
+template<typename Ty, bool exception, size_t... DimSize>
+    requires(sizeof...(DimSize) > 0)
+class basic_ndarray {
 	Ty _Data[(DimSize * ...)]{};
 
 public:
+	using value_type = Ty;
+	using iterator = Ty *;
+	using const_iterator = const Ty *;
+
 	constexpr basic_ndarray() = default;
 
 	constexpr decltype(auto) operator[](size_t i) const noexcept(!exception) {
-		basic_ndarray_visitor<const Ty, sizeof...(DimSize) - 1, DimSize...> visitor{
+		internal::ndarray_visitor<const Ty, exception, sizeof...(DimSize) - 1, DimSize...> visitor{
 			_Data, 0
 		};
 		return visitor[i];
 	}
 
 	constexpr decltype(auto) operator[](size_t i) noexcept(!exception) {
-		basic_ndarray_visitor<Ty, sizeof...(DimSize) - 1, DimSize...> visitor{
+		internal::ndarray_visitor<Ty, exception, sizeof...(DimSize) - 1, DimSize...> visitor{
 			_Data, 0
 		};
 		return visitor[i];
 	}
 
+	// operator[] without bounds checks, for loops whose range was validated up front
+	constexpr auto unchecked() noexcept {
+		return internal::ndarray_visitor<Ty, false, sizeof...(DimSize) - 1, DimSize...>{ _Data, 0 };
+	}
+
+	constexpr auto unchecked() const noexcept {
+		return internal::ndarray_visitor<const Ty, false, sizeof...(DimSize) - 1, DimSize...>{ _Data, 0 };
+	}
+
+	// row-major, arr_size elements
+	constexpr Ty *data() noexcept {
+		return _Data;
+	}
+
+	constexpr const Ty *data() const noexcept {
+		return _Data;
+	}
+
+	// the flat storage in row-major order, a contiguous range of arr_size elements
+	constexpr iterator begin() noexcept {
+		return _Data;
+	}
+
+	constexpr const_iterator begin() const noexcept {
+		return _Data;
+	}
+
+	constexpr iterator end() noexcept {
+		return _Data + arr_size;
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return _Data + arr_size;
+	}
+
+	constexpr const_iterator cbegin() const noexcept {
+		return _Data;
+	}
+
+	constexpr const_iterator cend() const noexcept {
+		return _Data + arr_size;
+	}
+
+	static constexpr size_t size() noexcept {
+		return arr_size;
+	}
+
+	constexpr void fill(const Ty &val) noexcept {
+		NSTD_PROFILE_SCOPE("basic_ndarray::fill");
+		for (size_t i = 0; i < arr_size; i++) {
+			_Data[i] = val;
+		}
+	}
+
 	static constexpr size_t arr_size = (DimSize * ...);
+	static constexpr size_t rank = sizeof...(DimSize);
+	static constexpr size_t shape[] = { DimSize... };
 };
 
 template<typename Ty, size_t... DimSize>
@@ -78,4 +171,418 @@ using ndarray = basic_ndarray<Ty, false, DimSize...>;
 template<typename Ty, size_t... DimSize>
 using ndarray_strict = basic_ndarray<Ty, true, DimSize...>;
 
+// strided_view BEGINS
+/*
+ * non-owning view of a rank-Rank grid with runtime extents and element strides
+ * 1. views of basic_ndarray are row-major and dense; slice() keeps a sub-range (optionally every step-th element) of one dimension
+ * 2. a view never outlives the storage it points into, it is cheap to copy and meant to be passed by value
+ */
+template<typename Ty, bool exception, size_t Rank>
+    requires(Rank > 0)
+class basic_strided_view {
+	Ty *_Data = nullptr;
+	size_t _Extents[Rank]{};
+	size_t _Strides[Rank]{};  // in elements
+
+public:
+	using value_type = Ty;
+
+	static constexpr size_t rank = Rank;
+
+	constexpr basic_strided_view() noexcept = default;
+
+	// dense row-major
+	constexpr basic_strided_view(Ty *data, const size_t (&extents)[Rank]) noexcept
+	    : _Data(data) {
+		size_t stride = 1;
+		for (size_t d = Rank; d-- > 0;) {
+			_Extents[d] = extents[d];
+			_Strides[d] = stride;
+			stride *= extents[d];
+		}
+	}
+
+	constexpr basic_strided_view(Ty *data, const size_t (&extents)[Rank], const size_t (&strides)[Rank]) noexcept
+	    : _Data(data) {
+		for (size_t d = 0; d < Rank; d++) {
+			_Extents[d] = extents[d];
+			_Strides[d] = strides[d];
+		}
+	}
+
+	template<typename Uy, bool _exception, size_t... DimSize>
+	    requires(sizeof...(DimSize) == Rank && is_convertible_v<Uy *, Ty *>)
+	constexpr basic_strided_view(basic_ndarray<Uy, _exception, DimSize...> &arr) noexcept
+	    : basic_strided_view(arr.data(), { DimSize... }) {}
+
+	template<typename Uy, bool _exception, size_t... DimSize>
+	    requires(sizeof...(DimSize) == Rank && is_convertible_v<const Uy *, Ty *>)
+	constexpr basic_strided_view(const basic_ndarray<Uy, _exception, DimSize...> &arr) noexcept
+	    : basic_strided_view(arr.data(), { DimSize... }) {}
+
+	// view<T> -> view<const T>
+	template<typename Uy>
+	    requires(!is_same_v<Uy, Ty> && is_convertible_v<Uy *, Ty *>)
+	constexpr basic_strided_view(const basic_strided_view<Uy, exception, Rank> &rhs) noexcept
+	    : _Data(rhs.data()) {
+		for (size_t d = 0; d < Rank; d++) {
+			_Extents[d] = rhs.extent(d);
+			_Strides[d] = rhs.stride(d);
+		}
+	}
+
+	constexpr decltype(auto) operator[](size_t i) const noexcept(!exception) {
+		internal::strided_visitor<Ty, exception, Rank - 1> visitor{ _Data, _Extents, _Strides };
+		return visitor[i];
+	}
+
+	constexpr Ty *data() const noexcept {
+		return _Data;
+	}
+
+	// the same view without bounds checks
+	constexpr basic_strided_view<Ty, false, Rank> unchecked() const noexcept {
+		return { _Data, _Extents, _Strides };
+	}
+
+	// the box [lo, hi), validated once here; element access inside it is unchecked
+	constexpr basic_strided_view<Ty, false, Rank> subview(const size_t (&lo)[Rank], const size_t (&hi)[Rank]) const {
+		Ty *data = _Data;
+		size_t extents[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			if (lo[d] > hi[d] || hi[d] > _Extents[d]) {
+				internal::bounds_failure("strided_view out of bounds!");
+			}
+			data += lo[d] * _Strides[d];
+			extents[d] = hi[d] - lo[d];
+		}
+		return { data, extents, _Strides };
+	}
+
+	constexpr size_t extent(size_t dim) const noexcept {
+		NSTD_BOUNDS_ASSERT(dim < Rank);
+		return _Extents[dim];
+	}
+
+	constexpr size_t stride(size_t dim) const noexcept {
+		NSTD_BOUNDS_ASSERT(dim < Rank);
+		return _Strides[dim];
+	}
+
+	constexpr size_t size() const noexcept {
+		size_t res = 1;
+		for (size_t d = 0; d < Rank; d++) {
+			res *= _Extents[d];
+		}
+		return res;
+	}
+
+	// dense row-major, i.e. data()[0, size()) is exactly the viewed elements
+	constexpr bool is_contiguous() const noexcept {
+		size_t stride = 1;
+		for (size_t d = Rank; d-- > 0;) {
+			if (_Extents[d] != 1 && _Strides[d] != stride) {
+				return false;
+			}
+			stride *= _Extents[d];
+		}
+		return true;
+	}
+
+	// elements begin, begin + step, ... below end along dim
+	constexpr basic_strided_view slice(size_t dim, size_t begin, size_t end, size_t step = 1) const {
+		if (dim >= Rank || begin > end || end > _Extents[dim] || step == 0) {
+			internal::bounds_failure("strided_view out of bounds!");
+		}
+		basic_strided_view res = *this;
+		res._Data = _Data + begin * _Strides[dim];
+		res._Extents[dim] = (end - begin + step - 1) / step;
+		res._Strides[dim] = _Strides[dim] * step;
+		return res;
+	}
+};
+
+template<typename Ty, size_t Rank>
+using strided_view = basic_strided_view<Ty, false, Rank>;
+
+template<typename Ty, size_t Rank>
+using strided_view_strict = basic_strided_view<Ty, true, Rank>;
+
+template<typename Ty, bool exception, size_t... DimSize>
+constexpr basic_strided_view<Ty, exception, sizeof...(DimSize)> make_view(basic_ndarray<Ty, exception, DimSize...> &arr) noexcept {
+	return arr;
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+constexpr basic_strided_view<const Ty, exception, sizeof...(DimSize)> make_view(const basic_ndarray<Ty, exception, DimSize...> &arr) noexcept {
+	return arr;
+}
+
+template<typename Ty, bool exception, size_t Rank>
+constexpr basic_strided_view<Ty, exception, Rank> make_view(const basic_strided_view<Ty, exception, Rank> &view) noexcept {
+	return view;
+}
+// strided_view ENDS
+
+// for_each_index BEGINS
+/*
+ * fn(element, i0, i1, ...) for every index of an array / view, or of the box [lo, hi) of it, in row-major order
+ * 1. the box is validated once, before the first call; elements are then reached by pointer arithmetic, so strict
+ *    arrays and views loop as fast as the non-strict ones
+ * 2. a unit innermost stride gets its own loop, which the compiler can vectorize
+ */
+namespace internal {
+
+template<size_t D, size_t Rank, typename Ty, typename Fn, typename... Idx>
+constexpr void for_each_index_impl(Ty *data, const size_t *lo, const size_t *hi, const size_t *strides, Fn &fn, Idx... idx) {
+	// locals, so that opaque calls in fn cannot force the bounds to be reloaded
+	const size_t begin = lo[D], end = hi[D], stride = strides[D];
+	if constexpr (D + 1 == Rank) {
+		if (stride == 1) {
+			for (size_t i = begin; i < end; i++) {
+				fn(data[i], idx..., i);
+			}
+		} else {
+			for (size_t i = begin; i < end; i++) {
+				fn(data[i * stride], idx..., i);
+			}
+		}
+	} else {
+		for (size_t i = begin; i < end; i++) {
+			for_each_index_impl<D + 1, Rank>(data + i * stride, lo, hi, strides, fn, idx..., i);
+		}
+	}
+}
+
+// the whole of a basic_ndarray, with every extent and stride a constant
+template<size_t... DimSize>
+struct fixed_index_loop {
+	static constexpr size_t rank = sizeof...(DimSize);
+	static constexpr size_t shape[] = { DimSize... };
+
+	template<size_t D, typename Ty, typename Fn, typename... Idx>
+	static constexpr void run(Ty *data, Fn &fn, Idx... idx) {
+		if constexpr (D + 1 == rank) {
+			for (size_t i = 0; i < shape[D]; i++) {
+				fn(data[i], idx..., i);
+			}
+		} else {
+			constexpr size_t stride = [] {
+				size_t res = 1;
+				for (size_t d = D + 1; d < rank; d++) {
+					res *= shape[d];
+				}
+				return res;
+			}();
+			for (size_t i = 0; i < shape[D]; i++) {
+				run<D + 1>(data + i * stride, fn, idx..., i);
+			}
+		}
+	}
+};
+
+template<typename Ty, bool exception, size_t... DimSize>
+fixed_index_loop<DimSize...> fixed_index_loop_of(const basic_ndarray<Ty, exception, DimSize...> &);
+
+}  // namespace internal
+
+template<typename Src, typename Fn>
+    requires requires(Src &src) { make_view(src); }
+constexpr void for_each_index(Src &&src, const size_t (&lo)[remove_cvref_t<decltype(make_view(src))>::rank],
+                              const size_t (&hi)[remove_cvref_t<decltype(make_view(src))>::rank], Fn &&fn) {
+	const auto view = make_view(src);
+	constexpr size_t rank = decltype(view)::rank;
+	size_t strides[rank];
+	for (size_t d = 0; d < rank; d++) {
+		if (lo[d] > hi[d] || hi[d] > view.extent(d)) {
+			internal::bounds_failure("for_each_index out of bounds!");
+		}
+		strides[d] = view.stride(d);
+	}
+	internal::for_each_index_impl<0, rank>(view.data(), lo, hi, strides, fn);
+}
+
+template<typename Src, typename Fn>
+    requires requires(Src &src) { make_view(src); }
+constexpr void for_each_index(Src &&src, Fn &&fn) {
+	if constexpr (requires { internal::fixed_index_loop_of(src); }) {
+		decltype(internal::fixed_index_loop_of(src))::template run<0>(src.data(), fn);
+	} else {
+		const auto view = make_view(src);
+		constexpr size_t rank = decltype(view)::rank;
+		size_t lo[rank]{}, hi[rank], strides[rank];
+		for (size_t d = 0; d < rank; d++) {
+			hi[d] = view.extent(d);
+			strides[d] = view.stride(d);
+		}
+		internal::for_each_index_impl<0, rank>(view.data(), lo, hi, strides, fn);
+	}
+}
+// for_each_index ENDS
+
+// index_range BEGINS
+/*
+ * every coordinate of an N-D grid in row-major order, together with its element offset
+ * 1. for (auto [i, j, k] : indices(arr)) visits the coordinates, (*it).offset() is the matching index into data()
+ * 2. the iterator steps by adding the innermost stride and, on wrap-around, subtracting a precomputed extent * stride:
+ *    no multiplication per step
+ * 3. a forward range of known size (a std::ranges::view), ended by std::default_sentinel
+ */
+template<size_t Rank>
+    requires(Rank > 0)
+struct nd_index {
+	size_t _Coords[Rank]{};
+	size_t _Offset = 0;
+
+	constexpr size_t operator[](size_t dim) const noexcept {
+		NSTD_BOUNDS_ASSERT(dim < Rank);
+		return _Coords[dim];
+	}
+
+	constexpr size_t offset() const noexcept {
+		return _Offset;
+	}
+
+	template<size_t I>
+	    requires(I < Rank)
+	constexpr size_t get() const noexcept {
+		return _Coords[I];
+	}
+};
+
+template<size_t Rank>
+class index_iterator {
+	nd_index<Rank> _Index;
+	size_t _Extents[Rank]{};
+	size_t _Strides[Rank]{};
+	size_t _Rewind[Rank]{};  // extent * stride
+	size_t _Remaining = 0;
+
+public:
+	using value_type = nd_index<Rank>;
+	using reference = nd_index<Rank>;  // by value: a reference into the iterator would dangle once it moves on
+	using difference_type = ptrdiff_t;
+	using iterator_concept = std::forward_iterator_tag;
+	using iterator_category = std::input_iterator_tag;  // C++17 forward iterators must yield real references, like iota_view
+
+	constexpr index_iterator() noexcept = default;
+
+	constexpr index_iterator(const size_t (&extents)[Rank], const size_t (&strides)[Rank]) noexcept {
+		_Remaining = 1;
+		for (size_t d = 0; d < Rank; d++) {
+			_Extents[d] = extents[d];
+			_Strides[d] = strides[d];
+			_Rewind[d] = extents[d] * strides[d];
+			_Remaining *= extents[d];
+		}
+	}
+
+	constexpr nd_index<Rank> operator*() const noexcept {
+		return _Index;
+	}
+
+	constexpr const nd_index<Rank> *operator->() const noexcept {
+		return &_Index;
+	}
+
+	constexpr index_iterator &operator++() noexcept {
+		NSTD_BOUNDS_ASSERT(_Remaining > 0);
+		--_Remaining;
+		for (size_t d = Rank; d-- > 0;) {
+			_Index._Offset += _Strides[d];
+			if (++_Index._Coords[d] != _Extents[d] || d == 0) {
+				break;
+			}
+			_Index._Coords[d] = 0;
+			_Index._Offset -= _Rewind[d];
+		}
+		return *this;
+	}
+
+	constexpr index_iterator operator++(int) noexcept {
+		index_iterator res = *this;
+		++*this;
+		return res;
+	}
+
+	constexpr size_t remaining() const noexcept {
+		return _Remaining;
+	}
+
+	// iterators of the same range
+	friend constexpr bool operator==(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+		return lhs._Remaining == rhs._Remaining;
+	}
+
+	friend constexpr bool operator==(const index_iterator &it, std::default_sentinel_t) noexcept {
+		return it._Remaining == 0;
+	}
+};
+
+template<size_t Rank>
+    requires(Rank > 0)
+class index_range : public std::ranges::view_interface<index_range<Rank>> {
+	index_iterator<Rank> _Begin;
+
+public:
+	constexpr index_range() noexcept = default;
+
+	// dense row-major offsets
+	constexpr explicit index_range(const size_t (&extents)[Rank]) noexcept {
+		size_t strides[Rank];
+		size_t stride = 1;
+		for (size_t d = Rank; d-- > 0;) {
+			strides[d] = stride;
+			stride *= extents[d];
+		}
+		_Begin = { extents, strides };
+	}
+
+	constexpr index_range(const size_t (&extents)[Rank], const size_t (&strides)[Rank]) noexcept
+	    : _Begin(extents, strides) {}
+
+	constexpr index_iterator<Rank> begin() const noexcept {
+		return _Begin;
+	}
+
+	constexpr std::default_sentinel_t end() const noexcept {
+		return std::default_sentinel;
+	}
+
+	constexpr size_t size() const noexcept {
+		return _Begin.remaining();
+	}
+};
+
+template<size_t Rank>
+constexpr index_range<Rank> indices(const size_t (&extents)[Rank]) noexcept {
+	return index_range<Rank>(extents);
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+constexpr index_range<sizeof...(DimSize)> indices(const basic_ndarray<Ty, exception, DimSize...> &) noexcept {
+	return index_range<sizeof...(DimSize)>({ DimSize... });
+}
+
+// offsets are relative to view.data()
+template<typename Ty, bool exception, size_t Rank>
+constexpr index_range<Rank> indices(const basic_strided_view<Ty, exception, Rank> &view) noexcept {
+	size_t extents[Rank], strides[Rank];
+	for (size_t d = 0; d < Rank; d++) {
+		extents[d] = view.extent(d);
+		strides[d] = view.stride(d);
+	}
+	return { extents, strides };
+}
+// index_range ENDS
+
 }  // namespace nstd
+
+// structured bindings for nd_index
+template<nstd::size_t Rank>
+struct std::tuple_size<nstd::nd_index<Rank>> : std::integral_constant<nstd::size_t, Rank> {};
+
+template<nstd::size_t I, nstd::size_t Rank>
+struct std::tuple_element<I, nstd::nd_index<Rank>> {
+	using type = nstd::size_t;
+};
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <container/nstd_static_vector.h>
+#include <memory/nstd_uninitialized.h>
+#include <util/nstd_bounds.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace nstd {
+
+// vector with an inline buffer of N elements, spills to Alloc-provided storage beyond that
+template<typename Ty, size_t N, typename Alloc = std::allocator<Ty>>
+    requires(N > 0)
+class small_vector {
+	using alloc_traits = std::allocator_traits<Alloc>;
+
+	internal::inline_storage<Ty, N> _Inline;
+	Ty *_Ptr = nullptr;  // _Inline.ptr() or heap storage
+	size_t _Size = 0;
+	size_t _Capacity = N;
+	[[no_unique_address]] Alloc _Alloc;
+
+	constexpr bool is_inline() const noexcept {
+		return _Ptr == _Inline.ptr();
+	}
+
+	constexpr void release_heap() noexcept {
+		if (!is_inline()) {
+			alloc_traits::deallocate(_Alloc, _Ptr, _Capacity);
+			_Ptr = _Inline.ptr();
+			_Capacity = N;
+		}
+	}
+
+	constexpr size_t grown_capacity(size_t needed) const noexcept {
+		return needed > _Capacity * 2 ? needed : _Capacity * 2;
+	}
+
+	// buf must hold cap elements, it is released if relocation throws (the elements stay in place)
+	constexpr void relocate_to(Ty *buf, size_t cap) {
+		try {
+			internal::uninitialized_relocate_n(_Ptr, _Size, buf);
+		} catch (...) {
+			alloc_traits::deallocate(_Alloc, buf, cap);
+			throw;
+		}
+		release_heap();
+		_Ptr = buf;
+		_Capacity = cap;
+	}
+
+	// takes over rhs's elements, rhs is left empty (and inline)
+	constexpr void steal(small_vector &rhs) {
+		if (rhs.is_inline()) {
+			internal::uninitialized_relocate_n(rhs._Ptr, rhs._Size, _Ptr);
+		} else {
+			_Ptr = rhs._Ptr;
+			_Capacity = rhs._Capacity;
+			rhs._Ptr = rhs._Inline.ptr();
+			rhs._Capacity = N;
+		}
+		_Size = rhs._Size;
+		rhs._Size = 0;
+	}
+
+public:
+	using value_type = Ty;
+	using allocator_type = Alloc;
+	using size_type = size_t;
+	using reference = Ty &;
+	using const_reference = const Ty &;
+	using pointer = Ty *;
+	using const_pointer = const Ty *;
+	using iterator = Ty *;
+	using const_iterator = const Ty *;
+
+	constexpr small_vector() noexcept(noexcept(Alloc())) {
+		_Ptr = _Inline.ptr();
+	}
+
+	constexpr explicit small_vector(const Alloc &alloc) noexcept
+	    : _Alloc(alloc) {
+		_Ptr = _Inline.ptr();
+	}
+
+	constexpr explicit small_vector(size_t n, const Alloc &alloc = Alloc())
+	    : small_vector(alloc) {
+		resize(n);
+	}
+
+	constexpr small_vector(size_t n, const Ty &val, const Alloc &alloc = Alloc())
+	    : small_vector(alloc) {
+		resize(n, val);
+	}
+
+	constexpr small_vector(std::initializer_list<Ty> init, const Alloc &alloc = Alloc())
+	    : small_vector(alloc) {
+		reserve(init.size());
+		internal::uninitialized_copy_n(init.begin(), init.size(), _Ptr);
+		_Size = init.size();
+	}
+
+	constexpr small_vector(const small_vector &rhs)
+	    : small_vector(alloc_traits::select_on_container_copy_construction(rhs._Alloc)) {
+		reserve(rhs._Size);
+		internal::uninitialized_copy_n(rhs._Ptr, rhs._Size, _Ptr);
+		_Size = rhs._Size;
+	}
+
+	constexpr small_vector(small_vector &&rhs) noexcept(is_trivially_relocatable_v<Ty> || std::is_nothrow_move_constructible_v<Ty>)
+	    : small_vector(static_cast<Alloc &&>(rhs._Alloc)) {
+		steal(rhs);
+	}
+
+	constexpr small_vector &operator=(const small_vector &rhs) {
+		if (this != &rhs) {
+			clear();
+			reserve(rhs._Size);
+			internal::uninitialized_copy_n(rhs._Ptr, rhs._Size, _Ptr);
+			_Size = rhs._Size;
+		}
+		return *this;
+	}
+
+	// like std::vector: unequal allocators that do not propagate move element-wise into a new allocation, which can throw
+	constexpr small_vector &operator=(small_vector &&rhs) noexcept((alloc_traits::propagate_on_container_move_assignment::value ||
+	                                                                alloc_traits::is_always_equal::value) &&
+	                                                               (is_trivially_relocatable_v<Ty> || std::is_nothrow_move_constructible_v<Ty>)) {
+		if (this == &rhs) {
+			return *this;
+		}
+		clear();
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+			release_heap();
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+				_Alloc = static_cast<Alloc &&>(rhs._Alloc);
+			}
+			steal(rhs);
+		} else if (_Alloc == rhs._Alloc) {
+			release_heap();
+			steal(rhs);
+		} else {  // heap storage can not change hands, move element-wise
+			reserve(rhs._Size);
+			internal::uninitialized_relocate_n(rhs._Ptr, rhs._Size, _Ptr);
+			_Size = rhs._Size;
+			rhs._Size = 0;
+		}
+		return *this;
+	}
+
+	constexpr ~small_vector() {
+		clear();
+		release_heap();
+	}
+
+	constexpr Ty *data() noexcept {
+		return _Ptr;
+	}
+
+	constexpr const Ty *data() const noexcept {
+		return _Ptr;
+	}
+
+	constexpr size_t size() const noexcept {
+		return _Size;
+	}
+
+	constexpr size_t capacity() const noexcept {
+		return _Capacity;
+	}
+
+	static constexpr size_t inline_capacity() noexcept {
+		return N;
+	}
+
+	constexpr bool empty() const noexcept {
+		return _Size == 0;
+	}
+
+	// true while the elements still live in the inline buffer
+	constexpr bool is_small() const noexcept {
+		return is_inline();
+	}
+
+	constexpr allocator_type get_allocator() const noexcept {
+		return _Alloc;
+	}
+
+	constexpr Ty &operator[](size_t i) {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return _Ptr[i];
+	}
+
+	constexpr const Ty &operator[](size_t i) const {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return _Ptr[i];
+	}
+
+	constexpr Ty &at(size_t i) {
+		if (i >= _Size) {
+			throw std::runtime_error("small_vector out of bounds!");
+		}
+		return _Ptr[i];
+	}
+
+	constexpr const Ty &at(size_t i) const {
+		if (i >= _Size) {
+			throw std::runtime_error("small_vector out of bounds!");
+		}
+		return _Ptr[i];
+	}
+
+	constexpr Ty &front() {
+		return (*this)[0];
+	}
+
+	constexpr const Ty &front() const {
+		return (*this)[0];
+	}
+
+	constexpr Ty &back() {
+		return (*this)[_Size - 1];
+	}
+
+	constexpr const Ty &back() const {
+		return (*this)[_Size - 1];
+	}
+
+	constexpr iterator begin() noexcept {
+		return _Ptr;
+	}
+
+	constexpr const_iterator begin() const noexcept {
+		return _Ptr;
+	}
+
+	constexpr iterator end() noexcept {
+		return _Ptr + _Size;
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return _Ptr + _Size;
+	}
+
+	constexpr void reserve(size_t n) {
+		if (n > _Capacity) {
+			Ty *buf = alloc_traits::allocate(_Alloc, n);
+			relocate_to(buf, n);
+		}
+	}
+
+	// moves the elements back into the inline buffer when they fit, otherwise trims the heap buffer
+	constexpr void shrink_to_fit() {
+		if (is_inline() || _Size == _Capacity) {
+			return;
+		}
+		if (_Size <= N) {
+			Ty *heap = _Ptr;
+			const size_t heap_cap = _Capacity;
+			internal::uninitialized_relocate_n(heap, _Size, _Inline.ptr());
+			alloc_traits::deallocate(_Alloc, heap, heap_cap);
+			_Ptr = _Inline.ptr();
+			_Capacity = N;
+		} else {
+			Ty *buf = alloc_traits::allocate(_Alloc, _Size);
+			relocate_to(buf, _Size);
+		}
+	}
+
+	template<typename... Args>
+	constexpr Ty &emplace_back(Args &&...args) {
+		if (_Size < _Capacity) {
+			Ty *res = std::construct_at(_Ptr + _Size, nstd::forward<Args>(args)...);
+			_Size++;
+			return *res;
+		}
+
+		// the new element is built before relocating, args may refer to an element of *this
+		const size_t cap = grown_capacity(_Size + 1);
+		Ty *buf = alloc_traits::allocate(_Alloc, cap);
+		Ty *res = nullptr;
+		try {
+			res = std::construct_at(buf + _Size, nstd::forward<Args>(args)...);
+			internal::uninitialized_relocate_n(_Ptr, _Size, buf);
+		} catch (...) {
+			if (res != nullptr) {
+				std::destroy_at(res);
+			}
+			alloc_traits::deallocate(_Alloc, buf, cap);
+			throw;
+		}
+		release_heap();
+		_Ptr = buf;
+		_Capacity = cap;
+		_Size++;
+		return *res;
+	}
+
+	constexpr void push_back(const Ty &val) {
+		emplace_back(val);
+	}
+
+	constexpr void push_back(Ty &&val) {
+		emplace_back(static_cast<Ty &&>(val));
+	}
+
+	constexpr void pop_back() {
+		NSTD_BOUNDS_ASSERT(_Size > 0);
+		_Size--;
+		internal::destroy_n(_Ptr + _Size, 1);
+	}
+
+	constexpr iterator insert(const_iterator pos, Ty val) {
+		const size_t idx = static_cast<size_t>(pos - _Ptr);
+		NSTD_BOUNDS_ASSERT(idx <= _Size);
+		reserve(_Size == _Capacity ? grown_capacity(_Size + 1) : _Size + 1);
+		internal::shift_right_one(_Ptr + idx, _Size - idx);
+		std::construct_at(_Ptr + idx, static_cast<Ty &&>(val));
+		_Size++;
+		return _Ptr + idx;
+	}
+
+	constexpr iterator erase(const_iterator pos) {
+		const size_t idx = static_cast<size_t>(pos - _Ptr);
+		NSTD_BOUNDS_ASSERT(idx < _Size);
+		internal::destroy_n(_Ptr + idx, 1);
+		internal::shift_left_one(_Ptr + idx, _Size - idx);
+		_Size--;
+		return _Ptr + idx;
+	}
+
+	constexpr void resize(size_t n) {
+		if (n < _Size) {
+			internal::destroy_n(_Ptr + n, _Size - n);
+		} else {
+			reserve(n);
+			internal::uninitialized_value_construct_n(_Ptr + _Size, n - _Size);
+		}
+		_Size = n;
+	}
+
+	constexpr void resize(size_t n, const Ty &val) {
+		if (n < _Size) {
+			internal::destroy_n(_Ptr + n, _Size - n);
+		} else {
+			reserve(n);
+			internal::uninitialized_fill_n(_Ptr + _Size, n - _Size, val);
+		}
+		_Size = n;
+	}
+
+	constexpr void clear() noexcept {
+		internal::destroy_n(_Ptr, _Size);
+		_Size = 0;
+	}
+
+	constexpr friend bool operator==(const small_vector &lhs, const small_vector &rhs) {
+		if (lhs._Size != rhs._Size) {
+			return false;
+		}
+		for (size_t i = 0; i < lhs._Size; i++) {
+			if (!(lhs._Ptr[i] == rhs._Ptr[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+}  // namespace nstd
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <container/nstd_static_vector.h>
+#include <memory/nstd_uninitialized.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <memory>
+
+/*
+ * bounded lock-free single-producer / single-consumer ring buffer
+ * 1. exactly one thread may push and exactly one thread may pop at any time
+ * 2. storage is inline, nothing is allocated after construction (place large rings on the heap)
+ * 3. head and tail live on separate cache lines, each side also keeps a cached copy of the other
+ *    side's index so that the shared line is only read when the ring looks full / empty
+ */
+
+namespace nstd {
+
+template<typename Ty, size_t N>
+    requires(N > 1 && (N & (N - 1)) == 0)
+class spsc_ring {
+	static constexpr size_t mask = N - 1;
+
+	// consumer side
+	alignas(cache_line_size) std::atomic<size_t> _Head{ 0 };
+	size_t _CachedTail = 0;
+
+	// producer side
+	alignas(cache_line_size) std::atomic<size_t> _Tail{ 0 };
+	size_t _CachedHead = 0;
+
+	alignas(cache_line_size) internal::inline_storage<Ty, N> _Storage;
+
+	Ty *slot(size_t i) noexcept {
+		return _Storage.ptr() + (i & mask);
+	}
+
+	// free slots as seen by the producer, refreshes the cached head only when needed
+	size_t writable(size_t tail, size_t wanted) noexcept {
+		size_t free = N - (tail - _CachedHead);
+		if (free < wanted) {
+			_CachedHead = _Head.load(std::memory_order_acquire);
+			free = N - (tail - _CachedHead);
+		}
+		return free;
+	}
+
+	size_t readable(size_t head, size_t wanted) noexcept {
+		size_t avail = _CachedTail - head;
+		if (avail < wanted) {
+			_CachedTail = _Tail.load(std::memory_order_acquire);
+			avail = _CachedTail - head;
+		}
+		return avail;
+	}
+
+public:
+	using value_type = Ty;
+
+	spsc_ring() noexcept = default;
+
+	spsc_ring(const spsc_ring &) = delete;
+	spsc_ring &operator=(const spsc_ring &) = delete;
+
+	~spsc_ring() {
+		const size_t tail = _Tail.load(std::memory_order_relaxed);
+		for (size_t i = _Head.load(std::memory_order_relaxed); i != tail; i++) {
+			internal::destroy_n(slot(i), 1);
+		}
+	}
+
+	static constexpr size_t capacity() noexcept {
+		return N;
+	}
+
+	// producer
+	template<typename... Args>
+	bool try_emplace(Args &&...args) {
+		const size_t tail = _Tail.load(std::memory_order_relaxed);
+		if (writable(tail, 1) == 0) {
+			return false;
+		}
+		std::construct_at(slot(tail), nstd::forward<Args>(args)...);
+		_Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push(const Ty &val) {
+		return try_emplace(val);
+	}
+
+	bool try_push(Ty &&val) {
+		return try_emplace(static_cast<Ty &&>(val));
+	}
+
+	// producer, copies up to n elements and publishes them at once, returns how many were pushed
+	size_t push_n(const Ty *src, size_t n) {
+		const size_t tail = _Tail.load(std::memory_order_relaxed);
+		const size_t free = writable(tail, n);
+		const size_t count = n < free ? n : free;
+		const size_t first = N - (tail & mask);  // contiguous slots before wrapping
+		if (count <= first) {
+			internal::uninitialized_copy_n(src, count, slot(tail));
+		} else {
+			internal::uninitialized_copy_n(src, first, slot(tail));
+			internal::uninitialized_copy_n(src + first, count - first, slot(0));
+		}
+		_Tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	// consumer
+	bool try_pop(Ty &out) {
+		const size_t head = _Head.load(std::memory_order_relaxed);
+		if (readable(head, 1) == 0) {
+			return false;
+		}
+		Ty *ptr = slot(head);
+		out = static_cast<Ty &&>(*ptr);
+		internal::destroy_n(ptr, 1);
+		_Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer, moves up to n elements into dst (which holds live objects) and releases their slots at once
+	size_t pop_n(Ty *dst, size_t n) {
+		const size_t head = _Head.load(std::memory_order_relaxed);
+		const size_t avail = readable(head, n);
+		const size_t count = n < avail ? n : avail;
+		for (size_t i = 0; i < count; i++) {
+			Ty *ptr = slot(head + i);
+			dst[i] = static_cast<Ty &&>(*ptr);
+			internal::destroy_n(ptr, 1);
+		}
+		_Head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	// only a snapshot when the other side is active
+	size_t size_approx() const noexcept {
+		const size_t head = _Head.load(std::memory_order_acquire);
+		const size_t tail = _Tail.load(std::memory_order_acquire);
+		return tail - head;
+	}
+
+	bool empty_approx() const noexcept {
+		return size_approx() == 0;
+	}
+};
+
+}  // namespace nstd
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <memory/nstd_uninitialized.h>
+#include <util/nstd_bounds.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+namespace nstd {
+
+namespace internal {
+
+// trivial element types are stored as a plain array, which keeps the container usable during constant evaluation,
+// other types live in raw storage and are constructed on demand
+template<typename Ty, size_t N, bool trivial = std::is_trivially_default_constructible_v<Ty> && std::is_trivially_destructible_v<Ty>>
+struct inline_storage {
+	Ty _Data[N];
+
+	constexpr inline_storage() noexcept {
+		if consteval {  // a constant's value must be fully initialized, at runtime the slack is left untouched
+			for (size_t i = 0; i < N; i++) {
+				std::construct_at(_Data + i);
+			}
+		}
+	}
+
+	constexpr Ty *ptr() noexcept {
+		return _Data;
+	}
+
+	constexpr const Ty *ptr() const noexcept {
+		return _Data;
+	}
+};
+
+template<typename Ty, size_t N>
+struct inline_storage<Ty, N, false> {
+	alignas(Ty) unsigned char _Raw[sizeof(Ty) * N];
+
+	Ty *ptr() noexcept {
+		return reinterpret_cast<Ty *>(_Raw);
+	}
+
+	const Ty *ptr() const noexcept {
+		return reinterpret_cast<const Ty *>(_Raw);
+	}
+};
+
+}  // namespace internal
+
+// fixed-capacity vector that never allocates, exceeding the capacity is a precondition violation
+template<typename Ty, size_t N>
+    requires(N > 0)
+class static_vector {
+	internal::inline_storage<Ty, N> _Storage;
+	size_t _Size = 0;
+
+public:
+	using value_type = Ty;
+	using size_type = size_t;
+	using reference = Ty &;
+	using const_reference = const Ty &;
+	using pointer = Ty *;
+	using const_pointer = const Ty *;
+	using iterator = Ty *;
+	using const_iterator = const Ty *;
+
+	constexpr static_vector() noexcept = default;
+
+	constexpr explicit static_vector(size_t n) {
+		NSTD_BOUNDS_ASSERT(n <= N);
+		internal::uninitialized_value_construct_n(data(), n);
+		_Size = n;
+	}
+
+	constexpr static_vector(size_t n, const Ty &val) {
+		NSTD_BOUNDS_ASSERT(n <= N);
+		internal::uninitialized_fill_n(data(), n, val);
+		_Size = n;
+	}
+
+	constexpr static_vector(std::initializer_list<Ty> init) {
+		NSTD_BOUNDS_ASSERT(init.size() <= N);
+		internal::uninitialized_copy_n(init.begin(), init.size(), data());
+		_Size = init.size();
+	}
+
+	constexpr static_vector(const static_vector &rhs) {
+		internal::uninitialized_copy_n(rhs.data(), rhs._Size, data());
+		_Size = rhs._Size;
+	}
+
+	// leaves rhs empty
+	constexpr static_vector(static_vector &&rhs) noexcept(is_trivially_relocatable_v<Ty> || std::is_nothrow_move_constructible_v<Ty>) {
+		internal::uninitialized_relocate_n(rhs.data(), rhs._Size, data());
+		_Size = rhs._Size;
+		rhs._Size = 0;
+	}
+
+	constexpr static_vector &operator=(const static_vector &rhs) {
+		if (this != &rhs) {
+			clear();
+			internal::uninitialized_copy_n(rhs.data(), rhs._Size, data());
+			_Size = rhs._Size;
+		}
+		return *this;
+	}
+
+	constexpr static_vector &operator=(static_vector &&rhs) noexcept(is_trivially_relocatable_v<Ty> || std::is_nothrow_move_constructible_v<Ty>) {
+		if (this != &rhs) {
+			clear();
+			internal::uninitialized_relocate_n(rhs.data(), rhs._Size, data());
+			_Size = rhs._Size;
+			rhs._Size = 0;
+		}
+		return *this;
+	}
+
+	constexpr ~static_vector() {
+		clear();
+	}
+
+	constexpr Ty *data() noexcept {
+		return _Storage.ptr();
+	}
+
+	constexpr const Ty *data() const noexcept {
+		return _Storage.ptr();
+	}
+
+	constexpr size_t size() const noexcept {
+		return _Size;
+	}
+
+	static constexpr size_t capacity() noexcept {
+		return N;
+	}
+
+	constexpr bool empty() const noexcept {
+		return _Size == 0;
+	}
+
+	constexpr bool full() const noexcept {
+		return _Size == N;
+	}
+
+	constexpr Ty &operator[](size_t i) {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return data()[i];
+	}
+
+	constexpr const Ty &operator[](size_t i) const {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return data()[i];
+	}
+
+	constexpr Ty &at(size_t i) {
+		if (i >= _Size) {
+			throw std::runtime_error("static_vector out of bounds!");
+		}
+		return data()[i];
+	}
+
+	constexpr const Ty &at(size_t i) const {
+		if (i >= _Size) {
+			throw std::runtime_error("static_vector out of bounds!");
+		}
+		return data()[i];
+	}
+
+	constexpr Ty &front() {
+		return (*this)[0];
+	}
+
+	constexpr const Ty &front() const {
+		return (*this)[0];
+	}
+
+	constexpr Ty &back() {
+		return (*this)[_Size - 1];
+	}
+
+	constexpr const Ty &back() const {
+		return (*this)[_Size - 1];
+	}
+
+	constexpr iterator begin() noexcept {
+		return data();
+	}
+
+	constexpr const_iterator begin() const noexcept {
+		return data();
+	}
+
+	constexpr iterator end() noexcept {
+		return data() + _Size;
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return data() + _Size;
+	}
+
+	template<typename... Args>
+	constexpr Ty &emplace_back(Args &&...args) {
+		NSTD_BOUNDS_ASSERT(_Size < N);
+		Ty *res = std::construct_at(data() + _Size, nstd::forward<Args>(args)...);
+		_Size++;
+		return *res;
+	}
+
+	constexpr void push_back(const Ty &val) {
+		emplace_back(val);
+	}
+
+	constexpr void push_back(Ty &&val) {
+		emplace_back(static_cast<Ty &&>(val));
+	}
+
+	// returns false instead of asserting when full
+	template<typename... Args>
+	constexpr bool try_emplace_back(Args &&...args) {
+		if (_Size == N) {
+			return false;
+		}
+		emplace_back(nstd::forward<Args>(args)...);
+		return true;
+	}
+
+	constexpr void pop_back() {
+		NSTD_BOUNDS_ASSERT(_Size > 0);
+		_Size--;
+		internal::destroy_n(data() + _Size, 1);
+	}
+
+	constexpr iterator insert(const_iterator pos, Ty val) {
+		NSTD_BOUNDS_ASSERT(_Size < N);
+		const size_t idx = static_cast<size_t>(pos - data());
+		internal::shift_right_one(data() + idx, _Size - idx);
+		std::construct_at(data() + idx, static_cast<Ty &&>(val));
+		_Size++;
+		return data() + idx;
+	}
+
+	constexpr iterator erase(const_iterator pos) {
+		const size_t idx = static_cast<size_t>(pos - data());
+		NSTD_BOUNDS_ASSERT(idx < _Size);
+		internal::destroy_n(data() + idx, 1);
+		internal::shift_left_one(data() + idx, _Size - idx);
+		_Size--;
+		return data() + idx;
+	}
+
+	constexpr void resize(size_t n) {
+		NSTD_BOUNDS_ASSERT(n <= N);
+		if (n < _Size) {
+			internal::destroy_n(data() + n, _Size - n);
+		} else {
+			internal::uninitialized_value_construct_n(data() + _Size, n - _Size);
+		}
+		_Size = n;
+	}
+
+	constexpr void resize(size_t n, const Ty &val) {
+		NSTD_BOUNDS_ASSERT(n <= N);
+		if (n < _Size) {
+			internal::destroy_n(data() + n, _Size - n);
+		} else {
+			internal::uninitialized_fill_n(data() + _Size, n - _Size, val);
+		}
+		_Size = n;
+	}
+
+	constexpr void clear() noexcept {
+		internal::destroy_n(data(), _Size);
+		_Size = 0;
+	}
+
+	constexpr friend bool operator==(const static_vector &lhs, const static_vector &rhs) {
+		if (lhs._Size != rhs._Size) {
+			return false;
+		}
+		for (size_t i = 0; i < lhs._Size; i++) {
+			if (!(lhs.data()[i] == rhs.data()[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+}  // namespace nstd
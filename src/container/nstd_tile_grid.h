@@ -0,0 +1,131 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <stdexcept>
+
+// shape bookkeeping for arrays split into fixed-size, row-major ordered tiles
+
+namespace nstd {
+
+template<size_t Rank>
+struct tile_info {
+	size_t _Index = 0;
+	size_t _Origin[Rank]{};  // global coordinates of the tile's first element
+	size_t _Extent[Rank]{};  // valid elements along each dimension, smaller than the tile shape at the edges
+};
+
+template<size_t... TileDim>
+    requires(sizeof...(TileDim) > 0 && ((TileDim > 0) && ...))
+class tile_grid {
+public:
+	static constexpr size_t rank = sizeof...(TileDim);
+	static constexpr size_t tile_shape[] = { TileDim... };
+	static constexpr size_t tile_size = (TileDim * ...);
+
+private:
+	size_t _Shape[rank]{};
+	size_t _Grid[rank]{};  // tiles along each dimension
+	size_t _TileCount = 0;
+
+public:
+	constexpr tile_grid() noexcept = default;
+
+	constexpr explicit tile_grid(const size_t (&shape)[rank]) {
+		_TileCount = 1;
+		for (size_t i = 0; i < rank; i++) {
+			if (shape[i] == 0) {
+				throw std::runtime_error("tile_grid empty shape!");
+			}
+			_Shape[i] = shape[i];
+			_Grid[i] = shape[i] / tile_shape[i] + (shape[i] % tile_shape[i] != 0);
+			if (_Grid[i] > static_cast<size_t>(-1) / _TileCount) {
+				throw std::runtime_error("tile_grid too many tiles!");
+			}
+			_TileCount *= _Grid[i];
+		}
+	}
+
+	constexpr size_t extent(size_t dim) const noexcept {
+		return _Shape[dim];
+	}
+
+	constexpr size_t grid_extent(size_t dim) const noexcept {
+		return _Grid[dim];
+	}
+
+	constexpr size_t tile_count() const noexcept {
+		return _TileCount;
+	}
+
+	// number of valid (non-padding) elements
+	constexpr size_t size() const noexcept {
+		size_t res = 1;
+		for (size_t i = 0; i < rank; i++) {
+			res *= _Shape[i];
+		}
+		return res;
+	}
+
+	constexpr tile_info<rank> info(size_t t) const noexcept {
+		tile_info<rank> res;
+		res._Index = t;
+		for (size_t i = rank; i-- > 0;) {
+			const size_t coord = t % _Grid[i];
+			t /= _Grid[i];
+			res._Origin[i] = coord * tile_shape[i];
+			const size_t left = _Shape[i] - res._Origin[i];
+			res._Extent[i] = left < tile_shape[i] ? left : tile_shape[i];
+		}
+		return res;
+	}
+
+	// tile holding the element at idx, and the element's row-major offset within that tile
+	constexpr size_t locate(const size_t (&idx)[rank], size_t &offset) const noexcept {
+		size_t t = 0;
+		offset = 0;
+		for (size_t i = 0; i < rank; i++) {
+			t = t * _Grid[i] + idx[i] / tile_shape[i];
+			offset = offset * tile_shape[i] + idx[i] % tile_shape[i];
+		}
+		return t;
+	}
+
+	constexpr bool contains(const size_t (&idx)[rank]) const noexcept {
+		for (size_t i = 0; i < rank; i++) {
+			if (idx[i] >= _Shape[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// calls fn on every valid element of a row-major tile buffer, in row-major order
+	template<typename Ty, typename Fn>
+	static constexpr void for_each_valid(Ty *data, const size_t (&extent)[rank], Fn &&fn) {
+		size_t idx[rank]{};
+		for (;;) {
+			size_t base = 0;
+			for (size_t i = 0; i + 1 < rank; i++) {
+				base = (base + idx[i]) * tile_shape[i + 1];
+			}
+			for (size_t j = 0; j < extent[rank - 1]; j++) {  // contiguous run
+				fn(data[base + j]);
+			}
+			// odometer over the outer dimensions
+			size_t dim = rank - 1;
+			while (dim-- > 0) {
+				if (++idx[dim] < extent[dim]) {
+					break;
+				}
+				idx[dim] = 0;
+			}
+			if (dim == static_cast<size_t>(-1)) {
+				return;
+			}
+		}
+	}
+};
+
+}  // namespace nstd
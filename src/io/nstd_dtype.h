@@ -0,0 +1,87 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <type_traits>
+
+// element type and layout tags written into file headers
+
+namespace nstd {
+
+enum class dtype : unsigned char {
+	unknown,
+	i8,
+	u8,
+	i16,
+	u16,
+	i32,
+	u32,
+	i64,
+	u64,
+	f32,
+	f64,
+};
+
+enum class layout : unsigned char {
+	row_major,     // last index is contiguous (basic_ndarray's layout)
+	column_major,  // first index is contiguous
+};
+
+namespace internal {
+
+template<typename Ty>
+constexpr dtype dtype_of() noexcept {
+	if constexpr (std::is_floating_point_v<Ty>) {
+		if constexpr (sizeof(Ty) == 4) {
+			return dtype::f32;
+		} else if constexpr (sizeof(Ty) == 8) {
+			return dtype::f64;
+		} else {
+			return dtype::unknown;
+		}
+	} else if constexpr (std::is_integral_v<Ty> && !std::is_same_v<Ty, bool>) {
+		constexpr bool is_signed = std::is_signed_v<Ty>;
+		if constexpr (sizeof(Ty) == 1) {
+			return is_signed ? dtype::i8 : dtype::u8;
+		} else if constexpr (sizeof(Ty) == 2) {
+			return is_signed ? dtype::i16 : dtype::u16;
+		} else if constexpr (sizeof(Ty) == 4) {
+			return is_signed ? dtype::i32 : dtype::u32;
+		} else if constexpr (sizeof(Ty) == 8) {
+			return is_signed ? dtype::i64 : dtype::u64;
+		} else {
+			return dtype::unknown;
+		}
+	} else {
+		return dtype::unknown;
+	}
+}
+
+}  // namespace internal
+
+template<typename Ty>
+constexpr dtype dtype_of_v = internal::dtype_of<std::remove_cv_t<Ty>>();
+
+constexpr size_t dtype_size(dtype type) noexcept {
+	switch (type) {
+		case dtype::i8:
+		case dtype::u8:
+			return 1;
+		case dtype::i16:
+		case dtype::u16:
+			return 2;
+		case dtype::i32:
+		case dtype::u32:
+		case dtype::f32:
+			return 4;
+		case dtype::i64:
+		case dtype::u64:
+		case dtype::f64:
+			return 8;
+		default:
+			return 0;
+	}
+}
+
+}  // namespace nstd
@@ -0,0 +1,455 @@
+#include <io/nstd_file.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <limits.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+namespace nstd {
+
+namespace {
+
+[[noreturn]] void fail(const char *what) {
+#ifdef _WIN32
+	throw std::runtime_error(std::string(what) + " failed! (error " + std::to_string(GetLastError()) + ")");
+#else
+	throw std::runtime_error(std::string(what) + " failed! (" + std::strerror(errno) + ")");
+#endif
+}
+
+#ifdef _WIN32
+HANDLE to_handle(long long h) noexcept {
+	return reinterpret_cast<HANDLE>(static_cast<intptr_t>(h));
+}
+
+OVERLAPPED at_offset(size_t offset) noexcept {
+	OVERLAPPED ov{};
+	ov.Offset = static_cast<DWORD>(offset & 0xffffffffull);
+	ov.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset) >> 32);
+	return ov;
+}
+
+// ReadFile / WriteFile take a DWORD length
+constexpr size_t max_transfer = 1u << 30;
+#else
+int to_fd(long long h) noexcept {
+	return static_cast<int>(h);
+}
+
+// advances the slice list past n transferred bytes
+void consume(iovec *&vec, int &count, size_t n) noexcept {
+	while (count > 0 && n >= vec->iov_len) {
+		n -= vec->iov_len;
+		vec++;
+		count--;
+	}
+	if (count > 0) {
+		vec->iov_base = static_cast<char *>(vec->iov_base) + n;
+		vec->iov_len -= n;
+	}
+}
+#endif
+
+}  // namespace
+
+// file BEGINS
+file::file(const char *path, open_mode mode) {
+#ifdef _WIN32
+	const DWORD access = mode == open_mode::read ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE;
+	const DWORD disposition = mode == open_mode::create ? CREATE_ALWAYS : OPEN_EXISTING;
+	HANDLE h = CreateFileA(path, access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (h == INVALID_HANDLE_VALUE) {
+		fail("CreateFileA");
+	}
+	_Handle = static_cast<long long>(reinterpret_cast<intptr_t>(h));
+#else
+	int flags = O_CLOEXEC;
+	switch (mode) {
+		case open_mode::read:
+			flags |= O_RDONLY;
+			break;
+		case open_mode::read_write:
+			flags |= O_RDWR;
+			break;
+		case open_mode::create:
+			flags |= O_RDWR | O_CREAT | O_TRUNC;
+			break;
+	}
+	const int fd = ::open(path, flags, 0644);
+	if (fd < 0) {
+		fail("open");
+	}
+	_Handle = fd;
+#endif
+}
+
+file::file(file &&rhs) noexcept
+    : _Handle(rhs._Handle) {
+	rhs._Handle = -1;
+}
+
+file &file::operator=(file &&rhs) noexcept {
+	if (this != &rhs) {
+		close();
+		_Handle = rhs._Handle;
+		rhs._Handle = -1;
+	}
+	return *this;
+}
+
+file::~file() {
+	close();
+}
+
+void file::close() noexcept {
+	if (_Handle != -1) {
+#ifdef _WIN32
+		CloseHandle(to_handle(_Handle));
+#else
+		::close(to_fd(_Handle));
+#endif
+		_Handle = -1;
+	}
+}
+
+size_t file::size() const {
+#ifdef _WIN32
+	LARGE_INTEGER res;
+	if (!GetFileSizeEx(to_handle(_Handle), &res)) {
+		fail("GetFileSizeEx");
+	}
+	return static_cast<size_t>(res.QuadPart);
+#else
+	struct stat st;
+	if (::fstat(to_fd(_Handle), &st) != 0) {
+		fail("fstat");
+	}
+	return static_cast<size_t>(st.st_size);
+#endif
+}
+
+void file::resize(size_t size) {
+#ifdef _WIN32
+	FILE_END_OF_FILE_INFO info;
+	info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+	if (!SetFileInformationByHandle(to_handle(_Handle), FileEndOfFileInfo, &info, sizeof(info))) {
+		fail("SetFileInformationByHandle");
+	}
+#else
+	if (::ftruncate(to_fd(_Handle), static_cast<off_t>(size)) != 0) {
+		fail("ftruncate");
+	}
+#endif
+}
+
+void file::read_at(void *dst, size_t n, size_t offset) const {
+	unsigned char *ptr = static_cast<unsigned char *>(dst);
+	while (n > 0) {
+#ifdef _WIN32
+		const DWORD chunk = static_cast<DWORD>(n < max_transfer ? n : max_transfer);
+		OVERLAPPED ov = at_offset(offset);
+		DWORD done = 0;
+		if (!ReadFile(to_handle(_Handle), ptr, chunk, &done, &ov)) {
+			fail("ReadFile");
+		}
+		const size_t got = done;
+#else
+		const ssize_t res = ::pread(to_fd(_Handle), ptr, n, static_cast<off_t>(offset));
+		if (res < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			fail("pread");
+		}
+		const size_t got = static_cast<size_t>(res);
+#endif
+		if (got == 0) {
+			throw std::runtime_error("file read past the end!");
+		}
+		ptr += got;
+		offset += got;
+		n -= got;
+	}
+}
+
+void file::write_at(const void *src, size_t n, size_t offset) {
+	const unsigned char *ptr = static_cast<const unsigned char *>(src);
+	while (n > 0) {
+#ifdef _WIN32
+		const DWORD chunk = static_cast<DWORD>(n < max_transfer ? n : max_transfer);
+		OVERLAPPED ov = at_offset(offset);
+		DWORD done = 0;
+		if (!WriteFile(to_handle(_Handle), ptr, chunk, &done, &ov)) {
+			fail("WriteFile");
+		}
+		if (done == 0) {
+			// no progress and no error, retrying would spin forever
+			SetLastError(ERROR_WRITE_FAULT);
+			fail("WriteFile");
+		}
+		const size_t put = done;
+#else
+		const ssize_t res = ::pwrite(to_fd(_Handle), ptr, n, static_cast<off_t>(offset));
+		if (res < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			fail("pwrite");
+		}
+		if (res == 0) {
+			// no progress and no error, retrying would spin forever
+			errno = EIO;
+			fail("pwrite");
+		}
+		const size_t put = static_cast<size_t>(res);
+#endif
+		ptr += put;
+		offset += put;
+		n -= put;
+	}
+}
+
+void file::write_gather(const io_slice *slices, size_t count, size_t offset) {
+#ifdef _WIN32
+	// no positional gather write on Win32 for buffered handles
+	for (size_t i = 0; i < count; i++) {
+		write_at(slices[i]._Data, slices[i]._Size, offset);
+		offset += slices[i]._Size;
+	}
+#else
+	constexpr size_t batch = IOV_MAX < 1024 ? IOV_MAX : 1024;
+	iovec vecs[batch];
+	while (count > 0) {
+		const size_t n = count < batch ? count : batch;
+		for (size_t i = 0; i < n; i++) {
+			vecs[i] = { slices[i]._Data, slices[i]._Size };
+		}
+		iovec *vec = vecs;
+		int left = static_cast<int>(n);
+		consume(vec, left, 0);  // skips empty slices
+		while (left > 0) {
+			const ssize_t res = ::pwritev(to_fd(_Handle), vec, left, static_cast<off_t>(offset));
+			if (res < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				fail("pwritev");
+			}
+			if (res == 0) {
+				errno = EIO;
+				fail("pwritev");
+			}
+			offset += static_cast<size_t>(res);
+			consume(vec, left, static_cast<size_t>(res));
+		}
+		slices += n;
+		count -= n;
+	}
+#endif
+}
+
+void file::read_scatter(const io_slice *slices, size_t count, size_t offset) const {
+#ifdef _WIN32
+	for (size_t i = 0; i < count; i++) {
+		read_at(slices[i]._Data, slices[i]._Size, offset);
+		offset += slices[i]._Size;
+	}
+#else
+	constexpr size_t batch = IOV_MAX < 1024 ? IOV_MAX : 1024;
+	iovec vecs[batch];
+	while (count > 0) {
+		const size_t n = count < batch ? count : batch;
+		for (size_t i = 0; i < n; i++) {
+			vecs[i] = { slices[i]._Data, slices[i]._Size };
+		}
+		iovec *vec = vecs;
+		int left = static_cast<int>(n);
+		consume(vec, left, 0);
+		while (left > 0) {
+			const ssize_t res = ::preadv(to_fd(_Handle), vec, left, static_cast<off_t>(offset));
+			if (res < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				fail("preadv");
+			}
+			if (res == 0) {
+				throw std::runtime_error("file read past the end!");
+			}
+			offset += static_cast<size_t>(res);
+			consume(vec, left, static_cast<size_t>(res));
+		}
+		slices += n;
+		count -= n;
+	}
+#endif
+}
+
+void file::sync() {
+#ifdef _WIN32
+	if (!FlushFileBuffers(to_handle(_Handle))) {
+		fail("FlushFileBuffers");
+	}
+#else
+	if (::fsync(to_fd(_Handle)) != 0) {
+		fail("fsync");
+	}
+#endif
+}
+// file ENDS
+
+// mapped_region BEGINS
+mapped_region::mapped_region(const file &f, map_mode mode)
+    : _Size(f.size())
+    , _Mode(mode) {
+	if (_Size == 0) {
+		return;
+	}
+#ifdef _WIN32
+	const DWORD protect = mode == map_mode::read_only ? PAGE_READONLY : mode == map_mode::copy_on_write ? PAGE_WRITECOPY : PAGE_READWRITE;
+	const DWORD access = mode == map_mode::read_only ? FILE_MAP_READ : mode == map_mode::copy_on_write ? FILE_MAP_COPY : FILE_MAP_WRITE;
+	HANDLE mapping = CreateFileMappingA(to_handle(f.native_handle()), nullptr, protect, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		fail("CreateFileMappingA");
+	}
+	_Base = MapViewOfFile(mapping, access, 0, 0, _Size);
+	CloseHandle(mapping);  // the view keeps the mapping alive
+	if (_Base == nullptr) {
+		fail("MapViewOfFile");
+	}
+#else
+	const int prot = mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+	const int flags = mode == map_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+	void *base = ::mmap(nullptr, _Size, prot, flags, to_fd(f.native_handle()), 0);
+	if (base == MAP_FAILED) {
+		fail("mmap");
+	}
+	_Base = base;
+#endif
+}
+
+mapped_region::mapped_region(mapped_region &&rhs) noexcept
+    : _Base(rhs._Base)
+    , _Size(rhs._Size)
+    , _Mode(rhs._Mode) {
+	rhs._Base = nullptr;
+	rhs._Size = 0;
+}
+
+mapped_region &mapped_region::operator=(mapped_region &&rhs) noexcept {
+	if (this != &rhs) {
+		unmap();
+		_Base = rhs._Base;
+		_Size = rhs._Size;
+		_Mode = rhs._Mode;
+		rhs._Base = nullptr;
+		rhs._Size = 0;
+	}
+	return *this;
+}
+
+mapped_region::~mapped_region() {
+	unmap();
+}
+
+void mapped_region::unmap() noexcept {
+	if (_Base != nullptr) {
+#ifdef _WIN32
+		UnmapViewOfFile(_Base);
+#else
+		::munmap(_Base, _Size);
+#endif
+		_Base = nullptr;
+		_Size = 0;
+	}
+}
+
+void mapped_region::advise(access_hint hint, size_t offset, size_t length) const noexcept {
+	if (_Base == nullptr || offset >= _Size) {
+		return;
+	}
+	length = length < _Size - offset ? length : _Size - offset;
+	// the range has to start on a page boundary
+	const size_t page = page_size();
+	const size_t begin = offset / page * page;
+	length += offset - begin;
+#ifdef _WIN32
+	if (hint == access_hint::will_need) {
+		WIN32_MEMORY_RANGE_ENTRY range;
+		range.VirtualAddress = data() + begin;
+		range.NumberOfBytes = length;
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#else
+	int advice = MADV_NORMAL;
+	switch (hint) {
+		case access_hint::normal:
+			advice = MADV_NORMAL;
+			break;
+		case access_hint::sequential:
+			advice = MADV_SEQUENTIAL;
+			break;
+		case access_hint::random:
+			advice = MADV_RANDOM;
+			break;
+		case access_hint::will_need:
+			advice = MADV_WILLNEED;
+			break;
+		case access_hint::dont_need:
+			// MADV_DONTNEED would discard private (copy-on-write) modifications
+			if (_Mode == map_mode::copy_on_write) {
+				return;
+			}
+			advice = MADV_DONTNEED;
+			break;
+	}
+	::madvise(data() + begin, length, advice);
+#endif
+}
+
+void mapped_region::flush() const {
+	if (_Base == nullptr || _Mode != map_mode::read_write) {
+		return;
+	}
+#ifdef _WIN32
+	if (!FlushViewOfFile(_Base, _Size)) {
+		fail("FlushViewOfFile");
+	}
+#else
+	if (::msync(_Base, _Size, MS_SYNC) != 0) {
+		fail("msync");
+	}
+#endif
+}
+
+size_t mapped_region::page_size() noexcept {
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwAllocationGranularity;
+#else
+	return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+}
+// mapped_region ENDS
+
+}  // namespace nstd
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+/*
+ * thin RAII wrappers over the OS file and memory-mapping APIs (POSIX and Win32)
+ * 1. every failure throws std::runtime_error
+ * 2. positional reads / writes never move a shared file cursor, so several threads may use one file
+ */
+
+namespace nstd {
+
+enum class open_mode {
+	read,        // existing file, read-only
+	read_write,  // existing file
+	create,      // created or truncated, read-write
+};
+
+// one contiguous piece of a gathered write / scattered read
+struct io_slice {
+	void *_Data;
+	size_t _Size;
+};
+
+class file {
+	long long _Handle = -1;  // fd on POSIX, HANDLE on Win32
+
+public:
+	file() noexcept = default;
+	file(const char *path, open_mode mode);
+
+	file(const file &) = delete;
+	file &operator=(const file &) = delete;
+
+	file(file &&rhs) noexcept;
+	file &operator=(file &&rhs) noexcept;
+
+	~file();
+
+	bool is_open() const noexcept {
+		return _Handle != -1;
+	}
+
+	long long native_handle() const noexcept {
+		return _Handle;
+	}
+
+	void close() noexcept;
+
+	size_t size() const;
+	void resize(size_t size);
+
+	// reads / writes exactly n bytes at offset, short transfers are retried
+	void read_at(void *dst, size_t n, size_t offset) const;
+	void write_at(const void *src, size_t n, size_t offset);
+
+	// pwritev / preadv where available: one system call for many buffers
+	void write_gather(const io_slice *slices, size_t count, size_t offset);
+	void read_scatter(const io_slice *slices, size_t count, size_t offset) const;
+
+	// flushes written data to the device
+	void sync();
+};
+
+enum class map_mode {
+	read_only,
+	copy_on_write,  // writes stay private to the mapping and never reach the file
+	read_write,     // writes reach the file
+};
+
+enum class access_hint {
+	normal,
+	sequential,  // aggressive read-ahead, pages behind may be dropped early
+	random,      // no read-ahead
+	will_need,   // start reading the range in now
+	dont_need,   // the range may be dropped from the page cache
+};
+
+// maps a whole file, an empty file gives an empty region
+class mapped_region {
+	void *_Base = nullptr;
+	size_t _Size = 0;
+	map_mode _Mode = map_mode::read_only;
+
+public:
+	mapped_region() noexcept = default;
+	mapped_region(const file &f, map_mode mode);
+
+	mapped_region(const mapped_region &) = delete;
+	mapped_region &operator=(const mapped_region &) = delete;
+
+	mapped_region(mapped_region &&rhs) noexcept;
+	mapped_region &operator=(mapped_region &&rhs) noexcept;
+
+	~mapped_region();
+
+	unsigned char *data() const noexcept {
+		return static_cast<unsigned char *>(_Base);
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	map_mode mode() const noexcept {
+		return _Mode;
+	}
+
+	void unmap() noexcept;
+
+	// a hint only, silently ignored where the OS has no equivalent
+	void advise(access_hint hint, size_t offset, size_t length) const noexcept;
+
+	void advise(access_hint hint) const noexcept {
+		advise(hint, 0, _Size);
+	}
+
+	// writes dirty pages of a read_write mapping back to the file
+	void flush() const;
+
+	static size_t page_size() noexcept;
+};
+
+}  // namespace nstd
@@ -0,0 +1,206 @@
+#include <io/nstd_serialize.h>
+
+// TODO: REMOVE these deps in future versions
+#include <bit>
+#include <cstring>
+
+namespace nstd {
+
+namespace internal {
+
+namespace {
+
+constexpr unsigned char npy_magic[6] = { 0x93, 'N', 'U', 'M', 'P', 'Y' };
+constexpr size_t npy_alignment = 64;
+
+constexpr char native_order = std::endian::native == std::endian::little ? '<' : '>';
+
+std::string npy_descr(dtype type) {
+	const char *kind = nullptr;
+	switch (type) {
+		case dtype::i8:
+			return "|i1";
+		case dtype::u8:
+			return "|u1";
+		case dtype::i16:
+			kind = "i2";
+			break;
+		case dtype::u16:
+			kind = "u2";
+			break;
+		case dtype::i32:
+			kind = "i4";
+			break;
+		case dtype::u32:
+			kind = "u4";
+			break;
+		case dtype::i64:
+			kind = "i8";
+			break;
+		case dtype::u64:
+			kind = "u8";
+			break;
+		case dtype::f32:
+			kind = "f4";
+			break;
+		case dtype::f64:
+			kind = "f8";
+			break;
+		default:
+			throw std::runtime_error("npy unsupported dtype!");
+	}
+	return std::string(1, native_order) + kind;
+}
+
+dtype parse_descr(const std::string &descr) {
+	if (descr.size() != 3) {
+		return dtype::unknown;
+	}
+	const char order = descr[0];
+	const std::string kind = descr.substr(1);
+	if (kind == "i1") {
+		return dtype::i8;
+	}
+	if (kind == "u1") {
+		return dtype::u8;
+	}
+	// multi-byte types must be in host order, '=' and '|' mean native
+	if (order != native_order && order != '=' && order != '|') {
+		throw std::runtime_error("npy byte order not supported!");
+	}
+	static constexpr struct {
+		const char *_Kind;
+		dtype _Dtype;
+	} table[] = {
+		{ "i2", dtype::i16 },
+		{ "u2", dtype::u16 },
+		{ "i4", dtype::i32 },
+		{ "u4", dtype::u32 },
+		{ "i8", dtype::i64 },
+		{ "u8", dtype::u64 },
+		{ "f4", dtype::f32 },
+		{ "f8", dtype::f64 },
+	};
+	for (const auto &entry : table) {
+		if (kind == entry._Kind) {
+			return entry._Dtype;
+		}
+	}
+	return dtype::unknown;
+}
+
+// value text following 'key': in the header dict
+size_t find_value(const std::string &dict, const char *key) {
+	const size_t pos = dict.find(std::string("'") + key + "'");
+	if (pos == std::string::npos) {
+		throw std::runtime_error("npy header is missing a key!");
+	}
+	size_t res = dict.find(':', pos);
+	if (res == std::string::npos) {
+		throw std::runtime_error("npy header is malformed!");
+	}
+	res++;
+	while (res < dict.size() && dict[res] == ' ') {
+		res++;
+	}
+	return res;
+}
+
+}  // namespace
+
+std::string npy_header(dtype type, bool fortran_order, const size_t *shape, size_t rank) {
+	std::string dict = "{'descr': '" + npy_descr(type) + "', 'fortran_order': " + (fortran_order ? "True" : "False") + ", 'shape': (";
+	for (size_t i = 0; i < rank; i++) {
+		dict += std::to_string(shape[i]);
+		if (rank == 1 || i + 1 < rank) {
+			dict += ",";
+		}
+		if (i + 1 < rank) {
+			dict += " ";
+		}
+	}
+	dict += "), }";
+
+	// magic (6) + version (2) + length (2) + dict + padding + '\n'
+	const size_t unpadded = 10 + dict.size() + 1;
+	const size_t total = (unpadded + npy_alignment - 1) / npy_alignment * npy_alignment;
+	dict.append(total - unpadded, ' ');
+	dict += '\n';
+	if (dict.size() > 0xffff) {
+		throw std::runtime_error("npy header too long!");
+	}
+
+	std::string res(reinterpret_cast<const char *>(npy_magic), sizeof(npy_magic));
+	res += static_cast<char>(1);  // version 1.0
+	res += static_cast<char>(0);
+	res += static_cast<char>(dict.size() & 0xff);  // little-endian length
+	res += static_cast<char>(dict.size() >> 8);
+	res += dict;
+	return res;
+}
+
+npy_info read_npy_header(const file &f, size_t offset) {
+	unsigned char prefix[12];
+	f.read_at(prefix, 10, offset);
+	if (std::memcmp(prefix, npy_magic, sizeof(npy_magic)) != 0) {
+		throw std::runtime_error("npy bad magic!");
+	}
+	const unsigned char major = prefix[6];
+	size_t dict_len = 0;
+	size_t prefix_len = 10;
+	if (major == 1) {
+		dict_len = prefix[8] | static_cast<size_t>(prefix[9]) << 8;
+	} else if (major == 2 || major == 3) {
+		f.read_at(prefix + 10, 2, offset + 10);
+		dict_len = prefix[8] | static_cast<size_t>(prefix[9]) << 8 | static_cast<size_t>(prefix[10]) << 16 | static_cast<size_t>(prefix[11]) << 24;
+		prefix_len = 12;
+	} else {
+		throw std::runtime_error("npy unsupported version!");
+	}
+
+	std::string dict(dict_len, '\0');
+	f.read_at(dict.data(), dict_len, offset + prefix_len);
+
+	npy_info res;
+	res._HeaderSize = prefix_len + dict_len;
+
+	size_t pos = find_value(dict, "descr");
+	if (pos >= dict.size() || dict[pos] != '\'') {
+		throw std::runtime_error("npy header is malformed!");
+	}
+	const size_t descr_end = dict.find('\'', pos + 1);
+	if (descr_end == std::string::npos) {
+		throw std::runtime_error("npy header is malformed!");
+	}
+	res._Dtype = parse_descr(dict.substr(pos + 1, descr_end - pos - 1));
+	if (res._Dtype == dtype::unknown) {
+		throw std::runtime_error("npy unsupported dtype!");
+	}
+
+	pos = find_value(dict, "fortran_order");
+	res._FortranOrder = dict.compare(pos, 4, "True") == 0;
+
+	pos = find_value(dict, "shape");
+	if (pos >= dict.size() || dict[pos] != '(') {
+		throw std::runtime_error("npy header is malformed!");
+	}
+	for (pos++; pos < dict.size() && dict[pos] != ')';) {
+		if (dict[pos] >= '0' && dict[pos] <= '9') {
+			if (res._Rank == npy_info::max_rank) {
+				throw std::runtime_error("npy rank out of bounds!");
+			}
+			size_t dim = 0;
+			for (; pos < dict.size() && dict[pos] >= '0' && dict[pos] <= '9'; pos++) {
+				dim = dim * 10 + static_cast<size_t>(dict[pos] - '0');
+			}
+			res._Shape[res._Rank++] = dim;
+		} else {
+			pos++;  // separators, 'L' suffixes of old headers
+		}
+	}
+	return res;
+}
+
+}  // namespace internal
+
+}  // namespace nstd
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <io/nstd_dtype.h>
+#include <io/nstd_file.h>
+#include <math/linalg/nstd_matrix.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * binary serialization straight from / into the objects' own storage, no staging buffers
+ * 1. basic_ndarray is written as an NPY (v1.0) record, readable with numpy.load;
+ *    records can be concatenated in one stream
+ * 2. matrices are written as a raw blob: a 64-byte blob_header followed by the elements,
+ *    the elements start on a 64-byte boundary of the file
+ * 3. an array of matrices is one blob, written with a single gather write
+ */
+
+namespace nstd {
+
+struct blob_header {
+	static constexpr char magic[8] = { 'N', 'S', 'T', 'D', 'B', 'L', 'O', 'B' };
+	static constexpr size_t alignment = 64;
+
+	char _Magic[8];
+	dtype _Dtype;
+	unsigned char _Reserved[3];
+	unsigned int _Rows;
+	unsigned int _Cols;
+	unsigned int _Padding;
+	unsigned long long _Count;
+	unsigned char _Tail[32];
+};
+
+static_assert(sizeof(blob_header) == blob_header::alignment);
+
+namespace internal {
+
+struct npy_info {
+	static constexpr size_t max_rank = 32;
+
+	dtype _Dtype = dtype::unknown;
+	bool _FortranOrder = false;
+	size_t _Rank = 0;
+	size_t _Shape[max_rank]{};
+	size_t _HeaderSize = 0;  // magic, lengths and dict, i.e. the offset of the data from the record start
+};
+
+// complete NPY v1.0 preamble, padded so that the data starts on a 64-byte boundary
+std::string npy_header(dtype type, bool fortran_order, const size_t *shape, size_t rank);
+
+// parses the preamble of an NPY record (v1.0 - v3.0) at offset, throws on malformed or unsupported headers
+npy_info read_npy_header(const file &f, size_t offset);
+
+}  // namespace internal
+
+// writes records back to back from a starting offset
+class binary_writer {
+	file *_File;
+	size_t _Offset;
+
+public:
+	explicit binary_writer(file &f, size_t offset = 0) noexcept
+	    : _File(&f)
+	    , _Offset(offset) {}
+
+	size_t offset() const noexcept {
+		return _Offset;
+	}
+
+	void write_bytes(const void *src, size_t n) {
+		_File->write_at(src, n, _Offset);
+		_Offset += n;
+	}
+
+	void write_gather(const io_slice *slices, size_t count) {
+		_File->write_gather(slices, count, _Offset);
+		for (size_t i = 0; i < count; i++) {
+			_Offset += slices[i]._Size;
+		}
+	}
+
+	// zero bytes up to the next multiple of alignment (a power of two)
+	void pad_to(size_t alignment) {
+		static constexpr unsigned char zeros[blob_header::alignment]{};
+		size_t n = (alignment - (_Offset & (alignment - 1))) & (alignment - 1);
+		while (n > 0) {
+			const size_t chunk = n < sizeof(zeros) ? n : sizeof(zeros);
+			write_bytes(zeros, chunk);
+			n -= chunk;
+		}
+	}
+
+	template<typename Ty, bool exception, size_t... DimSize>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void write_npy(const basic_ndarray<Ty, exception, DimSize...> &arr) {
+		using array_type = basic_ndarray<Ty, exception, DimSize...>;
+		const std::string header = internal::npy_header(dtype_of_v<Ty>, false, array_type::shape, array_type::rank);
+		const io_slice slices[2] = {
+			{ const_cast<char *>(header.data()), header.size() },
+			{ const_cast<Ty *>(arr.data()), array_type::arr_size * sizeof(Ty) },
+		};
+		write_gather(slices, 2);
+	}
+
+	template<typename Ty, size_t M, size_t N, bool simd>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void write(const linalg::matrix<Ty, M, N, simd> &mat) {
+		write(&mat, 1);
+	}
+
+	// one blob for count matrices, adjacent matrices are coalesced into a single slice
+	template<typename Ty, size_t M, size_t N, bool simd>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void write(const linalg::matrix<Ty, M, N, simd> *mats, size_t count) {
+		constexpr size_t mat_bytes = M * N * sizeof(Ty);
+		pad_to(blob_header::alignment);
+
+		blob_header header{};
+		for (size_t i = 0; i < sizeof(blob_header::magic); i++) {
+			header._Magic[i] = blob_header::magic[i];
+		}
+		header._Dtype = dtype_of_v<Ty>;
+		header._Rows = static_cast<unsigned int>(M);
+		header._Cols = static_cast<unsigned int>(N);
+		header._Count = count;
+
+		std::vector<io_slice> slices;
+		slices.reserve(count + 1);
+		slices.push_back({ &header, sizeof(blob_header) });
+		for (size_t i = 0; i < count; i++) {
+			unsigned char *ptr = reinterpret_cast<unsigned char *>(const_cast<Ty *>(mats[i].data()));
+			io_slice &last = slices.back();
+			if (i > 0 && static_cast<unsigned char *>(last._Data) + last._Size == ptr) {
+				last._Size += mat_bytes;
+			} else {
+				slices.push_back({ ptr, mat_bytes });
+			}
+		}
+		write_gather(slices.data(), slices.size());
+	}
+};
+
+// reads records back to back from a starting offset
+class binary_reader {
+	const file *_File;
+	size_t _Offset;
+
+	template<typename Ty, size_t M, size_t N>
+	void read_blob_header(size_t count) {
+		skip_to(blob_header::alignment);
+		blob_header header;
+		read_bytes(&header, sizeof(blob_header));
+		for (size_t i = 0; i < sizeof(blob_header::magic); i++) {
+			if (header._Magic[i] != blob_header::magic[i]) {
+				throw std::runtime_error("blob bad magic!");
+			}
+		}
+		if (header._Dtype != dtype_of_v<Ty>) {
+			throw std::runtime_error("blob dtype mismatch!");
+		}
+		if (header._Rows != M || header._Cols != N) {
+			throw std::runtime_error("blob shape mismatch!");
+		}
+		if (header._Count != count) {
+			throw std::runtime_error("blob count mismatch!");
+		}
+	}
+
+public:
+	explicit binary_reader(const file &f, size_t offset = 0) noexcept
+	    : _File(&f)
+	    , _Offset(offset) {}
+
+	size_t offset() const noexcept {
+		return _Offset;
+	}
+
+	void read_bytes(void *dst, size_t n) {
+		_File->read_at(dst, n, _Offset);
+		_Offset += n;
+	}
+
+	void read_scatter(const io_slice *slices, size_t count) {
+		_File->read_scatter(slices, count, _Offset);
+		for (size_t i = 0; i < count; i++) {
+			_Offset += slices[i]._Size;
+		}
+	}
+
+	void skip_to(size_t alignment) noexcept {
+		_Offset = (_Offset + alignment - 1) & ~(alignment - 1);
+	}
+
+	// the record's dtype and shape must match the array's exactly, fortran-ordered records are rejected
+	template<typename Ty, bool exception, size_t... DimSize>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void read_npy(basic_ndarray<Ty, exception, DimSize...> &arr) {
+		using array_type = basic_ndarray<Ty, exception, DimSize...>;
+		const internal::npy_info info = internal::read_npy_header(*_File, _Offset);
+		if (info._Dtype != dtype_of_v<Ty>) {
+			throw std::runtime_error("npy dtype mismatch!");
+		}
+		if (info._Rank != array_type::rank) {
+			throw std::runtime_error("npy rank mismatch!");
+		}
+		for (size_t i = 0; i < array_type::rank; i++) {
+			if (info._Shape[i] != array_type::shape[i]) {
+				throw std::runtime_error("npy shape mismatch!");
+			}
+		}
+		if (info._FortranOrder && array_type::rank > 1) {
+			throw std::runtime_error("npy fortran order is not supported!");
+		}
+		_Offset += info._HeaderSize;
+		read_bytes(arr.data(), array_type::arr_size * sizeof(Ty));
+	}
+
+	template<typename Ty, size_t M, size_t N, bool simd>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void read(linalg::matrix<Ty, M, N, simd> &mat) {
+		read(&mat, 1);
+	}
+
+	// counterpart of binary_writer::write(mats, count), scattered straight into the matrices
+	template<typename Ty, size_t M, size_t N, bool simd>
+	    requires(dtype_of_v<Ty> != dtype::unknown)
+	void read(linalg::matrix<Ty, M, N, simd> *mats, size_t count) {
+		constexpr size_t mat_bytes = M * N * sizeof(Ty);
+		read_blob_header<Ty, M, N>(count);
+
+		std::vector<io_slice> slices;
+		slices.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			unsigned char *ptr = reinterpret_cast<unsigned char *>(mats[i].data());
+			if (!slices.empty() && static_cast<unsigned char *>(slices.back()._Data) + slices.back()._Size == ptr) {
+				slices.back()._Size += mat_bytes;
+			} else {
+				slices.push_back({ ptr, mat_bytes });
+			}
+		}
+		read_scatter(slices.data(), slices.size());
+	}
+};
+
+// whole-file helpers
+template<typename Ty, bool exception, size_t... DimSize>
+void save_npy(const char *path, const basic_ndarray<Ty, exception, DimSize...> &arr) {
+	file f(path, open_mode::create);
+	binary_writer(f).write_npy(arr);
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+void load_npy(const char *path, basic_ndarray<Ty, exception, DimSize...> &arr) {
+	const file f(path, open_mode::read);
+	binary_reader(f).read_npy(arr);
+}
+
+}  // namespace nstd
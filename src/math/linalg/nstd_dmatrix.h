@@ -0,0 +1,540 @@
+#pragma once
+
+#include <math/linalg/nstd_gemm.h>
+#include <math/linalg/nstd_matrix.h>
+#include <math/nstd_dispatch.h>
+#include <math/nstd_math.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_bounds.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * ! assumptions !
+ * 1. dimensions are known only at runtime, storage is a cache-line aligned heap block
+ * 2. vectors are all column vectors (i.e. Nx1)
+ * 3. use row-major ordering storage layout, rows are packed (stride == cols)
+ * 4. like the fixed-size matrix, dmatrix(rows, cols) leaves the elements uninitialized
+ * 5. operands of mismatched dimensions throw, products go through the run-time dispatched gemm (math/nstd_dispatch.h) / gemv
+ */
+
+namespace nstd {
+
+namespace linalg {
+
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+class dvector;
+
+namespace internal {
+
+// dst[i] = op(lhs[i], rhs[i]) on raw pointers, so the loop vectorizes even with assertions enabled
+template<typename Ty, typename Op>
+void elementwise(size_t n, const Ty *lhs, const Ty *rhs, Ty *dst, Op op) noexcept {
+	for (size_t i = 0; i < n; i++) {
+		dst[i] = op(lhs[i], rhs[i]);
+	}
+}
+
+template<typename Ty>
+void scaled_copy(size_t n, const Ty *src, Ty scalar, Ty *dst) noexcept {
+	for (size_t i = 0; i < n; i++) {
+		dst[i] = src[i] * scalar;
+	}
+}
+
+}  // namespace internal
+
+// dmatrix BEGINS
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+class dmatrix {
+	aligned_buffer<Ty> _Data;
+	size_t _Rows = 0;
+	size_t _Cols = 0;
+
+	void check_same_shape(const dmatrix &rhs) const {
+		if (_Rows != rhs._Rows || _Cols != rhs._Cols) {
+			throw std::runtime_error("dmatrix dimension mismatch!");
+		}
+	}
+
+public:
+	using value_type = Ty;
+
+	dmatrix() = default;
+
+	dmatrix(size_t rows, size_t cols)
+	    : _Data(rows * cols), _Rows(rows), _Cols(cols) {}
+
+	dmatrix(size_t rows, size_t cols, Ty val)
+	    : _Data(rows * cols, val), _Rows(rows), _Cols(cols) {}
+
+	// should be given in row-major order
+	dmatrix(size_t rows, size_t cols, std::initializer_list<Ty> init)
+	    : dmatrix(rows, cols) {
+		if (init.size() != rows * cols) {
+			throw std::runtime_error("dmatrix dimension mismatch!");
+		}
+		size_t i = 0;
+		for (const Ty &val : init) {
+			_Data[i++] = val;
+		}
+	}
+
+	template<size_t M, size_t N, bool simd>
+	explicit dmatrix(const matrix<Ty, M, N, simd> &mat)
+	    : dmatrix(M, N) {
+		for (size_t i = 0; i < M * N; i++) {
+			_Data[i] = mat.data()[i];
+		}
+	}
+
+	size_t rows() const noexcept {
+		return _Rows;
+	}
+
+	size_t cols() const noexcept {
+		return _Cols;
+	}
+
+	size_t size() const noexcept {
+		return _Rows * _Cols;
+	}
+
+	Ty *data() noexcept {
+		return _Data.data();
+	}
+
+	const Ty *data() const noexcept {
+		return _Data.data();
+	}
+
+	// row i, so that mat[i][j] reads like the fixed-size matrix
+	Ty *operator[](size_t i) noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Rows);
+		return _Data.data() + i * _Cols;
+	}
+
+	const Ty *operator[](size_t i) const noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Rows);
+		return _Data.data() + i * _Cols;
+	}
+
+	Ty &at(size_t i, size_t j) {
+		if (i >= _Rows || j >= _Cols) {
+			nstd::internal::bounds_failure("dmatrix out of bounds!");
+		}
+		return _Data[i * _Cols + j];
+	}
+
+	const Ty &at(size_t i, size_t j) const {
+		if (i >= _Rows || j >= _Cols) {
+			nstd::internal::bounds_failure("dmatrix out of bounds!");
+		}
+		return _Data[i * _Cols + j];
+	}
+
+	template<size_t M, size_t N, bool simd = false>
+	matrix<Ty, M, N, simd> to_fixed() const {
+		if (_Rows != M || _Cols != N) {
+			throw std::runtime_error("dmatrix dimension mismatch!");
+		}
+		matrix<Ty, M, N, simd> res;
+		for (size_t i = 0; i < M * N; i++) {
+			res.data()[i] = _Data[i];
+		}
+		return res;
+	}
+
+	bool operator==(const dmatrix &rhs) const {
+		if (_Rows != rhs._Rows || _Cols != rhs._Cols) {
+			return false;
+		}
+		const Ty *lhs_data = data(), *rhs_data = rhs.data();
+		for (size_t i = 0; i < size(); i++) {
+			if (lhs_data[i] != rhs_data[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	dmatrix &operator+=(const dmatrix &rhs) {
+		check_same_shape(rhs);
+		axpy(size(), Ty(1), rhs.data(), data());
+		return *this;
+	}
+
+	dmatrix &operator-=(const dmatrix &rhs) {
+		check_same_shape(rhs);
+		axpy(size(), Ty(-1), rhs.data(), data());
+		return *this;
+	}
+
+	dmatrix &operator*=(Ty scalar) noexcept {
+		scal(size(), scalar, _Data.data());
+		return *this;
+	}
+
+	dmatrix operator+(const dmatrix &rhs) const {
+		check_same_shape(rhs);
+		dmatrix res(_Rows, _Cols);
+		internal::elementwise(size(), data(), rhs.data(), res.data(), [](Ty lhs, Ty rhs) { return lhs + rhs; });
+		return res;
+	}
+
+	dmatrix operator-(const dmatrix &rhs) const {
+		check_same_shape(rhs);
+		dmatrix res(_Rows, _Cols);
+		internal::elementwise(size(), data(), rhs.data(), res.data(), [](Ty lhs, Ty rhs) { return lhs - rhs; });
+		return res;
+	}
+
+	dmatrix operator*(const dmatrix &rhs) const {
+		if (_Cols != rhs._Rows) {
+			throw std::runtime_error("dmatrix dimension mismatch!");
+		}
+		dmatrix res(_Rows, rhs._Cols);
+		dispatch::gemm(_Rows, rhs._Cols, _Cols, Ty(1), data(), _Cols, rhs.data(), rhs._Cols, Ty(0), res.data(), rhs._Cols);
+		return res;
+	}
+
+	dvector<Ty> operator*(const dvector<Ty> &rhs) const;
+
+	dmatrix operator*(Ty scalar) const {
+		dmatrix res(_Rows, _Cols);
+		internal::scaled_copy(size(), data(), scalar, res.data());
+		return res;
+	}
+
+	friend dmatrix operator*(Ty scalar, const dmatrix &rhs) {
+		return rhs * scalar;
+	}
+
+	// cache-blocked so that both the reads and the writes walk whole lines
+	dmatrix transpose() const {
+		constexpr size_t block = 32;
+		dmatrix res(_Cols, _Rows);
+		const Ty *src = data();
+		Ty *dst = res.data();
+		for (size_t i0 = 0; i0 < _Rows; i0 += block) {
+			const size_t i1 = i0 + block < _Rows ? i0 + block : _Rows;
+			for (size_t j0 = 0; j0 < _Cols; j0 += block) {
+				const size_t j1 = j0 + block < _Cols ? j0 + block : _Cols;
+				for (size_t i = i0; i < i1; i++) {
+					for (size_t j = j0; j < j1; j++) {
+						dst[j * _Rows + i] = src[i * _Cols + j];
+					}
+				}
+			}
+		}
+		return res;
+	}
+
+	static dmatrix zeros(size_t rows, size_t cols) {
+		return dmatrix(rows, cols, Ty(0));
+	}
+
+	static dmatrix ones(size_t rows, size_t cols) {
+		return dmatrix(rows, cols, Ty(1));
+	}
+
+	static dmatrix identity(size_t n) {
+		dmatrix res(n, n, Ty(0));
+		for (size_t i = 0; i < n; i++) {
+			res._Data[i * n + i] = Ty(1);
+		}
+		return res;
+	}
+};
+// dmatrix ENDS
+
+// dvector BEGINS
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+class dvector {
+	aligned_buffer<Ty> _Data;
+
+	void check_same_size(const dvector &rhs) const {
+		if (size() != rhs.size()) {
+			throw std::runtime_error("dvector dimension mismatch!");
+		}
+	}
+
+public:
+	using value_type = Ty;
+
+	dvector() = default;
+
+	explicit dvector(size_t n)
+	    : _Data(n) {}
+
+	dvector(size_t n, Ty val)
+	    : _Data(n, val) {}
+
+	dvector(std::initializer_list<Ty> init)
+	    : _Data(init.size()) {
+		size_t i = 0;
+		for (const Ty &val : init) {
+			_Data[i++] = val;
+		}
+	}
+
+	template<size_t M, bool simd>
+	explicit dvector(const matrix<Ty, M, 1, simd> &vec)
+	    : _Data(M) {
+		for (size_t i = 0; i < M; i++) {
+			_Data[i] = vec.data()[i];
+		}
+	}
+
+	size_t size() const noexcept {
+		return _Data.size();
+	}
+
+	Ty *data() noexcept {
+		return _Data.data();
+	}
+
+	const Ty *data() const noexcept {
+		return _Data.data();
+	}
+
+	Ty &operator[](size_t i) noexcept {
+		NSTD_BOUNDS_ASSERT(i < size());
+		return _Data[i];
+	}
+
+	const Ty &operator[](size_t i) const noexcept {
+		NSTD_BOUNDS_ASSERT(i < size());
+		return _Data[i];
+	}
+
+	Ty &at(size_t i) {
+		if (i >= size()) {
+			nstd::internal::bounds_failure("dvector out of bounds!");
+		}
+		return _Data[i];
+	}
+
+	const Ty &at(size_t i) const {
+		if (i >= size()) {
+			nstd::internal::bounds_failure("dvector out of bounds!");
+		}
+		return _Data[i];
+	}
+
+	Ty *begin() noexcept {
+		return _Data.begin();
+	}
+
+	const Ty *begin() const noexcept {
+		return _Data.begin();
+	}
+
+	Ty *end() noexcept {
+		return _Data.end();
+	}
+
+	const Ty *end() const noexcept {
+		return _Data.end();
+	}
+
+	template<size_t M, bool simd = false>
+	matrix<Ty, M, 1, simd> to_fixed() const {
+		if (size() != M) {
+			throw std::runtime_error("dvector dimension mismatch!");
+		}
+		matrix<Ty, M, 1, simd> res;
+		for (size_t i = 0; i < M; i++) {
+			res.data()[i] = _Data[i];
+		}
+		return res;
+	}
+
+	bool operator==(const dvector &rhs) const {
+		if (size() != rhs.size()) {
+			return false;
+		}
+		const Ty *lhs_data = data(), *rhs_data = rhs.data();
+		for (size_t i = 0; i < size(); i++) {
+			if (lhs_data[i] != rhs_data[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	dvector &operator+=(const dvector &rhs) {
+		check_same_size(rhs);
+		axpy(size(), Ty(1), rhs.data(), data());
+		return *this;
+	}
+
+	dvector &operator-=(const dvector &rhs) {
+		check_same_size(rhs);
+		axpy(size(), Ty(-1), rhs.data(), data());
+		return *this;
+	}
+
+	dvector &operator*=(Ty scalar) noexcept {
+		scal(size(), scalar, data());
+		return *this;
+	}
+
+	dvector operator+(const dvector &rhs) const {
+		check_same_size(rhs);
+		dvector res(size());
+		internal::elementwise(size(), data(), rhs.data(), res.data(), [](Ty lhs, Ty rhs) { return lhs + rhs; });
+		return res;
+	}
+
+	dvector operator-(const dvector &rhs) const {
+		check_same_size(rhs);
+		dvector res(size());
+		internal::elementwise(size(), data(), rhs.data(), res.data(), [](Ty lhs, Ty rhs) { return lhs - rhs; });
+		return res;
+	}
+
+	dvector operator*(Ty scalar) const {
+		dvector res(size());
+		internal::scaled_copy(size(), data(), scalar, res.data());
+		return res;
+	}
+
+	friend dvector operator*(Ty scalar, const dvector &rhs) {
+		return rhs * scalar;
+	}
+
+	Ty dot(const dvector &rhs) const {
+		check_same_size(rhs);
+		return dispatch::dot(size(), data(), rhs.data());
+	}
+
+	Ty norm_squared() const noexcept {
+		return dispatch::dot(size(), data(), data());
+	}
+
+	Ty norm() const noexcept {
+		return static_cast<Ty>(std::sqrt(norm_squared()));
+	}
+
+	void normalize() noexcept {
+		Ty length = norm();
+		if (!is_approx(length, static_cast<Ty>(0), static_cast<Ty>(1e-5f))) {
+			Ty *ptr = data();
+			for (size_t i = 0; i < size(); i++) {
+				ptr[i] /= length;
+			}
+		}
+	}
+
+	dvector normalized() const {
+		dvector res(*this);
+		res.normalize();
+		return res;
+	}
+
+	static dvector zeros(size_t n) {
+		return dvector(n, Ty(0));
+	}
+
+	static dvector ones(size_t n) {
+		return dvector(n, Ty(1));
+	}
+};
+// dvector ENDS
+
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+dvector<Ty> dmatrix<Ty>::operator*(const dvector<Ty> &rhs) const {
+	if (_Cols != rhs.size()) {
+		throw std::runtime_error("dmatrix dimension mismatch!");
+	}
+	dvector<Ty> res(_Rows);
+	gemv(_Rows, _Cols, Ty(1), data(), _Cols, rhs.data(), Ty(0), res.data());
+	return res;
+}
+
+// mixed dynamic / fixed-size operations BEGINS
+template<typename Ty, size_t M, size_t N, bool simd>
+    requires(N != 1)
+dmatrix<Ty> operator*(const dmatrix<Ty> &lhs, const matrix<Ty, M, N, simd> &rhs) {
+	if (lhs.cols() != M) {
+		throw std::runtime_error("dmatrix dimension mismatch!");
+	}
+	dmatrix<Ty> res(lhs.rows(), N);
+	dispatch::gemm(lhs.rows(), N, M, Ty(1), lhs.data(), lhs.cols(), rhs.data(), N, Ty(0), res.data(), N);
+	return res;
+}
+
+template<typename Ty, size_t M, size_t N, bool simd>
+dmatrix<Ty> operator*(const matrix<Ty, M, N, simd> &lhs, const dmatrix<Ty> &rhs) {
+	if (rhs.rows() != N) {
+		throw std::runtime_error("dmatrix dimension mismatch!");
+	}
+	dmatrix<Ty> res(M, rhs.cols());
+	dispatch::gemm(M, rhs.cols(), N, Ty(1), lhs.data(), N, rhs.data(), rhs.cols(), Ty(0), res.data(), rhs.cols());
+	return res;
+}
+
+template<typename Ty, size_t M, size_t N, bool simd>
+dmatrix<Ty> operator+(const dmatrix<Ty> &lhs, const matrix<Ty, M, N, simd> &rhs) {
+	return lhs + dmatrix<Ty>(rhs);
+}
+
+template<typename Ty, size_t M, size_t N, bool simd>
+dmatrix<Ty> operator+(const matrix<Ty, M, N, simd> &lhs, const dmatrix<Ty> &rhs) {
+	return dmatrix<Ty>(lhs) + rhs;
+}
+
+template<typename Ty, size_t M, size_t N, bool simd>
+dmatrix<Ty> operator-(const dmatrix<Ty> &lhs, const matrix<Ty, M, N, simd> &rhs) {
+	return lhs - dmatrix<Ty>(rhs);
+}
+
+template<typename Ty, size_t M, size_t N, bool simd>
+dmatrix<Ty> operator-(const matrix<Ty, M, N, simd> &lhs, const dmatrix<Ty> &rhs) {
+	return dmatrix<Ty>(lhs) - rhs;
+}
+
+// a runtime-sized matrix applied to a fixed-size vector
+template<typename Ty, size_t M, bool simd>
+dvector<Ty> operator*(const dmatrix<Ty> &lhs, const matrix<Ty, M, 1, simd> &rhs) {
+	if (lhs.cols() != M) {
+		throw std::runtime_error("dmatrix dimension mismatch!");
+	}
+	dvector<Ty> res(lhs.rows());
+	gemv(lhs.rows(), M, Ty(1), lhs.data(), M, rhs.data(), Ty(0), res.data());
+	return res;
+}
+
+// a fixed-size matrix applied to a runtime-sized vector
+template<typename Ty, size_t M, size_t N, bool simd>
+    requires(N != 1)
+dvector<Ty> operator*(const matrix<Ty, M, N, simd> &lhs, const dvector<Ty> &rhs) {
+	if (rhs.size() != N) {
+		throw std::runtime_error("dvector dimension mismatch!");
+	}
+	dvector<Ty> res(M);
+	gemv(M, N, Ty(1), lhs.data(), N, rhs.data(), Ty(0), res.data());
+	return res;
+}
+// mixed dynamic / fixed-size operations ENDS
+
+using dmatrixi = dmatrix<int>;
+using dmatrixf = dmatrix<float>;
+using dmatrixd = dmatrix<double>;
+using dvectori = dvector<int>;
+using dvectorf = dvector<float>;
+using dvectord = dvector<double>;
+
+}  // namespace linalg
+
+}  // namespace nstd
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+
+// TODO: REMOVE these deps in future versions
+#include <type_traits>
+
+/*
+ * dense BLAS-style kernels on raw row-major storage, shared by the dynamic and fixed-size matrix types
+ * 1. every operand is (pointer, leading dimension); the leading dimension is the distance between rows
+ * 2. gemm packs blocks of A and B into contiguous panels (blocked for L1 / L2 / L3, see gemm_blocking)
+ *    and runs an MR x NR register-tiled micro kernel over them
+ * 3. beta == 0 overwrites c without reading it, so c may start uninitialized (or hold NaN)
+ * 4. c must not alias a or b (y must not alias x)
+ * 5. level-1 helpers (dot / axpy / scal) take a length and plain contiguous arrays
+ */
+
+namespace nstd {
+
+namespace linalg {
+
+// Vec is the register type the kernels run on, simd<Ty> unless a dispatched variant picks another instruction set
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+struct gemm_blocking {
+	static constexpr size_t width = Vec::width;
+	static constexpr size_t mr = width == 1 ? 4 : 6;          // mr x (nr / width) accumulators + nr / width loads of B fit the register file
+	static constexpr size_t nr = width == 1 ? 4 : 2 * width;  // two registers of B per k step
+	static constexpr size_t kc = 256;                         // kc x nr panel of B stays in L1
+	static constexpr size_t mc = 96;                          // mc x kc block of A stays in L2
+	static constexpr size_t nc = 2048;                        // kc x nc block of B stays in L3
+};
+
+namespace internal {
+
+// packs rows [0, m) x cols [0, k) of a into panels of mr rows, column by column, zero-padding the last panel
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+void gemm_pack_a(const Ty *a, size_t lda, size_t m, size_t k, Ty *dst) noexcept {
+	constexpr size_t mr = gemm_blocking<Ty, Vec>::mr;
+	for (size_t i0 = 0; i0 < m; i0 += mr) {
+		const size_t rows = m - i0 < mr ? m - i0 : mr;
+		for (size_t p = 0; p < k; p++) {
+			for (size_t i = 0; i < mr; i++) {
+				dst[i] = i < rows ? a[(i0 + i) * lda + p] : Ty(0);
+			}
+			dst += mr;
+		}
+	}
+}
+
+// packs rows [0, k) x cols [0, n) of b into panels of nr columns, row by row, zero-padding the last panel
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+void gemm_pack_b(const Ty *b, size_t ldb, size_t k, size_t n, Ty *dst) noexcept {
+	constexpr size_t nr = gemm_blocking<Ty, Vec>::nr;
+	for (size_t j0 = 0; j0 < n; j0 += nr) {
+		const size_t cols = n - j0 < nr ? n - j0 : nr;
+		for (size_t p = 0; p < k; p++) {
+			const Ty *src = b + p * ldb + j0;
+			if (cols == nr) {
+				for (size_t j = 0; j < nr; j++) {
+					dst[j] = src[j];
+				}
+			} else {
+				for (size_t j = 0; j < nr; j++) {
+					dst[j] = j < cols ? src[j] : Ty(0);
+				}
+			}
+			dst += nr;
+		}
+	}
+}
+
+// acc = packed a panel (mr x k) * packed b panel (k x nr), then c = alpha * acc (+ beta * c) on the valid m x n corner
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+void gemm_micro_kernel(size_t k, const Ty *__restrict a, const Ty *__restrict b, Ty alpha, Ty beta, Ty *c, size_t ldc,
+                       size_t m, size_t n) noexcept {
+	using vec = Vec;
+	using nstd::internal::static_for;
+	using reg = typename vec::reg;
+	constexpr size_t mr = gemm_blocking<Ty, Vec>::mr;
+	constexpr size_t nr = gemm_blocking<Ty, Vec>::nr;
+	constexpr size_t nv = nr / vec::width;
+
+	reg acc[mr][nv];
+	static_for<mr>([&](auto i) {
+		static_for<nv>([&](auto v) { acc[i][v] = vec::zero(); });
+	});
+	for (size_t p = 0; p < k; p++) {
+		reg bv[nv];
+		static_for<nv>([&](auto v) { bv[v] = vec::load(b + v * vec::width); });
+		static_for<mr>([&](auto i) {
+			const reg ai = vec::set1(a[i]);
+			static_for<nv>([&](auto v) { acc[i][v] = vec::fmadd(ai, bv[v], acc[i][v]); });
+		});
+		a += mr;
+		b += nr;
+	}
+
+	const reg alpha_v = vec::set1(alpha);
+	if (m == mr && n == nr) {
+		const reg beta_v = vec::set1(beta);
+		for (size_t i = 0; i < mr; i++) {
+			Ty *c_row = c + i * ldc;
+			for (size_t v = 0; v < nv; v++) {
+				const reg scaled = vec::mul(alpha_v, acc[i][v]);
+				Ty *dst = c_row + v * vec::width;
+				vec::store(dst, beta == Ty(0) ? scaled : vec::fmadd(beta_v, vec::load(dst), scaled));
+			}
+		}
+		return;
+	}
+
+	Ty tile[mr][nr];  // edge tile, spill and copy the valid corner
+	for (size_t i = 0; i < mr; i++) {
+		for (size_t v = 0; v < nv; v++) {
+			vec::store(tile[i] + v * vec::width, vec::mul(alpha_v, acc[i][v]));
+		}
+	}
+	for (size_t i = 0; i < m; i++) {
+		Ty *c_row = c + i * ldc;
+		for (size_t j = 0; j < n; j++) {
+			c_row[j] = beta == Ty(0) ? tile[i][j] : tile[i][j] + beta * c_row[j];
+		}
+	}
+}
+
+// c *= beta for the degenerate k == 0 product
+template<typename Ty>
+void gemm_scale(size_t m, size_t n, Ty beta, Ty *c, size_t ldc) noexcept {
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			c[i * ldc + j] = beta == Ty(0) ? Ty(0) : beta * c[i * ldc + j];
+		}
+	}
+}
+
+/*
+ * the blocked loop nest of gemm for m, n, k > 0 and alpha != 0
+ * pack_a holds mc * kc and pack_b kc * (nc + nr) elements of gemm_blocking<Ty, Vec>
+ */
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+void gemm_blocked(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c,
+                  size_t ldc, Ty *pack_a, Ty *pack_b) noexcept {
+	using blocking = gemm_blocking<Ty, Vec>;
+	for (size_t jc = 0; jc < n; jc += blocking::nc) {
+		const size_t nc = n - jc < blocking::nc ? n - jc : blocking::nc;
+		for (size_t pc = 0; pc < k; pc += blocking::kc) {
+			const size_t kc = k - pc < blocking::kc ? k - pc : blocking::kc;
+			const Ty beta_block = pc == 0 ? beta : Ty(1);  // later k blocks accumulate onto the first
+			gemm_pack_b<Ty, Vec>(b + pc * ldb + jc, ldb, kc, nc, pack_b);
+
+			for (size_t ic = 0; ic < m; ic += blocking::mc) {
+				const size_t mc = m - ic < blocking::mc ? m - ic : blocking::mc;
+				gemm_pack_a<Ty, Vec>(a + ic * lda + pc, lda, mc, kc, pack_a);
+
+				for (size_t jr = 0; jr < nc; jr += blocking::nr) {
+					const size_t nr = nc - jr < blocking::nr ? nc - jr : blocking::nr;
+					const Ty *b_panel = pack_b + jr * kc;
+					for (size_t ir = 0; ir < mc; ir += blocking::mr) {
+						const size_t mr = mc - ir < blocking::mr ? mc - ir : blocking::mr;
+						gemm_micro_kernel<Ty, Vec>(kc, pack_a + ir * kc, b_panel, alpha, beta_block, c + (ic + ir) * ldc + jc + jr, ldc,
+						                           mr, nr);
+					}
+				}
+			}
+		}
+	}
+}
+
+// scratch panels for one thread, grown on demand and kept for the next call
+template<typename Ty>
+struct gemm_workspace {
+	aligned_buffer<Ty> _PackA;
+	aligned_buffer<Ty> _PackB;
+
+	static gemm_workspace &local() {
+		thread_local gemm_workspace instance;
+		return instance;
+	}
+};
+
+}  // namespace internal
+
+// sum of x[i] * y[i] over [0, n)
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+    requires(std::is_arithmetic_v<Ty>)
+Ty dot(size_t n, const Ty *x, const Ty *y) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	reg acc[4] = { vec::zero(), vec::zero(), vec::zero(), vec::zero() };  // independent chains hide the add latency
+	size_t i = 0;
+	for (; i + 4 * vec::width <= n; i += 4 * vec::width) {
+		nstd::internal::static_for<4>([&](auto r) {
+			acc[r] = vec::fmadd(vec::load(x + i + r * vec::width), vec::load(y + i + r * vec::width), acc[r]);
+		});
+	}
+	for (; i + vec::width <= n; i += vec::width) {
+		acc[0] = vec::fmadd(vec::load(x + i), vec::load(y + i), acc[0]);
+	}
+	Ty res = vec::hsum(vec::add(vec::add(acc[0], acc[1]), vec::add(acc[2], acc[3])));
+	for (; i < n; i++) {
+		res += x[i] * y[i];
+	}
+	return res;
+}
+
+// y += alpha * x
+template<typename Ty, typename Vec = nstd::internal::simd<Ty>>
+    requires(std::is_arithmetic_v<Ty>)
+void axpy(size_t n, Ty alpha, const Ty *x, Ty *y) noexcept {
+	using vec = Vec;
+	const auto alpha_v = vec::set1(alpha);
+	size_t i = 0;
+	for (; i + vec::width <= n; i += vec::width) {
+		vec::store(y + i, vec::fmadd(alpha_v, vec::load(x + i), vec::load(y + i)));
+	}
+	for (; i < n; i++) {
+		y[i] += alpha * x[i];
+	}
+}
+
+// x *= alpha, alpha == 0 clears x without reading it
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void scal(size_t n, Ty alpha, Ty *x) noexcept {
+	if (alpha == Ty(0)) {
+		for (size_t i = 0; i < n; i++) {
+			x[i] = Ty(0);
+		}
+		return;
+	}
+	for (size_t i = 0; i < n; i++) {
+		x[i] *= alpha;
+	}
+}
+
+// c (m x n) = alpha * a (m x k) * b (k x n) + beta * c
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void gemm(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c,
+          size_t ldc) {
+	NSTD_PROFILE_SCOPE("linalg::gemm");
+	using blocking = gemm_blocking<Ty>;
+	if (m == 0 || n == 0) {
+		return;
+	}
+	if (k == 0 || alpha == Ty(0)) {
+		internal::gemm_scale(m, n, beta, c, ldc);
+		return;
+	}
+
+	auto &ws = internal::gemm_workspace<Ty>::local();
+	ws._PackA.reserve(blocking::mc * blocking::kc);
+	ws._PackB.reserve(blocking::kc * (blocking::nc + blocking::nr));
+
+	internal::gemm_blocked(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, ws._PackA.data(), ws._PackB.data());
+}
+
+// y (m) = alpha * a (m x n) * x (n) + beta * y
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void gemv(size_t m, size_t n, Ty alpha, const Ty *a, size_t lda, const Ty *x, Ty beta, Ty *y) noexcept {
+	NSTD_PROFILE_SCOPE("linalg::gemv");
+	using vec = nstd::internal::simd<Ty>;
+	using reg = typename vec::reg;
+	constexpr size_t rows = 4;  // rows share every load of x
+
+	size_t i = 0;
+	for (; i + rows <= m; i += rows) {
+		reg acc[rows] = { vec::zero(), vec::zero(), vec::zero(), vec::zero() };
+		size_t j = 0;
+		for (; j + vec::width <= n; j += vec::width) {
+			const reg xv = vec::load(x + j);
+			nstd::internal::static_for<rows>([&](auto r) { acc[r] = vec::fmadd(vec::load(a + (i + r) * lda + j), xv, acc[r]); });
+		}
+		for (size_t r = 0; r < rows; r++) {
+			const Ty *row = a + (i + r) * lda;
+			Ty s = vec::hsum(acc[r]);
+			for (size_t t = j; t < n; t++) {
+				s += row[t] * x[t];
+			}
+			y[i + r] = beta == Ty(0) ? alpha * s : alpha * s + beta * y[i + r];
+		}
+	}
+	for (; i < m; i++) {
+		const Ty s = dot(n, a + i * lda, x);
+		y[i] = beta == Ty(0) ? alpha * s : alpha * s + beta * y[i];
+	}
+}
+
+// y (n) = alpha * a^T (n x m) * x (m) + beta * y, walks a row by row
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void gemv_t(size_t m, size_t n, Ty alpha, const Ty *a, size_t lda, const Ty *x, Ty beta, Ty *y) noexcept {
+	NSTD_PROFILE_SCOPE("linalg::gemv_t");
+	scal(n, beta, y);
+	for (size_t i = 0; i < m; i++) {
+		axpy(n, alpha * x[i], a + i * lda, y);
+	}
+}
+
+}  // namespace linalg
+
+}  // namespace nstd
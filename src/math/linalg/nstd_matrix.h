@@ -1,13 +1,17 @@
 #pragma once
 
+#include <math/nstd_dispatch.h>
 #include <math/nstd_math.h>
+#include <util/nstd_bounds.h>
 #include <util/nstd_stddef.h>
+#include <util/nstd_hash.h>
+#include <util/nstd_profile.h>
 #include <util/nstd_type_traits.h>
 #include <util/nstd_utility.h>
 
 // TODO: REMOVE these deps in future versions
-#include <cassert>
-#include <cmath>
+#include <stdexcept>
+#include <type_traits>
 
 /*
  * ! assumptions !
@@ -28,11 +32,11 @@ class matrix_base {
 	struct matrix_visitor {
 		_Ty *_Data;
 
-		explicit matrix_visitor(_Ty *data_ptr)
+		constexpr explicit matrix_visitor(_Ty *data_ptr)
 		    : _Data(data_ptr) {}
 
-		_Ty &operator[](size_t i) {
-			assert(i < _N);
+		constexpr _Ty &operator[](size_t i) const {
+			NSTD_BOUNDS_ASSERT(i < _N);
 			return _Data[i];
 		}
 	};
@@ -72,7 +76,7 @@ public:
 	}
 
 	constexpr decltype(auto) operator[](size_t i) const {
-		assert(i < M);
+		NSTD_BOUNDS_ASSERT(i < M);
 		if constexpr (N != 1) {
 			return matrix_visitor<const Ty, N>(_Data[i]);
 		} else {
@@ -81,7 +85,7 @@ public:
 	}
 
 	constexpr decltype(auto) operator[](size_t i) {
-		assert(i < M);
+		NSTD_BOUNDS_ASSERT(i < M);
 		if constexpr (N != 1) {
 			return matrix_visitor<Ty, N>(_Data[i]);
 		} else {
@@ -89,8 +93,38 @@ public:
 		}
 	}
 
+	// bounds-checked, and the one accessor that works the same on vectors (whose operator[] yields scalars)
+	constexpr Ty &at(size_t i, size_t j) {
+		if (i >= M || j >= N) {
+			nstd::internal::bounds_failure("matrix out of bounds!");
+		}
+		return _Data[i][j];
+	}
+
+	constexpr const Ty &at(size_t i, size_t j) const {
+		if (i >= M || j >= N) {
+			nstd::internal::bounds_failure("matrix out of bounds!");
+		}
+		return _Data[i][j];
+	}
+
+	constexpr Ty *data() {
+		return &_Data[0][0];
+	}
+
 	constexpr const Ty *data() const {
-		return static_cast<const Ty *>(_Data);
+		return &_Data[0][0];
+	}
+
+	constexpr bool operator==(const Derived &rhs) const {
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				if (_Data[i][j] != rhs._Data[i][j]) {
+					return false;
+				}
+			}
+		}
+		return true;
 	}
 
 	constexpr Derived operator+(const Derived &rhs) const {
@@ -130,7 +164,7 @@ public:
 		for (size_t i = 0; i < M; i++) {
 			res += _Data[i][0] * _Data[i][0];
 		}
-		return std::sqrt(res);  // TODO: use nstd::sqrt
+		return nstd::sqrt(res);
 	}
 
 	template<size_t _ = M>
@@ -147,7 +181,7 @@ public:
 	    requires(N == 1)
 	constexpr void normalize() {
 		Ty length = norm();
-		if (!is_approx(length, 0.0f, static_cast<Ty>(1e-5f))) {
+		if (!is_approx(length, static_cast<Ty>(0), static_cast<Ty>(1e-5f))) {
 			for (size_t i = 0; i < M; i++) {
 				_Data[i][0] /= length;
 			}
@@ -225,10 +259,16 @@ constexpr Derived cross(const Derived &lhs, const Derived &rhs) {
 	return lhs.cross(rhs);
 }
 
+// fixed-size products of at least this many multiply-adds go through dispatch::gemm instead of the plain loop nest
+inline constexpr size_t gemm_fixed_min = 32 * 32 * 32;
+
 template<typename Ty, size_t M, size_t N, bool simd>
 class matrix : public matrix_base<matrix<Ty, M, N, simd>, Ty, M, N, simd> {
 	using base = matrix_base<matrix, Ty, M, N, simd>;
 
+	template<typename, size_t, size_t, bool>
+	friend class matrix;
+
 public:
 	using value_type = Ty;
 
@@ -256,12 +296,22 @@ public:
 
 	template<typename Mat>
 	constexpr auto _impl_mul(const Mat &rhs) const {
-		auto res = matrix<Ty, M, Mat::size_col(), simd>::zeros();
+		NSTD_PROFILE_SCOPE("linalg::matrix::mul");
+		constexpr size_t P = Mat::size_col();
+		if !consteval {
+			// large products take the packed (and, past dispatch's threshold, parallel) gemm
+			if constexpr (std::is_arithmetic_v<Ty> && M * N * P >= gemm_fixed_min) {
+				matrix<Ty, M, P, simd> res;
+				dispatch::gemm(M, P, N, Ty(1), base::data(), N, rhs.data(), P, Ty(0), res.data(), P);
+				return res;
+			}
+		}
+		auto res = matrix<Ty, M, P, simd>::zeros();
 		for (size_t i = 0; i < M; i++) {
-			for (size_t j = 0; j < Mat::size_col(); j++) {
-				for (size_t k = 0; k < N; k++) {
-					res[i][j] += base::_Data[i][k] * rhs[k][j];
-					// NOTE(25/07/08): potential optimization?
+			for (size_t k = 0; k < N; k++) {
+				const Ty a = base::_Data[i][k];
+				for (size_t j = 0; j < P; j++) {
+					res._Data[i][j] += a * rhs._Data[k][j];
 				}
 			}
 		}
@@ -284,6 +334,225 @@ constexpr matrix<Ty, M, N, simd> _impl_scalar_mul_mat(Ty scalar, const matrix<Ty
 	return mat * scalar;
 }
 
+// decompositions BEGINS
+/*
+ * small dense factorizations, all usable in constant expressions (e.g. to build constinit tables)
+ * ! assumptions !
+ * 1. floating-point element types only
+ * 2. a failure during constant evaluation (singular / indefinite input) is a compile error,
+ *    at run time it is reported through the result (or an exception for the convenience functions)
+ */
+template<typename Ty, size_t M, size_t N, bool simd>
+constexpr matrix<Ty, N, M, simd> transpose(const matrix<Ty, M, N, simd> &mat) {
+	matrix<Ty, N, M, simd> res;
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < N; j++) {
+			res.at(j, i) = mat.at(i, j);
+		}
+	}
+	return res;
+}
+
+template<typename Ty, size_t N, bool simd>
+constexpr Ty trace(const matrix<Ty, N, N, simd> &mat) {
+	Ty res{};
+	for (size_t i = 0; i < N; i++) {
+		res += mat.at(i, i);
+	}
+	return res;
+}
+
+// P A = L U with partial pivoting, L has a unit diagonal and is stored below the diagonal of _LU
+template<typename Ty, size_t N, bool simd>
+    requires(std::is_floating_point_v<Ty>)
+struct lu_decomposition {
+	matrix<Ty, N, N, simd> _LU;
+	size_t _Perm[N]{};  // row i of P A is row _Perm[i] of A
+	int _Sign = 1;      // determinant of P
+	bool _Singular = false;
+
+	constexpr explicit lu_decomposition(const matrix<Ty, N, N, simd> &mat)
+	    : _LU(mat) {
+		for (size_t i = 0; i < N; i++) {
+			_Perm[i] = i;
+		}
+		for (size_t k = 0; k < N; k++) {
+			size_t pivot = k;
+			for (size_t i = k + 1; i < N; i++) {
+				if (abs(_LU.at(i, k)) > abs(_LU.at(pivot, k))) {
+					pivot = i;
+				}
+			}
+			if (_LU.at(pivot, k) == Ty(0)) {
+				_Singular = true;
+				continue;
+			}
+			if (pivot != k) {
+				for (size_t j = 0; j < N; j++) {
+					const Ty tmp = _LU.at(k, j);
+					_LU.at(k, j) = _LU.at(pivot, j);
+					_LU.at(pivot, j) = tmp;
+				}
+				const size_t tmp = _Perm[k];
+				_Perm[k] = _Perm[pivot];
+				_Perm[pivot] = tmp;
+				_Sign = -_Sign;
+			}
+			for (size_t i = k + 1; i < N; i++) {
+				const Ty l = _LU.at(i, k) / _LU.at(k, k);
+				_LU.at(i, k) = l;
+				for (size_t j = k + 1; j < N; j++) {
+					_LU.at(i, j) -= l * _LU.at(k, j);
+				}
+			}
+		}
+	}
+
+	constexpr Ty determinant() const {
+		Ty res = static_cast<Ty>(_Sign);
+		for (size_t i = 0; i < N; i++) {
+			res *= _LU.at(i, i);
+		}
+		return res;
+	}
+
+	constexpr matrix<Ty, N, 1, simd> solve(const matrix<Ty, N, 1, simd> &b) const {
+		if (_Singular) {
+			throw std::runtime_error("matrix is singular!");
+		}
+		matrix<Ty, N, 1, simd> x;
+		for (size_t i = 0; i < N; i++) {
+			Ty s = b.at(_Perm[i], 0);
+			for (size_t j = 0; j < i; j++) {
+				s -= _LU.at(i, j) * x.at(j, 0);
+			}
+			x.at(i, 0) = s;
+		}
+		for (size_t i = N; i-- > 0;) {
+			Ty s = x.at(i, 0);
+			for (size_t j = i + 1; j < N; j++) {
+				s -= _LU.at(i, j) * x.at(j, 0);
+			}
+			x.at(i, 0) = s / _LU.at(i, i);
+		}
+		return x;
+	}
+
+	constexpr matrix<Ty, N, N, simd> inverse() const {
+		matrix<Ty, N, N, simd> res;
+		for (size_t j = 0; j < N; j++) {
+			auto e = matrix<Ty, N, 1, simd>::zeros();
+			e.at(j, 0) = Ty(1);
+			const auto col = solve(e);
+			for (size_t i = 0; i < N; i++) {
+				res.at(i, j) = col.at(i, 0);
+			}
+		}
+		return res;
+	}
+};
+
+// A = L L^T for a symmetric positive definite A, only the lower triangle of A is read
+template<typename Ty, size_t N, bool simd>
+    requires(std::is_floating_point_v<Ty>)
+struct cholesky_decomposition {
+	matrix<Ty, N, N, simd> _L = matrix<Ty, N, N, simd>::zeros();
+	bool _Success = true;
+
+	constexpr explicit cholesky_decomposition(const matrix<Ty, N, N, simd> &mat) {
+		for (size_t j = 0; j < N; j++) {
+			Ty d = mat.at(j, j);
+			for (size_t k = 0; k < j; k++) {
+				d -= _L.at(j, k) * _L.at(j, k);
+			}
+			if (!(d > Ty(0))) {
+				_Success = false;
+				return;
+			}
+			_L.at(j, j) = nstd::sqrt(d);
+			for (size_t i = j + 1; i < N; i++) {
+				Ty s = mat.at(i, j);
+				for (size_t k = 0; k < j; k++) {
+					s -= _L.at(i, k) * _L.at(j, k);
+				}
+				_L.at(i, j) = s / _L.at(j, j);
+			}
+		}
+	}
+
+	constexpr matrix<Ty, N, 1, simd> solve(const matrix<Ty, N, 1, simd> &b) const {
+		if (!_Success) {
+			throw std::runtime_error("matrix is not positive definite!");
+		}
+		matrix<Ty, N, 1, simd> x;
+		for (size_t i = 0; i < N; i++) {
+			Ty s = b.at(i, 0);
+			for (size_t k = 0; k < i; k++) {
+				s -= _L.at(i, k) * x.at(k, 0);
+			}
+			x.at(i, 0) = s / _L.at(i, i);
+		}
+		for (size_t i = N; i-- > 0;) {
+			Ty s = x.at(i, 0);
+			for (size_t k = i + 1; k < N; k++) {
+				s -= _L.at(k, i) * x.at(k, 0);
+			}
+			x.at(i, 0) = s / _L.at(i, i);
+		}
+		return x;
+	}
+};
+
+// A = Q R by modified Gram-Schmidt, Q has orthonormal columns and R is upper triangular (M >= N, full column rank)
+template<typename Ty, size_t M, size_t N, bool simd>
+    requires(std::is_floating_point_v<Ty> && M >= N)
+struct qr_decomposition {
+	matrix<Ty, M, N, simd> _Q;
+	matrix<Ty, N, N, simd> _R = matrix<Ty, N, N, simd>::zeros();
+	bool _FullRank = true;
+
+	constexpr explicit qr_decomposition(const matrix<Ty, M, N, simd> &mat)
+	    : _Q(mat) {
+		for (size_t j = 0; j < N; j++) {
+			Ty len{};
+			for (size_t i = 0; i < M; i++) {
+				len += _Q.at(i, j) * _Q.at(i, j);
+			}
+			len = nstd::sqrt(len);
+			_R.at(j, j) = len;
+			if (len == Ty(0)) {
+				_FullRank = false;
+				continue;
+			}
+			for (size_t i = 0; i < M; i++) {
+				_Q.at(i, j) /= len;
+			}
+			for (size_t k = j + 1; k < N; k++) {
+				Ty proj{};
+				for (size_t i = 0; i < M; i++) {
+					proj += _Q.at(i, j) * _Q.at(i, k);
+				}
+				_R.at(j, k) = proj;
+				for (size_t i = 0; i < M; i++) {
+					_Q.at(i, k) -= proj * _Q.at(i, j);
+				}
+			}
+		}
+	}
+};
+
+template<typename Ty, size_t N, bool simd>
+constexpr Ty determinant(const matrix<Ty, N, N, simd> &mat) {
+	return lu_decomposition<Ty, N, simd>(mat).determinant();
+}
+
+// throws std::runtime_error if mat is singular
+template<typename Ty, size_t N, bool simd>
+constexpr matrix<Ty, N, N, simd> inverse(const matrix<Ty, N, N, simd> &mat) {
+	return lu_decomposition<Ty, N, simd>(mat).inverse();
+}
+// decompositions ENDS
+
 template<typename Ty, size_t M, size_t N, bool simd>
 class matrix_v2 : public matrix_base<matrix<Ty, M, N, simd>, Ty, M, N, simd> {
 public:
@@ -304,4 +573,18 @@ using matrix4d = matrix<double, 4, 4, false>;
 
 }  // namespace linalg
 
+// integer matrices / vectors (e.g. grid cell coordinates) as hash keys
+template<typename Ty, size_t M, size_t N, bool simd>
+    requires(std::is_integral_v<Ty>)
+struct hash<linalg::matrix<Ty, M, N, simd>> {
+	size_t operator()(const linalg::matrix<Ty, M, N, simd> &mat) const noexcept {
+		const Ty *data = mat.data();
+		unsigned long long res = 0;
+		for (size_t i = 0; i < M * N; i++) {
+			res = (res ^ static_cast<unsigned long long>(data[i])) * 0x9e3779b97f4a7c15ull;
+		}
+		return static_cast<size_t>(internal::mix64(res));
+	}
+};
+
 }  // namespace nstd
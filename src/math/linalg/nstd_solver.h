@@ -0,0 +1,524 @@
+#pragma once
+
+#include <math/linalg/nstd_dmatrix.h>
+#include <math/linalg/nstd_gemm.h>
+#include <math/linalg/nstd_sparse.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Krylov solvers for A x = b
+ * 1. A is anything satisfying linear_operator: rows() / cols() and apply(op, x, y) computing y = A x;
+ *    csr_matrix, dmatrix and types with an apply(x, y) member work out of the box
+ * 2. preconditioners are computed once (setup allocates) and applied as z = M^-1 r without allocating
+ * 3. a solver object owns its workspace, repeated solves of the same (or smaller) size never allocate
+ * 4. x holds the initial guess on entry and the solution on exit; convergence is ||b - A x|| <= tolerance * ||b||
+ * 5. cg requires A (and M) symmetric positive definite, bicgstab only requires A to be nonsingular
+ */
+
+namespace nstd {
+
+namespace linalg {
+
+// operators BEGINS
+template<typename Ty, typename Index>
+void apply(const csr_matrix<Ty, Index> &op, const Ty *x, Ty *y) noexcept {
+	spmv(op, x, y);
+}
+
+template<typename Ty>
+void apply(const dmatrix<Ty> &op, const Ty *x, Ty *y) noexcept {
+	gemv(op.rows(), op.cols(), Ty(1), op.data(), op.cols(), x, Ty(0), y);
+}
+
+template<typename Op, typename Ty>
+    requires requires(const Op &op, const Ty *x, Ty *y) { op.apply(x, y); }
+void apply(const Op &op, const Ty *x, Ty *y) {
+	op.apply(x, y);
+}
+
+template<typename Op, typename Ty>
+concept linear_operator = requires(const Op &op, const Ty *x, Ty *y) {
+	{ op.rows() } -> std::convertible_to<size_t>;
+	{ op.cols() } -> std::convertible_to<size_t>;
+	apply(op, x, y);
+};
+
+// a CSR matrix whose products are split across a thread pool
+template<typename Ty, typename Index = int>
+class threaded_csr {
+	const csr_matrix<Ty, Index> *_Matrix;
+	thread_pool *_Pool;
+
+public:
+	threaded_csr(const csr_matrix<Ty, Index> &mat, thread_pool &pool = thread_pool::global()) noexcept
+	    : _Matrix(&mat), _Pool(&pool) {}
+
+	size_t rows() const noexcept {
+		return _Matrix->rows();
+	}
+
+	size_t cols() const noexcept {
+		return _Matrix->cols();
+	}
+
+	void apply(const Ty *x, Ty *y) const {
+		spmv(*_Matrix, x, y, *_Pool);
+	}
+};
+// operators ENDS
+
+// preconditioners BEGINS
+template<typename Pre, typename Ty>
+concept preconditioner = requires(const Pre &pre, const Ty *r, Ty *z) {
+	pre.apply(r, z);
+};
+
+template<typename Ty>
+class identity_preconditioner {
+	size_t _Size = 0;
+
+public:
+	identity_preconditioner() = default;
+
+	explicit identity_preconditioner(size_t n) noexcept
+	    : _Size(n) {}
+
+	void apply(const Ty *r, Ty *z) const noexcept {
+		for (size_t i = 0; i < _Size; i++) {
+			z[i] = r[i];
+		}
+	}
+};
+
+// z = r / diag(A)
+template<typename Ty>
+class jacobi_preconditioner {
+	aligned_buffer<Ty> _InvDiag;
+
+	void invert() {
+		for (Ty &d : _InvDiag) {
+			if (d == Ty(0)) {
+				throw std::runtime_error("jacobi_preconditioner zero diagonal!");
+			}
+			d = Ty(1) / d;
+		}
+	}
+
+public:
+	jacobi_preconditioner() = default;
+
+	template<typename Index>
+	explicit jacobi_preconditioner(const csr_matrix<Ty, Index> &mat) {
+		compute(mat);
+	}
+
+	explicit jacobi_preconditioner(const dmatrix<Ty> &mat) {
+		compute(mat);
+	}
+
+	template<typename Index>
+	void compute(const csr_matrix<Ty, Index> &mat) {
+		_InvDiag.resize(mat.rows());
+		for (size_t i = 0; i < mat.rows(); i++) {
+			_InvDiag[i] = Ty(0);
+			for (size_t k = static_cast<size_t>(mat.row_ptr()[i]); k < static_cast<size_t>(mat.row_ptr()[i + 1]); k++) {
+				if (static_cast<size_t>(mat.col_idx()[k]) == i) {
+					_InvDiag[i] = mat.values()[k];
+				}
+			}
+		}
+		invert();
+	}
+
+	void compute(const dmatrix<Ty> &mat) {
+		_InvDiag.resize(mat.rows());
+		for (size_t i = 0; i < mat.rows(); i++) {
+			_InvDiag[i] = mat[i][i];
+		}
+		invert();
+	}
+
+	void apply(const Ty *r, Ty *z) const noexcept {
+		const Ty *inv = _InvDiag.data();
+		for (size_t i = 0; i < _InvDiag.size(); i++) {
+			z[i] = r[i] * inv[i];
+		}
+	}
+};
+
+/*
+ * incomplete Cholesky with zero fill-in, A ~ L L^T where L keeps the pattern of the lower triangle of A
+ * ! assumptions !
+ * 1. A is symmetric, only its lower triangle (diagonal included) is read
+ * 2. every row stores its diagonal; a non-positive pivot throws (shift the diagonal of A and retry)
+ */
+template<typename Ty, typename Index = int>
+class ic0_preconditioner {
+	csr_matrix<Ty, Index> _L;  // diagonal last in every row
+	aligned_buffer<Ty> _InvDiag;
+
+public:
+	ic0_preconditioner() = default;
+
+	explicit ic0_preconditioner(const csr_matrix<Ty, Index> &mat) {
+		compute(mat);
+	}
+
+	void compute(const csr_matrix<Ty, Index> &mat) {
+		NSTD_PROFILE_SCOPE("linalg::ic0::compute");
+		const size_t n = mat.rows();
+		std::vector<Index> ptr(n + 1, Index(0)), idx;
+		std::vector<Ty> val;
+		for (size_t i = 0; i < n; i++) {
+			bool has_diag = false;
+			for (size_t k = static_cast<size_t>(mat.row_ptr()[i]); k < static_cast<size_t>(mat.row_ptr()[i + 1]); k++) {
+				const size_t j = static_cast<size_t>(mat.col_idx()[k]);
+				if (j <= i) {
+					idx.push_back(static_cast<Index>(j));
+					val.push_back(mat.values()[k]);
+					has_diag = has_diag || j == i;
+				}
+			}
+			if (!has_diag) {
+				throw std::runtime_error("ic0_preconditioner missing diagonal!");
+			}
+			ptr[i + 1] = static_cast<Index>(idx.size());
+		}
+
+		// row-by-row factorization, L[i][k] = (A[i][k] - <L[i][:k], L[k][:k]>) / L[k][k]
+		_InvDiag.resize(n);
+		for (size_t i = 0; i < n; i++) {
+			const size_t first = static_cast<size_t>(ptr[i]), diag = static_cast<size_t>(ptr[i + 1]) - 1;
+			for (size_t a = first; a <= diag; a++) {
+				const size_t k = static_cast<size_t>(idx[a]);
+				Ty s = val[a];
+				// sparse dot of the computed part of row i with row k (excluding its diagonal)
+				size_t p = first, q = static_cast<size_t>(ptr[k]);
+				const size_t q_end = static_cast<size_t>(ptr[k + 1]) - 1;
+				while (p < a && q < q_end) {
+					if (idx[p] < idx[q]) {
+						p++;
+					} else if (idx[q] < idx[p]) {
+						q++;
+					} else {
+						s -= val[p++] * val[q++];
+					}
+				}
+				if (a < diag) {
+					val[a] = s * _InvDiag[k];
+				} else {
+					if (!(s > Ty(0))) {
+						throw std::runtime_error("ic0_preconditioner non-positive pivot!");
+					}
+					val[a] = static_cast<Ty>(std::sqrt(s));
+					_InvDiag[i] = Ty(1) / val[a];
+				}
+			}
+		}
+		_L = csr_matrix<Ty, Index>(n, n, std::move(ptr), std::move(idx), std::move(val));
+	}
+
+	const csr_matrix<Ty, Index> &factor() const noexcept {
+		return _L;
+	}
+
+	// z = (L L^T)^-1 r: forward substitution with L, then backward substitution with L^T in place
+	void apply(const Ty *r, Ty *z) const noexcept {
+		const size_t n = _L.rows();
+		const Index *ptr = _L.row_ptr();
+		const Index *idx = _L.col_idx();
+		const Ty *val = _L.values();
+		const Ty *inv = _InvDiag.data();
+		for (size_t i = 0; i < n; i++) {
+			Ty s = r[i];
+			for (size_t k = static_cast<size_t>(ptr[i]); k + 1 < static_cast<size_t>(ptr[i + 1]); k++) {
+				s -= val[k] * z[static_cast<size_t>(idx[k])];
+			}
+			z[i] = s * inv[i];
+		}
+		for (size_t i = n; i-- > 0;) {
+			const Ty zi = z[i] * inv[i];
+			z[i] = zi;
+			for (size_t k = static_cast<size_t>(ptr[i]); k + 1 < static_cast<size_t>(ptr[i + 1]); k++) {
+				z[static_cast<size_t>(idx[k])] -= val[k] * zi;
+			}
+		}
+	}
+};
+// preconditioners ENDS
+
+template<typename Ty>
+struct solver_options {
+	size_t _MaxIterations = 1000;
+	Ty _Tolerance = static_cast<Ty>(1e-6);
+};
+
+template<typename Ty>
+struct solver_result {
+	size_t _Iterations = 0;
+	Ty _Residual = Ty(0);  // ||b - A x|| / ||b||
+	bool _Converged = false;
+};
+
+namespace internal {
+
+// x += alpha * p, r -= alpha * q, returns r . r; one pass instead of three
+template<typename Ty>
+Ty fused_update(size_t n, Ty alpha, const Ty *p, const Ty *q, Ty *x, Ty *r) noexcept {
+	using vec = nstd::internal::simd<Ty>;
+	using reg = typename vec::reg;
+	const reg alpha_v = vec::set1(alpha), neg_alpha_v = vec::set1(-alpha);
+	reg acc0 = vec::zero(), acc1 = vec::zero();
+	size_t i = 0;
+	for (; i + 2 * vec::width <= n; i += 2 * vec::width) {
+		vec::store(x + i, vec::fmadd(alpha_v, vec::load(p + i), vec::load(x + i)));
+		vec::store(x + i + vec::width, vec::fmadd(alpha_v, vec::load(p + i + vec::width), vec::load(x + i + vec::width)));
+		const reg r0 = vec::fmadd(neg_alpha_v, vec::load(q + i), vec::load(r + i));
+		const reg r1 = vec::fmadd(neg_alpha_v, vec::load(q + i + vec::width), vec::load(r + i + vec::width));
+		vec::store(r + i, r0);
+		vec::store(r + i + vec::width, r1);
+		acc0 = vec::fmadd(r0, r0, acc0);
+		acc1 = vec::fmadd(r1, r1, acc1);
+	}
+	Ty res = vec::hsum(vec::add(acc0, acc1));
+	for (; i < n; i++) {
+		x[i] += alpha * p[i];
+		r[i] -= alpha * q[i];
+		res += r[i] * r[i];
+	}
+	return res;
+}
+
+// p = z + beta * p
+template<typename Ty>
+void xpby(size_t n, const Ty *z, Ty beta, Ty *p) noexcept {
+	for (size_t i = 0; i < n; i++) {
+		p[i] = z[i] + beta * p[i];
+	}
+}
+
+// r = b - A x, returns ||r||
+template<typename Op, typename Ty>
+Ty residual(const Op &op, const Ty *b, const Ty *x, Ty *r) {
+	apply(op, x, r);
+	const size_t n = op.rows();
+	for (size_t i = 0; i < n; i++) {
+		r[i] = b[i] - r[i];
+	}
+	return static_cast<Ty>(std::sqrt(dot(n, r, r)));
+}
+
+template<typename Op>
+void check_square(const Op &op) {
+	if (static_cast<size_t>(op.rows()) != static_cast<size_t>(op.cols())) {
+		throw std::runtime_error("solver requires a square operator!");
+	}
+}
+
+}  // namespace internal
+
+// conjugate_gradient BEGINS
+template<typename Ty>
+    requires(std::is_floating_point_v<Ty>)
+class conjugate_gradient {
+	aligned_buffer<Ty> _Work;  // r, z, p, q
+	solver_options<Ty> _Options;
+
+public:
+	conjugate_gradient() = default;
+
+	explicit conjugate_gradient(solver_options<Ty> options)
+	    : _Options(options) {}
+
+	solver_options<Ty> &options() noexcept {
+		return _Options;
+	}
+
+	// sizes the workspace up front so that the first solve does not allocate either
+	void reserve(size_t n) {
+		_Work.reserve(4 * n);
+	}
+
+	template<linear_operator<Ty> Op, preconditioner<Ty> Pre>
+	solver_result<Ty> solve(const Op &op, const Ty *b, Ty *x, const Pre &pre) {
+		NSTD_PROFILE_SCOPE("linalg::conjugate_gradient::solve");
+		internal::check_square(op);
+		const size_t n = static_cast<size_t>(op.rows());
+		reserve(n);
+		Ty *r = _Work.data(), *z = r + n, *p = z + n, *q = p + n;
+
+		solver_result<Ty> res;
+		const Ty b_norm = static_cast<Ty>(std::sqrt(dot(n, b, b)));
+		if (b_norm == Ty(0)) {
+			scal(n, Ty(0), x);
+			res._Converged = true;
+			return res;
+		}
+		const Ty target = _Options._Tolerance * b_norm;
+
+		Ty r_norm = internal::residual(op, b, x, r);
+		res._Residual = r_norm / b_norm;
+		if (r_norm <= target) {
+			res._Converged = true;
+			return res;
+		}
+		pre.apply(r, z);
+		for (size_t i = 0; i < n; i++) {
+			p[i] = z[i];
+		}
+		Ty rz = dot(n, r, z);
+
+		while (res._Iterations < _Options._MaxIterations) {
+			apply(op, p, q);
+			const Ty pq = dot(n, p, q);
+			if (pq == Ty(0)) {
+				break;  // breakdown, A is not positive definite along p
+			}
+			const Ty alpha = rz / pq;
+			r_norm = static_cast<Ty>(std::sqrt(internal::fused_update(n, alpha, p, q, x, r)));
+			res._Iterations++;
+			res._Residual = r_norm / b_norm;
+			if (r_norm <= target) {
+				res._Converged = true;
+				break;
+			}
+			pre.apply(r, z);
+			const Ty rz_next = dot(n, r, z);
+			internal::xpby(n, z, rz_next / rz, p);
+			rz = rz_next;
+		}
+		return res;
+	}
+
+	template<linear_operator<Ty> Op>
+	solver_result<Ty> solve(const Op &op, const Ty *b, Ty *x) {
+		return solve(op, b, x, identity_preconditioner<Ty>(static_cast<size_t>(op.rows())));
+	}
+};
+// conjugate_gradient ENDS
+
+// bicgstab BEGINS
+// right-preconditioned BiCGSTAB (van der Vorst)
+template<typename Ty>
+    requires(std::is_floating_point_v<Ty>)
+class bicgstab {
+	aligned_buffer<Ty> _Work;  // r, r_hat, p, v, s, t, p_hat, s_hat
+	solver_options<Ty> _Options;
+
+public:
+	bicgstab() = default;
+
+	explicit bicgstab(solver_options<Ty> options)
+	    : _Options(options) {}
+
+	solver_options<Ty> &options() noexcept {
+		return _Options;
+	}
+
+	void reserve(size_t n) {
+		_Work.reserve(8 * n);
+	}
+
+	template<linear_operator<Ty> Op, preconditioner<Ty> Pre>
+	solver_result<Ty> solve(const Op &op, const Ty *b, Ty *x, const Pre &pre) {
+		NSTD_PROFILE_SCOPE("linalg::bicgstab::solve");
+		internal::check_square(op);
+		const size_t n = static_cast<size_t>(op.rows());
+		reserve(n);
+		Ty *r = _Work.data(), *r_hat = r + n, *p = r_hat + n, *v = p + n;
+		Ty *s = v + n, *t = s + n, *p_hat = t + n, *s_hat = p_hat + n;
+
+		solver_result<Ty> res;
+		const Ty b_norm = static_cast<Ty>(std::sqrt(dot(n, b, b)));
+		if (b_norm == Ty(0)) {
+			scal(n, Ty(0), x);
+			res._Converged = true;
+			return res;
+		}
+		const Ty target = _Options._Tolerance * b_norm;
+
+		Ty r_norm = internal::residual(op, b, x, r);
+		res._Residual = r_norm / b_norm;
+		if (r_norm <= target) {
+			res._Converged = true;
+			return res;
+		}
+		for (size_t i = 0; i < n; i++) {
+			r_hat[i] = r[i];
+			p[i] = Ty(0);
+			v[i] = Ty(0);
+		}
+		Ty rho = Ty(1), alpha = Ty(1), omega = Ty(1);
+
+		while (res._Iterations < _Options._MaxIterations) {
+			const Ty rho_next = dot(n, r_hat, r);
+			if (rho_next == Ty(0) || omega == Ty(0)) {
+				break;  // breakdown
+			}
+			const Ty beta = (rho_next / rho) * (alpha / omega);
+			rho = rho_next;
+			for (size_t i = 0; i < n; i++) {
+				p[i] = r[i] + beta * (p[i] - omega * v[i]);
+			}
+
+			pre.apply(p, p_hat);
+			apply(op, p_hat, v);
+			const Ty rv = dot(n, r_hat, v);
+			if (rv == Ty(0)) {
+				break;
+			}
+			alpha = rho / rv;
+			for (size_t i = 0; i < n; i++) {
+				s[i] = r[i] - alpha * v[i];
+			}
+			res._Iterations++;
+
+			const Ty s_norm = static_cast<Ty>(std::sqrt(dot(n, s, s)));
+			if (s_norm <= target) {
+				axpy(n, alpha, p_hat, x);
+				res._Residual = s_norm / b_norm;
+				res._Converged = true;
+				break;
+			}
+
+			pre.apply(s, s_hat);
+			apply(op, s_hat, t);
+			const Ty tt = dot(n, t, t);
+			omega = tt == Ty(0) ? Ty(0) : dot(n, t, s) / tt;
+			axpy(n, alpha, p_hat, x);
+			axpy(n, omega, s_hat, x);
+			for (size_t i = 0; i < n; i++) {
+				r[i] = s[i] - omega * t[i];
+			}
+			r_norm = static_cast<Ty>(std::sqrt(dot(n, r, r)));
+			res._Residual = r_norm / b_norm;
+			if (r_norm <= target) {
+				res._Converged = true;
+				break;
+			}
+		}
+		return res;
+	}
+
+	template<linear_operator<Ty> Op>
+	solver_result<Ty> solve(const Op &op, const Ty *b, Ty *x) {
+		return solve(op, b, x, identity_preconditioner<Ty>(static_cast<size_t>(op.rows())));
+	}
+};
+// bicgstab ENDS
+
+}  // namespace linalg
+
+}  // namespace nstd
@@ -0,0 +1,670 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+#include <util/nstd_thread_pool.h>
+#include <util/nstd_type_traits.h>
+
+// TODO: REMOVE these deps in future versions
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#	include <immintrin.h>
+#	define NSTD_SPARSE_AVX2 1
+#else
+#	define NSTD_SPARSE_AVX2 0
+#endif
+
+/*
+ * sparse matrices in coordinate (COO), compressed row (CSR) and compressed column (CSC) form
+ * 1. coo_matrix doubles as the triplet builder: push_back() in any order, duplicates are summed
+ *    when it is compressed (or by sum_duplicates())
+ * 2. compressing is a counting sort by the major index followed by a per-row sort (insertion sort for
+ *    short rows) and a merge pass; duplicates are summed in insertion order
+ * 3. compressed forms always keep the indices of a row (column) strictly increasing
+ * 4. Index is the storage type of both the indices and the row (column) pointers, nnz, rows and cols must fit in it
+ * 5. dense operands of spmv / spmm are raw pointers, dense column blocks are stored row-major
+ *    (one row of the block is contiguous)
+ */
+
+namespace nstd {
+
+namespace linalg {
+
+template<typename Ty, typename Index>
+    requires(std::is_integral_v<Index>)
+class coo_matrix;
+
+template<typename Ty, typename Index>
+    requires(std::is_integral_v<Index>)
+class csr_matrix;
+
+template<typename Ty, typename Index>
+    requires(std::is_integral_v<Index>)
+class csc_matrix;
+
+namespace internal {
+
+// every row and column index is stored as Index, so both dimensions must fit in it
+template<typename Index>
+void check_extents(size_t rows, size_t cols) {
+	constexpr size_t max = static_cast<size_t>(std::numeric_limits<Index>::max());
+	if (rows > max || cols > max) {
+		throw std::runtime_error("sparse index type too narrow!");
+	}
+}
+
+// a compressed sparse matrix seen from its major dimension (rows for CSR, columns for CSC)
+template<typename Ty, typename Index>
+struct compressed_storage {
+	size_t _Major = 0;
+	size_t _Minor = 0;
+	std::vector<Index> _Ptr;  // _Major + 1 entries
+	std::vector<Index> _Idx;
+	std::vector<Ty> _Val;
+
+	compressed_storage() = default;
+
+	compressed_storage(size_t major, size_t minor)
+	    : _Major(major), _Minor(minor) {
+		check_extents<Index>(major, minor);
+		_Ptr.assign(major + 1, Index(0));
+	}
+
+	size_t nnz() const noexcept {
+		return _Idx.size();
+	}
+
+	size_t begin(size_t i) const noexcept {
+		return static_cast<size_t>(_Ptr[i]);
+	}
+
+	size_t end(size_t i) const noexcept {
+		return static_cast<size_t>(_Ptr[i + 1]);
+	}
+
+	Ty coeff(size_t major, size_t minor) const {
+		const Index *first = _Idx.data() + begin(major);
+		const Index *last = _Idx.data() + end(major);
+		const Index *it = std::lower_bound(first, last, static_cast<Index>(minor));
+		return it != last && static_cast<size_t>(*it) == minor ? _Val[static_cast<size_t>(it - _Idx.data())] : Ty(0);
+	}
+
+	// the same entries seen from the other dimension, rows of the result stay sorted
+	// because entries are scattered in major order
+	compressed_storage flip() const {
+		compressed_storage res(_Minor, _Major);
+		res._Idx.resize(nnz());
+		res._Val.resize(nnz());
+		for (size_t k = 0; k < nnz(); k++) {
+			res._Ptr[static_cast<size_t>(_Idx[k]) + 1]++;
+		}
+		for (size_t i = 0; i < _Minor; i++) {
+			res._Ptr[i + 1] += res._Ptr[i];
+		}
+		std::vector<Index> cursor(res._Ptr.begin(), res._Ptr.end() - 1);
+		for (size_t i = 0; i < _Major; i++) {
+			for (size_t k = begin(i); k < end(i); k++) {
+				const size_t dst = static_cast<size_t>(cursor[static_cast<size_t>(_Idx[k])]++);
+				res._Idx[dst] = static_cast<Index>(i);
+				res._Val[dst] = _Val[k];
+			}
+		}
+		return res;
+	}
+
+	// throws unless pointers are monotonic and every row holds strictly increasing, in-range indices
+	void validate(const char *what) const {
+		check_extents<Index>(_Major, _Minor);
+		if (_Ptr.size() != _Major + 1 || _Ptr[0] != Index(0) || static_cast<size_t>(_Ptr[_Major]) != nnz() || _Val.size() != nnz()) {
+			throw std::runtime_error(what);
+		}
+		for (size_t i = 0; i < _Major; i++) {
+			if (_Ptr[i] > _Ptr[i + 1]) {
+				throw std::runtime_error(what);
+			}
+		}
+		for (size_t i = 0; i < _Major; i++) {
+			for (size_t k = begin(i); k < end(i); k++) {
+				if (_Idx[k] < Index(0) || static_cast<size_t>(_Idx[k]) >= _Minor || (k > begin(i) && _Idx[k - 1] >= _Idx[k])) {
+					throw std::runtime_error(what);
+				}
+			}
+		}
+	}
+};
+
+// sorts one row by index, rows are usually short enough for insertion sort
+template<typename Ty, typename Index>
+void sort_row(Index *idx, Ty *val, size_t n, std::vector<std::pair<Index, Ty>> &scratch) {
+	constexpr size_t insertion_limit = 32;
+	if (n <= insertion_limit) {
+		for (size_t k = 1; k < n; k++) {
+			const Index i = idx[k];
+			const Ty v = val[k];
+			size_t pos = k;
+			for (; pos > 0 && idx[pos - 1] > i; pos--) {
+				idx[pos] = idx[pos - 1];
+				val[pos] = val[pos - 1];
+			}
+			idx[pos] = i;
+			val[pos] = v;
+		}
+		return;
+	}
+	scratch.clear();
+	for (size_t k = 0; k < n; k++) {
+		scratch.emplace_back(idx[k], val[k]);
+	}
+	std::stable_sort(scratch.begin(), scratch.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+	for (size_t k = 0; k < n; k++) {
+		idx[k] = scratch[k].first;
+		val[k] = scratch[k].second;
+	}
+}
+
+// triplets to compressed form, see assumption 2
+template<typename Ty, typename Index>
+compressed_storage<Ty, Index> compress_triplets(const Index *major, const Index *minor, const Ty *val,
+                                                size_t n, size_t major_size, size_t minor_size) {
+	if (n > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+		throw std::runtime_error("sparse index type too narrow!");
+	}
+
+	// counting sort by the major index, straight into the output arrays
+	compressed_storage<Ty, Index> res(major_size, minor_size);
+	std::vector<size_t> cursor(major_size + 1, 0);
+	for (size_t k = 0; k < n; k++) {
+		cursor[static_cast<size_t>(major[k]) + 1]++;
+	}
+	for (size_t i = 0; i < major_size; i++) {
+		cursor[i + 1] += cursor[i];
+	}
+	res._Idx.resize(n);
+	res._Val.resize(n);
+	for (size_t k = 0; k < n; k++) {
+		const size_t dst = cursor[static_cast<size_t>(major[k])]++;
+		res._Idx[dst] = minor[k];
+		res._Val[dst] = val[k];
+	}
+
+	// sort every row and merge duplicates in place, cursor[i] is now the end of row i
+	std::vector<std::pair<Index, Ty>> scratch;
+	size_t out = 0, first = 0;
+	for (size_t i = 0; i < major_size; i++) {
+		const size_t last = cursor[i];
+		sort_row(res._Idx.data() + first, res._Val.data() + first, last - first, scratch);
+		const size_t row_begin = out;
+		for (size_t k = first; k < last; k++) {
+			if (out > row_begin && res._Idx[out - 1] == res._Idx[k]) {
+				res._Val[out - 1] += res._Val[k];
+			} else {
+				res._Idx[out] = res._Idx[k];
+				res._Val[out] = res._Val[k];
+				out++;
+			}
+		}
+		first = last;
+		res._Ptr[i + 1] = static_cast<Index>(out);
+	}
+	res._Idx.resize(out);
+	res._Val.resize(out);
+	return res;
+}
+
+// sum of val[k] * x[idx[k]] over [0, n)
+template<typename Ty, typename Index>
+inline Ty sparse_dot(const Ty *val, const Index *idx, size_t n, const Ty *x) noexcept {
+	size_t k = 0;
+#if NSTD_SPARSE_AVX2
+	if constexpr (std::is_same_v<Ty, float> && sizeof(Index) == 4) {
+		__m256 acc = _mm256_setzero_ps();
+		for (; k + 8 <= n; k += 8) {
+			const __m256i j = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx + k));
+			acc = _mm256_fmadd_ps(_mm256_loadu_ps(val + k), _mm256_i32gather_ps(x, j, 4), acc);
+		}
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+		Ty res = _mm_cvtss_f32(half);
+		for (; k < n; k++) {
+			res += val[k] * x[idx[k]];
+		}
+		return res;
+	} else if constexpr (std::is_same_v<Ty, double> && sizeof(Index) == 4) {
+		// the masked form with an explicit source, gcc 12 flags the undefined source of _mm256_i32gather_pd
+		const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		__m256d acc = _mm256_setzero_pd();
+		for (; k + 4 <= n; k += 4) {
+			const __m128i j = _mm_loadu_si128(reinterpret_cast<const __m128i *>(idx + k));
+			const __m256d g = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j, all, 8);
+			acc = _mm256_fmadd_pd(_mm256_loadu_pd(val + k), g, acc);
+		}
+		__m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+		Ty res = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+		for (; k < n; k++) {
+			res += val[k] * x[idx[k]];
+		}
+		return res;
+	}
+#endif
+	// four independent chains, the compiler may not reassociate a single floating-point sum
+	Ty s0(0), s1(0), s2(0), s3(0);
+	for (; k + 4 <= n; k += 4) {
+		s0 += val[k] * x[idx[k]];
+		s1 += val[k + 1] * x[idx[k + 1]];
+		s2 += val[k + 2] * x[idx[k + 2]];
+		s3 += val[k + 3] * x[idx[k + 3]];
+	}
+	for (; k < n; k++) {
+		s0 += val[k] * x[idx[k]];
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+// first major index whose (pointer + index) reaches target, balances work by nonzeros and rows alike
+template<typename Index>
+size_t balanced_split(const Index *ptr, size_t major, size_t target) noexcept {
+	size_t lo = 0, hi = major;
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		if (static_cast<size_t>(ptr[mid]) + mid < target) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// calls fn(first, last) over ranges of rows with roughly equal work, serially when the matrix is small
+template<typename Ty, typename Index, typename Fn>
+void for_each_row_block(const compressed_storage<Ty, Index> &a, thread_pool &pool, Fn &&fn) {
+	constexpr size_t serial_work = 1 << 15;
+	const size_t work = a.nnz() + a._Major;
+	if (work < serial_work || pool.size() == 1) {
+		fn(size_t(0), a._Major);
+		return;
+	}
+	const size_t blocks = std::min(pool.size() * 4, work / (serial_work / 4));
+	pool.run(blocks, [&](size_t b) {
+		const size_t first = balanced_split(a._Ptr.data(), a._Major, work * b / blocks);
+		const size_t last = balanced_split(a._Ptr.data(), a._Major, work * (b + 1) / blocks);
+		if (first < last) {
+			fn(first, last);
+		}
+	});
+}
+
+template<typename Ty, typename Index>
+void csr_spmv_rows(const compressed_storage<Ty, Index> &a, const Ty *x, Ty *y, size_t first, size_t last) noexcept {
+	for (size_t i = first; i < last; i++) {
+		const size_t k = a.begin(i);
+		y[i] = sparse_dot(a._Val.data() + k, a._Idx.data() + k, a.end(i) - k, x);
+	}
+}
+
+// c[i, first_col, first_col + Width) for rows [first, last), the panel accumulates in registers
+template<size_t Width, typename Ty, typename Index>
+void csr_spmm_panel(const compressed_storage<Ty, Index> &a, const Ty *b, size_t cols, Ty *c, size_t first, size_t last,
+                    size_t first_col) noexcept {
+	for (size_t i = first; i < last; i++) {
+		Ty acc[Width] = {};
+		for (size_t k = a.begin(i); k < a.end(i); k++) {
+			const Ty v = a._Val[k];
+			const Ty *b_row = b + static_cast<size_t>(a._Idx[k]) * cols + first_col;
+			for (size_t j = 0; j < Width; j++) {
+				acc[j] += v * b_row[j];
+			}
+		}
+		std::copy_n(acc, Width, c + i * cols + first_col);
+	}
+}
+
+template<typename Ty, typename Index>
+void csr_spmm_rows(const compressed_storage<Ty, Index> &a, const Ty *b, size_t cols, Ty *c, size_t first, size_t last) noexcept {
+	constexpr size_t panel = 32 / sizeof(Ty) < 4 ? 4 : 32 / sizeof(Ty);  // one 256-bit register
+	size_t j = 0;
+	for (; j + panel * 2 <= cols; j += panel * 2) {
+		csr_spmm_panel<panel * 2>(a, b, cols, c, first, last, j);
+	}
+	for (; j + panel <= cols; j += panel) {
+		csr_spmm_panel<panel>(a, b, cols, c, first, last, j);
+	}
+	for (; j < cols; j++) {
+		csr_spmm_panel<1>(a, b, cols, c, first, last, j);
+	}
+}
+
+}  // namespace internal
+
+// coo_matrix BEGINS
+template<typename Ty, typename Index = int>
+    requires(std::is_integral_v<Index>)
+class coo_matrix {
+	size_t _Rows = 0;
+	size_t _Cols = 0;
+	std::vector<Index> _Row;
+	std::vector<Index> _Col;
+	std::vector<Ty> _Val;
+
+public:
+	using value_type = Ty;
+	using index_type = Index;
+
+	coo_matrix() = default;
+
+	coo_matrix(size_t rows, size_t cols)
+	    : _Rows(rows), _Cols(cols) {
+		internal::check_extents<Index>(rows, cols);
+	}
+
+	size_t rows() const noexcept {
+		return _Rows;
+	}
+
+	size_t cols() const noexcept {
+		return _Cols;
+	}
+
+	// stored triplets, duplicates included
+	size_t nnz() const noexcept {
+		return _Val.size();
+	}
+
+	const Index *row_idx() const noexcept {
+		return _Row.data();
+	}
+
+	const Index *col_idx() const noexcept {
+		return _Col.data();
+	}
+
+	const Ty *values() const noexcept {
+		return _Val.data();
+	}
+
+	void reserve(size_t n) {
+		_Row.reserve(n);
+		_Col.reserve(n);
+		_Val.reserve(n);
+	}
+
+	void clear() noexcept {
+		_Row.clear();
+		_Col.clear();
+		_Val.clear();
+	}
+
+	void push_back(size_t row, size_t col, const Ty &val) {
+		if (row >= _Rows || col >= _Cols) {
+			throw std::runtime_error("coo_matrix out of bounds!");
+		}
+		_Row.push_back(static_cast<Index>(row));
+		_Col.push_back(static_cast<Index>(col));
+		_Val.push_back(val);
+	}
+
+	// sorts the triplets row-major and sums duplicates
+	void sum_duplicates() {
+		*this = to_csr().to_coo();
+	}
+
+	csr_matrix<Ty, Index> to_csr() const {
+		return csr_matrix<Ty, Index>(internal::compress_triplets(_Row.data(), _Col.data(), _Val.data(), nnz(), _Rows, _Cols));
+	}
+
+	csc_matrix<Ty, Index> to_csc() const {
+		return csc_matrix<Ty, Index>(internal::compress_triplets(_Col.data(), _Row.data(), _Val.data(), nnz(), _Cols, _Rows));
+	}
+};
+// coo_matrix ENDS
+
+// csr_matrix BEGINS
+template<typename Ty, typename Index = int>
+    requires(std::is_integral_v<Index>)
+class csr_matrix {
+	using storage_type = internal::compressed_storage<Ty, Index>;
+
+	storage_type _Storage;
+
+	template<typename _Ty, typename _Index>
+	    requires(std::is_integral_v<_Index>)
+	friend class coo_matrix;
+
+	template<typename _Ty, typename _Index>
+	    requires(std::is_integral_v<_Index>)
+	friend class csc_matrix;
+
+	explicit csr_matrix(storage_type &&storage) noexcept
+	    : _Storage(static_cast<storage_type &&>(storage)) {}
+
+public:
+	using value_type = Ty;
+	using index_type = Index;
+
+	csr_matrix() = default;
+
+	// all-zero rows x cols matrix
+	csr_matrix(size_t rows, size_t cols)
+	    : _Storage(rows, cols) {}
+
+	// adopts existing CSR arrays, throws if they are malformed
+	csr_matrix(size_t rows, size_t cols, std::vector<Index> row_ptr, std::vector<Index> col_idx, std::vector<Ty> values) {
+		_Storage._Major = rows;
+		_Storage._Minor = cols;
+		_Storage._Ptr = static_cast<std::vector<Index> &&>(row_ptr);
+		_Storage._Idx = static_cast<std::vector<Index> &&>(col_idx);
+		_Storage._Val = static_cast<std::vector<Ty> &&>(values);
+		_Storage.validate("csr_matrix malformed!");
+	}
+
+	size_t rows() const noexcept {
+		return _Storage._Major;
+	}
+
+	size_t cols() const noexcept {
+		return _Storage._Minor;
+	}
+
+	size_t nnz() const noexcept {
+		return _Storage.nnz();
+	}
+
+	const Index *row_ptr() const noexcept {
+		return _Storage._Ptr.data();
+	}
+
+	const Index *col_idx() const noexcept {
+		return _Storage._Idx.data();
+	}
+
+	const Ty *values() const noexcept {
+		return _Storage._Val.data();
+	}
+
+	// structure stays fixed, values may be updated in place
+	Ty *values() noexcept {
+		return _Storage._Val.data();
+	}
+
+	Ty coeff(size_t row, size_t col) const {
+		if (row >= rows() || col >= cols()) {
+			throw std::runtime_error("csr_matrix out of bounds!");
+		}
+		return _Storage.coeff(row, col);
+	}
+
+	csc_matrix<Ty, Index> to_csc() const {
+		return csc_matrix<Ty, Index>(_Storage.flip());
+	}
+
+	coo_matrix<Ty, Index> to_coo() const {
+		coo_matrix<Ty, Index> res(rows(), cols());
+		res.reserve(nnz());
+		for (size_t i = 0; i < rows(); i++) {
+			for (size_t k = _Storage.begin(i); k < _Storage.end(i); k++) {
+				res.push_back(i, static_cast<size_t>(_Storage._Idx[k]), _Storage._Val[k]);
+			}
+		}
+		return res;
+	}
+
+	csr_matrix transpose() const {
+		return csr_matrix(_Storage.flip());
+	}
+
+	const storage_type &storage() const noexcept {
+		return _Storage;
+	}
+};
+// csr_matrix ENDS
+
+// csc_matrix BEGINS
+template<typename Ty, typename Index = int>
+    requires(std::is_integral_v<Index>)
+class csc_matrix {
+	using storage_type = internal::compressed_storage<Ty, Index>;
+
+	storage_type _Storage;
+
+	template<typename _Ty, typename _Index>
+	    requires(std::is_integral_v<_Index>)
+	friend class coo_matrix;
+
+	template<typename _Ty, typename _Index>
+	    requires(std::is_integral_v<_Index>)
+	friend class csr_matrix;
+
+	explicit csc_matrix(storage_type &&storage) noexcept
+	    : _Storage(static_cast<storage_type &&>(storage)) {}
+
+public:
+	using value_type = Ty;
+	using index_type = Index;
+
+	csc_matrix() = default;
+
+	csc_matrix(size_t rows, size_t cols)
+	    : _Storage(cols, rows) {}
+
+	csc_matrix(size_t rows, size_t cols, std::vector<Index> col_ptr, std::vector<Index> row_idx, std::vector<Ty> values) {
+		_Storage._Major = cols;
+		_Storage._Minor = rows;
+		_Storage._Ptr = static_cast<std::vector<Index> &&>(col_ptr);
+		_Storage._Idx = static_cast<std::vector<Index> &&>(row_idx);
+		_Storage._Val = static_cast<std::vector<Ty> &&>(values);
+		_Storage.validate("csc_matrix malformed!");
+	}
+
+	size_t rows() const noexcept {
+		return _Storage._Minor;
+	}
+
+	size_t cols() const noexcept {
+		return _Storage._Major;
+	}
+
+	size_t nnz() const noexcept {
+		return _Storage.nnz();
+	}
+
+	const Index *col_ptr() const noexcept {
+		return _Storage._Ptr.data();
+	}
+
+	const Index *row_idx() const noexcept {
+		return _Storage._Idx.data();
+	}
+
+	const Ty *values() const noexcept {
+		return _Storage._Val.data();
+	}
+
+	Ty *values() noexcept {
+		return _Storage._Val.data();
+	}
+
+	Ty coeff(size_t row, size_t col) const {
+		if (row >= rows() || col >= cols()) {
+			throw std::runtime_error("csc_matrix out of bounds!");
+		}
+		return _Storage.coeff(col, row);
+	}
+
+	csr_matrix<Ty, Index> to_csr() const {
+		return csr_matrix<Ty, Index>(_Storage.flip());
+	}
+
+	coo_matrix<Ty, Index> to_coo() const {
+		return to_csr().to_coo();
+	}
+
+	csc_matrix transpose() const {
+		return csc_matrix(_Storage.flip());
+	}
+
+	const storage_type &storage() const noexcept {
+		return _Storage;
+	}
+};
+// csc_matrix ENDS
+
+// spmv BEGINS
+// y = a * x, y must not alias x
+template<typename Ty, typename Index>
+void spmv(const csr_matrix<Ty, Index> &a, const Ty *x, Ty *y) noexcept {
+	internal::csr_spmv_rows(a.storage(), x, y, 0, a.rows());
+}
+
+// rows are split into blocks of similar nonzero count, every block writes a disjoint slice of y
+template<typename Ty, typename Index>
+void spmv(const csr_matrix<Ty, Index> &a, const Ty *x, Ty *y, thread_pool &pool) {
+	internal::for_each_row_block(a.storage(), pool, [&](size_t first, size_t last) {
+		internal::csr_spmv_rows(a.storage(), x, y, first, last);
+	});
+}
+
+// column-wise scatter, prefer CSR when the same matrix is applied many times
+template<typename Ty, typename Index>
+void spmv(const csc_matrix<Ty, Index> &a, const Ty *x, Ty *y) noexcept {
+	const auto &s = a.storage();
+	std::fill_n(y, a.rows(), Ty(0));
+	for (size_t j = 0; j < a.cols(); j++) {
+		const Ty xj = x[j];
+		for (size_t k = s.begin(j); k < s.end(j); k++) {
+			y[static_cast<size_t>(s._Idx[k])] += s._Val[k] * xj;
+		}
+	}
+}
+// spmv ENDS
+
+// spmm BEGINS
+// c = a * b, b is a row-major a.cols() x cols block and c a a.rows() x cols block
+template<typename Ty, typename Index>
+void spmm(const csr_matrix<Ty, Index> &a, const Ty *b, size_t cols, Ty *c) noexcept {
+	internal::csr_spmm_rows(a.storage(), b, cols, c, 0, a.rows());
+}
+
+template<typename Ty, typename Index>
+void spmm(const csr_matrix<Ty, Index> &a, const Ty *b, size_t cols, Ty *c, thread_pool &pool) {
+	internal::for_each_row_block(a.storage(), pool, [&](size_t first, size_t last) {
+		internal::csr_spmm_rows(a.storage(), b, cols, c, first, last);
+	});
+}
+// spmm ENDS
+
+using coo_matrixf = coo_matrix<float>;
+using coo_matrixd = coo_matrix<double>;
+using csr_matrixf = csr_matrix<float>;
+using csr_matrixd = csr_matrix<double>;
+using csc_matrixf = csc_matrix<float>;
+using csc_matrixd = csc_matrix<double>;
+
+}  // namespace linalg
+
+}  // namespace nstd
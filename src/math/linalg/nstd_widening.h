@@ -0,0 +1,253 @@
+#pragma once
+
+#include <math/nstd_fixed.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * int8 / int16 dot products and matrix products with int32 results, the kernels of quantized inference
+ * 1. inputs are multiplied in pairs along k and summed into int32 lanes (pmaddwd / vpdpwssd, see simd_i16);
+ *    int8 inputs are sign-extended to int16 on load / while packing
+ * 2. saturate == false accumulates in int32 and wraps on overflow, like the instructions: exact while every partial sum
+ *    fits, which int8 inputs guarantee for k < 2^17
+ * 3. saturate == true accumulates the pair sums in int64 and clamps the finished result into int32
+ * 4. widening_gemm overwrites c (m x n) with a (m x k) * b (k x n), operands row-major with leading dimensions;
+ *    it packs a into pairs (widening_pack_a_size int32) and one column panel of b (widening_pack_b_size int16)
+ * ! assumptions !
+ * 1. no int16 pair of inputs multiplies -32768 by -32768 twice (symmetric quantization stays within [-32767, 32767])
+ */
+
+namespace nstd {
+
+namespace linalg {
+
+template<typename Ty>
+concept widening_input = std::is_same_v<Ty, std::int8_t> || std::is_same_v<Ty, std::int16_t>;
+
+template<typename Vec = nstd::internal::simd_i16>
+struct widening_blocking {
+	static constexpr size_t width = Vec::width;
+	static constexpr size_t nv = width == 1 ? 4 : 2;  // registers of b per row
+	static constexpr size_t nr = nv * width;          // columns of a b panel
+	static constexpr size_t mr = 6;                   // rows sharing every load of b
+	static constexpr size_t mr_wide = 3;              // the same with two int64 accumulators per register
+};
+
+inline constexpr size_t widening_pack_a_size(size_t m, size_t k, size_t mr) noexcept {
+	return (m + mr - 1) / mr * mr * ((k + 1) / 2);
+}
+
+inline constexpr size_t widening_pack_b_size(size_t k, size_t nr) noexcept {
+	return (k + 1) / 2 * 2 * nr;
+}
+
+namespace internal {
+
+template<typename Vec, typename Ty>
+typename Vec::reg widening_load(const Ty *ptr) noexcept {
+	if constexpr (std::is_same_v<Ty, std::int8_t>) {
+		return Vec::load_i8(ptr);
+	} else {
+		return Vec::load(ptr);
+	}
+}
+
+// rows of a in blocks of mr, each block k-pair by k-pair: dst[(block * kp + p) * mr + r] = (a[r][2p], a[r][2p + 1])
+template<typename Ty, typename Vec>
+void widening_pack_a(const Ty *a, size_t lda, size_t m, size_t k, size_t mr, std::int32_t *dst) noexcept {
+	using vec = Vec;
+	const size_t kp = (k + 1) / 2;
+	for (size_t i0 = 0; i0 < m; i0 += mr) {
+		for (size_t p = 0; p < kp; p++) {
+			for (size_t r = 0; r < mr; r++) {
+				const bool valid = i0 + r < m;
+				const Ty *row = valid ? a + (i0 + r) * lda : a;
+				const std::int16_t lo = valid ? row[2 * p] : 0;
+				const std::int16_t hi = valid && 2 * p + 1 < k ? row[2 * p + 1] : 0;
+				dst[r] = vec::pair(lo, hi);
+			}
+			dst += mr;
+		}
+	}
+}
+
+// columns [0, cols) of b as one panel of nr columns, k-pair by k-pair: (b[2p][j], b[2p + 1][j]) side by side
+template<typename Ty, typename Vec>
+void widening_pack_b(const Ty *b, size_t ldb, size_t k, size_t cols, std::int16_t *dst) noexcept {
+	constexpr size_t nr = widening_blocking<Vec>::nr;
+	for (size_t p = 0; p < k; p += 2) {
+		const Ty *r0 = b + p * ldb;
+		const Ty *r1 = p + 1 < k ? r0 + ldb : nullptr;
+		for (size_t j = 0; j < nr; j++) {
+			dst[2 * j] = j < cols ? r0[j] : 0;
+			dst[2 * j + 1] = j < cols && r1 != nullptr ? r1[j] : 0;
+		}
+		dst += 2 * nr;
+	}
+}
+
+// c (m x n corner of an mr x nr tile) = packed a block * packed b panel, over kp pairs
+template<typename Vec, size_t MR>
+void widening_micro_kernel(size_t kp, const std::int32_t *__restrict a, const std::int16_t *__restrict b, std::int32_t *c,
+                           size_t ldc, size_t m, size_t n) noexcept {
+	using vec = Vec;
+	using nstd::internal::static_for;
+	using reg = typename vec::reg;
+	constexpr size_t nv = widening_blocking<Vec>::nv;
+	constexpr size_t nr = widening_blocking<Vec>::nr;
+
+	reg acc[MR][nv];
+	static_for<MR>([&](auto i) {
+		static_for<nv>([&](auto v) { acc[i][v] = vec::zero(); });
+	});
+	for (size_t p = 0; p < kp; p++) {
+		reg bv[nv];
+		static_for<nv>([&](auto v) { bv[v] = vec::load(b + 2 * v * vec::width); });
+		static_for<MR>([&](auto i) {
+			const reg ai = vec::set1(a[i]);
+			static_for<nv>([&](auto v) { acc[i][v] = vec::madd(ai, bv[v], acc[i][v]); });
+		});
+		a += MR;
+		b += 2 * nr;
+	}
+
+	if (m == MR && n == nr) {
+		for (size_t i = 0; i < MR; i++) {
+			for (size_t v = 0; v < nv; v++) {
+				vec::store(c + i * ldc + v * vec::width, acc[i][v]);
+			}
+		}
+		return;
+	}
+	std::int32_t tile[MR][nr];  // edge tile, spill and copy the valid corner
+	for (size_t i = 0; i < MR; i++) {
+		for (size_t v = 0; v < nv; v++) {
+			vec::store(tile[i] + v * vec::width, acc[i][v]);
+		}
+	}
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			c[i * ldc + j] = tile[i][j];
+		}
+	}
+}
+
+// the saturating form: int64 accumulators, clamped into c
+template<typename Vec, size_t MR>
+void widening_micro_kernel_sat(size_t kp, const std::int32_t *__restrict a, const std::int16_t *__restrict b, std::int32_t *c,
+                               size_t ldc, size_t m, size_t n) noexcept {
+	using vec = Vec;
+	using nstd::internal::static_for;
+	using reg = typename vec::reg;
+	using wide = typename vec::wide;
+	constexpr size_t nv = widening_blocking<Vec>::nv;
+	constexpr size_t nr = widening_blocking<Vec>::nr;
+
+	wide lo[MR][nv], hi[MR][nv];
+	static_for<MR>([&](auto i) {
+		static_for<nv>([&](auto v) {
+			lo[i][v] = vec::zero_wide();
+			hi[i][v] = vec::zero_wide();
+		});
+	});
+	for (size_t p = 0; p < kp; p++) {
+		reg bv[nv];
+		static_for<nv>([&](auto v) { bv[v] = vec::load(b + 2 * v * vec::width); });
+		static_for<MR>([&](auto i) {
+			const reg ai = vec::set1(a[i]);
+			static_for<nv>([&](auto v) { vec::madd_wide(ai, bv[v], lo[i][v], hi[i][v]); });
+		});
+		a += MR;
+		b += 2 * nr;
+	}
+
+	long long tile[MR][nr];
+	for (size_t i = 0; i < MR; i++) {
+		for (size_t v = 0; v < nv; v++) {
+			vec::store_wide(tile[i] + v * vec::width, lo[i][v], hi[i][v]);
+		}
+	}
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			c[i * ldc + j] = saturate_cast<std::int32_t>(tile[i][j]);
+		}
+	}
+}
+
+}  // namespace internal
+
+// sum of x[i] * y[i] over [0, n) in int32
+template<typename Ty, typename Vec = nstd::internal::simd_i16>
+    requires widening_input<Ty>
+std::int32_t widening_dot(size_t n, const Ty *x, const Ty *y, bool saturate) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	constexpr size_t step = 2 * vec::width;  // inputs per register
+	size_t i = 0;
+	if (!saturate) {
+		reg acc[2] = { vec::zero(), vec::zero() };
+		for (; i + 2 * step <= n; i += 2 * step) {
+			acc[0] = vec::madd(internal::widening_load<Vec>(x + i), internal::widening_load<Vec>(y + i), acc[0]);
+			acc[1] = vec::madd(internal::widening_load<Vec>(x + i + step), internal::widening_load<Vec>(y + i + step), acc[1]);
+		}
+		for (; i + step <= n; i += step) {
+			acc[0] = vec::madd(internal::widening_load<Vec>(x + i), internal::widening_load<Vec>(y + i), acc[0]);
+		}
+		std::uint32_t res = static_cast<std::uint32_t>(vec::hsum(vec::add(acc[0], acc[1])));
+		for (; i < n; i++) {
+			res += static_cast<std::uint32_t>(std::int32_t(x[i]) * std::int32_t(y[i]));
+		}
+		return static_cast<std::int32_t>(res);
+	}
+
+	typename vec::wide lo = vec::zero_wide(), hi = vec::zero_wide();
+	for (; i + step <= n; i += step) {
+		vec::madd_wide(internal::widening_load<Vec>(x + i), internal::widening_load<Vec>(y + i), lo, hi);
+	}
+	long long lanes[vec::width];
+	vec::store_wide(lanes, lo, hi);
+	long long res = 0;
+	for (size_t l = 0; l < vec::width; l++) {
+		res += lanes[l];
+	}
+	for (; i < n; i++) {
+		res += std::int32_t(x[i]) * std::int32_t(y[i]);
+	}
+	return saturate_cast<std::int32_t>(res);
+}
+
+// c (m x n) = a (m x k) * b (k x n), on caller-provided packing buffers (see the top of this file)
+template<typename Ty, typename Vec = nstd::internal::simd_i16>
+    requires widening_input<Ty>
+void widening_gemm(size_t m, size_t n, size_t k, const Ty *a, size_t lda, const Ty *b, size_t ldb, std::int32_t *c, size_t ldc,
+                   bool saturate, std::int32_t *pack_a, std::int16_t *pack_b) noexcept {
+	using blocking = widening_blocking<Vec>;
+	if (m == 0 || n == 0) {
+		return;
+	}
+	const size_t kp = (k + 1) / 2;
+	const size_t mr = saturate ? blocking::mr_wide : blocking::mr;
+	internal::widening_pack_a<Ty, Vec>(a, lda, m, k, mr, pack_a);
+	for (size_t j0 = 0; j0 < n; j0 += blocking::nr) {
+		const size_t cols = n - j0 < blocking::nr ? n - j0 : blocking::nr;
+		internal::widening_pack_b<Ty, Vec>(b + j0, ldb, k, cols, pack_b);
+		for (size_t i0 = 0; i0 < m; i0 += mr) {
+			const size_t rows = m - i0 < mr ? m - i0 : mr;
+			const std::int32_t *a_block = pack_a + i0 * kp;
+			if (saturate) {
+				internal::widening_micro_kernel_sat<Vec, blocking::mr_wide>(kp, a_block, pack_b, c + i0 * ldc + j0, ldc, rows, cols);
+			} else {
+				internal::widening_micro_kernel<Vec, blocking::mr>(kp, a_block, pack_b, c + i0 * ldc + j0, ldc, rows, cols);
+			}
+		}
+	}
+}
+
+}  // namespace linalg
+
+}  // namespace nstd
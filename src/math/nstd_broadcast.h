@@ -0,0 +1,432 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <type_traits>
+#include <utility>
+
+/*
+ * elementwise arithmetic over fixed-shape basic_ndarrays with numpy broadcasting: eval((x - row_mean) / col_scale)
+ * 1. + - * / and the comparisons take two ndarrays, an ndarray and a scalar, or expressions built from them;
+ *    shapes are aligned on the right and each pair of extents must be equal or one of them 1, checked at compile time
+ * 2. an expression is a lazy tree of references, nothing is computed until it is assigned:
+ *    eval(expr) returns a new ndarray, assign(out, expr) overwrites an ndarray the expression broadcasts to
+ * 3. assignment is one pass over the output, row by row; a broadcast extent is read with stride 0, so expanded operands
+ *    are never materialized, and rows of float / double built from + - * / run on simd registers
+ * 4. a scalar takes the element type of the array it meets unless that would drop its kind (bool < integer < floating),
+ *    two arrays combine by the usual arithmetic conversions, comparisons yield bool
+ * ! expressions reference their operands: build and consume them in one statement, don't keep them in auto variables !
+ * ! out may appear in its own expression only with the full output shape, a broadcast read would see rows already written !
+ */
+
+namespace nstd {
+
+namespace internal {
+
+// a compile-time shape, rank 0 for scalars
+template<size_t... DimSize>
+struct broadcast_shape {
+	static constexpr size_t rank = sizeof...(DimSize);
+	static constexpr size_t dims[rank + 1] = { DimSize..., 1 };
+};
+
+template<size_t Rank>
+struct broadcast_extents {
+	static constexpr size_t rank = Rank;
+	size_t _Extents[Rank + 1]{};
+	bool _Compatible = true;
+};
+
+template<typename Lhs, typename Rhs>
+consteval auto resolve_broadcast() {
+	constexpr size_t rank = Lhs::rank > Rhs::rank ? Lhs::rank : Rhs::rank;
+	broadcast_extents<rank> res;
+	for (size_t d = 0; d < rank; d++) {
+		// aligned on the right, a missing leading extent is 1
+		const size_t lhs = d + Lhs::rank >= rank ? Lhs::dims[d + Lhs::rank - rank] : 1;
+		const size_t rhs = d + Rhs::rank >= rank ? Rhs::dims[d + Rhs::rank - rank] : 1;
+		res._Compatible = res._Compatible && (lhs == rhs || lhs == 1 || rhs == 1);
+		res._Extents[d] = lhs == 1 ? rhs : lhs;
+	}
+	return res;
+}
+
+template<auto Resolved, size_t... I>
+broadcast_shape<Resolved._Extents[I]...> make_broadcast_shape(std::index_sequence<I...>);
+
+template<typename Lhs, typename Rhs>
+struct broadcast_result {
+	static constexpr auto resolved = resolve_broadcast<Lhs, Rhs>();
+	static constexpr bool compatible = resolved._Compatible;
+	using type = decltype(make_broadcast_shape<resolved>(std::make_index_sequence<resolved.rank>{}));
+};
+
+// the ndarray a shape evaluates into
+template<typename Ty, typename Shape>
+struct broadcast_ndarray;
+
+template<typename Ty, size_t... DimSize>
+struct broadcast_ndarray<Ty, broadcast_shape<DimSize...>> {
+	using type = basic_ndarray<Ty, false, DimSize...>;
+};
+
+// broadcast_ops BEGINS
+/*
+ * apply: one element, apply_simd: one register (only when vectorizable)
+ */
+#define NSTD_BROADCAST_ARITHMETIC(name, op, simd_fn)                                    \
+	struct name {                                                                       \
+		static constexpr bool vectorizable = true;                                      \
+		template<typename Lhs, typename Rhs>                                            \
+		static constexpr auto apply(const Lhs &lhs, const Rhs &rhs) noexcept {          \
+			return lhs op rhs;                                                          \
+		}                                                                               \
+		template<typename Vec>                                                          \
+		static auto apply_simd(typename Vec::reg lhs, typename Vec::reg rhs) noexcept { \
+			return Vec::simd_fn(lhs, rhs);                                              \
+		}                                                                               \
+	};
+
+#define NSTD_BROADCAST_COMPARISON(name, op)                                             \
+	struct name {                                                                       \
+		static constexpr bool vectorizable = false;                                     \
+		template<typename Lhs, typename Rhs>                                            \
+		static constexpr bool apply(const Lhs &lhs, const Rhs &rhs) noexcept {          \
+			return lhs op rhs;                                                          \
+		}                                                                               \
+	};
+
+NSTD_BROADCAST_ARITHMETIC(broadcast_add, +, add)
+NSTD_BROADCAST_ARITHMETIC(broadcast_sub, -, sub)
+NSTD_BROADCAST_ARITHMETIC(broadcast_mul, *, mul)
+NSTD_BROADCAST_ARITHMETIC(broadcast_div, /, div)
+NSTD_BROADCAST_COMPARISON(broadcast_eq, ==)
+NSTD_BROADCAST_COMPARISON(broadcast_ne, !=)
+NSTD_BROADCAST_COMPARISON(broadcast_lt, <)
+NSTD_BROADCAST_COMPARISON(broadcast_le, <=)
+NSTD_BROADCAST_COMPARISON(broadcast_gt, >)
+NSTD_BROADCAST_COMPARISON(broadcast_ge, >=)
+
+#undef NSTD_BROADCAST_ARITHMETIC
+#undef NSTD_BROADCAST_COMPARISON
+// broadcast_ops ENDS
+
+// broadcast_nodes BEGINS
+/*
+ * every node has value_type, shape, vectorizable<Ty> and row<Rank>(idx): idx is the output coordinate of a row
+ * (Rank entries, the last one unused) and row() returns a cursor with get(j) and load<Vec>(j) over that row
+ */
+
+// a row of an array operand, Contiguous == false when the operand's last extent is broadcast
+template<typename Ty, bool Contiguous>
+struct broadcast_array_row {
+	const Ty *_Ptr;
+
+	constexpr Ty get(size_t j) const noexcept {
+		if constexpr (Contiguous) {
+			return _Ptr[j];
+		} else {
+			return *_Ptr;
+		}
+	}
+
+	template<typename Vec>
+	typename Vec::reg load(size_t j) const noexcept {
+		if constexpr (Contiguous) {
+			return Vec::load(_Ptr + j);
+		} else {
+			return Vec::set1(*_Ptr);
+		}
+	}
+};
+
+template<typename Ty, size_t... DimSize>
+struct broadcast_array {
+	using value_type = Ty;
+	using shape = broadcast_shape<DimSize...>;
+
+	template<typename Vt>
+	static constexpr bool vectorizable = std::is_same_v<Ty, Vt>;
+
+	const Ty *_Data;
+
+	template<size_t Rank>
+	constexpr auto row(const size_t *idx) const noexcept {
+		constexpr size_t rank = sizeof...(DimSize);
+		constexpr size_t dims[] = { DimSize... };
+		// a broadcast extent contributes nothing to the offset: stride 0
+		size_t offset = 0, stride = dims[rank - 1];
+		for (size_t d = rank - 1; d-- > 0;) {
+			if (dims[d] != 1) {
+				offset += idx[Rank - rank + d] * stride;
+			}
+			stride *= dims[d];
+		}
+		return broadcast_array_row<Ty, (dims[rank - 1] != 1)>{ _Data + offset };
+	}
+};
+
+// a scalar operand, its own row cursor
+template<typename Ty>
+struct broadcast_scalar {
+	using value_type = Ty;
+	using shape = broadcast_shape<>;
+
+	template<typename Vt>
+	static constexpr bool vectorizable = std::is_same_v<Ty, Vt>;
+
+	Ty _Value;
+
+	template<size_t Rank>
+	constexpr broadcast_scalar row(const size_t *) const noexcept {
+		return *this;
+	}
+
+	constexpr Ty get(size_t) const noexcept {
+		return _Value;
+	}
+
+	template<typename Vec>
+	typename Vec::reg load(size_t) const noexcept {
+		return Vec::set1(_Value);
+	}
+};
+
+template<typename Op, typename Lhs, typename Rhs>
+struct broadcast_expr_row {
+	Lhs _Lhs;
+	Rhs _Rhs;
+
+	constexpr auto get(size_t j) const noexcept {
+		return Op::apply(_Lhs.get(j), _Rhs.get(j));
+	}
+
+	template<typename Vec>
+	typename Vec::reg load(size_t j) const noexcept {
+		return Op::template apply_simd<Vec>(_Lhs.template load<Vec>(j), _Rhs.template load<Vec>(j));
+	}
+};
+// broadcast_nodes ENDS
+
+}  // namespace internal
+
+// a lazy elementwise expression, see the top of this file
+template<typename Op, typename Lhs, typename Rhs>
+struct broadcast_expr {
+	using value_type = decltype(Op::apply(std::declval<typename Lhs::value_type>(), std::declval<typename Rhs::value_type>()));
+	using shape = typename internal::broadcast_result<typename Lhs::shape, typename Rhs::shape>::type;
+
+	static_assert(internal::broadcast_result<typename Lhs::shape, typename Rhs::shape>::compatible,
+	    "operand shapes do not broadcast!");
+
+	template<typename Vt>
+	static constexpr bool vectorizable = Op::vectorizable && std::is_same_v<value_type, Vt>
+	    && Lhs::template vectorizable<Vt> && Rhs::template vectorizable<Vt>;
+
+	Lhs _Lhs;
+	Rhs _Rhs;
+
+	template<size_t Rank>
+	constexpr auto row(const size_t *idx) const noexcept {
+		using lhs_row = decltype(_Lhs.template row<Rank>(idx));
+		using rhs_row = decltype(_Rhs.template row<Rank>(idx));
+		return internal::broadcast_expr_row<Op, lhs_row, rhs_row>{ _Lhs.template row<Rank>(idx),
+			_Rhs.template row<Rank>(idx) };
+	}
+};
+
+namespace internal {
+
+template<typename Ty>
+struct is_broadcast_operand : std::false_type {};
+
+template<typename Ty, bool exception, size_t... DimSize>
+struct is_broadcast_operand<basic_ndarray<Ty, exception, DimSize...>> : std::true_type {};
+
+template<typename Op, typename Lhs, typename Rhs>
+struct is_broadcast_operand<broadcast_expr<Op, Lhs, Rhs>> : std::true_type {};
+
+template<typename Ty>
+concept broadcast_operand = is_broadcast_operand<std::remove_cvref_t<Ty>>::value;
+
+template<typename Ty>
+concept broadcast_arithmetic = std::is_arithmetic_v<std::remove_cvref_t<Ty>>;
+
+// at least one array side, the other an array or a scalar
+template<typename Lhs, typename Rhs>
+concept broadcast_operands = (broadcast_operand<Lhs> && (broadcast_operand<Rhs> || broadcast_arithmetic<Rhs>))
+    || (broadcast_arithmetic<Lhs> && broadcast_operand<Rhs>);
+
+template<typename Ty>
+constexpr int broadcast_kind = std::is_same_v<Ty, bool> ? 0 : std::is_integral_v<Ty> ? 1 : 2;
+
+// the type a scalar operand takes next to elements of type Elem
+template<typename Elem, typename Scalar>
+using broadcast_scalar_t = std::conditional_t<(broadcast_kind<Scalar> > broadcast_kind<Elem>),
+    std::common_type_t<Elem, Scalar>, Elem>;
+
+template<typename Ty, bool exception, size_t... DimSize>
+constexpr broadcast_array<Ty, DimSize...> as_broadcast(const basic_ndarray<Ty, exception, DimSize...> &arr) noexcept {
+	return { arr.data() };
+}
+
+template<typename Op, typename Lhs, typename Rhs>
+constexpr const broadcast_expr<Op, Lhs, Rhs> &as_broadcast(const broadcast_expr<Op, Lhs, Rhs> &expr) noexcept {
+	return expr;
+}
+
+template<typename Op, typename Lhs, typename Rhs>
+constexpr auto make_broadcast_expr(const Lhs &lhs, const Rhs &rhs) noexcept {
+	if constexpr (!broadcast_operand<Lhs>) {
+		using rhs_node = std::remove_cvref_t<decltype(as_broadcast(rhs))>;
+		using scalar = broadcast_scalar<broadcast_scalar_t<typename rhs_node::value_type, Lhs>>;
+		return broadcast_expr<Op, scalar, rhs_node>{ scalar{ static_cast<typename scalar::value_type>(lhs) },
+			as_broadcast(rhs) };
+	} else if constexpr (!broadcast_operand<Rhs>) {
+		using lhs_node = std::remove_cvref_t<decltype(as_broadcast(lhs))>;
+		using scalar = broadcast_scalar<broadcast_scalar_t<typename lhs_node::value_type, Rhs>>;
+		return broadcast_expr<Op, lhs_node, scalar>{ as_broadcast(lhs),
+			scalar{ static_cast<typename scalar::value_type>(rhs) } };
+	} else {
+		using lhs_node = std::remove_cvref_t<decltype(as_broadcast(lhs))>;
+		using rhs_node = std::remove_cvref_t<decltype(as_broadcast(rhs))>;
+		return broadcast_expr<Op, lhs_node, rhs_node>{ as_broadcast(lhs), as_broadcast(rhs) };
+	}
+}
+
+// one output row of Cols elements
+template<typename Ty, size_t Cols, bool Vectorize, typename Row>
+inline void broadcast_assign_row(Ty *dst, const Row &row) noexcept {
+	if constexpr (Vectorize && simd<Ty>::width > 1) {
+		using Vec = simd<Ty>;
+		constexpr size_t body = Cols - Cols % Vec::width;
+		for (size_t j = 0; j < body; j += Vec::width) {
+			Vec::store(dst + j, row.template load<Vec>(j));
+		}
+		if constexpr (body < Cols) {
+			for (size_t j = body; j < Cols; j++) {
+				dst[j] = row.get(j);
+			}
+		}
+	} else {
+		for (size_t j = 0; j < Cols; j++) {
+			dst[j] = static_cast<Ty>(row.get(j));
+		}
+	}
+}
+
+}  // namespace internal
+
+// broadcast_operators BEGINS
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator+(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_add>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator-(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_sub>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator*(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_mul>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator/(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_div>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator==(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_eq>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator!=(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_ne>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator<(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_lt>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator<=(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_le>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator>(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_gt>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+    requires internal::broadcast_operands<Lhs, Rhs>
+constexpr auto operator>=(const Lhs &lhs, const Rhs &rhs) noexcept {
+	return internal::make_broadcast_expr<internal::broadcast_ge>(lhs, rhs);
+}
+// broadcast_operators ENDS
+
+// broadcast_assign BEGINS
+/*
+ * 1. expr must broadcast to the shape of out (out[...] = expr in numpy), so a lower-rank operand alone is tiled
+ * 2. the element type of expr is converted to Ty; only an exact match takes the simd path
+ */
+template<typename Ty, bool exception, size_t... DimSize, typename Expr>
+    requires internal::broadcast_operand<Expr>
+void assign(basic_ndarray<Ty, exception, DimSize...> &out, const Expr &expr) noexcept {
+	NSTD_PROFILE_SCOPE("nstd::assign");
+	using node = std::remove_cvref_t<decltype(internal::as_broadcast(expr))>;
+	using out_shape = internal::broadcast_shape<DimSize...>;
+	static_assert(std::is_same_v<typename internal::broadcast_result<typename node::shape, out_shape>::type, out_shape>
+	        && internal::broadcast_result<typename node::shape, out_shape>::compatible,
+	    "expression does not broadcast to the output shape!");
+
+	constexpr size_t rank = sizeof...(DimSize);
+	constexpr size_t shape[] = { DimSize... };
+	constexpr size_t cols = shape[rank - 1];
+	constexpr size_t rows = (DimSize * ...) / cols;
+	constexpr bool vectorize = node::template vectorizable<Ty>;
+
+	const node &root = internal::as_broadcast(expr);
+	size_t idx[rank]{};
+	Ty *dst = out.data();
+	for (size_t r = 0; r < rows; r++, dst += cols) {
+		internal::broadcast_assign_row<Ty, cols, vectorize>(dst, root.template row<rank>(idx));
+		// next row, the last coordinate stays 0
+		for (size_t d = rank - 1; d-- > 0;) {
+			if (++idx[d] < shape[d]) {
+				break;
+			}
+			idx[d] = 0;
+		}
+	}
+}
+
+template<typename Expr>
+    requires internal::broadcast_operand<Expr>
+auto eval(const Expr &expr) noexcept {
+	using node = std::remove_cvref_t<decltype(internal::as_broadcast(expr))>;
+	typename internal::broadcast_ndarray<typename node::value_type, typename node::shape>::type res;
+	assign(res, expr);
+	return res;
+}
+// broadcast_assign ENDS
+
+}  // namespace nstd
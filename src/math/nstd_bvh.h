@@ -0,0 +1,684 @@
+#pragma once
+
+#include <container/nstd_small_vector.h>
+#include <math/linalg/nstd_vector.h>
+#include <math/nstd_geometry.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/*
+ * bounding volume hierarchy over axis-aligned boxes, Width (4 or 8) children per node
+ * 1. build: binned surface-area heuristic over the centroids, binning along all three axes; a node is filled by
+ *    splitting its largest child cluster again and again until it has Width of them or every cluster fits a leaf
+ *    (at most leaf_size primitives)
+ * 2. the top of the tree is built on a thread_pool with the binning of each split spread over its threads; the
+ *    subtrees below are independent tasks, built into node arrays of their own and appended, so every child is
+ *    stored after its parent
+ * 3. a node keeps the bounds of its children one coordinate per array, so a query tests all of them at once with
+ *    simd<float> (when its width divides Width, lane by lane otherwise)
+ * 4. refit() takes new boxes for the same primitives and recomputes the bounds bottom-up without changing the tree,
+ *    queries slow down as the boxes drift away from the ones the tree was built for
+ * 5. raycast / nearest test primitives through a callback, by default against the primitive boxes themselves
+ * ! assumptions !
+ * 1. fewer than 2^32 - 1 primitives
+ */
+
+namespace nstd {
+
+struct bvh_hit {
+	static constexpr std::uint32_t npos = ~std::uint32_t(0);
+
+	std::uint32_t _Prim = npos;
+	float _Dist = std::numeric_limits<float>::infinity();  // along the ray, or squared for nearest
+
+	explicit operator bool() const noexcept {
+		return _Prim != npos;
+	}
+};
+
+namespace internal {
+
+struct bvh_box {
+	float _Min[3] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+	float _Max[3] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+	static bvh_box from(const aabb &box) noexcept {
+		bvh_box res;
+		for (size_t a = 0; a < 3; a++) {
+			res._Min[a] = box._Min[a];
+			res._Max[a] = box._Max[a];
+		}
+		return res;
+	}
+
+	void grow(const bvh_box &rhs) noexcept {
+		for (size_t a = 0; a < 3; a++) {
+			_Min[a] = std::min(_Min[a], rhs._Min[a]);
+			_Max[a] = std::max(_Max[a], rhs._Max[a]);
+		}
+	}
+
+	void grow(const float *point) noexcept {
+		for (size_t a = 0; a < 3; a++) {
+			_Min[a] = std::min(_Min[a], point[a]);
+			_Max[a] = std::max(_Max[a], point[a]);
+		}
+	}
+
+	// half the surface area, 0 when empty
+	float area() const noexcept {
+		const float dx = _Max[0] - _Min[0], dy = _Max[1] - _Min[1], dz = _Max[2] - _Min[2];
+		return dx < 0.0f ? 0.0f : dx * dy + dy * dz + dz * dx;
+	}
+};
+
+// a primitive while building: its box and its id, moved around by the partitions
+struct bvh_ref {
+	bvh_box _Box;
+	std::uint32_t _Id;
+
+	float centroid(size_t axis) const noexcept {
+		return (_Box._Min[axis] + _Box._Max[axis]) * 0.5f;
+	}
+};
+
+}  // namespace internal
+
+template<size_t Width>
+    requires(Width == 4 || Width == 8)
+class basic_bvh {
+public:
+	static constexpr size_t width = Width;
+	static constexpr size_t leaf_size = 4;
+	static constexpr size_t bins = 16;
+	static constexpr std::uint32_t npos = bvh_hit::npos;
+
+	struct alignas(64) node {
+		float _Min[3][Width];
+		float _Max[3][Width];
+		std::uint32_t _Child[Width];  // a node for an inner child, the first slot of the leaf otherwise, npos if unused
+		std::uint32_t _Count[Width];  // primitives of a leaf, 0 for an inner child
+	};
+
+private:
+	using bvh_box = internal::bvh_box;
+	using bvh_ref = internal::bvh_ref;
+	using lane_vec = std::conditional_t<Width % nstd::internal::simd<float>::width == 0, nstd::internal::simd<float>,
+	                                    nstd::internal::simd_scalar<float>>;
+
+	struct cluster {
+		size_t _Begin;
+		size_t _End;
+		bvh_box _Box;
+	};
+
+	// an inner child still to be built: refs [_Begin, _End) hang under lane _Lane of node _Node
+	struct pending {
+		cluster _Range;
+		size_t _Node;
+		size_t _Lane;
+	};
+
+	struct bin {
+		bvh_box _Box;
+		size_t _Count = 0;
+	};
+
+	struct stack_entry {
+		std::uint32_t _Node;
+		float _Dist;  // of the node's box, entries farther than the best hit are skipped
+	};
+
+	std::vector<node> _Nodes;
+	std::vector<std::uint32_t> _Order;  // primitive ids, leaves are ranges of slots
+	std::vector<bvh_box> _Boxes;        // the box of the primitive in each slot
+
+	// splits at least parallel_min refs with the binning spread over the pool
+	static constexpr size_t parallel_min = size_t(1) << 16;
+
+	static node empty_node() noexcept {
+		node res;
+		for (size_t a = 0; a < 3; a++) {
+			for (size_t l = 0; l < Width; l++) {
+				res._Min[a][l] = std::numeric_limits<float>::infinity();
+				res._Max[a][l] = -std::numeric_limits<float>::infinity();
+			}
+		}
+		for (size_t l = 0; l < Width; l++) {
+			res._Child[l] = npos;
+			res._Count[l] = 0;
+		}
+		return res;
+	}
+
+	static void set_lane(node &nd, size_t lane, const bvh_box &box) noexcept {
+		for (size_t a = 0; a < 3; a++) {
+			nd._Min[a][lane] = box._Min[a];
+			nd._Max[a][lane] = box._Max[a];
+		}
+	}
+
+	static bvh_box lane_box(const node &nd, size_t lane) noexcept {
+		bvh_box res;
+		for (size_t a = 0; a < 3; a++) {
+			res._Min[a] = nd._Min[a][lane];
+			res._Max[a] = nd._Max[a][lane];
+		}
+		return res;
+	}
+
+	// bin of a centroid along axis, the same for the binning and the partition that follows it
+	static size_t bin_of(float centroid, float lo, float scale) noexcept {
+		const auto k = static_cast<size_t>((centroid - lo) * scale);
+		return k < bins ? k : bins - 1;
+	}
+
+	// fn(lo, hi) over [begin, end), on the pool when the range is large enough
+	template<typename Fn>
+	static void for_range(size_t begin, size_t end, thread_pool *pool, Fn &&fn) {
+		if (pool != nullptr && pool->size() > 1 && end - begin >= parallel_min) {
+			pool->parallel_for(begin, end, fn, parallel_min / 4);
+		} else {
+			fn(begin, end);
+		}
+	}
+
+	/*
+	 * splits refs [c._Begin, c._End) in two by the cheapest of (bins - 1) * 3 candidate planes, cost being
+	 * area(left) * count(left) + area(right) * count(right); when every centroid falls in one bin the range is
+	 * cut in half in its current order
+	 */
+	static void split(std::vector<bvh_ref> &refs, const cluster &c, thread_pool *pool, cluster &left, cluster &right) {
+		bvh_box centroids;
+		std::mutex lock;
+		for_range(c._Begin, c._End, pool, [&](size_t lo, size_t hi) {
+			bvh_box local;
+			for (size_t i = lo; i < hi; i++) {
+				const float point[3] = { refs[i].centroid(0), refs[i].centroid(1), refs[i].centroid(2) };
+				local.grow(point);
+			}
+			std::lock_guard guard(lock);
+			centroids.grow(local);
+		});
+
+		float scale[3];
+		for (size_t a = 0; a < 3; a++) {
+			const float extent = centroids._Max[a] - centroids._Min[a];
+			scale[a] = extent > 0.0f ? static_cast<float>(bins) * (1.0f - 1e-5f) / extent : 0.0f;
+		}
+		bin table[3][bins];
+		for_range(c._Begin, c._End, pool, [&](size_t lo, size_t hi) {
+			bin local[3][bins];
+			for (size_t i = lo; i < hi; i++) {
+				for (size_t a = 0; a < 3; a++) {
+					bin &b = local[a][bin_of(refs[i].centroid(a), centroids._Min[a], scale[a])];
+					b._Box.grow(refs[i]._Box);
+					b._Count++;
+				}
+			}
+			std::lock_guard guard(lock);
+			for (size_t a = 0; a < 3; a++) {
+				for (size_t k = 0; k < bins; k++) {
+					table[a][k]._Box.grow(local[a][k]._Box);
+					table[a][k]._Count += local[a][k]._Count;
+				}
+			}
+		});
+
+		size_t best_axis = 3, best_bin = 0;
+		float best_cost = std::numeric_limits<float>::infinity();
+		for (size_t a = 0; a < 3; a++) {
+			if (scale[a] == 0.0f) {
+				continue;
+			}
+			// right_area[k] / right_count[k]: bins (k, bins)
+			float right_area[bins];
+			size_t right_count[bins];
+			bvh_box acc;
+			size_t count = 0;
+			for (size_t k = bins - 1; k > 0; k--) {
+				acc.grow(table[a][k]._Box);
+				count += table[a][k]._Count;
+				right_area[k - 1] = acc.area();
+				right_count[k - 1] = count;
+			}
+			acc = bvh_box();
+			count = 0;
+			for (size_t k = 0; k + 1 < bins; k++) {
+				acc.grow(table[a][k]._Box);
+				count += table[a][k]._Count;
+				if (count == 0 || right_count[k] == 0) {
+					continue;
+				}
+				const float cost = acc.area() * static_cast<float>(count) + right_area[k] * static_cast<float>(right_count[k]);
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_axis = a;
+					best_bin = k;
+				}
+			}
+		}
+
+		size_t mid;
+		if (best_axis == 3) {
+			mid = c._Begin + (c._End - c._Begin) / 2;
+		} else {
+			const float lo = centroids._Min[best_axis], s = scale[best_axis];
+			const auto first = refs.begin() + static_cast<std::ptrdiff_t>(c._Begin), last = refs.begin() + static_cast<std::ptrdiff_t>(c._End);
+			mid = static_cast<size_t>(std::partition(first, last, [&](const bvh_ref &r) { return bin_of(r.centroid(best_axis), lo, s) <= best_bin; }) - refs.begin());
+		}
+		left = { c._Begin, mid, bvh_box() };
+		right = { mid, c._End, bvh_box() };
+		if (best_axis != 3) {
+			for (size_t k = 0; k < bins; k++) {
+				(k <= best_bin ? left : right)._Box.grow(table[best_axis][k]._Box);
+			}
+		} else {
+			for (size_t i = c._Begin; i < c._End; i++) {
+				(i < mid ? left : right)._Box.grow(refs[i]._Box);
+			}
+		}
+	}
+
+	// the children of one node: the range split into at most Width clusters, the largest split first
+	static size_t make_clusters(std::vector<bvh_ref> &refs, const cluster &c, thread_pool *pool, cluster (&out)[Width]) {
+		out[0] = c;
+		size_t count = 1;
+		while (count < Width) {
+			size_t pick = Width;
+			float area = -1.0f;
+			for (size_t i = 0; i < count; i++) {
+				if (out[i]._End - out[i]._Begin > leaf_size && out[i]._Box.area() > area) {
+					pick = i;
+					area = out[i]._Box.area();
+				}
+			}
+			if (pick == Width) {
+				break;
+			}
+			cluster left, right;
+			split(refs, out[pick], pool, left, right);
+			out[pick] = left;
+			out[count++] = right;
+		}
+		return count;
+	}
+
+	// the subtree over c into nodes (indices local to it), returns its root
+	static std::uint32_t build_subtree(std::vector<bvh_ref> &refs, const cluster &c, std::vector<node> &nodes) {
+		const auto index = static_cast<std::uint32_t>(nodes.size());
+		nodes.push_back(empty_node());
+		cluster children[Width];
+		const size_t count = make_clusters(refs, c, nullptr, children);
+		for (size_t l = 0; l < count; l++) {
+			set_lane(nodes[index], l, children[l]._Box);
+			const size_t size = children[l]._End - children[l]._Begin;
+			if (size <= leaf_size) {
+				nodes[index]._Child[l] = static_cast<std::uint32_t>(children[l]._Begin);
+				nodes[index]._Count[l] = static_cast<std::uint32_t>(size);
+			} else {
+				const std::uint32_t child = build_subtree(refs, children[l], nodes);  // may reallocate nodes
+				nodes[index]._Child[l] = child;
+			}
+		}
+		return index;
+	}
+
+	void build_impl(const aabb *boxes, size_t n, thread_pool *pool) {
+		_Nodes.clear();
+		_Order.assign(n, 0);
+		_Boxes.assign(n, bvh_box());
+		if (n == 0) {
+			return;
+		}
+		std::vector<bvh_ref> refs(n);
+		cluster root{ 0, n, bvh_box() };
+		for (size_t i = 0; i < n; i++) {
+			refs[i] = { bvh_box::from(boxes[i]), static_cast<std::uint32_t>(i) };
+			root._Box.grow(refs[i]._Box);
+		}
+
+		// the top: ranges larger than this are split here, the smaller ones become one task each
+		const size_t threads = pool == nullptr ? 1 : pool->size();
+		const size_t task_min = threads == 1 ? n + 1 : std::max<size_t>(n / (threads * 8), 4096);
+		std::vector<pending> top{ { root, npos, 0 } };
+		std::vector<pending> tasks;
+		for (size_t t = 0; t < top.size(); t++) {
+			const pending p = top[t];
+			const auto index = static_cast<std::uint32_t>(_Nodes.size());
+			_Nodes.push_back(empty_node());
+			if (p._Node != npos) {
+				_Nodes[p._Node]._Child[p._Lane] = index;
+			}
+			cluster children[Width];
+			const size_t count = make_clusters(refs, p._Range, pool, children);
+			for (size_t l = 0; l < count; l++) {
+				set_lane(_Nodes[index], l, children[l]._Box);
+				const size_t size = children[l]._End - children[l]._Begin;
+				if (size <= leaf_size) {
+					_Nodes[index]._Child[l] = static_cast<std::uint32_t>(children[l]._Begin);
+					_Nodes[index]._Count[l] = static_cast<std::uint32_t>(size);
+				} else {
+					(size >= task_min ? top : tasks).push_back({ children[l], index, l });
+				}
+			}
+		}
+
+		std::vector<std::vector<node>> subtrees(tasks.size());
+		if (pool != nullptr) {
+			pool->run(tasks.size(), [&](size_t t) { build_subtree(refs, tasks[t]._Range, subtrees[t]); });
+		} else {
+			for (size_t t = 0; t < tasks.size(); t++) {
+				build_subtree(refs, tasks[t]._Range, subtrees[t]);
+			}
+		}
+		for (size_t t = 0; t < tasks.size(); t++) {
+			const auto offset = static_cast<std::uint32_t>(_Nodes.size());
+			_Nodes[tasks[t]._Node]._Child[tasks[t]._Lane] = offset;
+			for (node &nd : subtrees[t]) {
+				for (size_t l = 0; l < Width; l++) {
+					if (nd._Count[l] == 0 && nd._Child[l] != npos) {
+						nd._Child[l] += offset;
+					}
+				}
+				_Nodes.push_back(nd);
+			}
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			_Order[i] = refs[i]._Id;
+			_Boxes[i] = refs[i]._Box;
+		}
+	}
+
+	// the ray with its reciprocal direction, and for each axis which bound a ray enters through
+	struct ray_setup {
+		float _Origin[3];
+		float _Inv[3];
+		bool _Flip[3];  // negative direction: enters through the max bound
+		float _TMin;
+	};
+
+	static ray_setup setup(const ray &r) noexcept {
+		ray_setup res;
+		for (size_t a = 0; a < 3; a++) {
+			res._Origin[a] = r._Origin[a];
+			res._Inv[a] = 1.0f / r._Dir[a];
+			res._Flip[a] = std::signbit(res._Inv[a]);
+		}
+		res._TMin = r._TMin;
+		return res;
+	}
+
+	// lanes of nd whose box the ray crosses within [_TMin, tmax], with the entry distance of each in near
+	static unsigned test_ray(const node &nd, const ray_setup &rs, float tmax, float *near) noexcept {
+		using vec = lane_vec;
+		using reg = typename vec::reg;
+		unsigned bits = 0;
+		for (size_t c = 0; c < Width; c += vec::width) {
+			reg tn = vec::set1(rs._TMin), tf = vec::set1(tmax);
+			for (size_t a = 0; a < 3; a++) {
+				const float *enter = rs._Flip[a] ? nd._Max[a] : nd._Min[a];
+				const float *leave = rs._Flip[a] ? nd._Min[a] : nd._Max[a];
+				const reg origin = vec::set1(rs._Origin[a]), inv = vec::set1(rs._Inv[a]);
+				tn = vec::max(vec::mul(vec::sub(vec::load(enter + c), origin), inv), tn);
+				tf = vec::min(vec::mul(vec::sub(vec::load(leave + c), origin), inv), tf);
+			}
+			vec::store(near + c, tn);
+			bits |= vec::le_mask(tn, tf) << c;
+		}
+		return bits;
+	}
+
+	// lanes of nd whose box is closer to p than best (squared), with the squared distances in dist
+	static unsigned test_point(const node &nd, const float *p, float best, float *dist) noexcept {
+		using vec = lane_vec;
+		using reg = typename vec::reg;
+		unsigned bits = 0;
+		for (size_t c = 0; c < Width; c += vec::width) {
+			reg d2 = vec::zero();
+			for (size_t a = 0; a < 3; a++) {
+				const reg x = vec::set1(p[a]);
+				const reg d = vec::max(vec::max(vec::sub(vec::load(nd._Min[a] + c), x), vec::sub(x, vec::load(nd._Max[a] + c))), vec::zero());
+				d2 = vec::fmadd(d, d, d2);
+			}
+			vec::store(dist + c, d2);
+			bits |= vec::lt_mask(d2, vec::set1(best)) << c;
+		}
+		return bits;
+	}
+
+	// the hit lanes of bits ordered by key, nearest first
+	static size_t sorted_lanes(unsigned bits, const float *key, std::uint32_t (&out)[Width]) noexcept {
+		size_t count = 0;
+		for (; bits != 0; bits &= bits - 1) {
+			const auto lane = static_cast<std::uint32_t>(std::countr_zero(bits));
+			size_t j = count++;
+			for (; j > 0 && key[out[j - 1]] > key[lane]; j--) {
+				out[j] = out[j - 1];
+			}
+			out[j] = lane;
+		}
+		return count;
+	}
+
+	static float box_ray(const bvh_box &box, const ray_setup &rs, float tmax) noexcept {
+		float tn = rs._TMin, tf = tmax;
+		for (size_t a = 0; a < 3; a++) {
+			const float enter = rs._Flip[a] ? box._Max[a] : box._Min[a];
+			const float leave = rs._Flip[a] ? box._Min[a] : box._Max[a];
+			tn = std::max((enter - rs._Origin[a]) * rs._Inv[a], tn);
+			tf = std::min((leave - rs._Origin[a]) * rs._Inv[a], tf);
+		}
+		return tn <= tf ? tn : std::numeric_limits<float>::infinity();
+	}
+
+	static float box_point(const bvh_box &box, const float *p) noexcept {
+		float d2 = 0.0f;
+		for (size_t a = 0; a < 3; a++) {
+			const float d = std::max(std::max(box._Min[a] - p[a], p[a] - box._Max[a]), 0.0f);
+			d2 += d * d;
+		}
+		return d2;
+	}
+
+	template<typename Fn>
+	bvh_hit raycast_impl(const ray &r, Fn &&leaf) const {
+		bvh_hit best;
+		best._Dist = r._TMax;
+		if (_Nodes.empty()) {
+			return {};
+		}
+		const ray_setup rs = setup(r);
+		small_vector<stack_entry, 64> stack;
+		stack.push_back({ 0, rs._TMin });
+		while (!stack.empty()) {
+			const stack_entry top = stack.back();
+			stack.pop_back();
+			if (top._Dist > best._Dist) {
+				continue;
+			}
+			const node &nd = _Nodes[top._Node];
+			float near[Width];
+			std::uint32_t lanes[Width];
+			const size_t count = sorted_lanes(test_ray(nd, rs, best._Dist, near), near, lanes);
+			// leaves first, nearest first; inner children are pushed so that the nearest is popped first
+			for (size_t i = 0; i < count; i++) {
+				const std::uint32_t l = lanes[i];
+				if (nd._Count[l] != 0 && near[l] <= best._Dist) {
+					for (std::uint32_t s = nd._Child[l]; s < nd._Child[l] + nd._Count[l]; s++) {
+						const float t = leaf(s, best._Dist);
+						if (t < best._Dist) {
+							best = { _Order[s], t };
+						}
+					}
+				}
+			}
+			for (size_t i = count; i-- > 0;) {
+				const std::uint32_t l = lanes[i];
+				if (nd._Count[l] == 0) {
+					stack.push_back({ nd._Child[l], near[l] });
+				}
+			}
+		}
+		return best._Prim == npos ? bvh_hit() : best;
+	}
+
+	template<typename Fn>
+	bvh_hit nearest_impl(const linalg::vector3f &point, float max_dist2, Fn &&leaf) const {
+		bvh_hit best;
+		best._Dist = max_dist2;
+		if (_Nodes.empty()) {
+			return {};
+		}
+		const float p[3] = { point[0], point[1], point[2] };
+		small_vector<stack_entry, 64> stack;
+		stack.push_back({ 0, 0.0f });
+		while (!stack.empty()) {
+			const stack_entry top = stack.back();
+			stack.pop_back();
+			if (top._Dist >= best._Dist) {
+				continue;
+			}
+			const node &nd = _Nodes[top._Node];
+			float dist[Width];
+			std::uint32_t lanes[Width];
+			const size_t count = sorted_lanes(test_point(nd, p, best._Dist, dist), dist, lanes);
+			for (size_t i = 0; i < count; i++) {
+				const std::uint32_t l = lanes[i];
+				if (nd._Count[l] != 0 && dist[l] < best._Dist) {
+					for (std::uint32_t s = nd._Child[l]; s < nd._Child[l] + nd._Count[l]; s++) {
+						const float d2 = leaf(s);
+						if (d2 < best._Dist) {
+							best = { _Order[s], d2 };
+						}
+					}
+				}
+			}
+			for (size_t i = count; i-- > 0;) {
+				const std::uint32_t l = lanes[i];
+				if (nd._Count[l] == 0) {
+					stack.push_back({ nd._Child[l], dist[l] });
+				}
+			}
+		}
+		return best._Prim == npos ? bvh_hit() : best;
+	}
+
+public:
+	basic_bvh() noexcept = default;
+
+	// large inputs are built on thread_pool::global()
+	basic_bvh(const aabb *boxes, size_t n) {
+		build(boxes, n);
+	}
+
+	basic_bvh(const aabb *boxes, size_t n, thread_pool &pool) {
+		build(boxes, n, pool);
+	}
+
+	void build(const aabb *boxes, size_t n) {
+		build_impl(boxes, n, n < parallel_min ? nullptr : &thread_pool::global());
+	}
+
+	// thread_pool(1) keeps it on the calling thread
+	void build(const aabb *boxes, size_t n, thread_pool &pool) {
+		build_impl(boxes, n, &pool);
+	}
+
+	// boxes[i] is the new box of primitive i, for as many primitives as the tree was built with
+	void refit(const aabb *boxes) noexcept {
+		for (size_t s = 0; s < _Order.size(); s++) {
+			_Boxes[s] = bvh_box::from(boxes[_Order[s]]);
+		}
+		// every child is stored after its parent, so walking backwards finishes the children first
+		for (size_t i = _Nodes.size(); i-- > 0;) {
+			node &nd = _Nodes[i];
+			for (size_t l = 0; l < Width; l++) {
+				if (nd._Child[l] == npos) {
+					continue;
+				}
+				bvh_box box;
+				if (nd._Count[l] != 0) {
+					for (std::uint32_t s = nd._Child[l]; s < nd._Child[l] + nd._Count[l]; s++) {
+						box.grow(_Boxes[s]);
+					}
+				} else {
+					const node &child = _Nodes[nd._Child[l]];
+					for (size_t k = 0; k < Width; k++) {
+						box.grow(lane_box(child, k));
+					}
+				}
+				set_lane(nd, l, box);
+			}
+		}
+	}
+
+	size_t size() const noexcept {
+		return _Order.size();
+	}
+
+	bool empty() const noexcept {
+		return _Order.empty();
+	}
+
+	const std::vector<node> &nodes() const noexcept {
+		return _Nodes;
+	}
+
+	aabb bounds() const noexcept {
+		bvh_box box;
+		if (!_Nodes.empty()) {
+			for (size_t l = 0; l < Width; l++) {
+				box.grow(lane_box(_Nodes[0], l));
+			}
+		}
+		return { linalg::vector3f(box._Min[0], box._Min[1], box._Min[2]), linalg::vector3f(box._Max[0], box._Max[1], box._Max[2]) };
+	}
+
+	// the nearest primitive box r enters within [r._TMin, r._TMax], _Dist is the entry distance
+	bvh_hit raycast(const ray &r) const noexcept {
+		const ray_setup rs = setup(r);
+		return raycast_impl(r, [&](std::uint32_t slot, float tmax) { return box_ray(_Boxes[slot], rs, tmax); });
+	}
+
+	// the same with the exact test fn(prim, r) -> distance along r, or +inf on a miss; r._TMax is the best so far
+	template<typename Fn>
+	    requires std::is_invocable_v<Fn &, std::uint32_t, const ray &>
+	bvh_hit raycast(const ray &r, Fn &&fn) const {
+		ray current = r;
+		return raycast_impl(r, [&](std::uint32_t slot, float tmax) {
+			current._TMax = tmax;
+			return static_cast<float>(fn(_Order[slot], static_cast<const ray &>(current)));
+		});
+	}
+
+	// the primitive nearest to point by fn(prim, point) -> squared distance, only those within sqrt(max_dist2)
+	template<typename Fn>
+	    requires std::is_invocable_v<Fn &, std::uint32_t, const linalg::vector3f &>
+	bvh_hit nearest(const linalg::vector3f &point, Fn &&fn, float max_dist2 = std::numeric_limits<float>::infinity()) const {
+		return nearest_impl(point, max_dist2, [&](std::uint32_t slot) { return static_cast<float>(fn(_Order[slot], point)); });
+	}
+
+	// the same by the distance to the primitive boxes, _Dist is squared
+	bvh_hit nearest(const linalg::vector3f &point, float max_dist2 = std::numeric_limits<float>::infinity()) const noexcept {
+		const float p[3] = { point[0], point[1], point[2] };
+		return nearest_impl(point, max_dist2, [&](std::uint32_t slot) { return box_point(_Boxes[slot], p); });
+	}
+};
+
+using bvh = basic_bvh<8>;
+using bvh4 = basic_bvh<4>;
+
+}  // namespace nstd
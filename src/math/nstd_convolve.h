@@ -0,0 +1,582 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_stencil.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+ * filters over basic_ndarray and strided_view grids of any rank, output has the shape of the input ("same" mode)
+ * 1. correlate: out[x] = sum of kernel[i] * in[x + i - c], c = extent / 2 per dimension; convolve flips the kernel
+ * 2. a kernel that is an outer product of 1-D kernels (Gaussian, box, Sobel, ...) is detected and run as one 1-D pass
+ *    per dimension when that needs fewer taps; everything else is a direct SIMD loop over the taps
+ * 3. box_filter is the mean over a (2r + 1)^Rank window from running sums, its cost does not depend on r
+ * 4. out-of-range reads go through the stencil boundary policies (clamp_boundary, wrap_boundary, constant_boundary)
+ * ! assumptions !
+ * 1. floating-point elements; in and out must not alias
+ * 2. views are read fastest with a unit stride along the last dimension, others are packed into a dense copy first
+ */
+
+namespace nstd {
+
+namespace internal {
+
+// grids are taken as non-strict views, basic_ndarray converts
+template<typename Ty, bool exception, size_t Rank>
+strided_view<Ty, Rank> as_view(const basic_strided_view<Ty, exception, Rank> &view) noexcept {
+	size_t extents[Rank], strides[Rank];
+	for (size_t d = 0; d < Rank; d++) {
+		extents[d] = view.extent(d);
+		strides[d] = view.stride(d);
+	}
+	return strided_view<Ty, Rank>(view.data(), extents, strides);
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+strided_view<Ty, sizeof...(DimSize)> as_view(basic_ndarray<Ty, exception, DimSize...> &arr) noexcept {
+	return arr;
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+strided_view<const Ty, sizeof...(DimSize)> as_view(const basic_ndarray<Ty, exception, DimSize...> &arr) noexcept {
+	return arr;
+}
+
+template<typename Ty, size_t Rank>
+struct filter_taps {
+	std::vector<ptrdiff_t> _Offsets;  // Rank per tap
+	std::vector<Ty> _Weights;
+	size_t _Radius[Rank]{};
+
+	void push(const ptrdiff_t (&offset)[Rank], Ty weight) {
+		for (size_t d = 0; d < Rank; d++) {
+			_Offsets.push_back(offset[d]);
+			const size_t r = static_cast<size_t>(offset[d] < 0 ? -offset[d] : offset[d]);
+			_Radius[d] = r > _Radius[d] ? r : _Radius[d];
+		}
+		_Weights.push_back(weight);
+	}
+
+	size_t size() const noexcept {
+		return _Weights.size();
+	}
+};
+
+template<typename Ty, size_t Rank>
+void check_same_shape(const strided_view<const Ty, Rank> &in, const strided_view<Ty, Rank> &out) {
+	for (size_t d = 0; d < Rank; d++) {
+		if (in.extent(d) != out.extent(d)) {
+			throw std::runtime_error("filter dimension mismatch!");
+		}
+	}
+	if (in.size() != 0 && static_cast<const void *>(in.data()) == static_cast<const void *>(out.data())) {
+		throw std::runtime_error("filter input and output must not alias!");
+	}
+}
+
+// dense row-major copy of a view
+template<typename Ty, size_t Rank>
+void pack(const strided_view<const Ty, Rank> &src, Ty *dst) noexcept {
+	size_t coord[Rank]{};
+	const size_t n = src.extent(Rank - 1), step = src.stride(Rank - 1);
+	for (size_t row = 0, rows = src.size() / (n == 0 ? 1 : n); row < rows && n != 0; row++) {
+		const Ty *s = src.data();
+		for (size_t d = 0; d + 1 < Rank; d++) {
+			s += coord[d] * src.stride(d);
+		}
+		for (size_t j = 0; j < n; j++) {
+			dst[j] = s[j * step];
+		}
+		dst += n;
+		for (size_t d = Rank - 1; d-- > 0;) {
+			if (++coord[d] < src.extent(d)) {
+				break;
+			}
+			coord[d] = 0;
+		}
+	}
+}
+
+/*
+ * calls fn(src_rows, dst_row) for every row along the last dimension
+ * src_rows[t] is the row tap t reads from, already moved by its outer offsets (a row of the constant for constant_boundary
+ * taps that fall outside), dst_row is contiguous: rows of a strided destination are written back after fn returns
+ */
+template<typename Ty, size_t Rank, typename Boundary, typename Fn>
+void for_each_filter_row(const strided_view<const Ty, Rank> &src, const strided_view<Ty, Rank> &dst, const filter_taps<Ty, Rank> &taps,
+                         const Boundary &boundary, Fn &&fn) {
+	const size_t n = src.extent(Rank - 1), r = taps._Radius[Rank - 1];
+	if (src.size() == 0) {
+		return;
+	}
+	std::vector<const Ty *> rows(taps.size());
+	aligned_buffer<Ty> fill, scratch;
+	if constexpr (requires { boundary._Value; }) {
+		fill = aligned_buffer<Ty>(n + 2 * r, static_cast<Ty>(boundary._Value));
+	}
+	const bool dense_dst = n == 1 || dst.stride(Rank - 1) == 1;
+	if (!dense_dst) {
+		scratch.resize(n);
+	}
+
+	size_t coord[Rank]{};
+	for (size_t row = 0, count = src.size() / n; row < count; row++) {
+		for (size_t t = 0; t < taps.size(); t++) {
+			const ptrdiff_t *offset = taps._Offsets.data() + t * Rank;
+			const Ty *p = src.data();
+			bool inside = true;
+			for (size_t d = 0; d + 1 < Rank; d++) {
+				ptrdiff_t i = static_cast<ptrdiff_t>(coord[d]) + offset[d];
+				inside = boundary.map(i, src.extent(d)) && inside;
+				p += static_cast<size_t>(i) * src.stride(d);
+			}
+			rows[t] = inside ? p : fill.data() + r;
+		}
+		Ty *out = dst.data();
+		for (size_t d = 0; d + 1 < Rank; d++) {
+			out += coord[d] * dst.stride(d);
+		}
+		fn(rows.data(), dense_dst ? out : scratch.data());
+		if (!dense_dst) {
+			for (size_t j = 0; j < n; j++) {
+				out[j * dst.stride(Rank - 1)] = scratch[j];
+			}
+		}
+		for (size_t d = Rank - 1; d-- > 0;) {
+			if (++coord[d] < src.extent(d)) {
+				break;
+			}
+			coord[d] = 0;
+		}
+	}
+}
+
+// one correlation pass, src has a unit stride along the last dimension
+template<typename Ty, size_t Rank, typename Boundary>
+void correlate_pass(const strided_view<const Ty, Rank> &src, const strided_view<Ty, Rank> &dst, const filter_taps<Ty, Rank> &taps,
+                    const Boundary &boundary) {
+	using vec = nstd::internal::simd<Ty>;
+	using reg = typename vec::reg;
+	const size_t n = src.extent(Rank - 1), r = taps._Radius[Rank - 1], count = taps.size();
+	const Ty *weights = taps._Weights.data();
+	std::vector<ptrdiff_t> shift(count);
+	for (size_t t = 0; t < count; t++) {
+		shift[t] = taps._Offsets[t * Rank + Rank - 1];
+	}
+
+	for_each_filter_row(src, dst, taps, boundary, [&](const Ty *const *rows, Ty *out) {
+		auto edge = [&](size_t begin, size_t end) {
+			for (size_t j = begin; j < end; j++) {
+				Ty acc(0);
+				for (size_t t = 0; t < count; t++) {
+					ptrdiff_t i = static_cast<ptrdiff_t>(j) + shift[t];
+					if constexpr (requires { boundary._Value; }) {
+						acc += weights[t] * (boundary.map(i, n) ? rows[t][i] : static_cast<Ty>(boundary._Value));
+					} else {
+						boundary.map(i, n);
+						acc += weights[t] * rows[t][i];
+					}
+				}
+				out[j] = acc;
+			}
+		};
+		if (n <= 2 * r) {
+			edge(0, n);
+			return;
+		}
+		edge(0, r);
+		size_t j = r;
+		for (; j + 2 * vec::width <= n - r; j += 2 * vec::width) {
+			reg acc0 = vec::zero(), acc1 = vec::zero();
+			for (size_t t = 0; t < count; t++) {
+				const reg w = vec::set1(weights[t]);
+				const Ty *s = rows[t] + shift[t] + static_cast<ptrdiff_t>(j);
+				acc0 = vec::fmadd(w, vec::load(s), acc0);
+				acc1 = vec::fmadd(w, vec::load(s + vec::width), acc1);
+			}
+			vec::store(out + j, acc0);
+			vec::store(out + j + vec::width, acc1);
+		}
+		for (; j < n - r; j++) {
+			Ty acc(0);
+			for (size_t t = 0; t < count; t++) {
+				acc += weights[t] * rows[t][shift[t] + static_cast<ptrdiff_t>(j)];
+			}
+			out[j] = acc;
+		}
+		edge(n - r, n);
+	});
+}
+
+// running-sum mean over [i - r, i + r] along dim, the accumulator is at least double precision
+template<typename Ty, size_t Rank, typename Boundary>
+void box_pass(const strided_view<const Ty, Rank> &src, const strided_view<Ty, Rank> &dst, size_t dim, size_t r, const Boundary &boundary) {
+	using acc_t = std::conditional_t<(sizeof(Ty) < sizeof(double)), double, Ty>;
+	const size_t n = src.extent(Rank - 1);
+	if (src.size() == 0) {
+		return;
+	}
+	const acc_t inv = acc_t(1) / static_cast<acc_t>(2 * r + 1);
+	filter_taps<Ty, Rank> taps;  // only the window ends: offsets -r - 1 (leaving) and +r (entering)
+
+	if (dim == Rank - 1) {
+		ptrdiff_t zero[Rank]{};
+		taps.push(zero, Ty(1));
+		for_each_filter_row(src, dst, taps, boundary, [&](const Ty *const *rows, Ty *out) {
+			const Ty *row = rows[0];
+			auto at = [&](ptrdiff_t i) -> acc_t {
+				if constexpr (requires { boundary._Value; }) {
+					return boundary.map(i, n) ? static_cast<acc_t>(row[i]) : static_cast<acc_t>(boundary._Value);
+				} else {
+					boundary.map(i, n);
+					return static_cast<acc_t>(row[i]);
+				}
+			};
+			acc_t sum(0);
+			for (ptrdiff_t i = -static_cast<ptrdiff_t>(r); i <= static_cast<ptrdiff_t>(r); i++) {
+				sum += at(i);
+			}
+			for (size_t j = 0; j < n; j++) {
+				out[j] = static_cast<Ty>(sum * inv);
+				sum += at(static_cast<ptrdiff_t>(j + r + 1)) - at(static_cast<ptrdiff_t>(j) - static_cast<ptrdiff_t>(r));
+			}
+		});
+		return;
+	}
+
+	// along an outer dimension whole rows slide: acc += row(i + r + 1) - row(i - r), vectorized across the row
+	const size_t len = src.extent(dim);
+	std::vector<acc_t> acc(n);
+	aligned_buffer<Ty> fill;
+	if constexpr (requires { boundary._Value; }) {
+		fill = aligned_buffer<Ty>(n, static_cast<Ty>(boundary._Value));
+	}
+	const size_t lines = src.size() / (n * len);
+	size_t coord[Rank]{};  // dim and the last dimension stay 0
+	for (size_t line = 0; line < lines; line++) {
+		auto row_at = [&](ptrdiff_t i) -> const Ty * {
+			if (!boundary.map(i, len)) {
+				return fill.data();
+			}
+			const Ty *p = src.data() + static_cast<size_t>(i) * src.stride(dim);
+			for (size_t d = 0; d + 1 < Rank; d++) {
+				p += d == dim ? 0 : coord[d] * src.stride(d);
+			}
+			return p;
+		};
+		const size_t step = src.stride(Rank - 1);
+		for (size_t j = 0; j < n; j++) {
+			acc[j] = acc_t(0);
+		}
+		for (ptrdiff_t i = -static_cast<ptrdiff_t>(r); i <= static_cast<ptrdiff_t>(r); i++) {
+			const Ty *p = row_at(i);
+			for (size_t j = 0; j < n; j++) {
+				acc[j] += static_cast<acc_t>(p[j * step]);
+			}
+		}
+		for (size_t i = 0; i < len; i++) {
+			Ty *out = dst.data() + i * dst.stride(dim);
+			for (size_t d = 0; d + 1 < Rank; d++) {
+				out += d == dim ? 0 : coord[d] * dst.stride(d);
+			}
+			const size_t out_step = dst.stride(Rank - 1);
+			for (size_t j = 0; j < n; j++) {
+				out[j * out_step] = static_cast<Ty>(acc[j] * inv);
+			}
+			const Ty *enter = row_at(static_cast<ptrdiff_t>(i + r + 1));
+			const Ty *leave = row_at(static_cast<ptrdiff_t>(i) - static_cast<ptrdiff_t>(r));
+			for (size_t j = 0; j < n; j++) {
+				acc[j] += static_cast<acc_t>(enter[j * step]) - static_cast<acc_t>(leave[j * step]);
+			}
+		}
+		for (size_t d = Rank - 1; d-- > 0;) {
+			if (d == dim) {
+				continue;
+			}
+			if (++coord[d] < src.extent(d)) {
+				break;
+			}
+			coord[d] = 0;
+		}
+	}
+}
+
+/*
+ * runs pass(src, dst, k) for k in [0, count), chaining through dense temporaries
+ * the first pass reads a dense copy when in lacks a unit stride along the last dimension
+ */
+template<typename Ty, size_t Rank, typename Pass>
+void run_passes(const strided_view<const Ty, Rank> &in, const strided_view<Ty, Rank> &out, size_t count, Pass &&pass) {
+	size_t extents[Rank];
+	for (size_t d = 0; d < Rank; d++) {
+		extents[d] = in.extent(d);
+	}
+	aligned_buffer<Ty> tmp[2];
+	strided_view<const Ty, Rank> src = in;
+	if (in.extent(Rank - 1) > 1 && in.stride(Rank - 1) != 1) {
+		tmp[1].resize(in.size());
+		pack(in, tmp[1].data());
+		src = strided_view<const Ty, Rank>(tmp[1].data(), extents);
+	}
+	if (count == 0) {  // identity
+		ptrdiff_t zero[Rank]{};
+		filter_taps<Ty, Rank> taps;
+		taps.push(zero, Ty(1));
+		correlate_pass(src, out, taps, clamp_boundary{});
+		return;
+	}
+	for (size_t k = 0; k < count; k++) {
+		if (k + 1 == count) {
+			pass(src, out, k);
+		} else {
+			aligned_buffer<Ty> &buf = tmp[k % 2];
+			if (buf.data() == src.data()) {
+				buf = aligned_buffer<Ty>();
+			}
+			buf.resize(in.size());
+			const strided_view<Ty, Rank> dst(buf.data(), extents);
+			pass(src, dst, k);
+			src = dst;
+		}
+	}
+}
+
+// kernel == outer product of factors[d] (within rounding), factors[d] has kernel.extent(d) entries
+template<typename Ty, size_t Rank>
+bool separate(const strided_view<const Ty, Rank> &kernel, std::vector<Ty> (&factors)[Rank]) {
+	const size_t count = kernel.size();
+	std::vector<Ty> dense(count);
+	pack(kernel, dense.data());
+	size_t pivot = 0;
+	Ty peak(0);
+	for (size_t i = 0; i < count; i++) {
+		if (std::abs(dense[i]) > peak) {
+			peak = std::abs(dense[i]);
+			pivot = i;
+		}
+	}
+	if (peak == Ty(0)) {
+		return false;
+	}
+
+	size_t strides[Rank], pivot_coord[Rank];
+	size_t stride = 1;
+	for (size_t d = Rank; d-- > 0;) {
+		strides[d] = stride;
+		pivot_coord[d] = pivot / stride % kernel.extent(d);
+		stride *= kernel.extent(d);
+	}
+	// the fibres through the pivot, all but the first scaled by the pivot value
+	for (size_t d = 0; d < Rank; d++) {
+		factors[d].resize(kernel.extent(d));
+		for (size_t i = 0; i < kernel.extent(d); i++) {
+			const Ty v = dense[pivot + (i - pivot_coord[d]) * strides[d]];
+			factors[d][i] = d == 0 ? v : v / dense[pivot];
+		}
+	}
+	const Ty tolerance = peak * Ty(64) * std::numeric_limits<Ty>::epsilon();
+	for (size_t i = 0; i < count; i++) {
+		Ty prod(1);
+		for (size_t d = 0; d < Rank; d++) {
+			prod *= factors[d][i / strides[d] % kernel.extent(d)];
+		}
+		if (std::abs(prod - dense[i]) > tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename Ty, size_t Rank, typename Boundary>
+void filter_separable(const strided_view<const Ty, Rank> &in, const strided_view<Ty, Rank> &out, const std::span<const Ty> (&kernels)[Rank],
+                      bool flip, const Boundary &boundary) {
+	size_t dims[Rank], count = 0;
+	for (size_t d = 0; d < Rank; d++) {
+		if (kernels[d].size() == 0) {
+			throw std::runtime_error("filter empty kernel!");
+		}
+		if (kernels[d].size() > 1 || kernels[d][0] != Ty(1)) {
+			dims[count++] = d;
+		}
+	}
+	run_passes(in, out, count, [&](const strided_view<const Ty, Rank> &src, const strided_view<Ty, Rank> &dst, size_t k) {
+		const size_t d = dims[k];
+		const std::span<const Ty> kernel = kernels[d];
+		const ptrdiff_t c = static_cast<ptrdiff_t>(kernel.size() / 2);
+		filter_taps<Ty, Rank> taps;
+		for (size_t i = 0; i < kernel.size(); i++) {
+			if (kernel[i] != Ty(0)) {
+				ptrdiff_t offset[Rank]{};
+				offset[d] = flip ? c - static_cast<ptrdiff_t>(i) : static_cast<ptrdiff_t>(i) - c;
+				taps.push(offset, kernel[i]);
+			}
+		}
+		if constexpr (requires { boundary._Value; }) {
+			// outside the grid the earlier passes saw the constant only, so this pass pads with what they made of it
+			Boundary padded = boundary;
+			for (size_t j = 0; j < k; j++) {
+				Ty sum(0);
+				for (Ty w : kernels[dims[j]]) {
+					sum += w;
+				}
+				padded._Value = padded._Value * sum;
+			}
+			correlate_pass(src, dst, taps, padded);
+		} else {
+			correlate_pass(src, dst, taps, boundary);
+		}
+	});
+}
+
+template<typename Ty, size_t Rank, typename Boundary>
+void filter(const strided_view<const Ty, Rank> &in, const strided_view<Ty, Rank> &out, const strided_view<const Ty, Rank> &kernel,
+            bool flip, const Boundary &boundary) {
+	NSTD_PROFILE_SCOPE("filter::correlate");
+	check_same_shape(in, out);
+	if (kernel.size() == 0) {
+		throw std::runtime_error("filter empty kernel!");
+	}
+	size_t direct = 1, separable = 0;
+	for (size_t d = 0; d < Rank; d++) {
+		direct *= kernel.extent(d);
+		separable += kernel.extent(d);
+	}
+	std::vector<Ty> factors[Rank];
+	if (Rank > 1 && separable < direct && separate(kernel, factors)) {
+		std::span<const Ty> kernels[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			kernels[d] = factors[d];
+		}
+		filter_separable(in, out, kernels, flip, boundary);
+		return;
+	}
+
+	filter_taps<Ty, Rank> taps;
+	size_t coord[Rank]{};
+	for (size_t i = 0; i < direct; i++) {
+		const Ty *p = kernel.data();
+		ptrdiff_t offset[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			p += coord[d] * kernel.stride(d);
+			const ptrdiff_t c = static_cast<ptrdiff_t>(kernel.extent(d) / 2), k = static_cast<ptrdiff_t>(coord[d]);
+			offset[d] = flip ? c - k : k - c;
+		}
+		if (*p != Ty(0)) {
+			taps.push(offset, *p);
+		}
+		for (size_t d = Rank; d-- > 0;) {
+			if (++coord[d] < kernel.extent(d)) {
+				break;
+			}
+			coord[d] = 0;
+		}
+	}
+	if (taps.size() == 0) {
+		ptrdiff_t zero[Rank]{};
+		taps.push(zero, Ty(0));
+	}
+	run_passes(in, out, 1, [&](const strided_view<const Ty, Rank> &src, const strided_view<Ty, Rank> &dst, size_t) {
+		correlate_pass(src, dst, taps, boundary);
+	});
+}
+
+}  // namespace internal
+
+// correlate / convolve BEGINS
+template<typename In, typename Out, typename Kernel, typename Boundary = clamp_boundary>
+void correlate(const In &in, Out &&out, const Kernel &kernel, const Boundary &boundary = {}) {
+	const auto in_view = internal::as_view(in);
+	const auto out_view = internal::as_view(out);
+	using Ty = remove_cvref_t<decltype(*out_view.data())>;
+	static_assert(std::is_floating_point_v<Ty>, "filters require floating-point elements");
+	constexpr size_t Rank = decltype(in_view)::rank;
+	internal::filter<Ty, Rank>(in_view, out_view, internal::as_view(kernel), false, boundary);
+}
+
+template<typename In, typename Out, typename Kernel, typename Boundary = clamp_boundary>
+void convolve(const In &in, Out &&out, const Kernel &kernel, const Boundary &boundary = {}) {
+	const auto in_view = internal::as_view(in);
+	const auto out_view = internal::as_view(out);
+	using Ty = remove_cvref_t<decltype(*out_view.data())>;
+	static_assert(std::is_floating_point_v<Ty>, "filters require floating-point elements");
+	constexpr size_t Rank = decltype(in_view)::rank;
+	internal::filter<Ty, Rank>(in_view, out_view, internal::as_view(kernel), true, boundary);
+}
+// correlate / convolve ENDS
+
+// separable filters BEGINS
+// one 1-D kernel per dimension (correlation), a kernel of { 1 } skips its dimension
+template<typename In, typename Out, typename Ty, size_t Rank, typename Boundary = clamp_boundary>
+void separable_filter(const In &in, Out &&out, const std::span<const Ty> (&kernels)[Rank], const Boundary &boundary = {}) {
+	static_assert(std::is_floating_point_v<Ty>, "filters require floating-point elements");
+	const strided_view<const Ty, Rank> in_view = internal::as_view(in);
+	const strided_view<Ty, Rank> out_view = internal::as_view(out);
+	internal::check_same_shape(in_view, out_view);
+	internal::filter_separable(in_view, out_view, kernels, false, boundary);
+}
+
+// normalized, 2 * radius + 1 taps; radius defaults to ceil(3 sigma)
+template<typename Ty>
+    requires(std::is_floating_point_v<Ty>)
+std::vector<Ty> gaussian_kernel(Ty sigma, size_t radius = 0) {
+	if (!(sigma > Ty(0))) {
+		throw std::runtime_error("gaussian_kernel sigma must be positive!");
+	}
+	if (radius == 0) {
+		radius = static_cast<size_t>(std::ceil(Ty(3) * sigma));
+	}
+	std::vector<Ty> res(2 * radius + 1);
+	Ty sum(0);
+	for (size_t i = 0; i < res.size(); i++) {
+		const Ty x = static_cast<Ty>(static_cast<ptrdiff_t>(i) - static_cast<ptrdiff_t>(radius));
+		res[i] = std::exp(-x * x / (Ty(2) * sigma * sigma));
+		sum += res[i];
+	}
+	for (Ty &v : res) {
+		v /= sum;
+	}
+	return res;
+}
+
+template<typename In, typename Out, typename Boundary = clamp_boundary>
+void gaussian_filter(const In &in, Out &&out, double sigma, const Boundary &boundary = {}) {
+	const auto out_view = internal::as_view(out);
+	using Ty = remove_cvref_t<decltype(*out_view.data())>;
+	constexpr size_t Rank = decltype(out_view)::rank;
+	const std::vector<Ty> kernel = gaussian_kernel(static_cast<Ty>(sigma));
+	std::span<const Ty> kernels[Rank];
+	for (size_t d = 0; d < Rank; d++) {
+		kernels[d] = kernel;
+	}
+	separable_filter(in, out_view, kernels, boundary);
+}
+
+// mean over the (2 radius + 1)^Rank window around every element, O(Rank) per element for any radius
+template<typename In, typename Out, typename Boundary = clamp_boundary>
+void box_filter(const In &in, Out &&out, size_t radius, const Boundary &boundary = {}) {
+	NSTD_PROFILE_SCOPE("filter::box");
+	const auto in_view = internal::as_view(in);
+	const auto out_view = internal::as_view(out);
+	using Ty = remove_cvref_t<decltype(*out_view.data())>;
+	static_assert(std::is_floating_point_v<Ty>, "filters require floating-point elements");
+	constexpr size_t Rank = decltype(in_view)::rank;
+	const strided_view<const Ty, Rank> src = in_view;
+	internal::check_same_shape(src, out_view);
+	internal::run_passes(src, out_view, radius == 0 ? 0 : Rank,
+	                     [&](const strided_view<const Ty, Rank> &s, const strided_view<Ty, Rank> &d, size_t k) {
+		                     internal::box_pass(s, d, k, radius, boundary);
+	                     });
+}
+// separable filters ENDS
+
+}  // namespace nstd
@@ -0,0 +1,75 @@
+#include <math/nstd_dispatch.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace nstd {
+
+namespace {
+
+constexpr kernel_table scalar_table = internal::make_kernel_table<nstd::internal::simd_scalar, nstd::internal::simd_i16_scalar>(isa::scalar);
+
+std::atomic<const kernel_table *> active{ nullptr };
+
+const kernel_table *built(isa target) noexcept {
+	switch (target) {
+	case isa::scalar:
+		return &scalar_table;
+	case isa::sse2:
+		return internal::kernels_sse2();
+	case isa::avx2:
+		return internal::kernels_avx2();
+	case isa::avx512:
+		return internal::kernels_avx512();
+	}
+	return nullptr;
+}
+
+// NSTD_ISA when it names an available table, else the widest available one
+const kernel_table *choose() noexcept {
+	constexpr isa order[] = { isa::avx512, isa::avx2, isa::sse2, isa::scalar };
+	if (const char *name = std::getenv("NSTD_ISA")) {
+		for (isa target : order) {
+			if (std::strcmp(name, isa_name(target)) == 0 && kernels_for(target) != nullptr) {
+				return kernels_for(target);
+			}
+		}
+	}
+	for (isa target : order) {
+		if (const kernel_table *table = kernels_for(target)) {
+			return table;
+		}
+	}
+	return &scalar_table;
+}
+
+}  // namespace
+
+const kernel_table *kernels_for(isa target) noexcept {
+	return cpu_supports(target) ? built(target) : nullptr;
+}
+
+const kernel_table &kernels() noexcept {
+	const kernel_table *table = active.load(std::memory_order_acquire);
+	if (table == nullptr) {
+		const kernel_table *expected = nullptr;
+		table = choose();
+		if (!active.compare_exchange_strong(expected, table, std::memory_order_acq_rel)) {
+			table = expected;
+		}
+	}
+	return *table;
+}
+
+void select_kernels(isa target) {
+	const kernel_table *table = kernels_for(target);
+	if (table == nullptr) {
+		throw std::runtime_error("select_kernels isa unavailable!");
+	}
+	active.store(table, std::memory_order_release);
+}
+
+}  // namespace nstd
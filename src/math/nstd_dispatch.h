@@ -0,0 +1,410 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <math/linalg/nstd_gemm.h>
+#include <math/linalg/nstd_widening.h>
+#include <util/nstd_cpu.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * run-time selection of the heavy float / double kernels (reductions, element-wise updates, gemm)
+ * 1. every instruction set is compiled in its own translation unit (nstd_dispatch_<isa>.cpp, built with that
+ *    target's flags) into a kernel_table of function pointers; a table exists when the build produced it and
+ *    the cpu supports it
+ * 2. kernels() is the active table: the best available one, chosen once on first use; the NSTD_ISA environment
+ *    variable (scalar / sse2 / avx2 / avx512) overrides the choice, select_kernels() changes it at run time
+ * 3. dispatch:: calls go through the active table, other element types fall back to the compile-time kernels
+ * 4. large gemm products are cut into tiles of c and spread over a thread_pool (the global one unless given),
+ *    every thread packing into its own panels
+ * 5. every table also carries the int8 / int16 widening kernels; the avx512 one takes the vpdpwssd build
+ *    (nstd_dispatch_avx512vnni.cpp) when the cpu has AVX512-VNNI
+ * 6. only the kernels above are dispatched: the fft, stencil, convolution and broadcast transforms still compile
+ *    against the default simd<Ty> and run at the width of the build target (SSE2 for a generic x86-64 build)
+ * 7. xsimd::dispatch would pick per-arch functors the same way, but every kernel here is written on simd<Ty>, and
+ *    xsimd is a private package of the nonstd target that the header-only callers could not include
+ * ! assumptions !
+ * 1. the per-isa translation units only instantiate templates parameterized on their simd type, which carries
+ *    the instruction set in its name (see util/nstd_simd.h); nothing compiled for a wider target can be picked
+ *    by the linker for a narrower caller
+ */
+
+namespace nstd {
+
+template<typename Ty>
+struct kernel_set {
+	Ty (*_Sum)(size_t n, const Ty *x) noexcept;
+	Ty (*_Dot)(size_t n, const Ty *x, const Ty *y) noexcept;
+	void (*_Axpy)(size_t n, Ty alpha, const Ty *x, Ty *y) noexcept;
+	void (*_Scal)(size_t n, Ty alpha, Ty *x) noexcept;
+	// linalg::gemm for m, n, k > 0, alpha != 0, on caller-provided panels of _PackA / _PackB elements
+	void (*_Gemm)(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c, size_t ldc,
+	              Ty *pack_a, Ty *pack_b) noexcept;
+	size_t _PackA;
+	size_t _PackB;
+};
+
+// int8 / int16 inputs with int32 results, see linalg/nstd_widening.h
+struct widening_kernel_set {
+	std::int32_t (*_DotI8)(size_t n, const std::int8_t *x, const std::int8_t *y, bool saturate) noexcept;
+	std::int32_t (*_DotI16)(size_t n, const std::int16_t *x, const std::int16_t *y, bool saturate) noexcept;
+	void (*_GemmI8)(size_t m, size_t n, size_t k, const std::int8_t *a, size_t lda, const std::int8_t *b, size_t ldb, std::int32_t *c,
+	                size_t ldc, bool saturate, std::int32_t *pack_a, std::int16_t *pack_b) noexcept;
+	void (*_GemmI16)(size_t m, size_t n, size_t k, const std::int16_t *a, size_t lda, const std::int16_t *b, size_t ldb, std::int32_t *c,
+	                 size_t ldc, bool saturate, std::int32_t *pack_a, std::int16_t *pack_b) noexcept;
+	size_t _Mr;  // rows per packed block of a, the larger of the plain and saturating ones
+	size_t _Nr;  // columns per packed panel of b
+	bool _Vnni;  // madd is vpdpwssd
+};
+
+struct kernel_table {
+	isa _Isa;
+	kernel_set<float> _F32;
+	kernel_set<double> _F64;
+	widening_kernel_set _Widening;
+
+	template<typename Ty>
+	const kernel_set<Ty> &get() const noexcept {
+		if constexpr (is_same_v<Ty, float>) {
+			return _F32;
+		} else {
+			return _F64;
+		}
+	}
+};
+
+// nullptr when the build has no kernels for target or the cpu cannot run them
+const kernel_table *kernels_for(isa target) noexcept;
+
+const kernel_table &kernels() noexcept;
+
+// makes target the active table, throws when it is unavailable
+void select_kernels(isa target);
+
+namespace internal {
+
+// the kernels behind every table, Vec picks the instruction set
+template<typename Ty, typename Vec>
+struct dispatch_kernels {
+	static Ty sum(size_t n, const Ty *x) noexcept {
+		using reg = typename Vec::reg;
+		reg acc[4] = { Vec::zero(), Vec::zero(), Vec::zero(), Vec::zero() };
+		size_t i = 0;
+		for (; i + 4 * Vec::width <= n; i += 4 * Vec::width) {
+			nstd::internal::static_for<4>([&](auto r) { acc[r] = Vec::add(acc[r], Vec::load(x + i + r * Vec::width)); });
+		}
+		for (; i + Vec::width <= n; i += Vec::width) {
+			acc[0] = Vec::add(acc[0], Vec::load(x + i));
+		}
+		Ty res = Vec::hsum(Vec::add(Vec::add(acc[0], acc[1]), Vec::add(acc[2], acc[3])));
+		for (; i < n; i++) {
+			res += x[i];
+		}
+		return res;
+	}
+
+	static Ty dot(size_t n, const Ty *x, const Ty *y) noexcept {
+		return linalg::dot<Ty, Vec>(n, x, y);
+	}
+
+	static void axpy(size_t n, Ty alpha, const Ty *x, Ty *y) noexcept {
+		linalg::axpy<Ty, Vec>(n, alpha, x, y);
+	}
+
+	static void scal(size_t n, Ty alpha, Ty *x) noexcept {
+		const typename Vec::reg alpha_v = Vec::set1(alpha);
+		size_t i = 0;
+		for (; i + Vec::width <= n; i += Vec::width) {
+			Vec::store(x + i, alpha == Ty(0) ? Vec::zero() : Vec::mul(alpha_v, Vec::load(x + i)));
+		}
+		for (; i < n; i++) {
+			x[i] = alpha == Ty(0) ? Ty(0) : alpha * x[i];
+		}
+	}
+
+	static void gemm(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c, size_t ldc,
+	                 Ty *pack_a, Ty *pack_b) noexcept {
+		linalg::internal::gemm_blocked<Ty, Vec>(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, pack_a, pack_b);
+	}
+
+	static constexpr kernel_set<Ty> set() noexcept {
+		using blocking = linalg::gemm_blocking<Ty, Vec>;
+		return { &sum, &dot, &axpy, &scal, &gemm, blocking::mc * blocking::kc, blocking::kc * (blocking::nc + blocking::nr) };
+	}
+};
+
+template<typename Vec>
+struct widening_kernels {
+	template<typename Ty>
+	static std::int32_t dot(size_t n, const Ty *x, const Ty *y, bool saturate) noexcept {
+		return linalg::widening_dot<Ty, Vec>(n, x, y, saturate);
+	}
+
+	template<typename Ty>
+	static void gemm(size_t m, size_t n, size_t k, const Ty *a, size_t lda, const Ty *b, size_t ldb, std::int32_t *c, size_t ldc,
+	                 bool saturate, std::int32_t *pack_a, std::int16_t *pack_b) noexcept {
+		linalg::widening_gemm<Ty, Vec>(m, n, k, a, lda, b, ldb, c, ldc, saturate, pack_a, pack_b);
+	}
+
+	static constexpr widening_kernel_set set() noexcept {
+		using blocking = linalg::widening_blocking<Vec>;
+		return { &dot<std::int8_t>, &dot<std::int16_t>, &gemm<std::int8_t>, &gemm<std::int16_t>, blocking::mr, blocking::nr,
+			     NSTD_SIMD_VNNI != 0 && Vec::width > 1 };
+	}
+};
+
+template<template<typename> class Vec, typename Wide>
+constexpr kernel_table make_kernel_table(isa target) noexcept {
+	return { target, dispatch_kernels<float, Vec<float>>::set(), dispatch_kernels<double, Vec<double>>::set(),
+		     widening_kernels<Wide>::set() };
+}
+
+// defined by the per-isa translation units, nullptr when that unit was not built for its target
+const kernel_table *kernels_sse2() noexcept;
+const kernel_table *kernels_avx2() noexcept;
+const kernel_table *kernels_avx512() noexcept;
+// the widening kernels built for AVX512-VNNI, nullptr when that unit was not built for it
+const widening_kernel_set *widening_kernels_avx512vnni() noexcept;
+
+template<typename Ty>
+inline constexpr bool dispatchable = is_same_v<Ty, float> || is_same_v<Ty, double>;
+
+// gemm products of fewer multiply-adds stay on the calling thread, waking the pool costs more than they take
+inline constexpr size_t gemm_parallel_min = size_t(1) << 21;
+
+/*
+ * splits c (m x n) into tiles and calls tile(i0, i1, j0, j1) for each on pool
+ * 1. about two tiles per thread: rows are cut into bands of at least mc rows, and columns into blocks of at least
+ *    4 * nr when there are fewer bands than tiles wanted
+ * 2. a band is a contiguous run of whole rows of c, so a freshly allocated c is first touched (and, on NUMA systems,
+ *    placed) by the threads that compute it; the packing panels are thread-local and first touched by their owner
+ * 3. tile edges fall on multiples of mr / nr, only the last band / block has partial micro tiles
+ */
+template<typename Ty, typename Fn>
+void gemm_tiles(size_t m, size_t n, thread_pool &pool, Fn &&tile) {
+	using blocking = linalg::gemm_blocking<Ty>;
+	const size_t wanted = pool.size() * 2;
+	const size_t row_units = (m + blocking::mr - 1) / blocking::mr;
+	const size_t col_units = (n + blocking::nr - 1) / blocking::nr;
+
+	size_t bands = (m + blocking::mc - 1) / blocking::mc;
+	bands = bands < wanted ? bands : wanted;
+	size_t blocks = wanted / bands;
+	blocks = blocks < col_units / 4 ? blocks : col_units / 4;
+	blocks = blocks == 0 ? 1 : blocks;
+
+	pool.run(bands * blocks, [&](size_t t) {
+		const size_t bi = t / blocks, bj = t % blocks;
+		const size_t i0 = row_units * bi / bands * blocking::mr, i1 = row_units * (bi + 1) / bands * blocking::mr;
+		const size_t j0 = col_units * bj / blocks * blocking::nr, j1 = col_units * (bj + 1) / blocks * blocking::nr;
+		tile(i0, i1 < m ? i1 : m, j0, j1 < n ? j1 : n);
+	});
+}
+
+// c = alpha * a * b + beta * c, on pool when it is given
+template<typename Ty>
+void gemm_run(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c, size_t ldc,
+              thread_pool *pool) {
+	if (m == 0 || n == 0) {
+		return;
+	}
+	if (k == 0 || alpha == Ty(0)) {
+		linalg::internal::gemm_scale(m, n, beta, c, ldc);
+		return;
+	}
+	// one tile is an independent product on the rows [i0, i1) of a and the columns [j0, j1) of b
+	const auto tile = [&](size_t i0, size_t i1, size_t j0, size_t j1) {
+		if constexpr (dispatchable<Ty>) {
+			const kernel_set<Ty> &set = kernels().get<Ty>();
+			auto &ws = linalg::internal::gemm_workspace<Ty>::local();
+			ws._PackA.reserve(set._PackA);
+			ws._PackB.reserve(set._PackB);
+			set._Gemm(i1 - i0, j1 - j0, k, alpha, a + i0 * lda, lda, b + j0, ldb, beta, c + i0 * ldc + j0, ldc, ws._PackA.data(),
+			          ws._PackB.data());
+		} else {
+			linalg::gemm(i1 - i0, j1 - j0, k, alpha, a + i0 * lda, lda, b + j0, ldb, beta, c + i0 * ldc + j0, ldc);
+		}
+	};
+	if (pool == nullptr || pool->size() == 1 || m * n * k < gemm_parallel_min) {
+		tile(0, m, 0, n);
+	} else {
+		gemm_tiles<Ty>(m, n, *pool, tile);
+	}
+}
+
+// rows of a packed at a time by the widening products, a multiple of both widening mr
+inline constexpr size_t widening_band = 192;
+
+// c = a * b in int32 through the active widening kernels, on pool when it is given
+template<typename Ty>
+void widening_gemm_run(size_t m, size_t n, size_t k, const Ty *a, size_t lda, const Ty *b, size_t ldb, std::int32_t *c, size_t ldc,
+                       bool saturate, thread_pool *pool) {
+	if (m == 0 || n == 0) {
+		return;
+	}
+	const widening_kernel_set &set = kernels()._Widening;
+	const auto gemm = [&] {
+		if constexpr (is_same_v<Ty, std::int8_t>) {
+			return set._GemmI8;
+		} else {
+			return set._GemmI16;
+		}
+	}();
+	// every band of a tile packs its rows once and streams all of b past them
+	const auto tile = [&](size_t i0, size_t i1, size_t j0, size_t j1) {
+		auto &pack_a = linalg::internal::gemm_workspace<std::int32_t>::local()._PackA;
+		auto &pack_b = linalg::internal::gemm_workspace<std::int16_t>::local()._PackB;
+		const size_t band = i1 - i0 < widening_band ? i1 - i0 : widening_band;
+		pack_a.reserve(linalg::widening_pack_a_size(band, k, set._Mr));
+		pack_b.reserve(linalg::widening_pack_b_size(k, set._Nr));
+		for (size_t r0 = i0; r0 < i1; r0 += band) {
+			const size_t rows = i1 - r0 < band ? i1 - r0 : band;
+			gemm(rows, j1 - j0, k, a + r0 * lda, lda, b + j0, ldb, c + r0 * ldc + j0, ldc, saturate, pack_a.data(), pack_b.data());
+		}
+	};
+	if (pool == nullptr || pool->size() == 1 || m * n * k < gemm_parallel_min) {
+		tile(0, m, 0, n);
+	} else {
+		// the float tiling: its mr matches the widening one, its column blocks are whole register widths
+		gemm_tiles<float>(m, n, *pool, tile);
+	}
+}
+
+}  // namespace internal
+
+namespace dispatch {
+
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+Ty sum(size_t n, const Ty *x) noexcept {
+	if constexpr (internal::dispatchable<Ty>) {
+		return kernels().get<Ty>()._Sum(n, x);
+	} else {
+		return internal::dispatch_kernels<Ty, nstd::internal::simd_scalar<Ty>>::sum(n, x);
+	}
+}
+
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+Ty dot(size_t n, const Ty *x, const Ty *y) noexcept {
+	if constexpr (internal::dispatchable<Ty>) {
+		return kernels().get<Ty>()._Dot(n, x, y);
+	} else {
+		return linalg::dot(n, x, y);
+	}
+}
+
+// y += alpha * x
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void axpy(size_t n, Ty alpha, const Ty *x, Ty *y) noexcept {
+	if constexpr (internal::dispatchable<Ty>) {
+		kernels().get<Ty>()._Axpy(n, alpha, x, y);
+	} else {
+		linalg::axpy(n, alpha, x, y);
+	}
+}
+
+// x *= alpha
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void scal(size_t n, Ty alpha, Ty *x) noexcept {
+	if constexpr (internal::dispatchable<Ty>) {
+		kernels().get<Ty>()._Scal(n, alpha, x);
+	} else {
+		linalg::scal(n, alpha, x);
+	}
+}
+
+// linalg::gemm through the active table, large products run on thread_pool::global()
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void gemm(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c, size_t ldc) {
+	NSTD_PROFILE_SCOPE("dispatch::gemm");
+	// the global pool is only created once a product is large enough to use it
+	thread_pool *pool = m * n * k < internal::gemm_parallel_min ? nullptr : &thread_pool::global();
+	internal::gemm_run(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, pool);
+}
+
+// the same on a given pool, thread_pool(1) keeps it on the calling thread
+template<typename Ty>
+    requires(std::is_arithmetic_v<Ty>)
+void gemm(size_t m, size_t n, size_t k, Ty alpha, const Ty *a, size_t lda, const Ty *b, size_t ldb, Ty beta, Ty *c, size_t ldc,
+          thread_pool &pool) {
+	NSTD_PROFILE_SCOPE("dispatch::gemm");
+	internal::gemm_run(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, &pool);
+}
+
+// sum of x[i] * y[i] in int32 for int8 / int16 inputs: wrapping like the instructions, or clamped when saturate
+template<typename Ty>
+    requires linalg::widening_input<Ty>
+std::int32_t widening_dot(size_t n, const Ty *x, const Ty *y, bool saturate = false) noexcept {
+	if constexpr (is_same_v<Ty, std::int8_t>) {
+		return kernels()._Widening._DotI8(n, x, y, saturate);
+	} else {
+		return kernels()._Widening._DotI16(n, x, y, saturate);
+	}
+}
+
+// c (m x n, int32) = a (m x k) * b (k x n) for int8 / int16 inputs, large products run on thread_pool::global()
+template<typename Ty>
+    requires linalg::widening_input<Ty>
+void widening_gemm(size_t m, size_t n, size_t k, const Ty *a, size_t lda, const Ty *b, size_t ldb, std::int32_t *c, size_t ldc,
+                   bool saturate = false) {
+	NSTD_PROFILE_SCOPE("dispatch::widening_gemm");
+	thread_pool *pool = m * n * k < internal::gemm_parallel_min ? nullptr : &thread_pool::global();
+	internal::widening_gemm_run(m, n, k, a, lda, b, ldb, c, ldc, saturate, pool);
+}
+
+template<typename Ty>
+    requires linalg::widening_input<Ty>
+void widening_gemm(size_t m, size_t n, size_t k, const Ty *a, size_t lda, const Ty *b, size_t ldb, std::int32_t *c, size_t ldc,
+                   bool saturate, thread_pool &pool) {
+	NSTD_PROFILE_SCOPE("dispatch::widening_gemm");
+	internal::widening_gemm_run(m, n, k, a, lda, b, ldb, c, ldc, saturate, &pool);
+}
+
+// whole-array forms for basic_ndarray
+template<typename Ty, bool exception, size_t... DimSize>
+Ty sum(const basic_ndarray<Ty, exception, DimSize...> &x) noexcept {
+	return sum(x.arr_size, x.data());
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+Ty dot(const basic_ndarray<Ty, exception, DimSize...> &x, const basic_ndarray<Ty, exception, DimSize...> &y) noexcept {
+	return dot(x.arr_size, x.data(), y.data());
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+void axpy(Ty alpha, const basic_ndarray<Ty, exception, DimSize...> &x, basic_ndarray<Ty, exception, DimSize...> &y) noexcept {
+	axpy(x.arr_size, alpha, x.data(), y.data());
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+void scal(Ty alpha, basic_ndarray<Ty, exception, DimSize...> &x) noexcept {
+	scal(x.arr_size, alpha, x.data());
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+    requires linalg::widening_input<Ty>
+std::int32_t widening_dot(const basic_ndarray<Ty, exception, DimSize...> &x, const basic_ndarray<Ty, exception, DimSize...> &y,
+                          bool saturate = false) noexcept {
+	return widening_dot(x.arr_size, x.data(), y.data(), saturate);
+}
+
+template<typename Ty, bool exception, size_t M, size_t K, size_t N>
+    requires linalg::widening_input<Ty>
+void widening_gemm(const basic_ndarray<Ty, exception, M, K> &a, const basic_ndarray<Ty, exception, K, N> &b,
+                   basic_ndarray<std::int32_t, exception, M, N> &c, bool saturate = false) {
+	widening_gemm(M, N, K, a.data(), K, b.data(), N, c.data(), N, saturate);
+}
+
+}  // namespace dispatch
+
+}  // namespace nstd
@@ -0,0 +1,19 @@
+// built with -mavx2 -mfma (/arch:AVX2), see xmake.lua
+#include <math/nstd_dispatch.h>
+
+namespace nstd {
+
+namespace internal {
+
+const kernel_table *kernels_avx2() noexcept {
+#if NSTD_SIMD_AVX && !NSTD_SIMD_AVX512
+	static constexpr kernel_table table = make_kernel_table<simd, simd_i16>(isa::avx2);
+	return &table;
+#else
+	return nullptr;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace nstd
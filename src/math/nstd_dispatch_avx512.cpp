@@ -0,0 +1,28 @@
+// built with -mavx512f -mavx512bw -mavx2 -mfma (/arch:AVX512), see xmake.lua
+#include <math/nstd_dispatch.h>
+
+namespace nstd {
+
+namespace internal {
+
+const kernel_table *kernels_avx512() noexcept {
+#if NSTD_SIMD_AVX512
+	static constexpr kernel_table table = make_kernel_table<simd, simd_i16>(isa::avx512);
+	// the same table with the vpdpwssd widening kernels, when both the build and the cpu have them
+	static const kernel_table vnni = [] {
+		kernel_table res = table;
+		const widening_kernel_set *set = widening_kernels_avx512vnni();
+		if (set != nullptr && cpu_info()._Avx512vnni) {
+			res._Widening = *set;
+		}
+		return res;
+	}();
+	return &vnni;
+#else
+	return nullptr;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace nstd
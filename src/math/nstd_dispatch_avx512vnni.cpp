@@ -0,0 +1,19 @@
+// built with -mavx512f -mavx512bw -mavx512vnni -mavx2 -mfma (/arch:AVX512), see xmake.lua
+#include <math/nstd_dispatch.h>
+
+namespace nstd {
+
+namespace internal {
+
+const widening_kernel_set *widening_kernels_avx512vnni() noexcept {
+#if NSTD_SIMD_VNNI
+	static constexpr widening_kernel_set set = widening_kernels<simd_i16>::set();
+	return &set;
+#else
+	return nullptr;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace nstd
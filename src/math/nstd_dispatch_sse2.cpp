@@ -0,0 +1,19 @@
+// built with the library's default flags (SSE2 on x86-64), see xmake.lua
+#include <math/nstd_dispatch.h>
+
+namespace nstd {
+
+namespace internal {
+
+const kernel_table *kernels_sse2() noexcept {
+#if NSTD_SIMD_SSE2 && !NSTD_SIMD_AVX
+	static constexpr kernel_table table = make_kernel_table<simd, simd_i16>(isa::sse2);
+	return &table;
+#else
+	return nullptr;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace nstd
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <math/linalg/nstd_gemm.h>
+#include <math/nstd_dispatch.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+ * einsum over fixed-shape basic_ndarrays: einsum<"bij,bjk->bik">(a, b)
+ * 1. the subscripts are a template argument, parsed and checked against the operand shapes at compile time;
+ *    one or two operands, letters as labels, "->" followed by the output labels (omitted: the labels used once, sorted)
+ * 2. a label repeated in one operand takes its diagonal, a label absent from the output is summed over
+ * 3. contractions of the form batch x (M x K) * (K x N) -> batch x (M x N), with each group of labels in the same
+ *    order everywhere, go to gemm (N empty: gemv, M empty: gemv_t); everything else runs one loop per label, nested
+ *    so that the labels with the smallest strides are innermost
+ * 4. einsum<S>(operands...) returns the result (a value for a full contraction), einsum<S>(operands..., out) overwrites out
+ */
+
+namespace nstd {
+
+// the subscripts string as a template argument
+template<size_t N>
+struct einsum_subscripts {
+	char _Str[N]{};
+
+	consteval einsum_subscripts(const char (&str)[N]) {
+		for (size_t i = 0; i < N; i++) {
+			_Str[i] = str[i];
+		}
+	}
+};
+
+namespace internal {
+
+inline constexpr size_t einsum_max_labels = 52;
+
+struct einsum_term {
+	char _Labels[einsum_max_labels]{};
+	size_t _Rank = 0;
+
+	constexpr size_t count(char label) const noexcept {
+		size_t res = 0;
+		for (size_t i = 0; i < _Rank; i++) {
+			res += _Labels[i] == label;
+		}
+		return res;
+	}
+};
+
+struct einsum_expr {
+	einsum_term _Inputs[2];
+	size_t _Operands = 0;
+	einsum_term _Output;
+};
+
+constexpr bool is_einsum_label(char c) noexcept {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// errors surface as compile errors at the throw
+template<size_t N>
+consteval einsum_expr parse_einsum(const einsum_subscripts<N> &spec) {
+	einsum_expr res;
+	einsum_term *term = &res._Inputs[0];
+	res._Operands = 1;
+	bool arrow = false;
+	for (size_t i = 0; i < N && spec._Str[i] != '\0'; i++) {
+		const char c = spec._Str[i];
+		if (c == ' ') {
+			continue;
+		}
+		if (c == ',' && !arrow) {
+			if (res._Operands == 2) {
+				throw std::runtime_error("einsum takes one or two operands!");
+			}
+			term = &res._Inputs[res._Operands++];
+		} else if (c == '-' && !arrow && i + 1 < N && spec._Str[i + 1] == '>') {
+			arrow = true;
+			term = &res._Output;
+			i++;
+		} else if (is_einsum_label(c) && term->_Rank < einsum_max_labels) {
+			term->_Labels[term->_Rank++] = c;
+		} else {
+			throw std::runtime_error("einsum subscripts malformed!");
+		}
+	}
+
+	auto uses = [&](char label) {
+		size_t n = 0;
+		for (size_t t = 0; t < res._Operands; t++) {
+			n += res._Inputs[t].count(label);
+		}
+		return n;
+	};
+	if (!arrow) {  // the labels used exactly once, in alphabetical order
+		for (char c : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz") {
+			if (c != '\0' && uses(c) == 1) {
+				res._Output._Labels[res._Output._Rank++] = c;
+			}
+		}
+	}
+	for (size_t i = 0; i < res._Output._Rank; i++) {
+		const char c = res._Output._Labels[i];
+		if (res._Output.count(c) != 1 || uses(c) == 0) {
+			throw std::runtime_error("einsum output label repeated or unknown!");
+		}
+	}
+	return res;
+}
+
+enum class einsum_route : unsigned char {
+	loops,
+	gemm,    // c = a * b per batch
+	gemv,    // N empty: c = a * b
+	gemv_t,  // M empty: c = b^T * a
+};
+
+// every distinct label with its extent and strides, the loop order and the gemm mapping
+struct einsum_plan {
+	size_t _Labels = 0;
+	char _Label[einsum_max_labels]{};
+	size_t _Extent[einsum_max_labels]{};
+	size_t _Stride[3][einsum_max_labels]{};  // operand 0, operand 1, output; 0 where the label is absent
+	size_t _Order[einsum_max_labels]{};      // outermost first
+	size_t _OutRank = 0;
+	size_t _OutShape[einsum_max_labels]{};
+
+	einsum_route _Route = einsum_route::loops;
+	bool _Swap = false;  // the gemm a operand is operand 1
+	size_t _Batch = 1, _M = 1, _N = 1, _K = 1;
+};
+
+constexpr bool einsum_has(const einsum_term &term, char label) noexcept {
+	return term.count(label) != 0;
+}
+
+// the labels of term that pass keep, in term order
+template<typename Pred>
+constexpr einsum_term einsum_filter(const einsum_term &term, Pred keep) noexcept {
+	einsum_term res;
+	for (size_t i = 0; i < term._Rank; i++) {
+		if (keep(term._Labels[i])) {
+			res._Labels[res._Rank++] = term._Labels[i];
+		}
+	}
+	return res;
+}
+
+constexpr bool einsum_is_concat(const einsum_term &term, const einsum_term &x, const einsum_term &y, const einsum_term &z) noexcept {
+	if (term._Rank != x._Rank + y._Rank + z._Rank) {
+		return false;
+	}
+	size_t i = 0;
+	for (const einsum_term *part : { &x, &y, &z }) {
+		for (size_t j = 0; j < part->_Rank; j++) {
+			if (term._Labels[i++] != part->_Labels[j]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// a (batch, M, K) * b (batch, K, N) -> out (batch, M, N), labels in one consistent order per group
+constexpr bool einsum_try_gemm(einsum_plan &plan, const einsum_term &a, const einsum_term &b, const einsum_term &out) noexcept {
+	for (const einsum_term *term : { &a, &b }) {
+		for (size_t i = 0; i < term->_Rank; i++) {
+			if (term->count(term->_Labels[i]) != 1) {
+				return false;  // diagonals
+			}
+		}
+	}
+	const einsum_term batch = einsum_filter(out, [&](char c) { return einsum_has(a, c) && einsum_has(b, c); });
+	const einsum_term m = einsum_filter(out, [&](char c) { return einsum_has(a, c) && !einsum_has(b, c); });
+	const einsum_term n = einsum_filter(out, [&](char c) { return !einsum_has(a, c) && einsum_has(b, c); });
+	const einsum_term k = einsum_filter(a, [&](char c) { return !einsum_has(out, c); });
+	if (k._Rank == 0 || !einsum_is_concat(a, batch, m, k) || !einsum_is_concat(b, batch, k, n) || !einsum_is_concat(out, batch, m, n)) {
+		return false;
+	}
+	auto extent = [&](const einsum_term &group) {
+		size_t res = 1;
+		for (size_t i = 0; i < group._Rank; i++) {
+			for (size_t l = 0; l < plan._Labels; l++) {
+				res *= plan._Label[l] == group._Labels[i] ? plan._Extent[l] : 1;
+			}
+		}
+		return res;
+	};
+	plan._Batch = extent(batch);
+	plan._M = extent(m);
+	plan._N = extent(n);
+	plan._K = extent(k);
+	plan._Route = n._Rank == 0 ? einsum_route::gemv : (m._Rank == 0 ? einsum_route::gemv_t : einsum_route::gemm);
+	return true;
+}
+
+template<typename Ty>
+struct einsum_operand_traits;
+
+template<typename Ty, bool exception, size_t... DimSize>
+struct einsum_operand_traits<basic_ndarray<Ty, exception, DimSize...>> {
+	using value_type = Ty;
+
+	static constexpr size_t rank = sizeof...(DimSize);
+	static constexpr size_t shape[] = { DimSize... };
+};
+
+template<einsum_subscripts Spec, typename... Operands>
+consteval einsum_plan make_einsum_plan() {
+	constexpr einsum_expr expr = parse_einsum(Spec);
+	static_assert(expr._Operands == sizeof...(Operands), "einsum operand count does not match the subscripts");
+	constexpr size_t ranks[] = { einsum_operand_traits<Operands>::rank... };
+	const size_t *shapes[] = { einsum_operand_traits<Operands>::shape... };
+	for (size_t t = 0; t < expr._Operands; t++) {
+		if (expr._Inputs[t]._Rank != ranks[t]) {
+			throw std::runtime_error("einsum subscripts do not match the operand ranks!");
+		}
+	}
+
+	einsum_plan plan;
+	for (size_t t = 0; t < expr._Operands; t++) {
+		const einsum_term &term = expr._Inputs[t];
+		size_t stride = 1;
+		for (size_t d = term._Rank; d-- > 0;) {
+			const char c = term._Labels[d];
+			size_t l = 0;
+			while (l < plan._Labels && plan._Label[l] != c) {
+				l++;
+			}
+			if (l == plan._Labels) {
+				plan._Label[l] = c;
+				plan._Extent[l] = shapes[t][d];
+				plan._Labels++;
+			} else if (plan._Extent[l] != shapes[t][d]) {
+				throw std::runtime_error("einsum label extents differ!");
+			}
+			plan._Stride[t][l] += stride;  // repeated labels walk the diagonal
+			stride *= shapes[t][d];
+		}
+	}
+	size_t stride = 1;
+	plan._OutRank = expr._Output._Rank;
+	for (size_t d = expr._Output._Rank; d-- > 0;) {
+		for (size_t l = 0; l < plan._Labels; l++) {
+			if (plan._Label[l] == expr._Output._Labels[d]) {
+				plan._Stride[2][l] = stride;
+				plan._OutShape[d] = plan._Extent[l];
+				stride *= plan._Extent[l];
+			}
+		}
+	}
+
+	// largest total stride outermost, ties keep the order of appearance
+	for (size_t l = 0; l < plan._Labels; l++) {
+		plan._Order[l] = l;
+	}
+	auto weight = [&](size_t l) { return plan._Stride[0][l] + plan._Stride[1][l] + plan._Stride[2][l]; };
+	for (size_t i = 1; i < plan._Labels; i++) {
+		for (size_t j = i; j > 0 && weight(plan._Order[j - 1]) < weight(plan._Order[j]); j--) {
+			const size_t tmp = plan._Order[j];
+			plan._Order[j] = plan._Order[j - 1];
+			plan._Order[j - 1] = tmp;
+		}
+	}
+
+	if (expr._Operands == 2) {
+		if (!einsum_try_gemm(plan, expr._Inputs[0], expr._Inputs[1], expr._Output)) {
+			plan._Swap = einsum_try_gemm(plan, expr._Inputs[1], expr._Inputs[0], expr._Output);
+		}
+	}
+	return plan;
+}
+
+// a basic_ndarray of the output shape, or a scalar for a full contraction
+template<typename Ty, einsum_plan Plan, typename = std::make_index_sequence<Plan._OutRank>>
+struct einsum_result;
+
+template<typename Ty, einsum_plan Plan>
+struct einsum_result<Ty, Plan, std::index_sequence<>> {
+	using type = Ty;
+};
+
+template<typename Ty, einsum_plan Plan, size_t... I>
+struct einsum_result<Ty, Plan, std::index_sequence<I...>> {
+	using type = basic_ndarray<Ty, false, Plan._OutShape[I]...>;
+};
+
+template<einsum_subscripts Spec, typename First, typename... Rest>
+struct einsum_program {
+	using value_type = typename einsum_operand_traits<First>::value_type;
+
+	static constexpr size_t operands = 1 + sizeof...(Rest);
+	static constexpr einsum_plan plan = make_einsum_plan<Spec, First, Rest...>();
+
+	using result = typename einsum_result<value_type, plan>::type;
+
+	// out += product over the remaining loops, out zeroed by the caller
+	template<size_t D>
+	static void loops(const value_type *a, const value_type *b, value_type *c) noexcept {
+		constexpr size_t l = plan._Order[D];
+		constexpr size_t extent = plan._Extent[l], sa = plan._Stride[0][l], sb = plan._Stride[1][l], sc = plan._Stride[2][l];
+		if constexpr (D + 1 < plan._Labels) {
+			for (size_t i = 0; i < extent; i++) {
+				loops<D + 1>(a + i * sa, b + i * sb, c + i * sc);
+			}
+		} else if constexpr (sc == 0) {  // innermost reduction, in a register
+			value_type acc = 0;
+			for (size_t i = 0; i < extent; i++) {
+				acc += operands == 2 ? a[i * sa] * b[i * sb] : a[i * sa];
+			}
+			*c += acc;
+		} else {
+			for (size_t i = 0; i < extent; i++) {
+				c[i * sc] += operands == 2 ? a[i * sa] * b[i * sb] : a[i * sa];
+			}
+		}
+	}
+
+	// c (batch x out size) = the contraction of x and y, c need not be initialized
+	static void run(const value_type *x, const value_type *y, value_type *c) {
+		NSTD_PROFILE_SCOPE("einsum");
+		constexpr size_t out_size = [] {
+			size_t res = 1;
+			for (size_t d = 0; d < plan._OutRank; d++) {
+				res *= plan._OutShape[d];
+			}
+			return res;
+		}();
+		if constexpr (plan._Route == einsum_route::loops) {
+			for (size_t i = 0; i < out_size; i++) {
+				c[i] = value_type(0);
+			}
+			loops<0>(x, y, c);
+		} else {
+			const value_type *a = plan._Swap ? y : x, *b = plan._Swap ? x : y;
+			constexpr size_t m = plan._M, n = plan._N, k = plan._K;
+			for (size_t batch = 0; batch < plan._Batch; batch++) {
+				const value_type *ab = a + batch * m * k, *bb = b + batch * k * n;
+				value_type *cb = c + batch * m * n;
+				if constexpr (plan._Route == einsum_route::gemm) {
+					dispatch::gemm(m, n, k, value_type(1), ab, k, bb, n, value_type(0), cb, n);
+				} else if constexpr (plan._Route == einsum_route::gemv) {
+					linalg::gemv(m, k, value_type(1), ab, k, bb, value_type(0), cb);
+				} else {
+					linalg::gemv_t(k, n, value_type(1), bb, n, ab, value_type(0), cb);
+				}
+			}
+		}
+	}
+};
+
+template<typename Ty>
+inline constexpr bool is_einsum_operand = false;
+
+template<typename Ty, bool exception, size_t... DimSize>
+inline constexpr bool is_einsum_operand<basic_ndarray<Ty, exception, DimSize...>> = true;
+
+}  // namespace internal
+
+// einsum<"ij,jk->ik">(a, b)
+template<einsum_subscripts Spec, typename Ty, bool exception, size_t... DimSize>
+auto einsum(const basic_ndarray<Ty, exception, DimSize...> &a) {
+	using program = internal::einsum_program<Spec, basic_ndarray<Ty, exception, DimSize...>>;
+	typename program::result res;
+	if constexpr (is_same_v<typename program::result, Ty>) {
+		program::run(a.data(), nullptr, &res);
+	} else {
+		program::run(a.data(), nullptr, res.data());
+	}
+	return res;
+}
+
+template<einsum_subscripts Spec, typename Ty, bool exception, size_t... DimSize, typename Rhs>
+    requires(internal::parse_einsum(Spec)._Operands == 2 && internal::is_einsum_operand<Rhs>)
+auto einsum(const basic_ndarray<Ty, exception, DimSize...> &a, const Rhs &b) {
+	using program = internal::einsum_program<Spec, basic_ndarray<Ty, exception, DimSize...>, Rhs>;
+	static_assert(is_same_v<typename Rhs::value_type, Ty>, "einsum operands must share the element type");
+	typename program::result res;
+	if constexpr (is_same_v<typename program::result, Ty>) {
+		program::run(a.data(), b.data(), &res);
+	} else {
+		program::run(a.data(), b.data(), res.data());
+	}
+	return res;
+}
+
+// the same, written into out (which must have the result shape)
+template<einsum_subscripts Spec, typename Ty, bool exception, size_t... DimSize, bool _exception, size_t... OutSize>
+    requires(internal::parse_einsum(Spec)._Operands == 1)
+void einsum(const basic_ndarray<Ty, exception, DimSize...> &a, basic_ndarray<Ty, _exception, OutSize...> &out) {
+	using program = internal::einsum_program<Spec, basic_ndarray<Ty, exception, DimSize...>>;
+	static_assert(is_same_v<typename program::result, basic_ndarray<Ty, false, OutSize...>>, "einsum output shape mismatch");
+	program::run(a.data(), nullptr, out.data());
+}
+
+template<einsum_subscripts Spec, typename Ty, bool exception, size_t... DimSize, typename Rhs, bool _exception, size_t... OutSize>
+    requires(internal::parse_einsum(Spec)._Operands == 2 && internal::is_einsum_operand<Rhs>)
+void einsum(const basic_ndarray<Ty, exception, DimSize...> &a, const Rhs &b, basic_ndarray<Ty, _exception, OutSize...> &out) {
+	using program = internal::einsum_program<Spec, basic_ndarray<Ty, exception, DimSize...>, Rhs>;
+	static_assert(is_same_v<typename program::result, basic_ndarray<Ty, false, OutSize...>>, "einsum output shape mismatch");
+	program::run(a.data(), b.data(), out.data());
+}
+
+}  // namespace nstd
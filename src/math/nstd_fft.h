@@ -0,0 +1,676 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/*
+ * discrete Fourier transforms of any length, X[k] = sum of x[j] * exp(-2 pi i jk / n)
+ * 1. a plan factors n into radices 4, 2, 3 and then any other primes and precomputes every twiddle once;
+ *    execution is a Stockham autosort pass per radix, no bit reversal, SIMD across the butterflies of a pass
+ * 2. forward is unnormalized, inverse scales by 1 / n, so inverse(forward(x)) == x
+ * 3. rfft_plan transforms real input of length n into its n / 2 + 1 non-redundant bins through a complex plan of n / 2
+ * 4. fftn_plan / rfftn_plan transform every axis of a grid, the lines of an axis are spread over a thread_pool
+ * 5. the butterflies use internal::simd rather than the xsimd package the build declares: xsimd is a private package of
+ *    the nonstd target, so this header-only template could not include it from the test and benchmark targets, and
+ *    simd<Ty> is the wrapper the gemm, stencil and convolution kernels already share
+ * ! assumptions !
+ * 1. data is split into real and imaginary arrays while it is transformed, the caller's std::complex layout is untouched
+ * 2. a plan is immutable once built: execute() is safe to call from several threads with their own work buffers,
+ *    forward() / inverse() use the plan's own buffer and are not
+ * 3. prime factors up to 64 run as a generic radix pass, O(p) per element; lengths with a larger prime factor are
+ *    computed as a chirp convolution (Bluestein) through a power-of-two plan of at least 2n - 1
+ */
+
+namespace nstd {
+
+namespace internal {
+
+template<typename Ty>
+struct fft_stage {
+	size_t _Radix;
+	size_t _Span;    // m = n / radix of the sub-transforms at this pass
+	size_t _Stride;  // s, the product of the radices before this pass
+	size_t _Twiddle;  // offset of this pass's (radix - 1) * m twiddles
+	size_t _Root;     // offset of the radix roots of unity, generic radices only
+};
+
+// the textbook product, without the inf / nan recovery of std::complex's operator*
+template<typename Ty>
+inline std::complex<Ty> fft_mul(const std::complex<Ty> &lhs, const std::complex<Ty> &rhs) noexcept {
+	return { lhs.real() * rhs.real() - lhs.imag() * rhs.imag(), lhs.real() * rhs.imag() + lhs.imag() * rhs.real() };
+}
+
+/*
+ * one Stockham pass: for p < m, q < s
+ *   a_k = x[q + s (p + k m)], y[q + s (r p + j)] = w_n^(jp) * sum of a_k w_r^(jk), n = r m
+ * Ops works on Ops::width consecutive q at once
+ */
+template<typename Ops, typename Ty>
+inline void fft_butterfly(const fft_stage<Ty> &stage, size_t p, size_t q, const Ty *xr, const Ty *xi, Ty *yr, Ty *yi, const Ty *twr,
+                          const Ty *twi, const Ty *rootr, const Ty *rooti) noexcept {
+	using reg = typename Ops::reg;
+	const size_t r = stage._Radix, m = stage._Span, s = stage._Stride;
+	const size_t in = q + s * p, in_step = s * m, out = q + s * r * p;
+	const Ty *wr = twr + stage._Twiddle + p * (r - 1), *wi = twi + stage._Twiddle + p * (r - 1);
+
+	// y_j * w, w = (c + i d)
+	auto store_twiddled = [&](size_t j, reg re, reg im) {
+		if (j == 0) {
+			Ops::store(yr + out, re);
+			Ops::store(yi + out, im);
+			return;
+		}
+		const reg c = Ops::set1(wr[j - 1]), d = Ops::set1(wi[j - 1]);
+		Ops::store(yr + out + j * s, Ops::fnmadd(im, d, Ops::mul(re, c)));
+		Ops::store(yi + out + j * s, Ops::fmadd(re, d, Ops::mul(im, c)));
+	};
+
+	switch (r) {
+	case 2: {
+		const reg a0r = Ops::load(xr + in), a0i = Ops::load(xi + in);
+		const reg a1r = Ops::load(xr + in + in_step), a1i = Ops::load(xi + in + in_step);
+		store_twiddled(0, Ops::add(a0r, a1r), Ops::add(a0i, a1i));
+		store_twiddled(1, Ops::sub(a0r, a1r), Ops::sub(a0i, a1i));
+		break;
+	}
+	case 3: {
+		const reg half = Ops::set1(Ty(0.5)), sin60 = Ops::set1(static_cast<Ty>(0.86602540378443864676372317075293618L));
+		const reg a0r = Ops::load(xr + in), a0i = Ops::load(xi + in);
+		const reg a1r = Ops::load(xr + in + in_step), a1i = Ops::load(xi + in + in_step);
+		const reg a2r = Ops::load(xr + in + 2 * in_step), a2i = Ops::load(xi + in + 2 * in_step);
+		const reg tr = Ops::add(a1r, a2r), ti = Ops::add(a1i, a2i);
+		const reg dr = Ops::mul(sin60, Ops::sub(a1r, a2r)), di = Ops::mul(sin60, Ops::sub(a1i, a2i));
+		const reg mr = Ops::fnmadd(half, tr, a0r), mi = Ops::fnmadd(half, ti, a0i);
+		store_twiddled(0, Ops::add(a0r, tr), Ops::add(a0i, ti));
+		store_twiddled(1, Ops::add(mr, di), Ops::sub(mi, dr));
+		store_twiddled(2, Ops::sub(mr, di), Ops::add(mi, dr));
+		break;
+	}
+	case 4: {
+		const reg a0r = Ops::load(xr + in), a0i = Ops::load(xi + in);
+		const reg a1r = Ops::load(xr + in + in_step), a1i = Ops::load(xi + in + in_step);
+		const reg a2r = Ops::load(xr + in + 2 * in_step), a2i = Ops::load(xi + in + 2 * in_step);
+		const reg a3r = Ops::load(xr + in + 3 * in_step), a3i = Ops::load(xi + in + 3 * in_step);
+		const reg t0r = Ops::add(a0r, a2r), t0i = Ops::add(a0i, a2i), t1r = Ops::sub(a0r, a2r), t1i = Ops::sub(a0i, a2i);
+		const reg t2r = Ops::add(a1r, a3r), t2i = Ops::add(a1i, a3i), t3r = Ops::sub(a1r, a3r), t3i = Ops::sub(a1i, a3i);
+		store_twiddled(0, Ops::add(t0r, t2r), Ops::add(t0i, t2i));
+		store_twiddled(1, Ops::add(t1r, t3i), Ops::sub(t1i, t3r));
+		store_twiddled(2, Ops::sub(t0r, t2r), Ops::sub(t0i, t2i));
+		store_twiddled(3, Ops::sub(t1r, t3i), Ops::add(t1i, t3r));
+		break;
+	}
+	default:  // any other prime, O(r^2): the inputs are reloaded per output instead of kept in registers
+		for (size_t j = 0; j < r; j++) {
+			reg accr = Ops::load(xr + in), acci = Ops::load(xi + in);
+			for (size_t k = 1, jk = j; k < r; k++, jk = (jk + j) % r) {
+				const reg ar = Ops::load(xr + in + k * in_step), ai = Ops::load(xi + in + k * in_step);
+				const reg c = Ops::set1(rootr[stage._Root + jk]), d = Ops::set1(rooti[stage._Root + jk]);
+				accr = Ops::fnmadd(ai, d, Ops::fmadd(ar, c, accr));
+				acci = Ops::fmadd(ar, d, Ops::fmadd(ai, c, acci));
+			}
+			store_twiddled(j, accr, acci);
+		}
+		break;
+	}
+}
+
+}  // namespace internal
+
+// fft_plan BEGINS
+template<typename Ty>
+    requires(std::is_floating_point_v<Ty>)
+class fft_plan {
+	using stage_type = internal::fft_stage<Ty>;
+
+	size_t _Size = 0;
+	std::vector<stage_type> _Stages;
+	aligned_buffer<Ty> _TwiddleRe, _TwiddleIm;  // per pass, w_n^(jp) for p < m, 1 <= j < r
+	aligned_buffer<Ty> _RootRe, _RootIm;        // per generic pass, w_r^k for k < r
+	std::shared_ptr<const fft_plan> _Inner;     // Bluestein only
+	std::vector<std::complex<Ty>> _Chirp;       // exp(-i pi k^2 / n), k < n
+	std::vector<std::complex<Ty>> _Filter;      // transform of the conjugate chirp, wrapped to the inner size
+	aligned_buffer<Ty> _Work;
+
+	static constexpr size_t _MaxRadix = 64;
+
+	// X_k = w_k * sum of (x_j w_j) conj(w_(k - j)), the sum a cyclic convolution of the inner size
+	void _impl_bluestein(const std::complex<Ty> *in, ptrdiff_t in_stride, std::complex<Ty> *out, ptrdiff_t out_stride, bool inverse,
+	                     Ty *work) const noexcept {
+		const size_t n = _Size, len = _Inner->size();
+		std::complex<Ty> *a = reinterpret_cast<std::complex<Ty> *>(work);
+		Ty *inner_work = work + 2 * len;
+		for (size_t k = 0; k < n; k++) {
+			const std::complex<Ty> v = in[static_cast<ptrdiff_t>(k) * in_stride];
+			a[k] = internal::fft_mul(inverse ? std::conj(v) : v, _Chirp[k]);
+		}
+		for (size_t k = n; k < len; k++) {
+			a[k] = 0;
+		}
+		_Inner->execute(a, 1, a, 1, false, inner_work);
+		for (size_t k = 0; k < len; k++) {
+			a[k] = internal::fft_mul(a[k], _Filter[k]);
+		}
+		_Inner->execute(a, 1, a, 1, true, inner_work);
+		const Ty scale = inverse ? Ty(1) / static_cast<Ty>(n) : Ty(1);
+		for (size_t k = 0; k < n; k++) {
+			const std::complex<Ty> v = internal::fft_mul(a[k], _Chirp[k]) * scale;
+			out[static_cast<ptrdiff_t>(k) * out_stride] = inverse ? std::conj(v) : v;
+		}
+	}
+
+	// split -> stages -> interleave; inverse conjugates on the way in and out
+	void _impl_execute(const std::complex<Ty> *in, ptrdiff_t in_stride, std::complex<Ty> *out, ptrdiff_t out_stride, bool inverse,
+	                   Ty *work) const noexcept {
+		if (_Inner) {
+			_impl_bluestein(in, in_stride, out, out_stride, inverse, work);
+			return;
+		}
+		const size_t n = _Size;
+		Ty *xr = work, *xi = work + n, *yr = work + 2 * n, *yi = work + 3 * n;
+		const Ty sign = inverse ? Ty(-1) : Ty(1);
+		for (size_t i = 0; i < n; i++) {
+			const std::complex<Ty> v = in[static_cast<ptrdiff_t>(i) * in_stride];
+			xr[i] = v.real();
+			xi[i] = sign * v.imag();
+		}
+
+		using vec = nstd::internal::simd<Ty>;
+		for (const stage_type &stage : _Stages) {
+			const Ty *twr = _TwiddleRe.data(), *twi = _TwiddleIm.data(), *rr = _RootRe.data(), *ri = _RootIm.data();
+			for (size_t p = 0; p < stage._Span; p++) {
+				size_t q = 0;
+				for (; q + vec::width <= stage._Stride; q += vec::width) {
+					internal::fft_butterfly<vec>(stage, p, q, xr, xi, yr, yi, twr, twi, rr, ri);
+				}
+				for (; q < stage._Stride; q++) {
+					internal::fft_butterfly<nstd::internal::simd_scalar<Ty>>(stage, p, q, xr, xi, yr, yi, twr, twi, rr, ri);
+				}
+			}
+			std::swap(xr, yr);
+			std::swap(xi, yi);
+		}
+
+		const Ty scale = inverse ? Ty(1) / static_cast<Ty>(n) : Ty(1);
+		for (size_t i = 0; i < n; i++) {
+			out[static_cast<ptrdiff_t>(i) * out_stride] = std::complex<Ty>(scale * xr[i], sign * scale * xi[i]);
+		}
+	}
+
+public:
+	fft_plan() noexcept = default;
+
+	explicit fft_plan(size_t n)
+	    : _Size(n) {
+		if (n == 0) {
+			throw std::runtime_error("fft_plan size must be positive!");
+		}
+		std::vector<size_t> radices;
+		size_t rest = n;
+		for (size_t r : { 4, 2, 3 }) {
+			for (; rest % r == 0; rest /= r) {
+				radices.push_back(r);
+			}
+		}
+		for (size_t r = 5; r * r <= rest; r += 2) {
+			for (; rest % r == 0; rest /= r) {
+				radices.push_back(r);
+			}
+		}
+		if (rest > 1) {
+			radices.push_back(rest);
+		}
+
+		// twiddles in long double, rounded once
+		constexpr long double tau = 2.0L * std::numbers::pi_v<long double>;
+		if (!radices.empty() && radices.back() > _MaxRadix) {
+			size_t len = 1;
+			while (len < 2 * n - 1) {
+				len *= 2;
+			}
+			_Inner = std::make_shared<const fft_plan>(len);
+			_Chirp.resize(n);
+			_Filter.assign(len, std::complex<Ty>(0));
+			for (size_t k = 0; k < n; k++) {
+				const long double angle = -tau / 2.0L * static_cast<long double>(k * k % (2 * n)) / static_cast<long double>(n);
+				_Chirp[k] = std::complex<Ty>(static_cast<Ty>(std::cos(angle)), static_cast<Ty>(std::sin(angle)));
+				_Filter[k] = std::conj(_Chirp[k]);
+				if (k != 0) {
+					_Filter[len - k] = _Filter[k];
+				}
+			}
+			aligned_buffer<Ty> work(_Inner->work_size());
+			_Inner->execute(_Filter.data(), 1, _Filter.data(), 1, false, work.data());
+			return;
+		}
+		size_t span = n, stride = 1, twiddles = 0, roots = 0;
+		for (size_t r : radices) {
+			span /= r;
+			_Stages.push_back({ r, span, stride, twiddles, roots });
+			twiddles += (r - 1) * span;
+			roots += r > 4 ? r : 0;
+			stride *= r;
+		}
+		_TwiddleRe.resize(twiddles);
+		_TwiddleIm.resize(twiddles);
+		_RootRe.resize(roots);
+		_RootIm.resize(roots);
+		for (const stage_type &stage : _Stages) {
+			const size_t len = stage._Radix * stage._Span;
+			for (size_t p = 0; p < stage._Span; p++) {
+				for (size_t j = 1; j < stage._Radix; j++) {
+					const long double angle = -tau * static_cast<long double>(j * p % len) / static_cast<long double>(len);
+					_TwiddleRe[stage._Twiddle + p * (stage._Radix - 1) + j - 1] = static_cast<Ty>(std::cos(angle));
+					_TwiddleIm[stage._Twiddle + p * (stage._Radix - 1) + j - 1] = static_cast<Ty>(std::sin(angle));
+				}
+			}
+			if (stage._Radix > 4) {
+				for (size_t k = 0; k < stage._Radix; k++) {
+					const long double angle = -tau * static_cast<long double>(k) / static_cast<long double>(stage._Radix);
+					_RootRe[stage._Root + k] = static_cast<Ty>(std::cos(angle));
+					_RootIm[stage._Root + k] = static_cast<Ty>(std::sin(angle));
+				}
+			}
+		}
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	// elements of Ty execute() needs as work space
+	size_t work_size() const noexcept {
+		return _Inner ? 2 * _Inner->size() + _Inner->work_size() : 4 * _Size;
+	}
+
+	// size() elements from in[0], in[in_stride], ... to out[0], out[out_stride], ...; in may equal out
+	void execute(const std::complex<Ty> *in, ptrdiff_t in_stride, std::complex<Ty> *out, ptrdiff_t out_stride, bool inverse,
+	             Ty *work) const noexcept {
+		NSTD_PROFILE_SCOPE("fft_plan::execute");
+		_impl_execute(in, in_stride, out, out_stride, inverse, work);
+	}
+
+	void forward(const std::complex<Ty> *in, std::complex<Ty> *out) {
+		_Work.resize(work_size());
+		execute(in, 1, out, 1, false, _Work.data());
+	}
+
+	void inverse(const std::complex<Ty> *in, std::complex<Ty> *out) {
+		_Work.resize(work_size());
+		execute(in, 1, out, 1, true, _Work.data());
+	}
+};
+// fft_plan ENDS
+
+// rfft_plan BEGINS
+/*
+ * real input of length n, n / 2 + 1 output bins (the rest are their conjugates)
+ * 1. even n: the even / odd samples become the real / imaginary parts of one complex transform of n / 2,
+ *    the bins are untangled with one more twiddle per bin
+ * 2. odd n: a complex transform of n
+ */
+template<typename Ty>
+    requires(std::is_floating_point_v<Ty>)
+class rfft_plan {
+	size_t _Size = 0;
+	fft_plan<Ty> _Half;
+	aligned_buffer<Ty> _TwiddleRe, _TwiddleIm;  // exp(-2 pi i k / n), k <= n / 4
+	aligned_buffer<Ty> _Work;
+
+	// (z[k] + conj(z[h - k])) / 2 and its counterpart, for both directions
+	void _impl_untangle(std::complex<Ty> *z, bool inverse) const noexcept {
+		const size_t h = _Size / 2;
+		for (size_t k = 0; k <= h / 2; k++) {
+			const size_t l = h - k;
+			const std::complex<Ty> a = z[k], b = std::conj(z[l]);
+			const std::complex<Ty> w(_TwiddleRe[k], inverse ? -_TwiddleIm[k] : _TwiddleIm[k]);
+			const std::complex<Ty> even = (a + b) * Ty(0.5), odd = (a - b) * Ty(0.5);
+			if (!inverse) {
+				// X_k = E_k + w^k O_k with O_k = (a - b) / 2i
+				const std::complex<Ty> rot = internal::fft_mul(w, std::complex<Ty>(odd.imag(), -odd.real()));
+				if (k == 0) {
+					z[0] = std::complex<Ty>(a.real() + a.imag(), 0);
+					z[h] = std::complex<Ty>(a.real() - a.imag(), 0);
+					continue;
+				}
+				z[k] = even + rot;
+				z[l] = std::conj(even - rot);
+			} else {
+				// Z_k = E_k + i O_k with O_k = (X_k - conj(X_{h - k})) conj(w^k) / 2
+				const std::complex<Ty> rot = internal::fft_mul(w, odd);
+				const std::complex<Ty> zk = even + std::complex<Ty>(-rot.imag(), rot.real());
+				const std::complex<Ty> zl = std::conj(even) + std::complex<Ty>(rot.imag(), rot.real());  // the same at h - k
+				z[k] = zk;
+				if (k != 0) {
+					z[l] = zl;
+				}
+			}
+		}
+	}
+
+public:
+	rfft_plan() noexcept = default;
+
+	explicit rfft_plan(size_t n)
+	    : _Size(n), _Half(n % 2 == 0 ? n / 2 : n) {
+		if (n % 2 == 0) {
+			constexpr long double tau = 2.0L * std::numbers::pi_v<long double>;
+			_TwiddleRe.resize(n / 4 + 1);
+			_TwiddleIm.resize(n / 4 + 1);
+			for (size_t k = 0; k <= n / 4; k++) {
+				const long double angle = -tau * static_cast<long double>(k) / static_cast<long double>(n);
+				_TwiddleRe[k] = static_cast<Ty>(std::cos(angle));
+				_TwiddleIm[k] = static_cast<Ty>(std::sin(angle));
+			}
+		}
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	// n / 2 + 1
+	size_t bins() const noexcept {
+		return _Size / 2 + 1;
+	}
+
+	size_t work_size() const noexcept {
+		return _Half.work_size() + 2 * (_Half.size() + 1);
+	}
+
+	void execute_forward(const Ty *in, ptrdiff_t in_stride, std::complex<Ty> *out, ptrdiff_t out_stride, Ty *work) const noexcept {
+		NSTD_PROFILE_SCOPE("rfft_plan::execute_forward");
+		std::complex<Ty> *z = reinterpret_cast<std::complex<Ty> *>(work + _Half.work_size());
+		const size_t h = _Half.size();
+		if (_Size % 2 != 0) {
+			for (size_t i = 0; i < h; i++) {
+				z[i] = std::complex<Ty>(in[static_cast<ptrdiff_t>(i) * in_stride], 0);
+			}
+			_Half.execute(z, 1, z, 1, false, work);
+		} else {
+			for (size_t i = 0; i < h; i++) {
+				z[i] = std::complex<Ty>(in[static_cast<ptrdiff_t>(2 * i) * in_stride], in[static_cast<ptrdiff_t>(2 * i + 1) * in_stride]);
+			}
+			_Half.execute(z, 1, z, 1, false, work);
+			z[h] = z[0];
+			_impl_untangle(z, false);
+		}
+		for (size_t k = 0; k < bins(); k++) {
+			out[static_cast<ptrdiff_t>(k) * out_stride] = z[k];
+		}
+	}
+
+	// the imaginary parts of bin 0 (and of bin n / 2 for even n) are ignored
+	void execute_inverse(const std::complex<Ty> *in, ptrdiff_t in_stride, Ty *out, ptrdiff_t out_stride, Ty *work) const noexcept {
+		NSTD_PROFILE_SCOPE("rfft_plan::execute_inverse");
+		std::complex<Ty> *z = reinterpret_cast<std::complex<Ty> *>(work + _Half.work_size());
+		const size_t h = _Half.size();
+		if (_Size % 2 != 0) {
+			for (size_t k = 0; k < bins(); k++) {
+				z[k] = in[static_cast<ptrdiff_t>(k) * in_stride];
+			}
+			z[0].imag(0);
+			for (size_t k = bins(); k < h; k++) {
+				z[k] = std::conj(z[h - k]);
+			}
+			_Half.execute(z, 1, z, 1, true, work);
+			for (size_t i = 0; i < h; i++) {
+				out[static_cast<ptrdiff_t>(i) * out_stride] = z[i].real();
+			}
+			return;
+		}
+		for (size_t k = 0; k < h; k++) {
+			z[k] = in[static_cast<ptrdiff_t>(k) * in_stride];
+		}
+		const Ty first = z[0].real(), last = in[static_cast<ptrdiff_t>(h) * in_stride].real();
+		z[h] = std::complex<Ty>(last, 0);
+		z[0] = std::complex<Ty>(first, 0);
+		_impl_untangle(z, true);
+		_Half.execute(z, 1, z, 1, true, work);
+		for (size_t i = 0; i < h; i++) {
+			out[static_cast<ptrdiff_t>(2 * i) * out_stride] = z[i].real();
+			out[static_cast<ptrdiff_t>(2 * i + 1) * out_stride] = z[i].imag();
+		}
+	}
+
+	void forward(const Ty *in, std::complex<Ty> *out) {
+		_Work.resize(work_size());
+		execute_forward(in, 1, out, 1, _Work.data());
+	}
+
+	void inverse(const std::complex<Ty> *in, Ty *out) {
+		_Work.resize(work_size());
+		execute_inverse(in, 1, out, 1, _Work.data());
+	}
+};
+// rfft_plan ENDS
+
+namespace internal {
+
+// element offset of the first element of line along dim, lines numbered row-major over the other dimensions
+template<size_t Rank>
+size_t fft_line_offset(size_t line, const size_t (&extents)[Rank], const size_t (&strides)[Rank], size_t dim) noexcept {
+	size_t offset = 0;
+	for (size_t d = Rank; d-- > 0;) {
+		if (d != dim) {
+			offset += line % extents[d] * strides[d];
+			line /= extents[d];
+		}
+	}
+	return offset;
+}
+
+// fn(line, work) for every line along dim, lines split over the pool, one work buffer per chunk
+template<typename Ty, size_t Rank, typename Fn>
+void for_each_fft_line(const size_t (&extents)[Rank], size_t dim, size_t work_size, thread_pool *pool, Fn &&fn) {
+	size_t lines = 1;
+	for (size_t d = 0; d < Rank; d++) {
+		lines *= d == dim ? 1 : extents[d];
+	}
+	auto chunk = [&](size_t lo, size_t hi) {
+		aligned_buffer<Ty> work(work_size);
+		for (size_t line = lo; line < hi; line++) {
+			fn(line, work.data());
+		}
+	};
+	if (pool == nullptr || pool->size() == 1 || lines < 2) {
+		chunk(0, lines);
+	} else {
+		pool->parallel_for(0, lines, chunk);
+	}
+}
+
+}  // namespace internal
+
+// fftn_plan BEGINS
+// complex transform over every axis of a grid with the given extents, in place on views of that shape
+template<typename Ty, size_t Rank>
+    requires(std::is_floating_point_v<Ty> && Rank > 0)
+class fftn_plan {
+	size_t _Extents[Rank];
+	std::vector<fft_plan<Ty>> _Plans;  // per axis
+
+	template<bool exception>
+	void _impl_execute(const basic_strided_view<std::complex<Ty>, exception, Rank> &data, bool inverse, thread_pool *pool) const {
+		size_t extents[Rank], strides[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			if (data.extent(d) != _Extents[d]) {
+				throw std::runtime_error("fftn_plan dimension mismatch!");
+			}
+			extents[d] = data.extent(d);
+			strides[d] = data.stride(d);
+		}
+		for (size_t d = 0; d < Rank; d++) {
+			if (extents[d] == 1) {
+				continue;
+			}
+			const fft_plan<Ty> &plan = _Plans[d];
+			const ptrdiff_t stride = static_cast<ptrdiff_t>(strides[d]);
+			internal::for_each_fft_line<Ty>(extents, d, plan.work_size(), pool, [&](size_t line, Ty *work) {
+				std::complex<Ty> *first = data.data() + internal::fft_line_offset(line, extents, strides, d);
+				plan.execute(first, stride, first, stride, inverse, work);
+			});
+		}
+	}
+
+public:
+	explicit fftn_plan(const size_t (&extents)[Rank]) {
+		for (size_t d = 0; d < Rank; d++) {
+			_Extents[d] = extents[d];
+			_Plans.emplace_back(extents[d]);
+		}
+	}
+
+	size_t extent(size_t dim) const noexcept {
+		return _Extents[dim];
+	}
+
+	template<bool exception>
+	void forward(const basic_strided_view<std::complex<Ty>, exception, Rank> &data, thread_pool *pool = nullptr) const {
+		NSTD_PROFILE_SCOPE("fftn_plan::forward");
+		_impl_execute(data, false, pool);
+	}
+
+	template<bool exception>
+	void inverse(const basic_strided_view<std::complex<Ty>, exception, Rank> &data, thread_pool *pool = nullptr) const {
+		NSTD_PROFILE_SCOPE("fftn_plan::inverse");
+		_impl_execute(data, true, pool);
+	}
+
+	template<bool exception, size_t... DimSize>
+	    requires(sizeof...(DimSize) == Rank)
+	void forward(basic_ndarray<std::complex<Ty>, exception, DimSize...> &arr, thread_pool *pool = nullptr) const {
+		forward(basic_strided_view<std::complex<Ty>, exception, Rank>(arr), pool);
+	}
+
+	template<bool exception, size_t... DimSize>
+	    requires(sizeof...(DimSize) == Rank)
+	void inverse(basic_ndarray<std::complex<Ty>, exception, DimSize...> &arr, thread_pool *pool = nullptr) const {
+		inverse(basic_strided_view<std::complex<Ty>, exception, Rank>(arr), pool);
+	}
+};
+// fftn_plan ENDS
+
+// rfftn_plan BEGINS
+/*
+ * real grid -> complex grid whose last extent is n / 2 + 1: rfft along the last axis, then complex transforms of the others
+ * inverse transforms the outer axes of its input in place, i.e. it overwrites the spectrum
+ */
+template<typename Ty, size_t Rank>
+    requires(std::is_floating_point_v<Ty> && Rank > 0)
+class rfftn_plan {
+	size_t _Extents[Rank];
+	rfft_plan<Ty> _Last;
+	std::vector<fft_plan<Ty>> _Plans;  // outer axes
+
+	void _impl_check(const size_t *real, const size_t *spectrum) const {
+		for (size_t d = 0; d < Rank; d++) {
+			const size_t expected = d + 1 == Rank ? _Last.bins() : _Extents[d];
+			if (real[d] != _Extents[d] || spectrum[d] != expected) {
+				throw std::runtime_error("rfftn_plan dimension mismatch!");
+			}
+		}
+	}
+
+	void _impl_outer(std::complex<Ty> *data, const size_t (&extents)[Rank], const size_t (&strides)[Rank], bool inverse, thread_pool *pool) const {
+		for (size_t d = 0; d + 1 < Rank; d++) {
+			if (extents[d] == 1) {
+				continue;
+			}
+			const fft_plan<Ty> &plan = _Plans[d];
+			const ptrdiff_t stride = static_cast<ptrdiff_t>(strides[d]);
+			internal::for_each_fft_line<Ty>(extents, d, plan.work_size(), pool, [&](size_t line, Ty *work) {
+				std::complex<Ty> *first = data + internal::fft_line_offset(line, extents, strides, d);
+				plan.execute(first, stride, first, stride, inverse, work);
+			});
+		}
+	}
+
+public:
+	explicit rfftn_plan(const size_t (&extents)[Rank])
+	    : _Last(extents[Rank - 1]) {
+		for (size_t d = 0; d < Rank; d++) {
+			_Extents[d] = extents[d];
+			if (d + 1 < Rank) {
+				_Plans.emplace_back(extents[d]);
+			}
+		}
+	}
+
+	size_t extent(size_t dim) const noexcept {
+		return _Extents[dim];
+	}
+
+	// extent of the spectrum along the last axis
+	size_t bins() const noexcept {
+		return _Last.bins();
+	}
+
+	template<bool e0, bool e1>
+	void forward(const basic_strided_view<const Ty, e0, Rank> &in, const basic_strided_view<std::complex<Ty>, e1, Rank> &out,
+	             thread_pool *pool = nullptr) const {
+		NSTD_PROFILE_SCOPE("rfftn_plan::forward");
+		size_t in_extents[Rank], in_strides[Rank], out_extents[Rank], out_strides[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			in_extents[d] = in.extent(d);
+			in_strides[d] = in.stride(d);
+			out_extents[d] = out.extent(d);
+			out_strides[d] = out.stride(d);
+		}
+		_impl_check(in_extents, out_extents);
+		internal::for_each_fft_line<Ty>(out_extents, Rank - 1, _Last.work_size(), pool, [&](size_t line, Ty *work) {
+			_Last.execute_forward(in.data() + internal::fft_line_offset(line, in_extents, in_strides, Rank - 1),
+			                      static_cast<ptrdiff_t>(in_strides[Rank - 1]),
+			                      out.data() + internal::fft_line_offset(line, out_extents, out_strides, Rank - 1),
+			                      static_cast<ptrdiff_t>(out_strides[Rank - 1]), work);
+		});
+		_impl_outer(out.data(), out_extents, out_strides, false, pool);
+	}
+
+	template<bool e0, bool e1>
+	void inverse(const basic_strided_view<std::complex<Ty>, e0, Rank> &in, const basic_strided_view<Ty, e1, Rank> &out,
+	             thread_pool *pool = nullptr) const {
+		NSTD_PROFILE_SCOPE("rfftn_plan::inverse");
+		size_t in_extents[Rank], in_strides[Rank], out_extents[Rank], out_strides[Rank];
+		for (size_t d = 0; d < Rank; d++) {
+			in_extents[d] = in.extent(d);
+			in_strides[d] = in.stride(d);
+			out_extents[d] = out.extent(d);
+			out_strides[d] = out.stride(d);
+		}
+		_impl_check(out_extents, in_extents);
+		_impl_outer(in.data(), in_extents, in_strides, true, pool);
+		internal::for_each_fft_line<Ty>(in_extents, Rank - 1, _Last.work_size(), pool, [&](size_t line, Ty *work) {
+			_Last.execute_inverse(in.data() + internal::fft_line_offset(line, in_extents, in_strides, Rank - 1),
+			                      static_cast<ptrdiff_t>(in_strides[Rank - 1]),
+			                      out.data() + internal::fft_line_offset(line, out_extents, out_strides, Rank - 1),
+			                      static_cast<ptrdiff_t>(out_strides[Rank - 1]), work);
+		});
+	}
+};
+// rfftn_plan ENDS
+
+// in-place transforms of a whole basic_ndarray, one plan per call
+template<typename Ty, bool exception, size_t... DimSize>
+void fft(basic_ndarray<std::complex<Ty>, exception, DimSize...> &arr, thread_pool *pool = nullptr) {
+	fftn_plan<Ty, sizeof...(DimSize)>({ DimSize... }).forward(arr, pool);
+}
+
+template<typename Ty, bool exception, size_t... DimSize>
+void ifft(basic_ndarray<std::complex<Ty>, exception, DimSize...> &arr, thread_pool *pool = nullptr) {
+	fftn_plan<Ty, sizeof...(DimSize)>({ DimSize... }).inverse(arr, pool);
+}
+
+}  // namespace nstd
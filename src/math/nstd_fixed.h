@@ -0,0 +1,288 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/*
+ * saturating integer arithmetic and signed fixed-point numbers
+ * 1. add_sat / sub_sat / mul_sat / div_sat / saturate_cast follow the C++26 <numeric> functions of the same names:
+ *    a result outside the range of the type is clamped to its nearest bound instead of wrapping (or being undefined)
+ * 2. q<Int, Frac> stores value * 2^Frac in Int; every operation saturates, and results that fall between two
+ *    representable values (products, quotients, conversions from floating point) round to nearest, ties to even
+ * 3. q is a regular value type with explicit conversions from / to arithmetic types, so it can be the element type
+ *    of matrix, ndarray and friends; q15 / q31 are the usual DSP formats, q16_16 the usual general-purpose one
+ * ! assumptions !
+ * 1. Int is a signed integer of at most 32 bits, so that products and shifted dividends fit in long long
+ */
+
+namespace nstd {
+
+// saturating BEGINS
+template<typename Ty>
+    requires(std::is_integral_v<Ty> && !std::is_same_v<Ty, bool>)
+constexpr Ty add_sat(Ty lhs, Ty rhs) noexcept {
+	constexpr Ty max = std::numeric_limits<Ty>::max(), min = std::numeric_limits<Ty>::min();
+	if constexpr (std::is_signed_v<Ty>) {
+		if (rhs > 0 && lhs > max - rhs) {
+			return max;
+		}
+		if (rhs < 0 && lhs < min - rhs) {
+			return min;
+		}
+		return static_cast<Ty>(lhs + rhs);
+	} else {
+		return lhs > max - rhs ? max : static_cast<Ty>(lhs + rhs);
+	}
+}
+
+template<typename Ty>
+    requires(std::is_integral_v<Ty> && !std::is_same_v<Ty, bool>)
+constexpr Ty sub_sat(Ty lhs, Ty rhs) noexcept {
+	constexpr Ty max = std::numeric_limits<Ty>::max(), min = std::numeric_limits<Ty>::min();
+	if constexpr (std::is_signed_v<Ty>) {
+		if (rhs < 0 && lhs > max + rhs) {
+			return max;
+		}
+		if (rhs > 0 && lhs < min + rhs) {
+			return min;
+		}
+		return static_cast<Ty>(lhs - rhs);
+	} else {
+		return lhs < rhs ? min : static_cast<Ty>(lhs - rhs);
+	}
+}
+
+// to's range clamps from, floating-point values truncate toward zero and NaN becomes 0
+template<typename To, typename From>
+    requires(std::is_integral_v<To> && !std::is_same_v<To, bool> && std::is_arithmetic_v<From>)
+constexpr To saturate_cast(From val) noexcept {
+	constexpr To max = std::numeric_limits<To>::max(), min = std::numeric_limits<To>::min();
+	if constexpr (std::is_floating_point_v<From>) {
+		if (val != val) {
+			return To(0);
+		}
+		if (val >= static_cast<From>(max)) {
+			return max;
+		}
+		if (val <= static_cast<From>(min)) {
+			return min;
+		}
+		return static_cast<To>(val);
+	} else {
+		if (std::cmp_greater(val, max)) {
+			return max;
+		}
+		if (std::cmp_less(val, min)) {
+			return min;
+		}
+		return static_cast<To>(val);
+	}
+}
+
+template<typename Ty>
+    requires(std::is_integral_v<Ty> && !std::is_same_v<Ty, bool>)
+constexpr Ty mul_sat(Ty lhs, Ty rhs) noexcept {
+	if constexpr (sizeof(Ty) < sizeof(long long)) {
+		// the exact product fits the wider type
+		using wide = std::conditional_t<std::is_signed_v<Ty>, long long, unsigned long long>;
+		return saturate_cast<Ty>(static_cast<wide>(lhs) * static_cast<wide>(rhs));
+	} else {
+		constexpr Ty max = std::numeric_limits<Ty>::max(), min = std::numeric_limits<Ty>::min();
+		if (lhs == 0 || rhs == 0) {
+			return Ty(0);
+		}
+		if constexpr (std::is_signed_v<Ty>) {
+			const bool negative = (lhs < 0) != (rhs < 0);
+			if (lhs > 0 ? (rhs > 0 ? lhs > max / rhs : rhs < min / lhs) : (rhs > 0 ? lhs < min / rhs : lhs < max / rhs)) {
+				return negative ? min : max;
+			}
+		} else if (lhs > max / rhs) {
+			return max;
+		}
+		return static_cast<Ty>(lhs * rhs);
+	}
+}
+
+// rhs must not be 0, min / -1 saturates to max
+template<typename Ty>
+    requires(std::is_integral_v<Ty> && !std::is_same_v<Ty, bool>)
+constexpr Ty div_sat(Ty lhs, Ty rhs) noexcept {
+	if constexpr (std::is_signed_v<Ty>) {
+		if (lhs == std::numeric_limits<Ty>::min() && rhs == -1) {
+			return std::numeric_limits<Ty>::max();
+		}
+	}
+	return static_cast<Ty>(lhs / rhs);
+}
+// saturating ENDS
+
+namespace internal {
+
+// value / 2^shift rounded to nearest, ties to even
+constexpr long long round_shift(long long value, int shift) noexcept {
+	if (shift == 0) {
+		return value;
+	}
+	const long long floor = value >> shift;
+	const long long rem = value - floor * (1LL << shift);
+	const long long half = 1LL << (shift - 1);
+	return floor + ((rem > half || (rem == half && (floor & 1) != 0)) ? 1 : 0);
+}
+
+// num / den rounded to nearest, ties to even, den != 0
+constexpr long long round_div(long long num, long long den) noexcept {
+	const long long quot = num / den, rem = num % den;
+	const unsigned long long twice = 2 * static_cast<unsigned long long>(rem < 0 ? -rem : rem);
+	const unsigned long long mag = static_cast<unsigned long long>(den < 0 ? -den : den);
+	if (twice > mag || (twice == mag && (quot & 1) != 0)) {
+		return (num < 0) != (den < 0) ? quot - 1 : quot + 1;
+	}
+	return quot;
+}
+
+// a finite value already within the range of long long, rounded to nearest, ties to even
+template<typename Fp>
+constexpr long long round_even(Fp val) noexcept {
+	long long floor = static_cast<long long>(val);
+	if (static_cast<Fp>(floor) > val) {
+		floor--;
+	}
+	const Fp frac = val - static_cast<Fp>(floor);
+	return floor + ((frac > Fp(0.5) || (frac == Fp(0.5) && (floor & 1) != 0)) ? 1 : 0);
+}
+
+}  // namespace internal
+
+// fixed_point BEGINS
+template<typename Int, int Frac>
+    requires(std::is_integral_v<Int> && std::is_signed_v<Int> && sizeof(Int) <= 4 && Frac >= 0 && Frac < int(sizeof(Int) * 8))
+class q {
+	Int _Raw = 0;
+
+	static constexpr long long one = 1LL << Frac;
+
+	static constexpr q saturate(long long raw) noexcept {
+		return from_raw(saturate_cast<Int>(raw));
+	}
+
+public:
+	using raw_type = Int;
+	static constexpr int frac_bits = Frac;
+
+	constexpr q() noexcept = default;
+
+	template<typename Ty>
+	    requires(std::is_arithmetic_v<Ty>)
+	constexpr explicit q(Ty val) noexcept {
+		if constexpr (std::is_floating_point_v<Ty>) {
+			const long double scaled = static_cast<long double>(val) * one;
+			if (val != val) {
+				_Raw = 0;
+			} else if (scaled >= static_cast<long double>(std::numeric_limits<Int>::max())) {
+				_Raw = std::numeric_limits<Int>::max();
+			} else if (scaled <= static_cast<long double>(std::numeric_limits<Int>::min())) {
+				_Raw = std::numeric_limits<Int>::min();
+			} else {
+				_Raw = static_cast<Int>(internal::round_even(scaled));
+			}
+		} else {
+			// clamp first so that the shift cannot overflow
+			_Raw = saturate_cast<Int>(saturate_cast<Int>(val) * one);
+		}
+	}
+
+	static constexpr q from_raw(Int raw) noexcept {
+		q res;
+		res._Raw = raw;
+		return res;
+	}
+
+	constexpr Int raw() const noexcept {
+		return _Raw;
+	}
+
+	// floating point: exact for float / double whenever the mantissa is wide enough; integers truncate toward zero
+	template<typename Ty>
+	    requires(std::is_arithmetic_v<Ty>)
+	constexpr explicit operator Ty() const noexcept {
+		if constexpr (std::is_floating_point_v<Ty>) {
+			return static_cast<Ty>(static_cast<long double>(_Raw) / one);
+		} else {
+			return static_cast<Ty>(_Raw / one);
+		}
+	}
+
+	static constexpr q min() noexcept {
+		return from_raw(std::numeric_limits<Int>::min());
+	}
+
+	static constexpr q max() noexcept {
+		return from_raw(std::numeric_limits<Int>::max());
+	}
+
+	static constexpr q epsilon() noexcept {
+		return from_raw(1);
+	}
+
+	constexpr q operator+() const noexcept {
+		return *this;
+	}
+
+	constexpr q operator-() const noexcept {
+		return saturate(-static_cast<long long>(_Raw));
+	}
+
+	constexpr q operator+(q rhs) const noexcept {
+		return from_raw(add_sat(_Raw, rhs._Raw));
+	}
+
+	constexpr q operator-(q rhs) const noexcept {
+		return from_raw(sub_sat(_Raw, rhs._Raw));
+	}
+
+	constexpr q operator*(q rhs) const noexcept {
+		return saturate(internal::round_shift(static_cast<long long>(_Raw) * rhs._Raw, Frac));
+	}
+
+	// division by zero saturates toward the sign of the dividend (0 / 0 is 0)
+	constexpr q operator/(q rhs) const noexcept {
+		if (rhs._Raw == 0) {
+			return _Raw > 0 ? max() : _Raw < 0 ? min() : q();
+		}
+		return saturate(internal::round_div(static_cast<long long>(_Raw) * one, rhs._Raw));
+	}
+
+	constexpr q &operator+=(q rhs) noexcept {
+		return *this = *this + rhs;
+	}
+
+	constexpr q &operator-=(q rhs) noexcept {
+		return *this = *this - rhs;
+	}
+
+	constexpr q &operator*=(q rhs) noexcept {
+		return *this = *this * rhs;
+	}
+
+	constexpr q &operator/=(q rhs) noexcept {
+		return *this = *this / rhs;
+	}
+
+	constexpr bool operator==(const q &) const noexcept = default;
+	constexpr auto operator<=>(const q &) const noexcept = default;
+};
+
+using q7 = q<std::int8_t, 7>;
+using q15 = q<std::int16_t, 15>;
+using q31 = q<std::int32_t, 31>;
+using q8_8 = q<std::int16_t, 8>;
+using q16_16 = q<std::int32_t, 16>;
+// fixed_point ENDS
+
+}  // namespace nstd
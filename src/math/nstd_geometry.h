@@ -0,0 +1,438 @@
+#pragma once
+
+#include <math/linalg/nstd_matrix.h>
+#include <math/linalg/nstd_vector.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_bounds.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/*
+ * batch intersection and culling tests over structure-of-arrays packets, one result bit per primitive
+ * 1. aabb_packet / sphere_packet / triangle_packet / point_packet keep every coordinate in an array of its own,
+ *    zero-padded to whole registers of the widest simd type, and are filled from linalg::vector3f data
+ * 2. every test overwrites mask_words(n) words of mask: primitive i is bit i % 64 of word i / 64, bits past n are 0;
+ *    it returns the number of bits set
+ * 3. ray / aabb is the slab test, ray / triangle is Moller-Trumbore (two-sided), both within [_TMin, _TMax] of the ray
+ * 4. culling keeps whatever is not entirely outside one plane of the frustum: conservative, a box next to a corner
+ *    of the frustum may be kept although it is outside
+ * ! assumptions !
+ * 1. frustum::from_matrix takes a view-projection matrix for column vectors (clip = m * p) with clip depth in
+ *    [-w, w], the OpenGL convention
+ * 2. a ray with a zero direction component whose origin lies exactly on a box face of that axis has an unspecified
+ *    result for that box (0 * inf in the slab test)
+ */
+
+namespace nstd {
+
+struct aabb {
+	linalg::vector3f _Min;
+	linalg::vector3f _Max;
+};
+
+struct ray {
+	linalg::vector3f _Origin;
+	linalg::vector3f _Dir;
+	float _TMin = 0.0f;
+	float _TMax = std::numeric_limits<float>::infinity();
+};
+
+// the points p with dot(_Normal, p) + _Dist >= 0 are inside
+struct plane {
+	linalg::vector3f _Normal;
+	float _Dist = 0.0f;
+};
+
+struct frustum {
+	plane _Planes[6];  // left, right, bottom, top, near, far
+
+	// Gribb / Hartmann: each plane is row 3 of m plus or minus another row, normalized so that _Dist is a distance
+	static frustum from_matrix(const linalg::matrix4f &m) noexcept {
+		frustum res;
+		for (size_t p = 0; p < 6; p++) {
+			const size_t row = p / 2;
+			const float sign = p % 2 == 0 ? 1.0f : -1.0f;
+			float coef[4];
+			for (size_t j = 0; j < 4; j++) {
+				coef[j] = m.at(3, j) + sign * m.at(row, j);
+			}
+			const float len = std::sqrt(coef[0] * coef[0] + coef[1] * coef[1] + coef[2] * coef[2]);
+			const float scale = len > 0.0f ? 1.0f / len : 1.0f;
+			res._Planes[p] = { linalg::vector3f(coef[0] * scale, coef[1] * scale, coef[2] * scale), coef[3] * scale };
+		}
+		return res;
+	}
+};
+
+// words of a result mask for n primitives
+inline constexpr size_t mask_words(size_t n) noexcept {
+	return (n + 63) / 64;
+}
+
+inline bool mask_test(const std::uint64_t *mask, size_t i) noexcept {
+	return (mask[i / 64] >> (i % 64) & 1) != 0;
+}
+
+namespace internal {
+
+// Fields arrays of n floats, each padded to a multiple of pad with zeros
+template<size_t Fields>
+class soa_storage {
+	aligned_buffer<float> _Data;
+	size_t _Size = 0;
+	size_t _Stride = 0;
+
+public:
+	static constexpr size_t pad = 16;  // lanes of the widest register, simd<float> on AVX-512
+
+	soa_storage() noexcept = default;
+
+	explicit soa_storage(size_t n)
+	    : _Data((n + pad - 1) / pad * pad * Fields, 0.0f), _Size(n), _Stride((n + pad - 1) / pad * pad) {
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	bool empty() const noexcept {
+		return _Size == 0;
+	}
+
+	float *field(size_t f) noexcept {
+		return _Data.data() + f * _Stride;
+	}
+
+	const float *field(size_t f) const noexcept {
+		return _Data.data() + f * _Stride;
+	}
+
+	void store(size_t f, size_t i, const linalg::vector3f &v) noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		for (size_t a = 0; a < 3; a++) {
+			field(f + a)[i] = v[a];
+		}
+	}
+
+	linalg::vector3f load(size_t f, size_t i) const noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return linalg::vector3f(field(f)[i], field(f + 1)[i], field(f + 2)[i]);
+	}
+};
+
+// runs lanes(i) -> bitmask for i = 0, width, 2 * width, ... < n and packs the results into mask
+template<typename Vec, typename Fn>
+size_t pack_mask(size_t n, std::uint64_t *mask, Fn &&lanes) noexcept {
+	constexpr size_t width = Vec::width;
+	static_assert(64 % width == 0 && width <= soa_storage<1>::pad);
+	for (size_t w = 0; w < mask_words(n); w++) {
+		mask[w] = 0;
+	}
+	for (size_t i = 0; i < n; i += width) {
+		unsigned bits = lanes(i);
+		if (n - i < width) {
+			bits &= (1u << (n - i)) - 1;  // the padding lanes
+		}
+		mask[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+	}
+	size_t hits = 0;
+	for (size_t w = 0; w < mask_words(n); w++) {
+		hits += static_cast<size_t>(std::popcount(mask[w]));
+	}
+	return hits;
+}
+
+}  // namespace internal
+
+// packets BEGINS
+class aabb_packet : public internal::soa_storage<6> {
+	using base = internal::soa_storage<6>;
+
+public:
+	aabb_packet() noexcept = default;
+
+	// n boxes, all at the origin with zero extent
+	explicit aabb_packet(size_t n)
+	    : base(n) {
+	}
+
+	aabb_packet(const aabb *boxes, size_t n)
+	    : base(n) {
+		for (size_t i = 0; i < n; i++) {
+			set(i, boxes[i]);
+		}
+	}
+
+	void set(size_t i, const aabb &box) noexcept {
+		base::store(0, i, box._Min);
+		base::store(3, i, box._Max);
+	}
+
+	aabb get(size_t i) const noexcept {
+		return { base::load(0, i), base::load(3, i) };
+	}
+
+	const float *min(size_t axis) const noexcept {
+		return base::field(axis);
+	}
+
+	const float *max(size_t axis) const noexcept {
+		return base::field(3 + axis);
+	}
+};
+
+class sphere_packet : public internal::soa_storage<4> {
+	using base = internal::soa_storage<4>;
+
+public:
+	sphere_packet() noexcept = default;
+
+	explicit sphere_packet(size_t n)
+	    : base(n) {
+	}
+
+	sphere_packet(const linalg::vector3f *centers, const float *radii, size_t n)
+	    : base(n) {
+		for (size_t i = 0; i < n; i++) {
+			set(i, centers[i], radii[i]);
+		}
+	}
+
+	void set(size_t i, const linalg::vector3f &center, float radius) noexcept {
+		base::store(0, i, center);
+		base::field(3)[i] = radius;
+	}
+
+	linalg::vector3f get_center(size_t i) const noexcept {
+		return base::load(0, i);
+	}
+
+	float get_radius(size_t i) const noexcept {
+		NSTD_BOUNDS_ASSERT(i < size());
+		return base::field(3)[i];
+	}
+
+	const float *center(size_t axis) const noexcept {
+		return base::field(axis);
+	}
+
+	const float *radius() const noexcept {
+		return base::field(3);
+	}
+};
+
+// stored as the first vertex and the two edges leaving it, what Moller-Trumbore reads
+class triangle_packet : public internal::soa_storage<9> {
+	using base = internal::soa_storage<9>;
+
+public:
+	triangle_packet() noexcept = default;
+
+	explicit triangle_packet(size_t n)
+	    : base(n) {
+	}
+
+	// triangle i is (vertices[3i], vertices[3i + 1], vertices[3i + 2])
+	triangle_packet(const linalg::vector3f *vertices, size_t n)
+	    : base(n) {
+		for (size_t i = 0; i < n; i++) {
+			set(i, vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]);
+		}
+	}
+
+	void set(size_t i, const linalg::vector3f &v0, const linalg::vector3f &v1, const linalg::vector3f &v2) noexcept {
+		base::store(0, i, v0);
+		base::store(3, i, v1 - v0);
+		base::store(6, i, v2 - v0);
+	}
+
+	const float *vertex(size_t axis) const noexcept {
+		return base::field(axis);
+	}
+
+	const float *edge1(size_t axis) const noexcept {
+		return base::field(3 + axis);
+	}
+
+	const float *edge2(size_t axis) const noexcept {
+		return base::field(6 + axis);
+	}
+};
+
+class point_packet : public internal::soa_storage<3> {
+	using base = internal::soa_storage<3>;
+
+public:
+	point_packet() noexcept = default;
+
+	explicit point_packet(size_t n)
+	    : base(n) {
+	}
+
+	point_packet(const linalg::vector3f *points, size_t n)
+	    : base(n) {
+		for (size_t i = 0; i < n; i++) {
+			set(i, points[i]);
+		}
+	}
+
+	void set(size_t i, const linalg::vector3f &point) noexcept {
+		base::store(0, i, point);
+	}
+
+	linalg::vector3f get(size_t i) const noexcept {
+		return base::load(0, i);
+	}
+
+	const float *coord(size_t axis) const noexcept {
+		return base::field(axis);
+	}
+};
+// packets ENDS
+
+// batch_queries BEGINS
+// bit i: r hits box i within [r._TMin, r._TMax]
+template<typename Vec = nstd::internal::simd<float>>
+size_t intersect(const ray &r, const aabb_packet &boxes, std::uint64_t *mask) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	reg origin[3], inv[3];
+	for (size_t a = 0; a < 3; a++) {
+		origin[a] = vec::set1(r._Origin[a]);
+		inv[a] = vec::set1(1.0f / r._Dir[a]);
+	}
+	const reg tmin = vec::set1(r._TMin), tmax = vec::set1(r._TMax);
+	return internal::pack_mask<Vec>(boxes.size(), mask, [&](size_t i) {
+		reg near = tmin, far = tmax;
+		for (size_t a = 0; a < 3; a++) {
+			const reg t0 = vec::mul(vec::sub(vec::load(boxes.min(a) + i), origin[a]), inv[a]);
+			const reg t1 = vec::mul(vec::sub(vec::load(boxes.max(a) + i), origin[a]), inv[a]);
+			near = vec::max(vec::min(t0, t1), near);
+			far = vec::min(vec::max(t0, t1), far);
+		}
+		return vec::le_mask(near, far);
+	});
+}
+
+// bit i: r hits triangle i within [r._TMin, r._TMax]; t (optional, tris.size() floats) gets the distances, +inf on a miss
+template<typename Vec = nstd::internal::simd<float>>
+size_t intersect(const ray &r, const triangle_packet &tris, std::uint64_t *mask, float *t = nullptr) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	reg o[3], d[3];
+	for (size_t a = 0; a < 3; a++) {
+		o[a] = vec::set1(r._Origin[a]);
+		d[a] = vec::set1(r._Dir[a]);
+	}
+	const reg zero = vec::zero(), one = vec::set1(1.0f), tmin = vec::set1(r._TMin), tmax = vec::set1(r._TMax);
+	const size_t n = tris.size();
+	return internal::pack_mask<Vec>(n, mask, [&](size_t i) {
+		const reg e1[3] = { vec::load(tris.edge1(0) + i), vec::load(tris.edge1(1) + i), vec::load(tris.edge1(2) + i) };
+		const reg e2[3] = { vec::load(tris.edge2(0) + i), vec::load(tris.edge2(1) + i), vec::load(tris.edge2(2) + i) };
+		const reg s[3] = { vec::sub(o[0], vec::load(tris.vertex(0) + i)), vec::sub(o[1], vec::load(tris.vertex(1) + i)),
+			               vec::sub(o[2], vec::load(tris.vertex(2) + i)) };
+		// p = d x e2, q = s x e1
+		const reg p[3] = { vec::fnmadd(d[2], e2[1], vec::mul(d[1], e2[2])), vec::fnmadd(d[0], e2[2], vec::mul(d[2], e2[0])),
+			               vec::fnmadd(d[1], e2[0], vec::mul(d[0], e2[1])) };
+		const reg q[3] = { vec::fnmadd(s[2], e1[1], vec::mul(s[1], e1[2])), vec::fnmadd(s[0], e1[2], vec::mul(s[2], e1[0])),
+			               vec::fnmadd(s[1], e1[0], vec::mul(s[0], e1[1])) };
+		// a parallel ray makes det 0 and u, v, dist NaN or infinite, which every comparison below rejects
+		const reg det = vec::fmadd(e1[2], p[2], vec::fmadd(e1[1], p[1], vec::mul(e1[0], p[0])));
+		const reg inv = vec::div(one, det);
+		const reg u = vec::mul(vec::fmadd(s[2], p[2], vec::fmadd(s[1], p[1], vec::mul(s[0], p[0]))), inv);
+		const reg v = vec::mul(vec::fmadd(d[2], q[2], vec::fmadd(d[1], q[1], vec::mul(d[0], q[0]))), inv);
+		const reg dist = vec::mul(vec::fmadd(e2[2], q[2], vec::fmadd(e2[1], q[1], vec::mul(e2[0], q[0]))), inv);
+		const unsigned bits = vec::le_mask(zero, u) & vec::le_mask(zero, v) & vec::le_mask(vec::add(u, v), one) &
+		                      vec::le_mask(tmin, dist) & vec::le_mask(dist, tmax);
+		if (t != nullptr) {
+			float lanes[vec::width];
+			vec::store(lanes, dist);
+			for (size_t l = 0; l < vec::width && i + l < n; l++) {
+				t[i + l] = (bits >> l & 1) != 0 ? lanes[l] : std::numeric_limits<float>::infinity();
+			}
+		}
+		return bits;
+	});
+}
+
+// bit i: box i is not entirely outside any plane of f
+template<typename Vec = nstd::internal::simd<float>>
+size_t cull(const frustum &f, const aabb_packet &boxes, std::uint64_t *mask) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	// the corner farthest along the normal: the max coordinate where the normal is positive, the min elsewhere;
+	// splitting the normal into its positive and negative parts picks it without a branch per lane block
+	reg positive[6][3], negative[6][3], dist[6];
+	for (size_t p = 0; p < 6; p++) {
+		for (size_t a = 0; a < 3; a++) {
+			const float n = f._Planes[p]._Normal[a];
+			positive[p][a] = vec::set1(n > 0.0f ? n : 0.0f);
+			negative[p][a] = vec::set1(n > 0.0f ? 0.0f : n);
+		}
+		dist[p] = vec::set1(f._Planes[p]._Dist);
+	}
+	return internal::pack_mask<Vec>(boxes.size(), mask, [&](size_t i) {
+		const reg lo[3] = { vec::load(boxes.min(0) + i), vec::load(boxes.min(1) + i), vec::load(boxes.min(2) + i) };
+		const reg hi[3] = { vec::load(boxes.max(0) + i), vec::load(boxes.max(1) + i), vec::load(boxes.max(2) + i) };
+		reg nearest = vec::set1(std::numeric_limits<float>::infinity());
+		for (size_t p = 0; p < 6; p++) {
+			reg s = dist[p];
+			for (size_t a = 0; a < 3; a++) {
+				s = vec::fmadd(negative[p][a], lo[a], vec::fmadd(positive[p][a], hi[a], s));
+			}
+			nearest = vec::min(nearest, s);
+		}
+		return vec::le_mask(vec::zero(), nearest);
+	});
+}
+
+// bit i: sphere i is not entirely outside any plane of f
+template<typename Vec = nstd::internal::simd<float>>
+size_t cull(const frustum &f, const sphere_packet &spheres, std::uint64_t *mask) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	reg normal[6][3], dist[6];
+	for (size_t p = 0; p < 6; p++) {
+		for (size_t a = 0; a < 3; a++) {
+			normal[p][a] = vec::set1(f._Planes[p]._Normal[a]);
+		}
+		dist[p] = vec::set1(f._Planes[p]._Dist);
+	}
+	return internal::pack_mask<Vec>(spheres.size(), mask, [&](size_t i) {
+		const reg c[3] = { vec::load(spheres.center(0) + i), vec::load(spheres.center(1) + i), vec::load(spheres.center(2) + i) };
+		reg nearest = vec::set1(std::numeric_limits<float>::infinity());
+		for (size_t p = 0; p < 6; p++) {
+			nearest = vec::min(nearest, vec::fmadd(normal[p][2], c[2], vec::fmadd(normal[p][1], c[1], vec::fmadd(normal[p][0], c[0], dist[p]))));
+		}
+		return vec::le_mask(vec::zero(), vec::add(nearest, vec::load(spheres.radius() + i)));
+	});
+}
+
+// bit i: point i lies in box, faces included
+template<typename Vec = nstd::internal::simd<float>>
+size_t contains(const aabb &box, const point_packet &points, std::uint64_t *mask) noexcept {
+	using vec = Vec;
+	using reg = typename vec::reg;
+	reg lo[3], hi[3];
+	for (size_t a = 0; a < 3; a++) {
+		lo[a] = vec::set1(box._Min[a]);
+		hi[a] = vec::set1(box._Max[a]);
+	}
+	return internal::pack_mask<Vec>(points.size(), mask, [&](size_t i) {
+		unsigned bits = ~0u;
+		for (size_t a = 0; a < 3; a++) {
+			const reg x = vec::load(points.coord(a) + i);
+			bits &= vec::le_mask(lo[a], x) & vec::le_mask(x, hi[a]);
+		}
+		return bits;
+	});
+}
+// batch_queries ENDS
+
+}  // namespace nstd
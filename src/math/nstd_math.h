@@ -1,5 +1,10 @@
 #pragma once
 
+// TODO: REMOVE these deps in future versions
+#include <bit>
+#include <cmath>
+#include <limits>
+
 namespace nstd {
 
 // TODO: constrain Ty to signed numbers
@@ -24,4 +29,74 @@ constexpr bool is_approx(Ty lhs, Ty rhs, Ty relative_tolerance) {
 	return abs(lhs - rhs) <= max(abs(lhs), abs(rhs)) * relative_tolerance;
 }
 
+namespace internal {
+
+// correctly rounded square root of a finite positive double, digit by digit on the integer mantissa
+consteval double soft_sqrt(double x) {
+	const unsigned long long bits = std::bit_cast<unsigned long long>(x);
+	unsigned long long mant = bits & 0xf'ffff'ffff'ffffull;
+	long long e = static_cast<long long>(bits >> 52);
+	if (e == 0) {  // subnormal: normalize the mantissa
+		e = 1;
+		while ((mant & (1ull << 52)) == 0) {
+			mant <<= 1;
+			e--;
+		}
+	} else {
+		mant |= 1ull << 52;
+	}
+	e -= 1023;
+	if (e & 1) {  // x = mant * 2^(e - 52) with an even exponent, mant in [2^52, 2^54)
+		mant <<= 1;
+		e--;
+	}
+
+	// q = floor(sqrt(mant * 2^54)), a 54-bit root: 53 bits of result and a rounding bit, rem != 0 is the sticky bit
+	unsigned long long q = 0, rem = 0;
+	for (int i = 0; i < 54; i++) {
+		const int shift = 52 - 2 * i;
+		const unsigned long long pair = shift >= 0 ? (mant >> shift) & 3 : 0;
+		rem = (rem << 2) | pair;
+		const unsigned long long trial = (q << 2) | 1;
+		q <<= 1;
+		if (rem >= trial) {
+			rem -= trial;
+			q |= 1;
+		}
+	}
+	unsigned long long res = q >> 1;
+	if ((q & 1) && (rem != 0 || (res & 1))) {
+		res++;
+	}
+	long long res_exp = e / 2 + 1023;
+	if (res >> 53) {
+		res >>= 1;
+		res_exp++;
+	}
+	return std::bit_cast<double>((static_cast<unsigned long long>(res_exp) << 52) | (res & 0xf'ffff'ffff'ffffull));
+}
+
+}  // namespace internal
+
+/*
+ * std::sqrt at run time, a correctly rounded software square root during constant evaluation
+ * 1. the two paths agree to the last bit for float / double (long double is evaluated in double at compile time)
+ * 2. integral arguments behave like static_cast<Ty>(std::sqrt(x))
+ */
+template<typename Ty>
+constexpr Ty sqrt(Ty x) {
+	if consteval {
+		const double val = static_cast<double>(x);
+		if (val != val || val < 0.0) {
+			return std::numeric_limits<Ty>::quiet_NaN();
+		}
+		if (val == 0.0 || val == std::numeric_limits<double>::infinity()) {
+			return x;
+		}
+		return static_cast<Ty>(internal::soft_sqrt(val));
+	} else {
+		return static_cast<Ty>(std::sqrt(x));
+	}
+}
+
 }  // namespace nstd
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <container/nstd_ndarray.h>
+#include <memory/nstd_aligned_buffer.h>
+#include <util/nstd_profile.h>
+#include <util/nstd_simd.h>
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * stencils over dense row-major grids, out[x] = sum of w * in[x + offset] over the taps
+ * 1. a stencil is a constant (passed as a template argument), so offsets and weights are compile-time constants
+ * 2. every row is one branch-free SIMD loop over the cells whose taps stay inside the row; the boundary policy is
+ *    applied once per row to pick the source row of each tap, and per cell only within the radius of the row ends
+ * 3. boundary policies:
+ *    clamp_boundary repeats the edge, wrap_boundary is periodic, constant_boundary reads a fixed value outside
+ * 4. in and out must not alias; iterate_stencil ping-pongs between two grids and can block several time steps
+ */
+
+namespace nstd {
+
+template<typename Ty, size_t Rank>
+struct stencil_tap {
+	int _Offset[Rank];
+	Ty _Weight;
+};
+
+template<typename Ty, size_t Rank, size_t Taps>
+    requires(Rank > 0 && Taps > 0)
+struct stencil {
+	using value_type = Ty;
+
+	static constexpr size_t rank = Rank;
+	static constexpr size_t taps = Taps;
+
+	stencil_tap<Ty, Rank> _Taps[Taps];
+
+	// largest |offset| along dim
+	constexpr size_t radius(size_t dim) const noexcept {
+		size_t res = 0;
+		for (size_t t = 0; t < Taps; t++) {
+			const int o = _Taps[t]._Offset[dim];
+			const size_t r = static_cast<size_t>(o < 0 ? -o : o);
+			res = r > res ? r : res;
+		}
+		return res;
+	}
+};
+
+namespace stencils {
+
+template<typename Ty>
+inline constexpr stencil<Ty, 2, 5> laplacian5{ {
+	{ { 0, 0 }, Ty(-4) },
+	{ { -1, 0 }, Ty(1) },
+	{ { 1, 0 }, Ty(1) },
+	{ { 0, -1 }, Ty(1) },
+	{ { 0, 1 }, Ty(1) },
+} };
+
+template<typename Ty>
+inline constexpr stencil<Ty, 3, 7> laplacian7{ {
+	{ { 0, 0, 0 }, Ty(-6) },
+	{ { -1, 0, 0 }, Ty(1) },
+	{ { 1, 0, 0 }, Ty(1) },
+	{ { 0, -1, 0 }, Ty(1) },
+	{ { 0, 1, 0 }, Ty(1) },
+	{ { 0, 0, -1 }, Ty(1) },
+	{ { 0, 0, 1 }, Ty(1) },
+} };
+
+// the 3 x 3 x 3 mean
+template<typename Ty>
+inline constexpr stencil<Ty, 3, 27> box27 = [] {
+	stencil<Ty, 3, 27> res{};
+	for (int t = 0; t < 27; t++) {
+		res._Taps[t] = { { t / 9 - 1, t / 3 % 3 - 1, t % 3 - 1 }, Ty(1) / Ty(27) };
+	}
+	return res;
+}();
+
+}  // namespace stencils
+
+// boundary policies BEGINS
+// map() moves an out-of-range coordinate back into [0, n), or returns false when the policy supplies a value instead
+struct clamp_boundary {
+	constexpr bool map(ptrdiff_t &i, size_t n) const noexcept {
+		i = i < 0 ? 0 : (i >= static_cast<ptrdiff_t>(n) ? static_cast<ptrdiff_t>(n) - 1 : i);
+		return true;
+	}
+};
+
+struct wrap_boundary {
+	constexpr bool map(ptrdiff_t &i, size_t n) const noexcept {
+		const ptrdiff_t len = static_cast<ptrdiff_t>(n);
+		if (i < 0 || i >= len) {  // offsets rarely exceed the extent, one add or subtract is the common case
+			i += i < 0 ? len : -len;
+			if (i < 0 || i >= len) {
+				i %= len;
+				i += i < 0 ? len : 0;
+			}
+		}
+		return true;
+	}
+};
+
+template<typename Ty>
+struct constant_boundary {
+	Ty _Value{};
+
+	constexpr bool map(ptrdiff_t &i, size_t n) const noexcept {
+		return i >= 0 && i < static_cast<ptrdiff_t>(n);
+	}
+};
+// boundary policies ENDS
+
+namespace internal {
+
+template<auto S, size_t Rank = decltype(S)::rank>
+struct stencil_geometry {
+	using value_type = typename decltype(S)::value_type;
+
+	size_t _Extents[Rank];
+	size_t _Strides[Rank];
+	size_t _Radius[Rank];
+	ptrdiff_t _Offsets[decltype(S)::taps];  // linear offset of every tap across the outer Rank - 1 dimensions
+
+	explicit stencil_geometry(const size_t (&extents)[Rank]) noexcept {
+		size_t stride = 1;
+		for (size_t d = Rank; d-- > 0;) {
+			_Extents[d] = extents[d];
+			_Strides[d] = stride;
+			_Radius[d] = S.radius(d);
+			stride *= extents[d];
+		}
+		for (size_t t = 0; t < decltype(S)::taps; t++) {
+			_Offsets[t] = 0;
+			for (size_t d = 0; d + 1 < Rank; d++) {
+				_Offsets[t] += static_cast<ptrdiff_t>(S._Taps[t]._Offset[d]) * static_cast<ptrdiff_t>(_Strides[d]);
+			}
+		}
+	}
+
+	size_t size() const noexcept {
+		size_t res = 1;
+		for (size_t d = 0; d < Rank; d++) {
+			res *= _Extents[d];
+		}
+		return res;
+	}
+};
+
+/*
+ * one output row: rows[t] is the input row tap t reads from (already moved by the outer offsets of the tap),
+ * so only the offset along the row is left; for constant_boundary a tap whose row falls outside reads a row of _Value
+ */
+template<auto S, typename Ty>
+void stencil_row(const Ty *const *rows, Ty *out, size_t begin, size_t end) noexcept {
+	using vec = nstd::internal::simd<Ty>;
+	using reg = typename vec::reg;
+	constexpr size_t taps = decltype(S)::taps;
+	constexpr size_t last = decltype(S)::rank - 1;
+	size_t j = begin;
+	for (; j + 2 * vec::width <= end; j += 2 * vec::width) {
+		reg acc0 = vec::zero(), acc1 = vec::zero();
+		nstd::internal::static_for<taps>([&](auto t) {
+			constexpr auto tap = S._Taps[decltype(t)::value];
+			const Ty *src = rows[decltype(t)::value] + tap._Offset[last] + static_cast<ptrdiff_t>(j);
+			acc0 = vec::fmadd(vec::set1(tap._Weight), vec::load(src), acc0);
+			acc1 = vec::fmadd(vec::set1(tap._Weight), vec::load(src + vec::width), acc1);
+		});
+		vec::store(out + j, acc0);
+		vec::store(out + j + vec::width, acc1);
+	}
+	for (; j < end; j++) {
+		Ty acc(0);
+		nstd::internal::static_for<taps>([&](auto t) {
+			constexpr auto tap = S._Taps[decltype(t)::value];
+			acc += tap._Weight * rows[decltype(t)::value][tap._Offset[last] + static_cast<ptrdiff_t>(j)];
+		});
+		out[j] = acc;
+	}
+}
+
+// cells of a row within the radius of its ends, the offset along the row goes through the boundary policy
+template<auto S, typename Ty, typename Boundary>
+void stencil_row_edge(const Ty *const *rows, Ty *out, size_t begin, size_t end, size_t n, const Boundary &boundary) noexcept {
+	constexpr size_t last = decltype(S)::rank - 1;
+	for (size_t j = begin; j < end; j++) {
+		Ty acc(0);
+		nstd::internal::static_for<decltype(S)::taps>([&](auto t) {
+			constexpr auto tap = S._Taps[decltype(t)::value];
+			ptrdiff_t i = static_cast<ptrdiff_t>(j) + tap._Offset[last];
+			if constexpr (requires { boundary._Value; }) {
+				acc += tap._Weight * (boundary.map(i, n) ? rows[decltype(t)::value][i] : static_cast<Ty>(boundary._Value));
+			} else {
+				boundary.map(i, n);
+				acc += tap._Weight * rows[decltype(t)::value][i];
+			}
+		});
+		out[j] = acc;
+	}
+}
+
+// every cell whose outermost coordinate lies in [first, last), fill is the constant_boundary row (unused otherwise)
+template<auto S, typename Ty, typename Boundary>
+void stencil_slab(const Ty *in, Ty *out, const stencil_geometry<S> &geo, size_t first, size_t last, const Boundary &boundary,
+                  const Ty *fill) noexcept {
+	constexpr size_t Rank = decltype(S)::rank;
+	constexpr size_t taps = decltype(S)::taps;
+	const size_t n = geo._Extents[Rank - 1], r = geo._Radius[Rank - 1];
+	const Ty *rows[taps];
+	ptrdiff_t coord[Rank]{};
+
+	auto line = [&] {
+		bool interior = true;
+		size_t base = 0;
+		for (size_t d = 0; d + 1 < Rank; d++) {
+			const size_t c = static_cast<size_t>(coord[d]);
+			interior = interior && c >= geo._Radius[d] && c + geo._Radius[d] < geo._Extents[d];
+			base += c * geo._Strides[d];
+		}
+		if (interior) {
+			for (size_t t = 0; t < taps; t++) {
+				rows[t] = in + base + geo._Offsets[t];
+			}
+		} else {
+			for (size_t t = 0; t < taps; t++) {
+				size_t lin = 0;
+				bool inside = true;
+				for (size_t d = 0; d + 1 < Rank; d++) {
+					ptrdiff_t i = coord[d] + S._Taps[t]._Offset[d];
+					inside = boundary.map(i, geo._Extents[d]) && inside;
+					lin += static_cast<size_t>(i) * geo._Strides[d];
+				}
+				rows[t] = inside ? in + lin : fill + r;
+			}
+		}
+		if (n > 2 * r) {
+			stencil_row_edge<S>(rows, out + base, 0, r, n, boundary);
+			stencil_row<S>(rows, out + base, r, n - r);
+			stencil_row_edge<S>(rows, out + base, n - r, n, n, boundary);
+		} else {
+			stencil_row_edge<S>(rows, out + base, 0, n, n, boundary);
+		}
+	};
+
+	if constexpr (Rank == 1) {
+		line();
+	} else {
+		// odometer over the outer Rank - 1 coordinates
+		coord[0] = static_cast<ptrdiff_t>(first);
+		while (static_cast<size_t>(coord[0]) < last) {
+			line();
+			size_t d = Rank - 2;
+			while (d > 0 && static_cast<size_t>(++coord[d]) == geo._Extents[d]) {
+				coord[d--] = 0;
+			}
+			if (d == 0) {
+				coord[0]++;
+			}
+		}
+	}
+}
+
+// the row a constant_boundary tap reads when its outer coordinates fall outside the grid
+template<auto S, typename Ty, typename Boundary>
+aligned_buffer<Ty> stencil_fill(const stencil_geometry<S> &geo, const Boundary &boundary) {
+	if constexpr (requires { boundary._Value; }) {
+		constexpr size_t last = decltype(S)::rank - 1;
+		return aligned_buffer<Ty>(geo._Extents[last] + 2 * geo._Radius[last], static_cast<Ty>(boundary._Value));
+	} else {
+		return aligned_buffer<Ty>();
+	}
+}
+
+}  // namespace internal
+
+// apply_stencil BEGINS
+// out = S(in) over a row-major grid of the given extents
+template<auto S, typename Ty, typename Boundary = clamp_boundary>
+    requires(std::is_same_v<Ty, typename decltype(S)::value_type>)
+void apply_stencil(const Ty *in, Ty *out, const size_t (&extents)[decltype(S)::rank], const Boundary &boundary = {}) {
+	NSTD_PROFILE_SCOPE("stencil::apply");
+	if (in == out) {
+		throw std::runtime_error("stencil input and output must not alias!");
+	}
+	const internal::stencil_geometry<S> geo(extents);
+	if (geo.size() != 0) {
+		const aligned_buffer<Ty> fill = internal::stencil_fill<S, Ty>(geo, boundary);
+		internal::stencil_slab<S>(in, out, geo, 0, extents[0], boundary, fill.data());
+	}
+}
+
+template<auto S, typename Ty, bool exception, size_t... DimSize, typename Boundary = clamp_boundary>
+    requires(sizeof...(DimSize) == decltype(S)::rank)
+void apply_stencil(const basic_ndarray<Ty, exception, DimSize...> &in, basic_ndarray<Ty, exception, DimSize...> &out,
+                   const Boundary &boundary = {}) {
+	const size_t extents[] = { DimSize... };
+	apply_stencil<S>(in.data(), out.data(), extents, boundary);
+}
+// apply_stencil ENDS
+
+// iterate_stencil BEGINS
+/*
+ * steps applications of S, alternating between a (holding the initial state) and b; returns the buffer holding the result
+ * temporal blocking: time_block steps advance together as a wavefront along the outermost dimension, step s trailing
+ * step s - 1 by the stencil radius, so each slab is reused from cache time_block times before it is evicted
+ * ! assumptions !
+ * 1. wrap_boundary couples the first and last slabs, it (and rank-1 grids) fall back to one step at a time
+ */
+template<auto S, typename Ty, typename Boundary = clamp_boundary>
+    requires(std::is_same_v<Ty, typename decltype(S)::value_type>)
+Ty *iterate_stencil(Ty *a, Ty *b, const size_t (&extents)[decltype(S)::rank], size_t steps, const Boundary &boundary = {},
+                    size_t time_block = 4) {
+	NSTD_PROFILE_SCOPE("stencil::iterate");
+	if (a == b) {
+		throw std::runtime_error("stencil input and output must not alias!");
+	}
+	const internal::stencil_geometry<S> geo(extents);
+	if (geo.size() == 0) {
+		return a;
+	}
+	const aligned_buffer<Ty> fill = internal::stencil_fill<S, Ty>(geo, boundary);
+	constexpr bool can_block = decltype(S)::rank > 1 && !std::is_same_v<Boundary, wrap_boundary>;
+	const size_t slabs = extents[0];
+	const size_t lag = geo._Radius[0] > 0 ? geo._Radius[0] : 1;
+	Ty *cur = a, *next = b;
+	while (steps > 0) {
+		const size_t block = can_block ? (time_block < 1 ? 1 : (time_block < steps ? time_block : steps)) : 1;
+		if (block == 1) {
+			internal::stencil_slab<S>(cur, next, geo, 0, slabs, boundary, fill.data());
+		} else {
+			for (size_t wave = 0; wave < slabs + (block - 1) * lag; wave++) {
+				for (size_t s = 0; s < block && s * lag <= wave; s++) {
+					const size_t slab = wave - s * lag;
+					if (slab < slabs) {
+						const Ty *src = s % 2 == 0 ? cur : next;
+						Ty *dst = s % 2 == 0 ? next : cur;
+						internal::stencil_slab<S>(src, dst, geo, slab, slab + 1, boundary, fill.data());
+					}
+				}
+			}
+		}
+		if (block % 2 == 1) {
+			Ty *tmp = cur;
+			cur = next;
+			next = tmp;
+		}
+		steps -= block;
+	}
+	return cur;
+}
+
+template<auto S, typename Ty, bool exception, size_t... DimSize, typename Boundary = clamp_boundary>
+    requires(sizeof...(DimSize) == decltype(S)::rank)
+basic_ndarray<Ty, exception, DimSize...> &iterate_stencil(basic_ndarray<Ty, exception, DimSize...> &a,
+                                                          basic_ndarray<Ty, exception, DimSize...> &b, size_t steps,
+                                                          const Boundary &boundary = {}, size_t time_block = 4) {
+	const size_t extents[] = { DimSize... };
+	return iterate_stencil<S>(a.data(), b.data(), extents, steps, boundary, time_block) == a.data() ? a : b;
+}
+// iterate_stencil ENDS
+
+}  // namespace nstd
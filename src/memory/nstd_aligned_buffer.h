@@ -0,0 +1,158 @@
+#pragma once
+
+#include <util/nstd_bounds.h>
+#include <util/nstd_stddef.h>
+#include <util/nstd_type_traits.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+/*
+ * owning, fixed-size heap array of trivially copyable elements
+ * 1. storage is aligned to Align (a cache line by default) so SIMD loads of the first element never split
+ * 2. elements are left uninitialized unless a fill value is given
+ * 3. resize() discards the contents, it is meant for workspaces that are reshaped between uses
+ */
+
+namespace nstd {
+
+template<typename Ty, size_t Align = cache_line_size>
+    requires(is_trivially_copyable_v<Ty> && (Align & (Align - 1)) == 0 && Align >= alignof(Ty))
+class aligned_buffer {
+	Ty *_Data = nullptr;
+	size_t _Size = 0;
+
+	static Ty *allocate(size_t n) {
+		return n == 0 ? nullptr : static_cast<Ty *>(::operator new(n * sizeof(Ty), std::align_val_t{ Align }));
+	}
+
+	static void deallocate(Ty *ptr) noexcept {
+		if (ptr != nullptr) {
+			::operator delete(static_cast<void *>(ptr), std::align_val_t{ Align });
+		}
+	}
+
+public:
+	using value_type = Ty;
+
+	static constexpr size_t alignment = Align;
+
+	aligned_buffer() noexcept = default;
+
+	explicit aligned_buffer(size_t n)
+	    : _Data(allocate(n)), _Size(n) {}
+
+	aligned_buffer(size_t n, const Ty &val)
+	    : aligned_buffer(n) {
+		fill(val);
+	}
+
+	aligned_buffer(const aligned_buffer &rhs)
+	    : aligned_buffer(rhs._Size) {
+		if (_Size != 0) {
+			std::memcpy(static_cast<void *>(_Data), static_cast<const void *>(rhs._Data), _Size * sizeof(Ty));
+		}
+	}
+
+	aligned_buffer(aligned_buffer &&rhs) noexcept
+	    : _Data(rhs._Data), _Size(rhs._Size) {
+		rhs._Data = nullptr;
+		rhs._Size = 0;
+	}
+
+	aligned_buffer &operator=(const aligned_buffer &rhs) {
+		if (this != &rhs) {
+			if (_Size != rhs._Size) {
+				resize(rhs._Size);
+			}
+			if (_Size != 0) {
+				std::memcpy(static_cast<void *>(_Data), static_cast<const void *>(rhs._Data), _Size * sizeof(Ty));
+			}
+		}
+		return *this;
+	}
+
+	aligned_buffer &operator=(aligned_buffer &&rhs) noexcept {
+		if (this != &rhs) {
+			deallocate(_Data);
+			_Data = rhs._Data;
+			_Size = rhs._Size;
+			rhs._Data = nullptr;
+			rhs._Size = 0;
+		}
+		return *this;
+	}
+
+	~aligned_buffer() {
+		deallocate(_Data);
+	}
+
+	Ty *data() noexcept {
+		return _Data;
+	}
+
+	const Ty *data() const noexcept {
+		return _Data;
+	}
+
+	size_t size() const noexcept {
+		return _Size;
+	}
+
+	bool empty() const noexcept {
+		return _Size == 0;
+	}
+
+	Ty &operator[](size_t i) noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return _Data[i];
+	}
+
+	const Ty &operator[](size_t i) const noexcept {
+		NSTD_BOUNDS_ASSERT(i < _Size);
+		return _Data[i];
+	}
+
+	Ty *begin() noexcept {
+		return _Data;
+	}
+
+	const Ty *begin() const noexcept {
+		return _Data;
+	}
+
+	Ty *end() noexcept {
+		return _Data + _Size;
+	}
+
+	const Ty *end() const noexcept {
+		return _Data + _Size;
+	}
+
+	void fill(const Ty &val) noexcept {
+		for (size_t i = 0; i < _Size; i++) {
+			_Data[i] = val;
+		}
+	}
+
+	// reallocates only when the size changes, the contents are unspecified afterwards
+	void resize(size_t n) {
+		if (n != _Size) {
+			Ty *buf = allocate(n);
+			deallocate(_Data);
+			_Data = buf;
+			_Size = n;
+		}
+	}
+
+	// grows without shrinking, for scratch space reused across calls of different sizes
+	void reserve(size_t n) {
+		if (n > _Size) {
+			resize(n);
+		}
+	}
+};
+
+}  // namespace nstd
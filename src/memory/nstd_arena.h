@@ -0,0 +1,193 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/*
+ * monotonic (bump-pointer) arena
+ * 1. deallocation is a no-op, memory is reclaimed all at once by reset()
+ * 2. destructors are NEVER run, so create() only accepts trivially destructible types
+ * 3. not thread-safe, use one arena per thread
+ */
+
+namespace nstd {
+
+class arena {
+	struct block {
+		block *_Next;
+		size_t _Capacity;  // usable bytes following the header
+
+		char *begin() {
+			return reinterpret_cast<char *>(this + 1);
+		}
+	};
+
+	static constexpr size_t block_align = alignof(std::max_align_t) > 64 ? alignof(std::max_align_t) : 64;
+
+	block *_Head = nullptr;  // block currently bumped from, older blocks are chained behind it
+	char *_Cursor = nullptr;
+	char *_End = nullptr;
+	size_t _BlockSize;
+	size_t _Used = 0;
+
+	static block *new_block(size_t capacity) {
+		void *raw = ::operator new(sizeof(block) + capacity, std::align_val_t{ block_align });
+		return ::new (raw) block{ nullptr, capacity };
+	}
+
+	static void delete_block(block *blk) {
+		::operator delete(static_cast<void *>(blk), std::align_val_t{ block_align });
+	}
+
+	void release_all() {
+		while (_Head) {
+			block *next = _Head->_Next;
+			delete_block(_Head);
+			_Head = next;
+		}
+		_Cursor = _End = nullptr;
+	}
+
+	void *allocate_slow(size_t size, size_t align) {
+		const size_t needed = size + align;  // worst-case padding
+		block *blk = new_block(needed > _BlockSize ? needed : _BlockSize);
+		blk->_Next = _Head;
+		_Head = blk;
+		_Cursor = blk->begin();
+		_End = _Cursor + blk->_Capacity;
+		return allocate(size, align);
+	}
+
+public:
+	explicit arena(size_t block_size = 64 * 1024)
+	    : _BlockSize(block_size) {}
+
+	arena(const arena &) = delete;
+	arena &operator=(const arena &) = delete;
+
+	arena(arena &&rhs) noexcept
+	    : _Head(rhs._Head)
+	    , _Cursor(rhs._Cursor)
+	    , _End(rhs._End)
+	    , _BlockSize(rhs._BlockSize)
+	    , _Used(rhs._Used) {
+		rhs._Head = nullptr;
+		rhs._Cursor = rhs._End = nullptr;
+		rhs._Used = 0;
+	}
+
+	arena &operator=(arena &&rhs) noexcept {
+		if (this != &rhs) {
+			release_all();
+			_Head = rhs._Head;
+			_Cursor = rhs._Cursor;
+			_End = rhs._End;
+			_BlockSize = rhs._BlockSize;
+			_Used = rhs._Used;
+			rhs._Head = nullptr;
+			rhs._Cursor = rhs._End = nullptr;
+			rhs._Used = 0;
+		}
+		return *this;
+	}
+
+	~arena() {
+		release_all();
+	}
+
+	void *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+		assert(align != 0 && (align & (align - 1)) == 0);
+		const size_t addr = reinterpret_cast<size_t>(_Cursor);
+		const size_t padding = (align - (addr & (align - 1))) & (align - 1);
+		if (_Cursor == nullptr || static_cast<size_t>(_End - _Cursor) < padding + size) {
+			return allocate_slow(size, align);
+		}
+		char *res = _Cursor + padding;
+		_Cursor = res + size;
+		_Used += padding + size;
+		return res;
+	}
+
+	template<typename Ty>
+	Ty *allocate(size_t n) {
+		return static_cast<Ty *>(allocate(n * sizeof(Ty), alignof(Ty)));
+	}
+
+	template<typename Ty, typename... Args>
+	    requires(std::is_trivially_destructible_v<Ty>)
+	Ty *create(Args &&...args) {
+		return ::new (allocate(sizeof(Ty), alignof(Ty))) Ty(nstd::forward<Args>(args)...);
+	}
+
+	// rewinds to empty, if the last frame spilled over several blocks they are merged into one
+	// so that the next frame of the same size is served from a single contiguous block
+	void reset() {
+		if (_Head && _Head->_Next) {
+			size_t total = 0;
+			for (block *blk = _Head; blk; blk = blk->_Next) {
+				total += blk->_Capacity;
+			}
+			release_all();
+			_Head = new_block(total);
+		}
+		if (_Head) {
+			_Cursor = _Head->begin();
+			_End = _Cursor + _Head->_Capacity;
+		}
+		_Used = 0;
+	}
+
+	// bytes handed out since the last reset, including alignment padding
+	size_t used() const noexcept {
+		return _Used;
+	}
+
+	size_t capacity() const noexcept {
+		size_t total = 0;
+		for (block *blk = _Head; blk; blk = blk->_Next) {
+			total += blk->_Capacity;
+		}
+		return total;
+	}
+};
+
+template<typename Ty>
+class arena_allocator {
+	template<typename>
+	friend class arena_allocator;
+
+	arena *_Arena;
+
+public:
+	using value_type = Ty;
+
+	explicit arena_allocator(arena &a) noexcept
+	    : _Arena(&a) {}
+
+	template<typename U>
+	arena_allocator(const arena_allocator<U> &rhs) noexcept
+	    : _Arena(rhs._Arena) {}
+
+	Ty *allocate(size_t n) {
+		return _Arena->allocate<Ty>(n);
+	}
+
+	void deallocate(Ty *, size_t) noexcept {}
+
+	arena &get_arena() const noexcept {
+		return *_Arena;
+	}
+
+	template<typename U>
+	bool operator==(const arena_allocator<U> &rhs) const noexcept {
+		return _Arena == rhs._Arena;
+	}
+};
+
+}  // namespace nstd
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+#include <util/nstd_type_traits.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <mutex>
+#include <new>
+#include <vector>
+
+/*
+ * fixed-size block pool
+ * 1. blocks are carved out of chunks of BlocksPerChunk and recycled through an intrusive free list
+ * 2. chunks are only returned to the system when the pool is destroyed
+ * 3. a pool is not thread-safe, local() gives every thread its own pool (and free list);
+ *    blocks obtained from local() must be deallocated on the same thread, before it exits
+ * 4. pool_allocator remembers the pool of the thread that made it: a container filled on one thread and destroyed
+ *    on another returns its blocks to the right free list, but the owning thread must not use its pool meanwhile
+ */
+
+namespace nstd {
+
+namespace internal {
+
+template<typename Pool>
+inline constexpr char pool_key = 0;
+
+// the local() pools of one thread, of every block type, destroyed when the thread exits; other threads reach them
+// through a pool_allocator made on this thread, so creating one takes a lock
+class pool_owner {
+	struct entry {
+		const void *_Key;
+		void *_Pool;
+		void (*_Delete)(void *) noexcept;
+	};
+
+	std::mutex _Mutex;
+	std::vector<entry> _Pools;
+
+public:
+	pool_owner() = default;
+	pool_owner(const pool_owner &) = delete;
+	pool_owner &operator=(const pool_owner &) = delete;
+
+	~pool_owner() {
+		for (const entry &e : _Pools) {
+			e._Delete(e._Pool);
+		}
+	}
+
+	template<typename Pool>
+	Pool &get() {
+		std::lock_guard<std::mutex> lock(_Mutex);
+		for (const entry &e : _Pools) {
+			if (e._Key == &pool_key<Pool>) {
+				return *static_cast<Pool *>(e._Pool);
+			}
+		}
+		_Pools.reserve(_Pools.size() + 1);  // so that push_back can not throw after new
+		Pool *res = new Pool();
+		_Pools.push_back({ &pool_key<Pool>, res, [](void *ptr) noexcept { delete static_cast<Pool *>(ptr); } });
+		return *res;
+	}
+
+	static pool_owner &local() {
+		thread_local pool_owner instance;
+		return instance;
+	}
+};
+
+}  // namespace internal
+
+template<typename Ty, size_t BlocksPerChunk = 256>
+    requires(BlocksPerChunk > 0)
+class pool {
+	union node {
+		node *_Next;
+		alignas(Ty) unsigned char _Storage[sizeof(Ty)];
+	};
+
+	struct chunk {
+		chunk *_Next;
+		node _Nodes[BlocksPerChunk];
+	};
+
+	node *_FreeList = nullptr;
+	chunk *_Chunks = nullptr;
+	size_t _ChunkCount = 0;
+	size_t _InUse = 0;
+
+	void grow() {
+		chunk *c = static_cast<chunk *>(::operator new(sizeof(chunk), std::align_val_t{ alignof(chunk) }));
+		c->_Next = _Chunks;
+		_Chunks = c;
+		_ChunkCount++;
+		for (size_t i = BlocksPerChunk; i-- > 0;) {  // reversed so that blocks are handed out in address order
+			c->_Nodes[i]._Next = _FreeList;
+			_FreeList = &c->_Nodes[i];
+		}
+	}
+
+public:
+	using value_type = Ty;
+
+	pool() = default;
+
+	pool(const pool &) = delete;
+	pool &operator=(const pool &) = delete;
+
+	~pool() {
+		while (_Chunks) {
+			chunk *next = _Chunks->_Next;
+			::operator delete(static_cast<void *>(_Chunks), std::align_val_t{ alignof(chunk) });
+			_Chunks = next;
+		}
+	}
+
+	// uninitialized storage for one Ty
+	Ty *allocate() {
+		if (_FreeList == nullptr) {
+			grow();
+		}
+		node *res = _FreeList;
+		_FreeList = res->_Next;
+		_InUse++;
+		return reinterpret_cast<Ty *>(res->_Storage);
+	}
+
+	void deallocate(Ty *ptr) noexcept {
+		node *n = reinterpret_cast<node *>(ptr);
+		n->_Next = _FreeList;
+		_FreeList = n;
+		_InUse--;
+	}
+
+	template<typename... Args>
+	Ty *create(Args &&...args) {
+		Ty *ptr = allocate();
+		try {
+			return ::new (static_cast<void *>(ptr)) Ty(nstd::forward<Args>(args)...);
+		} catch (...) {
+			deallocate(ptr);
+			throw;
+		}
+	}
+
+	void destroy(Ty *ptr) noexcept {
+		ptr->~Ty();
+		deallocate(ptr);
+	}
+
+	size_t in_use() const noexcept {
+		return _InUse;
+	}
+
+	size_t capacity() const noexcept {
+		return _ChunkCount * BlocksPerChunk;
+	}
+
+	// the calling thread's pool, the lock of its pool_owner is only taken on the first call
+	static pool &local() {
+		thread_local pool &instance = internal::pool_owner::local().template get<pool>();
+		return instance;
+	}
+};
+
+// single-object requests go to a pool of the thread that made the allocator (or the allocator it was converted from),
+// array requests fall back to operator new; allocators of different threads compare unequal, so containers never
+// hand blocks across pools
+template<typename Ty>
+class pool_allocator {
+	template<typename U>
+	friend class pool_allocator;
+
+	internal::pool_owner *_Owner = &internal::pool_owner::local();
+	pool<Ty> *_Pool = &pool<Ty>::local();  // nullptr after a converting copy, looked up in _Owner on first use
+
+	pool<Ty> &get_pool() {
+		if (_Pool == nullptr) {
+			_Pool = &_Owner->template get<pool<Ty>>();
+		}
+		return *_Pool;
+	}
+
+public:
+	using value_type = Ty;
+	using is_always_equal = false_type;
+
+	pool_allocator() noexcept = default;
+
+	template<typename U>
+	pool_allocator(const pool_allocator<U> &rhs) noexcept
+	    : _Owner(rhs._Owner)
+	    , _Pool(nullptr) {}
+
+	Ty *allocate(size_t n) {
+		if (n == 1) {
+			return get_pool().allocate();
+		}
+		return static_cast<Ty *>(::operator new(n * sizeof(Ty), std::align_val_t{ alignof(Ty) }));
+	}
+
+	// the pool exists once one of its blocks does, the lookup can not allocate
+	void deallocate(Ty *ptr, size_t n) noexcept {
+		if (n == 1) {
+			get_pool().deallocate(ptr);
+		} else {
+			::operator delete(static_cast<void *>(ptr), std::align_val_t{ alignof(Ty) });
+		}
+	}
+
+	template<typename U>
+	bool operator==(const pool_allocator<U> &rhs) const noexcept {
+		return _Owner == rhs._Owner;
+	}
+};
+
+}  // namespace nstd
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+#include <util/nstd_type_traits.h>
+#include <util/nstd_utility.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// element-wise construction helpers shared by the containers, all usable during constant evaluation
+
+namespace nstd {
+
+namespace internal {
+
+template<typename Ty>
+constexpr void destroy_n(Ty *first, size_t n) noexcept {
+	if constexpr (!std::is_trivially_destructible_v<Ty>) {
+		for (size_t i = 0; i < n; i++) {
+			std::destroy_at(first + i);
+		}
+	}
+}
+
+template<typename Ty>
+constexpr void uninitialized_copy_n(const Ty *src, size_t n, Ty *dst) {
+	if constexpr (is_trivially_copyable_v<Ty>) {
+		if !consteval {
+			if (n != 0) {
+				std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(Ty));
+			}
+			return;
+		}
+	}
+	size_t i = 0;
+	try {
+		for (; i < n; i++) {
+			std::construct_at(dst + i, src[i]);
+		}
+	} catch (...) {
+		destroy_n(dst, i);
+		throw;
+	}
+}
+
+template<typename Ty>
+constexpr void uninitialized_fill_n(Ty *dst, size_t n, const Ty &val) {
+	size_t i = 0;
+	try {
+		for (; i < n; i++) {
+			std::construct_at(dst + i, val);
+		}
+	} catch (...) {
+		destroy_n(dst, i);
+		throw;
+	}
+}
+
+template<typename Ty>
+constexpr void uninitialized_value_construct_n(Ty *dst, size_t n) {
+	size_t i = 0;
+	try {
+		for (; i < n; i++) {
+			std::construct_at(dst + i);
+		}
+	} catch (...) {
+		destroy_n(dst, i);
+		throw;
+	}
+}
+
+// moves [src, src + n) into uninitialized dst and ends the lifetime of the source objects,
+// ranges must not overlap
+template<typename Ty>
+constexpr void uninitialized_relocate_n(Ty *src, size_t n, Ty *dst) {
+	if constexpr (is_trivially_relocatable_v<Ty>) {
+		if !consteval {
+			if (n != 0) {
+				std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(Ty));
+			}
+			return;
+		}
+	}
+	size_t i = 0;
+	try {
+		for (; i < n; i++) {
+			std::construct_at(dst + i, static_cast<Ty &&>(src[i]));
+		}
+	} catch (...) {
+		destroy_n(dst, i);
+		throw;
+	}
+	destroy_n(src, n);
+}
+
+// shifts [first, first + n) right by one slot, first[n] must be uninitialized storage
+template<typename Ty>
+constexpr void shift_right_one(Ty *first, size_t n) {
+	if (n == 0) {
+		return;
+	}
+	if constexpr (is_trivially_relocatable_v<Ty>) {
+		if !consteval {
+			std::memmove(static_cast<void *>(first + 1), static_cast<const void *>(first), n * sizeof(Ty));
+			return;
+		}
+	}
+	std::construct_at(first + n, static_cast<Ty &&>(first[n - 1]));
+	for (size_t i = n - 1; i > 0; i--) {
+		first[i] = static_cast<Ty &&>(first[i - 1]);
+	}
+	destroy_n(first, 1);
+}
+
+// shifts [first + 1, first + n) left by one slot over a destroyed first[0], leaving first[n - 1] destroyed
+template<typename Ty>
+constexpr void shift_left_one(Ty *first, size_t n) {
+	if constexpr (is_trivially_relocatable_v<Ty>) {
+		if !consteval {
+			std::memmove(static_cast<void *>(first), static_cast<const void *>(first + 1), (n - 1) * sizeof(Ty));
+			return;
+		}
+	}
+	if (n > 1) {
+		std::construct_at(first, static_cast<Ty &&>(first[1]));
+		for (size_t i = 1; i + 1 < n; i++) {
+			first[i] = static_cast<Ty &&>(first[i + 1]);
+		}
+		destroy_n(first + n - 1, 1);
+	}
+}
+
+}  // namespace internal
+
+}  // namespace nstd
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cassert>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+#	define NSTD_TRAP() __fastfail(8)  // FAST_FAIL_RANGE_CHECK_FAILURE
+#	define NSTD_COLD __declspec(noinline)
+#else
+#	define NSTD_TRAP() __builtin_trap()
+#	define NSTD_COLD [[gnu::cold, gnu::noinline]]
+#endif
+
+/*
+ * what a failed bounds check does
+ * 1. by default the strict (exception == true) containers and views throw std::runtime_error
+ * 2. with NSTD_ENABLE_HARDENED they trap instead: no unwinding paths, so checks stay cheap enough to ship enabled,
+ *    and the assert-only checks (NSTD_BOUNDS_ASSERT) of the non-strict types keep running under NDEBUG
+ * 3. either way, a failing check during constant evaluation is a compile error
+ */
+
+namespace nstd {
+
+namespace internal {
+
+// out of line and cold, so that every check inlines as a compare and a branch
+[[noreturn]] NSTD_COLD inline void bounds_failure([[maybe_unused]] const char *what) {
+#if defined(NSTD_ENABLE_HARDENED)
+	NSTD_TRAP();
+#else
+	throw std::runtime_error(what);
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace nstd
+
+#if defined(NSTD_ENABLE_HARDENED)
+#	define NSTD_BOUNDS_ASSERT(cond)        \
+		do {                            \
+			if (!(cond)) [[unlikely]] { \
+				NSTD_TRAP();            \
+			}                           \
+		} while (0)
+#else
+#	define NSTD_BOUNDS_ASSERT(cond) assert(cond)
+#endif
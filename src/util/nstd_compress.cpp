@@ -0,0 +1,314 @@
+#include <util/nstd_compress.h>
+#include <util/nstd_type_traits.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <stdexcept>
+
+namespace nstd {
+
+namespace {
+
+using byte = unsigned char;
+
+// transposes the 8x8 bit matrix held in x (byte i = row i), an involution
+constexpr unsigned long long transpose8(unsigned long long x) noexcept {
+	unsigned long long t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaull;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000cccc0000ccccull;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ull;
+	x = x ^ t ^ (t << 28);
+	return x;
+}
+
+unsigned int load32(const byte *p) noexcept {
+	unsigned int res;
+	std::memcpy(&res, p, sizeof(res));
+	return res;
+}
+
+constexpr size_t hash_bits = 12;
+constexpr size_t min_match = 4;
+constexpr size_t max_offset = 65535;
+constexpr size_t last_literals = 5;  // the block always ends with literals
+constexpr size_t match_limit = 12;   // no match starts in the last bytes
+
+constexpr unsigned int hash4(unsigned int seq) noexcept {
+	return (seq * 2654435761u) >> (32 - hash_bits);
+}
+
+byte *put_length(byte *op, size_t len) noexcept {
+	for (; len >= 255; len -= 255) {
+		*op++ = 255;
+	}
+	*op++ = static_cast<byte>(len);
+	return op;
+}
+
+
+// ElemSize > 0 fixes the element size at compile time so that the inner loops unroll
+template<size_t ElemSize>
+void byte_shuffle_impl(const byte *in, byte *out, size_t count, size_t elem_size) noexcept {
+	const size_t es = ElemSize != 0 ? ElemSize : elem_size;
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = 0; j < es; j++) {
+			out[j * count + i] = in[i * es + j];
+		}
+	}
+}
+
+template<size_t ElemSize>
+void byte_unshuffle_impl(const byte *in, byte *out, size_t count, size_t elem_size) noexcept {
+	const size_t es = ElemSize != 0 ? ElemSize : elem_size;
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = 0; j < es; j++) {
+			out[i * es + j] = in[j * count + i];
+		}
+	}
+}
+
+template<size_t ElemSize>
+void bit_shuffle_impl(const byte *in, byte *out, size_t count, size_t elem_size) noexcept {
+	const size_t es = ElemSize != 0 ? ElemSize : elem_size;
+	const size_t blocks = count / 8;
+	for (size_t b = 0; b < blocks; b++) {
+		const byte *group = in + b * 8 * es;
+		for (size_t j = 0; j < es; j++) {
+			unsigned long long x = 0;
+			for (size_t r = 0; r < 8; r++) {
+				x |= static_cast<unsigned long long>(group[r * es + j]) << (8 * r);
+			}
+			x = transpose8(x);
+			byte *plane = out + j * count;
+			for (size_t k = 0; k < 8; k++) {
+				plane[k * blocks + b] = static_cast<byte>(x >> (8 * k));
+			}
+		}
+	}
+	for (size_t j = 0; j < es; j++) {
+		for (size_t i = blocks * 8; i < count; i++) {
+			out[j * count + i] = in[i * es + j];
+		}
+	}
+}
+
+template<size_t ElemSize>
+void bit_unshuffle_impl(const byte *in, byte *out, size_t count, size_t elem_size) noexcept {
+	const size_t es = ElemSize != 0 ? ElemSize : elem_size;
+	const size_t blocks = count / 8;
+	for (size_t b = 0; b < blocks; b++) {
+		byte *group = out + b * 8 * es;
+		for (size_t j = 0; j < es; j++) {
+			const byte *plane = in + j * count;
+			unsigned long long x = 0;
+			for (size_t k = 0; k < 8; k++) {
+				x |= static_cast<unsigned long long>(plane[k * blocks + b]) << (8 * k);
+			}
+			x = transpose8(x);
+			for (size_t r = 0; r < 8; r++) {
+				group[r * es + j] = static_cast<byte>(x >> (8 * r));
+			}
+		}
+	}
+	for (size_t j = 0; j < es; j++) {
+		for (size_t i = blocks * 8; i < count; i++) {
+			out[i * es + j] = in[j * count + i];
+		}
+	}
+}
+
+// calls fn with the element size as a compile-time constant for the common sizes, 0 for the rest
+template<typename Fn>
+void with_elem_size(size_t elem_size, Fn &&fn) noexcept {
+	switch (elem_size) {
+		case 2:
+			return fn(integral_constant<size_t, 2>{});
+		case 4:
+			return fn(integral_constant<size_t, 4>{});
+		case 8:
+			return fn(integral_constant<size_t, 8>{});
+		default:
+			return fn(integral_constant<size_t, 0>{});
+	}
+}
+
+}  // namespace
+
+void byte_shuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept {
+	with_elem_size(elem_size, [&](auto es) {
+		byte_shuffle_impl<decltype(es)::value>(static_cast<const byte *>(src), static_cast<byte *>(dst), count, elem_size);
+	});
+}
+
+void byte_unshuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept {
+	with_elem_size(elem_size, [&](auto es) {
+		byte_unshuffle_impl<decltype(es)::value>(static_cast<const byte *>(src), static_cast<byte *>(dst), count, elem_size);
+	});
+}
+
+void bit_shuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept {
+	with_elem_size(elem_size, [&](auto es) {
+		bit_shuffle_impl<decltype(es)::value>(static_cast<const byte *>(src), static_cast<byte *>(dst), count, elem_size);
+	});
+}
+
+void bit_unshuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept {
+	with_elem_size(elem_size, [&](auto es) {
+		bit_unshuffle_impl<decltype(es)::value>(static_cast<const byte *>(src), static_cast<byte *>(dst), count, elem_size);
+	});
+}
+
+size_t lz_compress(const void *src, size_t n, void *dst, size_t capacity) noexcept {
+	const byte *in = static_cast<const byte *>(src);
+	byte *out = static_cast<byte *>(dst);
+	byte *op = out;
+	if (capacity < lz_compress_bound(n)) {
+		return 0;
+	}
+
+	size_t table[size_t(1) << hash_bits];  // position + 1, 0 is empty
+	std::memset(table, 0, sizeof(table));
+
+	size_t anchor = 0;
+	if (n > match_limit) {
+		const size_t limit = n - match_limit;
+		size_t ip = 0;
+		size_t misses = 0;
+		while (ip < limit) {
+			const unsigned int seq = load32(in + ip);
+			const unsigned int h = hash4(seq);
+			const size_t ref = table[h];
+			table[h] = ip + 1;
+			if (ref == 0 || ip - (ref - 1) > max_offset || load32(in + ref - 1) != seq) {
+				ip += 1 + (misses++ >> 6);  // skip faster through incompressible data
+				continue;
+			}
+			misses = 0;
+
+			const size_t match = ref - 1;
+			size_t len = min_match;
+			while (ip + len < n - last_literals && in[match + len] == in[ip + len]) {
+				len++;
+			}
+			// extend backwards over pending literals
+			size_t back = 0;
+			while (ip - back > anchor && match - back > 0 && in[ip - back - 1] == in[match - back - 1]) {
+				back++;
+			}
+			const size_t start = ip - back;
+			len += back;
+
+			const size_t literals = start - anchor;
+			byte *token = op++;
+			*token = static_cast<byte>((literals < 15 ? literals : 15) << 4);
+			if (literals >= 15) {
+				op = put_length(op, literals - 15);
+			}
+			std::memcpy(op, in + anchor, literals);
+			op += literals;
+
+			const size_t offset = start - (match - back);
+			*op++ = static_cast<byte>(offset & 0xff);
+			*op++ = static_cast<byte>(offset >> 8);
+
+			const size_t extra = len - min_match;
+			*token |= static_cast<byte>(extra < 15 ? extra : 15);
+			if (extra >= 15) {
+				op = put_length(op, extra - 15);
+			}
+
+			ip = start + len;
+			anchor = ip;
+			if (ip - 2 < limit) {  // index a position inside the match as well
+				table[hash4(load32(in + ip - 2))] = ip - 1;
+			}
+		}
+	}
+
+	const size_t literals = n - anchor;
+	byte *token = op++;
+	*token = static_cast<byte>((literals < 15 ? literals : 15) << 4);
+	if (literals >= 15) {
+		op = put_length(op, literals - 15);
+	}
+	if (literals != 0) {
+		std::memcpy(op, in + anchor, literals);
+	}
+	op += literals;
+	return static_cast<size_t>(op - out);
+}
+
+size_t lz_decompress(const void *src, size_t n, void *dst, size_t capacity) {
+	const byte *ip = static_cast<const byte *>(src);
+	const byte *const end = ip + n;
+	byte *out = static_cast<byte *>(dst);
+	size_t pos = 0;
+
+	auto read_length = [&](size_t len) {
+		if (len == 15) {
+			byte b;
+			do {
+				if (ip == end) {
+					throw std::runtime_error("lz_decompress corrupt input!");
+				}
+				b = *ip++;
+				len += b;
+			} while (b == 255);
+		}
+		return len;
+	};
+
+	while (ip < end) {
+		const byte token = *ip++;
+		const size_t literals = read_length(token >> 4);
+		if (literals > static_cast<size_t>(end - ip) || literals > capacity - pos) {
+			throw std::runtime_error("lz_decompress corrupt input!");
+		}
+		if (literals <= 16 && end - ip >= 16 && capacity - pos >= 16) {
+			std::memcpy(out + pos, ip, 16);  // fixed-size copy, the excess is overwritten later or lies past the data
+		} else if (literals != 0) {
+			std::memcpy(out + pos, ip, literals);
+		}
+		ip += literals;
+		pos += literals;
+		if (ip == end) {
+			break;  // the last sequence has no match
+		}
+
+		if (end - ip < 2) {
+			throw std::runtime_error("lz_decompress corrupt input!");
+		}
+		const size_t offset = ip[0] | static_cast<size_t>(ip[1]) << 8;
+		ip += 2;
+		const size_t len = read_length(token & 15) + min_match;
+		if (offset == 0 || offset > pos || len > capacity - pos) {
+			throw std::runtime_error("lz_decompress corrupt input!");
+		}
+		byte *op = out + pos;
+		const byte *match = op - offset;
+		if (offset >= 16 && len <= 16 && capacity - pos >= 16) {
+			std::memcpy(op, match, 16);
+		} else if (offset >= len) {
+			std::memcpy(op, match, len);
+		} else if (offset == 1) {  // a run of one byte, e.g. zeros
+			std::memset(op, *match, len);
+		} else if (offset >= 8) {  // overlapping, but every 8-byte step reads bytes already written
+			size_t i = 0;
+			for (; i + 8 <= len; i += 8) {
+				std::memcpy(op + i, match + i, 8);
+			}
+			for (; i < len; i++) {
+				op[i] = match[i];
+			}
+		} else {
+			for (size_t i = 0; i < len; i++) {  // overlapping, repeats the last offset bytes
+				op[i] = match[i];
+			}
+		}
+		pos += len;
+	}
+	return pos;
+}
+
+}  // namespace nstd
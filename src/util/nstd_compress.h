@@ -0,0 +1,38 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+/*
+ * small self-contained codecs for numeric data
+ * 1. shuffles regroup the bytes (or bits) of fixed-size elements into planes, so that the slowly
+ *    varying high bytes of smooth fields form long runs the LZ stage can pick up
+ * 2. lz_* is a byte-oriented LZ77 in the LZ4 block layout (token, literals, 16-bit offset, match),
+ *    it favours speed over ratio
+ */
+
+namespace nstd {
+
+// dst[j * count + i] = byte j of element i
+void byte_shuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept;
+void byte_unshuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept;
+
+/*
+ * bit planes within every byte plane: byte plane j holds 8 planes of count / 8 bytes (bit k of
+ * byte j of every element), followed by the count % 8 trailing elements' bytes as they are
+ */
+void bit_shuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept;
+void bit_unshuffle(const void *src, void *dst, size_t count, size_t elem_size) noexcept;
+
+// worst-case compressed size of n bytes
+constexpr size_t lz_compress_bound(size_t n) noexcept {
+	return n + n / 255 + 16;
+}
+
+// returns the compressed size, capacity must be at least lz_compress_bound(n)
+size_t lz_compress(const void *src, size_t n, void *dst, size_t capacity) noexcept;
+
+// returns the decompressed size, throws std::runtime_error on corrupt input or when capacity is exceeded
+// NOTE: bytes of dst past the decompressed size (up to capacity) may be overwritten
+size_t lz_decompress(const void *src, size_t n, void *dst, size_t capacity);
+
+}  // namespace nstd
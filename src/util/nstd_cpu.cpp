@@ -0,0 +1,120 @@
+#include <util/nstd_cpu.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#	include <intrin.h>
+#	define NSTD_CPU_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <cpuid.h>
+#	define NSTD_CPU_X86 1
+#else
+#	define NSTD_CPU_X86 0
+#endif
+
+namespace nstd {
+
+namespace {
+
+#if NSTD_CPU_X86
+struct cpuid_regs {
+	unsigned _Eax, _Ebx, _Ecx, _Edx;
+};
+
+cpuid_regs cpuid(unsigned leaf, unsigned subleaf) noexcept {
+#	if defined(_MSC_VER)
+	int regs[4];
+	__cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+	return { static_cast<unsigned>(regs[0]), static_cast<unsigned>(regs[1]), static_cast<unsigned>(regs[2]), static_cast<unsigned>(regs[3]) };
+#	else
+	cpuid_regs res{};
+	__cpuid_count(leaf, subleaf, res._Eax, res._Ebx, res._Ecx, res._Edx);
+	return res;
+#	endif
+}
+
+// XCR0, the register state the OS saves on context switches
+unsigned long long xgetbv0() noexcept {
+#	if defined(_MSC_VER)
+	return _xgetbv(0);
+#	else
+	unsigned lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (static_cast<unsigned long long>(hi) << 32) | lo;
+#	endif
+}
+
+bool bit(unsigned reg, unsigned index) noexcept {
+	return (reg >> index & 1u) != 0;
+}
+#endif
+
+cpu_features detect() noexcept {
+	cpu_features res;
+#if NSTD_CPU_X86
+	const unsigned max_leaf = cpuid(0, 0)._Eax;
+	if (max_leaf < 1) {
+		return res;
+	}
+	const cpuid_regs leaf1 = cpuid(1, 0);
+	res._Sse2 = bit(leaf1._Edx, 26);
+	res._Sse41 = bit(leaf1._Ecx, 19);
+	res._Sse42 = bit(leaf1._Ecx, 20);
+
+	// AVX state (xmm + ymm) and AVX-512 state (opmask + both zmm halves) must be enabled by the OS
+	const bool osxsave = bit(leaf1._Ecx, 27);
+	const unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+	const bool ymm = (xcr0 & 0x6) == 0x6;
+	const bool zmm = ymm && (xcr0 & 0xe0) == 0xe0;
+	res._Avx = ymm && bit(leaf1._Ecx, 28);
+	res._Fma = res._Avx && bit(leaf1._Ecx, 12);
+	if (max_leaf >= 7) {
+		const cpuid_regs leaf7 = cpuid(7, 0);
+		res._Avx2 = res._Avx && bit(leaf7._Ebx, 5);
+		res._Avx512f = zmm && bit(leaf7._Ebx, 16);
+		res._Avx512bw = res._Avx512f && bit(leaf7._Ebx, 30);
+		res._Avx512vl = res._Avx512f && bit(leaf7._Ebx, 31);
+		res._Avx512vnni = res._Avx512f && bit(leaf7._Ecx, 11);
+		if (leaf7._Eax >= 1) {
+			res._AvxVnni = res._Avx2 && bit(cpuid(7, 1)._Eax, 4);
+		}
+	}
+#endif
+	return res;
+}
+
+}  // namespace
+
+const cpu_features &cpu_info() noexcept {
+	static const cpu_features features = detect();
+	return features;
+}
+
+bool cpu_supports(isa target) noexcept {
+	const cpu_features &cpu = cpu_info();
+	switch (target) {
+	case isa::scalar:
+		return true;
+	case isa::sse2:
+		return cpu._Sse2;
+	case isa::avx2:
+		return cpu._Avx2 && cpu._Fma;
+	case isa::avx512:
+		return cpu._Avx512f && cpu._Avx512bw && cpu._Avx2 && cpu._Fma;
+	}
+	return false;
+}
+
+const char *isa_name(isa target) noexcept {
+	switch (target) {
+	case isa::scalar:
+		return "scalar";
+	case isa::sse2:
+		return "sse2";
+	case isa::avx2:
+		return "avx2";
+	case isa::avx512:
+		return "avx512";
+	}
+	return "unknown";
+}
+
+}  // namespace nstd
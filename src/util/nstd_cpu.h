@@ -0,0 +1,43 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+/*
+ * run-time cpu feature detection
+ * 1. cpu_info() queries CPUID (and XGETBV for the register state the OS saves) once, on first use
+ * 2. a feature is reported only when both the processor and the OS support it, i.e. it is safe to execute
+ * 3. non-x86 targets report no features
+ */
+
+namespace nstd {
+
+// the instruction sets nstd kernels are built for, in increasing order
+enum class isa : unsigned char {
+	scalar,
+	sse2,
+	avx2,    // with FMA
+	avx512,  // AVX-512F + BW
+};
+
+struct cpu_features {
+	bool _Sse2 = false;
+	bool _Sse41 = false;
+	bool _Sse42 = false;
+	bool _Avx = false;
+	bool _Avx2 = false;
+	bool _Fma = false;
+	bool _Avx512f = false;
+	bool _Avx512bw = false;
+	bool _Avx512vl = false;
+	bool _Avx512vnni = false;
+	bool _AvxVnni = false;
+};
+
+const cpu_features &cpu_info() noexcept;
+
+// true when the cpu can run kernels built for target
+bool cpu_supports(isa target) noexcept;
+
+const char *isa_name(isa target) noexcept;
+
+}  // namespace nstd
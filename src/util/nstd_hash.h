@@ -0,0 +1,57 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <functional>
+#include <type_traits>
+
+/*
+ * hashes tuned for open addressing: every output bit depends on every input bit,
+ * so both the low bits (probe start) and the high bits (control byte) are usable
+ */
+
+namespace nstd {
+
+namespace internal {
+
+// moremur finalizer (a stronger variant of splitmix64's)
+constexpr unsigned long long mix64(unsigned long long x) noexcept {
+	x ^= x >> 27;
+	x *= 0x3c79ac492ba7b653ull;
+	x ^= x >> 33;
+	x *= 0x1c69b3f74ac4ae35ull;
+	x ^= x >> 27;
+	return x;
+}
+
+constexpr unsigned long long hash_combine(unsigned long long seed, unsigned long long value) noexcept {
+	return mix64(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+}  // namespace internal
+
+// falls back to std::hash, post-mixed since many std::hash implementations are the identity
+template<typename Ty>
+struct hash {
+	size_t operator()(const Ty &val) const noexcept(noexcept(std::hash<Ty>{}(val))) {
+		return static_cast<size_t>(internal::mix64(static_cast<unsigned long long>(std::hash<Ty>{}(val))));
+	}
+};
+
+template<typename Ty>
+    requires(std::is_integral_v<Ty> || std::is_enum_v<Ty>)
+struct hash<Ty> {
+	constexpr size_t operator()(Ty val) const noexcept {
+		return static_cast<size_t>(internal::mix64(static_cast<unsigned long long>(val)));
+	}
+};
+
+template<typename Ty>
+struct hash<Ty *> {
+	size_t operator()(Ty *ptr) const noexcept {
+		return static_cast<size_t>(internal::mix64(static_cast<unsigned long long>(reinterpret_cast<size_t>(ptr))));
+	}
+};
+
+}  // namespace nstd
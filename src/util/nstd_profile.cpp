@@ -0,0 +1,264 @@
+#include <util/nstd_profile.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace nstd {
+
+namespace profile {
+
+namespace {
+
+struct event {
+	const char *_Name;
+	tick_t _Begin;
+	tick_t _End;
+};
+
+// owned by the registry, written only by its thread
+struct thread_state {
+	size_t _Tid;
+	bool _Retired = false;  // its thread has exited, guarded by the registry mutex
+	size_t _Dumped = 0;     // events already written out by dump_chrome_trace, guarded by the registry mutex
+	std::unique_ptr<event[]> _Events{ new event[max_events_per_thread] };
+	std::atomic<size_t> _EventCount{ 0 };
+	std::atomic<size_t> _Dropped{ 0 };
+	std::atomic<unsigned long long> _Counters[max_counters]{};
+};
+
+struct registry {
+	std::mutex _Mutex;
+	std::vector<std::unique_ptr<thread_state>> _Threads;
+	const char *_CounterNames[max_counters]{};
+	size_t _CounterCount = 0;
+
+	// clock calibration anchor
+	tick_t _TickOrigin = now();
+	std::chrono::steady_clock::time_point _TimeOrigin = std::chrono::steady_clock::now();
+
+	static registry &get() {
+		static registry instance;
+		return instance;
+	}
+
+	// hands on the state of an exited thread once none of its events would be lost, counters keep their totals
+	thread_state *register_thread() {
+		std::lock_guard<std::mutex> lock(_Mutex);
+		for (auto &state : _Threads) {
+			if (state->_Retired && state->_EventCount.load(std::memory_order_relaxed) == state->_Dumped) {
+				state->_Retired = false;
+				state->_EventCount.store(0, std::memory_order_relaxed);
+				state->_Dumped = 0;
+				return state.get();
+			}
+		}
+		auto &state = _Threads.emplace_back(std::make_unique<thread_state>());
+		state->_Tid = _Threads.size() - 1;
+		return state.get();
+	}
+
+	void retire_thread(thread_state *state) {
+		std::lock_guard<std::mutex> lock(_Mutex);
+		state->_Retired = true;
+	}
+
+	// ticks per microsecond
+	double tick_rate() const {
+#if NSTD_PROFILE_HAS_RDTSC
+		auto elapsed = std::chrono::steady_clock::now() - _TimeOrigin;
+		while (elapsed < std::chrono::milliseconds(10)) {  // too short to calibrate reliably
+			elapsed = std::chrono::steady_clock::now() - _TimeOrigin;
+		}
+		const tick_t ticks = now() - _TickOrigin;
+		return static_cast<double>(ticks) / std::chrono::duration<double, std::micro>(elapsed).count();
+#else
+		return 1000.0;
+#endif
+	}
+};
+
+// retires the state of its thread on thread exit
+struct thread_handle {
+	thread_state *_State = registry::get().register_thread();
+
+	thread_handle() = default;
+	thread_handle(const thread_handle &) = delete;
+	thread_handle &operator=(const thread_handle &) = delete;
+
+	~thread_handle() {
+		registry::get().retire_thread(_State);
+	}
+};
+
+thread_state *local_state() {
+	thread_local thread_handle handle;
+	return handle._State;
+}
+
+void write_escaped(std::ofstream &out, const char *str) {
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\') {
+			out << '\\';
+		}
+		out << *str;
+	}
+}
+
+}  // namespace
+
+void record(const char *name, tick_t begin, tick_t end) noexcept {
+	thread_state *state = local_state();
+	const size_t n = state->_EventCount.load(std::memory_order_relaxed);
+	if (n == max_events_per_thread) {
+		state->_Dropped.store(state->_Dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+	state->_Events[n] = { name, begin, end };
+	state->_EventCount.store(n + 1, std::memory_order_release);
+}
+
+counter_id register_counter(const char *name) {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	for (size_t i = 0; i < reg._CounterCount; i++) {
+		if (std::strcmp(reg._CounterNames[i], name) == 0) {
+			return i;
+		}
+	}
+	if (reg._CounterCount == max_counters) {
+		throw std::runtime_error("nstd::profile: too many counters!");
+	}
+	reg._CounterNames[reg._CounterCount] = name;
+	return reg._CounterCount++;
+}
+
+void add(counter_id id, unsigned long long n) noexcept {
+	auto &counter = local_state()->_Counters[id];
+	counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);  // single writer
+}
+
+unsigned long long counter_value(const char *name) {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	for (size_t i = 0; i < reg._CounterCount; i++) {
+		if (std::strcmp(reg._CounterNames[i], name) == 0) {
+			unsigned long long sum = 0;
+			for (auto &state : reg._Threads) {
+				sum += state->_Counters[i].load(std::memory_order_relaxed);
+			}
+			return sum;
+		}
+	}
+	return 0;
+}
+
+size_t event_count() {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	size_t sum = 0;
+	for (auto &state : reg._Threads) {
+		sum += state->_EventCount.load(std::memory_order_acquire);
+	}
+	return sum;
+}
+
+size_t thread_buffers() {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	return reg._Threads.size();
+}
+
+size_t dropped_events() {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	size_t sum = 0;
+	for (auto &state : reg._Threads) {
+		sum += state->_Dropped.load(std::memory_order_relaxed);
+	}
+	return sum;
+}
+
+void reset() {
+	registry &reg = registry::get();
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+	for (auto &state : reg._Threads) {
+		state->_EventCount.store(0, std::memory_order_relaxed);
+		state->_Dumped = 0;
+		state->_Dropped.store(0, std::memory_order_relaxed);
+		for (auto &counter : state->_Counters) {
+			counter.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+void dump_chrome_trace(const char *path) {
+	registry &reg = registry::get();
+	const double rate = reg.tick_rate();
+	const tick_t dump_tick = now();
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		throw std::runtime_error("nstd::profile: can not open trace file!");
+	}
+
+	std::lock_guard<std::mutex> lock(reg._Mutex);
+
+	// the first scope of a thread may begin before the registry exists
+	tick_t origin = reg._TickOrigin;
+	for (auto &state : reg._Threads) {
+		const size_t n = state->_EventCount.load(std::memory_order_acquire);
+		for (size_t i = 0; i < n; i++) {
+			origin = state->_Events[i]._Begin < origin ? state->_Events[i]._Begin : origin;
+		}
+	}
+
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	auto separator = [&]() {
+		if (!first) {
+			out << ",\n";
+		}
+		first = false;
+	};
+
+	for (auto &state : reg._Threads) {
+		const size_t n = state->_EventCount.load(std::memory_order_acquire);
+		for (size_t i = 0; i < n; i++) {
+			const event &e = state->_Events[i];
+			separator();
+			out << "{\"name\":\"";
+			write_escaped(out, e._Name);
+			out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << state->_Tid
+			    << ",\"ts\":" << static_cast<double>(e._Begin - origin) / rate
+			    << ",\"dur\":" << static_cast<double>(e._End - e._Begin) / rate << '}';
+		}
+		state->_Dumped = n;
+	}
+
+	// counters are reported once, as their totals at dump time
+	for (size_t i = 0; i < reg._CounterCount; i++) {
+		unsigned long long sum = 0;
+		for (auto &state : reg._Threads) {
+			sum += state->_Counters[i].load(std::memory_order_relaxed);
+		}
+		separator();
+		out << "{\"name\":\"";
+		write_escaped(out, reg._CounterNames[i]);
+		out << "\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << static_cast<double>(dump_tick - origin) / rate
+		    << ",\"args\":{\"value\":" << sum << "}}";
+	}
+	out << "]}\n";
+
+	if (!out) {
+		throw std::runtime_error("nstd::profile: failed to write trace file!");
+	}
+}
+
+}  // namespace profile
+
+}  // namespace nstd
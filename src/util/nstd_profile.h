@@ -0,0 +1,108 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#	include <intrin.h>
+#	define NSTD_PROFILE_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#	define NSTD_PROFILE_HAS_RDTSC 1
+#else
+#	define NSTD_PROFILE_HAS_RDTSC 0
+#endif
+
+/*
+ * hot-path instrumentation
+ * 1. hooks (NSTD_PROFILE_SCOPE / NSTD_PROFILE_COUNT) expand to nothing unless NSTD_ENABLE_PROFILE is defined
+ * 2. every thread records into its own buffers, the recording path never takes a lock
+ * 3. scope names must have static storage duration (string literals), only the pointer is stored
+ * 4. the buffers of an exited thread go to the next new thread once dump_chrome_trace has written them out (or
+ *    reset() has dropped them), so threads that come and go do not grow memory between dumps
+ */
+
+namespace nstd {
+
+namespace profile {
+
+using tick_t = unsigned long long;
+using counter_id = size_t;
+
+inline constexpr size_t max_counters = 256;
+inline constexpr size_t max_events_per_thread = 1 << 16;
+
+// raw timestamp: TSC ticks on x86, steady_clock nanoseconds elsewhere
+inline tick_t now() noexcept {
+#if NSTD_PROFILE_HAS_RDTSC
+	return __rdtsc();
+#else
+	return static_cast<tick_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                               std::chrono::steady_clock::now().time_since_epoch())
+	                               .count());
+#endif
+}
+
+void record(const char *name, tick_t begin, tick_t end) noexcept;
+
+counter_id register_counter(const char *name);  // idempotent, takes a lock: cache the result
+void add(counter_id id, unsigned long long n) noexcept;
+unsigned long long counter_value(const char *name);  // summed over all threads, 0 if unknown
+
+size_t event_count();     // recorded events, summed over all threads
+size_t dropped_events();  // events lost because a thread buffer was full
+size_t thread_buffers();  // per-thread buffers allocated, an exited thread's is reused once its events are dumped
+
+// NOTE: reset() must not race with active scopes or counters
+void reset();
+
+// writes a chrome://tracing (trace event format) JSON file, throws std::runtime_error on IO failure
+void dump_chrome_trace(const char *path);
+
+class scope {
+	const char *_Name;
+	tick_t _Begin;
+
+public:
+	constexpr explicit scope(const char *name) noexcept
+	    : _Name(name)
+	    , _Begin(0) {
+		if !consteval {
+			_Begin = now();
+		}
+	}
+
+	scope(const scope &) = delete;
+	scope &operator=(const scope &) = delete;
+
+	constexpr ~scope() {
+		if !consteval {
+			record(_Name, _Begin, now());
+		}
+	}
+};
+
+}  // namespace profile
+
+}  // namespace nstd
+
+#define NSTD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NSTD_PROFILE_CONCAT(a, b) NSTD_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(NSTD_ENABLE_PROFILE)
+// usable inside constexpr functions, it does nothing during constant evaluation
+#	define NSTD_PROFILE_SCOPE(name) \
+		::nstd::profile::scope NSTD_PROFILE_CONCAT(_nstd_profile_scope_, __LINE__) { name }
+// NOT usable inside constexpr functions (needs a static local)
+#	define NSTD_PROFILE_COUNT(name, n)                                                               \
+		do {                                                                                          \
+			static const ::nstd::profile::counter_id _nstd_profile_counter = ::nstd::profile::register_counter(name); \
+			::nstd::profile::add(_nstd_profile_counter, (n));                                         \
+		} while (0)
+#else
+#	define NSTD_PROFILE_SCOPE(name) static_cast<void>(0)
+#	define NSTD_PROFILE_COUNT(name, n) static_cast<void>(0)
+#endif
@@ -0,0 +1,816 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+#include <util/nstd_type_traits.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <utility>
+
+
+#if defined(__AVX512F__)
+#	include <immintrin.h>
+#	define NSTD_SIMD_AVX512 1
+#	define NSTD_SIMD_AVX 1
+#	define NSTD_SIMD_SSE2 1
+#	if defined(__AVX512BW__) && defined(__AVX512VNNI__)
+#		define NSTD_SIMD_VNNI 1
+#		define NSTD_SIMD_ABI simd_avx512vnni
+#	elif defined(__AVX512BW__)
+#		define NSTD_SIMD_VNNI 0
+#		define NSTD_SIMD_ABI simd_avx512bw
+#	else
+#		define NSTD_SIMD_VNNI 0
+#		define NSTD_SIMD_ABI simd_avx512
+#	endif
+#elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#	include <immintrin.h>
+#	define NSTD_SIMD_AVX512 0
+#	define NSTD_SIMD_AVX 1
+#	define NSTD_SIMD_SSE2 1
+#	define NSTD_SIMD_VNNI 0
+#	define NSTD_SIMD_ABI simd_avx2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define NSTD_SIMD_AVX512 0
+#	define NSTD_SIMD_AVX 0
+#	define NSTD_SIMD_SSE2 1
+#	define NSTD_SIMD_VNNI 0
+#	define NSTD_SIMD_ABI simd_sse2
+#else
+#	define NSTD_SIMD_AVX512 0
+#	define NSTD_SIMD_AVX 0
+#	define NSTD_SIMD_SSE2 0
+#	define NSTD_SIMD_VNNI 0
+#	define NSTD_SIMD_ABI simd_scalar
+#endif
+
+/*
+ * the widest register the build targets, selected at compile time
+ * 1. simd<Ty> exposes one register type and the handful of operations the dense kernels need,
+ *    every load / store is unaligned; comparisons return a bitmask of lanes (lane 0 in bit 0)
+ * 2. the AVX path requires AVX2 + FMA, the AVX-512 path AVX512F; otherwise SSE2 on x86-64
+ * 3. other element types (and other targets) get a one-lane scalar fallback with the same interface
+ * 4. simd_i16 is the integer counterpart for the widening kernels: int16 pairs multiplied and summed into int32 lanes
+ *    (pmaddwd, vpdpwssd when the build targets AVX512-VNNI), 512 bits wide only with AVX512BW
+ * 5. simd and simd_scalar live in an inline namespace named after the instruction set, so translation units built for
+ *    different targets (see util/nstd_dispatch.h) link into one binary without sharing a definition; templates that
+ *    take the register type as a parameter inherit that separation
+ */
+
+namespace nstd {
+
+namespace internal {
+
+// fn(integral_constant<size_t, I>{}) for I in [0, N), unrolled so that register arrays indexed by I stay in registers
+template<size_t N, typename Fn>
+inline void static_for(Fn &&fn) {
+	[&]<size_t... I>(std::index_sequence<I...>) {
+		(fn(integral_constant<size_t, I>{}), ...);
+	}(std::make_index_sequence<N>{});
+}
+
+inline namespace NSTD_SIMD_ABI {
+
+template<typename Ty>
+struct simd_scalar {
+	using reg = Ty;
+	static constexpr size_t width = 1;
+
+	static reg zero() noexcept {
+		return Ty(0);
+	}
+
+	static reg set1(Ty val) noexcept {
+		return val;
+	}
+
+	static reg load(const Ty *ptr) noexcept {
+		return *ptr;
+	}
+
+	static void store(Ty *ptr, reg val) noexcept {
+		*ptr = val;
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return lhs + rhs;
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return lhs - rhs;
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return lhs * rhs;
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return lhs / rhs;
+	}
+
+	// a * b + c
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return a * b + c;
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return c - a * b;
+	}
+
+	// rhs when either is NaN, like minps / maxps
+	static reg min(reg lhs, reg rhs) noexcept {
+		return lhs < rhs ? lhs : rhs;
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return lhs > rhs ? lhs : rhs;
+	}
+
+	// bit l set when lane l compares true, false for NaN
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return lhs < rhs ? 1u : 0u;
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return lhs <= rhs ? 1u : 0u;
+	}
+
+	static Ty hsum(reg val) noexcept {
+		return val;
+	}
+};
+
+template<typename Ty>
+struct simd : simd_scalar<Ty> {};
+
+#if NSTD_SIMD_AVX512
+template<>
+struct simd<float> {
+	using reg = __m512;
+	static constexpr size_t width = 16;
+
+	static reg zero() noexcept {
+		return _mm512_setzero_ps();
+	}
+
+	static reg set1(float val) noexcept {
+		return _mm512_set1_ps(val);
+	}
+
+	static reg load(const float *ptr) noexcept {
+		return _mm512_loadu_ps(ptr);
+	}
+
+	static void store(float *ptr, reg val) noexcept {
+		_mm512_storeu_ps(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm512_add_ps(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm512_sub_ps(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm512_mul_ps(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm512_div_ps(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm512_fmadd_ps(a, b, c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm512_fnmadd_ps(a, b, c);
+	}
+
+	// masked like hsum, the plain forms merge into an undefined register
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm512_maskz_min_ps(0xffff, lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm512_maskz_max_ps(0xffff, lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm512_cmp_ps_mask(lhs, rhs, _CMP_LE_OQ));
+	}
+
+	// masked extracts: _mm512_reduce_add_* and the 512 -> 256 casts read an undefined register, a -Wuninitialized error with gcc 12
+	static float hsum(reg val) noexcept {
+		const __m256 upper = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff, _mm512_castps_pd(val), 1));
+		const __m256 lower = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xff, _mm512_castps_pd(val), 0));
+		const __m256 quarter = _mm256_add_ps(lower, upper);
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(quarter), _mm256_extractf128_ps(quarter, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		return _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 1)));
+	}
+};
+
+template<>
+struct simd<double> {
+	using reg = __m512d;
+	static constexpr size_t width = 8;
+
+	static reg zero() noexcept {
+		return _mm512_setzero_pd();
+	}
+
+	static reg set1(double val) noexcept {
+		return _mm512_set1_pd(val);
+	}
+
+	static reg load(const double *ptr) noexcept {
+		return _mm512_loadu_pd(ptr);
+	}
+
+	static void store(double *ptr, reg val) noexcept {
+		_mm512_storeu_pd(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm512_add_pd(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm512_sub_pd(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm512_mul_pd(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm512_div_pd(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm512_fmadd_pd(a, b, c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm512_fnmadd_pd(a, b, c);
+	}
+
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm512_maskz_min_pd(0xff, lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm512_maskz_max_pd(0xff, lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm512_cmp_pd_mask(lhs, rhs, _CMP_LT_OQ));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm512_cmp_pd_mask(lhs, rhs, _CMP_LE_OQ));
+	}
+
+	static double hsum(reg val) noexcept {
+		const __m256d quarter = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xff, val, 0), _mm512_maskz_extractf64x4_pd(0xff, val, 1));
+		const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(quarter), _mm256_extractf128_pd(quarter, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+	}
+};
+#elif NSTD_SIMD_AVX
+template<>
+struct simd<float> {
+	using reg = __m256;
+	static constexpr size_t width = 8;
+
+	static reg zero() noexcept {
+		return _mm256_setzero_ps();
+	}
+
+	static reg set1(float val) noexcept {
+		return _mm256_set1_ps(val);
+	}
+
+	static reg load(const float *ptr) noexcept {
+		return _mm256_loadu_ps(ptr);
+	}
+
+	static void store(float *ptr, reg val) noexcept {
+		_mm256_storeu_ps(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm256_add_ps(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm256_sub_ps(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm256_mul_ps(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm256_div_ps(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm256_fmadd_ps(a, b, c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm256_fnmadd_ps(a, b, c);
+	}
+
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm256_min_ps(lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm256_max_ps(lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ)));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ)));
+	}
+
+	static float hsum(reg val) noexcept {
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(val), _mm256_extractf128_ps(val, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		return _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 1)));
+	}
+};
+
+template<>
+struct simd<double> {
+	using reg = __m256d;
+	static constexpr size_t width = 4;
+
+	static reg zero() noexcept {
+		return _mm256_setzero_pd();
+	}
+
+	static reg set1(double val) noexcept {
+		return _mm256_set1_pd(val);
+	}
+
+	static reg load(const double *ptr) noexcept {
+		return _mm256_loadu_pd(ptr);
+	}
+
+	static void store(double *ptr, reg val) noexcept {
+		_mm256_storeu_pd(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm256_add_pd(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm256_sub_pd(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm256_mul_pd(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm256_div_pd(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm256_fmadd_pd(a, b, c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm256_fnmadd_pd(a, b, c);
+	}
+
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm256_min_pd(lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm256_max_pd(lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ)));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ)));
+	}
+
+	static double hsum(reg val) noexcept {
+		const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(val), _mm256_extractf128_pd(val, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+	}
+};
+#elif NSTD_SIMD_SSE2
+template<>
+struct simd<float> {
+	using reg = __m128;
+	static constexpr size_t width = 4;
+
+	static reg zero() noexcept {
+		return _mm_setzero_ps();
+	}
+
+	static reg set1(float val) noexcept {
+		return _mm_set1_ps(val);
+	}
+
+	static reg load(const float *ptr) noexcept {
+		return _mm_loadu_ps(ptr);
+	}
+
+	static void store(float *ptr, reg val) noexcept {
+		_mm_storeu_ps(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm_add_ps(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm_sub_ps(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm_mul_ps(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm_div_ps(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm_sub_ps(c, _mm_mul_ps(a, b));
+	}
+
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm_min_ps(lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm_max_ps(lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(lhs, rhs)));
+	}
+
+	static float hsum(reg val) noexcept {
+		val = _mm_add_ps(val, _mm_movehl_ps(val, val));
+		return _mm_cvtss_f32(_mm_add_ss(val, _mm_shuffle_ps(val, val, 1)));
+	}
+};
+
+template<>
+struct simd<double> {
+	using reg = __m128d;
+	static constexpr size_t width = 2;
+
+	static reg zero() noexcept {
+		return _mm_setzero_pd();
+	}
+
+	static reg set1(double val) noexcept {
+		return _mm_set1_pd(val);
+	}
+
+	static reg load(const double *ptr) noexcept {
+		return _mm_loadu_pd(ptr);
+	}
+
+	static void store(double *ptr, reg val) noexcept {
+		_mm_storeu_pd(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm_add_pd(lhs, rhs);
+	}
+
+	static reg sub(reg lhs, reg rhs) noexcept {
+		return _mm_sub_pd(lhs, rhs);
+	}
+
+	static reg mul(reg lhs, reg rhs) noexcept {
+		return _mm_mul_pd(lhs, rhs);
+	}
+
+	static reg div(reg lhs, reg rhs) noexcept {
+		return _mm_div_pd(lhs, rhs);
+	}
+
+	static reg fmadd(reg a, reg b, reg c) noexcept {
+		return _mm_add_pd(_mm_mul_pd(a, b), c);
+	}
+
+	// c - a * b
+	static reg fnmadd(reg a, reg b, reg c) noexcept {
+		return _mm_sub_pd(c, _mm_mul_pd(a, b));
+	}
+
+	static reg min(reg lhs, reg rhs) noexcept {
+		return _mm_min_pd(lhs, rhs);
+	}
+
+	static reg max(reg lhs, reg rhs) noexcept {
+		return _mm_max_pd(lhs, rhs);
+	}
+
+	static unsigned lt_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(lhs, rhs)));
+	}
+
+	static unsigned le_mask(reg lhs, reg rhs) noexcept {
+		return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(lhs, rhs)));
+	}
+
+	static double hsum(reg val) noexcept {
+		return _mm_cvtsd_f64(_mm_add_sd(val, _mm_unpackhi_pd(val, val)));
+	}
+};
+#endif
+
+// simd_i16 BEGINS
+/*
+ * 1. a register holds width int32 lanes: 2 * width int16 on input (load, or load_i8 sign-extending int8),
+ *    width int32 sums on output; set1 broadcasts one packed pair (low half first, see pair())
+ * 2. madd(a, b, acc) adds a[2l] * b[2l] + a[2l + 1] * b[2l + 1] to lane l, wrapping like the instructions
+ * 3. madd_wide accumulates the same pair sums into two registers of int64 lanes, lo: lanes [0, width / 2), hi: the rest
+ * ! a pair of two -32768 * -32768 products does not fit its int32 lane, as in pmaddwd / vpdpwssd themselves !
+ */
+struct simd_i16_scalar {
+	using reg = std::int32_t;
+	using wide = long long;
+	static constexpr size_t width = 1;
+
+	static constexpr std::int32_t pair(std::int16_t lo, std::int16_t hi) noexcept {
+		return static_cast<std::int32_t>(static_cast<std::uint16_t>(lo) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(hi)) << 16));
+	}
+
+	static reg zero() noexcept {
+		return 0;
+	}
+
+	static wide zero_wide() noexcept {
+		return 0;
+	}
+
+	static reg set1(std::int32_t pair) noexcept {
+		return pair;
+	}
+
+	static reg load(const std::int16_t *ptr) noexcept {
+		return pair(ptr[0], ptr[1]);
+	}
+
+	static reg load_i8(const std::int8_t *ptr) noexcept {
+		return pair(ptr[0], ptr[1]);
+	}
+
+	static void store(std::int32_t *ptr, reg val) noexcept {
+		*ptr = val;
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return static_cast<std::int32_t>(static_cast<std::uint32_t>(lhs) + static_cast<std::uint32_t>(rhs));
+	}
+
+	static reg madd(reg a, reg b, reg acc) noexcept {
+		const std::int32_t lo = static_cast<std::int16_t>(a) * static_cast<std::int16_t>(b);
+		const std::int32_t hi = static_cast<std::int16_t>(a >> 16) * static_cast<std::int16_t>(b >> 16);
+		return add(acc, add(lo, hi));
+	}
+
+	static void madd_wide(reg a, reg b, wide &lo, wide &) noexcept {
+		lo += static_cast<long long>(madd(a, b, 0));
+	}
+
+	static void store_wide(long long *ptr, wide lo, wide) noexcept {
+		*ptr = lo;
+	}
+
+	static std::int32_t hsum(reg val) noexcept {
+		return val;
+	}
+};
+
+#if NSTD_SIMD_AVX512 && defined(__AVX512BW__)
+struct simd_i16 : simd_i16_scalar {
+	using reg = __m512i;
+	using wide = __m512i;
+	static constexpr size_t width = 16;
+
+	static reg zero() noexcept {
+		return _mm512_setzero_si512();
+	}
+
+	static wide zero_wide() noexcept {
+		return _mm512_setzero_si512();
+	}
+
+	static reg set1(std::int32_t pair) noexcept {
+		return _mm512_set1_epi32(pair);
+	}
+
+	static reg load(const std::int16_t *ptr) noexcept {
+		return _mm512_loadu_si512(ptr);
+	}
+
+	static reg load_i8(const std::int8_t *ptr) noexcept {
+		return _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)));
+	}
+
+	static void store(std::int32_t *ptr, reg val) noexcept {
+		_mm512_storeu_si512(ptr, val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm512_add_epi32(lhs, rhs);
+	}
+
+	static reg madd(reg a, reg b, reg acc) noexcept {
+#	if NSTD_SIMD_VNNI
+		return _mm512_dpwssd_epi32(acc, a, b);
+#	else
+		return _mm512_add_epi32(acc, _mm512_madd_epi16(a, b));
+#	endif
+	}
+
+	static void madd_wide(reg a, reg b, wide &lo, wide &hi) noexcept {
+		const __m512i sums = _mm512_madd_epi16(a, b);
+		lo = _mm512_add_epi64(lo, _mm512_maskz_cvtepi32_epi64(0xff, _mm512_maskz_extracti64x4_epi64(0xf, sums, 0)));
+		hi = _mm512_add_epi64(hi, _mm512_maskz_cvtepi32_epi64(0xff, _mm512_maskz_extracti64x4_epi64(0xf, sums, 1)));
+	}
+
+	static void store_wide(long long *ptr, wide lo, wide hi) noexcept {
+		_mm512_storeu_si512(ptr, lo);
+		_mm512_storeu_si512(ptr + 8, hi);
+	}
+
+	static std::int32_t hsum(reg val) noexcept {
+		const __m256i half = _mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xf, val, 0), _mm512_maskz_extracti64x4_epi64(0xf, val, 1));
+		__m128i quarter = _mm_add_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+		quarter = _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0x4e));
+		quarter = _mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0xb1));
+		return _mm_cvtsi128_si32(quarter);
+	}
+};
+#elif NSTD_SIMD_AVX
+struct simd_i16 : simd_i16_scalar {
+	using reg = __m256i;
+	using wide = __m256i;
+	static constexpr size_t width = 8;
+
+	static reg zero() noexcept {
+		return _mm256_setzero_si256();
+	}
+
+	static wide zero_wide() noexcept {
+		return _mm256_setzero_si256();
+	}
+
+	static reg set1(std::int32_t pair) noexcept {
+		return _mm256_set1_epi32(pair);
+	}
+
+	static reg load(const std::int16_t *ptr) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+	}
+
+	static reg load_i8(const std::int8_t *ptr) noexcept {
+		return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+	}
+
+	static void store(std::int32_t *ptr, reg val) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm256_add_epi32(lhs, rhs);
+	}
+
+	static reg madd(reg a, reg b, reg acc) noexcept {
+		return _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+	}
+
+	static void madd_wide(reg a, reg b, wide &lo, wide &hi) noexcept {
+		const __m256i sums = _mm256_madd_epi16(a, b);
+		lo = _mm256_add_epi64(lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(sums)));
+		hi = _mm256_add_epi64(hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(sums, 1)));
+	}
+
+	static void store_wide(long long *ptr, wide lo, wide hi) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr + 4), hi);
+	}
+
+	static std::int32_t hsum(reg val) noexcept {
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(val), _mm256_extracti128_si256(val, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4e));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xb1));
+		return _mm_cvtsi128_si32(half);
+	}
+};
+#elif NSTD_SIMD_SSE2
+struct simd_i16 : simd_i16_scalar {
+	using reg = __m128i;
+	using wide = __m128i;
+	static constexpr size_t width = 4;
+
+	static reg zero() noexcept {
+		return _mm_setzero_si128();
+	}
+
+	static wide zero_wide() noexcept {
+		return _mm_setzero_si128();
+	}
+
+	static reg set1(std::int32_t pair) noexcept {
+		return _mm_set1_epi32(pair);
+	}
+
+	static reg load(const std::int16_t *ptr) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+	}
+
+	// unpacking a byte with itself and shifting right by 8 sign-extends it, SSE2 has no pmovsxbw
+	static reg load_i8(const std::int8_t *ptr) noexcept {
+		const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr));
+		return _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+	}
+
+	static void store(std::int32_t *ptr, reg val) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), val);
+	}
+
+	static reg add(reg lhs, reg rhs) noexcept {
+		return _mm_add_epi32(lhs, rhs);
+	}
+
+	static reg madd(reg a, reg b, reg acc) noexcept {
+		return _mm_add_epi32(acc, _mm_madd_epi16(a, b));
+	}
+
+	static void madd_wide(reg a, reg b, wide &lo, wide &hi) noexcept {
+		const __m128i sums = _mm_madd_epi16(a, b);
+		const __m128i sign = _mm_srai_epi32(sums, 31);
+		lo = _mm_add_epi64(lo, _mm_unpacklo_epi32(sums, sign));
+		hi = _mm_add_epi64(hi, _mm_unpackhi_epi32(sums, sign));
+	}
+
+	static void store_wide(long long *ptr, wide lo, wide hi) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), lo);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr + 2), hi);
+	}
+
+	static std::int32_t hsum(reg val) noexcept {
+		val = _mm_add_epi32(val, _mm_shuffle_epi32(val, 0x4e));
+		val = _mm_add_epi32(val, _mm_shuffle_epi32(val, 0xb1));
+		return _mm_cvtsi128_si32(val);
+	}
+};
+#else
+struct simd_i16 : simd_i16_scalar {};
+#endif
+// simd_i16 ENDS
+
+}  // namespace NSTD_SIMD_ABI
+
+}  // namespace internal
+
+// name of the instruction set the simd kernels were compiled for
+inline constexpr const char *simd_isa = NSTD_SIMD_AVX512 ? "avx512" : NSTD_SIMD_AVX ? "avx2" : NSTD_SIMD_SSE2 ? "sse2" : "scalar";
+
+}  // namespace nstd
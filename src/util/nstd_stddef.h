@@ -6,4 +6,7 @@ using size_t = decltype(sizeof(0));
 using ptrdiff_t = decltype(static_cast<int *>(0) - static_cast<int *>(0));
 using nullptr_t = decltype(nullptr);
 
+// NOTE: fixed instead of std::hardware_destructive_interference_size, whose value may differ between TUs
+inline constexpr size_t cache_line_size = 64;
+
 }  // namespace nstd
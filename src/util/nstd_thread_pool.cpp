@@ -0,0 +1,116 @@
+#include <util/nstd_thread_pool.h>
+
+namespace nstd {
+
+namespace {
+
+thread_local bool in_task = false;
+
+}  // namespace
+
+thread_pool::thread_pool(size_t threads) {
+	const size_t workers = threads > 1 ? threads - 1 : 0;
+	_Workers.reserve(workers);
+	for (size_t i = 0; i < workers; i++) {
+		_Workers.emplace_back([this] { work_loop(); });
+	}
+}
+
+thread_pool::~thread_pool() {
+	{
+		std::lock_guard lock(_Mutex);
+		_Stop = true;
+	}
+	_Wake.notify_all();
+	for (auto &worker : _Workers) {
+		worker.join();
+	}
+}
+
+void thread_pool::drain(job &j) noexcept {
+	const bool outer = in_task;
+	in_task = true;
+	for (size_t task; (task = j._Next.fetch_add(1, std::memory_order_relaxed)) < j._TaskCount;) {
+		try {
+			j._Invoke(j._Ctx, task);
+		} catch (...) {
+			std::lock_guard lock(j._ErrorMutex);
+			if (!j._Error) {
+				j._Error = std::current_exception();
+			}
+		}
+	}
+	in_task = outer;
+}
+
+void thread_pool::work_loop() {
+	unsigned long long seen = 0;
+	for (;;) {
+		job *j;
+		{
+			std::unique_lock lock(_Mutex);
+			_Wake.wait(lock, [&] { return _Stop || _Generation != seen; });
+			if (_Stop) {
+				return;
+			}
+			seen = _Generation;
+			j = _Job;
+			if (j == nullptr) {
+				continue;
+			}
+			_Active++;
+		}
+		drain(*j);
+		std::lock_guard lock(_Mutex);
+		if (--_Active == 0) {
+			_Finished.notify_all();
+		}
+	}
+}
+
+void thread_pool::run_job(void (*invoke)(const void *, size_t), const void *ctx, size_t tasks) {
+	bool expected = false;
+	if (_Workers.empty() || tasks == 1 || in_task || !_Busy.compare_exchange_strong(expected, true)) {
+		const bool outer = in_task;
+		in_task = true;
+		try {
+			for (size_t i = 0; i < tasks; i++) {
+				invoke(ctx, i);
+			}
+		} catch (...) {
+			in_task = outer;
+			throw;
+		}
+		in_task = outer;
+		return;
+	}
+
+	job j;
+	j._Invoke = invoke;
+	j._Ctx = ctx;
+	j._TaskCount = tasks;
+	{
+		std::lock_guard lock(_Mutex);
+		_Job = &j;
+		_Generation++;
+	}
+	_Wake.notify_all();
+
+	drain(j);
+	{
+		std::unique_lock lock(_Mutex);
+		_Finished.wait(lock, [&] { return _Active == 0; });
+		_Job = nullptr;
+	}
+	_Busy.store(false, std::memory_order_release);
+	if (j._Error) {
+		std::rethrow_exception(j._Error);
+	}
+}
+
+thread_pool &thread_pool::global() {
+	static thread_pool instance;
+	return instance;
+}
+
+}  // namespace nstd
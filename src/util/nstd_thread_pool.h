@@ -0,0 +1,89 @@
+#pragma once
+
+#include <util/nstd_stddef.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * fixed-size fork-join pool for data-parallel kernels
+ * 1. run() hands out task indices dynamically, the calling thread works on the job too
+ * 2. one job runs at a time; a run() issued from inside a task (or while another job is running)
+ *    executes serially on the calling thread instead of deadlocking
+ * 3. the first exception thrown by a task is rethrown by run() once all tasks have finished
+ */
+
+namespace nstd {
+
+class thread_pool {
+	struct job {
+		void (*_Invoke)(const void *ctx, size_t task);
+		const void *_Ctx;
+		size_t _TaskCount;
+		std::atomic<size_t> _Next{ 0 };
+		std::exception_ptr _Error;
+		std::mutex _ErrorMutex;
+	};
+
+	std::vector<std::thread> _Workers;
+	std::mutex _Mutex;
+	std::condition_variable _Wake;
+	std::condition_variable _Finished;
+	job *_Job = nullptr;
+	size_t _Active = 0;  // workers inside the current job, it must outlive them
+	unsigned long long _Generation = 0;
+	bool _Stop = false;
+	std::atomic<bool> _Busy{ false };
+
+	void work_loop();
+	static void drain(job &j) noexcept;
+	void run_job(void (*invoke)(const void *, size_t), const void *ctx, size_t tasks);
+
+public:
+	// threads counts the calling thread, so thread_pool(1) spawns no workers
+	explicit thread_pool(size_t threads = std::thread::hardware_concurrency());
+
+	thread_pool(const thread_pool &) = delete;
+	thread_pool &operator=(const thread_pool &) = delete;
+
+	~thread_pool();
+
+	// workers plus the calling thread
+	size_t size() const noexcept {
+		return _Workers.size() + 1;
+	}
+
+	// calls fn(task) for every task in [0, tasks), returns when all are done
+	template<typename Fn>
+	void run(size_t tasks, Fn &&fn) {
+		if (tasks == 0) {
+			return;
+		}
+		run_job([](const void *ctx, size_t task) { (*static_cast<const Fn *>(ctx))(task); }, &fn, tasks);
+	}
+
+	// splits [begin, end) into about size() * 4 chunks of at least grain and calls fn(lo, hi) on each
+	template<typename Fn>
+	void parallel_for(size_t begin, size_t end, Fn &&fn, size_t grain = 1) {
+		if (begin >= end) {
+			return;
+		}
+		const size_t n = end - begin;
+		grain = grain == 0 ? 1 : grain;
+		size_t chunks = size() * 4;
+		if (n / grain < chunks) {
+			chunks = n / grain == 0 ? 1 : n / grain;
+		}
+		run(chunks, [&](size_t c) { fn(begin + n * c / chunks, begin + n * (c + 1) / chunks); });
+	}
+
+	// process-wide pool sized to the hardware, created on first use
+	static thread_pool &global();
+};
+
+}  // namespace nstd
@@ -393,6 +393,24 @@ template<typename Ty>
 using remove_cvref_t = typename remove_cvref<Ty>::type;
 // remove_cvref ENDS
 
+// is_trivially_copyable BEGINS
+template<typename Ty>
+struct is_trivially_copyable : bool_constant<__is_trivially_copyable(Ty)> {};
+
+template<typename Ty>
+constexpr bool is_trivially_copyable_v = is_trivially_copyable<Ty>::value;
+// is_trivially_copyable ENDS
+
+// is_trivially_relocatable BEGINS
+// a move followed by destroying the source can be replaced by a memcpy,
+// specialize it for types such as owning handles that are relocatable but not trivially copyable
+template<typename Ty>
+struct is_trivially_relocatable : is_trivially_copyable<Ty> {};
+
+template<typename Ty>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Ty>::value;
+// is_trivially_relocatable ENDS
+
 // decay BEGINS
 // template<typename Ty>
 // struct decay {
@@ -0,0 +1,188 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_chunked_ndarray.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace test_chunked_ndarray {
+
+std::string temp_path(const char *name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+using field = nstd::chunked_ndarray<int, 4, 8>;
+
+// global shape 10 x 20, i.e. a 3 x 3 grid of 4 x 8 tiles with padded edges
+field make_field(const std::string &path) {
+	auto arr = field::create(path.c_str(), { 10, 20 });
+	field::tile_type tile;
+	for (nstd::size_t t = 0; t < arr.tile_count(); t++) {
+		const auto info = arr.info(t);
+		tile.fill(0);
+		for (nstd::size_t i = 0; i < info._Extent[0]; i++) {
+			for (nstd::size_t j = 0; j < info._Extent[1]; j++) {
+				tile[i][j] = static_cast<int>((info._Origin[0] + i) * 100 + info._Origin[1] + j);
+			}
+		}
+		arr.write_tile(t, tile);
+	}
+	return arr;
+}
+
+// written for plain in-memory ndarrays
+void double_tile(const nstd::ndarray<int, 4, 8> &in, nstd::ndarray<int, 4, 8> &out) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 8; j++) {
+			out[i][j] = in[i][j] * 2;
+		}
+	}
+}
+
+}  // namespace test_chunked_ndarray
+
+TEST_CASE("tile grid") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_grid.bin");
+	auto arr = test_chunked_ndarray::make_field(path);
+	CHECK_EQ(arr.tile_count(), 9);
+	CHECK_EQ(arr.grid_extent(0), 3);
+	CHECK_EQ(arr.grid_extent(1), 3);
+	CHECK_EQ(arr.size(), 200);
+
+	const auto info = arr.info(5);  // row 1, column 2
+	CHECK_EQ(info._Origin[0], 4);
+	CHECK_EQ(info._Origin[1], 16);
+	CHECK_EQ(info._Extent[0], 4);
+	CHECK_EQ(info._Extent[1], 4);
+
+	test_chunked_ndarray::field::tile_type tile;
+	arr.read_tile(8, tile);
+	CHECK_EQ(tile[0][0], 816);
+	CHECK_EQ(tile[1][3], 919);
+	CHECK_EQ(tile[2][0], 0);  // padding
+	CHECK_THROWS(arr.read_tile(9, tile));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("reopen") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_reopen.bin");
+	test_chunked_ndarray::make_field(path);
+
+	const test_chunked_ndarray::field arr(path.c_str());
+	CHECK_EQ(arr.extent(0), 10);
+	CHECK_EQ(arr.extent(1), 20);
+	CHECK_THROWS(nstd::chunked_ndarray<int, 8, 4>(path.c_str()));
+	CHECK_THROWS(nstd::chunked_ndarray<float, 4, 8>(path.c_str()));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("crafted headers") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_crafted.bin");
+	const auto patch = [&](size_t offset, unsigned long long val) {
+		test_chunked_ndarray::field::create(path.c_str(), { 10, 20 });
+		nstd::file f(path.c_str(), nstd::open_mode::read_write);
+		f.write_at(&val, sizeof(val), offset);
+	};
+	using test_chunked_ndarray::field;
+	const size_t shape = offsetof(nstd::chunked_header, _Shape), data = offsetof(nstd::chunked_header, _DataOffset);
+
+	// tile counts or tile offsets that wrap to something small
+	patch(shape, ~0ULL);
+	CHECK_THROWS(field(path.c_str()));
+	patch(shape, 1ULL << 62);
+	CHECK_THROWS(field(path.c_str()));
+	patch(data, ~0ULL - 4095);
+	CHECK_THROWS(field(path.c_str()));
+	// elements inside the header, misaligned elements
+	patch(data, 0);
+	CHECK_THROWS(field(path.c_str()));
+	patch(data, 4096 + 8);
+	CHECK_THROWS(field(path.c_str()));
+
+	patch(shape, 10);
+	CHECK_EQ(field(path.c_str()).tile_count(), 9);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("tile_stream") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_stream.bin");
+	const auto arr = test_chunked_ndarray::make_field(path);
+
+	nstd::size_t seen = 0;
+	nstd::tile_stream<int, 4, 8> stream(arr);
+	while (const auto *tile = stream.next()) {
+		const auto info = arr.info(stream.index());
+		CHECK_EQ(stream.index(), seen);
+		CHECK_EQ((*tile)[0][0], static_cast<int>(info._Origin[0] * 100 + info._Origin[1]));
+		seen++;
+	}
+	CHECK_EQ(seen, 9);
+	CHECK(stream.next() == nullptr);
+
+	// a sub-range, abandoned half-way
+	nstd::tile_stream<int, 4, 8> partial(arr, 3, 7);
+	REQUIRE(partial.next() != nullptr);
+	CHECK_EQ(partial.index(), 3);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("reduce") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_reduce.bin");
+	const auto arr = test_chunked_ndarray::make_field(path);
+
+	long long expected = 0;
+	for (int i = 0; i < 10; i++) {
+		for (int j = 0; j < 20; j++) {
+			expected += i * 100 + j;
+		}
+	}
+	CHECK_EQ(nstd::reduce(arr, 0ll, [](long long acc, int x) { return acc + x; }), expected);
+	CHECK_EQ(nstd::reduce(arr, 0, [](int acc, int) { return acc + 1; }), 200);  // padding is skipped
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("transform") {
+	const auto src_path = test_chunked_ndarray::temp_path("nstd_test_chunked_src.bin");
+	const auto dst_path = test_chunked_ndarray::temp_path("nstd_test_chunked_dst.bin");
+	auto src = test_chunked_ndarray::make_field(src_path);
+	auto dst = test_chunked_ndarray::field::create(dst_path.c_str(), { 10, 20 });
+
+	nstd::transform(src, dst, test_chunked_ndarray::double_tile);
+	test_chunked_ndarray::field::tile_type tile;
+	dst.read_tile(4, tile);
+	CHECK_EQ(tile[1][1], 2 * 509);
+
+	nstd::transform(src, src, [](int x) { return x + 1; });  // in place, element-wise
+	src.read_tile(4, tile);
+	CHECK_EQ(tile[1][1], 510);
+
+	nstd::size_t tiles = 0;
+	nstd::for_each_tile(src, [&](const test_chunked_ndarray::field::tile_type &t, const auto &info) {
+		CHECK_EQ(t[0][0], static_cast<int>(info._Origin[0] * 100 + info._Origin[1] + 1));
+		tiles++;
+	});
+	CHECK_EQ(tiles, 9);
+
+	auto small = test_chunked_ndarray::field::create(dst_path.c_str(), { 4, 4 });
+	CHECK_THROWS(nstd::transform(src, small, [](int x) { return x; }));
+	std::filesystem::remove(src_path);
+	std::filesystem::remove(dst_path);
+}
+
+TEST_CASE("3d, rank 1") {
+	const auto path = test_chunked_ndarray::temp_path("nstd_test_chunked_3d.bin");
+	{
+		auto arr = nstd::chunked_ndarray<float, 2, 3, 4>::create(path.c_str(), { 5, 5, 5 });
+		nstd::transform(arr, arr, [](float) { return 1.0f; });
+		CHECK_EQ(nstd::reduce(arr, 0.0, [](double acc, float x) { return acc + x; }), 125.0);
+	}
+	{
+		auto arr = nstd::chunked_ndarray<double, 16>::create(path.c_str(), { 40 });
+		nstd::transform(arr, arr, [](double) { return 0.5; });
+		CHECK_EQ(nstd::reduce(arr, 0.0, [](double acc, double x) { return acc + x; }), 20.0);
+	}
+	std::filesystem::remove(path);
+}
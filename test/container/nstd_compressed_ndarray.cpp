@@ -0,0 +1,96 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_compressed_ndarray.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+
+namespace test_compressed_ndarray {
+
+using field = nstd::compressed_ndarray<float, 16, 16>;
+
+// written for plain in-memory ndarrays
+void negate_tile(const nstd::ndarray<float, 16, 16> &in, nstd::ndarray<float, 16, 16> &out) {
+	for (int i = 0; i < 16; i++) {
+		for (int j = 0; j < 16; j++) {
+			out[i][j] = -in[i][j];
+		}
+	}
+}
+
+}  // namespace test_compressed_ndarray
+
+TEST_CASE("zero init / footprint") {
+	test_compressed_ndarray::field arr({ 100, 70 });
+	CHECK_EQ(arr.tile_count(), 7 * 5);
+	CHECK_EQ(arr.size(), 7000);
+	CHECK_EQ(arr.get({ 99, 69 }), 0.0f);
+	CHECK_LT(arr.footprint(), arr.raw_bytes() / 10);
+	CHECK_THROWS(arr.get({ 100, 0 }));
+	CHECK_THROWS(arr.set({ 0, 70 }, 1.0f));
+}
+
+TEST_CASE("element access through the cache") {
+	for (auto shuffle : { nstd::shuffle_mode::none, nstd::shuffle_mode::byte, nstd::shuffle_mode::bit }) {
+		nstd::compressed_ndarray<double, 8, 8, 8> arr({ 20, 20, 20 }, shuffle, 2);
+		for (nstd::size_t i = 0; i < 20; i++) {
+			for (nstd::size_t j = 0; j < 20; j++) {
+				for (nstd::size_t k = 0; k < 20; k++) {
+					arr.set({ i, j, k }, static_cast<double>(i * 400 + j * 20 + k));  // evicts dirty tiles constantly
+				}
+			}
+		}
+		bool same = true;
+		for (nstd::size_t i = 0; i < 20; i++) {
+			for (nstd::size_t j = 0; j < 20; j++) {
+				for (nstd::size_t k = 0; k < 20; k++) {
+					same = same && arr.get({ i, j, k }) == static_cast<double>(i * 400 + j * 20 + k);
+				}
+			}
+		}
+		CHECK(same);
+
+		arr.flush();
+		nstd::ndarray<double, 8, 8, 8> tile;
+		arr.read_tile(arr.tile_count() - 1, tile);
+		CHECK_EQ(tile[3][3][3], 19.0 * 400 + 19 * 20 + 19);
+		CHECK_EQ(tile[4][0][0], 0.0);  // padding
+	}
+}
+
+TEST_CASE("tile kernels") {
+	test_compressed_ndarray::field arr({ 40, 40 });
+	nstd::transform(arr, [](float) { return 2.0f; });
+	arr.set({ 5, 5 }, 10.0f);  // cached and dirty, seen by the next pass
+	nstd::transform(arr, test_compressed_ndarray::negate_tile);
+
+	CHECK_EQ(arr.get({ 5, 5 }), -10.0f);
+	CHECK_EQ(arr.get({ 39, 39 }), -2.0f);
+	CHECK_EQ(nstd::reduce(arr, 0.0, [](double acc, float x) { return acc + x; }), -2.0 * 1599 - 10.0);
+
+	nstd::size_t tiles = 0;
+	nstd::for_each_tile(arr, [&](const auto &tile, const auto &info) {
+		CHECK_EQ(info._Index, tiles);
+		CHECK_EQ(tile[0][0], -2.0f);
+		tiles++;
+	});
+	CHECK_EQ(tiles, 9);
+}
+
+TEST_CASE("smooth fields compress") {
+	test_compressed_ndarray::field arr({ 256, 256 });
+	nstd::ndarray<float, 16, 16> tile;
+	for (nstd::size_t t = 0; t < arr.tile_count(); t++) {
+		const auto info = arr.info(t);
+		for (nstd::size_t i = 0; i < 16; i++) {
+			for (nstd::size_t j = 0; j < 16; j++) {
+				const float x = static_cast<float>(info._Origin[0] + i), y = static_cast<float>(info._Origin[1] + j);
+				tile[i][j] = std::round(std::sin(x * 0.01f) * std::cos(y * 0.01f) * 1000.0f) / 1000.0f;
+			}
+		}
+		arr.write_tile(t, tile);
+	}
+	CHECK_LT(arr.footprint(), arr.raw_bytes());
+	CHECK_EQ(arr.get({ 100, 0 }), std::round(std::sin(1.0f) * 1000.0f) / 1000.0f);
+}
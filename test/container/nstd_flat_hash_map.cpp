@@ -0,0 +1,202 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_flat_hash_map.h>
+#include <math/linalg/nstd_vector.h>
+
+// TODO: REMOVE these deps in future versions
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+TEST_CASE("empty") {
+	nstd::flat_hash_map<int, int> map;
+	CHECK(map.empty());
+	CHECK_EQ(map.capacity(), 0);
+	CHECK(map.find(1) == map.end());
+	CHECK(map.begin() == map.end());
+	CHECK_EQ(map.erase(1), 0);
+	CHECK_THROWS(map.at(1));
+}
+
+TEST_CASE("insert / find / erase") {
+	nstd::flat_hash_map<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map.try_emplace(i, i * 2).second);
+	}
+	CHECK_FALSE(map.try_emplace(5, 0).second);
+	CHECK_EQ(map.size(), 1000);
+	for (int i = 0; i < 1000; i++) {
+		REQUIRE(map.contains(i));
+		CHECK_EQ(map.at(i), i * 2);
+	}
+	CHECK_FALSE(map.contains(1000));
+
+	for (int i = 0; i < 1000; i += 2) {
+		CHECK_EQ(map.erase(i), 1);
+	}
+	CHECK_EQ(map.size(), 500);
+	for (int i = 0; i < 1000; i++) {
+		CHECK_EQ(map.contains(i), i % 2 == 1);
+	}
+	CHECK_LE(map.load_factor(), 1.0f);
+}
+
+TEST_CASE("operator[] / insert_or_assign") {
+	nstd::flat_hash_map<std::string, int> map;
+	map["a"] = 1;
+	map["b"]++;
+	map["b"]++;
+	CHECK_EQ(map["a"], 1);
+	CHECK_EQ(map["b"], 2);
+	CHECK_FALSE(map.insert_or_assign("a", 10).second);
+	CHECK_EQ(map.at("a"), 10);
+}
+
+TEST_CASE("iteration / erase while iterating") {
+	nstd::flat_hash_map<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map[i] = i;
+	}
+	int sum = 0;
+	for (auto &[k, v] : map) {
+		CHECK_EQ(k, v);
+		sum += v;
+	}
+	CHECK_EQ(sum, 4950);
+
+	for (auto it = map.begin(); it != map.end();) {
+		if (it->first % 3 == 0) {
+			map.erase(it++);
+		} else {
+			++it;
+		}
+	}
+	CHECK_EQ(map.size(), 66);
+}
+
+TEST_CASE("tombstone churn does not grow the table") {
+	nstd::flat_hash_map<int, int> map;
+	map.reserve(100);
+	const nstd::size_t cap = map.capacity();
+	for (int round = 0; round < 100; round++) {
+		for (int i = 0; i < 50; i++) {
+			map[round * 50 + i] = i;
+		}
+		for (int i = 0; i < 50; i++) {
+			CHECK_EQ(map.erase(round * 50 + i), 1);
+		}
+	}
+	CHECK(map.empty());
+	CHECK_EQ(map.capacity(), cap);
+}
+
+TEST_CASE("copy / move / clear") {
+	nstd::flat_hash_map<int, std::string> map;
+	for (int i = 0; i < 100; i++) {
+		map[i] = std::to_string(i);
+	}
+	auto copy = map;
+	CHECK_EQ(copy.size(), 100);
+	CHECK_EQ(copy.at(42), "42");
+
+	auto moved = std::move(copy);
+	CHECK_EQ(moved.at(99), "99");
+	CHECK(copy.empty());
+
+	moved.clear();
+	CHECK(moved.empty());
+	CHECK_FALSE(moved.contains(1));
+	moved[1] = "1";
+	CHECK_EQ(moved.size(), 1);
+}
+
+TEST_CASE("vector3i keys") {
+	nstd::flat_hash_map<nstd::linalg::vector3i, int> grid;
+	for (int x = -10; x < 10; x++) {
+		for (int y = -10; y < 10; y++) {
+			for (int z = -10; z < 10; z++) {
+				grid[nstd::linalg::vector3i(x, y, z)] = x * 10000 + y * 100 + z;
+			}
+		}
+	}
+	CHECK_EQ(grid.size(), 8000);
+	CHECK_EQ(grid.at(nstd::linalg::vector3i(3, -4, 5)), 30000 - 400 + 5);
+	CHECK_FALSE(grid.contains(nstd::linalg::vector3i(10, 0, 0)));
+
+	nstd::hash<nstd::linalg::vector3i> h;
+	CHECK_NE(h(nstd::linalg::vector3i(1, 2, 3)), h(nstd::linalg::vector3i(3, 2, 1)));
+}
+
+TEST_CASE("random ops against std::unordered_map") {
+	std::mt19937_64 engine(42);
+	std::uniform_int_distribution<int> key_dist(0, 5000);
+	std::uniform_int_distribution<int> op_dist(0, 2);
+
+	nstd::flat_hash_map<int, int> map;
+	std::unordered_map<int, int> ref;
+	for (int i = 0; i < 200000; i++) {
+		const int key = key_dist(engine);
+		switch (op_dist(engine)) {
+		case 0:
+			map[key] = i;
+			ref[key] = i;
+			break;
+		case 1:
+			CHECK_EQ(map.erase(key), ref.erase(key));
+			break;
+		default:
+			CHECK_EQ(map.contains(key), ref.count(key) == 1);
+			break;
+		}
+	}
+	REQUIRE_EQ(map.size(), ref.size());
+	for (auto &[k, v] : ref) {
+		CHECK_EQ(map.at(k), v);
+	}
+}
+
+namespace test_flat_hash_map {
+
+// throws from its constructor for negative values
+struct picky {
+	std::string _Name;
+
+	explicit picky(int v) {
+		if (v < 0) {
+			throw std::runtime_error("negative!");
+		}
+		_Name = std::to_string(v);
+	}
+};
+
+}  // namespace test_flat_hash_map
+
+TEST_CASE("throwing value constructor leaves no slot behind") {
+	using test_flat_hash_map::picky;
+	nstd::flat_hash_map<int, picky> map;
+	for (int i = 0; i < 500; i++) {
+		if (i % 3 == 0) {
+			CHECK_THROWS(map.try_emplace(i, -i - 1));
+			CHECK_FALSE(map.contains(i));
+		} else {
+			CHECK(map.try_emplace(i, i).second);
+		}
+	}
+	const size_t expected = 500 - 167;
+	CHECK_EQ(map.size(), expected);
+	size_t visited = 0;
+	for (const auto &[key, val] : map) {
+		CHECK_EQ(val._Name, std::to_string(key));
+		visited++;
+	}
+	CHECK_EQ(visited, expected);
+
+	// the failed keys can still be inserted, copies and rehashes only see constructed slots
+	CHECK(map.try_emplace(0, 0).second);
+	nstd::flat_hash_map<int, picky> copy = map;
+	copy.reserve(4 * copy.capacity());
+	CHECK_EQ(copy.size(), expected + 1);
+	CHECK_EQ(copy.at(499)._Name, "499");
+}
@@ -0,0 +1,156 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_mapped_ndarray.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace test_mapped_ndarray {
+
+std::string temp_path(const char *name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace test_mapped_ndarray
+
+TEST_CASE("create / reopen") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_static.bin");
+	{
+		auto arr = nstd::mapped_ndarray<int, 5, 6, 7>::create(path.c_str());
+		CHECK(arr.is_open());
+		CHECK_EQ(arr[4][5][6], 0);  // zero-filled
+		for (int i = 0; i < 5; i++) {
+			for (int j = 0; j < 6; j++) {
+				for (int k = 0; k < 7; k++) {
+					arr[i][j][k] = i * 100 + j * 10 + k;
+				}
+			}
+		}
+		arr.flush();
+		CHECK_EQ(reinterpret_cast<nstd::size_t>(arr.data()) % nstd::cache_line_size, 0);
+	}
+
+	const nstd::mapped_ndarray<int, 5, 6, 7> arr(path.c_str());
+	CHECK_EQ(arr.mode(), nstd::map_mode::read_only);
+	arr.advise(nstd::access_hint::random);
+	CHECK_EQ(arr[3][2][1], 321);
+	CHECK_EQ(arr.data()[7], 10);  // row-major, same layout as basic_ndarray
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("copy-on-write") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_cow.bin");
+	{
+		auto arr = nstd::mapped_ndarray<float, 16>::create(path.c_str());
+		arr[3] = 1.5f;
+	}
+	{
+		nstd::mapped_ndarray<float, 16> cow(path.c_str(), nstd::map_mode::copy_on_write);
+		CHECK_EQ(cow[3], 1.5f);
+		cow[3] = 2.5f;
+		CHECK_EQ(cow[3], 2.5f);
+	}
+	nstd::mapped_ndarray<float, 16> arr(path.c_str());
+	CHECK_EQ(arr[3], 1.5f);  // the file is untouched
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("validation") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_check.bin");
+	nstd::mapped_ndarray<int, 4, 4>::create(path.c_str());
+
+	CHECK_THROWS(nstd::mapped_ndarray<int, 4, 5>(path.c_str()));     // shape
+	CHECK_THROWS(nstd::mapped_ndarray<int, 16>(path.c_str()));       // rank
+	CHECK_THROWS(nstd::mapped_ndarray<float, 4, 4>(path.c_str()));   // dtype
+	CHECK_THROWS(nstd::mapped_ndarray<int, 4, 4>("/nonexistent/x"));  // open
+
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::read_write);
+		f.resize(f.size() - 4);
+	}
+	CHECK_THROWS(nstd::mapped_ndarray<int, 4, 4>(path.c_str()));  // truncated
+
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::read_write);
+		f.write_at("X", 1, 0);
+	}
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));  // magic
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("crafted headers") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_crafted.bin");
+	const auto patch = [&](size_t offset, unsigned long long val) {
+		nstd::mapped_ndarray<int, 4, 4>::create(path.c_str());
+		nstd::file f(path.c_str(), nstd::open_mode::read_write);
+		f.write_at(&val, sizeof(val), offset);
+	};
+	const size_t shape = offsetof(nstd::mapped_header, _Shape), data = offsetof(nstd::mapped_header, _DataOffset);
+
+	// the shape product times the element size wraps to a small number
+	patch(shape, 1ULL << 62);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+	patch(shape, ~0ULL);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+	// the offset plus the elements wraps
+	patch(data, ~0ULL - 63);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+	// elements overlapping the header, misaligned elements
+	patch(data, 0);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+	patch(data, sizeof(nstd::mapped_header) + 4);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+	patch(offsetof(nstd::mapped_header, _Alignment), 3);
+	CHECK_THROWS(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()));
+
+	patch(shape, 4);  // untouched values still open
+	CHECK_EQ(nstd::dynamic_mapped_ndarray<int, 2>(path.c_str()).size(), 16);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("strict bounds") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_strict.bin");
+	auto arr = nstd::mapped_ndarray_strict<short, 3, 3>::create(path.c_str());
+	arr[2][2] = 7;
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS(arr[3][0]);
+	CHECK_THROWS(arr[0][3]);
+#endif
+
+	auto dyn = nstd::dynamic_mapped_ndarray_strict<short, 2>(path.c_str());
+	CHECK_EQ(dyn[2][2], 7);
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS(dyn[2][3]);
+#endif
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("dynamic shape") {
+	const auto path = test_mapped_ndarray::temp_path("nstd_test_mapped_dynamic.bin");
+	{
+		auto arr = nstd::dynamic_mapped_ndarray<double, 3>::create(path.c_str(), { 3, 4, 5 }, nstd::layout::column_major);
+		CHECK_EQ(arr.size(), 60);
+		CHECK_EQ(arr.stride(0), 1);
+		CHECK_EQ(arr.stride(2), 12);
+		arr[2][1][3] = 42.0;
+		CHECK_EQ(arr.data()[2 + 1 * 3 + 3 * 12], 42.0);
+	}
+
+	nstd::dynamic_mapped_ndarray<double, 3> arr(path.c_str(), nstd::map_mode::read_write);
+	CHECK_EQ(arr.order(), nstd::layout::column_major);
+	CHECK_EQ(arr.extent(0), 3);
+	CHECK_EQ(arr.extent(1), 4);
+	CHECK_EQ(arr.extent(2), 5);
+	CHECK_EQ(arr[2][1][3], 42.0);
+
+	// static shape arrays only accept row-major files
+	CHECK_THROWS(nstd::mapped_ndarray<double, 3, 4, 5>(path.c_str()));
+
+	nstd::dynamic_mapped_ndarray<double, 3> moved = static_cast<nstd::dynamic_mapped_ndarray<double, 3> &&>(arr);
+	CHECK_FALSE(arr.is_open());
+	CHECK_EQ(moved[2][1][3], 42.0);
+	std::filesystem::remove(path);
+}
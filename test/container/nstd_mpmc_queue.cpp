@@ -0,0 +1,110 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_mpmc_queue.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("capacity") {
+	CHECK_EQ(nstd::mpmc_queue<int>(5).capacity(), 8);
+	CHECK_EQ(nstd::mpmc_queue<int>(16).capacity(), 16);
+	CHECK_EQ(nstd::mpmc_queue<int>(1).capacity(), 2);
+	CHECK_THROWS(nstd::mpmc_queue<int>(0));
+}
+
+TEST_CASE("push / pop") {
+	nstd::mpmc_queue<int> queue(4);
+	for (int i = 0; i < 4; i++) {
+		CHECK(queue.try_push(i));
+	}
+	CHECK_FALSE(queue.try_push(4));
+	CHECK_EQ(queue.size_approx(), 4);
+
+	int val = -1;
+	for (int lap = 0; lap < 3; lap++) {  // reuses the cells over several laps
+		for (int i = 0; i < 4; i++) {
+			REQUIRE(queue.try_pop(val));
+			CHECK_EQ(val, lap * 4 + i);
+			CHECK(queue.try_push(lap * 4 + i + 4));
+		}
+	}
+	CHECK_EQ(queue.size_approx(), 4);
+}
+
+TEST_CASE("batches") {
+	nstd::mpmc_queue<int> queue(8);
+	int src[6] = { 0, 1, 2, 3, 4, 5 };
+	int dst[8] = {};
+
+	CHECK_EQ(queue.push_n(src, 6), 6);
+	CHECK_EQ(queue.push_n(src, 6), 2);  // only two cells left
+	CHECK_EQ(queue.pop_n(dst, 3), 3);
+	CHECK_EQ(dst[2], 2);
+	CHECK_EQ(queue.pop_n(dst, 8), 5);
+	CHECK_EQ(dst[3], 0);
+	CHECK_EQ(dst[4], 1);
+	CHECK_EQ(queue.pop_n(dst, 8), 0);
+}
+
+TEST_CASE("non-trivial elements") {
+	nstd::mpmc_queue<std::string> queue(4);
+	CHECK(queue.try_emplace(40, 'a'));
+	CHECK(queue.try_push("b"));
+
+	std::string out;
+	REQUIRE(queue.try_pop(out));
+	CHECK_EQ(out, std::string(40, 'a'));
+	// the remaining element is destroyed with the queue
+}
+
+TEST_CASE("producers / consumers threads") {
+	constexpr int producers = 4;
+	constexpr int consumers = 4;
+	constexpr long long per_producer = 50000;
+
+	nstd::mpmc_queue<long long> queue(128);
+	std::atomic<long long> sum{ 0 };
+	std::atomic<long long> popped{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; p++) {
+		threads.emplace_back([&, p] {
+			long long batch[8];
+			long long next = 0;
+			while (next < per_producer) {
+				size_t n = 0;
+				for (; n < 8 && next + static_cast<long long>(n) < per_producer; n++) {
+					batch[n] = p * per_producer + next + static_cast<long long>(n) + 1;
+				}
+				next += static_cast<long long>(p % 2 == 0 ? queue.push_n(batch, n) : queue.try_push(batch[0]) ? 1 : 0);
+			}
+		});
+	}
+	for (int c = 0; c < consumers; c++) {
+		threads.emplace_back([&, c] {
+			long long buf[8];
+			while (popped.load(std::memory_order_relaxed) < producers * per_producer) {
+				const size_t n = c % 2 == 0 ? queue.pop_n(buf, 8) : queue.try_pop(buf[0]) ? 1 : 0;
+				long long local = 0;
+				for (size_t i = 0; i < n; i++) {
+					local += buf[i];
+				}
+				sum.fetch_add(local, std::memory_order_relaxed);
+				popped.fetch_add(static_cast<long long>(n), std::memory_order_relaxed);
+			}
+		});
+	}
+	for (auto &t : threads) {
+		t.join();
+	}
+
+	constexpr long long total = producers * per_producer;
+	CHECK_EQ(popped.load(), total);
+	CHECK_EQ(sum.load(), total * (total + 1) / 2);
+	CHECK(queue.empty_approx());
+}
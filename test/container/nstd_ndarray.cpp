@@ -3,8 +3,20 @@
 
 #include <container/nstd_ndarray.h>
 
-// TODO: REMOVE this dep in future versions
+// TODO: REMOVE these deps in future versions
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <random>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(NSTD_ENABLE_HARDENED) && !defined(_WIN32)
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
 
 TEST_CASE("zero init") {
 	nstd::ndarray<int, 5, 6, 7> arr;
@@ -48,9 +60,182 @@ TEST_CASE("rw") {
 	}
 }
 
+#ifndef NSTD_ENABLE_HARDENED
 TEST_CASE("out of bounds") {
 	nstd::ndarray_strict<int, 5, 6, 7> arr;
 	CHECK_THROWS(arr[5][0][0]);
 	CHECK_THROWS(arr[0][6][0]);
 	CHECK_THROWS(arr[0][0][7]);
 }
+#elif !defined(_WIN32)
+namespace test_ndarray {
+
+// runs fn in a child process, true when the child died on a signal instead of returning
+template<typename Fn>
+bool traps(Fn &&fn) {
+	const pid_t pid = fork();
+	if (pid == 0) {
+		fn();
+		_exit(0);
+	}
+	int status = 0;
+	waitpid(pid, &status, 0);
+	return WIFSIGNALED(status);
+}
+
+}  // namespace test_ndarray
+
+TEST_CASE("hardened out of bounds traps") {
+	using test_ndarray::traps;
+	nstd::ndarray_strict<int, 5, 6, 7> arr;
+	nstd::ndarray<int, 5, 6, 7> loose;
+	CHECK_FALSE(traps([&] { arr[4][5][6] = 1; }));
+	CHECK(traps([&] { arr[5][0][0] = 1; }));
+	CHECK(traps([&] { arr[0][0][7] = 1; }));
+	CHECK(traps([&] { nstd::make_view(arr)[0][6][0] = 1; }));
+	CHECK(traps([&] { nstd::for_each_index(arr, { 0, 0, 0 }, { 5, 6, 8 }, [](int &, size_t, size_t, size_t) {}); }));
+	CHECK(traps([&] { nstd::make_view(loose).extent(3); }));  // NSTD_BOUNDS_ASSERT, kept under NDEBUG
+}
+#endif
+
+TEST_CASE("shape / data") {
+	nstd::ndarray<int, 5, 6, 7> arr;
+	static_assert(decltype(arr)::rank == 3);
+	static_assert(decltype(arr)::shape[1] == 6);
+	arr[1][2][3] = 42;
+	CHECK_EQ(arr.data()[1 * 42 + 2 * 7 + 3], 42);  // row-major
+}
+
+TEST_CASE("strided_view") {
+	nstd::ndarray<int, 4, 6> arr;
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 6; j++) {
+			arr[i][j] = i * 10 + j;
+		}
+	}
+	nstd::strided_view<int, 2> view = arr;
+	CHECK(view.is_contiguous());
+	CHECK_EQ(view.size(), 24);
+	view[2][3] = -1;
+	CHECK_EQ(arr[2][3], -1);
+
+	// rows 1 and 3, every other column from 1
+	const auto sub = view.slice(0, 1, 4, 2).slice(1, 1, 6, 2);
+	CHECK_EQ(sub.extent(0), 2);
+	CHECK_EQ(sub.extent(1), 3);
+	CHECK_EQ(sub.stride(0), 12);
+	CHECK_EQ(sub.stride(1), 2);
+	CHECK_FALSE(sub.is_contiguous());
+	CHECK_EQ(sub[0][0], 11);
+	CHECK_EQ(sub[1][2], 35);
+
+	const nstd::strided_view<const int, 2> readonly = sub;
+	CHECK_EQ(readonly[1][1], 33);
+	CHECK(nstd::make_view(static_cast<const decltype(arr) &>(arr)).slice(0, 3, 4).is_contiguous());
+
+	const nstd::strided_view_strict<int, 2> strict(arr.data(), { 4, 6 });
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS(strict[4][0]);
+	CHECK_THROWS(view.slice(1, 2, 7));
+#endif
+	CHECK_EQ(strict[3][5], 35);
+}
+
+TEST_CASE("checked regions") {
+	nstd::ndarray_strict<int, 4, 5, 6> arr;
+	nstd::for_each_index(arr, [](int &v, size_t i, size_t j, size_t k) { v = static_cast<int>(i * 100 + j * 10 + k); });
+	CHECK_EQ(arr[3][4][5], 345);
+	CHECK_EQ(arr.unchecked()[2][1][3], 213);
+
+	// the box is validated once, up front: nothing is visited when it is out of range
+	int visited = 0;
+	nstd::for_each_index(arr, { 1, 2, 0 }, { 3, 5, 6 }, [&](int &v, size_t i, size_t j, size_t k) {
+		CHECK_EQ(v, static_cast<int>(i * 100 + j * 10 + k));
+		v = -v;
+		visited++;
+	});
+	CHECK_EQ(visited, 2 * 3 * 6);
+	CHECK_EQ(arr[2][4][5], -245);
+	CHECK_EQ(arr[0][2][0], 20);
+#ifndef NSTD_ENABLE_HARDENED
+	visited = 0;
+	CHECK_THROWS(nstd::for_each_index(arr, { 0, 0, 0 }, { 4, 5, 7 }, [&](int &, size_t, size_t, size_t) { visited++; }));
+	CHECK_THROWS(nstd::for_each_index(arr, { 2, 0, 0 }, { 1, 5, 6 }, [&](int &, size_t, size_t, size_t) { visited++; }));
+	CHECK_EQ(visited, 0);
+#endif
+
+	// strided views, inner stride != 1
+	const nstd::strided_view_strict<const int, 3> view = arr;
+	const auto sub = view.slice(2, 0, 6, 3);
+	visited = 0;
+	nstd::for_each_index(sub, [&](const int &v, size_t i, size_t j, size_t k) {
+		CHECK_EQ(&v, &view[i][j][3 * k]);
+		visited++;
+	});
+	CHECK_EQ(visited, 4 * 5 * 2);
+
+	const auto box = view.subview({ 1, 1, 1 }, { 3, 3, 3 });
+	static_assert(std::is_same_v<decltype(box), const nstd::strided_view<const int, 3>>);
+	CHECK_EQ(box[0][0][0], 111);
+	CHECK_EQ(box[1][1][1], -222);
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS(view.subview({ 0, 0, 0 }, { 5, 1, 1 }));
+#endif
+	CHECK_EQ(view.unchecked()[3][4][5], 345);
+}
+
+TEST_CASE("iterators and ranges") {
+	nstd::ndarray<int, 3, 4, 5> arr;
+	static_assert(std::ranges::contiguous_range<decltype(arr)>);
+	static_assert(std::ranges::sized_range<const decltype(arr)>);
+	std::iota(arr.begin(), arr.end(), 0);
+	CHECK_EQ(arr[2][3][4], 59);
+	CHECK_EQ(std::ranges::distance(arr), 60);
+	std::ranges::sort(arr, std::greater<>());
+	CHECK_EQ(arr[0][0][0], 59);
+	CHECK_EQ(*std::ranges::min_element(arr), 0);
+	long sum = 0;
+	for (int v : std::as_const(arr) | std::views::filter([](int v) { return v % 2 == 0; })) {
+		sum += v;
+	}
+	CHECK_EQ(sum, 870);
+
+	// coordinates in row-major order, offsets without multiplications
+	static_assert(std::ranges::forward_range<nstd::index_range<3>>);
+	static_assert(std::ranges::view<nstd::index_range<3>>);
+	const auto grid = nstd::indices(arr);
+	CHECK_EQ(grid.size(), 60);
+	size_t expected = 0;
+	for (auto it = grid.begin(); it != grid.end(); ++it, expected++) {
+		const auto [i, j, k] = *it;
+		CHECK_EQ(it->offset(), expected);
+		CHECK_EQ(i * 20 + j * 5 + k, expected);
+		CHECK_EQ(arr.data()[it->offset()], arr[i][j][k]);
+	}
+	CHECK_EQ(expected, 60);
+	CHECK_EQ(std::ranges::distance(nstd::indices({ 7, 0, 3 })), 0);
+
+	// values, not references into the iterator: they survive increments and copies
+	static_assert(std::is_same_v<std::iter_reference_t<nstd::index_iterator<3>>, nstd::nd_index<3>>);
+	auto it = grid.begin();
+	const auto copy = it;
+	const nstd::nd_index<3> first = *it;
+	++it;
+	++it;
+	CHECK_EQ(first.offset(), 0);
+	CHECK_EQ((*copy).offset(), 0);
+	CHECK_EQ((*it)[2], 2);
+	CHECK(std::ranges::equal(grid | std::views::take(3) | std::views::transform([](nstd::nd_index<3> index) { return index.offset(); }),
+	                         std::vector<size_t>{ 0, 1, 2 }));
+
+	// strided views: offsets follow the view's strides
+	const auto sub = nstd::make_view(arr).slice(1, 1, 4, 2).slice(2, 4, 5);
+	size_t visited = 0;
+	for (const auto &index : nstd::indices(sub)) {
+		CHECK_EQ(&sub.data()[index.offset()], &sub[index[0]][index[1]][index[2]]);
+		visited++;
+	}
+	CHECK_EQ(visited, 3 * 2 * 1);
+	auto firsts = nstd::indices(sub) | std::views::transform([](const nstd::nd_index<3> &index) { return index[1]; });
+	CHECK(std::ranges::equal(firsts, std::vector<size_t>{ 0, 1, 0, 1, 0, 1 }));
+}
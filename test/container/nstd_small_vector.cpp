@@ -0,0 +1,165 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_small_vector.h>
+#include <memory/nstd_arena.h>
+
+// TODO: REMOVE these deps in future versions
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace test_small_vector {
+
+constexpr int constexpr_spill() {
+	nstd::small_vector<int, 2> vec;
+	for (int i = 0; i < 10; i++) {
+		vec.push_back(i);
+	}
+	vec.erase(vec.begin());
+	vec.insert(vec.begin() + 3, 100);
+	int sum = 0;
+	for (int x : vec) {
+		sum += x;
+	}
+	return sum + (vec.is_small() ? 1000 : 0);  // 1 + ... + 9 + 100
+}
+
+// counts live objects, the move constructor throws once moves_left runs out
+struct throwing_move {
+	static inline int live = 0;
+	static inline int moves_left = -1;
+	int v;
+
+	throwing_move(int v) : v(v) {
+		live++;
+	}
+
+	throwing_move(const throwing_move &rhs) : v(rhs.v) {
+		live++;
+	}
+
+	throwing_move(throwing_move &&rhs) : v(rhs.v) {
+		if (moves_left == 0) {
+			throw std::runtime_error("move failed!");
+		}
+		if (moves_left > 0) {
+			moves_left--;
+		}
+		live++;
+	}
+
+	~throwing_move() {
+		live--;
+	}
+};
+
+}  // namespace test_small_vector
+
+TEST_CASE("constexpr") {
+	static_assert(test_small_vector::constexpr_spill() == 145);
+}
+
+TEST_CASE("inline then spill") {
+	nstd::small_vector<int, 4> vec;
+	for (int i = 0; i < 4; i++) {
+		vec.push_back(i);
+	}
+	CHECK(vec.is_small());
+	CHECK_EQ(vec.capacity(), 4);
+
+	vec.push_back(4);
+	CHECK_FALSE(vec.is_small());
+	CHECK_GE(vec.capacity(), 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(vec[i], i);
+	}
+
+	vec.resize(3);
+	vec.shrink_to_fit();
+	CHECK(vec.is_small());
+	CHECK_EQ(vec[2], 2);
+}
+
+TEST_CASE("push_back of own element while growing") {
+	nstd::small_vector<std::string, 2> vec{ std::string(30, 'a'), "b" };
+	vec.push_back(vec[0]);
+	CHECK_EQ(vec[2], std::string(30, 'a'));
+}
+
+TEST_CASE("throwing relocation while growing") {
+	using test_small_vector::throwing_move;
+	{
+		nstd::small_vector<throwing_move, 2> vec;
+		vec.emplace_back(1);
+		vec.emplace_back(2);
+		throwing_move::moves_left = 1;
+		CHECK_THROWS_AS(vec.emplace_back(3), std::runtime_error);
+		CHECK_THROWS_AS(vec.reserve(8), std::runtime_error);
+		throwing_move::moves_left = -1;
+		CHECK_EQ(throwing_move::live, 2);
+		CHECK_EQ(vec.size(), 2);
+		CHECK(vec.is_small());
+		vec.emplace_back(3);
+		CHECK_EQ(vec[2].v, 3);
+	}
+	CHECK_EQ(throwing_move::live, 0);
+}
+
+TEST_CASE("copy / move") {
+	for (int n : { 3, 20 }) {  // inline and spilled
+		nstd::small_vector<std::string, 4> vec;
+		for (int i = 0; i < n; i++) {
+			vec.push_back(std::to_string(i));
+		}
+
+		auto copy = vec;
+		CHECK(copy == vec);
+
+		auto moved = static_cast<nstd::small_vector<std::string, 4> &&>(copy);
+		CHECK(moved == vec);
+		CHECK(copy.empty());
+		CHECK(copy.is_small());
+
+		nstd::small_vector<std::string, 4> assigned{ "x" };
+		assigned = static_cast<nstd::small_vector<std::string, 4> &&>(moved);
+		CHECK(assigned == vec);
+
+		assigned = vec;
+		CHECK(assigned == vec);
+	}
+}
+
+TEST_CASE("move-only elements") {
+	nstd::small_vector<std::unique_ptr<int>, 2> vec;
+	for (int i = 0; i < 5; i++) {
+		vec.push_back(std::make_unique<int>(i));
+	}
+	vec.erase(vec.begin() + 1);
+	CHECK_EQ(*vec[1], 2);
+	CHECK_EQ(*vec.back(), 4);
+}
+
+TEST_CASE("arena allocator") {
+	using arena_vector = nstd::small_vector<int, 4, nstd::arena_allocator<int>>;
+	// moving between arenas allocates
+	static_assert(!std::is_nothrow_move_assignable_v<arena_vector>);
+	static_assert(std::is_nothrow_move_assignable_v<nstd::small_vector<int, 4>>);
+	static_assert(std::is_nothrow_move_constructible_v<arena_vector>);
+
+	nstd::arena a;
+	arena_vector vec{ nstd::arena_allocator<int>(a) };
+	for (int i = 0; i < 4; i++) {
+		vec.push_back(i);
+	}
+	CHECK_EQ(a.used(), 0);
+	vec.push_back(4);
+	CHECK_GT(a.used(), 0);
+	CHECK_EQ(vec[4], 4);
+}
+
+TEST_CASE("out of bounds") {
+	nstd::small_vector<int, 4> vec{ 1 };
+	CHECK_THROWS(vec.at(1));
+}
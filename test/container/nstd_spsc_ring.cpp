@@ -0,0 +1,94 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_spsc_ring.h>
+
+// TODO: REMOVE these deps in future versions
+#include <memory>
+#include <string>
+#include <thread>
+
+TEST_CASE("push / pop") {
+	nstd::spsc_ring<int, 4> ring;
+	CHECK(ring.empty_approx());
+	CHECK_EQ(nstd::spsc_ring<int, 4>::capacity(), 4);
+	for (int i = 0; i < 4; i++) {
+		CHECK(ring.try_push(i));
+	}
+	CHECK_FALSE(ring.try_push(4));
+	CHECK_EQ(ring.size_approx(), 4);
+
+	int val = -1;
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(ring.try_pop(val));
+		CHECK_EQ(val, i);
+	}
+	CHECK_FALSE(ring.try_pop(val));
+}
+
+TEST_CASE("batches wrap around") {
+	nstd::spsc_ring<int, 8> ring;
+	int src[6] = { 0, 1, 2, 3, 4, 5 };
+	int dst[8] = {};
+
+	CHECK_EQ(ring.push_n(src, 6), 6);
+	CHECK_EQ(ring.pop_n(dst, 4), 4);
+	CHECK_EQ(ring.push_n(src, 6), 6);  // wraps
+	CHECK_EQ(ring.push_n(src, 6), 0);  // full
+	CHECK_EQ(ring.pop_n(dst, 8), 8);
+	const int expected[8] = { 4, 5, 0, 1, 2, 3, 4, 5 };
+	for (int i = 0; i < 8; i++) {
+		CHECK_EQ(dst[i], expected[i]);
+	}
+	CHECK_EQ(ring.pop_n(dst, 8), 0);
+}
+
+TEST_CASE("non-trivial elements") {
+	auto ring = std::make_unique<nstd::spsc_ring<std::string, 4>>();
+	CHECK(ring->try_emplace(40, 'a'));
+	CHECK(ring->try_push("b"));
+	CHECK(ring->try_push("c"));
+
+	std::string out;
+	REQUIRE(ring->try_pop(out));
+	CHECK_EQ(out, std::string(40, 'a'));
+	// remaining elements are destroyed with the ring
+}
+
+TEST_CASE("producer / consumer threads") {
+	constexpr long long count = 200000;
+	auto ring = std::make_unique<nstd::spsc_ring<long long, 256>>();
+
+	std::thread producer([&] {
+		long long batch[16];
+		long long next = 0;
+		while (next < count) {
+			if (next % 3 == 0) {
+				if (ring->try_push(next)) {
+					next++;
+				}
+				continue;
+			}
+			size_t n = 0;
+			for (; n < 16 && next + static_cast<long long>(n) < count; n++) {
+				batch[n] = next + static_cast<long long>(n);
+			}
+			next += static_cast<long long>(ring->push_n(batch, n));
+		}
+	});
+
+	long long expected = 0;
+	bool ordered = true;
+	long long buf[32];
+	while (expected < count) {
+		const size_t n = ring->pop_n(buf, 32);
+		for (size_t i = 0; i < n; i++) {
+			ordered = ordered && buf[i] == expected;
+			expected++;
+		}
+	}
+	producer.join();
+
+	CHECK(ordered);
+	CHECK(ring->empty_approx());
+}
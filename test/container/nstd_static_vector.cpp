@@ -0,0 +1,101 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_static_vector.h>
+
+// TODO: REMOVE these deps in future versions
+#include <memory>
+#include <string>
+
+namespace test_static_vector {
+
+constexpr int constexpr_sum() {
+	nstd::static_vector<int, 8> vec{ 1, 2, 3 };
+	vec.push_back(4);
+	vec.insert(vec.begin(), 0);
+	vec.erase(vec.begin() + 2);
+	int sum = 0;
+	for (int x : vec) {
+		sum += x;
+	}
+	return sum;  // 0 + 1 + 3 + 4
+}
+
+constexpr nstd::static_vector<int, 4> make_constant() {
+	nstd::static_vector<int, 4> vec;
+	vec.push_back(7);
+	vec.push_back(8);
+	return vec;
+}
+
+}  // namespace test_static_vector
+
+TEST_CASE("constexpr") {
+	static_assert(test_static_vector::constexpr_sum() == 8);
+
+	constexpr auto vec = test_static_vector::make_constant();
+	static_assert(vec.size() == 2);
+	static_assert(vec[0] == 7 && vec[1] == 8);
+	CHECK_EQ(vec.back(), 8);
+}
+
+TEST_CASE("push / pop") {
+	nstd::static_vector<int, 4> vec;
+	CHECK(vec.empty());
+	for (int i = 0; i < 4; i++) {
+		vec.push_back(i);
+	}
+	CHECK(vec.full());
+	CHECK_FALSE(vec.try_emplace_back(4));
+	vec.pop_back();
+	CHECK_EQ(vec.size(), 3);
+	CHECK_EQ(vec.back(), 2);
+	CHECK_EQ(nstd::static_vector<int, 4>::capacity(), 4);
+}
+
+TEST_CASE("non-trivial elements") {
+	nstd::static_vector<std::string, 4> vec;
+	vec.emplace_back(40, 'a');
+	vec.emplace_back("b");
+	vec.insert(vec.begin(), "c");
+	CHECK_EQ(vec[0], "c");
+	CHECK_EQ(vec[1], std::string(40, 'a'));
+	CHECK_EQ(vec[2], "b");
+
+	auto copy = vec;
+	CHECK(copy == vec);
+
+	auto moved = static_cast<nstd::static_vector<std::string, 4> &&>(copy);
+	CHECK(moved == vec);
+	CHECK(copy.empty());
+
+	vec.erase(vec.begin() + 1);
+	CHECK_EQ(vec.size(), 2);
+	CHECK_EQ(vec[1], "b");
+}
+
+TEST_CASE("move-only elements") {
+	nstd::static_vector<std::unique_ptr<int>, 4> vec;
+	vec.push_back(std::make_unique<int>(1));
+	vec.push_back(std::make_unique<int>(2));
+	vec.insert(vec.begin(), std::make_unique<int>(0));
+	auto moved = static_cast<nstd::static_vector<std::unique_ptr<int>, 4> &&>(vec);
+	CHECK_EQ(*moved[0], 0);
+	CHECK_EQ(*moved[2], 2);
+}
+
+TEST_CASE("resize") {
+	nstd::static_vector<int, 8> vec(3, 5);
+	vec.resize(6);
+	CHECK_EQ(vec[2], 5);
+	CHECK_EQ(vec[5], 0);
+	vec.resize(1);
+	CHECK_EQ(vec.size(), 1);
+	vec.resize(3, 9);
+	CHECK_EQ(vec[2], 9);
+}
+
+TEST_CASE("out of bounds") {
+	nstd::static_vector<int, 4> vec{ 1 };
+	CHECK_THROWS(vec.at(1));
+}
@@ -0,0 +1,101 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <io/nstd_file.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace test_file {
+
+std::string temp_path(const char *name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace test_file
+
+TEST_CASE("positional read / write") {
+	const auto path = test_file::temp_path("nstd_test_file_rw.bin");
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::create);
+		CHECK(f.is_open());
+		CHECK_EQ(f.size(), 0);
+		f.write_at("world", 5, 6);
+		f.write_at("hello ", 6, 0);
+		CHECK_EQ(f.size(), 11);
+	}
+
+	nstd::file f(path.c_str(), nstd::open_mode::read);
+	char buf[12]{};
+	f.read_at(buf, 11, 0);
+	CHECK_EQ(std::string(buf), "hello world");
+	CHECK_THROWS(f.read_at(buf, 4, 8));  // past the end
+
+	nstd::file moved = static_cast<nstd::file &&>(f);
+	CHECK_FALSE(f.is_open());
+	CHECK(moved.is_open());
+	moved.close();
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("missing file") {
+	CHECK_THROWS(nstd::file(test_file::temp_path("nstd_test_file_missing.bin").c_str(), nstd::open_mode::read));
+}
+
+TEST_CASE("gather / scatter") {
+	const auto path = test_file::temp_path("nstd_test_file_gather.bin");
+	nstd::file f(path.c_str(), nstd::open_mode::create);
+
+	int a[3] = { 1, 2, 3 };
+	double b[2] = { 4.5, 5.5 };
+	char empty = 0;
+	nstd::io_slice out[3] = { { a, sizeof(a) }, { &empty, 0 }, { b, sizeof(b) } };
+	f.write_gather(out, 3, 8);
+	CHECK_EQ(f.size(), 8 + sizeof(a) + sizeof(b));
+
+	int ra[3]{};
+	double rb[2]{};
+	nstd::io_slice in[2] = { { ra, sizeof(ra) }, { rb, sizeof(rb) } };
+	f.read_scatter(in, 2, 8);
+	CHECK_EQ(ra[2], 3);
+	CHECK_EQ(rb[1], 5.5);
+
+	f.close();
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("mapped_region") {
+	const auto path = test_file::temp_path("nstd_test_file_map.bin");
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::create);
+		f.resize(3 * nstd::mapped_region::page_size());
+
+		nstd::mapped_region region(f, nstd::map_mode::read_write);
+		CHECK_EQ(region.size(), 3 * nstd::mapped_region::page_size());
+		region.advise(nstd::access_hint::sequential);
+		std::memcpy(region.data() + 100, "mapped", 6);
+		region.flush();
+	}
+
+	nstd::file f(path.c_str(), nstd::open_mode::read);
+	{
+		nstd::mapped_region cow(f, nstd::map_mode::copy_on_write);
+		CHECK_EQ(std::memcmp(cow.data() + 100, "mapped", 6), 0);
+		cow.data()[100] = 'M';  // private to this mapping
+		cow.advise(nstd::access_hint::dont_need, 0, cow.size());
+		CHECK_EQ(cow.data()[100], 'M');
+	}
+	nstd::mapped_region ro(f, nstd::map_mode::read_only);
+	ro.advise(nstd::access_hint::random, 50, 10);
+	CHECK_EQ(ro.data()[100], 'm');
+
+	nstd::mapped_region moved = static_cast<nstd::mapped_region &&>(ro);
+	CHECK(ro.data() == nullptr);
+	CHECK_EQ(moved.data()[101], 'a');
+
+	moved.unmap();
+	f.close();
+	std::filesystem::remove(path);
+}
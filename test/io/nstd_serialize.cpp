@@ -0,0 +1,157 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <io/nstd_serialize.h>
+#include <math/linalg/nstd_vector.h>
+
+// TODO: REMOVE these deps in future versions
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace test_serialize {
+
+std::string temp_path(const char *name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace test_serialize
+
+TEST_CASE("npy header") {
+	const nstd::size_t shape[] = { 5, 6, 7 };
+	const std::string header = nstd::internal::npy_header(nstd::dtype::f32, false, shape, 3);
+	CHECK_EQ(header.size() % 64, 0);
+	CHECK_EQ(header.back(), '\n');
+	CHECK_NE(header.find("{'descr': '<f4', 'fortran_order': False, 'shape': (5, 6, 7), }"), std::string::npos);
+
+	const nstd::size_t vec_shape[] = { 9 };
+	CHECK_NE(nstd::internal::npy_header(nstd::dtype::u8, false, vec_shape, 1).find("'descr': '|u1'"), std::string::npos);
+	CHECK_NE(nstd::internal::npy_header(nstd::dtype::i64, true, vec_shape, 1).find("'shape': (9,)"), std::string::npos);
+}
+
+TEST_CASE("npy round trip") {
+	const auto path = test_serialize::temp_path("nstd_test_serialize.npy");
+	nstd::ndarray<float, 3, 4> arr;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 4; j++) {
+			arr[i][j] = static_cast<float>(i) + static_cast<float>(j) * 0.25f;
+		}
+	}
+	nstd::save_npy(path.c_str(), arr);
+
+	nstd::ndarray<float, 3, 4> loaded;
+	nstd::load_npy(path.c_str(), loaded);
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 4; j++) {
+			CHECK_EQ(loaded[i][j], arr[i][j]);
+		}
+	}
+
+	nstd::ndarray<float, 4, 3> transposed;
+	nstd::ndarray<double, 3, 4> widened;
+	CHECK_THROWS(nstd::load_npy(path.c_str(), transposed));
+	CHECK_THROWS(nstd::load_npy(path.c_str(), widened));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("npy written by numpy") {
+	// np.save(f, np.arange(6, dtype='<i2').reshape(2, 3)), version 1.0 with a 118-byte dict
+	const auto path = test_serialize::temp_path("nstd_test_serialize_numpy.npy");
+	std::string dict = "{'descr': '<i2', 'fortran_order': False, 'shape': (2, 3), }";
+	dict.append(128 - 10 - dict.size() - 1, ' ');
+	dict += '\n';
+	std::string record = "\x93NUMPY";
+	record += '\x01';
+	record += '\x00';
+	record += static_cast<char>(dict.size());
+	record += '\x00';
+	record += dict;
+	for (short i = 0; i < 6; i++) {
+		record.append(reinterpret_cast<const char *>(&i), sizeof(i));
+	}
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::create);
+		f.write_at(record.data(), record.size(), 0);
+	}
+
+	nstd::ndarray<short, 2, 3> arr;
+	nstd::load_npy(path.c_str(), arr);
+	CHECK_EQ(arr[0][2], 2);
+	CHECK_EQ(arr[1][0], 3);
+	CHECK_EQ(arr[1][2], 5);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("streams of records") {
+	const auto path = test_serialize::temp_path("nstd_test_serialize_stream.bin");
+	nstd::ndarray<int, 8> first;
+	nstd::ndarray<double, 2, 2, 2> second;
+	first.fill(3);
+	second.fill(0.5);
+	nstd::linalg::matrix4f mat(1.0f);
+	nstd::linalg::vector3d vec(1.0, 2.0, 3.0);
+
+	nstd::size_t end = 0;
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::create);
+		nstd::binary_writer writer(f);
+		writer.write_npy(first);
+		writer.write(vec);  // padded up to a 64-byte boundary first
+		writer.write_npy(second);
+		writer.write(mat);
+		end = writer.offset();
+	}
+
+	const nstd::file f(path.c_str(), nstd::open_mode::read);
+	nstd::binary_reader reader(f);
+	nstd::ndarray<int, 8> first_in;
+	nstd::ndarray<double, 2, 2, 2> second_in;
+	nstd::linalg::matrix4f mat_in;
+	nstd::linalg::vector3d vec_in;
+
+	reader.read_npy(first_in);
+	reader.read(vec_in);
+	reader.read_npy(second_in);
+	reader.read(mat_in);
+	CHECK_EQ(reader.offset(), end);
+	CHECK_EQ(first_in[7], 3);
+	CHECK_EQ(second_in[1][1][1], 0.5);
+	CHECK(vec_in == vec);
+	CHECK(mat_in == mat);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("arrays of matrices") {
+	const auto path = test_serialize::temp_path("nstd_test_serialize_mats.bin");
+	std::vector<nstd::linalg::matrix3d> mats;
+	for (int i = 0; i < 100; i++) {
+		mats.emplace_back(static_cast<double>(i));
+	}
+	// the gather write also handles matrices scattered over memory
+	nstd::linalg::matrix3d lone(-1.0);
+	const nstd::linalg::matrix3d *pieces[2] = { &lone, &mats[0] };
+	{
+		nstd::file f(path.c_str(), nstd::open_mode::create);
+		nstd::binary_writer writer(f);
+		writer.write(mats.data(), mats.size());
+		writer.write(*pieces[0]);
+		writer.write(*pieces[1]);
+		CHECK_EQ(writer.offset() % 8, 0);
+	}
+
+	const nstd::file f(path.c_str(), nstd::open_mode::read);
+	nstd::binary_reader reader(f);
+	std::vector<nstd::linalg::matrix3d> loaded(100);
+	reader.read(loaded.data(), loaded.size());
+	for (int i = 0; i < 100; i++) {
+		CHECK(loaded[i] == mats[i]);
+	}
+
+	nstd::linalg::matrix3d one;
+	reader.read(one);
+	CHECK(one == lone);
+
+	nstd::linalg::matrix3f wrong;
+	CHECK_THROWS(reader.read(wrong));
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,137 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_dmatrix.h>
+#include <math/linalg/nstd_matrix.h>
+#include <math/linalg/nstd_vector.h>
+#include <math/nstd_math.h>
+
+#include <Eigen/Dense>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+namespace test_dmatrix {
+
+nstd::linalg::dmatrixf random_dmatrix(size_t rows, size_t cols, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	nstd::linalg::dmatrixf res(rows, cols);
+	for (size_t i = 0; i < res.size(); i++) {
+		res.data()[i] = dist(engine);
+	}
+	return res;
+}
+
+Eigen::MatrixXf to_eigen(const nstd::linalg::dmatrixf &mat) {
+	return Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(mat.data(), mat.rows(), mat.cols());
+}
+
+}  // namespace test_dmatrix
+
+TEST_CASE("init / access") {
+	nstd::linalg::dmatrixf mat(2, 3, { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f });
+	CHECK_EQ(mat.rows(), 2);
+	CHECK_EQ(mat.cols(), 3);
+	CHECK_EQ(mat[1][0], 4.0f);
+	CHECK_EQ(mat.at(0, 2), 3.0f);
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS_AS(mat.at(2, 0), std::runtime_error);
+#endif
+	CHECK_THROWS_AS(nstd::linalg::dmatrixf(2, 2, { 1.0f }), std::runtime_error);
+	CHECK_EQ(reinterpret_cast<std::uintptr_t>(mat.data()) % nstd::cache_line_size, 0);
+
+	CHECK(nstd::linalg::dmatrixf::identity(3) == nstd::linalg::dmatrixf(3, 3, { 1, 0, 0, 0, 1, 0, 0, 0, 1 }));
+	CHECK(nstd::linalg::dmatrixi::ones(2, 2) == nstd::linalg::dmatrixi(2, 2, 1));
+	CHECK_FALSE(nstd::linalg::dmatrixi::zeros(2, 2) == nstd::linalg::dmatrixi::zeros(2, 3));
+
+	nstd::linalg::dvectorf vec{ 3.0f, 4.0f };
+	CHECK_EQ(vec.size(), 2);
+	CHECK_EQ(vec.norm(), 5.0f);
+#ifndef NSTD_ENABLE_HARDENED
+	CHECK_THROWS_AS(vec.at(2), std::runtime_error);
+#endif
+}
+
+TEST_CASE("element-wise operators") {
+	const nstd::linalg::dmatrixi a(2, 2, { 1, 2, 3, 4 }), b(2, 2, { 5, 6, 7, 8 });
+	CHECK(a + b == nstd::linalg::dmatrixi(2, 2, { 6, 8, 10, 12 }));
+	CHECK(b - a == nstd::linalg::dmatrixi(2, 2, 4));
+	CHECK(a * 2 == nstd::linalg::dmatrixi(2, 2, { 2, 4, 6, 8 }));
+	CHECK(2 * a == a * 2);
+
+	nstd::linalg::dmatrixi c = a;
+	c += b;
+	c -= a;
+	c *= 3;
+	CHECK(c == b * 3);
+	CHECK_THROWS_AS(a + nstd::linalg::dmatrixi(2, 3, 0), std::runtime_error);
+
+	nstd::linalg::dvectorf u{ 1.0f, 2.0f, 2.0f }, v{ 1.0f, 0.0f, 1.0f };
+	CHECK(u + v == nstd::linalg::dvectorf{ 2.0f, 2.0f, 3.0f });
+	CHECK(u - v == nstd::linalg::dvectorf{ 0.0f, 2.0f, 1.0f });
+	CHECK_EQ(u.dot(v), 3.0f);
+	CHECK_EQ(u.norm_squared(), 9.0f);
+	CHECK(nstd::is_approx(u.normalized().norm(), 1.0f, 1e-6f));
+	u -= v;
+	u *= 2.0f;
+	CHECK(u == nstd::linalg::dvectorf{ 0.0f, 4.0f, 2.0f });
+	CHECK_THROWS_AS(u.dot(nstd::linalg::dvectorf(2)), std::runtime_error);
+}
+
+TEST_CASE("products match Eigen") {
+	const auto a = test_dmatrix::random_dmatrix(123, 77, 1);
+	const auto b = test_dmatrix::random_dmatrix(77, 45, 2);
+	const auto ab = a * b;
+	const Eigen::MatrixXf expected = test_dmatrix::to_eigen(a) * test_dmatrix::to_eigen(b);
+	CHECK_EQ(ab.rows(), 123);
+	CHECK_EQ(ab.cols(), 45);
+	for (size_t i = 0; i < ab.rows(); i++) {
+		for (size_t j = 0; j < ab.cols(); j++) {
+			// entries are sums of 77 unit-sized products, the dispatched kernel may round them differently (fma) near zero
+			CHECK(nstd::abs(ab[i][j] - expected(i, j)) <= 1e-4f * nstd::max(1.0f, nstd::abs(expected(i, j))));
+		}
+	}
+	CHECK_THROWS_AS(b * a, std::runtime_error);
+
+	nstd::linalg::dvectorf x(77);
+	for (size_t i = 0; i < x.size(); i++) {
+		x[i] = static_cast<float>(i) * 0.01f;
+	}
+	const auto ax = a * x;
+	const Eigen::VectorXf expected_x = test_dmatrix::to_eigen(a) * Eigen::Map<const Eigen::VectorXf>(x.data(), 77);
+	for (size_t i = 0; i < ax.size(); i++) {
+		CHECK(nstd::is_approx(ax[i], expected_x[i], 1e-4f));
+	}
+
+	const auto t = a.transpose();
+	CHECK_EQ(t.rows(), 77);
+	for (size_t i = 0; i < a.rows(); i++) {
+		for (size_t j = 0; j < a.cols(); j++) {
+			CHECK_EQ(t[j][i], a[i][j]);
+		}
+	}
+}
+
+TEST_CASE("mixed with fixed-size matrices") {
+	const nstd::linalg::matrix<float, 2, 3, false> fixed(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+	const nstd::linalg::dmatrixf dyn(fixed);
+	CHECK(dyn == nstd::linalg::dmatrixf(2, 3, { 1, 2, 3, 4, 5, 6 }));
+	CHECK(dyn.to_fixed<2, 3>() == fixed);
+	CHECK_THROWS_AS((dyn.to_fixed<3, 2>()), std::runtime_error);
+
+	const nstd::linalg::dmatrixf tall(3, 2, { 1, 0, 0, 1, 1, 1 });
+	CHECK(fixed * tall == nstd::linalg::dmatrixf(2, 2, { 4, 5, 10, 11 }));
+	CHECK(tall * fixed == nstd::linalg::dmatrixf(3, 3, { 1, 2, 3, 4, 5, 6, 5, 7, 9 }));
+	CHECK(dyn + fixed == dyn * 2.0f);
+	CHECK(fixed - dyn == nstd::linalg::dmatrixf::zeros(2, 3));
+	CHECK_THROWS_AS(fixed * dyn, std::runtime_error);
+
+	const nstd::linalg::vector3f v(1.0f, 1.0f, 2.0f);
+	const auto dv = dyn * v;
+	CHECK(dv == nstd::linalg::dvectorf{ 9.0f, 21.0f });
+	CHECK(fixed * nstd::linalg::dvectorf(v) == dv);
+	CHECK(nstd::linalg::dvectorf(v).to_fixed<3>() == v);
+}
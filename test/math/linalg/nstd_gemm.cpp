@@ -0,0 +1,131 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_gemm.h>
+#include <math/nstd_math.h>
+
+#include <Eigen/Dense>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace test_gemm {
+
+template<typename Ty>
+using row_major = Eigen::Matrix<Ty, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+template<typename Ty>
+std::vector<Ty> random_dense(size_t n, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<int> dist(-4, 4);  // small integers keep float sums exact
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = static_cast<Ty>(dist(engine));
+	}
+	return res;
+}
+
+// c = alpha * a * b + beta * c with padded leading dimensions, checked against Eigen
+template<typename Ty>
+void check_gemm(size_t m, size_t n, size_t k, Ty alpha, Ty beta) {
+	const size_t lda = k + 3, ldb = n + 1, ldc = n + 2;
+	const auto a = random_dense<Ty>(m * lda, 1), b = random_dense<Ty>(k * ldb, 2);
+	auto c = random_dense<Ty>(m * ldc, 3);
+	const auto c0 = c;
+
+	nstd::linalg::gemm(m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+
+	using stride = Eigen::OuterStride<>;
+	Eigen::Map<const row_major<Ty>, 0, stride> ea(a.data(), m, k, stride(lda)), eb(b.data(), k, n, stride(ldb));
+	Eigen::Map<const row_major<Ty>, 0, stride> ec0(c0.data(), m, n, stride(ldc));
+	const row_major<Ty> expected = alpha * (ea * eb) + beta * ec0;
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < ldc; j++) {
+			if (j < n) {
+				CHECK_EQ(c[i * ldc + j], expected(i, j));
+			} else {
+				CHECK_EQ(c[i * ldc + j], c0[i * ldc + j]);  // padding untouched
+			}
+		}
+	}
+}
+
+}  // namespace test_gemm
+
+TEST_CASE("gemm / shapes") {
+	for (size_t m : { 1, 5, 6, 13, 100 }) {
+		for (size_t n : { 1, 7, 16, 33 }) {
+			for (size_t k : { 1, 4, 300 }) {  // 300 spans two k blocks
+				test_gemm::check_gemm<float>(m, n, k, 1.0f, 0.0f);
+			}
+		}
+	}
+	test_gemm::check_gemm<double>(97, 2100, 20, 1.0, 0.0);  // spans two n blocks
+	test_gemm::check_gemm<int>(30, 20, 10, 1, 0);
+}
+
+TEST_CASE("gemm / alpha beta") {
+	test_gemm::check_gemm<float>(20, 40, 300, 2.0f, 0.5f);
+	test_gemm::check_gemm<double>(9, 9, 9, -1.0, 1.0);
+	test_gemm::check_gemm<double>(9, 9, 0, 1.0, 3.0);  // empty product only scales c
+
+	// beta == 0 never reads c
+	std::vector<float> a(4, 1.0f), b(4, 1.0f), c(4, std::numeric_limits<float>::quiet_NaN());
+	nstd::linalg::gemm<float>(2, 2, 2, 1.0f, a.data(), 2, b.data(), 2, 0.0f, c.data(), 2);
+	for (float v : c) {
+		CHECK_EQ(v, 2.0f);
+	}
+}
+
+TEST_CASE("gemv / gemv_t") {
+	for (size_t m : { 1, 3, 4, 37 }) {
+		for (size_t n : { 1, 8, 21 }) {
+			const size_t lda = n + 1;
+			const auto a = test_gemm::random_dense<double>(m * lda, 4);
+			const auto x = test_gemm::random_dense<double>(m + n, 5);
+			auto y = test_gemm::random_dense<double>(m + n, 6);
+			const auto y0 = y;
+
+			using stride = Eigen::OuterStride<>;
+			Eigen::Map<const test_gemm::row_major<double>, 0, stride> ea(a.data(), m, n, stride(lda));
+
+			nstd::linalg::gemv(m, n, 2.0, a.data(), lda, x.data(), 3.0, y.data());
+			const Eigen::VectorXd expected = 2.0 * ea * Eigen::Map<const Eigen::VectorXd>(x.data(), n) + 3.0 * Eigen::Map<const Eigen::VectorXd>(y0.data(), m);
+			for (size_t i = 0; i < m; i++) {
+				CHECK_EQ(y[i], expected[i]);
+			}
+
+			nstd::linalg::gemv_t(m, n, -1.0, a.data(), lda, x.data(), 0.0, y.data());
+			const Eigen::VectorXd expected_t = -(ea.transpose() * Eigen::Map<const Eigen::VectorXd>(x.data(), m));
+			for (size_t j = 0; j < n; j++) {
+				CHECK_EQ(y[j], expected_t[j]);
+			}
+		}
+	}
+}
+
+TEST_CASE("dot / axpy / scal") {
+	for (size_t n : { 0, 1, 7, 64, 1001 }) {
+		const auto x = test_gemm::random_dense<float>(n, 7);
+		auto y = test_gemm::random_dense<float>(n, 8);
+		const auto y0 = y;
+
+		float expected = 0.0f;
+		for (size_t i = 0; i < n; i++) {
+			expected += x[i] * y[i];
+		}
+		CHECK_EQ(nstd::linalg::dot(n, x.data(), y.data()), expected);
+
+		nstd::linalg::axpy(n, 2.0f, x.data(), y.data());
+		for (size_t i = 0; i < n; i++) {
+			CHECK_EQ(y[i], y0[i] + 2.0f * x[i]);
+		}
+		nstd::linalg::scal(n, 0.5f, y.data());
+		for (size_t i = 0; i < n; i++) {
+			CHECK_EQ(y[i], (y0[i] + 2.0f * x[i]) * 0.5f);
+		}
+	}
+}
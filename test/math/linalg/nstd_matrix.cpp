@@ -10,6 +10,7 @@
 #include <Eigen/Dense>
 
 // TODO: REMOVE these deps in future versions
+#include <memory>
 #include <random>
 
 float random_float(float left, float right) {
@@ -117,3 +118,32 @@ TEST_CASE("mat mul 2") {
 
 	CHECK(check_matrix2(mul_a, mul_b(0, 0), mul_b(0, 1), mul_b(1, 0), mul_b(1, 1)));
 }
+
+TEST_CASE("mat mul large") {
+	// past gemm_fixed_min the product goes through dispatch::gemm
+	constexpr size_t M = 48, N = 40, P = 36;
+	static_assert(M * N * P >= nstd::linalg::gemm_fixed_min);
+	auto a = std::make_unique<nstd::linalg::matrix<float, M, N, false>>();
+	auto b = std::make_unique<nstd::linalg::matrix<float, N, P, false>>();
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < N; j++) {
+			(*a)[i][j] = random_float(-1.0f, 1.0f);
+		}
+	}
+	for (size_t i = 0; i < N; i++) {
+		for (size_t j = 0; j < P; j++) {
+			(*b)[i][j] = random_float(-1.0f, 1.0f);
+		}
+	}
+
+	const auto c = std::make_unique<nstd::linalg::matrix<float, M, P, false>>(*a * *b);
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < P; j++) {
+			float expected = 0.0f;
+			for (size_t k = 0; k < N; k++) {
+				expected += (*a)[i][k] * (*b)[k][j];
+			}
+			CHECK(nstd::abs((*c)[i][j] - expected) <= 1e-4f);
+		}
+	}
+}
@@ -0,0 +1,163 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_matrix.h>
+#include <math/linalg/nstd_vector.h>
+#include <math/nstd_math.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace test_matrix_constexpr {
+
+using nstd::linalg::matrix3d;
+using nstd::linalg::matrix4f;
+using nstd::linalg::vector3d;
+using nstd::linalg::vector3f;
+using nstd::linalg::vector4f;
+
+template<typename Mat>
+constexpr bool approx_equal(const Mat &lhs, const Mat &rhs, typename Mat::value_type tolerance) {
+	for (size_t i = 0; i < Mat::size_row(); i++) {
+		for (size_t j = 0; j < Mat::size_col(); j++) {
+			if (nstd::abs(lhs.at(i, j) - rhs.at(i, j)) > tolerance) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// an orthonormal camera basis, built with normalize / cross only
+constexpr matrix4f look_at(vector3f eye, vector3f target, vector3f up) {
+	const vector3f f = (target - eye).normalized();
+	const vector3f s = f.cross(up).normalized();
+	const vector3f u = s.cross(f);
+	return { s[0], s[1], s[2], -s.dot(eye),
+		     u[0], u[1], u[2], -u.dot(eye),
+		     -f[0], -f[1], -f[2], f.dot(eye),
+		     0.0f, 0.0f, 0.0f, 1.0f };
+}
+
+// OpenGL-style perspective projection from the focal length 1 / tan(fov / 2)
+constexpr matrix4f perspective(float focal, float aspect, float z_near, float z_far) {
+	return { focal / aspect, 0.0f, 0.0f, 0.0f,
+		     0.0f, focal, 0.0f, 0.0f,
+		     0.0f, 0.0f, (z_far + z_near) / (z_near - z_far), 2.0f * z_far * z_near / (z_near - z_far),
+		     0.0f, 0.0f, -1.0f, 0.0f };
+}
+
+// rotations about z by multiples of 45 degrees, composed from one rotation at compile time
+constexpr auto make_rotation_table() {
+	const double h = nstd::sqrt(0.5);
+	const matrix3d step(h, -h, 0.0, h, h, 0.0, 0.0, 0.0, 1.0);
+	struct {
+		matrix3d _Rot[8];
+	} res;
+	res._Rot[0] = matrix3d::identity();
+	for (size_t i = 1; i < 8; i++) {
+		res._Rot[i] = res._Rot[i - 1] * step;
+	}
+	return res;
+}
+
+constinit const matrix4f view_projection = perspective(2.0f, 16.0f / 9.0f, 0.1f, 100.0f) *
+                                           look_at({ 3.0f, 4.0f, 5.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+constinit const auto rotation_table = make_rotation_table();
+
+}  // namespace test_matrix_constexpr
+
+using namespace test_matrix_constexpr;
+
+// sqrt BEGINS
+static_assert(nstd::sqrt(0.0) == 0.0);
+static_assert(nstd::sqrt(1.0) == 1.0);
+static_assert(nstd::sqrt(4.0) == 2.0);
+static_assert(nstd::sqrt(0.25f) == 0.5f);
+static_assert(nstd::sqrt(2.0) == 1.4142135623730951);
+static_assert(nstd::sqrt(2.0f) == 1.41421356f);
+static_assert(nstd::sqrt(1e300) == 1e150);
+static_assert(nstd::sqrt(4.9406564584124654e-324) == 2.2227587494850775e-162);  // smallest subnormal
+static_assert(nstd::sqrt(17) == 4);
+static_assert(nstd::sqrt(-1.0) != nstd::sqrt(-1.0));
+static_assert(nstd::sqrt(std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity());
+// sqrt ENDS
+
+// visitor / products / norms BEGINS
+static_assert([] {
+	nstd::linalg::matrix2i mat = nstd::linalg::matrix2i::zeros();
+	mat[0][1] = 3;
+	mat[1][0] = mat[0][1] * 2;
+	return mat[1][0];
+}() == 6);
+
+static_assert(nstd::linalg::matrix2i(1, 2, 3, 4) * nstd::linalg::matrix2i(5, 6, 7, 8) == nstd::linalg::matrix2i(19, 22, 43, 50));
+static_assert(nstd::linalg::matrix2i(1, 2, 3, 4) * nstd::linalg::vector2i(1, 1) == nstd::linalg::vector2i(3, 7));
+static_assert(nstd::linalg::matrix<int, 2, 3, false>(1, 2, 3, 4, 5, 6) * nstd::linalg::matrix<int, 3, 1, false>(1, 0, -1) ==
+              nstd::linalg::vector2i(-2, -2));
+
+static_assert(vector3d(3.0, 4.0, 12.0).norm() == 13.0);
+static_assert(vector3f(0.0f, 3.0f, 4.0f).normalized() == vector3f(0.0f, 0.6f, 0.8f));
+static_assert(vector3d(0.0, 0.0, 0.0).normalized() == vector3d(0.0, 0.0, 0.0));
+static_assert([] {
+	vector4f v(1.0f, 1.0f, 1.0f, 1.0f);
+	v.normalize();
+	return v;
+}() == vector4f(0.5f, 0.5f, 0.5f, 0.5f));
+// visitor / products / norms ENDS
+
+// decompositions BEGINS
+constexpr matrix3d spd(4.0, 2.0, 0.6, 2.0, 5.0, 1.0, 0.6, 1.0, 3.0);
+constexpr matrix3d general(0.0, 2.0, 1.0, 1.0, 1.0, 0.0, 3.0, 0.0, 2.0);
+
+static_assert(nstd::linalg::transpose(nstd::linalg::matrix<int, 2, 3, false>(1, 2, 3, 4, 5, 6)) ==
+              nstd::linalg::matrix<int, 3, 2, false>(1, 4, 2, 5, 3, 6));
+static_assert(nstd::linalg::trace(spd) == 12.0);
+
+static_assert(nstd::is_approx(nstd::linalg::determinant(general), -7.0, 1e-15));  // needs a row swap, the first pivot is 0
+static_assert(nstd::linalg::lu_decomposition(matrix3d(1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 1.0, 1.0))._Singular);
+static_assert(approx_equal(nstd::linalg::inverse(general) * general, matrix3d::identity(), 1e-15));
+static_assert(approx_equal(nstd::linalg::lu_decomposition(general).solve(vector3d(3.0, 2.0, 5.0)), vector3d(1.0, 1.0, 1.0), 1e-15));
+
+static_assert([] {
+	const nstd::linalg::cholesky_decomposition chol(spd);
+	return chol._Success && approx_equal(chol._L * nstd::linalg::transpose(chol._L), spd, 1e-14);
+}());
+static_assert(approx_equal(nstd::linalg::cholesky_decomposition(spd).solve(spd * vector3d(1.0, -2.0, 0.5)), vector3d(1.0, -2.0, 0.5), 1e-14));
+static_assert(!nstd::linalg::cholesky_decomposition(general)._Success);
+
+static_assert([] {
+	const nstd::linalg::qr_decomposition qr(general);
+	return qr._FullRank && approx_equal(qr._Q * qr._R, general, 1e-15) &&
+	       approx_equal(nstd::linalg::transpose(qr._Q) * qr._Q, matrix3d::identity(), 1e-15);
+}());
+// decompositions ENDS
+
+TEST_CASE("sqrt agrees with std::sqrt") {
+	constexpr double values[] = { 2.0, 3.0, 0.1, 1e-300, 123456789.0, 4.9406564584124654e-324, 1.7976931348623157e308 };
+	constexpr double roots[] = { nstd::sqrt(values[0]), nstd::sqrt(values[1]), nstd::sqrt(values[2]), nstd::sqrt(values[3]),
+		                         nstd::sqrt(values[4]), nstd::sqrt(values[5]), nstd::sqrt(values[6]) };
+	for (size_t i = 0; i < 7; i++) {
+		volatile double x = values[i];
+		CHECK_EQ(roots[i], std::sqrt(x));
+		CHECK_EQ(nstd::sqrt(static_cast<double>(x)), std::sqrt(x));
+	}
+}
+
+TEST_CASE("constinit tables match run-time evaluation") {
+	volatile float two = 2.0f;
+	const matrix4f runtime = perspective(two, 16.0f / 9.0f, 0.1f, 100.0f) *
+	                         look_at({ 3.0f, 4.0f, 5.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+	CHECK(view_projection == runtime);
+
+	// eight 45 degree steps make a full turn
+	CHECK(approx_equal(rotation_table._Rot[7] * rotation_table._Rot[1], matrix3d::identity(), 1e-15));
+	CHECK(nstd::is_approx(rotation_table._Rot[2].at(0, 1), -1.0, 1e-15));
+
+	const matrix3d singular(1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 1.0, 1.0);
+	CHECK_EQ(nstd::linalg::determinant(singular), 0.0);
+	CHECK_THROWS_AS(nstd::linalg::inverse(singular), std::runtime_error);
+	CHECK_THROWS_AS(nstd::linalg::cholesky_decomposition(general).solve(vector3d(1.0, 1.0, 1.0)), std::runtime_error);
+}
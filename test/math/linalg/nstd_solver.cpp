@@ -0,0 +1,238 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_solver.h>
+#include <math/nstd_math.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_solver {
+
+// 5-point Laplacian on a grid x grid mesh, plus an upwinded convection term that makes it nonsymmetric
+template<typename Ty>
+nstd::linalg::csr_matrix<Ty> poisson(size_t grid, Ty convection = Ty(0)) {
+	nstd::linalg::coo_matrix<Ty> coo(grid * grid, grid * grid);
+	for (size_t i = 0; i < grid; i++) {
+		for (size_t j = 0; j < grid; j++) {
+			const size_t r = i * grid + j;
+			coo.push_back(r, r, Ty(4) + convection);
+			if (i > 0) {
+				coo.push_back(r, r - grid, Ty(-1) - convection);
+			}
+			if (i + 1 < grid) {
+				coo.push_back(r, r + grid, Ty(-1));
+			}
+			if (j > 0) {
+				coo.push_back(r, r - 1, Ty(-1));
+			}
+			if (j + 1 < grid) {
+				coo.push_back(r, r + 1, Ty(-1));
+			}
+		}
+	}
+	return coo.to_csr();
+}
+
+template<typename Ty>
+std::vector<Ty> random_dense(size_t n) {
+	std::mt19937_64 engine(n);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+// ||b - A x|| / ||b|| recomputed from scratch
+template<typename Ty>
+Ty relative_residual(const nstd::linalg::csr_matrix<Ty> &a, const std::vector<Ty> &b, const std::vector<Ty> &x) {
+	std::vector<Ty> ax(b.size());
+	nstd::linalg::spmv(a, x.data(), ax.data());
+	Ty num = 0, den = 0;
+	for (size_t i = 0; i < b.size(); i++) {
+		num += (b[i] - ax[i]) * (b[i] - ax[i]);
+		den += b[i] * b[i];
+	}
+	return std::sqrt(num / den);
+}
+
+// a matrix-free operator: the 1-D Laplacian
+struct laplacian_1d {
+	size_t _Size;
+
+	size_t rows() const noexcept {
+		return _Size;
+	}
+
+	size_t cols() const noexcept {
+		return _Size;
+	}
+
+	void apply(const double *x, double *y) const noexcept {
+		for (size_t i = 0; i < _Size; i++) {
+			y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i + 1 < _Size ? x[i + 1] : 0.0);
+		}
+	}
+};
+
+}  // namespace test_solver
+
+static_assert(nstd::linalg::linear_operator<nstd::linalg::csr_matrixf, float>);
+static_assert(nstd::linalg::linear_operator<nstd::linalg::dmatrixd, double>);
+static_assert(nstd::linalg::linear_operator<nstd::linalg::threaded_csr<float>, float>);
+static_assert(nstd::linalg::linear_operator<test_solver::laplacian_1d, double>);
+static_assert(!nstd::linalg::linear_operator<nstd::linalg::coo_matrixf, float>);
+static_assert(nstd::linalg::preconditioner<nstd::linalg::ic0_preconditioner<double>, double>);
+
+TEST_CASE("conjugate gradient with every preconditioner") {
+	const auto a = test_solver::poisson<double>(40);
+	const auto b = test_solver::random_dense<double>(a.rows());
+	nstd::linalg::conjugate_gradient<double> cg({ 2000, 1e-10 });
+
+	std::vector<double> x(a.rows(), 0.0);
+	const auto plain = cg.solve(a, b.data(), x.data());
+	CHECK(plain._Converged);
+	CHECK_LT(plain._Residual, 1e-10);
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-9);
+
+	std::fill(x.begin(), x.end(), 0.0);
+	const auto jacobi = cg.solve(a, b.data(), x.data(), nstd::linalg::jacobi_preconditioner<double>(a));
+	CHECK(jacobi._Converged);
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-9);
+
+	std::fill(x.begin(), x.end(), 0.0);
+	const nstd::linalg::ic0_preconditioner<double> ic(a);
+	const auto ic0 = cg.solve(a, b.data(), x.data(), ic);
+	CHECK(ic0._Converged);
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-9);
+	CHECK_LT(ic0._Iterations, plain._Iterations);
+
+	// a converged guess returns immediately
+	const auto again = cg.solve(a, b.data(), x.data(), ic);
+	CHECK(again._Converged);
+	CHECK_EQ(again._Iterations, 0);
+}
+
+TEST_CASE("ic0 reproduces the exact factor of a tridiagonal matrix") {
+	// no fill-in happens for a tridiagonal matrix, so IC(0) is the Cholesky factor and one application solves exactly
+	const size_t n = 50;
+	nstd::linalg::coo_matrixd coo(n, n);
+	for (size_t i = 0; i < n; i++) {
+		coo.push_back(i, i, 2.5);
+		if (i > 0) {
+			coo.push_back(i, i - 1, -1.0);
+			coo.push_back(i - 1, i, -1.0);
+		}
+	}
+	const auto a = coo.to_csr();
+	const nstd::linalg::ic0_preconditioner<double> ic(a);
+	CHECK_EQ(ic.factor().nnz(), 2 * n - 1);
+
+	const auto b = test_solver::random_dense<double>(n);
+	std::vector<double> x(n);
+	ic.apply(b.data(), x.data());
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-12);
+
+	nstd::linalg::coo_matrixd indefinite(2, 2);
+	indefinite.push_back(0, 0, 1.0);
+	indefinite.push_back(1, 0, 2.0);
+	indefinite.push_back(1, 1, 1.0);
+	CHECK_THROWS_AS(nstd::linalg::ic0_preconditioner<double>(indefinite.to_csr()), std::runtime_error);
+	nstd::linalg::coo_matrixd hollow(2, 2);
+	hollow.push_back(0, 0, 1.0);
+	CHECK_THROWS_AS(nstd::linalg::ic0_preconditioner<double>(hollow.to_csr()), std::runtime_error);
+	CHECK_THROWS_AS(nstd::linalg::jacobi_preconditioner<double>(hollow.to_csr()), std::runtime_error);
+}
+
+TEST_CASE("bicgstab on a nonsymmetric system") {
+	const auto a = test_solver::poisson<float>(48, 2.0f);
+	const auto b = test_solver::random_dense<float>(a.rows());
+	nstd::linalg::bicgstab<float> solver({ 1000, 1e-5f });
+
+	std::vector<float> x(a.rows(), 0.0f);
+	const auto plain = solver.solve(a, b.data(), x.data());
+	CHECK(plain._Converged);
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-4f);
+
+	std::fill(x.begin(), x.end(), 0.0f);
+	const auto jacobi = solver.solve(a, b.data(), x.data(), nstd::linalg::jacobi_preconditioner<float>(a));
+	CHECK(jacobi._Converged);
+	CHECK_LT(test_solver::relative_residual(a, b, x), 1e-4f);
+
+	// the threaded operator splits rows only, so it reproduces the serial iteration bit for bit
+	nstd::thread_pool pool(3);
+	std::vector<float> x_pool(a.rows(), 0.0f);
+	const auto threaded = solver.solve(nstd::linalg::threaded_csr<float>(a, pool), b.data(), x_pool.data(),
+	                                   nstd::linalg::jacobi_preconditioner<float>(a));
+	CHECK_EQ(threaded._Iterations, jacobi._Iterations);
+	for (size_t i = 0; i < x.size(); i++) {
+		CHECK_EQ(x_pool[i], x[i]);
+	}
+}
+
+TEST_CASE("dense and matrix-free operators") {
+	const size_t n = 60;
+	nstd::linalg::dmatrixd a(n, n, 0.0);
+	for (size_t i = 0; i < n; i++) {
+		a[i][i] = 2.0;
+		if (i > 0) {
+			a[i][i - 1] = -1.0;
+			a[i - 1][i] = -1.0;
+		}
+	}
+	const auto b = test_solver::random_dense<double>(n);
+
+	nstd::linalg::conjugate_gradient<double> cg({ 500, 1e-12 });
+	std::vector<double> x_dense(n, 0.0), x_free(n, 0.0);
+	CHECK(cg.solve(a, b.data(), x_dense.data(), nstd::linalg::jacobi_preconditioner<double>(a))._Converged);
+	CHECK(cg.solve(test_solver::laplacian_1d{ n }, b.data(), x_free.data())._Converged);
+	for (size_t i = 0; i < n; i++) {
+		CHECK(nstd::is_approx(x_dense[i], x_free[i], 1e-9));
+	}
+
+	nstd::linalg::bicgstab<double> solver({ 500, 1e-12 });
+	std::vector<double> x_bicg(n, 0.0);
+	CHECK(solver.solve(a, b.data(), x_bicg.data())._Converged);
+	for (size_t i = 0; i < n; i++) {
+		CHECK(nstd::is_approx(x_bicg[i], x_free[i], 1e-8));
+	}
+
+	// zero right-hand side gives the zero solution, non-square operators are rejected
+	const std::vector<double> zero(n, 0.0);
+	CHECK(cg.solve(a, zero.data(), x_dense.data())._Converged);
+	CHECK_EQ(x_dense[7], 0.0);
+	const nstd::linalg::dmatrixd wide(3, 4, 1.0);
+	CHECK_THROWS_AS(cg.solve(wide, zero.data(), x_dense.data()), std::runtime_error);
+}
+
+TEST_CASE("workspace is reused across solves") {
+	const auto big = test_solver::poisson<double>(20);
+	const auto small = test_solver::poisson<double>(10);
+	const auto b = test_solver::random_dense<double>(big.rows());
+	nstd::linalg::conjugate_gradient<double> cg;
+	cg.options()._MaxIterations = 3;
+	cg.reserve(big.rows());
+
+	// later solves of the same or smaller size give identical results, so nothing stale leaks from the previous one
+	std::vector<double> x1(big.rows(), 0.0), x2(big.rows(), 0.0), x3(small.rows(), 0.0), x4(small.rows(), 0.0);
+	const auto r1 = cg.solve(big, b.data(), x1.data());
+	cg.solve(small, b.data(), x3.data());
+	const auto r2 = cg.solve(big, b.data(), x2.data());
+	CHECK_FALSE(r1._Converged);
+	CHECK_EQ(r1._Iterations, 3);
+	CHECK_EQ(r1._Residual, r2._Residual);
+	for (size_t i = 0; i < x1.size(); i++) {
+		CHECK_EQ(x1[i], x2[i]);
+	}
+	nstd::linalg::conjugate_gradient<double> fresh(cg.options());
+	fresh.solve(small, b.data(), x4.data());
+	for (size_t i = 0; i < x3.size(); i++) {
+		CHECK_EQ(x3[i], x4[i]);
+	}
+}
@@ -0,0 +1,166 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_sparse.h>
+#include <math/nstd_math.h>
+#include <util/nstd_thread_pool.h>
+
+#include <Eigen/Sparse>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_sparse {
+
+// random triplets with plenty of duplicates, mirrored into an Eigen matrix
+template<typename Ty>
+nstd::linalg::coo_matrix<Ty> random_coo(size_t rows, size_t cols, size_t n, Eigen::SparseMatrix<Ty, Eigen::RowMajor> &ref) {
+	std::mt19937_64 engine(rows * 31 + cols);
+	std::uniform_int_distribution<size_t> row_dist(0, rows - 1), col_dist(0, cols - 1);
+	std::uniform_real_distribution<Ty> val_dist(-1, 1);
+
+	nstd::linalg::coo_matrix<Ty> coo(rows, cols);
+	std::vector<Eigen::Triplet<Ty>> triplets;
+	for (size_t k = 0; k < n; k++) {
+		const size_t r = row_dist(engine), c = col_dist(engine);
+		const Ty v = val_dist(engine);
+		coo.push_back(r, c, v);
+		triplets.emplace_back(static_cast<int>(r), static_cast<int>(c), v);
+	}
+	ref.resize(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+	ref.setFromTriplets(triplets.begin(), triplets.end());
+	return coo;
+}
+
+template<typename Ty>
+std::vector<Ty> random_dense(size_t n) {
+	std::mt19937_64 engine(n);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+}  // namespace test_sparse
+
+TEST_CASE("triplets are sorted and summed") {
+	nstd::linalg::coo_matrixf coo(3, 4);
+	coo.push_back(2, 1, 1.0f);
+	coo.push_back(0, 3, 2.0f);
+	coo.push_back(2, 0, 3.0f);
+	coo.push_back(0, 3, 4.0f);
+	coo.push_back(0, 1, 5.0f);
+	CHECK_THROWS_AS(coo.push_back(3, 0, 1.0f), std::runtime_error);
+	// indices that would not fit the index type
+	CHECK_THROWS_AS((nstd::linalg::coo_matrix<float, std::int16_t>(40000, 3)), std::runtime_error);
+	CHECK_THROWS_AS((nstd::linalg::csr_matrix<float, std::int16_t>(3, 40000)), std::runtime_error);
+	CHECK_THROWS_AS((nstd::linalg::csc_matrix<float, std::int16_t>(40000, 3)), std::runtime_error);
+
+	const auto csr = coo.to_csr();
+	CHECK_EQ(csr.rows(), 3);
+	CHECK_EQ(csr.cols(), 4);
+	CHECK_EQ(csr.nnz(), 4);
+	const int row_ptr[] = { 0, 2, 2, 4 };
+	const int col_idx[] = { 1, 3, 0, 1 };
+	const float values[] = { 5.0f, 6.0f, 3.0f, 1.0f };
+	for (size_t i = 0; i < 4; i++) {
+		CHECK_EQ(csr.row_ptr()[i], row_ptr[i]);
+		CHECK_EQ(csr.col_idx()[i], col_idx[i]);
+		CHECK_EQ(csr.values()[i], values[i]);
+	}
+	CHECK_EQ(csr.coeff(0, 3), 6.0f);
+	CHECK_EQ(csr.coeff(1, 1), 0.0f);
+	CHECK_THROWS_AS(csr.coeff(0, 4), std::runtime_error);
+
+	coo.sum_duplicates();
+	CHECK_EQ(coo.nnz(), 4);
+	CHECK_EQ(coo.row_idx()[1], 0);
+	CHECK_EQ(coo.col_idx()[1], 3);
+	CHECK_EQ(coo.values()[1], 6.0f);
+}
+
+TEST_CASE("conversions") {
+	Eigen::SparseMatrix<double, Eigen::RowMajor> ref;
+	const auto coo = test_sparse::random_coo<double>(57, 43, 600, ref);
+	const auto csr = coo.to_csr();
+	const auto csc = coo.to_csc();
+	CHECK_EQ(csr.nnz(), static_cast<size_t>(ref.nonZeros()));
+	CHECK_EQ(csc.nnz(), csr.nnz());
+
+	const auto csc2 = csr.to_csc();
+	const auto csr2 = csc.to_csr();
+	const auto t = csr.transpose();
+	CHECK_EQ(t.rows(), 43);
+	for (size_t i = 0; i < 57; i++) {
+		for (size_t j = 0; j < 43; j++) {
+			const double expected = ref.coeff(static_cast<int>(i), static_cast<int>(j));
+			CHECK(nstd::is_approx(csr.coeff(i, j), expected, 1e-12));
+			CHECK_EQ(csc.coeff(i, j), csc2.coeff(i, j));
+			CHECK_EQ(csr2.coeff(i, j), csr.coeff(i, j));
+			CHECK_EQ(t.coeff(j, i), csr.coeff(i, j));
+		}
+	}
+	for (size_t k = 0; k <= 57; k++) {
+		CHECK_EQ(csr2.row_ptr()[k], csr.row_ptr()[k]);
+	}
+	CHECK_EQ(csc.to_coo().nnz(), csr.nnz());
+}
+
+TEST_CASE("adopt raw arrays") {
+	nstd::linalg::csr_matrixf ok(2, 3, { 0, 1, 3 }, { 2, 0, 1 }, { 1.0f, 2.0f, 3.0f });
+	CHECK_EQ(ok.coeff(1, 1), 3.0f);
+	CHECK_THROWS_AS(nstd::linalg::csr_matrixf(2, 3, { 0, 1, 3 }, { 2, 1, 0 }, { 1.0f, 2.0f, 3.0f }), std::runtime_error);  // unsorted
+	CHECK_THROWS_AS(nstd::linalg::csr_matrixf(2, 3, { 0, 1, 3 }, { 2, 0, 3 }, { 1.0f, 2.0f, 3.0f }), std::runtime_error);  // out of range
+	CHECK_THROWS_AS(nstd::linalg::csr_matrixf(2, 3, { 0, 2, 1 }, { 2, 0, 1 }, { 1.0f, 2.0f, 3.0f }), std::runtime_error);  // not monotonic
+	CHECK_THROWS_AS(nstd::linalg::csc_matrixf(2, 3, { 0, 1 }, { 0 }, { 1.0f }), std::runtime_error);                       // short pointers
+
+	const nstd::linalg::csr_matrixf empty(0, 5);
+	CHECK_EQ(empty.to_csc().cols(), 5);
+}
+
+TEST_CASE("spmv") {
+	nstd::thread_pool pool(4);
+	for (size_t n : { 1, 7, 300, 4000 }) {
+		Eigen::SparseMatrix<float, Eigen::RowMajor> ref;
+		const auto coo = test_sparse::random_coo<float>(n, n + 3, n * 9, ref);
+		const auto csr = coo.to_csr();
+		const auto csc = coo.to_csc();
+		const auto x = test_sparse::random_dense<float>(n + 3);
+
+		const Eigen::VectorXf expected = ref * Eigen::Map<const Eigen::VectorXf>(x.data(), static_cast<Eigen::Index>(x.size()));
+		std::vector<float> y(n), y_pool(n), y_csc(n);
+		nstd::linalg::spmv(csr, x.data(), y.data());
+		nstd::linalg::spmv(csr, x.data(), y_pool.data(), pool);
+		nstd::linalg::spmv(csc, x.data(), y_csc.data());
+		for (size_t i = 0; i < n; i++) {
+			CHECK(nstd::is_approx(y[i], expected[static_cast<Eigen::Index>(i)], 1e-4f));
+			CHECK_EQ(y_pool[i], y[i]);
+			CHECK(nstd::is_approx(y_csc[i], y[i], 1e-4f));
+		}
+	}
+}
+
+TEST_CASE("spmm") {
+	nstd::thread_pool pool(3);
+	Eigen::SparseMatrix<double, Eigen::RowMajor> ref;
+	const size_t rows = 2000, inner = 1500, block = 5;
+	const auto csr = test_sparse::random_coo<double>(rows, inner, 30000, ref).to_csr();
+	const auto b = test_sparse::random_dense<double>(inner * block);
+
+	using dense = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+	const dense expected = ref * Eigen::Map<const dense>(b.data(), inner, block);
+	std::vector<double> c(rows * block, 42.0), c_pool(rows * block, 42.0);
+	nstd::linalg::spmm(csr, b.data(), block, c.data());
+	nstd::linalg::spmm(csr, b.data(), block, c_pool.data(), pool);
+	for (size_t i = 0; i < rows; i++) {
+		for (size_t j = 0; j < block; j++) {
+			CHECK(nstd::is_approx(c[i * block + j], expected(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j)), 1e-12));
+			CHECK_EQ(c_pool[i * block + j], c[i * block + j]);
+		}
+	}
+}
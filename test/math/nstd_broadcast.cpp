@@ -0,0 +1,102 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_broadcast.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <memory>
+#include <type_traits>
+
+namespace test_broadcast {
+
+template<typename Arr>
+void iota(Arr &arr, typename Arr::value_type first, typename Arr::value_type step) {
+	for (auto &v : arr) {
+		v = first;
+		first += step;
+	}
+}
+
+template<typename Lhs, typename Rhs>
+using shape_of = typename nstd::internal::broadcast_result<Lhs, Rhs>::type;
+
+}  // namespace test_broadcast
+
+TEST_CASE("shapes broadcast at compile time") {
+	using nstd::internal::broadcast_shape;
+	using test_broadcast::shape_of;
+	static_assert(std::is_same_v<shape_of<broadcast_shape<4, 1>, broadcast_shape<3>>, broadcast_shape<4, 3>>);
+	static_assert(std::is_same_v<shape_of<broadcast_shape<2, 1, 5>, broadcast_shape<7, 1>>, broadcast_shape<2, 7, 5>>);
+	static_assert(std::is_same_v<shape_of<broadcast_shape<>, broadcast_shape<3, 2>>, broadcast_shape<3, 2>>);
+	static_assert(!nstd::internal::broadcast_result<broadcast_shape<4, 3>, broadcast_shape<4>>::compatible);
+
+	using m43 = nstd::ndarray<float, 4, 3>;
+	// expressions are lazy and typed by the promotions of their elements
+	static_assert(std::is_same_v<decltype(nstd::eval(std::declval<m43>() - std::declval<nstd::ndarray<float, 4, 1>>())), m43>);
+	static_assert(std::is_same_v<decltype(nstd::eval(std::declval<m43>() * 2.0)), m43>);
+	static_assert(std::is_same_v<decltype(nstd::eval(std::declval<nstd::ndarray<int, 3>>() * 0.5)), nstd::ndarray<double, 3>>);
+	static_assert(std::is_same_v<decltype(nstd::eval(std::declval<m43>() > 0)), nstd::ndarray<bool, 4, 3>>);
+}
+
+TEST_CASE("row-mean subtraction and column scaling in one pass") {
+	constexpr size_t R = 5, C = 37;  // C is not a multiple of any simd width
+	auto x = std::make_unique<nstd::ndarray<double, R, C>>();
+	test_broadcast::iota(*x, 1.0, 0.5);
+	nstd::ndarray<double, R, 1> mean{};
+	nstd::ndarray<double, C> scale{};
+	for (size_t i = 0; i < R; i++) {
+		for (size_t j = 0; j < C; j++) {
+			mean[i][0] += (*x)[i][j] / C;
+		}
+	}
+	test_broadcast::iota(scale, 1.0, 1.0);
+
+	const auto y = nstd::eval((*x - mean) / scale);
+	for (size_t i = 0; i < R; i++) {
+		for (size_t j = 0; j < C; j++) {
+			CHECK(std::abs(y[i][j] - ((*x)[i][j] - mean[i][0]) / scale[j]) < 1e-12);
+		}
+	}
+
+	// in place: x appears with the full output shape
+	nstd::assign(*x, (*x - mean) / scale);
+	CHECK_EQ(y[2][5], (*x)[2][5]);
+	CHECK_EQ(y[4][36], (*x)[4][36]);
+
+	// scalars on either side, operands of different rank
+	nstd::ndarray<float, 3, 1, 4> a;
+	nstd::ndarray<float, 2, 1> b;
+	test_broadcast::iota(a, 0.0f, 1.0f);
+	test_broadcast::iota(b, 10.0f, 10.0f);
+	const auto c = nstd::eval(2.0f * a + b - 1);
+	static_assert(std::is_same_v<std::remove_const_t<decltype(c)>, nstd::ndarray<float, 3, 2, 4>>);
+	CHECK_EQ(c[2][1][3], 2.0f * 11 + 20 - 1);
+	CHECK_EQ(c[0][0][0], 9.0f);
+
+	// a lower-rank expression tiled over the output
+	nstd::ndarray<float, 3, 4> tiled;
+	nstd::assign(tiled, b[1][0] + nstd::ndarray<float, 4>{});
+	CHECK_EQ(tiled[2][3], 20.0f);
+}
+
+TEST_CASE("comparisons and integer elements") {
+	nstd::ndarray<int, 3, 4> m;
+	nstd::ndarray<int, 4> threshold;
+	test_broadcast::iota(m, 0, 1);
+	test_broadcast::iota(threshold, 2, 3);
+
+	const auto mask = nstd::eval(m >= threshold);
+	CHECK(mask[0][0] == false);
+	CHECK(mask[1][0] == true);
+	CHECK(mask[2][3] == true);
+	CHECK(mask[1][3] == false);
+	CHECK(nstd::eval(m == 5)[1][1] == true);
+	CHECK(nstd::eval(7 < m)[1][3] == false);
+	CHECK(nstd::eval(m != m)[2][2] == false);
+
+	const auto q = nstd::eval((m + 1) * 3 / threshold);
+	CHECK_EQ(q[2][3], (11 + 1) * 3 / 11);
+	CHECK_EQ(q[0][0], 1);
+}
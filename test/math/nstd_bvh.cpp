@@ -0,0 +1,199 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/nstd_bvh.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace test_bvh {
+
+using nstd::linalg::vector3f;
+
+std::vector<nstd::aabb> random_boxes(size_t n, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> pos(-50.0f, 50.0f), size(0.0f, 2.0f);
+	std::vector<nstd::aabb> res(n);
+	for (auto &box : res) {
+		for (size_t a = 0; a < 3; a++) {
+			box._Min[a] = pos(engine);
+			box._Max[a] = box._Min[a] + size(engine);
+		}
+	}
+	return res;
+}
+
+float box_entry(const nstd::ray &r, const nstd::aabb &box) {
+	float near = r._TMin, far = r._TMax;
+	for (size_t a = 0; a < 3; a++) {
+		const float inv = 1.0f / r._Dir[a];
+		const float t0 = (box._Min[a] - r._Origin[a]) * inv, t1 = (box._Max[a] - r._Origin[a]) * inv;
+		near = std::max(near, std::min(t0, t1));
+		far = std::min(far, std::max(t0, t1));
+	}
+	return near <= far ? near : std::numeric_limits<float>::infinity();
+}
+
+float box_dist2(const vector3f &p, const nstd::aabb &box) {
+	float d2 = 0.0f;
+	for (size_t a = 0; a < 3; a++) {
+		const float d = std::max(std::max(box._Min[a] - p[a], p[a] - box._Max[a]), 0.0f);
+		d2 += d * d;
+	}
+	return d2;
+}
+
+// leaves hold every primitive once and inner children follow their parents
+template<typename Bvh>
+void check_structure(const Bvh &tree, const std::vector<nstd::aabb> &boxes) {
+	size_t leaves = 0;
+	const auto &nodes = tree.nodes();
+	for (size_t i = 0; i < nodes.size(); i++) {
+		for (size_t l = 0; l < Bvh::width; l++) {
+			if (nodes[i]._Child[l] == Bvh::npos) {
+				continue;
+			}
+			if (nodes[i]._Count[l] != 0) {
+				leaves += nodes[i]._Count[l];
+				CHECK(nodes[i]._Count[l] <= Bvh::leaf_size);
+			} else {
+				CHECK(nodes[i]._Child[l] > i);
+				REQUIRE(nodes[i]._Child[l] < nodes.size());
+			}
+		}
+	}
+	CHECK_EQ(leaves, boxes.size());
+	for (size_t p = 0; p < boxes.size(); p++) {
+		const nstd::bvh_hit hit = tree.nearest(boxes[p]._Min, [&](std::uint32_t prim, const vector3f &) { return prim == p ? 0.0f : 1.0f; }, 0.5f);
+		CHECK_EQ(hit._Prim, p);
+	}
+}
+
+template<typename Bvh>
+void check_queries(const Bvh &tree, const std::vector<nstd::aabb> &boxes, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> pos(-60.0f, 60.0f), dir(-1.0f, 1.0f);
+	for (int trial = 0; trial < 200; trial++) {
+		const nstd::ray r{ vector3f(pos(engine), pos(engine), pos(engine)), vector3f(dir(engine), dir(engine), dir(engine)) };
+		float expected = std::numeric_limits<float>::infinity();
+		for (const auto &box : boxes) {
+			expected = std::min(expected, box_entry(r, box));
+		}
+		const nstd::bvh_hit hit = tree.raycast(r);
+		CHECK_EQ(hit._Dist, expected);
+		CHECK_EQ(static_cast<bool>(hit), expected != std::numeric_limits<float>::infinity());
+		if (hit) {
+			CHECK_EQ(box_entry(r, boxes[hit._Prim]), expected);
+		}
+
+		const vector3f p(pos(engine), pos(engine), pos(engine));
+		float nearest = std::numeric_limits<float>::infinity();
+		for (const auto &box : boxes) {
+			nearest = std::min(nearest, box_dist2(p, box));
+		}
+		const nstd::bvh_hit near = tree.nearest(p);
+		REQUIRE(static_cast<bool>(near));
+		CHECK_EQ(near._Dist, nearest);
+		CHECK_EQ(box_dist2(p, boxes[near._Prim]), nearest);
+	}
+}
+
+}  // namespace test_bvh
+
+TEST_CASE("bvh queries match brute force") {
+	using namespace test_bvh;
+	nstd::thread_pool pool(4);
+	for (size_t n : { 1, 3, 4, 5, 37, 1000, 20000 }) {
+		CAPTURE(n);
+		const auto boxes = random_boxes(n, static_cast<unsigned>(n));
+		const nstd::bvh wide(boxes.data(), n, pool);
+		const nstd::bvh4 narrow(boxes.data(), n);
+		CHECK_EQ(wide.size(), n);
+		check_structure(wide, boxes);
+		check_structure(narrow, boxes);
+		check_queries(wide, boxes, 1);
+		check_queries(narrow, boxes, 2);
+	}
+
+	// clustered and duplicated primitives: centroids that no plane separates
+	std::vector<nstd::aabb> same(100, nstd::aabb{ vector3f(1.0f, 1.0f, 1.0f), vector3f(2.0f, 2.0f, 2.0f) });
+	const nstd::bvh dup(same.data(), same.size());
+	check_structure(dup, same);
+	CHECK(dup.raycast(nstd::ray{ vector3f(0.0f, 1.5f, 1.5f), vector3f(1.0f, 0.0f, 0.0f) })._Dist == 1.0f);
+
+	const nstd::bvh empty;
+	CHECK(!empty.raycast(nstd::ray{ vector3f(0.0f), vector3f(1.0f) }));
+	CHECK(!empty.nearest(vector3f(0.0f)));
+}
+
+TEST_CASE("bvh exact callbacks and refit") {
+	using namespace test_bvh;
+	// points as degenerate boxes, the callback measures to the points themselves
+	std::mt19937 engine(7);
+	std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+	std::vector<vector3f> points(5000);
+	std::vector<nstd::aabb> boxes(points.size());
+	for (size_t i = 0; i < points.size(); i++) {
+		points[i] = vector3f(pos(engine), pos(engine), pos(engine));
+		boxes[i] = { points[i], points[i] };
+	}
+	nstd::thread_pool pool(3);
+	nstd::bvh tree(boxes.data(), boxes.size(), pool);
+	const auto dist2 = [&](std::uint32_t prim, const vector3f &p) {
+		const vector3f d = points[prim] - p;
+		return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+	};
+	const vector3f query(0.5f, -0.25f, 3.0f);
+	std::uint32_t expected = 0;
+	for (std::uint32_t i = 1; i < points.size(); i++) {
+		expected = dist2(i, query) < dist2(expected, query) ? i : expected;
+	}
+	CHECK_EQ(tree.nearest(query, dist2)._Prim, expected);
+	CHECK(!tree.nearest(query, dist2, dist2(expected, query) * 0.5f));
+
+	// spheres of radius 0.05 around the points
+	const nstd::ray r{ vector3f(-20.0f, 0.0f, 0.0f), vector3f(1.0f, 0.0f, 0.0f) };
+	const auto sphere = [&](std::uint32_t prim, const nstd::ray &ray) {
+		const vector3f oc = ray._Origin - points[prim];
+		const float b = oc[0] * ray._Dir[0] + oc[1] * ray._Dir[1] + oc[2] * ray._Dir[2];
+		const float c = oc[0] * oc[0] + oc[1] * oc[1] + oc[2] * oc[2] - 0.05f * 0.05f;
+		const float disc = b * b - c;
+		const float t = disc < 0.0f ? std::numeric_limits<float>::infinity() : -b - std::sqrt(disc);
+		return t >= ray._TMin && t <= ray._TMax ? t : std::numeric_limits<float>::infinity();
+	};
+	// enlarge the boxes to the spheres
+	for (size_t i = 0; i < points.size(); i++) {
+		boxes[i] = { points[i] - vector3f(0.05f), points[i] + vector3f(0.05f) };
+	}
+	tree.refit(boxes.data());
+	float best = std::numeric_limits<float>::infinity();
+	std::uint32_t best_prim = nstd::bvh_hit::npos;
+	for (std::uint32_t i = 0; i < points.size(); i++) {
+		const float t = sphere(i, r);
+		if (t < best) {
+			best = t;
+			best_prim = i;
+		}
+	}
+	const nstd::bvh_hit hit = tree.raycast(r, sphere);
+	CHECK_EQ(hit._Prim, best_prim);
+	CHECK_EQ(hit._Dist, best);
+
+	// move everything: the refitted tree answers like a rebuilt one
+	for (size_t i = 0; i < points.size(); i++) {
+		points[i] = vector3f(points[i][1] * 2.0f, points[i][2], -points[i][0]);
+		boxes[i] = { points[i], points[i] };
+	}
+	tree.refit(boxes.data());
+	const nstd::bvh rebuilt(boxes.data(), boxes.size());
+	check_queries(tree, boxes, 3);
+	const nstd::aabb moved = tree.bounds(), fresh = rebuilt.bounds();
+	for (size_t a = 0; a < 3; a++) {
+		CHECK_EQ(moved._Min[a], fresh._Min[a]);
+		CHECK_EQ(moved._Max[a], fresh._Max[a]);
+	}
+}
@@ -0,0 +1,242 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_convolve.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_convolve {
+
+template<typename Ty>
+std::vector<Ty> random_grid(size_t n, size_t seed = 1) {
+	std::mt19937_64 engine(n + seed);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+template<size_t Rank>
+size_t volume(const size_t (&extents)[Rank]) {
+	size_t n = 1;
+	for (size_t e : extents) {
+		n *= e;
+	}
+	return n;
+}
+
+template<typename Ty, typename Boundary>
+Ty sample(const std::vector<Ty> &in, const long long *coord, const size_t *extents, size_t rank, const Boundary &boundary) {
+	size_t lin = 0;
+	for (size_t d = 0; d < rank; d++) {
+		long long i = coord[d];
+		const long long n = static_cast<long long>(extents[d]);
+		if constexpr (std::is_same_v<Boundary, nstd::clamp_boundary>) {
+			i = i < 0 ? 0 : (i >= n ? n - 1 : i);
+		} else if constexpr (std::is_same_v<Boundary, nstd::wrap_boundary>) {
+			i = ((i % n) + n) % n;
+		} else if (i < 0 || i >= n) {
+			return boundary._Value;
+		}
+		lin = lin * extents[d] + static_cast<size_t>(i);
+	}
+	return in[lin];
+}
+
+// the textbook loop: out[x] = sum of kernel[i] * in[x + i - c], or in[x - i + c] when flipped
+template<typename Ty, size_t Rank, typename Boundary>
+std::vector<Ty> reference(const std::vector<Ty> &in, const size_t (&extents)[Rank], const std::vector<Ty> &kernel,
+                          const size_t (&kernel_extents)[Rank], bool flip, const Boundary &boundary) {
+	std::vector<Ty> out(in.size());
+	for (size_t cell = 0; cell < in.size(); cell++) {
+		long long coord[Rank];
+		size_t rest = cell;
+		for (size_t d = Rank; d-- > 0;) {
+			coord[d] = static_cast<long long>(rest % extents[d]);
+			rest /= extents[d];
+		}
+		Ty acc = 0;
+		for (size_t k = 0; k < kernel.size(); k++) {
+			long long at[Rank];
+			rest = k;
+			for (size_t d = Rank; d-- > 0;) {
+				const long long i = static_cast<long long>(rest % kernel_extents[d]), c = static_cast<long long>(kernel_extents[d] / 2);
+				rest /= kernel_extents[d];
+				at[d] = coord[d] + (flip ? c - i : i - c);
+			}
+			acc += kernel[k] * sample(in, at, extents, Rank, boundary);
+		}
+		out[cell] = acc;
+	}
+	return out;
+}
+
+template<typename Ty>
+void check_close(const std::vector<Ty> &lhs, const std::vector<Ty> &rhs, Ty tolerance) {
+	REQUIRE_EQ(lhs.size(), rhs.size());
+	for (size_t i = 0; i < lhs.size(); i++) {
+		CHECK(std::abs(lhs[i] - rhs[i]) <= tolerance);
+	}
+}
+
+template<typename Ty, size_t Rank, typename Boundary>
+void check_against_reference(const size_t (&extents)[Rank], const std::vector<Ty> &kernel, const size_t (&kernel_extents)[Rank],
+                             const Boundary &boundary, Ty tolerance) {
+	const auto in = random_grid<Ty>(volume(extents));
+	std::vector<Ty> out(in.size(), Ty(42));
+	const nstd::strided_view<const Ty, Rank> in_view(in.data(), extents), kernel_view(kernel.data(), kernel_extents);
+	nstd::correlate(in_view, nstd::strided_view<Ty, Rank>(out.data(), extents), kernel_view, boundary);
+	check_close(out, reference(in, extents, kernel, kernel_extents, false, boundary), tolerance);
+	nstd::convolve(in_view, nstd::strided_view<Ty, Rank>(out.data(), extents), kernel_view, boundary);
+	check_close(out, reference(in, extents, kernel, kernel_extents, true, boundary), tolerance);
+}
+
+// outer product of the 1-D kernels
+template<typename Ty>
+std::vector<Ty> outer(const std::vector<Ty> &a, const std::vector<Ty> &b) {
+	std::vector<Ty> res;
+	for (Ty x : a) {
+		for (Ty y : b) {
+			res.push_back(x * y);
+		}
+	}
+	return res;
+}
+
+}  // namespace test_convolve
+
+TEST_CASE("direct and separable kernels match the reference under every boundary policy") {
+	using namespace test_convolve;
+	const std::vector<double> sobel = outer<double>({ 1.0, 2.0, 1.0 }, { -1.0, 0.0, 1.0 });        // separable
+	const std::vector<double> sharpen = { 0.0, -1.0, 0.0, -1.0, 5.0, -1.0, 0.0, -1.0, 0.0 };      // not separable
+	const std::vector<double> wide = outer<double>({ 0.5, -1.0 }, { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 });  // even extents
+	const std::vector<double> odd = random_grid<double>(5 * 7, 7);
+	const size_t k33[] = { 3, 3 }, k26[] = { 2, 6 }, k57[] = { 5, 7 };
+
+	const size_t shapes[][2] = { { 1, 1 }, { 2, 3 }, { 3, 70 }, { 33, 41 }, { 16, 64 } };
+	for (const auto &shape : shapes) {
+		check_against_reference(shape, sobel, k33, nstd::clamp_boundary{}, 1e-12);
+		check_against_reference(shape, sobel, k33, nstd::wrap_boundary{}, 1e-12);
+		check_against_reference(shape, sobel, k33, nstd::constant_boundary<double>{ 2.0 }, 1e-12);
+		check_against_reference(shape, sharpen, k33, nstd::clamp_boundary{}, 1e-12);
+		check_against_reference(shape, sharpen, k33, nstd::constant_boundary<double>{ -1.0 }, 1e-12);
+		check_against_reference(shape, wide, k26, nstd::wrap_boundary{}, 1e-12);
+		check_against_reference(shape, odd, k57, nstd::clamp_boundary{}, 1e-12);
+	}
+
+	const std::vector<float> blur3 = outer<float>(outer<float>({ 0.25f, 0.5f, 0.25f }, { 0.25f, 0.5f, 0.25f }), { 0.25f, 0.5f, 0.25f });
+	const size_t k333[] = { 3, 3, 3 }, shape3[] = { 9, 5, 37 };
+	check_against_reference(shape3, blur3, k333, nstd::clamp_boundary{}, 1e-6f);
+	check_against_reference(shape3, blur3, k333, nstd::constant_boundary<float>{ 1.0f }, 1e-6f);
+	check_against_reference(shape3, random_grid<float>(27, 3), k333, nstd::wrap_boundary{}, 1e-5f);
+
+	const size_t k9[] = { 9 }, shape1[] = { 100 };
+	check_against_reference(shape1, random_grid<double>(9, 5), k9, nstd::wrap_boundary{}, 1e-12);
+	check_against_reference(shape1, random_grid<double>(9, 5), k9, nstd::constant_boundary<double>{ 3.0 }, 1e-12);
+}
+
+TEST_CASE("strided views and ndarray grids") {
+	using namespace test_convolve;
+	auto in = std::make_unique<nstd::ndarray<double, 20, 30>>();
+	auto out = std::make_unique<nstd::ndarray<double, 20, 30>>();
+	const auto values = random_grid<double>(20 * 30);
+	std::copy(values.begin(), values.end(), in->data());
+	nstd::ndarray<double, 3, 3> kernel;
+	kernel[0][1] = 1.0;
+	kernel[1][1] = -2.0;
+	kernel[2][2] = 0.5;
+
+	nstd::correlate(*in, *out, kernel);
+	const size_t extents[] = { 20, 30 }, k33[] = { 3, 3 };
+	const auto expected = reference(values, extents, std::vector<double>(kernel.data(), kernel.data() + 9), k33, false, nstd::clamp_boundary{});
+	check_close(std::vector<double>(out->data(), out->data() + 600), expected, 1e-12);
+
+	// every other column of the input into the transposed layout of a dense buffer: both sides strided
+	const auto src = nstd::make_view(static_cast<const nstd::ndarray<double, 20, 30> &>(*in)).slice(1, 0, 30, 2);
+	std::vector<double> dst(20 * 15, 42.0), packed;
+	for (size_t i = 0; i < 20; i++) {
+		for (size_t j = 0; j < 30; j += 2) {
+			packed.push_back(values[i * 30 + j]);
+		}
+	}
+	const nstd::strided_view<double, 2> transposed(dst.data(), { 20, 15 }, { 1, 20 });
+	nstd::correlate(src, transposed, kernel, nstd::wrap_boundary{});
+	const size_t half[] = { 20, 15 };
+	const auto expected_half = reference(packed, half, std::vector<double>(kernel.data(), kernel.data() + 9), k33, false, nstd::wrap_boundary{});
+	for (size_t i = 0; i < 20; i++) {
+		for (size_t j = 0; j < 15; j++) {
+			CHECK(std::abs(transposed[i][j] - expected_half[i * 15 + j]) <= 1e-12);
+		}
+	}
+
+	CHECK_THROWS_AS(nstd::correlate(*in, *in, kernel), std::runtime_error);
+	nstd::ndarray<double, 20, 29> narrow;
+	CHECK_THROWS_AS(nstd::correlate(*in, narrow, kernel), std::runtime_error);
+}
+
+TEST_CASE("gaussian and separable filters") {
+	using namespace test_convolve;
+	const auto gauss = nstd::gaussian_kernel(1.5f);
+	CHECK_EQ(gauss.size(), 11);
+	float sum = 0.0f;
+	for (float v : gauss) {
+		sum += v;
+	}
+	CHECK(std::abs(sum - 1.0f) <= 1e-6f);
+	CHECK_THROWS_AS(nstd::gaussian_kernel(0.0), std::runtime_error);
+
+	// the 2-D Gaussian as a full kernel is detected as separable and agrees with two 1-D passes
+	const size_t extents[] = { 40, 50 }, k11[] = { 11, 11 };
+	const auto in = random_grid<float>(40 * 50);
+	const auto kernel2d = outer(gauss, gauss);
+	std::vector<float> direct(in.size()), passes(in.size());
+	nstd::correlate(nstd::strided_view<const float, 2>(in.data(), extents), nstd::strided_view<float, 2>(direct.data(), extents),
+	                nstd::strided_view<const float, 2>(kernel2d.data(), k11));
+	nstd::gaussian_filter(nstd::strided_view<const float, 2>(in.data(), extents), nstd::strided_view<float, 2>(passes.data(), extents), 1.5);
+	check_close(direct, passes, 1e-6f);
+	check_close(direct, reference(in, extents, kernel2d, k11, false, nstd::clamp_boundary{}), 1e-5f);
+
+	// a kernel of { 1 } leaves its dimension alone
+	const std::vector<float> one = { 1.0f }, diff = { -1.0f, 0.0f, 1.0f };
+	const std::span<const float> kernels[] = { one, diff };
+	nstd::separable_filter(nstd::strided_view<const float, 2>(in.data(), extents), nstd::strided_view<float, 2>(passes.data(), extents), kernels,
+	                       nstd::constant_boundary<float>{});
+	const size_t k13[] = { 1, 3 };
+	check_close(passes, reference(in, extents, diff, k13, false, nstd::constant_boundary<float>{}), 1e-6f);
+}
+
+TEST_CASE("box filter is a running mean for any radius") {
+	using namespace test_convolve;
+	const size_t extents[] = { 7, 13, 29 };
+	const auto in = random_grid<double>(volume(extents));
+	std::vector<double> out(in.size());
+	auto check = [&](size_t radius, const auto &boundary) {
+		const size_t width = 2 * radius + 1, kernel_extents[] = { width, width, width };
+		const std::vector<double> kernel(width * width * width, 1.0 / static_cast<double>(width * width * width));
+		nstd::box_filter(nstd::strided_view<const double, 3>(in.data(), extents), nstd::strided_view<double, 3>(out.data(), extents), radius,
+		                 boundary);
+		check_close(out, reference(in, extents, kernel, kernel_extents, false, boundary), 1e-12);
+	};
+	for (size_t radius : { 0, 1, 2, 6, 15 }) {
+		check(radius, nstd::clamp_boundary{});
+		check(radius, nstd::wrap_boundary{});
+		check(radius, nstd::constant_boundary<double>{ 0.5 });
+	}
+
+	// float grids accumulate in double: a long constant run stays exact
+	auto flat = std::make_unique<nstd::ndarray<float, 4, 4096>>();
+	auto mean = std::make_unique<nstd::ndarray<float, 4, 4096>>();
+	flat->fill(0.1f);
+	nstd::box_filter(*flat, *mean, 100);
+	for (size_t j = 0; j < 4096; j++) {
+		CHECK_EQ((*mean)[3][j], 0.1f);
+	}
+}
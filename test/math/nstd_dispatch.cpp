@@ -0,0 +1,342 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/linalg/nstd_dmatrix.h>
+#include <math/nstd_dispatch.h>
+#include <util/nstd_cpu.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test_dispatch {
+
+constexpr nstd::isa all_isas[] = { nstd::isa::scalar, nstd::isa::sse2, nstd::isa::avx2, nstd::isa::avx512 };
+
+template<typename Ty>
+std::vector<Ty> random_vector(size_t n, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+// max |a - b| relative to max |b|
+template<typename Ty>
+Ty relative_error(const std::vector<Ty> &a, const std::vector<Ty> &b) {
+	Ty err = 0, peak = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		err = std::max(err, std::abs(a[i] - b[i]));
+		peak = std::max(peak, std::abs(b[i]));
+	}
+	return peak == 0 ? err : err / peak;
+}
+
+// the gemm entry of a table, with the workspace the dispatch:: wrapper would provide
+template<typename Ty>
+void table_gemm(const nstd::kernel_set<Ty> &set, size_t m, size_t n, size_t k, Ty alpha, const Ty *a, const Ty *b, Ty beta, Ty *c) {
+	std::vector<Ty> pack_a(set._PackA), pack_b(set._PackB);
+	set._Gemm(m, n, k, alpha, a, k, b, n, beta, c, n, pack_a.data(), pack_b.data());
+}
+
+// every kernel of target against the scalar table, on sizes that leave vector and micro-tile remainders
+template<typename Ty>
+void compare_with_scalar(nstd::isa target, Ty tolerance) {
+	const nstd::kernel_set<Ty> &ref = nstd::kernels_for(nstd::isa::scalar)->get<Ty>();
+	const nstd::kernel_set<Ty> &set = nstd::kernels_for(target)->get<Ty>();
+
+	for (size_t n : { 0, 1, 3, 7, 8, 15, 16, 17, 63, 64, 129, 1000 }) {
+		const auto x = random_vector<Ty>(n, 1), y = random_vector<Ty>(n, 2);
+		const Ty scale = static_cast<Ty>(n + 1);
+		CHECK(std::abs(set._Sum(n, x.data()) - ref._Sum(n, x.data())) <= tolerance * scale);
+		CHECK(std::abs(set._Dot(n, x.data(), y.data()) - ref._Dot(n, x.data(), y.data())) <= tolerance * scale);
+
+		auto y0 = y, y1 = y;
+		set._Axpy(n, Ty(0.75), x.data(), y0.data());
+		ref._Axpy(n, Ty(0.75), x.data(), y1.data());
+		CHECK(relative_error(y0, y1) <= tolerance);
+
+		set._Scal(n, Ty(-1.5), y0.data());
+		ref._Scal(n, Ty(-1.5), y1.data());
+		CHECK(relative_error(y0, y1) <= tolerance);
+		set._Scal(n, Ty(0), y0.data());
+		for (Ty v : y0) {
+			CHECK_EQ(v, Ty(0));
+		}
+	}
+
+	for (auto [m, n, k] : { std::array<size_t, 3>{ 1, 1, 1 }, { 5, 7, 3 }, { 17, 33, 65 }, { 64, 64, 64 }, { 130, 70, 300 }, { 3, 513, 9 } }) {
+		const auto a = random_vector<Ty>(m * k, 3), b = random_vector<Ty>(k * n, 4), c = random_vector<Ty>(m * n, 5);
+		auto c0 = c, c1 = c;
+		table_gemm(set, m, n, k, Ty(1.25), a.data(), b.data(), Ty(-0.5), c0.data());
+		table_gemm(ref, m, n, k, Ty(1.25), a.data(), b.data(), Ty(-0.5), c1.data());
+		CHECK(relative_error(c0, c1) <= tolerance * static_cast<Ty>(k));
+		// beta == 0 overwrites, even NaN
+		c0.assign(m * n, std::numeric_limits<Ty>::quiet_NaN());
+		c1.assign(m * n, Ty(0));
+		table_gemm(set, m, n, k, Ty(1), a.data(), b.data(), Ty(0), c0.data());
+		table_gemm(ref, m, n, k, Ty(1), a.data(), b.data(), Ty(0), c1.data());
+		CHECK(relative_error(c0, c1) <= tolerance * static_cast<Ty>(k));
+	}
+}
+
+template<typename Ty>
+std::vector<Ty> random_ints(size_t n, unsigned seed, int lo, int hi) {
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<int> dist(lo, hi);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = static_cast<Ty>(dist(engine));
+	}
+	return res;
+}
+
+// the exact sum, wrapped or clamped into int32 the way the widening kernels finish it
+std::int32_t finish(long long sum, bool saturate) {
+	if (saturate) {
+		return static_cast<std::int32_t>(std::clamp<long long>(sum, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()));
+	}
+	return static_cast<std::int32_t>(static_cast<std::uint32_t>(sum));
+}
+
+template<typename Ty>
+std::vector<std::int32_t> reference_widening_gemm(size_t m, size_t n, size_t k, const std::vector<Ty> &a, const std::vector<Ty> &b, bool saturate) {
+	std::vector<std::int32_t> res(m * n);
+	for (size_t i = 0; i < m; i++) {
+		for (size_t j = 0; j < n; j++) {
+			long long sum = 0;
+			for (size_t p = 0; p < k; p++) {
+				sum += static_cast<long long>(a[i * k + p]) * b[p * n + j];
+			}
+			res[i * n + j] = finish(sum, saturate);
+		}
+	}
+	return res;
+}
+
+// the widening kernels of target against exact sums, integer results have to match bit for bit
+template<typename Ty>
+void check_widening(nstd::isa target, int lo, int hi) {
+	const nstd::widening_kernel_set &set = nstd::kernels_for(target)->_Widening;
+	const auto dot = [&](size_t n, const Ty *x, const Ty *y, bool saturate) {
+		if constexpr (std::is_same_v<Ty, std::int8_t>) {
+			return set._DotI8(n, x, y, saturate);
+		} else {
+			return set._DotI16(n, x, y, saturate);
+		}
+	};
+	const auto gemm = [&](size_t m, size_t n, size_t k, const Ty *a, const Ty *b, std::int32_t *c, bool saturate) {
+		std::vector<std::int32_t> pack_a(nstd::linalg::widening_pack_a_size(m, k, set._Mr));
+		std::vector<std::int16_t> pack_b(nstd::linalg::widening_pack_b_size(k, set._Nr));
+		if constexpr (std::is_same_v<Ty, std::int8_t>) {
+			set._GemmI8(m, n, k, a, k, b, n, c, n, saturate, pack_a.data(), pack_b.data());
+		} else {
+			set._GemmI16(m, n, k, a, k, b, n, c, n, saturate, pack_a.data(), pack_b.data());
+		}
+	};
+
+	for (bool saturate : { false, true }) {
+		CAPTURE(saturate);
+		for (size_t n : { 0, 1, 2, 3, 15, 16, 17, 31, 33, 64, 65, 1001 }) {
+			const auto x = random_ints<Ty>(n, 1, lo, hi), y = random_ints<Ty>(n, 2, lo, hi);
+			long long sum = 0;
+			for (size_t i = 0; i < n; i++) {
+				sum += static_cast<long long>(x[i]) * y[i];
+			}
+			CHECK_EQ(dot(n, x.data(), y.data(), saturate), finish(sum, saturate));
+		}
+		for (auto [m, n, k] : { std::array<size_t, 3>{ 1, 1, 1 }, { 5, 7, 3 }, { 7, 33, 64 }, { 13, 65, 129 }, { 64, 48, 1 }, { 2, 100, 300 } }) {
+			const auto a = random_ints<Ty>(m * k, 3, lo, hi), b = random_ints<Ty>(k * n, 4, lo, hi);
+			std::vector<std::int32_t> c(m * n, -1);
+			gemm(m, n, k, a.data(), b.data(), c.data(), saturate);
+			CHECK(c == reference_widening_gemm(m, n, k, a, b, saturate));
+		}
+	}
+}
+
+}  // namespace test_dispatch
+
+TEST_CASE("cpu features are consistent") {
+	const nstd::cpu_features &cpu = nstd::cpu_info();
+	CHECK(&cpu == &nstd::cpu_info());
+	CHECK((!cpu._Avx2 || cpu._Avx));
+	CHECK((!cpu._Fma || cpu._Avx));
+	CHECK((!cpu._Avx512bw || cpu._Avx512f));
+	CHECK((!cpu._Avx512vnni || cpu._Avx512f));
+	CHECK(nstd::cpu_supports(nstd::isa::scalar));
+	CHECK((!nstd::cpu_supports(nstd::isa::avx512) || nstd::cpu_supports(nstd::isa::avx2)));
+	CHECK_EQ(std::string(nstd::isa_name(nstd::isa::avx2)), "avx2");
+}
+
+TEST_CASE("every available kernel table matches the scalar one") {
+	using namespace test_dispatch;
+	REQUIRE(nstd::kernels_for(nstd::isa::scalar) != nullptr);
+	for (nstd::isa target : all_isas) {
+		const nstd::kernel_table *table = nstd::kernels_for(target);
+		if (table == nullptr) {
+			CHECK_THROWS_AS(nstd::select_kernels(target), std::runtime_error);
+			continue;
+		}
+		CAPTURE(nstd::isa_name(target));
+		CHECK(nstd::cpu_supports(target));
+		CHECK_EQ(table->_Isa, target);
+		compare_with_scalar<float>(target, 1e-5f);
+		compare_with_scalar<double>(target, 1e-13);
+	}
+}
+
+TEST_CASE("forcing each table reroutes the dispatch:: calls") {
+	using namespace test_dispatch;
+	const nstd::isa initial = nstd::kernels()._Isa;
+	CHECK(nstd::kernels_for(initial) == &nstd::kernels());
+
+	nstd::linalg::dmatrix<double> a(37, 29), b(29, 41);
+	const auto va = random_vector<double>(a.size(), 6), vb = random_vector<double>(b.size(), 7);
+	std::copy(va.begin(), va.end(), a.data());
+	std::copy(vb.begin(), vb.end(), b.data());
+	std::vector<double> expected(37 * 41, 0.0);
+	for (size_t i = 0; i < 37; i++) {
+		for (size_t j = 0; j < 41; j++) {
+			for (size_t p = 0; p < 29; p++) {
+				expected[i * 41 + j] += va[i * 29 + p] * vb[p * 41 + j];
+			}
+		}
+	}
+
+	nstd::ndarray<float, 9, 13> x, y;
+	for (size_t i = 0; i < x.arr_size; i++) {
+		x.data()[i] = static_cast<float>(i % 5);
+		y.data()[i] = 1.0f;
+	}
+
+	for (nstd::isa target : all_isas) {
+		if (nstd::kernels_for(target) == nullptr) {
+			continue;
+		}
+		CAPTURE(nstd::isa_name(target));
+		nstd::select_kernels(target);
+		CHECK_EQ(nstd::kernels()._Isa, target);
+
+		const auto c = a * b;
+		CHECK(relative_error(std::vector<double>(c.data(), c.data() + c.size()), expected) < 1e-13);
+
+		CHECK_EQ(nstd::dispatch::sum(x), 231.0f);
+		CHECK_EQ(nstd::dispatch::dot(x, y), 231.0f);
+		auto z = y;
+		nstd::dispatch::axpy(2.0f, x, z);
+		nstd::dispatch::scal(0.5f, z);
+		CHECK_EQ(nstd::dispatch::sum(z), 0.5f * (2.0f * 231.0f + 117.0f));
+
+		// element types without tables take the compile-time kernels
+		const int ints[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		CHECK_EQ(nstd::dispatch::sum(9, ints), 45);
+		CHECK_EQ(nstd::dispatch::dot(9, ints, ints), 285);
+	}
+	nstd::select_kernels(initial);
+}
+
+TEST_CASE("gemm tiles split over a pool match the serial product") {
+	using namespace test_dispatch;
+	nstd::thread_pool pool(4);
+
+	// every element of c lands in exactly one tile, for shapes with partial micro tiles
+	for (auto [m, n] : { std::array<size_t, 2>{ 1, 1 }, { 7, 5 }, { 97, 1000 }, { 1000, 13 }, { 401, 403 } }) {
+		std::vector<int> hits(m * n, 0);
+		nstd::internal::gemm_tiles<float>(m, n, pool, [&](size_t i0, size_t i1, size_t j0, size_t j1) {
+			for (size_t i = i0; i < i1; i++) {
+				for (size_t j = j0; j < j1; j++) {
+					hits[i * n + j]++;
+				}
+			}
+		});
+		CHECK(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+	}
+
+	// large enough to take the parallel path, beta == 0 on a NaN-filled (never read) c
+	constexpr size_t m = 203, n = 157, k = 131;
+	const auto a = random_vector<double>(m * k, 8), b = random_vector<double>(k * n, 9);
+	std::vector<double> serial(m * n), parallel(m * n, std::numeric_limits<double>::quiet_NaN());
+	nstd::thread_pool single(1);
+	nstd::dispatch::gemm(m, n, k, 1.0, a.data(), k, b.data(), n, 0.0, serial.data(), n, single);
+	nstd::dispatch::gemm(m, n, k, 1.0, a.data(), k, b.data(), n, 0.0, parallel.data(), n, pool);
+	CHECK(relative_error(parallel, serial) < 1e-13);
+	// beta != 0 and element types without tables
+	nstd::dispatch::gemm(m, n, k, 0.5, a.data(), k, b.data(), n, 2.0, serial.data(), n, single);
+	nstd::dispatch::gemm(m, n, k, 0.5, a.data(), k, b.data(), n, 2.0, parallel.data(), n, pool);
+	CHECK(relative_error(parallel, serial) < 1e-13);
+
+	std::vector<long long> ia(m * k), ib(k * n), ic0(m * n), ic1(m * n);
+	for (size_t i = 0; i < ia.size(); i++) {
+		ia[i] = static_cast<long long>(i % 7) - 3;
+	}
+	for (size_t i = 0; i < ib.size(); i++) {
+		ib[i] = static_cast<long long>(i % 5) - 2;
+	}
+	nstd::dispatch::gemm(m, n, k, 1LL, ia.data(), k, ib.data(), n, 0LL, ic0.data(), n, single);
+	nstd::dispatch::gemm(m, n, k, 1LL, ia.data(), k, ib.data(), n, 0LL, ic1.data(), n, pool);
+	CHECK(ic0 == ic1);
+}
+
+TEST_CASE("widening kernels are exact in every table") {
+	using namespace test_dispatch;
+	for (nstd::isa target : all_isas) {
+		if (nstd::kernels_for(target) == nullptr) {
+			continue;
+		}
+		CAPTURE(nstd::isa_name(target));
+		check_widening<std::int8_t>(target, -128, 127);
+		check_widening<std::int16_t>(target, -32767, 32767);  // large enough for the int32 sums to overflow
+		// the tables built from the same simd_i16 width share their blocking
+		CHECK(nstd::kernels_for(target)->_Widening._Nr % 4 == 0);
+	}
+	const nstd::kernel_table *avx512 = nstd::kernels_for(nstd::isa::avx512);
+	CHECK((avx512 == nullptr || avx512->_Widening._Vnni == nstd::cpu_info()._Avx512vnni));
+}
+
+TEST_CASE("widening gemm saturates and splits over a pool") {
+	using namespace test_dispatch;
+	// every product is 32767^2, so any k > 2 leaves int32
+	constexpr size_t m = 3, n = 5, k = 4;
+	std::vector<std::int16_t> a(m * k, 32767), b(k * n, 32767);
+	b[n - 1] = -32767;  // one column sums to 2 * 32767^2
+	std::int32_t c[m * n];
+	nstd::dispatch::widening_gemm(m, n, k, a.data(), k, b.data(), n, c, n, true);
+	CHECK_EQ(c[0], std::numeric_limits<std::int32_t>::max());
+	CHECK_EQ(c[n - 1], 2 * 32767 * 32767);
+	nstd::dispatch::widening_gemm(m, n, k, a.data(), k, b.data(), n, c, n);
+	CHECK_EQ(c[0], finish(4LL * 32767 * 32767, false));
+	CHECK_EQ(nstd::dispatch::widening_dot(k, a.data(), b.data(), true), std::numeric_limits<std::int32_t>::max());
+
+	nstd::ndarray<std::int8_t, 3, 4> x;
+	nstd::ndarray<std::int8_t, 4, 2> y;
+	nstd::ndarray<std::int32_t, 3, 2> z;
+	for (size_t i = 0; i < x.arr_size; i++) {
+		x.data()[i] = static_cast<std::int8_t>(i) - 6;
+	}
+	for (size_t i = 0; i < y.arr_size; i++) {
+		y.data()[i] = static_cast<std::int8_t>(-128 + static_cast<int>(i));
+	}
+	nstd::dispatch::widening_gemm(x, y, z);
+	CHECK_EQ(z[2][1], 2 * -127 + 3 * -125 + 4 * -123 + 5 * -121);
+	CHECK_EQ(nstd::dispatch::widening_dot(x, x), 2 * (25 + 16 + 9 + 4 + 1) + 36);
+
+	// large enough to take the parallel path
+	constexpr size_t pm = 203, pn = 157, pk = 131;
+	const auto pa = random_ints<std::int8_t>(pm * pk, 5, -128, 127), pb = random_ints<std::int8_t>(pk * pn, 6, -128, 127);
+	std::vector<std::int32_t> parallel(pm * pn);
+	nstd::thread_pool pool(4);
+	nstd::dispatch::widening_gemm(pm, pn, pk, pa.data(), pk, pb.data(), pn, parallel.data(), pn, false, pool);
+	CHECK(parallel == reference_widening_gemm(pm, pn, pk, pa, pb, false));
+}
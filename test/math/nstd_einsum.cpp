@@ -0,0 +1,144 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_einsum.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+namespace test_einsum {
+
+template<typename Arr>
+std::unique_ptr<Arr> random_array(unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<double> dist(-1, 1);
+	auto res = std::make_unique<Arr>();
+	for (auto &v : *res) {
+		v = static_cast<typename Arr::value_type>(dist(engine));
+	}
+	return res;
+}
+
+template<typename Arr>
+bool approx_equal(const Arr &lhs, const Arr &rhs, double tolerance) {
+	for (size_t i = 0; i < Arr::arr_size; i++) {
+		if (std::abs(static_cast<double>(lhs.data()[i] - rhs.data()[i])) > tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace test_einsum
+
+TEST_CASE("subscripts are parsed at compile time") {
+	using nstd::internal::einsum_route;
+	constexpr auto expr = nstd::internal::parse_einsum(nstd::einsum_subscripts("ij, jk -> ik"));
+	static_assert(expr._Operands == 2 && expr._Inputs[0]._Rank == 2 && expr._Output._Labels[1] == 'k');
+	// implicit output: the labels used once, sorted
+	constexpr auto implicit = nstd::internal::parse_einsum(nstd::einsum_subscripts("kj,ji"));
+	static_assert(implicit._Output._Rank == 2 && implicit._Output._Labels[0] == 'i' && implicit._Output._Labels[1] == 'k');
+
+	using m34 = nstd::ndarray<float, 3, 4>;
+	using m45 = nstd::ndarray<float, 4, 5>;
+	using m54 = nstd::ndarray<float, 5, 4>;
+	static_assert(nstd::internal::make_einsum_plan<"ij,jk->ik", m34, m45>()._Route == einsum_route::gemm);
+	static_assert(nstd::internal::make_einsum_plan<"jk,ij->ik", m45, m34>()._Swap);
+	static_assert(nstd::internal::make_einsum_plan<"ij,kj->ik", m34, m54>()._Route == einsum_route::loops);
+	static_assert(nstd::internal::make_einsum_plan<"ij,j->i", m34, nstd::ndarray<float, 4>>()._Route == einsum_route::gemv);
+	static_assert(nstd::internal::make_einsum_plan<"i,ij->j", nstd::ndarray<float, 3>, m34>()._Route == einsum_route::gemv_t);
+	// a * b^T: j has stride 1 in both operands and becomes the innermost (register-accumulated) loop
+	constexpr auto plan = nstd::internal::make_einsum_plan<"ij,kj->ik", m34, m54>();
+	static_assert(plan._Label[plan._Order[0]] == 'i' && plan._Label[plan._Order[1]] == 'k' && plan._Label[plan._Order[2]] == 'j');
+	static_assert(std::is_same_v<decltype(nstd::einsum<"ij,jk">(std::declval<m34>(), std::declval<m45>())), nstd::ndarray<float, 3, 5>>);
+	static_assert(std::is_same_v<decltype(nstd::einsum<"ii">(std::declval<nstd::ndarray<int, 3, 3>>())), int>);
+}
+
+TEST_CASE("contractions match the loop definitions") {
+	using namespace test_einsum;
+	constexpr size_t B = 3, I = 17, J = 23, K = 9;
+
+	// batched matrix product, routed to gemm
+	const auto a = random_array<nstd::ndarray<double, B, I, J>>(1);
+	const auto b = random_array<nstd::ndarray<double, B, J, K>>(2);
+	auto expected = std::make_unique<nstd::ndarray<double, B, I, K>>();
+	for (size_t n = 0; n < B; n++) {
+		for (size_t i = 0; i < I; i++) {
+			for (size_t k = 0; k < K; k++) {
+				for (size_t j = 0; j < J; j++) {
+					(*expected)[n][i][k] += (*a)[n][i][j] * (*b)[n][j][k];
+				}
+			}
+		}
+	}
+	auto c = std::make_unique<nstd::ndarray<double, B, I, K>>();
+	c->fill(42.0);
+	nstd::einsum<"bij,bjk->bik">(*a, *b, *c);
+	CHECK(approx_equal(*c, *expected, 1e-12));
+	CHECK(approx_equal(nstd::einsum<"bjk,bij->bik">(*b, *a), *expected, 1e-12));
+
+	// the same product, operands and output in an order gemm cannot take
+	const auto bt = random_array<nstd::ndarray<double, B, K, J>>(3);
+	auto expected_t = std::make_unique<nstd::ndarray<double, K, B, I>>();
+	for (size_t n = 0; n < B; n++) {
+		for (size_t i = 0; i < I; i++) {
+			for (size_t k = 0; k < K; k++) {
+				for (size_t j = 0; j < J; j++) {
+					(*expected_t)[k][n][i] += (*a)[n][i][j] * (*bt)[n][k][j];
+				}
+			}
+		}
+	}
+	CHECK(approx_equal(nstd::einsum<"bij,bkj->kbi">(*a, *bt), *expected_t, 1e-12));
+
+	// ijk,k->ij (gemv) and its transpose k,kij->ij (gemv_t)
+	const auto v = random_array<nstd::ndarray<double, J>>(4);
+	nstd::ndarray<double, B, I> w{}, w_t{};
+	for (size_t n = 0; n < B; n++) {
+		for (size_t i = 0; i < I; i++) {
+			for (size_t j = 0; j < J; j++) {
+				w[n][i] += (*a)[n][i][j] * (*v)[j];
+			}
+		}
+	}
+	CHECK(approx_equal(nstd::einsum<"ijk,k->ij">(*a, *v), w, 1e-12));
+	const auto at = random_array<nstd::ndarray<double, J, B, I>>(5);
+	for (size_t j = 0; j < J; j++) {
+		for (size_t n = 0; n < B; n++) {
+			for (size_t i = 0; i < I; i++) {
+				w_t[n][i] += (*v)[j] * (*at)[j][n][i];
+			}
+		}
+	}
+	CHECK(approx_equal(nstd::einsum<"k,kij->ij">(*v, *at), w_t, 1e-12));
+}
+
+TEST_CASE("diagonals, sums, outer products and transposes") {
+	nstd::ndarray<int, 4, 4> m;
+	nstd::ndarray<int, 4> x;
+	for (size_t i = 0; i < 4; i++) {
+		x[i] = static_cast<int>(i + 1);
+		for (size_t j = 0; j < 4; j++) {
+			m[i][j] = static_cast<int>(10 * i + j);
+		}
+	}
+	CHECK_EQ(nstd::einsum<"ii">(m), 0 + 11 + 22 + 33);
+	CHECK_EQ(nstd::einsum<"ij->">(m), 6 * 4 + 40 * 6);
+	CHECK_EQ(nstd::einsum<"i,i">(x, x), 30);
+	const auto diag = nstd::einsum<"ii->i">(m);
+	CHECK_EQ(diag[3], 33);
+	const auto t = nstd::einsum<"ij->ji">(m);
+	CHECK_EQ(t[1][3], 31);
+	const auto rows = nstd::einsum<"ij->i">(m);
+	CHECK_EQ(rows[2], 4 * 20 + 6);
+	const auto outer = nstd::einsum<"i,j->ij">(x, x);
+	CHECK_EQ(outer[2][3], 12);
+	const auto mv = nstd::einsum<"ij,j->i">(m, x);
+	CHECK_EQ(mv[1], 10 * 1 + 11 * 2 + 12 * 3 + 13 * 4);
+	const auto summed = nstd::einsum<"ij,k->i">(m, x);
+	CHECK_EQ(summed[0], 6 * 10);
+}
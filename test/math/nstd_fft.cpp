@@ -0,0 +1,186 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_fft.h>
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_fft {
+
+template<typename Ty>
+std::vector<std::complex<Ty>> random_signal(size_t n) {
+	std::mt19937_64 engine(n);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<std::complex<Ty>> res(n);
+	for (auto &v : res) {
+		v = { dist(engine), dist(engine) };
+	}
+	return res;
+}
+
+// the O(n^2) definition, accumulated in long double
+template<typename Ty>
+std::vector<std::complex<Ty>> naive_dft(const std::vector<std::complex<Ty>> &x, bool inverse = false) {
+	const size_t n = x.size();
+	std::vector<std::complex<Ty>> res(n);
+	for (size_t k = 0; k < n; k++) {
+		std::complex<long double> acc = 0;
+		for (size_t j = 0; j < n; j++) {
+			const long double angle = (inverse ? 2.0L : -2.0L) * std::numbers::pi_v<long double> * static_cast<long double>(j * k % n) /
+			                          static_cast<long double>(n);
+			acc += std::complex<long double>(x[j]) * std::polar(1.0L, angle);
+		}
+		res[k] = std::complex<Ty>(inverse ? acc / static_cast<long double>(n) : acc);
+	}
+	return res;
+}
+
+// max |a - b| relative to max |b|
+template<typename Ty>
+Ty relative_error(const std::complex<Ty> *a, const std::complex<Ty> *b, size_t n) {
+	Ty err = 0, peak = 0;
+	for (size_t i = 0; i < n; i++) {
+		err = std::max(err, std::abs(a[i] - b[i]));
+		peak = std::max(peak, std::abs(b[i]));
+	}
+	return peak == 0 ? err : err / peak;
+}
+
+}  // namespace test_fft
+
+TEST_CASE("complex transforms of mixed-radix sizes match the naive DFT") {
+	using namespace test_fft;
+	for (size_t n : { 1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 30, 49, 59, 64, 67, 97, 100, 134, 210, 243, 256, 1000, 1009, 1024, 2048 }) {
+		const auto x = random_signal<double>(n);
+		const auto expected = naive_dft(x);
+		nstd::fft_plan<double> plan(n);
+		std::vector<std::complex<double>> y(n), back(n);
+		plan.forward(x.data(), y.data());
+		CHECK(relative_error(y.data(), expected.data(), n) < 1e-13);
+		plan.inverse(y.data(), back.data());
+		CHECK(relative_error(back.data(), x.data(), n) < 1e-13);
+
+		// in place, single precision
+		auto xf = random_signal<float>(n);
+		const auto expected_f = naive_dft(xf);
+		nstd::fft_plan<float> plan_f(n);
+		plan_f.forward(xf.data(), xf.data());
+		CHECK(relative_error(xf.data(), expected_f.data(), n) < 1e-5f);
+	}
+	CHECK_THROWS_AS(nstd::fft_plan<float>(0), std::runtime_error);
+}
+
+TEST_CASE("strided execute with a caller-owned work buffer") {
+	using namespace test_fft;
+	const size_t n = 60;
+	const auto x = random_signal<double>(n);
+	const auto expected = naive_dft(x);
+	const nstd::fft_plan<double> plan(n);
+	std::vector<double> work(plan.work_size());
+
+	// every third element of a longer buffer, written back reversed
+	std::vector<std::complex<double>> in(3 * n), out(2 * n);
+	for (size_t i = 0; i < n; i++) {
+		in[3 * i] = x[i];
+	}
+	plan.execute(in.data(), 3, out.data() + 2 * n - 2, -2, false, work.data());
+	for (size_t k = 0; k < n; k++) {
+		CHECK(std::abs(out[2 * n - 2 - 2 * k] - expected[k]) < 1e-12);
+	}
+}
+
+TEST_CASE("real transforms keep the non-redundant half") {
+	using namespace test_fft;
+	for (size_t n : { 1, 2, 3, 4, 6, 9, 10, 16, 17, 64, 90, 262, 1000, 1024 }) {
+		std::vector<double> x(n);
+		std::vector<std::complex<double>> cx(n);
+		std::mt19937_64 engine(n);
+		std::uniform_real_distribution<double> dist(-1, 1);
+		for (size_t i = 0; i < n; i++) {
+			x[i] = dist(engine);
+			cx[i] = x[i];
+		}
+		const auto expected = naive_dft(cx);
+
+		nstd::rfft_plan<double> plan(n);
+		REQUIRE_EQ(plan.bins(), n / 2 + 1);
+		std::vector<std::complex<double>> spectrum(plan.bins());
+		plan.forward(x.data(), spectrum.data());
+		CHECK(relative_error(spectrum.data(), expected.data(), plan.bins()) < 1e-13);
+
+		std::vector<double> back(n);
+		plan.inverse(spectrum.data(), back.data());
+		for (size_t i = 0; i < n; i++) {
+			CHECK(std::abs(back[i] - x[i]) < 1e-13);
+		}
+	}
+}
+
+TEST_CASE("multi-dimensional transforms, serial and threaded") {
+	using namespace test_fft;
+	// the 2-D DFT is the 1-D DFT of every row, then of every column
+	constexpr size_t rows = 12, cols = 20;
+	auto arr = std::make_unique<nstd::ndarray<std::complex<double>, rows, cols>>();
+	const auto x = random_signal<double>(rows * cols);
+	std::copy(x.begin(), x.end(), arr->data());
+	std::vector<std::complex<double>> expected(rows * cols);
+	for (size_t i = 0; i < rows; i++) {
+		const auto row = naive_dft(std::vector<std::complex<double>>(x.begin() + i * cols, x.begin() + (i + 1) * cols));
+		std::copy(row.begin(), row.end(), expected.begin() + i * cols);
+	}
+	for (size_t j = 0; j < cols; j++) {
+		std::vector<std::complex<double>> column(rows);
+		for (size_t i = 0; i < rows; i++) {
+			column[i] = expected[i * cols + j];
+		}
+		column = naive_dft(column);
+		for (size_t i = 0; i < rows; i++) {
+			expected[i * cols + j] = column[i];
+		}
+	}
+
+	nstd::fft(*arr);
+	CHECK(relative_error(arr->data(), expected.data(), rows * cols) < 1e-13);
+	nstd::ifft(*arr);
+	CHECK(relative_error(arr->data(), x.data(), rows * cols) < 1e-13);
+
+	nstd::thread_pool pool(4);
+	const nstd::fftn_plan<double, 2> plan({ rows, cols });
+	plan.forward(*arr, &pool);
+	CHECK(relative_error(arr->data(), expected.data(), rows * cols) < 1e-13);
+
+	// a real 3-D grid against the complex transform of the same data
+	constexpr size_t a = 6, b = 10, c = 16;
+	const size_t extents[] = { a, b, c }, half[] = { a, b, c / 2 + 1 };
+	std::vector<double> real(a * b * c);
+	std::vector<std::complex<double>> full(a * b * c), spectrum(a * b * (c / 2 + 1));
+	for (size_t i = 0; i < real.size(); i++) {
+		real[i] = std::sin(0.37 * static_cast<double>(i)) + 0.01 * static_cast<double>(i % 7);
+		full[i] = real[i];
+	}
+	nstd::fftn_plan<double, 3>(extents).forward(nstd::strided_view<std::complex<double>, 3>(full.data(), extents), &pool);
+	const nstd::rfftn_plan<double, 3> rplan(extents);
+	CHECK_EQ(rplan.bins(), c / 2 + 1);
+	rplan.forward(nstd::strided_view<const double, 3>(real.data(), extents), nstd::strided_view<std::complex<double>, 3>(spectrum.data(), half), &pool);
+	for (size_t i = 0; i < a * b; i++) {
+		CHECK(relative_error(spectrum.data() + i * (c / 2 + 1), full.data() + i * c, c / 2 + 1) < 1e-12);
+	}
+	std::vector<double> back(real.size());
+	rplan.inverse(nstd::strided_view<std::complex<double>, 3>(spectrum.data(), half), nstd::strided_view<double, 3>(back.data(), extents));
+	for (size_t i = 0; i < real.size(); i++) {
+		CHECK(std::abs(back[i] - real[i]) < 1e-12);
+	}
+
+	CHECK_THROWS_AS(rplan.forward(nstd::strided_view<const double, 3>(real.data(), extents),
+	                              nstd::strided_view<std::complex<double>, 3>(full.data(), extents)),
+	                std::runtime_error);
+}
@@ -0,0 +1,95 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/linalg/nstd_matrix.h>
+#include <math/nstd_fixed.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("saturating integer arithmetic") {
+	using i8 = std::int8_t;
+	using u8 = std::uint8_t;
+	static_assert(nstd::add_sat<i8>(100, 100) == 127);
+	static_assert(nstd::add_sat<i8>(-100, -100) == -128);
+	static_assert(nstd::add_sat<i8>(-100, 100) == 0);
+	static_assert(nstd::sub_sat<i8>(-100, 100) == -128);
+	static_assert(nstd::sub_sat<i8>(100, -100) == 127);
+	static_assert(nstd::add_sat<u8>(200, 100) == 255);
+	static_assert(nstd::sub_sat<u8>(100, 200) == 0);
+	static_assert(nstd::mul_sat<i8>(-16, 9) == -128);
+	static_assert(nstd::mul_sat<i8>(-16, -9) == 127);
+	static_assert(nstd::mul_sat<long long>(std::numeric_limits<long long>::max() / 2, 3) == std::numeric_limits<long long>::max());
+	static_assert(nstd::mul_sat<long long>(std::numeric_limits<long long>::min() / 2, 3) == std::numeric_limits<long long>::min());
+	static_assert(nstd::mul_sat<long long>(-3, 5) == -15);
+	static_assert(nstd::div_sat<i8>(-128, -1) == 127);
+
+	static_assert(nstd::saturate_cast<i8>(300) == 127);
+	static_assert(nstd::saturate_cast<u8>(-1) == 0);
+	static_assert(nstd::saturate_cast<std::int32_t>(3000000000u) == std::numeric_limits<std::int32_t>::max());
+	static_assert(nstd::saturate_cast<std::int16_t>(-1e9) == -32768);
+	static_assert(nstd::saturate_cast<std::int16_t>(-2.75) == -2);
+	CHECK_EQ(nstd::saturate_cast<int>(std::numeric_limits<double>::quiet_NaN()), 0);
+}
+
+TEST_CASE("fixed-point rounding and saturation") {
+	using nstd::q15;
+	using nstd::q16_16;
+	using nstd::q8_8;
+
+	// conversions round to nearest, ties to even
+	CHECK_EQ(q8_8(1.0 / 512).raw(), 0);   // 0.5 ulp -> 0
+	CHECK_EQ(q8_8(3.0 / 512).raw(), 2);   // 1.5 ulp -> 2
+	CHECK_EQ(q8_8(-3.0 / 512).raw(), -2);
+	CHECK_EQ(q8_8(0.7 / 256).raw(), 1);
+	CHECK_EQ(q15(1.0).raw(), 32767);  // 1.0 is just outside q15
+	CHECK_EQ(q15(-1.0).raw(), -32768);
+	CHECK_EQ(q8_8(1000).raw(), 32767);
+	CHECK_EQ(q8_8(-3).raw(), -3 * 256);
+	CHECK_EQ(static_cast<int>(q8_8(-2.75)), -2);
+	CHECK_EQ(static_cast<double>(q16_16(-1.25)), -1.25);
+
+	// products and quotients round the same way
+	CHECK_EQ((q8_8::from_raw(3) * q8_8(0.5)).raw(), 2);  // 1.5 -> 2
+	CHECK_EQ((q8_8::from_raw(5) * q8_8(0.5)).raw(), 2);  // 2.5 -> 2
+	CHECK_EQ((q8_8::from_raw(-5) * q8_8(0.5)).raw(), -2);
+	CHECK_EQ((q8_8(1) / q8_8(3)).raw(), 85);   // 85.33
+	CHECK_EQ((q8_8(2) / q8_8(3)).raw(), 171);  // 170.67
+	CHECK_EQ((q8_8(-2) / q8_8(3)).raw(), -171);
+	CHECK_EQ((q8_8::from_raw(1) / q8_8(2)).raw(), 0);  // 0.5 -> 0
+	CHECK_EQ((q8_8::from_raw(3) / q8_8(2)).raw(), 2);  // 1.5 -> 2
+
+	// every operation saturates instead of wrapping
+	CHECK_EQ(q15(0.75) + q15(0.75), q15::max());
+	CHECK_EQ(q15(-0.75) - q15(0.75), q15::min());
+	CHECK_EQ(-q15::min(), q15::max());
+	CHECK_EQ(q15(-1.0) * q15(-1.0), q15::max());
+	CHECK_EQ(q8_8(100) * q8_8(100), q8_8::max());
+	CHECK_EQ(q8_8(1) / q8_8(), q8_8::max());
+	CHECK_EQ(q8_8(-1) / q8_8(), q8_8::min());
+	CHECK_EQ(q8_8() / q8_8(), q8_8());
+
+	q16_16 acc(0.0);
+	for (int i = 0; i < 10; i++) {
+		acc += q16_16(0.1);
+	}
+	CHECK(static_cast<double>(acc) - 1.0 < 1e-4);
+	static_assert(q16_16(2.5) * q16_16(4) == q16_16(10));
+	static_assert(q8_8(1.5) < q8_8(2));
+}
+
+TEST_CASE("fixed-point elements in matrix products") {
+	using nstd::q16_16;
+	using mat = nstd::linalg::matrix<q16_16, 2, 2, false>;
+	mat a, b;
+	a[0][0] = q16_16(0.5), a[0][1] = q16_16(-1.25);
+	a[1][0] = q16_16(2), a[1][1] = q16_16(0.75);
+	b[0][0] = q16_16(4), b[0][1] = q16_16(1);
+	b[1][0] = q16_16(0.5), b[1][1] = q16_16(-2);
+	const mat c = a * b;
+	CHECK_EQ(static_cast<double>(c[0][0]), 0.5 * 4 - 1.25 * 0.5);
+	CHECK_EQ(static_cast<double>(c[0][1]), 0.5 + 2.5);
+	CHECK_EQ(static_cast<double>(c[1][0]), 8 + 0.375);
+	CHECK_EQ(static_cast<double>(c[1][1]), 2 - 1.5);
+}
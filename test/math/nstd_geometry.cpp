@@ -0,0 +1,184 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <math/nstd_geometry.h>
+
+// TODO: REMOVE these deps in future versions
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace test_geometry {
+
+using nstd::linalg::vector3f;
+
+vector3f random_point(std::mt19937 &engine, float lo, float hi) {
+	std::uniform_real_distribution<float> dist(lo, hi);
+	const float x = dist(engine), y = dist(engine), z = dist(engine);
+	return vector3f(x, y, z);
+}
+
+std::vector<nstd::aabb> random_boxes(size_t n, unsigned seed) {
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> size(0.05f, 1.5f);
+	std::vector<nstd::aabb> res(n);
+	for (auto &box : res) {
+		box._Min = random_point(engine, -10.0f, 10.0f);
+		for (size_t a = 0; a < 3; a++) {
+			box._Max[a] = box._Min[a] + size(engine);
+		}
+	}
+	return res;
+}
+
+// one object at a time, the way the packets replace
+bool slab(const nstd::ray &r, const nstd::aabb &box) {
+	float near = r._TMin, far = r._TMax;
+	for (size_t a = 0; a < 3; a++) {
+		const float inv = 1.0f / r._Dir[a];
+		float t0 = (box._Min[a] - r._Origin[a]) * inv, t1 = (box._Max[a] - r._Origin[a]) * inv;
+		if (t0 > t1) {
+			std::swap(t0, t1);
+		}
+		near = std::max(near, t0);
+		far = std::min(far, t1);
+	}
+	return near <= far;
+}
+
+float plane_distance(const nstd::plane &p, const vector3f &v) {
+	return p._Normal[0] * v[0] + p._Normal[1] * v[1] + p._Normal[2] * v[2] + p._Dist;
+}
+
+bool box_visible(const nstd::frustum &f, const nstd::aabb &box) {
+	for (const nstd::plane &p : f._Planes) {
+		vector3f corner;
+		for (size_t a = 0; a < 3; a++) {
+			corner[a] = p._Normal[a] >= 0.0f ? box._Max[a] : box._Min[a];
+		}
+		if (plane_distance(p, corner) < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// perspective projection (OpenGL style, 90 degrees, near 1, far 100) looking down -z from the origin
+nstd::linalg::matrix4f perspective() {
+	constexpr float n = 1.0f, f = 100.0f;
+	nstd::linalg::matrix4f m(0.0f);
+	m.at(0, 0) = 1.0f;
+	m.at(1, 1) = 1.0f;
+	m.at(2, 2) = -(f + n) / (f - n);
+	m.at(2, 3) = -2.0f * f * n / (f - n);
+	m.at(3, 2) = -1.0f;
+	return m;
+}
+
+}  // namespace test_geometry
+
+TEST_CASE("ray against boxes and triangles") {
+	using namespace test_geometry;
+	for (size_t n : { 1, 5, 16, 17, 64, 65, 1000 }) {
+		const auto boxes = random_boxes(n, 1);
+		const nstd::aabb_packet packet(boxes.data(), n);
+		std::vector<std::uint64_t> mask(nstd::mask_words(n), ~0ull);
+		std::mt19937 engine(2);
+		for (int trial = 0; trial < 20; trial++) {
+			nstd::ray r{ random_point(engine, -12.0f, 12.0f), random_point(engine, -1.0f, 1.0f) };
+			r._TMax = trial % 2 == 0 ? 8.0f : r._TMax;
+			size_t expected = 0;
+			const size_t hits = nstd::intersect(r, packet, mask.data());
+			for (size_t i = 0; i < n; i++) {
+				CHECK_EQ(nstd::mask_test(mask.data(), i), slab(r, boxes[i]));
+				expected += slab(r, boxes[i]) ? 1 : 0;
+			}
+			CHECK_EQ(hits, expected);
+			if (n % 64 != 0) {
+				CHECK_EQ(mask.back() >> (n % 64), 0u);  // bits past n stay clear
+			}
+		}
+	}
+
+	// axis-aligned rays: the zero direction components divide to infinity
+	const nstd::aabb_packet unit(std::vector<nstd::aabb>{ { vector3f(0.0f, 0.0f, 0.0f), vector3f(1.0f, 1.0f, 1.0f) } }.data(), 1);
+	std::uint64_t mask = 0;
+	CHECK_EQ(nstd::intersect(nstd::ray{ vector3f(0.5f, 0.5f, -3.0f), vector3f(0.0f, 0.0f, 1.0f) }, unit, &mask), 1u);
+	CHECK_EQ(nstd::intersect(nstd::ray{ vector3f(1.5f, 0.5f, -3.0f), vector3f(0.0f, 0.0f, 1.0f) }, unit, &mask), 0u);
+	CHECK_EQ(nstd::intersect(nstd::ray{ vector3f(0.5f, 0.5f, -3.0f), vector3f(0.0f, 0.0f, -1.0f) }, unit, &mask), 0u);
+
+	// triangles in the plane z = 0 and z = 2, one parallel to the ray and one behind it
+	const vector3f vertices[] = {
+		vector3f(0.0f, 0.0f, 0.0f), vector3f(1.0f, 0.0f, 0.0f), vector3f(0.0f, 1.0f, 0.0f),
+		vector3f(0.0f, 0.0f, 2.0f), vector3f(0.0f, 1.0f, 2.0f), vector3f(1.0f, 0.0f, 2.0f),  // the other winding
+		vector3f(0.5f, 0.0f, 1.0f), vector3f(1.0f, 0.0f, 1.0f), vector3f(1.0f, 1.0f, 1.0f),  // misses at (0.25, 0.25)
+		vector3f(0.0f, 0.0f, 0.0f), vector3f(0.0f, 1.0f, 0.0f), vector3f(0.0f, 0.0f, 5.0f),  // contains the ray
+		vector3f(0.0f, 0.0f, -4.0f), vector3f(1.0f, 0.0f, -4.0f), vector3f(0.0f, 1.0f, -4.0f),
+	};
+	const nstd::triangle_packet tris(vertices, 5);
+	const nstd::ray r{ vector3f(0.25f, 0.25f, -1.0f), vector3f(0.0f, 0.0f, 1.0f) };
+	float t[5];
+	CHECK_EQ(nstd::intersect(r, tris, &mask, t), 2u);
+	CHECK_EQ(mask, 0b00011u);
+	CHECK_EQ(t[0], 1.0f);
+	CHECK_EQ(t[1], 3.0f);
+	CHECK_EQ(t[2], std::numeric_limits<float>::infinity());
+	CHECK_EQ(t[4], std::numeric_limits<float>::infinity());
+	CHECK_EQ(nstd::intersect(nstd::ray{ r._Origin, r._Dir, 0.0f, 2.0f }, tris, &mask), 1u);
+}
+
+TEST_CASE("frustum culling and point-in-box") {
+	using namespace test_geometry;
+	const nstd::frustum f = nstd::frustum::from_matrix(perspective());
+	// the near plane faces -z at distance 1, the left plane passes through the origin
+	CHECK(std::abs(plane_distance(f._Planes[4], vector3f(0.0f, 0.0f, -1.0f))) < 1e-5f);
+	CHECK(plane_distance(f._Planes[4], vector3f(0.0f, 0.0f, -2.0f)) > 0.0f);
+	CHECK(std::abs(f._Planes[0]._Dist) < 1e-6f);
+
+	const std::vector<nstd::aabb> fixed = {
+		{ vector3f(-1.0f, -1.0f, -6.0f), vector3f(1.0f, 1.0f, -4.0f) },    // inside
+		{ vector3f(-1.0f, -1.0f, 2.0f), vector3f(1.0f, 1.0f, 4.0f) },      // behind the camera
+		{ vector3f(20.0f, -1.0f, -6.0f), vector3f(22.0f, 1.0f, -4.0f) },   // right of it
+		{ vector3f(-1.0f, -1.0f, -200.0f), vector3f(1.0f, 1.0f, -90.0f) },  // across the far plane
+	};
+	std::uint64_t mask = 0;
+	CHECK_EQ(nstd::cull(f, nstd::aabb_packet(fixed.data(), fixed.size()), &mask), 2u);
+	CHECK_EQ(mask, 0b1001u);
+
+	for (size_t n : { 3, 33, 500 }) {
+		auto boxes = random_boxes(n, 3);
+		for (auto &box : boxes) {
+			box._Min[2] -= 12.0f;
+			box._Max[2] -= 12.0f;
+		}
+		std::vector<std::uint64_t> bits(nstd::mask_words(n));
+		nstd::cull(f, nstd::aabb_packet(boxes.data(), n), bits.data());
+		std::vector<vector3f> centers(n);
+		std::vector<float> radii(n);
+		for (size_t i = 0; i < n; i++) {
+			CHECK_EQ(nstd::mask_test(bits.data(), i), box_visible(f, boxes[i]));
+			centers[i] = (boxes[i]._Min + boxes[i]._Max) * 0.5f;
+			radii[i] = 0.25f;
+		}
+
+		nstd::cull(f, nstd::sphere_packet(centers.data(), radii.data(), n), bits.data());
+		for (size_t i = 0; i < n; i++) {
+			bool visible = true;
+			for (const nstd::plane &p : f._Planes) {
+				visible = visible && plane_distance(p, centers[i]) >= -0.25f;
+			}
+			CHECK_EQ(nstd::mask_test(bits.data(), i), visible);
+		}
+
+		const nstd::aabb box{ vector3f(-2.0f, -2.0f, -2.0f), vector3f(2.0f, 3.0f, 2.0f) };
+		nstd::contains(box, nstd::point_packet(centers.data(), n), bits.data());
+		for (size_t i = 0; i < n; i++) {
+			bool inside = true;
+			for (size_t a = 0; a < 3; a++) {
+				inside = inside && box._Min[a] <= centers[i][a] && centers[i][a] <= box._Max[a];
+			}
+			CHECK_EQ(nstd::mask_test(bits.data(), i), inside);
+		}
+	}
+}
@@ -0,0 +1,168 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <container/nstd_ndarray.h>
+#include <math/nstd_stencil.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_stencil {
+
+// asymmetric, radius 2 along the last dimension only
+constexpr nstd::stencil<double, 2, 4> upwind{ {
+	{ { 0, 0 }, 1.5 },
+	{ { 0, -1 }, -2.0 },
+	{ { 0, -2 }, 0.5 },
+	{ { 1, 0 }, 0.25 },
+} };
+
+constexpr nstd::stencil<double, 1, 3> smooth1d{ {
+	{ { -1 }, 0.25 },
+	{ { 0 }, 0.5 },
+	{ { 1 }, 0.25 },
+} };
+
+template<typename Ty>
+std::vector<Ty> random_grid(size_t n) {
+	std::mt19937_64 engine(n);
+	std::uniform_real_distribution<Ty> dist(-1, 1);
+	std::vector<Ty> res(n);
+	for (auto &v : res) {
+		v = dist(engine);
+	}
+	return res;
+}
+
+// the textbook loop: every cell, every tap, a boundary branch per coordinate
+template<auto S, typename Ty, size_t Rank, typename Boundary>
+std::vector<Ty> reference(const std::vector<Ty> &in, const size_t (&extents)[Rank], const Boundary &boundary) {
+	std::vector<Ty> out(in.size());
+	for (size_t cell = 0; cell < in.size(); cell++) {
+		long long coord[Rank];
+		size_t rest = cell;
+		for (size_t d = Rank; d-- > 0;) {
+			coord[d] = static_cast<long long>(rest % extents[d]);
+			rest /= extents[d];
+		}
+		Ty acc = 0;
+		for (const auto &tap : S._Taps) {
+			size_t lin = 0;
+			bool outside = false;
+			for (size_t d = 0; d < Rank; d++) {
+				long long i = coord[d] + tap._Offset[d];
+				const long long n = static_cast<long long>(extents[d]);
+				if constexpr (std::is_same_v<Boundary, nstd::clamp_boundary>) {
+					i = i < 0 ? 0 : (i >= n ? n - 1 : i);
+				} else if constexpr (std::is_same_v<Boundary, nstd::wrap_boundary>) {
+					i = ((i % n) + n) % n;
+				} else {
+					outside = outside || i < 0 || i >= n;
+				}
+				lin = lin * extents[d] + static_cast<size_t>(outside ? 0 : i);
+			}
+			if constexpr (requires { boundary._Value; }) {
+				acc += tap._Weight * (outside ? boundary._Value : in[lin]);
+			} else {
+				acc += tap._Weight * in[lin];
+			}
+		}
+		out[cell] = acc;
+	}
+	return out;
+}
+
+template<auto S, typename Ty, size_t Rank, typename Boundary>
+void check_against_reference(const size_t (&extents)[Rank], const Boundary &boundary, Ty tolerance) {
+	size_t n = 1;
+	for (size_t e : extents) {
+		n *= e;
+	}
+	const auto in = random_grid<Ty>(n);
+	std::vector<Ty> out(n, Ty(42));
+	nstd::apply_stencil<S>(in.data(), out.data(), extents, boundary);
+	const auto expected = reference<S>(in, extents, boundary);
+	for (size_t i = 0; i < n; i++) {
+		CHECK(std::abs(out[i] - expected[i]) <= tolerance);
+	}
+}
+
+}  // namespace test_stencil
+
+static_assert(nstd::stencils::laplacian7<float>.radius(0) == 1);
+static_assert(test_stencil::upwind.radius(0) == 1 && test_stencil::upwind.radius(1) == 2);
+static_assert(nstd::stencils::box27<double>._Taps[26]._Offset[2] == 1);
+
+TEST_CASE("interior and every boundary policy match the reference") {
+	using namespace test_stencil;
+	const size_t shapes2[][2] = { { 1, 1 }, { 2, 3 }, { 3, 70 }, { 33, 41 }, { 64, 64 } };
+	for (const auto &shape : shapes2) {
+		check_against_reference<nstd::stencils::laplacian5<float>>(shape, nstd::clamp_boundary{}, 1e-5f);
+		check_against_reference<nstd::stencils::laplacian5<float>>(shape, nstd::wrap_boundary{}, 1e-5f);
+		check_against_reference<nstd::stencils::laplacian5<float>>(shape, nstd::constant_boundary<float>{ 3.0f }, 1e-5f);
+		check_against_reference<upwind>(shape, nstd::clamp_boundary{}, 1e-12);
+		check_against_reference<upwind>(shape, nstd::wrap_boundary{}, 1e-12);
+		check_against_reference<upwind>(shape, nstd::constant_boundary<double>{ -1.0 }, 1e-12);
+	}
+	const size_t shapes3[][3] = { { 2, 2, 2 }, { 5, 6, 37 }, { 17, 9, 20 } };
+	for (const auto &shape : shapes3) {
+		check_against_reference<nstd::stencils::laplacian7<double>>(shape, nstd::clamp_boundary{}, 1e-12);
+		check_against_reference<nstd::stencils::laplacian7<double>>(shape, nstd::wrap_boundary{}, 1e-12);
+		check_against_reference<nstd::stencils::box27<float>>(shape, nstd::clamp_boundary{}, 1e-5f);
+		check_against_reference<nstd::stencils::box27<float>>(shape, nstd::constant_boundary<float>{}, 1e-5f);
+	}
+	const size_t shape1[] = { 100 };
+	check_against_reference<smooth1d>(shape1, nstd::wrap_boundary{}, 1e-12);
+	check_against_reference<smooth1d>(shape1, nstd::constant_boundary<double>{ 1.0 }, 1e-12);
+}
+
+TEST_CASE("ndarray grids") {
+	auto in = std::make_unique<nstd::ndarray<float, 12, 10, 24>>();
+	auto out = std::make_unique<nstd::ndarray<float, 12, 10, 24>>();
+	in->fill(2.0f);
+	(*in)[5][5][5] = 8.0f;
+	nstd::apply_stencil<nstd::stencils::laplacian7<float>>(*in, *out);
+	CHECK_EQ((*out)[5][5][5], -36.0f);
+	CHECK_EQ((*out)[5][5][6], 6.0f);
+	CHECK_EQ((*out)[0][0][0], 0.0f);  // clamped edges see a flat field
+
+	nstd::apply_stencil<nstd::stencils::laplacian7<float>>(*in, *out, nstd::constant_boundary<float>{ 0.0f });
+	CHECK_EQ((*out)[0][0][0], -6.0f);
+	CHECK_EQ((*out)[0][4][4], -2.0f);
+
+	CHECK_THROWS_AS(nstd::apply_stencil<nstd::stencils::laplacian7<float>>(*in, *in), std::runtime_error);
+}
+
+TEST_CASE("temporal blocking reproduces step-by-step iteration") {
+	const size_t extents[] = { 23, 19, 40 };
+	const auto init = test_stencil::random_grid<float>(23 * 19 * 40);
+
+	auto run = [&](size_t steps, auto boundary, size_t time_block) {
+		std::vector<float> a = init, b(init.size());
+		const float *res = nstd::iterate_stencil<nstd::stencils::box27<float>>(a.data(), b.data(), extents, steps, boundary, time_block);
+		return std::vector<float>(res, res + init.size());
+	};
+	for (size_t steps : { 1, 2, 5, 8 }) {
+		const auto serial = run(steps, nstd::clamp_boundary{}, 1);
+		for (size_t time_block : { 2, 3, 4, 16 }) {
+			CHECK(run(steps, nstd::clamp_boundary{}, time_block) == serial);
+		}
+		CHECK(run(steps, nstd::constant_boundary<float>{ 1.0f }, 4) == run(steps, nstd::constant_boundary<float>{ 1.0f }, 1));
+		CHECK(run(steps, nstd::wrap_boundary{}, 4) == run(steps, nstd::wrap_boundary{}, 1));
+	}
+
+	// two explicit applications agree with iterate_stencil, and the result lands in the right buffer
+	std::vector<float> a = init, b(init.size()), c(init.size());
+	nstd::apply_stencil<nstd::stencils::box27<float>>(a.data(), b.data(), extents);
+	nstd::apply_stencil<nstd::stencils::box27<float>>(b.data(), c.data(), extents);
+	CHECK(nstd::iterate_stencil<nstd::stencils::box27<float>>(a.data(), b.data(), extents, 2) == a.data());
+	CHECK(a == c);
+
+	nstd::ndarray<double, 6, 6> x, y;
+	x[3][3] = 1.0;
+	CHECK_EQ(&nstd::iterate_stencil<test_stencil::upwind>(x, y, 3), &y);
+}
@@ -0,0 +1,56 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <memory/nstd_aligned_buffer.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <utility>
+
+TEST_CASE("alignment") {
+	nstd::aligned_buffer<float> a(3);
+	CHECK_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % nstd::cache_line_size, 0);
+	nstd::aligned_buffer<char, 256> b(1);
+	CHECK_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 256, 0);
+
+	nstd::aligned_buffer<double> empty;
+	CHECK(empty.data() == nullptr);
+	CHECK(empty.empty());
+}
+
+TEST_CASE("fill / copy / move") {
+	nstd::aligned_buffer<int> a(5, 7);
+	for (int v : a) {
+		CHECK_EQ(v, 7);
+	}
+	a[2] = 1;
+
+	nstd::aligned_buffer<int> b(a);
+	CHECK_EQ(b.size(), 5);
+	CHECK_EQ(b[2], 1);
+	CHECK_NE(b.data(), a.data());
+
+	nstd::aligned_buffer<int> c(std::move(a));
+	CHECK_EQ(c.size(), 5);
+	CHECK(a.data() == nullptr);
+
+	b = c;
+	CHECK_EQ(b[0], 7);
+	nstd::aligned_buffer<int> d(2);
+	d = b;
+	CHECK_EQ(d.size(), 5);
+	CHECK_EQ(d[2], 1);
+}
+
+TEST_CASE("resize / reserve") {
+	nstd::aligned_buffer<float> a(4);
+	const float *old = a.data();
+	a.resize(4);
+	CHECK_EQ(a.data(), old);
+	a.reserve(2);
+	CHECK_EQ(a.size(), 4);
+	a.reserve(100);
+	CHECK_EQ(a.size(), 100);
+	a.resize(0);
+	CHECK(a.data() == nullptr);
+}
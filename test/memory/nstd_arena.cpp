@@ -0,0 +1,85 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <memory/nstd_arena.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("alignment") {
+	nstd::arena a(256);
+	for (nstd::size_t align = 1; align <= 128; align *= 2) {
+		a.allocate(1, 1);  // misalign the cursor
+		void *ptr = a.allocate(8, align);
+		CHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) % align, 0);
+	}
+}
+
+TEST_CASE("bump allocations are contiguous") {
+	nstd::arena a;
+	int *x = a.allocate<int>(4);
+	int *y = a.allocate<int>(4);
+	CHECK_EQ(y, x + 4);
+	CHECK_EQ(a.used(), 8 * sizeof(int));
+}
+
+TEST_CASE("oversized allocation") {
+	nstd::arena a(64);
+	char *big = a.allocate<char>(1000);
+	big[999] = 'x';
+	CHECK_GE(a.capacity(), 1000);
+}
+
+TEST_CASE("reset merges spilled blocks") {
+	nstd::arena a(128);
+	for (int i = 0; i < 10; i++) {
+		a.allocate(100);
+	}
+	const nstd::size_t cap = a.capacity();
+	a.reset();
+	CHECK_EQ(a.used(), 0);
+	CHECK_EQ(a.capacity(), cap);
+
+	// the same frame now fits in one block: every allocation follows the previous one
+	char *prev = static_cast<char *>(a.allocate(100, 1));
+	for (int i = 1; i < 10; i++) {
+		char *cur = static_cast<char *>(a.allocate(100, 1));
+		CHECK_EQ(cur, prev + 100);
+		prev = cur;
+	}
+	CHECK_EQ(a.capacity(), cap);
+}
+
+TEST_CASE("create") {
+	struct point {
+		int x, y;
+	};
+	nstd::arena a;
+	point *p = a.create<point>(1, 2);
+	CHECK_EQ(p->x, 1);
+	CHECK_EQ(p->y, 2);
+}
+
+TEST_CASE("move") {
+	nstd::arena a;
+	int *x = a.allocate<int>(1);
+	*x = 42;
+	nstd::arena b(static_cast<nstd::arena &&>(a));
+	CHECK_EQ(*x, 42);
+	CHECK_EQ(a.capacity(), 0);
+	CHECK_EQ(b.used(), sizeof(int));
+}
+
+TEST_CASE("allocator") {
+	nstd::arena a;
+	std::vector<int, nstd::arena_allocator<int>> vec{ nstd::arena_allocator<int>(a) };
+	for (int i = 0; i < 1000; i++) {
+		vec.push_back(i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		CHECK_EQ(vec[i], i);
+	}
+	CHECK_GE(a.used(), 1000 * sizeof(int));
+	CHECK(nstd::arena_allocator<int>(a) == nstd::arena_allocator<double>(a));
+}
@@ -0,0 +1,110 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <memory/nstd_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cstdint>
+#include <list>
+#include <string>
+#include <thread>
+
+TEST_CASE("recycle") {
+	nstd::pool<double, 4> p;
+	double *a = p.allocate();
+	p.deallocate(a);
+	double *b = p.allocate();
+	CHECK_EQ(a, b);
+	CHECK_EQ(p.in_use(), 1);
+	CHECK_EQ(p.capacity(), 4);
+}
+
+TEST_CASE("grow") {
+	nstd::pool<int, 4> p;
+	int *ptrs[10];
+	for (int i = 0; i < 10; i++) {
+		ptrs[i] = p.allocate();
+		*ptrs[i] = i;
+	}
+	CHECK_EQ(p.capacity(), 12);
+	for (int i = 0; i < 10; i++) {
+		CHECK_EQ(*ptrs[i], i);
+		p.deallocate(ptrs[i]);
+	}
+	CHECK_EQ(p.in_use(), 0);
+}
+
+TEST_CASE("alignment") {
+	struct alignas(64) wide {
+		char c;
+	};
+	nstd::pool<wide, 8> p;
+	for (int i = 0; i < 20; i++) {
+		CHECK_EQ(reinterpret_cast<std::uintptr_t>(p.allocate()) % 64, 0);
+	}
+}
+
+TEST_CASE("create / destroy") {
+	nstd::pool<std::string> p;
+	std::string *s = p.create(100, 'x');
+	CHECK_EQ(s->size(), 100);
+	p.destroy(s);
+	CHECK_EQ(p.in_use(), 0);
+}
+
+TEST_CASE("per-thread pools") {
+	nstd::pool<int> *main_pool = &nstd::pool<int>::local();
+	nstd::pool<int> *other_pool = nullptr;
+	std::thread([&]() {
+		other_pool = &nstd::pool<int>::local();
+	}).join();
+	CHECK_NE(main_pool, other_pool);
+}
+
+TEST_CASE("allocator") {
+	std::list<int, nstd::pool_allocator<int>> lst;
+	for (int i = 0; i < 1000; i++) {
+		lst.push_back(i);
+	}
+	int expected = 0;
+	for (int x : lst) {
+		CHECK_EQ(x, expected++);
+	}
+	lst.clear();
+}
+
+TEST_CASE("allocator owners") {
+	const nstd::pool_allocator<long> mine;
+	const nstd::pool_allocator<long> copy = mine;
+	const nstd::pool_allocator<short> rebound(mine);
+	CHECK(mine == copy);
+	CHECK(mine == rebound);
+
+	bool equal = true;
+	std::thread([&]() {
+		const nstd::pool_allocator<long> theirs;
+		equal = theirs == mine;
+	}).join();
+	CHECK_FALSE(equal);
+
+	// a block freed on another thread goes back to the pool it came from
+	nstd::pool_allocator<long> alloc;
+	long *ptr = alloc.allocate(1);
+	const size_t in_use = nstd::pool<long>::local().in_use();
+	std::thread([&]() { alloc.deallocate(ptr, 1); }).join();
+	CHECK_EQ(nstd::pool<long>::local().in_use(), in_use - 1);
+
+	// converting on another thread keeps the source's owner, and with it this thread's pools
+	bool rebound_equal = false;
+	short *block = nullptr;
+	const size_t shorts = nstd::pool<short>::local().in_use();
+	std::thread([&]() {
+		nstd::pool_allocator<short> converted(alloc);
+		rebound_equal = converted == alloc;
+		block = converted.allocate(1);
+	}).join();
+	CHECK(rebound_equal);
+	CHECK_EQ(nstd::pool<short>::local().in_use(), shorts + 1);
+	nstd::pool_allocator<short>(alloc).deallocate(block, 1);
+	CHECK_EQ(nstd::pool<short>::local().in_use(), shorts);
+}
@@ -0,0 +1,122 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <util/nstd_compress.h>
+
+// TODO: REMOVE these deps in future versions
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace test_compress {
+
+std::vector<unsigned char> round_trip(const std::vector<unsigned char> &src, size_t &packed) {
+	std::vector<unsigned char> buf(nstd::lz_compress_bound(src.size()));
+	packed = nstd::lz_compress(src.data(), src.size(), buf.data(), buf.size());
+	std::vector<unsigned char> res(src.size());
+	const size_t n = nstd::lz_decompress(buf.data(), packed, res.data(), res.size());
+	CHECK_EQ(n, src.size());
+	return res;
+}
+
+}  // namespace test_compress
+
+TEST_CASE("byte shuffle") {
+	const unsigned short src[3] = { 0x0102, 0x0304, 0x0506 };
+	unsigned char shuffled[6];
+	nstd::byte_shuffle(src, shuffled, 3, 2);
+	const unsigned char low_first[6] = { 0x02, 0x04, 0x06, 0x01, 0x03, 0x05 };  // little-endian
+	CHECK_EQ(std::memcmp(shuffled, low_first, 6), 0);
+
+	unsigned short back[3];
+	nstd::byte_unshuffle(shuffled, back, 3, 2);
+	CHECK_EQ(std::memcmp(src, back, sizeof(src)), 0);
+}
+
+TEST_CASE("bit shuffle") {
+	// 8 bytes with only bit 0 set land in a single byte of bit plane 0
+	unsigned char ones[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+	unsigned char planes[8];
+	nstd::bit_shuffle(ones, planes, 8, 1);
+	int set = 0;
+	for (unsigned char b : planes) {
+		set += b != 0;
+	}
+	CHECK_EQ(set, 1);
+
+	std::mt19937 engine(7);
+	for (size_t count : { 0, 5, 8, 67, 1024 }) {
+		std::vector<float> src(count);
+		for (auto &x : src) {
+			x = static_cast<float>(engine()) * 1e-3f;
+		}
+		std::vector<unsigned char> shuffled(count * sizeof(float));
+		std::vector<float> back(count);
+		nstd::bit_shuffle(src.data(), shuffled.data(), count, sizeof(float));
+		nstd::bit_unshuffle(shuffled.data(), back.data(), count, sizeof(float));
+		CHECK(src == back);
+	}
+}
+
+TEST_CASE("lz round trip") {
+	size_t packed = 0;
+
+	std::vector<unsigned char> empty;
+	CHECK(test_compress::round_trip(empty, packed) == empty);
+
+	std::vector<unsigned char> tiny = { 1, 2, 3 };
+	CHECK(test_compress::round_trip(tiny, packed) == tiny);
+
+	std::vector<unsigned char> runs(100000);
+	for (size_t i = 0; i < runs.size(); i++) {
+		runs[i] = static_cast<unsigned char>(i / 1000);
+	}
+	CHECK(test_compress::round_trip(runs, packed) == runs);
+	CHECK_LT(packed, runs.size() / 50);
+
+	std::vector<unsigned char> text;
+	const char *words[] = { "tile ", "cache ", "shuffle ", "ndarray ", "matrix " };
+	std::mt19937 engine(1);
+	while (text.size() < 50000) {
+		for (const char *c = words[engine() % 5]; *c; c++) {
+			text.push_back(static_cast<unsigned char>(*c));
+		}
+	}
+	CHECK(test_compress::round_trip(text, packed) == text);
+	CHECK_LT(packed, text.size() / 2);
+
+	std::vector<unsigned char> noise(65536);
+	for (auto &b : noise) {
+		b = static_cast<unsigned char>(engine());
+	}
+	CHECK(test_compress::round_trip(noise, packed) == noise);
+	CHECK_LE(packed, nstd::lz_compress_bound(noise.size()));
+}
+
+TEST_CASE("smooth field compresses better shuffled") {
+	std::vector<float> field(4096);
+	for (size_t i = 0; i < field.size(); i++) {
+		field[i] = std::sin(static_cast<float>(i) * 0.001f);
+	}
+	std::vector<unsigned char> shuffled(field.size() * sizeof(float));
+	std::vector<unsigned char> buf(nstd::lz_compress_bound(shuffled.size()));
+
+	const size_t plain = nstd::lz_compress(field.data(), shuffled.size(), buf.data(), buf.size());
+	nstd::bit_shuffle(field.data(), shuffled.data(), field.size(), sizeof(float));
+	const size_t bits = nstd::lz_compress(shuffled.data(), shuffled.size(), buf.data(), buf.size());
+	CHECK_LT(bits, plain);
+}
+
+TEST_CASE("corrupt input") {
+	std::vector<unsigned char> data(1000, 7);
+	std::vector<unsigned char> buf(nstd::lz_compress_bound(data.size()));
+	const size_t packed = nstd::lz_compress(data.data(), data.size(), buf.data(), buf.size());
+
+	std::vector<unsigned char> out(data.size());
+	CHECK_THROWS(nstd::lz_decompress(buf.data(), packed, out.data(), 10));  // too small
+	CHECK_THROWS(nstd::lz_decompress(buf.data(), packed - 1, out.data(), out.size()));
+
+	const unsigned char bad_offset[] = { 0x14, 'a', 0x05, 0x00 };  // one literal, then a match 5 bytes back
+	CHECK_THROWS(nstd::lz_decompress(bad_offset, sizeof(bad_offset), out.data(), out.size()));
+}
@@ -0,0 +1,122 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#ifndef NSTD_ENABLE_PROFILE  // xmake.lua defines it for this target, the guard keeps other builds working
+#	define NSTD_ENABLE_PROFILE
+#endif
+#include <container/nstd_ndarray.h>
+#include <util/nstd_profile.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("scope records one event") {
+	nstd::profile::reset();
+	{
+		nstd::profile::scope s("test::scope");
+	}
+	CHECK_EQ(nstd::profile::event_count(), 1);
+}
+
+TEST_CASE("scope is a no-op during constant evaluation") {
+	constexpr int res = []() {
+		NSTD_PROFILE_SCOPE("test::constexpr");
+		return 42;
+	}();
+	CHECK_EQ(res, 42);
+}
+
+TEST_CASE("counters are summed over threads") {
+	nstd::profile::reset();
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([]() {
+			for (int i = 0; i < 1000; i++) {
+				NSTD_PROFILE_COUNT("test::counter", 2);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	CHECK_EQ(nstd::profile::counter_value("test::counter"), 8000);
+	CHECK_EQ(nstd::profile::counter_value("test::unknown"), 0);
+}
+
+TEST_CASE("full buffer drops events") {
+	nstd::profile::reset();
+	for (size_t i = 0; i < nstd::profile::max_events_per_thread + 10; i++) {
+		nstd::profile::record("test::flood", 0, 1);
+	}
+	CHECK_EQ(nstd::profile::event_count(), nstd::profile::max_events_per_thread);
+	CHECK_EQ(nstd::profile::dropped_events(), 10);
+}
+
+TEST_CASE("hooks in ndarray") {
+	nstd::profile::reset();
+	nstd::ndarray<int, 4, 4> arr;
+	arr.fill(7);
+	CHECK_EQ(arr[3][3], 7);
+	CHECK_EQ(nstd::profile::event_count(), 1);
+}
+
+TEST_CASE("chrome trace dump") {
+	nstd::profile::reset();
+	{
+		NSTD_PROFILE_SCOPE("test::\"quoted\"");
+	}
+	NSTD_PROFILE_COUNT("test::dumped", 3);
+
+	const char *path = "nstd_profile_trace.json";
+	nstd::profile::dump_chrome_trace(path);
+
+	std::ifstream in(path);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	const std::string json = ss.str();
+	in.close();
+	std::remove(path);
+
+	CHECK_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0);
+	CHECK_NE(json.find("\"name\":\"test::\\\"quoted\\\"\",\"ph\":\"X\""), std::string::npos);
+	CHECK_NE(json.find("\"name\":\"test::dumped\",\"ph\":\"C\""), std::string::npos);
+	CHECK_NE(json.find("\"args\":{\"value\":3}"), std::string::npos);
+	CHECK_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST_CASE("exited threads hand on their buffers") {
+	nstd::profile::reset();
+	const auto churn = [](int threads, bool scope) {
+		for (int t = 0; t < threads; t++) {
+			std::thread([scope]() {
+				NSTD_PROFILE_COUNT("test::churn", 1);
+				if (scope) {
+					NSTD_PROFILE_SCOPE("test::churn");
+				}
+			}).join();
+		}
+	};
+
+	// nothing to dump: one buffer goes round
+	churn(1, false);
+	const size_t buffers = nstd::profile::thread_buffers();
+	churn(50, false);
+	CHECK_EQ(nstd::profile::thread_buffers(), buffers);
+	CHECK_EQ(nstd::profile::counter_value("test::churn"), 51);
+
+	// events are kept until they are written out
+	churn(5, true);
+	churn(5, true);
+	CHECK_EQ(nstd::profile::event_count(), 10);
+	const size_t kept = nstd::profile::thread_buffers();
+	const char *path = "nstd_profile_churn.json";
+	nstd::profile::dump_chrome_trace(path);
+	std::remove(path);
+	churn(10, true);
+	CHECK_EQ(nstd::profile::thread_buffers(), kept);
+	CHECK_EQ(nstd::profile::counter_value("test::churn"), 71);
+}
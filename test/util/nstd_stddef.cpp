@@ -11,3 +11,8 @@ TEST_CASE("baseline") {
 	CHECK(std::is_same_v<nstd::ptrdiff_t, std::ptrdiff_t>);
 	CHECK(std::is_same_v<nstd::nullptr_t, std::nullptr_t>);
 }
+
+TEST_CASE("cache_line_size") {
+	static_assert((nstd::cache_line_size & (nstd::cache_line_size - 1)) == 0);
+	CHECK_GE(nstd::cache_line_size, alignof(std::max_align_t));
+}
@@ -0,0 +1,75 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <util/nstd_thread_pool.h>
+
+// TODO: REMOVE these deps in future versions
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("size") {
+	CHECK_EQ(nstd::thread_pool(1).size(), 1);
+	CHECK_EQ(nstd::thread_pool(4).size(), 4);
+	CHECK_GE(nstd::thread_pool::global().size(), 1);
+}
+
+TEST_CASE("run visits every task once") {
+	nstd::thread_pool pool(4);
+	std::vector<std::atomic<int>> hits(1000);
+	for (int round = 0; round < 20; round++) {
+		pool.run(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+	}
+	for (auto &h : hits) {
+		CHECK_EQ(h.load(), 20);
+	}
+	pool.run(0, [](size_t) { CHECK(false); });
+}
+
+TEST_CASE("parallel_for covers the range") {
+	nstd::thread_pool pool(3);
+	for (size_t n : { 1, 5, 12, 1000 }) {
+		std::vector<int> seen(n + 10, 0);
+		pool.parallel_for(10, n + 10, [&](size_t lo, size_t hi) {
+			CHECK_LT(lo, hi);
+			for (size_t i = lo; i < hi; i++) {
+				seen[i]++;
+			}
+		});
+		for (size_t i = 0; i < seen.size(); i++) {
+			CHECK_EQ(seen[i], i < 10 ? 0 : 1);
+		}
+	}
+
+	size_t chunks = 0;
+	pool.parallel_for(0, 100, [&](size_t lo, size_t hi) {
+		CHECK_GE(hi - lo, 50);
+		chunks++;  // grain 50 leaves at most two chunks
+	}, 50);
+	CHECK_LE(chunks, 2);
+}
+
+TEST_CASE("nested run executes inline") {
+	nstd::thread_pool pool(4);
+	std::atomic<int> total{ 0 };
+	pool.run(8, [&](size_t) {
+		pool.run(8, [&](size_t) { total.fetch_add(1); });
+	});
+	CHECK_EQ(total.load(), 64);
+}
+
+TEST_CASE("exceptions propagate") {
+	nstd::thread_pool pool(4);
+	std::atomic<int> done{ 0 };
+	CHECK_THROWS_AS(pool.run(100, [&](size_t i) {
+		if (i == 37) {
+			throw std::runtime_error("task failed");
+		}
+		done.fetch_add(1);
+	}),
+	                std::runtime_error);
+	CHECK_EQ(done.load(), 99);
+
+	pool.run(10, [&](size_t) { done.fetch_add(1); });  // still usable
+	CHECK_EQ(done.load(), 109);
+}
@@ -457,3 +457,44 @@ TEST_CASE("remove_cvref") {
 	CHECK(nstd::is_same_v<nstd::remove_cvref_t<const volatile int>,
 	                      std::remove_cvref_t<const volatile int>>);
 }
+
+TEST_CASE("is_trivially_copyable") {
+	struct A {
+		int x;
+	};
+
+	struct B {
+		B(const B &) {}
+	};
+
+	CHECK(nstd::is_trivially_copyable_v<int>);
+	CHECK(nstd::is_trivially_copyable_v<A>);
+	CHECK(!nstd::is_trivially_copyable_v<B>);
+
+	CHECK_EQ(nstd::is_trivially_copyable_v<int>, std::is_trivially_copyable_v<int>);
+	CHECK_EQ(nstd::is_trivially_copyable_v<int *>, std::is_trivially_copyable_v<int *>);
+	CHECK_EQ(nstd::is_trivially_copyable_v<A>, std::is_trivially_copyable_v<A>);
+	CHECK_EQ(nstd::is_trivially_copyable_v<B>, std::is_trivially_copyable_v<B>);
+}
+
+namespace test_relocatable {
+
+struct handle {
+	int *_Ptr;
+	handle(handle &&rhs) noexcept
+	    : _Ptr(rhs._Ptr) {
+		rhs._Ptr = nullptr;
+	}
+	~handle() {}
+};
+
+}  // namespace test_relocatable
+
+template<>
+struct nstd::is_trivially_relocatable<test_relocatable::handle> : nstd::true_type {};
+
+TEST_CASE("is_trivially_relocatable") {
+	CHECK(nstd::is_trivially_relocatable_v<int>);
+	CHECK(!nstd::is_trivially_copyable_v<test_relocatable::handle>);
+	CHECK(nstd::is_trivially_relocatable_v<test_relocatable::handle>);
+}
@@ -4,15 +4,51 @@ add_rules("mode.debug", "mode.release")
 add_requires("doctest", "nanobench")
 add_requires("xsimd", "eigen", "glm")
 
+option("profile")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Enable nstd::profile hot-path instrumentation (NSTD_PROFILE_* hooks)")
+    add_defines("NSTD_ENABLE_PROFILE")
+option_end()
+add_options("profile")
+
+option("hardened")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Trap instead of throwing on failed bounds checks, keep NSTD_BOUNDS_ASSERT checks under NDEBUG")
+    add_defines("NSTD_ENABLE_HARDENED")
+option_end()
+add_options("hardened")
+
+if is_plat("linux") then
+    add_syslinks("pthread")
+end
+
 target("nonstd")
     set_languages("cxx23")
     set_kind("static")
     set_warnings("all", "error", "extra", "pedantic")
 
     add_includedirs("src")
-    add_files("src/**.cpp")
+    add_files("src/**.cpp|math/nstd_dispatch_avx2.cpp|math/nstd_dispatch_avx512.cpp|math/nstd_dispatch_avx512vnni.cpp")
     add_packages("xsimd")
 
+    -- per-isa kernels selected at run time (math/nstd_dispatch.h), the rest of the library keeps the default target
+    if is_arch("x86_64", "x64", "i386", "x86") then
+        if is_plat("windows") then
+            add_files("src/math/nstd_dispatch_avx2.cpp", {cxflags = "/arch:AVX2"})
+            add_files("src/math/nstd_dispatch_avx512.cpp", {cxflags = "/arch:AVX512"})
+            -- msvc has no VNNI switch, the file builds without it and the avx512 table keeps pmaddwd
+            add_files("src/math/nstd_dispatch_avx512vnni.cpp", {cxflags = "/arch:AVX512"})
+        else
+            add_files("src/math/nstd_dispatch_avx2.cpp", {cxflags = {"-mavx2", "-mfma"}})
+            add_files("src/math/nstd_dispatch_avx512.cpp", {cxflags = {"-mavx512f", "-mavx512bw", "-mavx2", "-mfma"}})
+            add_files("src/math/nstd_dispatch_avx512vnni.cpp", {cxflags = {"-mavx512f", "-mavx512bw", "-mavx512vnni", "-mavx2", "-mfma"}})
+        end
+    else
+        add_files("src/math/nstd_dispatch_avx2.cpp", "src/math/nstd_dispatch_avx512.cpp", "src/math/nstd_dispatch_avx512vnni.cpp")
+    end
+
     after_build(function (target)
         os.cp(target:targetfile(), "bin/")
     end)
@@ -56,6 +92,10 @@ for _, file in ipairs(os.files("test/**/*.cpp")) do
         if string.find(path.absolute(file), "math") then
             add_packages("eigen")
         end
+        -- the profiler test needs the hooks whether or not the profile option is on
+        if path.basename(file) == "nstd_profile" and not has_config("profile") then
+            add_defines("NSTD_ENABLE_PROFILE")
+        end
 
         add_includedirs("src")
         add_rules("test")